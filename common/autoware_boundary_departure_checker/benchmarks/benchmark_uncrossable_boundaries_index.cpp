@@ -0,0 +1,176 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/boundary_departure_checker/uncrossable_boundaries_index.hpp"
+#include "autoware/boundary_departure_checker/utils.hpp"
+
+#include <lanelet2_core/LaneletMap.h>
+#include <malloc.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Compare the R-tree of the whole map built by the checker before with the tiled index, against
+// the size of the map: the time and heap memory to get ready, and the latency of the boundary
+// query done for each ego side, i.e. the k nearest segments passed to find_closest_segment().
+
+using autoware::boundary_departure_checker::Point2d;
+using autoware::boundary_departure_checker::Segment2d;
+using autoware::boundary_departure_checker::SegmentWithIdx;
+using autoware::boundary_departure_checker::UncrossableBoundariesIndex;
+namespace utils = autoware::boundary_departure_checker::utils;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+constexpr double block_size_m = 100.0;
+constexpr double road_half_width_m = 5.0;
+constexpr double point_interval_m = 2.0;
+
+// road borders around the blocks of a grid city
+lanelet::LaneletMapPtr create_grid_map(const int blocks_per_side)
+{
+  auto map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::Id id = 1;
+  const auto add_border = [&](const double x0, const double y0, const double x1, const double y1) {
+    const auto points_num = static_cast<int>(std::hypot(x1 - x0, y1 - y0) / point_interval_m) + 1;
+    lanelet::Points3d points;
+    for (int i = 0; i <= points_num; ++i) {
+      const double ratio = static_cast<double>(i) / points_num;
+      points.emplace_back(id++, x0 + (x1 - x0) * ratio, y0 + (y1 - y0) * ratio, 0.0);
+    }
+    map->add(lanelet::LineString3d(id++, points, lanelet::AttributeMap{{"type", "road_border"}}));
+  };
+
+  for (int ix = 0; ix < blocks_per_side; ++ix) {
+    for (int iy = 0; iy < blocks_per_side; ++iy) {
+      const double min_x = ix * block_size_m + road_half_width_m;
+      const double min_y = iy * block_size_m + road_half_width_m;
+      const double max_x = (ix + 1) * block_size_m - road_half_width_m;
+      const double max_y = (iy + 1) * block_size_m - road_half_width_m;
+      add_border(min_x, min_y, max_x, min_y);
+      add_border(max_x, min_y, max_x, max_y);
+      add_border(max_x, max_y, min_x, max_y);
+      add_border(min_x, max_y, min_x, min_y);
+    }
+  }
+  return map;
+}
+
+double allocated_mb()
+{
+  return static_cast<double>(mallinfo2().uordblks) / 1024.0 / 1024.0;
+}
+
+double elapsed_ms(const std::chrono::steady_clock::time_point & start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+
+// ego sides of a drive along the road between the first and second rows of blocks
+std::vector<Segment2d> create_ego_sides(const int blocks_per_side)
+{
+  std::vector<Segment2d> ego_sides;
+  const double y = block_size_m - 1.5;
+  for (double x = 0.0; x < blocks_per_side * block_size_m - 5.0; x += 0.5) {
+    ego_sides.emplace_back(Point2d(x, y), Point2d(x + 4.0, y));
+  }
+  return ego_sides;
+}
+
+// return the latency [us] and the mean lateral distance to the closest boundary as a checksum
+template <typename NearestFunc>
+std::pair<double, double> measure_query(
+  const std::vector<Segment2d> & ego_sides, const lanelet::LaneletMap & map,
+  const NearestFunc & nearest)
+{
+  double lat_dist_sum = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < ego_sides.size(); ++i) {
+    const auto & ego_side = ego_sides[i];
+    std::vector<SegmentWithIdx> boundary_segments;
+    for (const auto & [envelope, id] : nearest(ego_side.first)) {
+      const auto basic_ls = map.lineStringLayer.get(id.linestring_id).basicLineString();
+      const auto seg =
+        utils::to_segment_2d(basic_ls.at(id.segment_start_idx), basic_ls.at(id.segment_end_idx));
+      boundary_segments.emplace_back(seg, id);
+    }
+    const Segment2d rear(ego_side.first, Point2d(ego_side.first.x(), ego_side.first.y() - 2.0));
+    lat_dist_sum += utils::find_closest_segment(ego_side, rear, i, boundary_segments).lat_dist;
+  }
+  const auto queries_num = static_cast<double>(ego_sides.size());
+  return {elapsed_ms(start) * 1e3 / queries_num, lat_dist_sum / queries_num};
+}
+}  // namespace
+
+int main()
+{
+  const std::vector<std::string> types{"road_border"};
+  constexpr size_t k = 5;
+
+  for (const int blocks_per_side : {10, 30, 60, 100}) {
+    const auto map = create_grid_map(blocks_per_side);
+    const auto ego_sides = create_ego_sides(blocks_per_side);
+    std::cout << "map " << blocks_per_side * block_size_m / 1000.0 << " km square, "
+              << map->lineStringLayer.size() << " borders" << std::endl;
+
+    {
+      const auto memory_before = allocated_mb();
+      const auto start = std::chrono::steady_clock::now();
+      const auto rtree = utils::build_uncrossable_boundaries_rtree(*map, types);
+      const auto build_ms = elapsed_ms(start);
+      const auto memory_mb = allocated_mb() - memory_before;
+      const auto [query_us, lat_dist] = measure_query(ego_sides, *map, [&](const Point2d & point) {
+        std::vector<SegmentWithIdx> nearest;
+        rtree.query(bgi::nearest(point, static_cast<unsigned>(k)), std::back_inserter(nearest));
+        return nearest;
+      });
+      std::cout << "  full rtree: build " << build_ms << " [ms], " << memory_mb << " [MB], query "
+                << query_us << " [us], mean lateral distance " << lat_dist << " [m]" << std::endl;
+    }
+
+    {
+      const auto memory_before = allocated_mb();
+      auto start = std::chrono::steady_clock::now();
+      const UncrossableBoundariesIndex index(map, types);
+      const auto construct_ms = elapsed_ms(start);
+      start = std::chrono::steady_clock::now();
+      index.nearest(ego_sides.front().first, k);
+      const auto first_query_ms = elapsed_ms(start);
+      const auto [query_us, lat_dist] = measure_query(
+        ego_sides, *map, [&](const Point2d & point) { return index.nearest(point, k); });
+      const auto drive_memory_mb = allocated_mb() - memory_before;
+      const auto built_tiles_num = index.built_tiles_num();
+
+      start = std::chrono::steady_clock::now();
+      index.build_all_tiles();
+      const auto build_all_ms = elapsed_ms(start);
+      const auto all_memory_mb = allocated_mb() - memory_before;
+      std::cout << "  tiled index: construct " << construct_ms << " [ms], first query "
+                << first_query_ms << " [ms], query " << query_us << " [us], mean lateral distance "
+                << lat_dist << " [m]" << std::endl;
+      std::cout << "    " << built_tiles_num << "/" << index.tiles_num() << " tiles built "
+                << drive_memory_mb << " [MB] after the drive, build all " << build_all_ms
+                << " [ms] " << all_memory_mb << " [MB]" << std::endl;
+    }
+  }
+  return 0;
+}
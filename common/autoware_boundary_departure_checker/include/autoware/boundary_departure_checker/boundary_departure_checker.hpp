@@ -16,6 +16,7 @@
 #define AUTOWARE__BOUNDARY_DEPARTURE_CHECKER__BOUNDARY_DEPARTURE_CHECKER_HPP_
 
 #include "autoware/boundary_departure_checker/parameters.hpp"
+#include "autoware/boundary_departure_checker/uncrossable_boundaries_index.hpp"
 
 #include <autoware_utils/system/time_keeper.hpp>
 #include <autoware_vehicle_info_utils/vehicle_info_utils.hpp>
@@ -210,7 +211,7 @@ private:
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   std::unique_ptr<Param> param_ptr_;
   std::shared_ptr<VehicleInfo> vehicle_info_ptr_;
-  std::unique_ptr<UncrossableBoundRTree> uncrossable_boundaries_rtree_ptr_;
+  std::shared_ptr<const UncrossableBoundariesIndex> uncrossable_boundaries_index_ptr_;
 
   bool willLeaveLane(
     const lanelet::ConstLanelets & candidate_lanelets,
@@ -0,0 +1,130 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__BOUNDARY_DEPARTURE_CHECKER__UNCROSSABLE_BOUNDARIES_INDEX_HPP_
+#define AUTOWARE__BOUNDARY_DEPARTURE_CHECKER__UNCROSSABLE_BOUNDARIES_INDEX_HPP_
+
+#include "autoware/boundary_departure_checker/data_structs.hpp"
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace autoware::boundary_departure_checker
+{
+/**
+ * @brief Spatial index of the uncrossable boundary segments of a lanelet map, built tile by tile.
+ *
+ * The constructor only assigns the uncrossable line strings to square tiles by their bounding
+ * boxes. The R-tree of a tile is built when a query reaches the tile for the first time, so the
+ * construction does not block on large maps and only the tiles around the ego are ever built.
+ * Queries may be called from multiple threads.
+ *
+ * The index keeps the map alive. Use get_shared() to share one index between the modules of a
+ * process; it is keyed by the map instance, which is replaced whenever a new map is received.
+ */
+class UncrossableBoundariesIndex
+{
+public:
+  static constexpr double default_tile_size_m = 200.0;
+
+  /**
+   * @brief Assign the uncrossable line strings of the map to tiles without building any R-tree.
+   *
+   * @param lanelet_map_ptr          Map to index. It must not be null.
+   * @param boundary_types_to_detect Types of the line strings considered as uncrossable.
+   * @param tile_size_m              Edge length of the tiles.
+   */
+  UncrossableBoundariesIndex(
+    lanelet::LaneletMapConstPtr lanelet_map_ptr, std::vector<std::string> boundary_types_to_detect,
+    double tile_size_m = default_tile_size_m);
+
+  UncrossableBoundariesIndex(const UncrossableBoundariesIndex &) = delete;
+  UncrossableBoundariesIndex & operator=(const UncrossableBoundariesIndex &) = delete;
+
+  /**
+   * @brief Get the index of the map shared within the process, creating it if necessary.
+   *
+   * @param lanelet_map_ptr          Map to index. It must not be null.
+   * @param boundary_types_to_detect Types of the line strings considered as uncrossable.
+   * @return The same index as long as it is used somewhere for the same map and types.
+   */
+  static std::shared_ptr<const UncrossableBoundariesIndex> get_shared(
+    const lanelet::LaneletMapConstPtr & lanelet_map_ptr,
+    const std::vector<std::string> & boundary_types_to_detect);
+
+  /**
+   * @brief Find the k nearest segments, with the same result as a query of bgi::nearest(point, k)
+   * on the R-tree built by utils::build_uncrossable_boundaries_rtree().
+   *
+   * The tiles are visited ring by ring around the point until the k-th candidate is closer than
+   * any segment in the unvisited tiles.
+   *
+   * @param point Query point.
+   * @param k     Maximum number of segments to return.
+   * @return Segments sorted by distance from the point.
+   */
+  std::vector<SegmentWithIdx> nearest(const Point2d & point, size_t k) const;
+
+  /**
+   * @brief Build the R-trees of all the tiles, e.g. from a background thread after the map is
+   * loaded.
+   */
+  void build_all_tiles() const;
+
+  [[nodiscard]] size_t tiles_num() const { return tiles_.size(); }
+  [[nodiscard]] size_t built_tiles_num() const { return built_tiles_num_.load(); }
+  [[nodiscard]] const lanelet::LaneletMapConstPtr & lanelet_map_ptr() const
+  {
+    return lanelet_map_ptr_;
+  }
+  [[nodiscard]] const std::vector<std::string> & boundary_types_to_detect() const
+  {
+    return boundary_types_to_detect_;
+  }
+
+private:
+  struct Tile
+  {
+    Box2d box;
+    std::vector<lanelet::Id> linestring_ids;
+    // built lazily from const queries
+    mutable std::once_flag built;
+    mutable UncrossableBoundRTree rtree;
+  };
+
+  std::int32_t to_tile_index(double coordinate) const;
+  static std::int64_t to_tile_key(std::int32_t ix, std::int32_t iy);
+  const UncrossableBoundRTree & get_rtree(const Tile & tile) const;
+
+  lanelet::LaneletMapConstPtr lanelet_map_ptr_;
+  std::vector<std::string> boundary_types_to_detect_;
+  double tile_size_m_;
+
+  std::unordered_map<std::int64_t, Tile> tiles_;
+  mutable std::atomic<size_t> built_tiles_num_{0};
+  std::int32_t min_ix_{0};
+  std::int32_t max_ix_{-1};
+  std::int32_t min_iy_{0};
+  std::int32_t max_iy_{-1};
+};
+}  // namespace autoware::boundary_departure_checker
+
+#endif  // AUTOWARE__BOUNDARY_DEPARTURE_CHECKER__UNCROSSABLE_BOUNDARIES_INDEX_HPP_
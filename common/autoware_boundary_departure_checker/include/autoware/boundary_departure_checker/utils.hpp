@@ -270,6 +270,17 @@ EgoSides get_sides_from_footprints(
 bool is_uncrossable_type(
   std::vector<std::string> boundary_types_to_detect, const lanelet::ConstLineString3d & ls);
 
+/**
+ * @brief Split a line string into indexed 2D segments for the uncrossable boundaries R-tree.
+ *
+ * Each segment is stored as its envelope, together with the line string id and the indices of
+ * its end points, so that the original segment can be recovered from the map.
+ *
+ * @param linestring The lanelet line string to split.
+ * @return Envelopes of the segments with their indices.
+ */
+std::vector<SegmentWithIdx> create_local_segments(const lanelet::ConstLineString3d & linestring);
+
 /**
  * @brief Construct an R-tree of uncrossable boundary segments from the given lanelet map.
  *
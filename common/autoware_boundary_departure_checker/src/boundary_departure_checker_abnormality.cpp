@@ -47,14 +47,15 @@ BoundaryDepartureChecker::BoundaryDepartureChecker(
   vehicle_info_ptr_(std::make_shared<VehicleInfo>(vehicle_info)),
   time_keeper_(std::move(time_keeper))
 {
-  auto try_uncrossable_boundaries_rtree = build_uncrossable_boundaries_tree(lanelet_map_ptr);
+  autoware_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
-  if (!try_uncrossable_boundaries_rtree) {
-    throw std::runtime_error(try_uncrossable_boundaries_rtree.error());
+  if (!lanelet_map_ptr) {
+    throw std::runtime_error("lanelet_map_ptr is null");
   }
 
-  uncrossable_boundaries_rtree_ptr_ =
-    std::make_unique<UncrossableBoundRTree>(*try_uncrossable_boundaries_rtree);
+  // the index is shared with the other checkers of the same map and built around the queries
+  uncrossable_boundaries_index_ptr_ =
+    UncrossableBoundariesIndex::get_shared(lanelet_map_ptr, param_ptr_->boundary_types_to_detect);
 }
 
 tl::expected<AbnormalitiesData, std::string> BoundaryDepartureChecker::get_abnormalities_data(
@@ -114,8 +115,8 @@ BoundaryDepartureChecker::get_boundary_segments_from_side(
     return tl::make_unexpected(std::string(__func__) + ": invalid lanelet_map_ptr");
   }
 
-  if (!uncrossable_boundaries_rtree_ptr_) {
-    return tl::make_unexpected(std::string(__func__) + ": invalid uncrossable boundaries rtree");
+  if (!uncrossable_boundaries_index_ptr_) {
+    return tl::make_unexpected(std::string(__func__) + ": invalid uncrossable boundaries index");
   }
 
   if (!param_ptr_) {
@@ -124,16 +125,14 @@ BoundaryDepartureChecker::get_boundary_segments_from_side(
 
   const auto max_lat_query_num = param_ptr_->th_max_lateral_query_num;
 
-  const auto & rtree = *uncrossable_boundaries_rtree_ptr_;
+  const auto & uncrossable_boundaries_index = *uncrossable_boundaries_index_ptr_;
   const auto & linestring_layer = lanelet_map_ptr_->lineStringLayer;
 
   const auto closest_segment = [&](
                                  const auto & ego_seg, const auto & compare_seg,
                                  auto & output_side) {
-    std::vector<SegmentWithIdx> nearest_raw;
-
-    const lanelet::BasicPoint2d ego_start{ego_seg.first.x(), ego_seg.first.y()};
-    rtree.query(bgi::nearest(ego_start, max_lat_query_num), std::back_inserter(nearest_raw));
+    const auto nearest_raw = uncrossable_boundaries_index.nearest(
+      ego_seg.first, static_cast<size_t>(std::max(max_lat_query_num, 0)));
 
     for (const auto & nearest : nearest_raw) {
       const auto & id = std::get<1>(nearest);
@@ -0,0 +1,227 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/boundary_departure_checker/uncrossable_boundaries_index.hpp"
+
+#include "autoware/boundary_departure_checker/utils.hpp"
+
+#include <boost/geometry.hpp>
+
+#include <lanelet2_core/geometry/LineString.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::boundary_departure_checker
+{
+UncrossableBoundariesIndex::UncrossableBoundariesIndex(
+  lanelet::LaneletMapConstPtr lanelet_map_ptr, std::vector<std::string> boundary_types_to_detect,
+  const double tile_size_m)
+: lanelet_map_ptr_(std::move(lanelet_map_ptr)),
+  boundary_types_to_detect_(std::move(boundary_types_to_detect)),
+  tile_size_m_(tile_size_m)
+{
+  if (!lanelet_map_ptr_) {
+    throw std::invalid_argument("lanelet_map_ptr is null");
+  }
+  if (!(tile_size_m_ > 0.0)) {
+    throw std::invalid_argument("tile_size_m must be positive");
+  }
+
+  for (const auto & linestring : lanelet_map_ptr_->lineStringLayer) {
+    if (
+      linestring.size() < 2 ||
+      !utils::is_uncrossable_type(boundary_types_to_detect_, linestring)) {
+      continue;
+    }
+
+    const auto bbox = lanelet::geometry::boundingBox2d(linestring);
+    const auto min_ix = to_tile_index(bbox.min().x());
+    const auto max_ix = to_tile_index(bbox.max().x());
+    const auto min_iy = to_tile_index(bbox.min().y());
+    const auto max_iy = to_tile_index(bbox.max().y());
+    for (auto ix = min_ix; ix <= max_ix; ++ix) {
+      for (auto iy = min_iy; iy <= max_iy; ++iy) {
+        const auto [tile_itr, inserted] = tiles_.try_emplace(to_tile_key(ix, iy));
+        auto & tile = tile_itr->second;
+        if (inserted) {
+          tile.box = Box2d(
+            Point2d(ix * tile_size_m_, iy * tile_size_m_),
+            Point2d((ix + 1) * tile_size_m_, (iy + 1) * tile_size_m_));
+        }
+        tile.linestring_ids.push_back(linestring.id());
+      }
+    }
+
+    const bool is_first = min_ix_ > max_ix_;
+    min_ix_ = is_first ? min_ix : std::min(min_ix_, min_ix);
+    max_ix_ = is_first ? max_ix : std::max(max_ix_, max_ix);
+    min_iy_ = is_first ? min_iy : std::min(min_iy_, min_iy);
+    max_iy_ = is_first ? max_iy : std::max(max_iy_, max_iy);
+  }
+}
+
+std::shared_ptr<const UncrossableBoundariesIndex> UncrossableBoundariesIndex::get_shared(
+  const lanelet::LaneletMapConstPtr & lanelet_map_ptr,
+  const std::vector<std::string> & boundary_types_to_detect)
+{
+  // The registry does not own the indices, so an index is released with the last module using it.
+  // The map instance is a safe key because a living index keeps its map, and thus its address.
+  static std::mutex mutex;
+  static std::vector<std::weak_ptr<const UncrossableBoundariesIndex>> indices;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  indices.erase(
+    std::remove_if(
+      indices.begin(), indices.end(), [](const auto & index) { return index.expired(); }),
+    indices.end());
+
+  for (const auto & weak_index : indices) {
+    const auto index = weak_index.lock();
+    if (
+      index && index->lanelet_map_ptr_ == lanelet_map_ptr &&
+      index->boundary_types_to_detect_ == boundary_types_to_detect) {
+      return index;
+    }
+  }
+
+  auto index =
+    std::make_shared<const UncrossableBoundariesIndex>(lanelet_map_ptr, boundary_types_to_detect);
+  indices.push_back(index);
+  return index;
+}
+
+std::vector<SegmentWithIdx> UncrossableBoundariesIndex::nearest(
+  const Point2d & point, const size_t k) const
+{
+  if (k == 0 || tiles_.empty()) {
+    return {};
+  }
+
+  std::vector<std::pair<double, SegmentWithIdx>> candidates;
+  std::vector<SegmentWithIdx> tile_nearest;
+  const auto visit = [&](const std::int64_t ix, const std::int64_t iy) {
+    if (ix < min_ix_ || ix > max_ix_ || iy < min_iy_ || iy > max_iy_) {
+      return;
+    }
+    const auto tile_itr = tiles_.find(
+      to_tile_key(static_cast<std::int32_t>(ix), static_cast<std::int32_t>(iy)));
+    if (tile_itr == tiles_.end()) {
+      return;
+    }
+
+    tile_nearest.clear();
+    get_rtree(tile_itr->second)
+      .query(bgi::nearest(point, static_cast<unsigned>(k)), std::back_inserter(tile_nearest));
+    for (auto & segment : tile_nearest) {
+      // a segment is stored in all the tiles its envelope overlaps
+      const auto is_same = [&](const auto & candidate) {
+        return candidate.second.second == segment.second;
+      };
+      if (std::none_of(candidates.begin(), candidates.end(), is_same)) {
+        const auto dist = bg::comparable_distance(point, segment.first);
+        candidates.emplace_back(dist, std::move(segment));
+      }
+    }
+  };
+  const auto is_closer = [](const auto & a, const auto & b) { return a.first < b.first; };
+
+  const std::int64_t cx = to_tile_index(point.x());
+  const std::int64_t cy = to_tile_index(point.y());
+  const std::int64_t max_ring = std::max({cx - min_ix_, max_ix_ - cx, cy - min_iy_, max_iy_ - cy});
+  for (std::int64_t ring = 0; ring <= max_ring; ++ring) {
+    for (auto ix = cx - ring; ix <= cx + ring; ++ix) {
+      visit(ix, cy - ring);
+      if (ring > 0) visit(ix, cy + ring);
+    }
+    for (auto iy = cy - ring + 1; iy <= cy + ring - 1; ++iy) {
+      visit(cx - ring, iy);
+      visit(cx + ring, iy);
+    }
+
+    if (candidates.size() < k) {
+      continue;
+    }
+
+    // segments only in the unvisited tiles are farther than the border of the visited square
+    const auto kth = std::next(candidates.begin(), static_cast<std::ptrdiff_t>(k - 1));
+    std::nth_element(candidates.begin(), kth, candidates.end(), is_closer);
+    const double dist_to_outside = std::min(
+      {point.x() - static_cast<double>(cx - ring) * tile_size_m_,
+       static_cast<double>(cx + ring + 1) * tile_size_m_ - point.x(),
+       point.y() - static_cast<double>(cy - ring) * tile_size_m_,
+       static_cast<double>(cy + ring + 1) * tile_size_m_ - point.y()});
+    if (kth->first <= dist_to_outside * dist_to_outside) {
+      break;
+    }
+  }
+
+  const auto end = std::next(
+    candidates.begin(), static_cast<std::ptrdiff_t>(std::min(k, candidates.size())));
+  std::partial_sort(candidates.begin(), end, candidates.end(), is_closer);
+
+  std::vector<SegmentWithIdx> nearest_segments;
+  nearest_segments.reserve(static_cast<size_t>(std::distance(candidates.begin(), end)));
+  std::transform(
+    candidates.begin(), end, std::back_inserter(nearest_segments),
+    [](auto & candidate) { return std::move(candidate.second); });
+  return nearest_segments;
+}
+
+void UncrossableBoundariesIndex::build_all_tiles() const
+{
+  for (const auto & [key, tile] : tiles_) {
+    get_rtree(tile);
+  }
+}
+
+std::int32_t UncrossableBoundariesIndex::to_tile_index(const double coordinate) const
+{
+  constexpr double max_index = 1e9;
+  return static_cast<std::int32_t>(
+    std::clamp(std::floor(coordinate / tile_size_m_), -max_index, max_index));
+}
+
+std::int64_t UncrossableBoundariesIndex::to_tile_key(const std::int32_t ix, const std::int32_t iy)
+{
+  return static_cast<std::int64_t>(
+    (static_cast<std::uint64_t>(static_cast<std::uint32_t>(ix)) << 32U) |
+    static_cast<std::uint32_t>(iy));
+}
+
+const UncrossableBoundRTree & UncrossableBoundariesIndex::get_rtree(const Tile & tile) const
+{
+  std::call_once(tile.built, [&]() {
+    std::vector<SegmentWithIdx> segments;
+    for (const auto id : tile.linestring_ids) {
+      for (auto & segment :
+           utils::create_local_segments(lanelet_map_ptr_->lineStringLayer.get(id))) {
+        const auto & envelope = segment.first;
+        if (bg::intersects(Box2d(envelope.first, envelope.second), tile.box)) {
+          segments.push_back(std::move(segment));
+        }
+      }
+    }
+    tile.rtree = UncrossableBoundRTree(segments.begin(), segments.end());
+    ++built_tiles_num_;
+  });
+  return tile.rtree;
+}
+}  // namespace autoware::boundary_departure_checker
@@ -42,12 +42,7 @@ using autoware::boundary_departure_checker::ClosestProjectionToBound;
 using autoware::boundary_departure_checker::DeparturePoint;
 using autoware::boundary_departure_checker::DeparturePoints;
 using autoware::boundary_departure_checker::DepartureType;
-using autoware::boundary_departure_checker::IdxForRTreeSegment;
-using autoware::boundary_departure_checker::Segment2d;
-using autoware::boundary_departure_checker::SegmentWithIdx;
 using autoware::boundary_departure_checker::VehicleInfo;
-using autoware::boundary_departure_checker::utils::to_segment_2d;
-namespace bg = boost::geometry;
 
 DeparturePoint create_departure_point(
   const ClosestProjectionToBound & projection_to_bound, const double th_dist_hysteresis_m,
@@ -80,19 +75,6 @@ void erase_after_first_match(DeparturePoints & departure_points)
     departure_points.erase(std::next(crit_dpt_finder), departure_points.end());
   }
 }
-
-std::vector<SegmentWithIdx> create_local_segments(const lanelet::ConstLineString3d & linestring)
-{
-  std::vector<SegmentWithIdx> local_segments;
-  local_segments.reserve(linestring.size());
-  const auto basic_ls = linestring.basicLineString();
-  for (size_t i = 0; i + 1 < basic_ls.size(); ++i) {
-    const auto segment = to_segment_2d(basic_ls.at(i), basic_ls.at(i + 1));
-    local_segments.emplace_back(
-      bg::return_envelope<Segment2d>(segment), IdxForRTreeSegment(linestring.id(), i, i + 1));
-  }
-  return local_segments;
-}
 }  // namespace
 
 namespace autoware::boundary_departure_checker::utils
@@ -453,6 +435,19 @@ bool is_uncrossable_type(
       boundary_types_to_detect.end());
 };
 
+std::vector<SegmentWithIdx> create_local_segments(const lanelet::ConstLineString3d & linestring)
+{
+  std::vector<SegmentWithIdx> local_segments;
+  local_segments.reserve(linestring.size());
+  const auto basic_ls = linestring.basicLineString();
+  for (size_t i = 0; i + 1 < basic_ls.size(); ++i) {
+    const auto segment = to_segment_2d(basic_ls.at(i), basic_ls.at(i + 1));
+    local_segments.emplace_back(
+      bg::return_envelope<Segment2d>(segment), IdxForRTreeSegment(linestring.id(), i, i + 1));
+  }
+  return local_segments;
+}
+
 UncrossableBoundRTree build_uncrossable_boundaries_rtree(
   const lanelet::LaneletMap & lanelet_map,
   const std::vector<std::string> & boundary_types_to_detect)
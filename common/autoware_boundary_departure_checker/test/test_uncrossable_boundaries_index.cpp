@@ -0,0 +1,142 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/boundary_departure_checker/uncrossable_boundaries_index.hpp"
+#include "autoware/boundary_departure_checker/utils.hpp"
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using autoware::boundary_departure_checker::Point2d;
+using autoware::boundary_departure_checker::SegmentWithIdx;
+using autoware::boundary_departure_checker::UncrossableBoundariesIndex;
+using autoware::boundary_departure_checker::utils::build_uncrossable_boundaries_rtree;
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+// random walks of road borders and lane dividers in a 2 km square
+lanelet::LaneletMapPtr create_random_map(const int linestrings_num, const unsigned seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> start(0.0, 2000.0);
+  std::uniform_real_distribution<double> step(-30.0, 30.0);
+
+  auto map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::Id id = 1;
+  for (int i = 0; i < linestrings_num; ++i) {
+    lanelet::Points3d points;
+    double x = start(engine);
+    double y = start(engine);
+    for (int j = 0; j < 10; ++j) {
+      points.emplace_back(id++, x, y, 0.0);
+      x += step(engine);
+      y += step(engine);
+    }
+    const std::string type = i % 4 == 0 ? "line_thin" : "road_border";
+    map->add(lanelet::LineString3d(id++, points, lanelet::AttributeMap{{"type", type}}));
+  }
+  return map;
+}
+
+std::vector<double> to_distances(
+  const Point2d & point, const std::vector<SegmentWithIdx> & segments)
+{
+  std::vector<double> distances;
+  for (const auto & segment : segments) {
+    distances.push_back(bg::distance(point, segment.first));
+  }
+  std::sort(distances.begin(), distances.end());
+  return distances;
+}
+}  // namespace
+
+TEST(UncrossableBoundariesIndexTest, NearestMatchesFullRTree)
+{
+  const std::vector<std::string> types{"road_border"};
+  const auto map = create_random_map(500, 0);
+  const auto rtree = build_uncrossable_boundaries_rtree(*map, types);
+
+  for (const double tile_size_m : {20.0, 100.0, 5000.0}) {
+    const UncrossableBoundariesIndex index(map, types, tile_size_m);
+    EXPECT_EQ(index.built_tiles_num(), 0u);
+
+    std::mt19937 engine(1);
+    // include points outside of the map
+    std::uniform_real_distribution<double> coordinate(-500.0, 2500.0);
+    for (int i = 0; i < 200; ++i) {
+      const Point2d point(coordinate(engine), coordinate(engine));
+      for (const size_t k : {1u, 5u, 20u}) {
+        std::vector<SegmentWithIdx> expected;
+        rtree.query(bgi::nearest(point, static_cast<unsigned>(k)), std::back_inserter(expected));
+        const auto actual = index.nearest(point, k);
+
+        ASSERT_EQ(actual.size(), expected.size());
+        const auto expected_distances = to_distances(point, expected);
+        const auto actual_distances = to_distances(point, actual);
+        for (size_t j = 0; j < actual.size(); ++j) {
+          EXPECT_DOUBLE_EQ(actual_distances.at(j), expected_distances.at(j));
+        }
+      }
+    }
+    EXPECT_GT(index.built_tiles_num(), 0u);
+    EXPECT_LE(index.built_tiles_num(), index.tiles_num());
+  }
+}
+
+TEST(UncrossableBoundariesIndexTest, BuildAllTiles)
+{
+  const auto map = create_random_map(100, 2);
+  const UncrossableBoundariesIndex index(map, {"road_border"}, 100.0);
+  index.build_all_tiles();
+  EXPECT_EQ(index.built_tiles_num(), index.tiles_num());
+}
+
+TEST(UncrossableBoundariesIndexTest, NoUncrossableBoundaries)
+{
+  const auto map = create_random_map(10, 3);
+  const UncrossableBoundariesIndex index(map, {"curbstone"});
+  EXPECT_EQ(index.tiles_num(), 0u);
+  EXPECT_TRUE(index.nearest(Point2d(0.0, 0.0), 5).empty());
+}
+
+TEST(UncrossableBoundariesIndexTest, NullMap)
+{
+  EXPECT_THROW(UncrossableBoundariesIndex(nullptr, {"road_border"}), std::invalid_argument);
+}
+
+TEST(UncrossableBoundariesIndexTest, SharedPerMap)
+{
+  const std::vector<std::string> types{"road_border"};
+  const auto map = create_random_map(10, 4);
+  const auto index = UncrossableBoundariesIndex::get_shared(map, types);
+
+  EXPECT_EQ(UncrossableBoundariesIndex::get_shared(map, types), index);
+  EXPECT_NE(UncrossableBoundariesIndex::get_shared(map, {"road_border", "line_thin"}), index);
+
+  // a new map is indexed again even if it has the same content
+  const auto new_map = create_random_map(10, 4);
+  const auto new_index = UncrossableBoundariesIndex::get_shared(new_map, types);
+  EXPECT_NE(new_index, index);
+  EXPECT_EQ(new_index->lanelet_map_ptr(), new_map);
+}
@@ -21,6 +21,7 @@
 #include <grid_map_core/GridMapMath.hpp>
 #include <grid_map_core/Polygon.hpp>
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -42,6 +43,74 @@ struct Edge
   }
 };
 
+/// @brief Cells of a row of the grid map between two columns
+/// @details The indexes are the storage indexes of the grid map, i.e., the indexes of its
+/// grid_map::Matrix layers. Spans are split where the circular buffer of the grid map wraps around
+/// so that a span always corresponds to a single block of a layer.
+struct RowSpan
+{
+  int row;
+  int col_begin;
+  int col_end;  ///< past-the-end column
+};
+using RowSpans = std::vector<RowSpan>;
+
+/// @brief Calculate the row spans of the cells whose center is inside the polygon.
+/// @details The spans are calculated with the scan line algorithm and are ordered like the indexes
+/// returned by the PolygonIterator.
+/// @param grid_map the grid map.
+/// @param polygon the polygonal area.
+/// @return the spans of the cells inside the polygon.
+RowSpans calculateRowSpans(const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon);
+
+/// @brief Get the block of a layer corresponding to a span.
+/// @param matrix layer of the grid map.
+/// @param span span calculated on the same grid map.
+/// @return 1 x n block of the layer.
+template <typename MatrixT>
+auto spanBlock(MatrixT & matrix, const RowSpan & span)
+{
+  return matrix.block(span.row, span.col_begin, 1, span.col_end - span.col_begin);
+}
+
+/// @brief Set all the cells of the spans to a value.
+/// @param matrix layer of the grid map.
+/// @param spans spans calculated on the same grid map.
+/// @param value value to set.
+void fillRowSpans(grid_map::Matrix & matrix, const RowSpans & spans, float value);
+
+/// @brief Reduce all the cells of the spans with one block operation per span.
+/// @param matrix layer of the grid map.
+/// @param spans spans calculated on the same grid map.
+/// @param init initial value of the reduction.
+/// @param block_reduction reduction of a block, e.g., `[](const auto & b) { return b.sum(); }`.
+/// @param combine combination of two reduced values, e.g., `[](auto a, auto b) { return a + b; }`.
+/// @return the reduced value, init if there is no span.
+template <typename T, typename BlockReduction, typename Combine>
+T reduceRowSpans(
+  const grid_map::Matrix & matrix, const RowSpans & spans, T init,
+  const BlockReduction & block_reduction, const Combine & combine)
+{
+  for (const auto & span : spans) {
+    init = combine(init, block_reduction(spanBlock(matrix, span)));
+  }
+  return init;
+}
+
+/// @brief Test if any cell of the spans satisfies a predicate with one block operation per span.
+/// @param matrix layer of the grid map.
+/// @param spans spans calculated on the same grid map.
+/// @param block_predicate predicate on a block, e.g., `[](const auto & b) { return b.any(); }`.
+/// @return true if the predicate is true for any span.
+template <typename BlockPredicate>
+bool anyOfRowSpans(
+  const grid_map::Matrix & matrix, const RowSpans & spans, const BlockPredicate & block_predicate)
+{
+  return std::any_of(spans.begin(), spans.end(), [&](const RowSpan & span) {
+    return block_predicate(spanBlock(matrix, span));
+  });
+}
+
 /** @brief A polygon iterator for grid_map::GridMap based on the scan line algorithm.
     @details This iterator allows to iterate over all cells whose center is inside a polygon. \
              This reproduces the behavior of the original grid_map::PolygonIterator which uses\
@@ -53,8 +122,8 @@ class PolygonIterator
 {
 public:
   /// @brief Constructor.
-  /// @details Calculate the indexes of the gridmap that are inside the polygon using the scan line
-  /// algorithm.
+  /// @details Calculate the row spans of the gridmap that are inside the polygon using the scan
+  /// line algorithm.
   /// @param grid_map the grid map to iterate on.
   /// @param polygon the polygonal area to iterate on.
   PolygonIterator(const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon);
@@ -71,58 +140,17 @@ public:
   /// @brief Indicates if iterator is past end.
   /// @return true if iterator is out of scope, false if end has not been reached.
   [[nodiscard]] bool isPastEnd() const;
+  /// @brief Get the row spans visited by the iterator.
+  /// @return the spans of the cells inside the polygon.
+  [[nodiscard]] const RowSpans & getRowSpans() const { return spans_; }
 
 private:
-  /** @brief Calculate sorted edges of the given polygon.
-      @details Vertices in an edge are ordered from higher to lower x.
-              Edges are sorted in reverse lexicographical order of x.
-      @param polygon Polygon for which edges are calculated.
-      @return Sorted edges of the polygon.
-  */
-  static std::vector<Edge> calculateSortedEdges(const grid_map::Polygon & polygon);
-
-  /// @brief Calculates intersections between lines (i.e., center of rows) and the polygon edges.
-  /// @param edges Edges of the polygon.
-  /// @param from_to_row ranges of lines to use for intersection.
-  /// @param origin Position of the top-left cell in the grid map.
-  /// @param grid_map grid map.
-  /// @return for each row the vector of y values with an intersection.
-  static std::vector<std::vector<double>> calculateIntersectionsPerLine(
-    const std::vector<Edge> & edges, const std::pair<int, int> from_to_row,
-    const grid_map::Position & origin, const grid_map::GridMap & grid_map);
-
-  /// @brief Calculates the range of rows covering the given edges.
-  /// @details The rows are calculated without any shift that might exist in the grid map.
-  /// @param edges Edges of the polygon.
-  /// @param origin Position of the top-left cell in the grid map.
-  /// @param grid_map grid map.
-  /// @return the range of rows as a pair {first row, last row}.
-  static std::pair<int, int> calculateRowRange(
-    const std::vector<Edge> & edges, const grid_map::Position & origin,
-    const grid_map::GridMap & grid_map);
-
-  // Helper functions
-  /// @brief Increment the current_line_ to the line with intersections
-  void goToNextLine();
-  /// @brief Calculate the initial current_col_ and the current_to_col_ for the current intersection
-  void calculateColumnIndexes();
-  /// @brief Calculate the current_index_ from the current_line_ and current_col_
-  void calculateIndex();
-
-  /// Gridmap info
-  int row_of_first_line_;
-  grid_map::Index map_start_idx_;
-  grid_map::Size map_size_;
-  double map_resolution_;
-  double map_origin_y_;
-  /// Intersections between scan lines and the polygon
-  std::vector<std::vector<double>> intersections_per_line_;
-  std::vector<double>::const_iterator intersection_iter_;
+  /// Spans of the cells inside the polygon
+  RowSpans spans_;
   /// current indexes
   grid_map::Index current_index_;
-  size_t current_line_;
-  int current_col_;
-  int current_to_col_;
+  size_t current_span_{0};
+  int current_col_{0};
 };
 }  // namespace autoware::grid_map_utils
 
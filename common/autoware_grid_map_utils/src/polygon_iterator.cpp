@@ -25,8 +25,15 @@
 
 namespace autoware::grid_map_utils
 {
-
-std::vector<Edge> PolygonIterator::calculateSortedEdges(const grid_map::Polygon & polygon)
+namespace
+{
+/** @brief Calculate sorted edges of the given polygon.
+    @details Vertices in an edge are ordered from higher to lower x.
+            Edges are sorted in reverse lexicographical order of x.
+    @param polygon Polygon for which edges are calculated.
+    @return Sorted edges of the polygon.
+*/
+std::vector<Edge> calculateSortedEdges(const grid_map::Polygon & polygon)
 {
   std::vector<Edge> edges;
   edges.reserve(polygon.nVertices());
@@ -43,53 +50,56 @@ std::vector<Edge> PolygonIterator::calculateSortedEdges(const grid_map::Polygon
   return edges;
 }
 
-std::vector<std::vector<double>> PolygonIterator::calculateIntersectionsPerLine(
-  const std::vector<Edge> & edges, const std::pair<int, int> from_to_row,
-  const grid_map::Position & origin, const grid_map::GridMap & grid_map)
+/// @brief Calculates intersections between a line (i.e., center of a row) and the polygon edges.
+/// @param edges Edges of the polygon.
+/// @param row row of the line, without any shift that might exist in the grid map.
+/// @param origin Position of the top-left cell in the grid map.
+/// @param grid_map grid map.
+/// @param y_intersections [out] y values with an intersection in decreasing order.
+void calculateIntersectionsOfLine(
+  const std::vector<Edge> & edges, const int row, const grid_map::Position & origin,
+  const grid_map::GridMap & grid_map, std::vector<double> & y_intersections)
 {
-  const auto from_row = from_to_row.first;
-  const auto to_row = from_to_row.second;
-  // calculate for each line the y value intersecting with the polygon in decreasing order
-  std::vector<std::vector<double>> y_intersections_per_line;
-  y_intersections_per_line.reserve(to_row - from_row + 1);
-  for (auto row = from_row; row <= to_row; ++row) {
-    std::vector<double> y_intersections;
-    const auto line_x = origin.x() - grid_map.getResolution() * row;
-    for (const auto & edge : edges) {
-      // special case when exactly touching a vertex: only count edge for its lowest x
-      // up-down edge (\/) case: count the vertex twice
-      // down-down edge case: count the vertex only once
-      if (edge.second.x() == line_x) {
-        y_intersections.push_back(edge.second.y());
-      } else if (edge.first.x() >= line_x && edge.second.x() < line_x) {
-        const auto diff = edge.first - edge.second;
-        const auto y = edge.second.y() + (line_x - edge.second.x()) * diff.y() / diff.x();
-        y_intersections.push_back(y);
-      } else if (edge.first.x() < line_x) {  // edge below the line
-        break;
-      }
+  y_intersections.clear();
+  const auto line_x = origin.x() - grid_map.getResolution() * row;
+  for (const auto & edge : edges) {
+    // special case when exactly touching a vertex: only count edge for its lowest x
+    // up-down edge (\/) case: count the vertex twice
+    // down-down edge case: count the vertex only once
+    if (edge.second.x() == line_x) {
+      y_intersections.push_back(edge.second.y());
+    } else if (edge.first.x() >= line_x && edge.second.x() < line_x) {
+      const auto diff = edge.first - edge.second;
+      const auto y = edge.second.y() + (line_x - edge.second.x()) * diff.y() / diff.x();
+      y_intersections.push_back(y);
+    } else if (edge.first.x() < line_x) {  // edge below the line
+      break;
     }
-    std::sort(y_intersections.begin(), y_intersections.end(), std::greater());
-    // remove pairs outside of map
-    auto iter = y_intersections.cbegin();
-    while (iter != y_intersections.cend() && std::next(iter) != y_intersections.cend() &&
-           *iter >= origin.y() && *std::next(iter) >= origin.y()) {
-      iter = y_intersections.erase(iter);
-      iter = y_intersections.erase(iter);
-    }
-    iter = std::lower_bound(
-      y_intersections.cbegin(), y_intersections.cend(),
-      origin.y() - (grid_map.getSize()(1) - 1) * grid_map.getResolution(), std::greater());
-    while (iter != y_intersections.cend() && std::next(iter) != y_intersections.cend()) {
-      iter = y_intersections.erase(iter);
-      iter = y_intersections.erase(iter);
-    }
-    y_intersections_per_line.push_back(y_intersections);
   }
-  return y_intersections_per_line;
+  std::sort(y_intersections.begin(), y_intersections.end(), std::greater());
+  // remove pairs outside of map
+  auto iter = y_intersections.cbegin();
+  while (iter != y_intersections.cend() && std::next(iter) != y_intersections.cend() &&
+         *iter >= origin.y() && *std::next(iter) >= origin.y()) {
+    iter = y_intersections.erase(iter);
+    iter = y_intersections.erase(iter);
+  }
+  iter = std::lower_bound(
+    y_intersections.cbegin(), y_intersections.cend(),
+    origin.y() - (grid_map.getSize()(1) - 1) * grid_map.getResolution(), std::greater());
+  while (iter != y_intersections.cend() && std::next(iter) != y_intersections.cend()) {
+    iter = y_intersections.erase(iter);
+    iter = y_intersections.erase(iter);
+  }
 }
 
-std::pair<int, int> PolygonIterator::calculateRowRange(
+/// @brief Calculates the range of rows covering the given edges.
+/// @details The rows are calculated without any shift that might exist in the grid map.
+/// @param edges Edges of the polygon.
+/// @param origin Position of the top-left cell in the grid map.
+/// @param grid_map grid map.
+/// @return the range of rows as a pair {first row, last row}.
+std::pair<int, int> calculateRowRange(
   const std::vector<Edge> & edges, const grid_map::Position & origin,
   const grid_map::GridMap & grid_map)
 {
@@ -108,111 +118,100 @@ std::pair<int, int> PolygonIterator::calculateRowRange(
 
   return {min_row, max_row};
 }
+}  // namespace
 
-PolygonIterator::PolygonIterator(
-  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
+RowSpans calculateRowSpans(const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
 {
+  RowSpans spans;
   auto poly = polygon;
-  if (poly.nVertices() < 3) return;
+  if (poly.nVertices() < 3) return spans;
   // repeat the first vertex to get the last edge [last vertex, first vertex]
   if (poly.getVertex(0) != poly.getVertex(poly.nVertices() - 1)) poly.addVertex(poly.getVertex(0));
 
-  map_start_idx_ = grid_map.getStartIndex();
-  map_resolution_ = grid_map.getResolution();
-  map_size_ = grid_map.getSize();
-  const auto origin = [&]() {
-    grid_map::Position origin;
-    grid_map.getPosition(map_start_idx_, origin);
-    return origin;
-  }();
-  map_origin_y_ = origin.y();
+  const auto & map_start_idx = grid_map.getStartIndex();
+  const auto & map_size = grid_map.getSize();
+  const auto map_resolution = grid_map.getResolution();
+  grid_map::Position origin;
+  grid_map.getPosition(map_start_idx, origin);
 
   // We make line scan left -> right / up -> down *in the index frame* (idx[0,0] is pos[up, left]).
   // In the position frame, this corresponds to high -> low Y values and high -> low X values.
   const std::vector<Edge> edges = calculateSortedEdges(poly);
-  if (edges.empty()) return;
-  const auto from_to_row = calculateRowRange(edges, origin, grid_map);
-  intersections_per_line_ = calculateIntersectionsPerLine(edges, from_to_row, origin, grid_map);
-
-  row_of_first_line_ = from_to_row.first;
-  current_col_ = 0;
-  current_to_col_ = -1;
-  current_line_ = -1;  // goToNextLine() increments the line so assign -1 to start from 0
-
-  // Initialize iterator to the first (row,column) inside the Polygon
-  if (!intersections_per_line_.empty()) {
-    goToNextLine();
-    if (!isPastEnd()) {
-      calculateColumnIndexes();
-      calculateIndex();
+  if (edges.empty()) return spans;
+  const auto [from_row, to_row] = calculateRowRange(edges, origin, grid_map);
+
+  std::vector<double> y_intersections;
+  for (auto row = from_row; row <= to_row; ++row) {
+    calculateIntersectionsOfLine(edges, row, origin, grid_map, y_intersections);
+    auto map_row = map_start_idx(0) + row;
+    grid_map::wrapIndexToRange(map_row, map_size(0));
+    // each pair of intersections delimits the columns inside the polygon
+    for (size_t i = 0; i + 1 < y_intersections.size(); i += 2) {
+      const auto dist_from_origin = origin.y() - y_intersections[i] + map_resolution;
+      const auto from_col =
+        std::clamp(static_cast<int>(dist_from_origin / map_resolution), 0, map_size(1) - 1);
+      const auto dist_to_origin = origin.y() - y_intersections[i + 1];
+      const auto to_col =
+        std::clamp(static_cast<int>(dist_to_origin / map_resolution), 0, map_size(1) - 1);
+      // Case where intersections do not encompass the center of a cell
+      if (to_col < from_col) continue;
+
+      auto map_col = map_start_idx(1) + from_col;
+      grid_map::wrapIndexToRange(map_col, map_size(1));
+      const auto map_col_end = map_col + to_col - from_col + 1;
+      if (map_col_end <= map_size(1)) {
+        spans.push_back({map_row, map_col, map_col_end});
+      } else {
+        spans.push_back({map_row, map_col, map_size(1)});
+        spans.push_back({map_row, 0, map_col_end - map_size(1)});
+      }
     }
   }
+  return spans;
 }
 
-bool PolygonIterator::operator!=(const PolygonIterator & other) const
-{
-  return current_line_ != other.current_line_ || current_col_ != other.current_col_;
-}
-
-const grid_map::Index & PolygonIterator::operator*() const
+void fillRowSpans(grid_map::Matrix & matrix, const RowSpans & spans, const float value)
 {
-  return current_index_;
+  for (const auto & span : spans) {
+    spanBlock(matrix, span).setConstant(value);
+  }
 }
 
-void PolygonIterator::goToNextLine()
+PolygonIterator::PolygonIterator(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
+: spans_(calculateRowSpans(grid_map, polygon))
 {
-  ++current_line_;
-  while (current_line_ < intersections_per_line_.size() &&
-         intersections_per_line_[current_line_].size() < 2)
-    ++current_line_;
-  if (!isPastEnd()) intersection_iter_ = intersections_per_line_[current_line_].cbegin();
+  if (!isPastEnd()) {
+    current_col_ = spans_.front().col_begin;
+    current_index_ = grid_map::Index(spans_.front().row, current_col_);
+  }
 }
 
-void PolygonIterator::calculateColumnIndexes()
+bool PolygonIterator::operator!=(const PolygonIterator & other) const
 {
-  const auto dist_from_origin = map_origin_y_ - *intersection_iter_ + map_resolution_;
-  current_col_ =
-    std::clamp(static_cast<int>(dist_from_origin / map_resolution_), 0, map_size_(1) - 1);
-  ++intersection_iter_;
-  const auto dist_to_origin = map_origin_y_ - *intersection_iter_;
-  current_to_col_ =
-    std::clamp(static_cast<int>(dist_to_origin / map_resolution_), 0, map_size_(1) - 1);
-  // Case where intersections do not encompass the center of a cell: iterate again
-  if (current_to_col_ < current_col_) {
-    operator++();
-  }
+  return current_span_ != other.current_span_ || current_col_ != other.current_col_;
 }
 
-void PolygonIterator::calculateIndex()
+const grid_map::Index & PolygonIterator::operator*() const
 {
-  current_index_(0) = map_start_idx_(0) + row_of_first_line_ + static_cast<int>(current_line_);
-  grid_map::wrapIndexToRange(current_index_(0), map_size_(0));
-  current_index_(1) = map_start_idx_(1) + current_col_;
-  grid_map::wrapIndexToRange(current_index_(1), map_size_(1));
+  return current_index_;
 }
 
 PolygonIterator & PolygonIterator::operator++()
 {
   ++current_col_;
-  if (current_col_ > current_to_col_) {
-    ++intersection_iter_;
-    if (
-      intersection_iter_ == intersections_per_line_[current_line_].cend() ||
-      std::next(intersection_iter_) == intersections_per_line_[current_line_].cend()) {
-      goToNextLine();
-    }
-    if (!isPastEnd()) {
-      calculateColumnIndexes();
-    }
-  }
-  if (!isPastEnd()) {
-    calculateIndex();
+  if (current_col_ == spans_[current_span_].col_end) {
+    ++current_span_;
+    if (isPastEnd()) return *this;
+    current_col_ = spans_[current_span_].col_begin;
+    current_index_(0) = spans_[current_span_].row;
   }
+  current_index_(1) = current_col_;
   return *this;
 }
 
 [[nodiscard]] bool PolygonIterator::isPastEnd() const
 {
-  return current_line_ >= intersections_per_line_.size();
+  return current_span_ >= spans_.size();
 }
 }  // namespace autoware::grid_map_utils
@@ -45,7 +45,8 @@ int main(int argc, char * argv[])
   result_file.open("benchmark_results.csv");
   result_file
     << "#Size PolygonVertices PolygonIndexes grid_map_utils_constructor grid_map_utils_iteration "
-       "grid_map_constructor grid_map_iteration\n";
+       "grid_map_constructor grid_map_iteration grid_map_utils_row_spans grid_map_utils_fill "
+       "grid_map_utils_iterator_fill\n";
   autoware_utils::StopWatch<std::chrono::milliseconds> stopwatch;
 
   constexpr auto nb_iterations = 10;
@@ -98,6 +99,9 @@ int main(int argc, char * argv[])
       double grid_map_constructor_duration{};
       double grid_map_utils_iteration_duration{};
       double grid_map_iteration_duration{};
+      double grid_map_utils_row_spans_duration{};
+      double grid_map_utils_fill_duration{};
+      double grid_map_utils_iterator_fill_duration{};
 
       for (auto iteration = 0; iteration < nb_iterations; ++iteration) {
         map.setGeometry(grid_map::Length(10.0, 10.0), resolution, grid_map::Position(0.0, 0.0));
@@ -121,6 +125,24 @@ int main(int argc, char * argv[])
         stopwatch.tic("gm_ctor");
         grid_map::PolygonIterator grid_map_iterator(map, polygon);
         grid_map_constructor_duration += stopwatch.toc("gm_ctor");
+        // span API: calculate the spans then set the cells with one block operation per span
+        stopwatch.tic("gmu_spans");
+        const auto spans = autoware::grid_map_utils::calculateRowSpans(map, polygon);
+        grid_map_utils_row_spans_duration += stopwatch.toc("gmu_spans");
+        auto & layer = map["layer"];
+        stopwatch.tic("gmu_fill");
+        autoware::grid_map_utils::fillRowSpans(layer, spans, 1.0f);
+        grid_map_utils_fill_duration += stopwatch.toc("gmu_fill");
+        const auto nb_filled_cells = layer.sum();
+        layer.setZero();
+        // same operation with the per-cell iterator (construction included)
+        stopwatch.tic("gmu_iter_fill");
+        for (autoware::grid_map_utils::PolygonIterator iterator(map, polygon);
+             !iterator.isPastEnd(); ++iterator)
+          layer((*iterator)(0), (*iterator)(1)) = 1.0f;
+        grid_map_utils_iterator_fill_duration += stopwatch.toc("gmu_iter_fill");
+        layer.setZero();
+        auto nb_iterated_cells = 0.0f;
         bool diff = false;
         while (!grid_map_utils_iterator.isPastEnd() && !grid_map_iterator.isPastEnd()) {
           stopwatch.tic("gmu_iter");
@@ -132,12 +154,15 @@ int main(int argc, char * argv[])
           ++grid_map_iterator;
           grid_map_iteration_duration += stopwatch.toc("gm_iter");
           ++polygon_indexes;
+          ++nb_iterated_cells;
 
           if (gmu_idx.x() != gm_idx.x() || gmu_idx.y() != gm_idx.y()) {
             diff = true;
           }
         }
-        if (grid_map_iterator.isPastEnd() != grid_map_utils_iterator.isPastEnd()) {
+        if (
+          grid_map_iterator.isPastEnd() != grid_map_utils_iterator.isPastEnd() ||
+          nb_filled_cells != nb_iterated_cells) {
           diff = true;
         }
         if (diff || visualize) {
@@ -175,7 +200,10 @@ int main(int argc, char * argv[])
                   << " " << grid_map_utils_constructor_duration / nb_iterations << " "
                   << grid_map_utils_iteration_duration / nb_iterations << " "
                   << grid_map_constructor_duration / nb_iterations << " "
-                  << grid_map_iteration_duration / nb_iterations << "\n";
+                  << grid_map_iteration_duration / nb_iterations << " "
+                  << grid_map_utils_row_spans_duration / nb_iterations << " "
+                  << grid_map_utils_fill_duration / nb_iterations << " "
+                  << grid_map_utils_iterator_fill_duration / nb_iterations << "\n";
     }
   }
   result_file.close();
@@ -278,3 +278,76 @@ TEST(PolygonIterator, SelfCrossingPolygon)
   }
   EXPECT_FALSE(diff);
 }
+
+TEST(PolygonIterator, RowSpansWrapAround)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+  map.move(Position(2.0, 2.0));                                 // startIndex(6, 3)
+
+  // cover the 2 top rows of the map entirely
+  Polygon polygon;
+  polygon.addVertex(Position(6.1, 4.6));
+  polygon.addVertex(Position(4.1, 4.6));
+  polygon.addVertex(Position(4.1, -0.6));
+  polygon.addVertex(Position(6.1, -0.6));
+
+  // the rows are split where the columns wrap around
+  const auto spans = autoware::grid_map_utils::calculateRowSpans(map, polygon);
+  ASSERT_EQ(spans.size(), 4u);
+  const std::vector<std::vector<int>> expected_spans = {{6, 3, 5}, {6, 0, 3}, {7, 3, 5}, {7, 0, 3}};
+  for (size_t i = 0; i < spans.size(); ++i) {
+    EXPECT_EQ(spans[i].row, expected_spans[i][0]);
+    EXPECT_EQ(spans[i].col_begin, expected_spans[i][1]);
+    EXPECT_EQ(spans[i].col_end, expected_spans[i][2]);
+  }
+
+  // the iterator visits the cells of the spans in the same order
+  autoware::grid_map_utils::PolygonIterator iterator(map, polygon);
+  for (const auto & span : spans) {
+    for (auto col = span.col_begin; col < span.col_end; ++col) {
+      ASSERT_FALSE(iterator.isPastEnd());
+      EXPECT_EQ((*iterator)(0), span.row);
+      EXPECT_EQ((*iterator)(1), col);
+      ++iterator;
+    }
+  }
+  EXPECT_TRUE(iterator.isPastEnd());
+}
+
+TEST(PolygonIterator, RowSpansBlockOperations)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(10.0, 10.0), 0.1, Position(0.0, 0.0));
+  map.move(Position(1.23, -2.34));
+  map["layer"].setZero();
+
+  Polygon polygon;
+  polygon.addVertex(Position(3.0, 1.0));
+  polygon.addVertex(Position(-2.0, 4.0));
+  polygon.addVertex(Position(-4.0, -3.0));
+  polygon.addVertex(Position(1.0, -5.0));
+
+  const auto spans = autoware::grid_map_utils::calculateRowSpans(map, polygon);
+  auto & layer = map["layer"];
+  autoware::grid_map_utils::fillRowSpans(layer, spans, 1.0f);
+
+  // the same cells as the iterator are filled
+  float iterated_sum = 0.0f;
+  for (autoware::grid_map_utils::PolygonIterator iterator(map, polygon); !iterator.isPastEnd();
+       ++iterator) {
+    iterated_sum += map.at("layer", *iterator);
+  }
+  EXPECT_GT(iterated_sum, 0.0f);
+  EXPECT_EQ(iterated_sum, layer.sum());
+
+  const auto sum = autoware::grid_map_utils::reduceRowSpans(
+    layer, spans, 0.0f, [](const auto & block) { return block.sum(); },
+    [](const float a, const float b) { return a + b; });
+  EXPECT_EQ(sum, iterated_sum);
+
+  const auto is_empty = [](const auto & block) { return (block.array() == 0.0f).any(); };
+  EXPECT_FALSE(autoware::grid_map_utils::anyOfRowSpans(layer, spans, is_empty));
+  layer(spans.back().row, spans.back().col_end - 1) = 0.0f;
+  EXPECT_TRUE(autoware::grid_map_utils::anyOfRowSpans(layer, spans, is_empty));
+}
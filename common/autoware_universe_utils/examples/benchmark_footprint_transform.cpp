@@ -0,0 +1,109 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "autoware/universe_utils/geometry/geometry.hpp"
+#include "autoware/universe_utils/math/trigonometry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measure the batch APIs against the scalar ones they replace: sin_and_cos() of a vector of angles
+// against the table lookup per angle, and transformFootprints() against transformVector() per pose,
+// as done for the footprints along a trajectory.
+
+namespace
+{
+template <typename Function>
+double microseconds(Function function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+}  // namespace
+
+int main()
+{
+  using autoware::universe_utils::LinearRing2d;
+
+  std::mt19937 gen{};
+  std::uniform_real_distribution<float> angle(-3.2f, 3.2f);
+
+  for (const size_t size : {100u, 1000u, 10000u}) {
+    std::vector<float> radians(size);
+    for (auto & radian : radians) radian = angle(gen);
+
+    std::vector<float> sin_values;
+    std::vector<float> cos_values;
+    const auto batch_us = microseconds(
+      [&]() { autoware::universe_utils::sin_and_cos(radians, sin_values, cos_values); });
+
+    double max_error = 0.0;
+    float checksum = 0.0f;
+    const auto table_us = microseconds([&]() {
+      for (const auto radian : radians) {
+        const auto [sin_value, cos_value] = autoware::universe_utils::sin_and_cos(radian);
+        checksum += sin_value + cos_value;
+      }
+    });
+    for (size_t i = 0; i < size; ++i) {
+      const auto radian = static_cast<double>(radians[i]);
+      max_error = std::max(max_error, std::abs(std::sin(radian) - sin_values[i]));
+      max_error = std::max(max_error, std::abs(std::cos(radian) - cos_values[i]));
+    }
+
+    std::cout << size << " angles: sin_and_cos batch " << batch_us << " [us], table " << table_us
+              << " [us], batch max error " << max_error << " (checksum " << checksum << ")"
+              << std::endl;
+  }
+
+  LinearRing2d footprint;
+  footprint.emplace_back(4.0, 1.0);
+  footprint.emplace_back(4.0, 0.0);
+  footprint.emplace_back(4.0, -1.0);
+  footprint.emplace_back(0.0, -1.0);
+  footprint.emplace_back(-1.0, -1.0);
+  footprint.emplace_back(-1.0, 1.0);
+  footprint.emplace_back(0.0, 1.0);
+  footprint.emplace_back(4.0, 1.0);
+
+  for (const size_t size : {100u, 1000u, 10000u}) {
+    std::vector<geometry_msgs::msg::Pose> poses(size);
+    for (size_t i = 0; i < size; ++i) {
+      poses[i].position.x = static_cast<double>(i);
+      poses[i].orientation =
+        autoware::universe_utils::createQuaternionFromYaw(static_cast<double>(angle(gen)));
+    }
+
+    std::vector<LinearRing2d> batch;
+    const auto batch_us = microseconds(
+      [&]() { batch = autoware::universe_utils::transformFootprints(footprint, poses); });
+
+    std::vector<LinearRing2d> scalar;
+    const auto scalar_us = microseconds([&]() {
+      for (const auto & pose : poses) {
+        scalar.push_back(autoware::universe_utils::transformVector(
+          footprint, autoware::universe_utils::pose2transform(pose)));
+      }
+    });
+
+    std::cout << size << " footprints: transformFootprints " << batch_us
+              << " [us], transformVector " << scalar_us << " [us]" << std::endl;
+  }
+  return 0;
+}
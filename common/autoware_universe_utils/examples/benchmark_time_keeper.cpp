@@ -0,0 +1,83 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "autoware/universe_utils/system/lightweight_time_keeper.hpp"
+#include "autoware/universe_utils/system/time_keeper.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Measure the cost of one track (start and end) on the calling thread. A root scope wraps a loop of
+// tracked inner scopes, as planners do around hot loops. The time of reporting the tree is
+// included for TimeKeeper, which reports on the calling thread, and not for LightweightTimeKeeper,
+// which reports on its own thread.
+
+namespace
+{
+using autoware::universe_utils::LightweightScopedTimeTrack;
+using autoware::universe_utils::LightweightTimeKeeper;
+using autoware::universe_utils::ScopedTimeTrack;
+using autoware::universe_utils::TimeKeeper;
+
+template <typename Function>
+double nanoseconds_per_track(const int tracks, Function function)
+{
+  // Warm up to allocate the states of the calling thread
+  function();
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / tracks;
+}
+}  // namespace
+
+int main()
+{
+  constexpr int repeats = 100;
+
+  for (const int inner_tracks : {10, 100, 1000}) {
+    std::ostringstream time_keeper_output;
+    TimeKeeper time_keeper(&time_keeper_output);
+    const auto time_keeper_ns = nanoseconds_per_track(repeats * (inner_tracks + 1), [&]() {
+      for (int r = 0; r < repeats; ++r) {
+        ScopedTimeTrack root("root", time_keeper);
+        for (int i = 0; i < inner_tracks; ++i) {
+          ScopedTimeTrack inner("inner", time_keeper);
+        }
+      }
+    });
+
+    // Large enough not to drop the records between the reports
+    LightweightTimeKeeper::Options options;
+    options.ring_capacity = 1 << 18;
+    std::ostringstream lightweight_output;
+    LightweightTimeKeeper lightweight(options, &lightweight_output);
+    static const auto root_scope = LightweightTimeKeeper::register_scope("root");
+    static const auto inner_scope = LightweightTimeKeeper::register_scope("inner");
+    const auto lightweight_ns = nanoseconds_per_track(repeats * (inner_tracks + 1), [&]() {
+      for (int r = 0; r < repeats; ++r) {
+        LightweightScopedTimeTrack root(root_scope, lightweight);
+        for (int i = 0; i < inner_tracks; ++i) {
+          LightweightScopedTimeTrack inner(inner_scope, lightweight);
+        }
+      }
+    });
+
+    std::cout << inner_tracks << " inner tracks per root: TimeKeeper " << time_keeper_ns
+              << " [ns/track], LightweightTimeKeeper " << lightweight_ns << " [ns/track], dropped "
+              << lightweight.dropped_count() << std::endl;
+  }
+  return 0;
+}
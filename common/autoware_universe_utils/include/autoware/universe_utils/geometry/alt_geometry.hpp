@@ -17,7 +17,8 @@
 
 #include "autoware/universe_utils/geometry/boost_geometry.hpp"
 
-#include <list>
+#include <boost/container/small_vector.hpp>
+
 #include <optional>
 #include <utility>
 #include <vector>
@@ -90,7 +91,9 @@ inline Vector2d operator*(const double & s, const Vector2d & v)
 // as it has some vector operation functions.
 using Point2d = Vector2d;
 using Points2d = std::vector<Point2d>;
-using PointList2d = std::list<Point2d>;
+// Vertices of a ring are stored contiguously, and inline up to 8 points (including the closing
+// point) so that the footprints and the bounding boxes do not allocate.
+using PointList2d = boost::container::small_vector<Point2d, 8>;
 
 class Polygon2d
 {
@@ -159,6 +162,12 @@ void correct(alt::Polygon2d & poly);
 
 bool covered_by(const alt::Point2d & point, const alt::ConvexPolygon2d & poly);
 
+/**
+ * @brief Check if each of the points is covered by the polygon
+ * @details the bounding box of the polygon is computed once for all the points
+ */
+std::vector<bool> covered_by(const alt::Points2d & points, const alt::ConvexPolygon2d & poly);
+
 bool disjoint(const alt::ConvexPolygon2d & poly1, const alt::ConvexPolygon2d & poly2);
 
 double distance(
@@ -181,6 +190,13 @@ bool intersects(
 
 bool intersects(const alt::ConvexPolygon2d & poly1, const alt::ConvexPolygon2d & poly2);
 
+/**
+ * @brief Check if the polygon intersects each of the polygons
+ * @details the polygons whose bounding boxes are apart from that of poly are rejected before GJK
+ */
+std::vector<bool> intersects(
+  const alt::ConvexPolygon2d & poly, const std::vector<alt::ConvexPolygon2d> & polys);
+
 bool is_above(
   const alt::Point2d & point, const alt::Point2d & seg_start, const alt::Point2d & seg_end);
 
@@ -199,6 +215,13 @@ bool within(const alt::Point2d & point, const alt::ConvexPolygon2d & poly);
 
 bool within(
   const alt::ConvexPolygon2d & poly_contained, const alt::ConvexPolygon2d & poly_containing);
+
+/**
+ * @brief Check if the polygon is within each of the polygons
+ * @details the polygons whose bounding boxes do not contain that of poly are rejected first
+ */
+std::vector<bool> within(
+  const alt::ConvexPolygon2d & poly, const std::vector<alt::ConvexPolygon2d> & polys);
 }  // namespace autoware::universe_utils
 
 #endif  // AUTOWARE__UNIVERSE_UTILS__GEOMETRY__ALT_GEOMETRY_HPP_
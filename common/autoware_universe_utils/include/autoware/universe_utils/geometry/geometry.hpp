@@ -419,6 +419,18 @@ T transformVector(const T & points, const geometry_msgs::msg::Transform & transf
   return transformed;
 }
 
+/**
+ * @brief Transform a footprint to each of the poses
+ * @details The result is the same as transformVector(footprint, pose2transform(pose)) for each
+ * pose. The rotation of each pose is converted to a matrix once, instead of once per point, and the
+ * points are transformed in a loop that the compiler vectorizes.
+ * @param footprint footprint in the local frame
+ * @param poses poses of the footprint
+ * @return footprints in the frame of the poses
+ */
+std::vector<LinearRing2d> transformFootprints(
+  const LinearRing2d & footprint, const std::vector<geometry_msgs::msg::Pose> & poses);
+
 geometry_msgs::msg::Pose transformPose(
   const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::TransformStamped & transform);
 
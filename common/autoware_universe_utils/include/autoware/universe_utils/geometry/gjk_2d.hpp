@@ -15,6 +15,7 @@
 #ifndef AUTOWARE__UNIVERSE_UTILS__GEOMETRY__GJK_2D_HPP_
 #define AUTOWARE__UNIVERSE_UTILS__GEOMETRY__GJK_2D_HPP_
 
+#include "autoware/universe_utils/geometry/alt_geometry.hpp"
 #include "autoware/universe_utils/geometry/boost_geometry.hpp"
 
 namespace autoware::universe_utils::gjk
@@ -24,6 +25,13 @@ namespace autoware::universe_utils::gjk
  * @details much faster than boost::geometry::overlaps() but limited to convex polygons
  */
 bool intersects(const Polygon2d & convex_polygon1, const Polygon2d & convex_polygon2);
+
+/**
+ * @brief Check if 2 convex polygons intersect using the GJK algorithm
+ * @details same as above on the contiguous vertices of alt::ConvexPolygon2d
+ */
+bool intersects(
+  const alt::ConvexPolygon2d & convex_polygon1, const alt::ConvexPolygon2d & convex_polygon2);
 }  // namespace autoware::universe_utils::gjk
 
 #endif  // AUTOWARE__UNIVERSE_UTILS__GEOMETRY__GJK_2D_HPP_
@@ -0,0 +1,196 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef AUTOWARE__UNIVERSE_UTILS__SYSTEM__LIGHTWEIGHT_TIME_KEEPER_HPP_
+#define AUTOWARE__UNIVERSE_UTILS__SYSTEM__LIGHTWEIGHT_TIME_KEEPER_HPP_
+
+#include "autoware/universe_utils/system/time_keeper.hpp"
+
+#include <rclcpp/publisher.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autoware::universe_utils
+{
+/**
+ * @brief Low-overhead variant of TimeKeeper
+ *
+ * The names of the scopes are interned once by register_scope(), and start_track()/end_track()
+ * only write an (id, depth, start, end) record into a preallocated ring buffer of the calling
+ * thread, without allocation or lock. A background thread drains the rings, reconstructs the trees
+ * and reports them in the same format as TimeKeeper. Each thread has its own stack of scopes, so
+ * the trees of different threads are reported separately.
+ *
+ * When the ring of a thread is full, the records are dropped until the current root scope ends
+ * and the tree is not reported. Comments are not supported.
+ */
+class LightweightTimeKeeper
+{
+public:
+  using ScopeId = std::uint32_t;
+
+  struct Options
+  {
+    std::size_t ring_capacity{4096};  //!< Number of records per thread, rounded up to a power of 2
+    std::size_t max_depth{64};        //!< Deeper scopes are ignored
+    std::chrono::milliseconds report_period{100};  //!< Period of the background reporter
+  };
+
+  /**
+   * @brief Intern the name of a scope. Call it once per call site, e.g. by a static local variable.
+   *
+   * @param name Name of the scope
+   * @return ScopeId Same id for the same name
+   */
+  static ScopeId register_scope(const std::string & name);
+
+  /**
+   * @brief Construct a time keeper and start the background reporter without reporters
+   *
+   * @param options Options of the rings and the reporter
+   */
+  explicit LightweightTimeKeeper(const Options & options);
+
+  template <typename... Reporters>
+  explicit LightweightTimeKeeper(const Options & options, Reporters... reporters)
+  : LightweightTimeKeeper(options)
+  {
+    (add_reporter(reporters), ...);
+  }
+
+  template <typename... Reporters>
+  explicit LightweightTimeKeeper(Reporters... reporters)
+  : LightweightTimeKeeper(Options{}, reporters...)
+  {
+  }
+
+  /**
+   * @brief Stop the background reporter after reporting the remaining records
+   */
+  ~LightweightTimeKeeper();
+
+  LightweightTimeKeeper(const LightweightTimeKeeper &) = delete;
+  LightweightTimeKeeper & operator=(const LightweightTimeKeeper &) = delete;
+  LightweightTimeKeeper(LightweightTimeKeeper &&) = delete;
+  LightweightTimeKeeper & operator=(LightweightTimeKeeper &&) = delete;
+
+  /**
+   * @brief Add a reporter to output processing times to an ostream from the background thread
+   *
+   * @param os Pointer to the ostream object
+   */
+  void add_reporter(std::ostream * os);
+
+  /**
+   * @brief Add a reporter to publish processing times from the background thread
+   *
+   * @param publisher Shared pointer to the rclcpp publisher
+   */
+  void add_reporter(rclcpp::Publisher<ProcessingTimeDetail>::SharedPtr publisher);
+
+  /**
+   * @brief Start tracking the processing time of a scope on the calling thread
+   *
+   * @param scope_id Id returned by register_scope()
+   */
+  void start_track(ScopeId scope_id);
+
+  /**
+   * @brief End tracking the processing time of a scope on the calling thread
+   *
+   * @param scope_id Id passed to the corresponding start_track()
+   */
+  void end_track(ScopeId scope_id);
+
+  /**
+   * @brief Report the records written so far without waiting for the background reporter
+   */
+  void flush();
+
+  /**
+   * @brief Get the number of records dropped because a ring was full
+   */
+  std::uint64_t dropped_count() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+private:
+  struct Record
+  {
+    ScopeId scope_id;
+    std::uint32_t depth;  //!< Depth from the root scope, or incomplete_marker
+    std::int64_t start_ns;
+    std::int64_t end_ns;
+  };
+  //! Depth of the record telling the reporter to discard the records of an incomplete tree
+  static constexpr std::uint32_t incomplete_marker = 0xffffffffu;
+
+  struct ThreadState;
+
+  ThreadState & thread_state();
+  void drain();
+
+  const Options options_;
+  const std::uint64_t instance_id_{next_instance_id_++};
+  static inline std::atomic<std::uint64_t> next_instance_id_{0};
+
+  std::mutex threads_mutex_;
+  std::vector<std::unique_ptr<ThreadState>> threads_;
+  std::atomic<std::uint64_t> dropped_count_{0};
+
+  std::mutex report_mutex_;  //!< Serializes the drain and guards the reporters
+  std::vector<std::function<void(const std::shared_ptr<ProcessingTimeNode> &)>> reporters_;
+
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
+  bool stop_{false};
+  std::thread reporter_thread_;
+};
+
+/**
+ * @brief Class for automatically tracking the processing time of a scope with
+ * LightweightTimeKeeper
+ */
+class LightweightScopedTimeTrack
+{
+public:
+  LightweightScopedTimeTrack(
+    LightweightTimeKeeper::ScopeId scope_id, LightweightTimeKeeper & time_keeper)
+  : scope_id_(scope_id), time_keeper_(time_keeper)
+  {
+    time_keeper_.start_track(scope_id_);
+  }
+
+  LightweightScopedTimeTrack(const LightweightScopedTimeTrack &) = delete;
+  LightweightScopedTimeTrack & operator=(const LightweightScopedTimeTrack &) = delete;
+  LightweightScopedTimeTrack(LightweightScopedTimeTrack &&) = delete;
+  LightweightScopedTimeTrack & operator=(LightweightScopedTimeTrack &&) = delete;
+
+  ~LightweightScopedTimeTrack() { time_keeper_.end_track(scope_id_); }
+
+private:
+  const LightweightTimeKeeper::ScopeId scope_id_;
+  LightweightTimeKeeper & time_keeper_;
+};
+
+}  // namespace autoware::universe_utils
+
+#endif  // AUTOWARE__UNIVERSE_UTILS__SYSTEM__LIGHTWEIGHT_TIME_KEEPER_HPP_
@@ -21,6 +21,30 @@
 
 namespace autoware::universe_utils
 {
+namespace
+{
+struct BoundingBox
+{
+  double x_min;
+  double y_min;
+  double x_max;
+  double y_max;
+};
+
+BoundingBox bounding_box(const alt::PointList2d & vertices)
+{
+  BoundingBox box{
+    vertices.front().x(), vertices.front().y(), vertices.front().x(), vertices.front().y()};
+  for (const auto & vertex : vertices) {
+    box.x_min = std::min(box.x_min, vertex.x());
+    box.y_min = std::min(box.y_min, vertex.y());
+    box.x_max = std::max(box.x_max, vertex.x());
+    box.y_max = std::max(box.y_max, vertex.y());
+  }
+  return box;
+}
+}  // namespace
+
 // Alternatives for Boost.Geometry ----------------------------------------------------------------
 namespace alt
 {
@@ -66,6 +90,7 @@ std::optional<Polygon2d> Polygon2d::create(
   const autoware::universe_utils::Polygon2d & polygon) noexcept
 {
   PointList2d outer;
+  outer.reserve(polygon.outer().size() + 1);
   for (const auto & point : polygon.outer()) {
     outer.push_back(Point2d(point));
   }
@@ -76,13 +101,14 @@ std::optional<Polygon2d> Polygon2d::create(
     if (inner.empty()) {
       continue;
     }
+    _inner.reserve(inner.size() + 1);
     for (const auto & point : inner) {
       _inner.push_back(Point2d(point));
     }
-    inners.push_back(_inner);
+    inners.push_back(std::move(_inner));
   }
 
-  return Polygon2d::create(outer, inners);
+  return Polygon2d::create(std::move(outer), std::move(inners));
 }
 
 autoware::universe_utils::Polygon2d Polygon2d::to_boost() const
@@ -140,11 +166,12 @@ std::optional<ConvexPolygon2d> ConvexPolygon2d::create(
   const autoware::universe_utils::Polygon2d & polygon) noexcept
 {
   PointList2d vertices;
+  vertices.reserve(polygon.outer().size() + 1);
   for (const auto & point : polygon.outer()) {
     vertices.push_back(Point2d(point));
   }
 
-  return ConvexPolygon2d::create(vertices);
+  return ConvexPolygon2d::create(std::move(vertices));
 }
 }  // namespace alt
 
@@ -217,7 +244,7 @@ std::optional<alt::ConvexPolygon2d> convex_hull(const alt::Points2d & points)
     make_hull(make_hull, p_max, p_min, below_points);
   }
 
-  auto hull = alt::ConvexPolygon2d::create(vertices);
+  auto hull = alt::ConvexPolygon2d::create(std::move(vertices));
   if (!hull) {
     return std::nullopt;
   }
@@ -294,6 +321,27 @@ bool covered_by(const alt::Point2d & point, const alt::ConvexPolygon2d & poly)
   return winding_number != 0;
 }
 
+std::vector<bool> covered_by(const alt::Points2d & points, const alt::ConvexPolygon2d & poly)
+{
+  // the box is padded on both axes by the tolerance of equals() so that it never rejects a point
+  // that covered_by() finds on an edge
+  constexpr double epsilon = 1e-3;
+
+  const auto box = bounding_box(poly.vertices());
+  std::vector<bool> result(points.size(), false);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto & point = points[i];
+    if (
+      point.x() < box.x_min - epsilon || point.x() > box.x_max + epsilon ||
+      point.y() < box.y_min - epsilon || point.y() > box.y_max + epsilon) {
+      continue;
+    }
+    result[i] = covered_by(point, poly);
+  }
+
+  return result;
+}
+
 bool disjoint(const alt::ConvexPolygon2d & poly1, const alt::ConvexPolygon2d & poly2)
 {
   if (equals(poly1, poly2)) {
@@ -478,6 +526,24 @@ bool intersects(const alt::ConvexPolygon2d & poly1, const alt::ConvexPolygon2d &
   return true;
 }
 
+std::vector<bool> intersects(
+  const alt::ConvexPolygon2d & poly, const std::vector<alt::ConvexPolygon2d> & polys)
+{
+  const auto box = bounding_box(poly.vertices());
+  std::vector<bool> result(polys.size(), false);
+  for (size_t i = 0; i < polys.size(); ++i) {
+    const auto other_box = bounding_box(polys[i].vertices());
+    if (
+      box.x_max < other_box.x_min || other_box.x_max < box.x_min || box.y_max < other_box.y_min ||
+      other_box.y_max < box.y_min) {
+      continue;
+    }
+    result[i] = intersects(poly, polys[i]);
+  }
+
+  return result;
+}
+
 bool is_above(
   const alt::Point2d & point, const alt::Point2d & seg_start, const alt::Point2d & seg_end)
 {
@@ -649,4 +715,25 @@ bool within(
 
   return true;
 }
+
+std::vector<bool> within(
+  const alt::ConvexPolygon2d & poly, const std::vector<alt::ConvexPolygon2d> & polys)
+{
+  // same tolerance as equals()
+  constexpr double epsilon = 1e-3;
+
+  const auto box = bounding_box(poly.vertices());
+  std::vector<bool> result(polys.size(), false);
+  for (size_t i = 0; i < polys.size(); ++i) {
+    const auto other_box = bounding_box(polys[i].vertices());
+    if (
+      box.x_min < other_box.x_min - epsilon || box.x_max > other_box.x_max + epsilon ||
+      box.y_min < other_box.y_min - epsilon || box.y_max > other_box.y_max + epsilon) {
+      continue;
+    }
+    result[i] = within(poly, polys[i]);
+  }
+
+  return result;
+}
 }  // namespace autoware::universe_utils
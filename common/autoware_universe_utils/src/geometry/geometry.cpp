@@ -23,6 +23,7 @@
 #include <tf2/convert.h>
 
 #include <string>
+#include <vector>
 
 namespace tf2
 {
@@ -219,6 +220,45 @@ geometry_msgs::msg::Point32 transformPoint(
     .z(transformed_point.z);
 }
 
+std::vector<LinearRing2d> transformFootprints(
+  const LinearRing2d & footprint, const std::vector<geometry_msgs::msg::Pose> & poses)
+{
+  const size_t points_size = footprint.size();
+  std::vector<double> local_x(points_size);
+  std::vector<double> local_y(points_size);
+  for (size_t j = 0; j < points_size; ++j) {
+    local_x[j] = footprint[j].x();
+    local_y[j] = footprint[j].y();
+  }
+
+  std::vector<LinearRing2d> footprints(poses.size());
+  std::vector<double> x(points_size);
+  std::vector<double> y(points_size);
+  for (size_t i = 0; i < poses.size(); ++i) {
+    // Upper left 2x2 block of the rotation matrix of the quaternion, as the local z is 0
+    const auto & q = poses[i].orientation;
+    const double r00 = 1.0 - 2.0 * (q.y * q.y + q.z * q.z);
+    const double r01 = 2.0 * (q.x * q.y - q.z * q.w);
+    const double r10 = 2.0 * (q.x * q.y + q.z * q.w);
+    const double r11 = 1.0 - 2.0 * (q.x * q.x + q.z * q.z);
+    const double tx = poses[i].position.x;
+    const double ty = poses[i].position.y;
+
+    for (size_t j = 0; j < points_size; ++j) {
+      x[j] = r00 * local_x[j] + r01 * local_y[j] + tx;
+      y[j] = r10 * local_x[j] + r11 * local_y[j] + ty;
+    }
+
+    auto & transformed = footprints[i];
+    transformed.reserve(points_size);
+    for (size_t j = 0; j < points_size; ++j) {
+      transformed.emplace_back(x[j], y[j]);
+    }
+  }
+
+  return footprints;
+}
+
 geometry_msgs::msg::Pose transformPose(
   const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::TransformStamped & transform)
 {
@@ -23,30 +23,36 @@ namespace autoware::universe_utils::gjk
 
 namespace
 {
+// The helpers are templates so that they run on both Polygon2d and alt::ConvexPolygon2d, with
+// Point2d and alt::Point2d respectively.
+
 /// @brief structure with all variables updated during the GJK loop
 /// @details for performance we only want to reserve their space in memory once
+template <typename Point>
 struct SimplexSearch
 {
   // current triangle simplex
-  Point2d a;
-  Point2d b;
-  Point2d c;
-  Point2d co;                // vector from C to the origin
-  Point2d ca;                // vector from C to A
-  Point2d cb;                // vector from C to B
-  Point2d ca_perpendicular;  // perpendicular to CA
-  Point2d cb_perpendicular;  // perpendicular to CB
-  Point2d direction;         // current search direction
+  Point a;
+  Point b;
+  Point c;
+  Point co;                // vector from C to the origin
+  Point ca;                // vector from C to A
+  Point cb;                // vector from C to B
+  Point ca_perpendicular;  // perpendicular to CA
+  Point cb_perpendicular;  // perpendicular to CB
+  Point direction;         // current search direction
 };
 
 /// @brief calculate the dot product between 2 points
-double dot_product(const Point2d & p1, const Point2d & p2)
+template <typename Point>
+double dot_product(const Point & p1, const Point & p2)
 {
   return p1.x() * p2.x() + p1.y() * p2.y();
 }
 
 /// @brief calculate the index of the furthest polygon vertex in the given direction
-size_t furthest_vertex_idx(const Polygon2d & poly, const Point2d & direction)
+template <typename Polygon, typename Point>
+size_t furthest_vertex_idx(const Polygon & poly, const Point & direction)
 {
   auto furthest_distance = dot_product(poly.outer()[0], direction);
   size_t furthest_idx = 0UL;
@@ -61,31 +67,35 @@ size_t furthest_vertex_idx(const Polygon2d & poly, const Point2d & direction)
 }
 
 /// @brief calculate the next Minkowski difference vertex in the given direction
-Point2d support_vertex(const Polygon2d & poly1, const Polygon2d & poly2, const Point2d & direction)
+template <typename Polygon, typename Point>
+Point support_vertex(const Polygon & poly1, const Polygon & poly2, const Point & direction)
 {
-  const auto opposite_direction = Point2d(-direction.x(), -direction.y());
+  const auto opposite_direction = Point(-direction.x(), -direction.y());
   const auto idx1 = furthest_vertex_idx(poly1, direction);
   const auto idx2 = furthest_vertex_idx(poly2, opposite_direction);
-  return Point2d(
+  return Point(
     poly1.outer()[idx1].x() - poly2.outer()[idx2].x(),
     poly1.outer()[idx1].y() - poly2.outer()[idx2].y());
 }
 
 /// @brief return true if both points are in the same direction
-bool same_direction(const Point2d & p1, const Point2d & p2)
+template <typename Point>
+bool same_direction(const Point & p1, const Point & p2)
 {
   return dot_product(p1, p2) > 0.0;
 }
 
 /// @brief return the triple cross product of the given points
-Point2d cross_product(const Point2d & p1, const Point2d & p2, const Point2d & p3)
+template <typename Point>
+Point cross_product(const Point & p1, const Point & p2, const Point & p3)
 {
   const auto tmp = p1.x() * p2.y() - p1.y() * p2.x();
-  return Point2d(-p3.y() * tmp, p3.x() * tmp);
+  return Point(-p3.y() * tmp, p3.x() * tmp);
 }
 
 /// @brief update the search simplex and search direction to try to surround the origin
-bool update_search_simplex_and_direction(SimplexSearch & search)
+template <typename Point>
+bool update_search_simplex_and_direction(SimplexSearch<Point> & search)
 {
   bool continue_search = false;
   search.co.x() = -search.c.x();
@@ -111,21 +121,12 @@ bool update_search_simplex_and_direction(SimplexSearch & search)
   }
   return continue_search;
 }
-}  // namespace
 
-/// @brief return true if the two given polygons intersect
-/// @details if the intersection area is 0 (e.g., only one point or one edge intersect), the return
-/// value is false
-bool intersects(const Polygon2d & convex_polygon1, const Polygon2d & convex_polygon2)
+/// @brief search a simplex of the Minkowski difference surrounding the origin
+template <typename Point, typename Polygon>
+bool search_simplex(const Polygon & convex_polygon1, const Polygon & convex_polygon2)
 {
-  if (convex_polygon1.outer().empty() || convex_polygon2.outer().empty()) {
-    return false;
-  }
-  if (boost::geometry::equals(convex_polygon1, convex_polygon2)) {
-    return true;
-  }
-
-  SimplexSearch search;
+  SimplexSearch<Point> search;
   search.direction = {1.0, 0.0};
   search.a = support_vertex(convex_polygon1, convex_polygon2, search.direction);
   search.direction = {-search.a.x(), -search.a.y()};
@@ -134,8 +135,8 @@ bool intersects(const Polygon2d & convex_polygon1, const Polygon2d & convex_poly
                                                          // the origin
     return false;                                        // no collision
   }
-  Point2d ab = {search.b.x() - search.a.x(), search.b.y() - search.a.y()};
-  Point2d ao = {-search.a.x(), -search.a.y()};
+  Point ab = {search.b.x() - search.a.x(), search.b.y() - search.a.y()};
+  Point ao = {-search.a.x(), -search.a.y()};
   search.direction = cross_product(ab, ao, ab);
   bool continue_search = true;
   while (continue_search) {
@@ -147,4 +148,28 @@ bool intersects(const Polygon2d & convex_polygon1, const Polygon2d & convex_poly
   }
   return true;
 }
+}  // namespace
+
+/// @brief return true if the two given polygons intersect
+/// @details if the intersection area is 0 (e.g., only one point or one edge intersect), the return
+/// value is false
+bool intersects(const Polygon2d & convex_polygon1, const Polygon2d & convex_polygon2)
+{
+  if (convex_polygon1.outer().empty() || convex_polygon2.outer().empty()) {
+    return false;
+  }
+  if (boost::geometry::equals(convex_polygon1, convex_polygon2)) {
+    return true;
+  }
+  return search_simplex<Point2d>(convex_polygon1, convex_polygon2);
+}
+
+bool intersects(
+  const alt::ConvexPolygon2d & convex_polygon1, const alt::ConvexPolygon2d & convex_polygon2)
+{
+  if (equals(convex_polygon1, convex_polygon2)) {
+    return true;
+  }
+  return search_simplex<alt::Point2d>(convex_polygon1, convex_polygon2);
+}
 }  // namespace autoware::universe_utils::gjk
@@ -21,14 +21,18 @@ namespace autoware::universe_utils::sat
 
 namespace
 {
+// The helpers are templates so that they run on both Polygon2d and alt::ConvexPolygon2d.
+
 /// @brief calculate the edge normal of two points
-Point2d edge_normal(const Point2d & p1, const Point2d & p2)
+template <typename Point>
+Point edge_normal(const Point & p1, const Point & p2)
 {
   return {p2.y() - p1.y(), p1.x() - p2.x()};
 }
 
 /// @brief project a polygon onto an axis and return the minimum and maximum values
-std::pair<double, double> project_polygon(const Polygon2d & poly, const Point2d & axis)
+template <typename Polygon, typename Point>
+std::pair<double, double> project_polygon(const Polygon & poly, const Point & axis)
 {
   double min = poly.outer()[0].dot(axis);
   double max = min;
@@ -53,11 +57,12 @@ bool projections_overlap(
 
 /// @brief check is all edges of a polygon can be separated from the other polygon with a separating
 /// axis
-bool has_no_separating_axis(const Polygon2d & polygon, const Polygon2d & other)
+template <typename Polygon>
+bool has_no_separating_axis(const Polygon & polygon, const Polygon & other)
 {
   for (size_t i = 0; i < polygon.outer().size(); ++i) {
     const size_t next_i = (i + 1) % polygon.outer().size();
-    const Point2d edge = edge_normal(polygon.outer()[i], polygon.outer()[next_i]);
+    const auto edge = edge_normal(polygon.outer()[i], polygon.outer()[next_i]);
     const auto projection1 = project_polygon(polygon, edge);
     const auto projection2 = project_polygon(other, edge);
     if (!projections_overlap(projection1, projection2)) {
@@ -79,4 +84,11 @@ bool intersects(const Polygon2d & convex_polygon1, const Polygon2d & convex_poly
          has_no_separating_axis(convex_polygon2, convex_polygon1);
 }
 
+bool intersects(
+  const alt::ConvexPolygon2d & convex_polygon1, const alt::ConvexPolygon2d & convex_polygon2)
+{
+  return has_no_separating_axis(convex_polygon1, convex_polygon2) &&
+         has_no_separating_axis(convex_polygon2, convex_polygon1);
+}
+
 }  // namespace autoware::universe_utils::sat
@@ -19,6 +19,7 @@
 
 #include <cmath>
 #include <utility>
+#include <vector>
 
 namespace autoware::universe_utils
 {
@@ -73,6 +74,49 @@ std::pair<float, float> sin_and_cos(float radian)
   }
 }
 
+void sin_and_cos(
+  const std::vector<float> & radians, std::vector<float> & sin_values,
+  std::vector<float> & cos_values)
+{
+  // pi / 2 split into 3 parts so that the reduced angle is exact for moderate angles (Cody-Waite)
+  constexpr float two_over_pi = 0.636619772367581343f;
+  constexpr float pi_over_2_1 = 1.5703125f;
+  constexpr float pi_over_2_2 = 4.837512969970703125e-4f;
+  constexpr float pi_over_2_3 = 7.54978995489188216e-8f;
+
+  const size_t size = radians.size();
+  sin_values.resize(size);
+  cos_values.resize(size);
+  const float * in = radians.data();
+  float * sin_out = sin_values.data();
+  float * cos_out = cos_values.data();
+
+  // No branch nor table lookup in the loop so that it is vectorized
+  for (size_t i = 0; i < size; ++i) {
+    const float x = in[i];
+    const float q = x * two_over_pi;
+    const int quadrant = static_cast<int>(q + (q >= 0.f ? 0.5f : -0.5f));
+    const float k = static_cast<float>(quadrant);
+    const float r = ((x - k * pi_over_2_1) - k * pi_over_2_2) - k * pi_over_2_3;  // [-pi/4, pi/4]
+    const float r2 = r * r;
+
+    // minimax polynomials on [-pi/4, pi/4] from Cephes sinf and cosf
+    const float sin_r =
+      ((-1.9515295891e-4f * r2 + 8.3321608736e-3f) * r2 - 1.6666654611e-1f) * r2 * r + r;
+    const float cos_r =
+      ((2.443315711809948e-5f * r2 - 1.388731625493765e-3f) * r2 + 4.166664568298827e-2f) * r2 *
+        r2 -
+      0.5f * r2 + 1.f;
+
+    // x = r + quadrant * pi / 2
+    const bool swap = (quadrant & 1) != 0;
+    const float sin_x = swap ? cos_r : sin_r;
+    const float cos_x = swap ? sin_r : cos_r;
+    sin_out[i] = (quadrant & 2) != 0 ? -sin_x : sin_x;
+    cos_out[i] = ((quadrant + 1) & 2) != 0 ? -cos_x : cos_x;
+  }
+}
+
 // This code is modified from a part of the OpenCV project
 // (https://github.com/opencv/opencv/blob/4.x/modules/core/src/mathfuncs_core.simd.hpp). It is
 // subject to the license terms in the LICENSE file found in the top-level directory of this
@@ -0,0 +1,292 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/system/lightweight_time_keeper.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware::universe_utils
+{
+namespace
+{
+struct ScopeRegistry
+{
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string, LightweightTimeKeeper::ScopeId> ids;
+};
+
+ScopeRegistry & scope_registry()
+{
+  static ScopeRegistry registry;
+  return registry;
+}
+
+std::string scope_name(const LightweightTimeKeeper::ScopeId scope_id)
+{
+  auto & registry = scope_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return scope_id < registry.names.size() ? registry.names[scope_id] : "unknown";
+}
+
+std::int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+std::size_t round_up_to_power_of_two(const std::size_t value)
+{
+  std::size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+// Tree of the records reconstructed by the reporter
+struct TrackedScope
+{
+  LightweightTimeKeeper::ScopeId scope_id;
+  double processing_time;  // [ms]
+  std::vector<TrackedScope> children;
+};
+
+void build_children(const TrackedScope & scope, ProcessingTimeNode & node)
+{
+  for (const auto & child : scope.children) {
+    const auto child_node = node.add_child(scope_name(child.scope_id));
+    child_node->set_time(child.processing_time);
+    build_children(child, *child_node);
+  }
+}
+}  // namespace
+
+struct LightweightTimeKeeper::ThreadState
+{
+  struct Frame
+  {
+    ScopeId scope_id;
+    std::int64_t start_ns;
+  };
+
+  explicit ThreadState(const Options & options)
+  : records(round_up_to_power_of_two(std::max<std::size_t>(options.ring_capacity, 1))),
+    mask(records.size() - 1),
+    stack(options.max_depth)
+  {
+  }
+
+  // Ring buffer written by the owner thread and read by the reporter
+  std::vector<Record> records;
+  const std::size_t mask;
+  std::atomic<std::uint64_t> head{0};
+  std::atomic<std::uint64_t> tail{0};
+
+  // Used by the owner thread only
+  std::vector<Frame> stack;
+  std::size_t depth{0};
+  std::size_t ignored_depth{0};  // scopes deeper than max_depth
+  bool dropping{false};          // a record of the current tree has been dropped
+  bool marker_owed{false};       // incomplete records are in the ring without the marker
+
+  bool try_push(const Record & record)
+  {
+    const auto head_index = head.load(std::memory_order_relaxed);
+    if (head_index - tail.load(std::memory_order_acquire) == records.size()) {
+      return false;
+    }
+    records[head_index & mask] = record;
+    head.store(head_index + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Used by the reporter only. pending[d] holds the finished scopes at depth d whose parent has not
+  // finished yet, because the records are written in the order of the end of the scopes.
+  std::vector<std::vector<TrackedScope>> pending;
+};
+
+LightweightTimeKeeper::ScopeId LightweightTimeKeeper::register_scope(const std::string & name)
+{
+  auto & registry = scope_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto [iter, inserted] =
+    registry.ids.emplace(name, static_cast<ScopeId>(registry.names.size()));
+  if (inserted) {
+    registry.names.push_back(name);
+  }
+  return iter->second;
+}
+
+LightweightTimeKeeper::LightweightTimeKeeper(const Options & options) : options_(options)
+{
+  reporter_thread_ = std::thread([this]() {
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_) {
+      stop_cv_.wait_for(lock, options_.report_period, [this]() { return stop_; });
+      lock.unlock();
+      drain();
+      lock.lock();
+    }
+  });
+}
+
+LightweightTimeKeeper::~LightweightTimeKeeper()
+{
+  {
+    std::lock_guard<std::mutex> lock(stop_mutex_);
+    stop_ = true;
+  }
+  stop_cv_.notify_all();
+  reporter_thread_.join();
+  drain();
+}
+
+void LightweightTimeKeeper::add_reporter(std::ostream * os)
+{
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  reporters_.emplace_back([os](const std::shared_ptr<ProcessingTimeNode> & node) {
+    *os << "==========================" << std::endl;
+    *os << node->to_string() << std::endl;
+  });
+}
+
+void LightweightTimeKeeper::add_reporter(
+  rclcpp::Publisher<ProcessingTimeDetail>::SharedPtr publisher)
+{
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  reporters_.emplace_back([publisher](const std::shared_ptr<ProcessingTimeNode> & node) {
+    publisher->publish(node->to_msg());
+  });
+}
+
+LightweightTimeKeeper::ThreadState & LightweightTimeKeeper::thread_state()
+{
+  // The instance id instead of the address identifies the time keeper, because the address may be
+  // reused after the time keeper is destroyed.
+  thread_local std::vector<std::pair<std::uint64_t, ThreadState *>> states;
+  for (const auto & [instance_id, state] : states) {
+    if (instance_id == instance_id_) {
+      return *state;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(threads_mutex_);
+  threads_.push_back(std::make_unique<ThreadState>(options_));
+  states.emplace_back(instance_id_, threads_.back().get());
+  return *threads_.back();
+}
+
+void LightweightTimeKeeper::start_track(const ScopeId scope_id)
+{
+  auto & state = thread_state();
+  if (state.depth == state.stack.size()) {
+    ++state.ignored_depth;
+    return;
+  }
+  state.stack[state.depth++] = ThreadState::Frame{scope_id, now_ns()};
+}
+
+void LightweightTimeKeeper::end_track(const ScopeId scope_id)
+{
+  const auto end_ns = now_ns();
+  auto & state = thread_state();
+  if (state.ignored_depth > 0) {
+    --state.ignored_depth;
+    return;
+  }
+  if (state.depth == 0 || state.stack[state.depth - 1].scope_id != scope_id) {
+    throw std::runtime_error(fmt::format(
+      "end_track({}) is called without the corresponding start_track()", scope_name(scope_id)));
+  }
+
+  const auto & frame = state.stack[--state.depth];
+  const Record record{scope_id, static_cast<std::uint32_t>(state.depth), frame.start_ns, end_ns};
+  const bool is_root = state.depth == 0;
+
+  // Once a record is dropped, the records of the tree already in the ring are incomplete. A marker
+  // is written before the next record so that the reporter discards them, and the rest of the tree
+  // is dropped.
+  if (state.marker_owed && state.try_push(Record{0, incomplete_marker, 0, 0})) {
+    state.marker_owed = false;
+  }
+  if (state.dropping || state.marker_owed || !state.try_push(record)) {
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    if (!state.dropping) {
+      state.dropping = true;
+      state.marker_owed = true;
+    }
+  }
+  if (is_root) {
+    state.dropping = false;
+  }
+}
+
+void LightweightTimeKeeper::flush()
+{
+  drain();
+}
+
+void LightweightTimeKeeper::drain()
+{
+  std::lock_guard<std::mutex> report_lock(report_mutex_);
+
+  std::vector<ThreadState *> states;
+  {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    for (const auto & state : threads_) states.push_back(state.get());
+  }
+
+  for (auto * state : states) {
+    const auto head = state->head.load(std::memory_order_acquire);
+    auto & pending = state->pending;
+    for (auto index = state->tail.load(std::memory_order_relaxed); index < head; ++index) {
+      const auto & record = state->records[index & state->mask];
+      if (record.depth == incomplete_marker) {
+        pending.clear();
+        continue;
+      }
+
+      // The children of this scope have already finished at depth + 1.
+      const auto depth = record.depth;
+      if (pending.size() < depth + 2) pending.resize(depth + 2);
+      TrackedScope scope{
+        record.scope_id, static_cast<double>(record.end_ns - record.start_ns) * 1e-6,
+        std::move(pending[depth + 1])};
+      pending[depth + 1].clear();
+      pending[depth].push_back(std::move(scope));
+      if (depth != 0) continue;
+
+      const auto & root = pending[0].back();
+      const auto root_node = std::make_shared<ProcessingTimeNode>(scope_name(root.scope_id));
+      root_node->set_time(root.processing_time);
+      build_children(root, *root_node);
+      for (const auto & reporter : reporters_) {
+        reporter(root_node);
+      }
+      pending[0].clear();
+    }
+    state->tail.store(head, std::memory_order_release);
+  }
+}
+
+}  // namespace autoware::universe_utils
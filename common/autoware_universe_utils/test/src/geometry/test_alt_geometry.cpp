@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "autoware/universe_utils/geometry/alt_geometry.hpp"
+#include "autoware/universe_utils/geometry/gjk_2d.hpp"
 #include "autoware/universe_utils/geometry/random_convex_polygon.hpp"
+#include "autoware/universe_utils/geometry/sat_2d.hpp"
 #include "autoware/universe_utils/system/stop_watch.hpp"
 
 #include <boost/geometry/algorithms/convex_hull.hpp>
@@ -177,6 +179,32 @@ TEST(alt_geometry, coveredBy)
   }
 }
 
+TEST(alt_geometry, coveredByBatch)
+{
+  using autoware::universe_utils::covered_by;
+  using autoware::universe_utils::alt::ConvexPolygon2d;
+  using autoware::universe_utils::alt::Point2d;
+  using autoware::universe_utils::alt::Points2d;
+
+  const Point2d p1 = {0.0, 0.0};
+  const Point2d p2 = {0.0, 1.0};
+  const Point2d p3 = {1.0, 1.0};
+  const Point2d p4 = {1.0, 0.0};
+  const auto poly = ConvexPolygon2d::create({p1, p2, p3, p4}).value();
+
+  // The points on the edges and at the vertices are covered, the points just outside are not
+  const Points2d points = {
+    {0.5, 0.5},   {0.0, 0.5},        {1.0, 0.5}, {0.5, 0.0}, {0.5, 1.0}, {1.0, 1.0},
+    {-5e-4, 0.5}, {1.0 + 5e-4, 0.5}, {0.5, -5e-4}, {0.5, 1.0 + 5e-4}, {0.5, 1.1}, {1.1, 0.5}};
+  const auto result = covered_by(points, poly);
+
+  ASSERT_EQ(result.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(result[i], covered_by(points[i], poly)) << i;
+    EXPECT_EQ(result[i], i < 6) << i;
+  }
+}
+
 TEST(alt_geometry, disjoint)
 {
   using autoware::universe_utils::disjoint;
@@ -1164,3 +1192,178 @@ TEST(alt_geometry, withinPolygonRand)
       (alt_not_within_ns + alt_within_ns) / 1e6);
   }
 }
+
+TEST(alt_geometry, coveredByBatchRand)
+{
+  std::vector<autoware::universe_utils::Polygon2d> polygons;
+  constexpr auto polygons_nb = 100;
+  constexpr auto max_vertices = 10;
+  constexpr auto max_values = 1000;
+
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+  for (auto vertices = 3UL; vertices < max_vertices; ++vertices) {
+    double ground_truth_ns = 0.0;
+    double alt_ns = 0.0;
+    double alt_batch_ns = 0.0;
+
+    polygons.clear();
+    autoware::universe_utils::alt::Points2d points;
+    for (auto i = 0; i < polygons_nb; ++i) {
+      polygons.push_back(autoware::universe_utils::random_convex_polygon(vertices, max_values));
+      for (const auto & point : polygons.back().outer()) {
+        points.emplace_back(point);
+      }
+    }
+    for (auto j = 0UL; j < polygons.size(); ++j) {
+      const auto alt_poly =
+        autoware::universe_utils::alt::ConvexPolygon2d::create(polygons[j]).value();
+      sw.tic();
+      const auto alt_batch = autoware::universe_utils::covered_by(points, alt_poly);
+      alt_batch_ns += sw.toc();
+
+      ASSERT_EQ(alt_batch.size(), points.size());
+      for (auto i = 0UL; i < points.size(); ++i) {
+        const autoware::universe_utils::Point2d point(points[i].x(), points[i].y());
+        sw.tic();
+        const auto ground_truth = boost::geometry::covered_by(point, polygons[j]);
+        ground_truth_ns += sw.toc();
+
+        sw.tic();
+        const auto alt = autoware::universe_utils::covered_by(points[i], alt_poly);
+        alt_ns += sw.toc();
+
+        EXPECT_EQ(ground_truth, alt);
+        EXPECT_EQ(alt, alt_batch[i]);
+      }
+    }
+    std::printf("polygons_nb = %d, vertices = %ld\n", polygons_nb, vertices);
+    std::printf(
+      "\tCovered by:\n\t\tBoost::geometry = %2.2f ms\n\t\tAlt = %2.2f ms\n\t\tAlt batch = %2.2f "
+      "ms\n",
+      ground_truth_ns / 1e6, alt_ns / 1e6, alt_batch_ns / 1e6);
+  }
+}
+
+TEST(alt_geometry, intersectsBatchRand)
+{
+  std::vector<autoware::universe_utils::Polygon2d> polygons;
+  constexpr auto polygons_nb = 100;
+  constexpr auto max_vertices = 10;
+  constexpr auto max_values = 1000;
+
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+  for (auto vertices = 3UL; vertices < max_vertices; ++vertices) {
+    double ground_truth_ns = 0.0;
+    double alt_ns = 0.0;
+    double alt_batch_ns = 0.0;
+    double gjk_ns = 0.0;
+    double alt_gjk_ns = 0.0;
+    double sat_ns = 0.0;
+    double alt_sat_ns = 0.0;
+
+    polygons.clear();
+    std::vector<autoware::universe_utils::alt::ConvexPolygon2d> alt_polygons;
+    for (auto i = 0; i < polygons_nb; ++i) {
+      polygons.push_back(autoware::universe_utils::random_convex_polygon(vertices, max_values));
+      alt_polygons.push_back(
+        autoware::universe_utils::alt::ConvexPolygon2d::create(polygons.back()).value());
+    }
+    for (auto i = 0UL; i < polygons.size(); ++i) {
+      sw.tic();
+      const auto alt_batch = autoware::universe_utils::intersects(alt_polygons[i], alt_polygons);
+      alt_batch_ns += sw.toc();
+
+      ASSERT_EQ(alt_batch.size(), polygons.size());
+      for (auto j = 0UL; j < polygons.size(); ++j) {
+        sw.tic();
+        const auto ground_truth = boost::geometry::intersects(polygons[i], polygons[j]);
+        ground_truth_ns += sw.toc();
+
+        sw.tic();
+        const auto alt = autoware::universe_utils::intersects(alt_polygons[i], alt_polygons[j]);
+        alt_ns += sw.toc();
+
+        sw.tic();
+        const auto gjk = autoware::universe_utils::gjk::intersects(polygons[i], polygons[j]);
+        gjk_ns += sw.toc();
+
+        sw.tic();
+        const auto alt_gjk =
+          autoware::universe_utils::gjk::intersects(alt_polygons[i], alt_polygons[j]);
+        alt_gjk_ns += sw.toc();
+
+        sw.tic();
+        const auto sat = autoware::universe_utils::sat::intersects(polygons[i], polygons[j]);
+        sat_ns += sw.toc();
+
+        sw.tic();
+        const auto alt_sat =
+          autoware::universe_utils::sat::intersects(alt_polygons[i], alt_polygons[j]);
+        alt_sat_ns += sw.toc();
+
+        EXPECT_EQ(ground_truth, alt);
+        EXPECT_EQ(alt, alt_batch[j]);
+        EXPECT_EQ(gjk, alt_gjk);
+        EXPECT_EQ(sat, alt_sat);
+      }
+    }
+    std::printf("polygons_nb = %d, vertices = %ld\n", polygons_nb, vertices);
+    std::printf(
+      "\tIntersects:\n\t\tBoost::geometry = %2.2f ms\n\t\tAlt = %2.2f ms\n\t\tAlt batch = %2.2f "
+      "ms\n",
+      ground_truth_ns / 1e6, alt_ns / 1e6, alt_batch_ns / 1e6);
+    std::printf(
+      "\tGJK:\n\t\tBoost::geometry = %2.2f ms\n\t\tAlt = %2.2f ms\n", gjk_ns / 1e6,
+      alt_gjk_ns / 1e6);
+    std::printf(
+      "\tSAT:\n\t\tBoost::geometry = %2.2f ms\n\t\tAlt = %2.2f ms\n", sat_ns / 1e6,
+      alt_sat_ns / 1e6);
+  }
+}
+
+TEST(alt_geometry, withinBatchRand)
+{
+  std::vector<autoware::universe_utils::Polygon2d> polygons;
+  constexpr auto polygons_nb = 100;
+  constexpr auto max_vertices = 10;
+  constexpr auto max_values = 1000;
+
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+  for (auto vertices = 3UL; vertices < max_vertices; ++vertices) {
+    double ground_truth_ns = 0.0;
+    double alt_ns = 0.0;
+    double alt_batch_ns = 0.0;
+
+    polygons.clear();
+    std::vector<autoware::universe_utils::alt::ConvexPolygon2d> alt_polygons;
+    for (auto i = 0; i < polygons_nb; ++i) {
+      polygons.push_back(autoware::universe_utils::random_convex_polygon(vertices, max_values));
+      alt_polygons.push_back(
+        autoware::universe_utils::alt::ConvexPolygon2d::create(polygons.back()).value());
+    }
+    for (auto i = 0UL; i < polygons.size(); ++i) {
+      sw.tic();
+      const auto alt_batch = autoware::universe_utils::within(alt_polygons[i], alt_polygons);
+      alt_batch_ns += sw.toc();
+
+      ASSERT_EQ(alt_batch.size(), polygons.size());
+      for (auto j = 0UL; j < polygons.size(); ++j) {
+        sw.tic();
+        const auto ground_truth = boost::geometry::within(polygons[i], polygons[j]);
+        ground_truth_ns += sw.toc();
+
+        sw.tic();
+        const auto alt = autoware::universe_utils::within(alt_polygons[i], alt_polygons[j]);
+        alt_ns += sw.toc();
+
+        EXPECT_EQ(ground_truth, alt);
+        EXPECT_EQ(alt, alt_batch[j]);
+      }
+    }
+    std::printf("polygons_nb = %d, vertices = %ld\n", polygons_nb, vertices);
+    std::printf(
+      "\tWithin:\n\t\tBoost::geometry = %2.2f ms\n\t\tAlt = %2.2f ms\n\t\tAlt batch = %2.2f "
+      "ms\n",
+      ground_truth_ns / 1e6, alt_ns / 1e6, alt_batch_ns / 1e6);
+  }
+}
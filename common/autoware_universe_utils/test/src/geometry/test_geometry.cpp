@@ -1094,6 +1094,46 @@ TEST(geometry, transformVector)
   }
 }
 
+TEST(geometry, transformFootprints)
+{
+  using autoware::universe_utils::createQuaternionFromRPY;
+  using autoware::universe_utils::deg2rad;
+  using autoware::universe_utils::LinearRing2d;
+  using autoware::universe_utils::pose2transform;
+  using autoware::universe_utils::transformFootprints;
+  using autoware::universe_utils::transformVector;
+
+  LinearRing2d footprint;
+  footprint.emplace_back(4.0, 1.0);
+  footprint.emplace_back(4.0, -1.0);
+  footprint.emplace_back(-1.0, -1.0);
+  footprint.emplace_back(-1.0, 1.0);
+  footprint.emplace_back(4.0, 1.0);
+
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (int i = 0; i < 36; ++i) {
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = 10.0 * i;
+    pose.position.y = -5.0 * i;
+    pose.position.z = 1.0;
+    pose.orientation = createQuaternionFromRPY(deg2rad(i % 3), deg2rad(i % 5), deg2rad(10 * i));
+    poses.push_back(pose);
+  }
+
+  const auto footprints = transformFootprints(footprint, poses);
+  ASSERT_EQ(footprints.size(), poses.size());
+  for (size_t i = 0; i < poses.size(); ++i) {
+    const auto expected = transformVector(footprint, pose2transform(poses.at(i)));
+    ASSERT_EQ(footprints.at(i).size(), expected.size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+      EXPECT_NEAR(footprints.at(i).at(j).x(), expected.at(j).x(), epsilon);
+      EXPECT_NEAR(footprints.at(i).at(j).y(), expected.at(j).y(), epsilon);
+    }
+  }
+
+  EXPECT_TRUE(transformFootprints(footprint, {}).empty());
+}
+
 TEST(geometry, calcCurvature)
 {
   using autoware::universe_utils::calcCurvature;
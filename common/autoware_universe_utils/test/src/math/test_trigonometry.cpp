@@ -19,6 +19,7 @@
 
 #include <cmath>
 #include <random>
+#include <vector>
 
 TEST(trigonometry, sin)
 {
@@ -52,6 +53,32 @@ TEST(trigonometry, sin_and_cos)
   }
 }
 
+TEST(trigonometry, sin_and_cos_batch)
+{
+  // Default initialization ensures a constant seed needed for reproducible tests
+  std::mt19937 gen{};
+  std::uniform_real_distribution<float> dis(-100.0f, 100.0f);
+
+  std::vector<float> radians;
+  for (int i = 0; i < 1000; ++i) {
+    radians.push_back(dis(gen));
+  }
+  for (int i = -8; i <= 8; ++i) {
+    radians.push_back(static_cast<float>(autoware::universe_utils::pi / 4.0 * i));
+  }
+
+  std::vector<float> sin_values;
+  std::vector<float> cos_values;
+  autoware::universe_utils::sin_and_cos(radians, sin_values, cos_values);
+  ASSERT_EQ(sin_values.size(), radians.size());
+  ASSERT_EQ(cos_values.size(), radians.size());
+  for (size_t i = 0; i < radians.size(); ++i) {
+    // at least as accurate as the table
+    EXPECT_NEAR(std::sin(static_cast<double>(radians[i])), sin_values[i], 1e-6);
+    EXPECT_NEAR(std::cos(static_cast<double>(radians[i])), cos_values[i], 1e-6);
+  }
+}
+
 float normalize_angle(double angle)
 {
   const double tau = 2 * autoware::universe_utils::pi;
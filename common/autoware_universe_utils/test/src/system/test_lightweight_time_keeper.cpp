@@ -0,0 +1,133 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "autoware/universe_utils/system/lightweight_time_keeper.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware::universe_utils::LightweightScopedTimeTrack;
+using autoware::universe_utils::LightweightTimeKeeper;
+
+TEST(LightweightTimeKeeperTest, BasicFunctionality)
+{
+  static const auto main_func = LightweightTimeKeeper::register_scope("main_func");
+  static const auto func_a = LightweightTimeKeeper::register_scope("funcA");
+  static const auto func_b = LightweightTimeKeeper::register_scope("funcB");
+  EXPECT_EQ(LightweightTimeKeeper::register_scope("funcA"), func_a);
+
+  std::ostringstream oss;
+  {
+    LightweightTimeKeeper time_keeper(&oss);
+    {
+      LightweightScopedTimeTrack st{main_func, time_keeper};
+      {
+        LightweightScopedTimeTrack st{func_a, time_keeper};
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      {
+        LightweightScopedTimeTrack st{func_b, time_keeper};
+      }
+    }
+    time_keeper.flush();
+    EXPECT_EQ(time_keeper.dropped_count(), 0U);
+  }
+
+  // The children are reported in the order of the start under the root
+  const auto output = oss.str();
+  const auto main_pos = output.find("main_func");
+  const auto a_pos = output.find("├── funcA");
+  const auto b_pos = output.find("└── funcB");
+  ASSERT_NE(main_pos, std::string::npos);
+  ASSERT_NE(a_pos, std::string::npos);
+  ASSERT_NE(b_pos, std::string::npos);
+  EXPECT_LT(main_pos, a_pos);
+  EXPECT_LT(a_pos, b_pos);
+}
+
+TEST(LightweightTimeKeeperTest, MultiThread)
+{
+  static const auto thread_func = LightweightTimeKeeper::register_scope("ThreadFunction");
+  static const auto inner_func = LightweightTimeKeeper::register_scope("InnerFunction");
+
+  std::ostringstream oss;
+  {
+    LightweightTimeKeeper time_keeper(&oss);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&time_keeper]() {
+        for (int k = 0; k < 10; ++k) {
+          LightweightScopedTimeTrack st{thread_func, time_keeper};
+          LightweightScopedTimeTrack inner{inner_func, time_keeper};
+        }
+      });
+    }
+    for (auto & thread : threads) thread.join();
+  }
+
+  // Every tree of every thread is reported
+  const auto output = oss.str();
+  size_t count = 0;
+  for (auto pos = output.find("ThreadFunction"); pos != std::string::npos;
+       pos = output.find("ThreadFunction", pos + 1)) {
+    ++count;
+  }
+  EXPECT_EQ(count, 40U);
+}
+
+TEST(LightweightTimeKeeperTest, DropIncompleteTree)
+{
+  static const auto root = LightweightTimeKeeper::register_scope("Root");
+  static const auto child = LightweightTimeKeeper::register_scope("Child");
+
+  LightweightTimeKeeper::Options options;
+  options.ring_capacity = 4;
+  options.report_period = std::chrono::hours(1);
+
+  std::ostringstream oss;
+  LightweightTimeKeeper time_keeper(options, &oss);
+  {
+    LightweightScopedTimeTrack st{root, time_keeper};
+    for (int i = 0; i < 8; ++i) {
+      LightweightScopedTimeTrack st{child, time_keeper};
+    }
+  }
+  EXPECT_GT(time_keeper.dropped_count(), 0U);
+  time_keeper.flush();
+  EXPECT_EQ(oss.str().find("Root"), std::string::npos);
+
+  // The next tree is reported after the ring is drained
+  {
+    LightweightScopedTimeTrack st{root, time_keeper};
+    LightweightScopedTimeTrack inner{child, time_keeper};
+  }
+  time_keeper.flush();
+  EXPECT_NE(oss.str().find("Root"), std::string::npos);
+}
+
+TEST(LightweightTimeKeeperTest, MismatchedEnd)
+{
+  static const auto scope_a = LightweightTimeKeeper::register_scope("ScopeA");
+  static const auto scope_b = LightweightTimeKeeper::register_scope("ScopeB");
+
+  LightweightTimeKeeper time_keeper;
+  time_keeper.start_track(scope_a);
+  EXPECT_THROW(time_keeper.end_track(scope_b), std::runtime_error);
+  time_keeper.end_track(scope_a);
+}
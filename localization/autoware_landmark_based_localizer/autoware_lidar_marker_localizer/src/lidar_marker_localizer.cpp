@@ -86,6 +86,17 @@ LidarMarkerLocalizer::LidarMarkerLocalizer(const rclcpp::NodeOptions & node_opti
   ekf_pose_buffer_ = std::make_unique<autoware::localization_util::SmartPoseBuffer>(
     this->get_logger(), param_.self_pose_timeout_sec, param_.self_pose_distance_tolerance_m);
 
+  MarkerDetector::Param marker_detector_param;
+  marker_detector_param.resolution = param_.resolution;
+  marker_detector_param.intensity_pattern = param_.intensity_pattern;
+  marker_detector_param.match_intensity_difference_threshold =
+    param_.match_intensity_difference_threshold;
+  marker_detector_param.positive_match_num_threshold = param_.positive_match_num_threshold;
+  marker_detector_param.negative_match_num_threshold = param_.negative_match_num_threshold;
+  marker_detector_param.vote_threshold_for_detect_marker =
+    param_.vote_threshold_for_detect_marker;
+  marker_detector_ = std::make_unique<MarkerDetector>(marker_detector_param);
+
   rclcpp::CallbackGroup::SharedPtr points_callback_group;
   points_callback_group = this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
   auto points_sub_opt = rclcpp::SubscriptionOptions();
@@ -339,128 +350,39 @@ std::vector<landmark_manager::Landmark> LidarMarkerLocalizer::detect_landmarks(
   // TODO(YamatoAndo)
   // Transform sensor_frame to base_link
 
-  pcl::PointCloud<autoware::point_types::PointXYZIRC>::Ptr points_ptr(
-    new pcl::PointCloud<autoware::point_types::PointXYZIRC>);
-  pcl::fromROSMsg(*points_msg_ptr, *points_ptr);
+  std::vector<MarkerDetector::MarkerPosition> marker_positions;
+  const MarkerDetector::Status status = marker_detector_->detect(*points_msg_ptr, marker_positions);
 
-  if (points_ptr->empty()) {
-    RCLCPP_WARN_STREAM_THROTTLE(this->get_logger(), *this->get_clock(), 1000, "No points!");
+  if (status == MarkerDetector::Status::MISSING_FIELDS) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000, "x, y or intensity field is missing!");
     return std::vector<landmark_manager::Landmark>{};
   }
-
-  std::vector<pcl::PointCloud<autoware::point_types::PointXYZIRC>> ring_points(128);
-
-  float min_x = std::numeric_limits<float>::max();
-  float max_x = std::numeric_limits<float>::lowest();
-  for (const autoware::point_types::PointXYZIRC & point : points_ptr->points) {
-    ring_points[point.channel].push_back(point);
-    min_x = std::min(min_x, point.x);
-    max_x = std::max(max_x, point.x);
+  if (status == MarkerDetector::Status::INVALID_DATA) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000,
+      "The pointcloud data is smaller than its width, height and steps!");
+    return std::vector<landmark_manager::Landmark>{};
   }
-
-  // Check that the leaf size is not too small, given the size of the data
-  const int bin_num = static_cast<int>((max_x - min_x) / param_.resolution + 1);
-
-  if (bin_num < static_cast<int>(param_.intensity_pattern.size())) {
+  if (status == MarkerDetector::Status::NO_POINTS) {
+    RCLCPP_WARN_STREAM_THROTTLE(this->get_logger(), *this->get_clock(), 1000, "No points!");
+    return std::vector<landmark_manager::Landmark>{};
+  }
+  if (status == MarkerDetector::Status::TOO_FEW_BINS) {
     RCLCPP_WARN_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), 1000, "bin_num is too small!");
     return std::vector<landmark_manager::Landmark>{};
   }
 
-  // initialize variables
-  std::vector<int> vote(bin_num, 0);
-  std::vector<float> min_y(bin_num, std::numeric_limits<float>::max());
-
-  // for each channel
-  for (const pcl::PointCloud<autoware::point_types::PointXYZIRC> & one_ring : ring_points) {
-    std::vector<double> intensity_sum(bin_num, 0.0);
-    std::vector<int> intensity_num(bin_num, 0);
-    std::vector<double> average_intensity(bin_num, 0.0);
-
-    for (const autoware::point_types::PointXYZIRC & point : one_ring.points) {
-      const int bin_index = static_cast<int>((point.x - min_x) / param_.resolution);
-      intensity_sum[bin_index] += point.intensity;
-      intensity_num[bin_index]++;
-      min_y[bin_index] = std::min(min_y[bin_index], point.y);
-    }
-
-    // calc average
-    for (int bin_index = 0; bin_index < bin_num; bin_index++) {
-      if (intensity_num[bin_index] == 0) {
-        continue;
-      }
-
-      average_intensity[bin_index] = intensity_sum[bin_index] / intensity_num[bin_index];
-    }
-
-    // pattern matching
-    for (size_t i = 0; i <= bin_num - param_.intensity_pattern.size(); i++) {
-      int64_t pos = 0;
-      int64_t neg = 0;
-      double min_intensity = std::numeric_limits<double>::max();
-      double max_intensity = std::numeric_limits<double>::lowest();
-
-      // find max_min
-      for (size_t j = 0; j < param_.intensity_pattern.size(); j++) {
-        if (intensity_num[i + j] == 0) {
-          continue;
-        }
-
-        min_intensity = std::min(min_intensity, average_intensity[i + j]);
-        max_intensity = std::max(max_intensity, average_intensity[i + j]);
-      }
-
-      if (max_intensity <= min_intensity) {
-        continue;
-      }
-
-      const double center_intensity = (max_intensity - min_intensity) / 2.0 + min_intensity;
-
-      for (size_t j = 0; j < param_.intensity_pattern.size(); j++) {
-        if (intensity_num[i + j] == 0) {
-          continue;
-        }
-
-        if (param_.intensity_pattern[j] == 1) {
-          // check positive
-          if (
-            average_intensity[i + j] >
-            center_intensity + static_cast<double>(param_.match_intensity_difference_threshold)) {
-            pos++;
-          }
-        } else if (param_.intensity_pattern[j] == -1) {
-          // check negative
-          if (
-            average_intensity[i + j] <
-            center_intensity - static_cast<double>(param_.match_intensity_difference_threshold)) {
-            neg++;
-          }
-        } else {
-          // ignore param_.intensity_pattern[j] == 0
-        }
-      }
-
-      if (
-        pos >= param_.positive_match_num_threshold && neg >= param_.negative_match_num_threshold) {
-        vote[i]++;
-      }
-    }
-  }
-
   std::vector<landmark_manager::Landmark> detected_landmarks;
-
-  for (size_t i = 0; i < bin_num - param_.intensity_pattern.size(); i++) {
-    if (vote[i] > param_.vote_threshold_for_detect_marker) {
-      const double bin_position =
-        static_cast<double>(i) + static_cast<double>(param_.intensity_pattern.size()) / 2.0;
-      Pose marker_pose_on_base_link;
-      marker_pose_on_base_link.position.x = bin_position * param_.resolution + min_x;
-      marker_pose_on_base_link.position.y = min_y[i];
-      marker_pose_on_base_link.position.z = param_.marker_height_from_ground;
-      marker_pose_on_base_link.orientation =
-        autoware_utils::create_quaternion_from_rpy(M_PI_2, 0.0, 0.0);  // TODO(YamatoAndo)
-      detected_landmarks.push_back(landmark_manager::Landmark{"0", marker_pose_on_base_link});
-    }
+  for (const MarkerDetector::MarkerPosition & marker_position : marker_positions) {
+    Pose marker_pose_on_base_link;
+    marker_pose_on_base_link.position.x = marker_position.x;
+    marker_pose_on_base_link.position.y = marker_position.y;
+    marker_pose_on_base_link.position.z = param_.marker_height_from_ground;
+    marker_pose_on_base_link.orientation =
+      autoware_utils::create_quaternion_from_rpy(M_PI_2, 0.0, 0.0);  // TODO(YamatoAndo)
+    detected_landmarks.push_back(landmark_manager::Landmark{"0", marker_pose_on_base_link});
   }
 
   return detected_landmarks;
@@ -17,6 +17,7 @@
 
 #include "autoware/localization_util/smart_pose_buffer.hpp"
 #include "autoware_utils/ros/diagnostics_interface.hpp"
+#include "marker_detector.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -139,6 +140,7 @@ private:
   Param param_;
   bool is_activated_;
   std::unique_ptr<autoware::localization_util::SmartPoseBuffer> ekf_pose_buffer_;
+  std::unique_ptr<MarkerDetector> marker_detector_;
 
   landmark_manager::LandmarkManager landmark_manager_;
 };
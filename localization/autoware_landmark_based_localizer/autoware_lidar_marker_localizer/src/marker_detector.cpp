@@ -0,0 +1,396 @@
+// Copyright 2023 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "marker_detector.hpp"
+
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace autoware::lidar_marker_localizer
+{
+namespace
+{
+using sensor_msgs::msg::PointField;
+
+template <typename T>
+T read(const uint8_t * ptr)
+{
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  return value;
+}
+
+double read_as_double(const uint8_t * ptr, uint8_t datatype)
+{
+  switch (datatype) {
+    case PointField::UINT8:
+      return *ptr;
+    case PointField::INT8:
+      return read<int8_t>(ptr);
+    case PointField::UINT16:
+      return read<uint16_t>(ptr);
+    case PointField::INT16:
+      return read<int16_t>(ptr);
+    case PointField::UINT32:
+      return read<uint32_t>(ptr);
+    case PointField::INT32:
+      return read<int32_t>(ptr);
+    case PointField::FLOAT32:
+      return read<float>(ptr);
+    case PointField::FLOAT64:
+      return read<double>(ptr);
+    default:
+      return 0.0;
+  }
+}
+
+size_t datatype_size(uint8_t datatype)
+{
+  switch (datatype) {
+    case PointField::UINT8:
+    case PointField::INT8:
+      return 1;
+    case PointField::UINT16:
+    case PointField::INT16:
+      return 2;
+    case PointField::UINT32:
+    case PointField::INT32:
+    case PointField::FLOAT32:
+      return 4;
+    case PointField::FLOAT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+// Call f with the address of each point, the rows may be padded
+template <typename F>
+void for_each_point(const sensor_msgs::msg::PointCloud2 & points_msg, F && f)
+{
+  for (size_t row = 0; row < points_msg.height; ++row) {
+    const uint8_t * point = points_msg.data.data() + row * points_msg.row_step;
+    for (size_t col = 0; col < points_msg.width; ++col, point += points_msg.point_step) {
+      f(point);
+    }
+  }
+}
+}  // namespace
+
+MarkerDetector::MarkerDetector(const Param & param) : param_(param)
+{
+  for (size_t j = 0; j < param_.intensity_pattern.size(); j++) {
+    if (param_.intensity_pattern[j] == 1) {
+      positive_offsets_.push_back(j);
+    } else if (param_.intensity_pattern[j] == -1) {
+      negative_offsets_.push_back(j);
+    }
+  }
+
+  // The positive and negative matches are counted on distinct non-empty bins,
+  // and at least two non-empty bins are required to have different min and max.
+  min_valid_bin_num_ = static_cast<int>(std::max<int64_t>(
+    2, std::max<int64_t>(param_.positive_match_num_threshold, 0) +
+         std::max<int64_t>(param_.negative_match_num_threshold, 0)));
+}
+
+MarkerDetector::FieldLayout MarkerDetector::find_field_layout(
+  const sensor_msgs::msg::PointCloud2 & points_msg)
+{
+  FieldLayout layout;
+  for (const auto & field : points_msg.fields) {
+    if (field.name == "x" && field.datatype == PointField::FLOAT32) {
+      layout.x_offset = static_cast<int32_t>(field.offset);
+    } else if (field.name == "y" && field.datatype == PointField::FLOAT32) {
+      layout.y_offset = static_cast<int32_t>(field.offset);
+    } else if (field.name == "intensity") {
+      layout.intensity_offset = static_cast<int32_t>(field.offset);
+      layout.intensity_datatype = field.datatype;
+    } else if (field.name == "channel") {
+      layout.channel_offset = static_cast<int32_t>(field.offset);
+      layout.channel_datatype = field.datatype;
+    }
+  }
+  return layout;
+}
+
+bool MarkerDetector::is_valid_layout(
+  const sensor_msgs::msg::PointCloud2 & points_msg, const FieldLayout & layout)
+{
+  // Every field which is read must be inside a point
+  const size_t step = points_msg.point_step;
+  auto fits = [step](int32_t offset, size_t size) {
+    return offset < 0 || static_cast<size_t>(offset) + size <= step;
+  };
+  if (
+    !fits(layout.x_offset, sizeof(float)) || !fits(layout.y_offset, sizeof(float)) ||
+    !fits(layout.intensity_offset, datatype_size(layout.intensity_datatype)) ||
+    !fits(layout.channel_offset, datatype_size(layout.channel_datatype))) {
+    return false;
+  }
+
+  // Every point must be inside the buffer, a truncated message is not read at all
+  if (points_msg.height == 0 || points_msg.width == 0) {
+    return true;
+  }
+  const size_t row_size = static_cast<size_t>(points_msg.width) * step;
+  return points_msg.row_step >= row_size &&
+         points_msg.data.size() >=
+           static_cast<size_t>(points_msg.height - 1) * points_msg.row_step + row_size;
+}
+
+MarkerDetector::Status MarkerDetector::detect(
+  const sensor_msgs::msg::PointCloud2 & points_msg, std::vector<MarkerPosition> & markers)
+{
+  markers.clear();
+
+  const FieldLayout layout = find_field_layout(points_msg);
+  if (layout.x_offset < 0 || layout.y_offset < 0 || layout.intensity_offset < 0) {
+    return Status::MISSING_FIELDS;
+  }
+
+  if (!is_valid_layout(points_msg, layout)) {
+    return Status::INVALID_DATA;
+  }
+
+  const size_t point_num = static_cast<size_t>(points_msg.width) * points_msg.height;
+  if (point_num == 0) {
+    return Status::NO_POINTS;
+  }
+
+  auto channel_of = [&](const uint8_t * point) -> size_t {
+    // NOTE: all points are regarded as on one ring if the pointcloud has no channel
+    if (layout.channel_offset < 0) return 0;
+    return static_cast<size_t>(
+      read_as_double(point + layout.channel_offset, layout.channel_datatype));
+  };
+
+  // 1st pass: the range of x
+  float min_x = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  for_each_point(points_msg, [&](const uint8_t * point) {
+    const auto x = read<float>(point + layout.x_offset);
+    min_x = std::min(min_x, x);
+    max_x = std::max(max_x, x);
+  });
+
+  // Check that the leaf size is not too small, given the size of the data
+  const int pattern_size = static_cast<int>(param_.intensity_pattern.size());
+  bin_num_ = static_cast<int>((max_x - min_x) / param_.resolution + 1);
+  if (bin_num_ < pattern_size) {
+    return Status::TOO_FEW_BINS;
+  }
+  window_num_ = bin_num_ - pattern_size + 1;
+
+  // Reuse the buffers. assign() keeps the capacity.
+  // The number of rings is kept from the previous call and grown when a new channel appears.
+  const size_t bin_num = static_cast<size_t>(bin_num_);
+  size_t ring_num = ring_point_num_.size();
+  intensity_sum_.assign(ring_num * bin_num, 0.0);
+  intensity_num_.assign(ring_num * bin_num, 0);
+  ring_point_num_.assign(ring_num, 0);
+  min_y_.assign(bin_num, std::numeric_limits<float>::max());
+  vote_.assign(static_cast<size_t>(window_num_), 0);
+
+  // 2nd pass: accumulate the intensity into the rings x bins matrix
+  for_each_point(points_msg, [&](const uint8_t * point) {
+    const auto x = read<float>(point + layout.x_offset);
+    const auto y = read<float>(point + layout.y_offset);
+    const double intensity =
+      read_as_double(point + layout.intensity_offset, layout.intensity_datatype);
+    const size_t ring = channel_of(point);
+    const auto bin_index = static_cast<size_t>((x - min_x) / param_.resolution);
+
+    if (ring >= ring_num) {
+      // The matrix is ring major, so appending rows keeps the accumulated values
+      ring_num = ring + 1;
+      intensity_sum_.resize(ring_num * bin_num, 0.0);
+      intensity_num_.resize(ring_num * bin_num, 0);
+      ring_point_num_.resize(ring_num, 0);
+    }
+
+    intensity_sum_[ring * bin_num + bin_index] += intensity;
+    intensity_num_[ring * bin_num + bin_index]++;
+    ring_point_num_[ring]++;
+    min_y_[bin_index] = std::min(min_y_[bin_index], y);
+  });
+
+  // for each channel
+  for (size_t ring = 0; ring < ring_num; ++ring) {
+    if (ring_point_num_[ring] == 0) {
+      continue;
+    }
+    vote_ring(&intensity_sum_[ring * bin_num], &intensity_num_[ring * bin_num]);
+  }
+
+  for (int i = 0; i < bin_num_ - pattern_size; i++) {
+    if (vote_[i] > param_.vote_threshold_for_detect_marker) {
+      const double bin_position = static_cast<double>(i) + static_cast<double>(pattern_size) / 2.0;
+      markers.push_back(MarkerPosition{bin_position * param_.resolution + min_x, min_y_[i]});
+    }
+  }
+
+  return Status::SUCCEEDED;
+}
+
+void MarkerDetector::vote_ring(const double * intensity_sum, const uint32_t * intensity_num)
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const size_t bin_num = static_cast<size_t>(bin_num_);
+  const size_t window_num = static_cast<size_t>(window_num_);
+  const size_t pattern_size = param_.intensity_pattern.size();
+
+  average_low_.resize(bin_num);
+  average_high_.resize(bin_num);
+  valid_bin_count_.resize(bin_num + 1);
+  double * average_low = average_low_.data();
+  double * average_high = average_high_.data();
+  int * valid_bin_count = valid_bin_count_.data();
+
+  // calc average. Empty bins are excluded from min/max and matching by the infinities
+  for (size_t b = 0; b < bin_num; b++) {
+    const auto num = static_cast<int32_t>(intensity_num[b]);
+    const bool empty = num == 0;
+    const double average = intensity_sum[b] / static_cast<double>(empty ? 1 : num);
+    average_low[b] = empty ? inf : average;
+    average_high[b] = empty ? -inf : average;
+  }
+
+  // Windows which do not have enough non-empty bins never match the pattern
+  valid_bin_count[0] = 0;
+  for (size_t b = 0; b < bin_num; b++) {
+    valid_bin_count[b + 1] = valid_bin_count[b] + (intensity_num[b] == 0 ? 0 : 1);
+  }
+  candidate_windows_.clear();
+  for (size_t i = 0; i < window_num; i++) {
+    if (valid_bin_count[i + pattern_size] - valid_bin_count[i] >= min_valid_bin_num_) {
+      candidate_windows_.push_back(static_cast<int>(i));
+    }
+  }
+
+  // Rings far from the sensor are sparse, so only the candidates are evaluated for them
+  if (candidate_windows_.size() * 4 < window_num) {
+    vote_candidate_windows();
+  } else {
+    vote_all_windows();
+  }
+}
+
+void MarkerDetector::vote_candidate_windows()
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const double * average_low = average_low_.data();
+  const double * average_high = average_high_.data();
+  const auto threshold = static_cast<double>(param_.match_intensity_difference_threshold);
+
+  for (const int i : candidate_windows_) {
+    // find max_min
+    double min_intensity = inf;
+    double max_intensity = -inf;
+    for (size_t j = 0; j < param_.intensity_pattern.size(); j++) {
+      min_intensity = std::min(min_intensity, average_low[i + j]);
+      max_intensity = std::max(max_intensity, average_high[i + j]);
+    }
+
+    if (max_intensity <= min_intensity) {
+      continue;
+    }
+
+    // pattern matching
+    const double center_intensity = (max_intensity - min_intensity) / 2.0 + min_intensity;
+    int64_t pos = 0;
+    int64_t neg = 0;
+    for (const size_t j : positive_offsets_) {
+      pos += average_high[i + j] > center_intensity + threshold ? 1 : 0;
+    }
+    for (const size_t j : negative_offsets_) {
+      neg += average_low[i + j] < center_intensity - threshold ? 1 : 0;
+    }
+
+    if (pos >= param_.positive_match_num_threshold && neg >= param_.negative_match_num_threshold) {
+      vote_[i]++;
+    }
+  }
+}
+
+void MarkerDetector::vote_all_windows()
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const size_t window_num = static_cast<size_t>(window_num_);
+
+  // NOTE: The loops below work on raw pointers of contiguous buffers and have no branch so that
+  // the compiler can vectorize them. The window is slid as the inner loop.
+  window_min_.assign(window_num, inf);
+  window_max_.assign(window_num, -inf);
+  positive_threshold_.resize(window_num);
+  negative_threshold_.resize(window_num);
+  positive_num_.assign(window_num, 0.0);
+  negative_num_.assign(window_num, 0.0);
+  const double * average_low = average_low_.data();
+  const double * average_high = average_high_.data();
+  double * window_min = window_min_.data();
+  double * window_max = window_max_.data();
+  double * positive_threshold = positive_threshold_.data();
+  double * negative_threshold = negative_threshold_.data();
+  double * positive_num = positive_num_.data();
+  double * negative_num = negative_num_.data();
+  int * vote = vote_.data();
+
+  // find max_min
+  for (size_t j = 0; j < param_.intensity_pattern.size(); j++) {
+    const double * low = average_low + j;
+    const double * high = average_high + j;
+    for (size_t i = 0; i < window_num; i++) {
+      window_min[i] = low[i] < window_min[i] ? low[i] : window_min[i];
+      window_max[i] = high[i] > window_max[i] ? high[i] : window_max[i];
+    }
+  }
+
+  // pattern matching
+  const auto threshold = static_cast<double>(param_.match_intensity_difference_threshold);
+  for (size_t i = 0; i < window_num; i++) {
+    const double center_intensity = (window_max[i] - window_min[i]) / 2.0 + window_min[i];
+    positive_threshold[i] = center_intensity + threshold;
+    negative_threshold[i] = center_intensity - threshold;
+  }
+  for (const size_t j : positive_offsets_) {
+    const double * high = average_high + j;
+    for (size_t i = 0; i < window_num; i++) {
+      positive_num[i] += high[i] > positive_threshold[i] ? 1.0 : 0.0;
+    }
+  }
+  for (const size_t j : negative_offsets_) {
+    const double * low = average_low + j;
+    for (size_t i = 0; i < window_num; i++) {
+      negative_num[i] += low[i] < negative_threshold[i] ? 1.0 : 0.0;
+    }
+  }
+
+  const auto positive_match_num_threshold =
+    static_cast<double>(param_.positive_match_num_threshold);
+  const auto negative_match_num_threshold =
+    static_cast<double>(param_.negative_match_num_threshold);
+  for (size_t i = 0; i < window_num; i++) {
+    const bool matched = (window_min[i] < window_max[i]) &
+                         (positive_num[i] >= positive_match_num_threshold) &
+                         (negative_num[i] >= negative_match_num_threshold);
+    vote[i] += matched ? 1 : 0;
+  }
+}
+
+}  // namespace autoware::lidar_marker_localizer
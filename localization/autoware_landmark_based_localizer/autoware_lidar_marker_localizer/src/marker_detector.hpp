@@ -0,0 +1,111 @@
+// Copyright 2023 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MARKER_DETECTOR_HPP_
+#define MARKER_DETECTOR_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace autoware::lidar_marker_localizer
+{
+
+// Detect the intensity pattern of the marker by voting of each ring.
+// The points are read directly from PointCloud2 and accumulated into one rings x bins matrix which
+// is kept across calls, so that no memory is allocated once the matrix has grown enough.
+class MarkerDetector
+{
+public:
+  struct Param
+  {
+    double resolution;
+    std::vector<int64_t> intensity_pattern;
+    int64_t match_intensity_difference_threshold;
+    int64_t positive_match_num_threshold;
+    int64_t negative_match_num_threshold;
+    int64_t vote_threshold_for_detect_marker;
+  };
+
+  enum class Status { SUCCEEDED, NO_POINTS, TOO_FEW_BINS, MISSING_FIELDS, INVALID_DATA };
+
+  // Position of the detected marker on the frame of the input pointcloud
+  struct MarkerPosition
+  {
+    double x;
+    double y;
+  };
+
+  explicit MarkerDetector(const Param & param);
+
+  Status detect(
+    const sensor_msgs::msg::PointCloud2 & points_msg, std::vector<MarkerPosition> & markers);
+
+private:
+  // Offsets and datatypes of the fields in PointCloud2
+  struct FieldLayout
+  {
+    int32_t x_offset{-1};
+    int32_t y_offset{-1};
+    int32_t intensity_offset{-1};
+    uint8_t intensity_datatype{0};
+    int32_t channel_offset{-1};
+    uint8_t channel_datatype{0};
+  };
+
+  static FieldLayout find_field_layout(const sensor_msgs::msg::PointCloud2 & points_msg);
+  // Whether the fields are inside point_step and the points are inside the data
+  static bool is_valid_layout(
+    const sensor_msgs::msg::PointCloud2 & points_msg, const FieldLayout & layout);
+
+  // Vote the windows of one ring whose intensity matches the pattern
+  void vote_ring(const double * intensity_sum, const uint32_t * intensity_num);
+  void vote_candidate_windows();
+  void vote_all_windows();
+
+  Param param_;
+  std::vector<size_t> positive_offsets_;
+  std::vector<size_t> negative_offsets_;
+  int min_valid_bin_num_;
+
+  int bin_num_{0};
+  int window_num_{0};
+
+  // rings x bins matrices
+  std::vector<double> intensity_sum_;
+  std::vector<uint32_t> intensity_num_;
+  std::vector<uint32_t> ring_point_num_;
+
+  // bins
+  std::vector<float> min_y_;
+  std::vector<double> average_low_;   // average intensity, +inf for empty bins
+  std::vector<double> average_high_;  // average intensity, -inf for empty bins
+  std::vector<int> valid_bin_count_;  // prefix sum of non-empty bins
+
+  // windows
+  std::vector<int> vote_;
+  std::vector<int> candidate_windows_;
+  std::vector<double> window_min_;
+  std::vector<double> window_max_;
+  std::vector<double> positive_threshold_;
+  std::vector<double> negative_threshold_;
+  // NOTE: counted in double to keep the same vector width as the intensity
+  std::vector<double> positive_num_;
+  std::vector<double> negative_num_;
+};
+
+}  // namespace autoware::lidar_marker_localizer
+
+#endif  // MARKER_DETECTOR_HPP_
@@ -0,0 +1,98 @@
+// Copyright 2023 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/marker_detector.hpp"
+
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measure the detection time on a synthetic 128 ring scan with one retroreflective marker.
+
+using autoware::lidar_marker_localizer::MarkerDetector;
+using sensor_msgs::msg::PointCloud2;
+
+PointCloud2 create_scan(float range, int ring_num, int points_per_ring)
+{
+  PointCloud2 msg;
+  sensor_msgs::PointCloud2Modifier modifier(msg);
+  modifier.setPointCloud2Fields(
+    4, "x", 1, sensor_msgs::msg::PointField::FLOAT32, "y", 1,
+    sensor_msgs::msg::PointField::FLOAT32, "intensity", 1, sensor_msgs::msg::PointField::UINT8,
+    "channel", 1, sensor_msgs::msg::PointField::UINT16);
+  modifier.resize(static_cast<size_t>(ring_num) * points_per_ring);
+
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<float> x_distribution(-range, range);
+  std::uniform_real_distribution<float> y_distribution(-5.f, 5.f);
+  std::uniform_int_distribution<int> intensity_distribution(0, 40);
+
+  sensor_msgs::PointCloud2Iterator<float> x(msg, "x");
+  sensor_msgs::PointCloud2Iterator<float> y(msg, "y");
+  sensor_msgs::PointCloud2Iterator<uint8_t> intensity(msg, "intensity");
+  sensor_msgs::PointCloud2Iterator<uint16_t> channel(msg, "channel");
+  for (int ring = 0; ring < ring_num; ++ring) {
+    for (int i = 0; i < points_per_ring; ++i, ++x, ++y, ++intensity, ++channel) {
+      *x = x_distribution(engine);
+      *y = y_distribution(engine);
+      *intensity = static_cast<uint8_t>(intensity_distribution(engine));
+      *channel = static_cast<uint16_t>(ring);
+      // a bright band of the marker at x = 3.0 on the middle rings
+      if (ring > 40 && ring < 80 && std::abs(*x - 3.f) < 0.12f) {
+        *intensity = 200;
+      }
+    }
+  }
+  return msg;
+}
+
+int main()
+{
+  MarkerDetector::Param param;
+  param.resolution = 0.05;
+  param.intensity_pattern = {-1, -1, 0, 1, 1, 1, 1, 1, 0, -1, -1};
+  param.match_intensity_difference_threshold = 20;
+  param.positive_match_num_threshold = 3;
+  param.negative_match_num_threshold = 3;
+  param.vote_threshold_for_detect_marker = 20;
+
+  constexpr int iterations = 100;
+  for (const float range : {40.f, 100.f}) {
+    const PointCloud2 scan = create_scan(range, 128, 1800);
+    MarkerDetector detector(param);
+    std::vector<MarkerDetector::MarkerPosition> markers;
+    // The first call grows the internal buffers
+    detector.detect(scan, markers);
+
+    double mean_ms = 0.0;
+    double max_ms = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      detector.detect(scan, markers);
+      const auto end = std::chrono::steady_clock::now();
+      const double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+      mean_ms += elapsed / iterations;
+      max_ms = std::max(max_ms, elapsed);
+    }
+    std::cout << "range +-" << range << " [m] points " << scan.width << " markers "
+              << markers.size() << " mean " << mean_ms << " [ms] max " << max_ms << " [ms]"
+              << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,385 @@
+// Copyright 2023 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/marker_detector.hpp"
+
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using autoware::lidar_marker_localizer::MarkerDetector;
+using sensor_msgs::msg::PointCloud2;
+using sensor_msgs::msg::PointField;
+
+namespace
+{
+struct Point
+{
+  float x;
+  float y;
+  double intensity;
+  uint32_t channel;
+};
+
+MarkerDetector::Param create_param()
+{
+  MarkerDetector::Param param;
+  param.resolution = 0.05;
+  param.intensity_pattern = {-1, -1, 0, 1, 1, 1, 1, 1, 0, -1, -1};
+  param.match_intensity_difference_threshold = 20;
+  param.positive_match_num_threshold = 3;
+  param.negative_match_num_threshold = 3;
+  param.vote_threshold_for_detect_marker = 20;
+  return param;
+}
+
+// The detection before the rings x bins matrix: each ring is binned and matched on its own. The
+// rings are kept in a map so that any channel can be compared, the previous implementation had
+// 128 fixed rings.
+std::vector<MarkerDetector::MarkerPosition> detect_per_ring(
+  const MarkerDetector::Param & param, const std::vector<Point> & points)
+{
+  std::map<uint32_t, std::vector<Point>> ring_points;
+  float min_x = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  for (const Point & point : points) {
+    ring_points[point.channel].push_back(point);
+    min_x = std::min(min_x, point.x);
+    max_x = std::max(max_x, point.x);
+  }
+
+  const int bin_num = static_cast<int>((max_x - min_x) / param.resolution + 1);
+  const size_t pattern_size = param.intensity_pattern.size();
+  if (bin_num < static_cast<int>(pattern_size)) return {};
+
+  std::vector<int> vote(bin_num, 0);
+  std::vector<float> min_y(bin_num, std::numeric_limits<float>::max());
+  for (const auto & [channel, one_ring] : ring_points) {
+    std::vector<double> intensity_sum(bin_num, 0.0);
+    std::vector<int> intensity_num(bin_num, 0);
+    std::vector<double> average_intensity(bin_num, 0.0);
+
+    for (const Point & point : one_ring) {
+      const int bin_index = static_cast<int>((point.x - min_x) / param.resolution);
+      intensity_sum[bin_index] += point.intensity;
+      intensity_num[bin_index]++;
+      min_y[bin_index] = std::min(min_y[bin_index], point.y);
+    }
+    for (int bin_index = 0; bin_index < bin_num; bin_index++) {
+      if (intensity_num[bin_index] == 0) continue;
+      average_intensity[bin_index] = intensity_sum[bin_index] / intensity_num[bin_index];
+    }
+
+    for (size_t i = 0; i <= bin_num - pattern_size; i++) {
+      int64_t pos = 0;
+      int64_t neg = 0;
+      double min_intensity = std::numeric_limits<double>::max();
+      double max_intensity = std::numeric_limits<double>::lowest();
+      for (size_t j = 0; j < pattern_size; j++) {
+        if (intensity_num[i + j] == 0) continue;
+        min_intensity = std::min(min_intensity, average_intensity[i + j]);
+        max_intensity = std::max(max_intensity, average_intensity[i + j]);
+      }
+      if (max_intensity <= min_intensity) continue;
+
+      const double center_intensity = (max_intensity - min_intensity) / 2.0 + min_intensity;
+      const auto threshold = static_cast<double>(param.match_intensity_difference_threshold);
+      for (size_t j = 0; j < pattern_size; j++) {
+        if (intensity_num[i + j] == 0) continue;
+        if (param.intensity_pattern[j] == 1) {
+          pos += average_intensity[i + j] > center_intensity + threshold ? 1 : 0;
+        } else if (param.intensity_pattern[j] == -1) {
+          neg += average_intensity[i + j] < center_intensity - threshold ? 1 : 0;
+        }
+      }
+      if (pos >= param.positive_match_num_threshold && neg >= param.negative_match_num_threshold) {
+        vote[i]++;
+      }
+    }
+  }
+
+  std::vector<MarkerDetector::MarkerPosition> markers;
+  for (size_t i = 0; i < bin_num - pattern_size; i++) {
+    if (vote[i] > param.vote_threshold_for_detect_marker) {
+      const double bin_position =
+        static_cast<double>(i) + static_cast<double>(pattern_size) / 2.0;
+      markers.push_back({bin_position * param.resolution + min_x, min_y[i]});
+    }
+  }
+  return markers;
+}
+
+template <typename T>
+void write(uint8_t * ptr, T value)
+{
+  std::memcpy(ptr, &value, sizeof(T));
+}
+
+void write_as(uint8_t * ptr, uint8_t datatype, double value)
+{
+  switch (datatype) {
+    case PointField::UINT8:
+      write(ptr, static_cast<uint8_t>(value));
+      break;
+    case PointField::UINT16:
+      write(ptr, static_cast<uint16_t>(value));
+      break;
+    case PointField::UINT32:
+      write(ptr, static_cast<uint32_t>(value));
+      break;
+    case PointField::FLOAT32:
+      write(ptr, static_cast<float>(value));
+      break;
+    default:
+      FAIL() << "unsupported datatype " << static_cast<int>(datatype);
+  }
+}
+
+PointField create_field(const std::string & name, uint32_t offset, uint8_t datatype)
+{
+  PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  return field;
+}
+
+// x, y, intensity and channel in 16 bytes, on two rows which may be padded
+PointCloud2 create_msg(
+  const std::vector<Point> & points, uint8_t intensity_datatype, uint8_t channel_datatype,
+  bool with_channel, uint32_t row_padding)
+{
+  PointCloud2 msg;
+  msg.fields.push_back(create_field("x", 0, PointField::FLOAT32));
+  msg.fields.push_back(create_field("y", 4, PointField::FLOAT32));
+  msg.fields.push_back(create_field("intensity", 8, intensity_datatype));
+  if (with_channel) msg.fields.push_back(create_field("channel", 12, channel_datatype));
+  msg.point_step = 16;
+  msg.height = 2;
+  msg.width = static_cast<uint32_t>(points.size() / 2);
+  msg.row_step = msg.width * msg.point_step + row_padding;
+  msg.data.assign(static_cast<size_t>(msg.row_step) * msg.height, 0xff);
+  for (size_t i = 0; i < static_cast<size_t>(msg.width) * msg.height; ++i) {
+    uint8_t * ptr = msg.data.data() + (i / msg.width) * msg.row_step + (i % msg.width) * 16;
+    write(ptr, points[i].x);
+    write(ptr + 4, points[i].y);
+    write_as(ptr + 8, intensity_datatype, points[i].intensity);
+    if (with_channel) write_as(ptr + 12, channel_datatype, points[i].channel);
+  }
+  return msg;
+}
+
+struct ScanConfig
+{
+  float range;
+  uint32_t first_channel;
+  int ring_num;
+  int points_per_ring;         // over the whole range
+  int marker_points_per_ring;  // around the markers only, as on the rings far from the sensor
+};
+
+// Background intensities with bright bands of markers on the middle rings
+std::vector<Point> create_points(const ScanConfig & config, std::mt19937 & engine)
+{
+  const std::vector<float> marker_x = {0.5f * config.range, -0.3f * config.range};
+  std::uniform_real_distribution<float> x_distribution(-config.range, config.range);
+  std::uniform_real_distribution<float> marker_distribution(-0.6f, 0.6f);
+  std::uniform_int_distribution<size_t> marker_index(0, marker_x.size() - 1);
+  std::uniform_real_distribution<float> y_distribution(-5.f, 5.f);
+  std::uniform_int_distribution<int> intensity_distribution(0, 40);
+
+  std::vector<Point> points;
+  for (int ring = 0; ring < config.ring_num; ++ring) {
+    const bool middle_ring = config.ring_num / 5 < ring && ring < config.ring_num * 4 / 5;
+    for (int i = 0; i < config.points_per_ring + config.marker_points_per_ring; ++i) {
+      const float x = i < config.points_per_ring
+                        ? x_distribution(engine)
+                        : marker_x.at(marker_index(engine)) + marker_distribution(engine);
+      Point point{
+        x, y_distribution(engine), intensity_distribution(engine) * 1.0,
+        config.first_channel + static_cast<uint32_t>(ring)};
+      for (const float center : marker_x) {
+        if (middle_ring && std::abs(point.x - center) < 0.12f) point.intensity = 200.0;
+      }
+      points.push_back(point);
+    }
+  }
+  // an even number of points for the two rows
+  if (points.size() % 2 == 1) points.pop_back();
+  return points;
+}
+
+void expect_same_markers(
+  const std::vector<MarkerDetector::MarkerPosition> & markers,
+  const std::vector<MarkerDetector::MarkerPosition> & expected)
+{
+  ASSERT_EQ(markers.size(), expected.size());
+  for (size_t i = 0; i < markers.size(); ++i) {
+    EXPECT_DOUBLE_EQ(markers[i].x, expected[i].x) << i;
+    EXPECT_DOUBLE_EQ(markers[i].y, expected[i].y) << i;
+  }
+}
+}  // namespace
+
+TEST(MarkerDetectorTest, DetectionMatchesPerRingDetection)
+{
+  const MarkerDetector::Param param = create_param();
+  // One detector for all the scans, so that its buffers are reused and grown
+  MarkerDetector detector(param);
+  std::mt19937 engine(0);
+
+  const std::vector<ScanConfig> configs = {
+    // dense rings and few empty bins
+    {2.f, 0, 64, 600, 0},
+    // many empty bins
+    {40.f, 0, 128, 1800, 0},
+    // sparse rings, most windows have too few points to match
+    {40.f, 0, 128, 20, 60},
+    {40.f, 0, 128, 0, 30},
+    // ring indices beyond 128, e.g. several lidars concatenated
+    {10.f, 120, 100, 900, 10},
+    {20.f, 1000, 60, 100, 60},
+    // fewer rings than the previous scan
+    {5.f, 3, 16, 400, 0},
+  };
+  size_t marker_num = 0;
+  for (const ScanConfig & config : configs) {
+    for (const uint8_t intensity_datatype : {PointField::UINT8, PointField::FLOAT32}) {
+      for (const uint32_t row_padding : {0U, 24U}) {
+        SCOPED_TRACE(
+          "range " + std::to_string(config.range) + ", first channel " +
+          std::to_string(config.first_channel) + ", padding " + std::to_string(row_padding));
+        const std::vector<Point> points = create_points(config, engine);
+        const PointCloud2 msg =
+          create_msg(points, intensity_datatype, PointField::UINT16, true, row_padding);
+
+        std::vector<MarkerDetector::MarkerPosition> markers;
+        ASSERT_EQ(detector.detect(msg, markers), MarkerDetector::Status::SUCCEEDED);
+        expect_same_markers(markers, detect_per_ring(param, points));
+        marker_num += markers.size();
+      }
+    }
+  }
+  // The scans are not trivial
+  EXPECT_GT(marker_num, 0U);
+}
+
+TEST(MarkerDetectorTest, DetectionWithoutChannel)
+{
+  // All the points are on one ring, which needs a lower vote threshold
+  MarkerDetector::Param param = create_param();
+  param.vote_threshold_for_detect_marker = 0;
+  MarkerDetector detector(param);
+  std::mt19937 engine(1);
+
+  const std::vector<Point> points = create_points({3.f, 0, 8, 200, 0}, engine);
+  std::vector<Point> one_ring = points;
+  for (Point & point : one_ring) point.channel = 0;
+
+  std::vector<MarkerDetector::MarkerPosition> markers;
+  ASSERT_EQ(
+    detector.detect(create_msg(points, PointField::UINT8, PointField::UINT16, false, 0), markers),
+    MarkerDetector::Status::SUCCEEDED);
+  const auto expected = detect_per_ring(param, one_ring);
+  EXPECT_FALSE(expected.empty());
+  expect_same_markers(markers, expected);
+}
+
+TEST(MarkerDetectorTest, DetectionAtThresholds)
+{
+  const MarkerDetector::Param param = create_param();
+  MarkerDetector detector(param);
+
+  // One point per listed bin on each of the rings, the bins start at x = -1
+  std::vector<Point> points = {{-1.f, 0.f, 0.0, 0}, {6.f, 0.f, 0.0, 0}};
+  const auto add_bins = [&](const std::vector<std::pair<int, double>> & bins) {
+    for (uint32_t ring = 0; ring < 30; ++ring) {
+      for (const auto & [bin, intensity] : bins) {
+        const auto x = static_cast<float>(-1.0 + (bin + 0.5) * param.resolution);
+        points.push_back({x, 1.f, intensity, ring});
+      }
+    }
+  };
+  // Only as many non-empty bins as the positive and negative matches
+  add_bins({{20, 0.0}, {21, 0.0}, {23, 100.0}, {24, 100.0}, {25, 100.0}, {29, 0.0}});
+  // The outer negative bins are exactly at the threshold, which is not a match
+  add_bins({{60, 0.0}, {61, 0.0}, {63, 100.0}, {64, 100.0}, {65, 100.0}, {66, 100.0}});
+  add_bins({{67, 100.0}, {69, 30.0}, {70, 30.0}});
+  // The positive bins are mostly at the threshold
+  add_bins({{100, 0.0}, {101, 0.0}, {103, 100.0}, {104, 100.0}, {105, 70.0}, {106, 70.0}});
+  add_bins({{107, 70.0}, {109, 0.0}, {110, 0.0}});
+  if (points.size() % 2 == 1) points.pop_back();
+
+  std::vector<MarkerDetector::MarkerPosition> markers;
+  ASSERT_EQ(
+    detector.detect(create_msg(points, PointField::FLOAT32, PointField::UINT16, true, 0), markers),
+    MarkerDetector::Status::SUCCEEDED);
+  const auto expected = detect_per_ring(param, points);
+  ASSERT_EQ(expected.size(), 1U);
+  expect_same_markers(markers, expected);
+}
+
+TEST(MarkerDetectorTest, RejectInvalidData)
+{
+  const MarkerDetector::Param param = create_param();
+  MarkerDetector detector(param);
+  std::mt19937 engine(2);
+  const std::vector<Point> points = create_points({10.f, 0, 32, 400, 0}, engine);
+  const PointCloud2 msg = create_msg(points, PointField::UINT8, PointField::UINT16, true, 8);
+  std::vector<MarkerDetector::MarkerPosition> markers;
+  ASSERT_EQ(detector.detect(msg, markers), MarkerDetector::Status::SUCCEEDED);
+
+  // The last row is truncated
+  PointCloud2 truncated = msg;
+  truncated.data.resize(msg.data.size() - msg.row_step + msg.width * msg.point_step - 1);
+  markers.resize(1);
+  EXPECT_EQ(detector.detect(truncated, markers), MarkerDetector::Status::INVALID_DATA);
+  EXPECT_TRUE(markers.empty());
+  // The padding of the last row is not needed
+  truncated.data.push_back(0);
+  EXPECT_EQ(detector.detect(truncated, markers), MarkerDetector::Status::SUCCEEDED);
+
+  // The rows overlap
+  PointCloud2 overlapping = msg;
+  overlapping.row_step = msg.width * msg.point_step - 1;
+  EXPECT_EQ(detector.detect(overlapping, markers), MarkerDetector::Status::INVALID_DATA);
+
+  // The width and the height are larger than the data
+  PointCloud2 too_wide = msg;
+  too_wide.width += 1;
+  EXPECT_EQ(detector.detect(too_wide, markers), MarkerDetector::Status::INVALID_DATA);
+  PointCloud2 too_high = msg;
+  too_high.height += 1;
+  EXPECT_EQ(detector.detect(too_high, markers), MarkerDetector::Status::INVALID_DATA);
+
+  // A field is out of the point
+  PointCloud2 out_of_point = msg;
+  out_of_point.fields.at(3).datatype = PointField::FLOAT64;
+  EXPECT_EQ(detector.detect(out_of_point, markers), MarkerDetector::Status::INVALID_DATA);
+
+  PointCloud2 empty = msg;
+  empty.width = 0;
+  empty.data.clear();
+  EXPECT_EQ(detector.detect(empty, markers), MarkerDetector::Status::NO_POINTS);
+}
@@ -15,6 +15,8 @@
 #ifndef AUTOWARE__POSE_INSTABILITY_DETECTOR__POSE_INSTABILITY_DETECTOR_HPP_
 #define AUTOWARE__POSE_INSTABILITY_DETECTOR__POSE_INSTABILITY_DETECTOR_HPP_
 
+#include "autoware/pose_instability_detector/twist_history.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <diagnostic_msgs/msg/diagnostic_array.hpp>
@@ -53,30 +55,27 @@ public:
 
   explicit PoseInstabilityDetector(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
   ThresholdValues calculate_threshold(double interval_sec) const;
-  static void dead_reckon(
-    PoseStamped::SharedPtr & initial_pose, const rclcpp::Time & end_time,
-    const std::deque<TwistWithCovarianceStamped> & twist_deque, Pose::SharedPtr & estimated_pose);
+  static Pose dead_reckon(
+    const Pose & initial_pose, const rclcpp::Time & start_time, const rclcpp::Time & end_time,
+    const TwistHistory & twist_history);
 
 private:
   void callback_odometry(Odometry::ConstSharedPtr odometry_msg_ptr);
   void callback_twist(TwistWithCovarianceStamped::ConstSharedPtr twist_msg_ptr);
-  void callback_timer();
 
-  static std::deque<TwistWithCovarianceStamped> clip_out_necessary_twist(
-    const std::deque<TwistWithCovarianceStamped> & twist_buffer, const rclcpp::Time & start_time,
-    const rclcpp::Time & end_time);
+  // Compare the latest odometry with the pose dead-reckoned from the reference odometry
+  void check(const Odometry & reference_odometry, const Odometry & latest_odometry);
 
-  // subscribers and timer
+  // subscribers
   rclcpp::Subscription<Odometry>::SharedPtr odometry_sub_;
   rclcpp::Subscription<TwistWithCovarianceStamped>::SharedPtr twist_sub_;
-  rclcpp::TimerBase::SharedPtr timer_;
 
   // publisher
   rclcpp::Publisher<PoseStamped>::SharedPtr diff_pose_pub_;
   rclcpp::Publisher<DiagnosticArray>::SharedPtr diagnostics_pub_;
 
   // parameters
-  const double timer_period_;  // [sec]
+  const double comparison_interval_;  // [sec]
 
   const double heading_velocity_maximum_;                 // [m/s]
   const double heading_velocity_scale_factor_tolerance_;  // [%]
@@ -91,9 +90,9 @@ private:
   const double pose_estimator_angular_tolerance_;       // [rad]
 
   // variables
-  std::optional<Odometry> latest_odometry_ = std::nullopt;
-  std::optional<Odometry> prev_odometry_ = std::nullopt;
-  std::deque<TwistWithCovarianceStamped> twist_buffer_;
+  // odometries since the latest one older than comparison_interval_
+  std::deque<Odometry> odometry_buffer_;
+  TwistHistory twist_history_;
 };
 }  // namespace autoware::pose_instability_detector
 
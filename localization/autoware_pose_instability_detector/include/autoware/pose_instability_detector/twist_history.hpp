@@ -0,0 +1,81 @@
+// Copyright 2023- Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__POSE_INSTABILITY_DETECTOR__TWIST_HISTORY_HPP_
+#define AUTOWARE__POSE_INSTABILITY_DETECTOR__TWIST_HISTORY_HPP_
+
+#include <geometry_msgs/msg/twist.hpp>
+
+#include <tf2/LinearMath/Transform.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace autoware::pose_instability_detector
+{
+/**
+ * Fixed-capacity ring buffer of twists with the poses integrated up to each twist
+ *
+ * Each twist is held until the next one and integrated in the same way as the previous dead
+ * reckoning (the translation is rotated by the orientation in the middle of the step). Because the
+ * poses are accumulated when the twists are pushed, the motion between any two stamps is a
+ * composition of two interpolated prefix poses, which costs O(log n) regardless of the interval.
+ * Before the oldest twist and after the latest twist, the nearest twist is extrapolated.
+ */
+class TwistHistory
+{
+public:
+  using Twist = geometry_msgs::msg::Twist;
+
+  explicit TwistHistory(size_t capacity);
+
+  // Twists older than the latest one are ignored. The oldest twist is dropped when full.
+  void push(int64_t stamp_ns, const Twist & twist);
+
+  // Drops all the twists, e.g. when the time goes backwards
+  void clear();
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_t size() const { return size_; }
+
+  // Stamp of the latest twist. The history must not be empty.
+  [[nodiscard]] int64_t latest_stamp_ns() const { return at(size_ - 1).stamp_ns; }
+
+  // Motion from start to end expressed in the frame of the pose at start.
+  // The history must not be empty.
+  [[nodiscard]] tf2::Transform relative_motion(int64_t start_ns, int64_t end_ns) const;
+
+private:
+  struct Sample
+  {
+    int64_t stamp_ns;
+    tf2::Vector3 linear;
+    tf2::Vector3 angular;
+    // pose at stamp_ns in the frame of the first pushed twist
+    tf2::Transform pose;
+  };
+
+  // Motion by holding the twist of the sample for dt_sec (negative dt_sec moves backwards)
+  static tf2::Transform step(const Sample & sample, double dt_sec);
+
+  [[nodiscard]] const Sample & at(size_t index) const;
+  [[nodiscard]] tf2::Transform pose_at(int64_t stamp_ns) const;
+
+  std::vector<Sample> samples_;
+  size_t head_{0};  // index of the oldest sample
+  size_t size_{0};
+};
+}  // namespace autoware::pose_instability_detector
+
+#endif  // AUTOWARE__POSE_INSTABILITY_DETECTOR__TWIST_HISTORY_HPP_
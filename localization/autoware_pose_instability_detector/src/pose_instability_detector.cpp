@@ -31,7 +31,7 @@ namespace autoware::pose_instability_detector
 {
 PoseInstabilityDetector::PoseInstabilityDetector(const rclcpp::NodeOptions & options)
 : rclcpp::Node("pose_instability_detector", options),
-  timer_period_(this->declare_parameter<double>("timer_period")),
+  comparison_interval_(this->declare_parameter<double>("comparison_interval")),
   heading_velocity_maximum_(this->declare_parameter<double>("heading_velocity_maximum")),
   heading_velocity_scale_factor_tolerance_(
     this->declare_parameter<double>("heading_velocity_scale_factor_tolerance")),
@@ -47,9 +47,11 @@ PoseInstabilityDetector::PoseInstabilityDetector(const rclcpp::NodeOptions & opt
   pose_estimator_vertical_tolerance_(
     this->declare_parameter<double>("pose_estimator_vertical_tolerance")),
   pose_estimator_angular_tolerance_(
-    this->declare_parameter<double>("pose_estimator_angular_tolerance"))
+    this->declare_parameter<double>("pose_estimator_angular_tolerance")),
+  twist_history_(
+    static_cast<size_t>(this->declare_parameter<int64_t>("twist_history_capacity")))
 {
-  // Define subscribers, publishers and a timer.
+  // Define subscribers and publishers.
   odometry_sub_ = this->create_subscription<Odometry>(
     "~/input/odometry", 10,
     std::bind(&PoseInstabilityDetector::callback_odometry, this, std::placeholders::_1));
@@ -58,44 +60,58 @@ PoseInstabilityDetector::PoseInstabilityDetector(const rclcpp::NodeOptions & opt
     "~/input/twist", 10,
     std::bind(&PoseInstabilityDetector::callback_twist, this, std::placeholders::_1));
 
-  timer_ = rclcpp::create_timer(
-    this, this->get_clock(), std::chrono::duration<double>(timer_period_),
-    std::bind(&PoseInstabilityDetector::callback_timer, this));
-
   diff_pose_pub_ = this->create_publisher<PoseStamped>("~/debug/diff_pose", 10);
   diagnostics_pub_ = this->create_publisher<DiagnosticArray>("/diagnostics", 10);
 }
 
 void PoseInstabilityDetector::callback_odometry(Odometry::ConstSharedPtr odometry_msg_ptr)
 {
-  latest_odometry_ = *odometry_msg_ptr;
+  const int64_t latest_odometry_ns = rclcpp::Time(odometry_msg_ptr->header.stamp).nanoseconds();
+
+  // Time went backwards (e.g. rosbag replay restarted)
+  if (
+    !odometry_buffer_.empty() &&
+    latest_odometry_ns < rclcpp::Time(odometry_buffer_.back().header.stamp).nanoseconds()) {
+    odometry_buffer_.clear();
+    twist_history_.clear();
+  }
+  odometry_buffer_.push_back(*odometry_msg_ptr);
+
+  // Keep only the latest odometry older than comparison_interval_ and the later ones. It is the
+  // reference of the comparison, or the oldest one until the interval has been buffered.
+  const int64_t reference_ns =
+    latest_odometry_ns - static_cast<int64_t>(comparison_interval_ * 1e9);
+  while (odometry_buffer_.size() > 1 &&
+         rclcpp::Time(odometry_buffer_[1].header.stamp).nanoseconds() <= reference_ns) {
+    odometry_buffer_.pop_front();
+  }
+
+  // twist callback has to be called at least once
+  if (twist_history_.empty()) {
+    return;
+  }
+
+  check(odometry_buffer_.front(), odometry_buffer_.back());
 }
 
 void PoseInstabilityDetector::callback_twist(
   TwistWithCovarianceStamped::ConstSharedPtr twist_msg_ptr)
 {
-  twist_buffer_.push_back(*twist_msg_ptr);
-}
+  const int64_t twist_ns = rclcpp::Time(twist_msg_ptr->header.stamp).nanoseconds();
 
-void PoseInstabilityDetector::callback_timer()
-{
-  // odometry callback and timer callback has to be called at least once
-  if (latest_odometry_ == std::nullopt) {
-    return;
-  }
-  if (prev_odometry_ == std::nullopt) {
-    prev_odometry_ = latest_odometry_;
-    return;
-  }
-
-  // twist callback has to be called at least once
-  if (twist_buffer_.empty()) {
-    return;
+  // Time went backwards (e.g. rosbag replay restarted), the history would ignore the new twists
+  if (!twist_history_.empty() && twist_ns < twist_history_.latest_stamp_ns()) {
+    twist_history_.clear();
   }
+  twist_history_.push(twist_ns, twist_msg_ptr->twist.twist);
+}
 
+void PoseInstabilityDetector::check(
+  const Odometry & reference_odometry, const Odometry & latest_odometry)
+{
   // time variables
-  const rclcpp::Time latest_odometry_time = rclcpp::Time(latest_odometry_->header.stamp);
-  const rclcpp::Time prev_odometry_time = rclcpp::Time(prev_odometry_->header.stamp);
+  const rclcpp::Time latest_odometry_time = rclcpp::Time(latest_odometry.header.stamp);
+  const rclcpp::Time prev_odometry_time = rclcpp::Time(reference_odometry.header.stamp);
 
   // define lambda function to convert quaternion to rpy
   auto quat_to_rpy = [](const Quaternion & quat) {
@@ -108,26 +124,13 @@ void PoseInstabilityDetector::callback_timer()
     return std::make_tuple(roll, pitch, yaw);
   };
 
-  // delete twist data older than prev_odometry_ (but preserve the one right before prev_odometry_)
-  while (twist_buffer_.size() > 1) {
-    if (rclcpp::Time(twist_buffer_[1].header.stamp) < prev_odometry_time) {
-      twist_buffer_.pop_front();
-    } else {
-      break;
-    }
-  }
-
-  // dead reckoning from prev_odometry_ to latest_odometry_
-  PoseStamped::SharedPtr prev_pose = std::make_shared<PoseStamped>();
-  prev_pose->header = prev_odometry_->header;
-  prev_pose->pose = prev_odometry_->pose.pose;
-
-  Pose::SharedPtr dr_pose = std::make_shared<Pose>();
-  dead_reckon(prev_pose, latest_odometry_time, twist_buffer_, dr_pose);
+  // dead reckoning from reference_odometry to latest_odometry
+  const Pose dr_pose = dead_reckon(
+    reference_odometry.pose.pose, prev_odometry_time, latest_odometry_time, twist_history_);
 
   // compare dead reckoning pose and latest_odometry_
-  const Pose latest_ekf_pose = latest_odometry_->pose.pose;
-  const Pose ekf_to_dr = autoware_utils_geometry::inverse_transform_pose(*dr_pose, latest_ekf_pose);
+  const Pose latest_ekf_pose = latest_odometry.pose.pose;
+  const Pose ekf_to_dr = autoware_utils_geometry::inverse_transform_pose(dr_pose, latest_ekf_pose);
   const geometry_msgs::msg::Point pos = ekf_to_dr.position;
   const auto [ang_x, ang_y, ang_z] = quat_to_rpy(ekf_to_dr.orientation);
   const std::vector<double> values = {pos.x, pos.y, pos.z, ang_x, ang_y, ang_z};
@@ -176,9 +179,6 @@ void PoseInstabilityDetector::callback_timer()
   diagnostics.header.stamp = latest_odometry_time;
   diagnostics.status.emplace_back(status);
   diagnostics_pub_->publish(diagnostics);
-
-  // prepare for next loop
-  prev_odometry_ = latest_odometry_;
 }
 
 PoseInstabilityDetector::ThresholdValues PoseInstabilityDetector::calculate_threshold(
@@ -244,174 +244,20 @@ PoseInstabilityDetector::ThresholdValues PoseInstabilityDetector::calculate_thre
   return result_values;
 }
 
-void PoseInstabilityDetector::dead_reckon(
-  PoseStamped::SharedPtr & initial_pose, const rclcpp::Time & end_time,
-  const std::deque<TwistWithCovarianceStamped> & twist_deque, Pose::SharedPtr & estimated_pose)
-{
-  // get start time
-  rclcpp::Time start_time = rclcpp::Time(initial_pose->header.stamp);
-
-  // initialize estimated_pose
-  estimated_pose->position = initial_pose->pose.position;
-  estimated_pose->orientation = initial_pose->pose.orientation;
-
-  // cut out necessary twist data
-  std::deque<TwistWithCovarianceStamped> sliced_twist_deque =
-    clip_out_necessary_twist(twist_deque, start_time, end_time);
-
-  // dead reckoning
-  rclcpp::Time prev_odometry_time = rclcpp::Time(sliced_twist_deque.front().header.stamp);
-  tf2::Quaternion prev_orientation;
-  tf2::fromMsg(estimated_pose->orientation, prev_orientation);
-
-  for (size_t i = 1; i < sliced_twist_deque.size(); ++i) {
-    const rclcpp::Time curr_time = rclcpp::Time(sliced_twist_deque[i].header.stamp);
-    const double time_diff_sec = (curr_time - prev_odometry_time).seconds();
-
-    const Twist twist = sliced_twist_deque[i - 1].twist.twist;
-
-    // variation of orientation (rpy update)
-    tf2::Quaternion delta_orientation;
-    tf2::Vector3 rotation_axis(twist.angular.x, twist.angular.y, twist.angular.z);
-    if (rotation_axis.length() > 0.0) {
-      delta_orientation.setRotation(
-        rotation_axis.normalized(), rotation_axis.length() * time_diff_sec);
-    } else {
-      delta_orientation.setValue(0.0, 0.0, 0.0, 1.0);
-    }
-
-    tf2::Quaternion curr_orientation;
-    curr_orientation = prev_orientation * delta_orientation;
-    curr_orientation.normalize();
-
-    // average quaternion of two frames
-    tf2::Quaternion average_quat = prev_orientation.slerp(curr_orientation, 0.5);
-
-    // Convert twist to world frame (take average of two frames)
-    tf2::Vector3 linear_velocity(twist.linear.x, twist.linear.y, twist.linear.z);
-    linear_velocity = tf2::quatRotate(average_quat, linear_velocity);
-
-    // xyz update
-    estimated_pose->position.x += linear_velocity.x() * time_diff_sec;
-    estimated_pose->position.y += linear_velocity.y() * time_diff_sec;
-    estimated_pose->position.z += linear_velocity.z() * time_diff_sec;
-
-    // update previous variables
-    prev_odometry_time = curr_time;
-    prev_orientation = curr_orientation;
-  }
-  estimated_pose->orientation.x = prev_orientation.x();
-  estimated_pose->orientation.y = prev_orientation.y();
-  estimated_pose->orientation.z = prev_orientation.z();
-  estimated_pose->orientation.w = prev_orientation.w();
-}
-
-std::deque<PoseInstabilityDetector::TwistWithCovarianceStamped>
-PoseInstabilityDetector::clip_out_necessary_twist(
-  const std::deque<TwistWithCovarianceStamped> & twist_buffer, const rclcpp::Time & start_time,
-  const rclcpp::Time & end_time)
+PoseInstabilityDetector::Pose PoseInstabilityDetector::dead_reckon(
+  const Pose & initial_pose, const rclcpp::Time & start_time, const rclcpp::Time & end_time,
+  const TwistHistory & twist_history)
 {
-  // If there is only one element in the twist_buffer, return a deque that has the same twist
-  // from the start till the end
-  if (twist_buffer.size() == 1) {
-    TwistWithCovarianceStamped twist = twist_buffer.front();
-    std::deque<TwistWithCovarianceStamped> simple_twist_deque;
+  tf2::Transform initial_transform;
+  tf2::fromMsg(initial_pose, initial_transform);
 
-    twist.header.stamp = start_time;
-    simple_twist_deque.push_back(twist);
+  const tf2::Transform motion =
+    twist_history.relative_motion(start_time.nanoseconds(), end_time.nanoseconds());
+  const tf2::Transform estimated_transform = initial_transform * motion;
 
-    twist.header.stamp = end_time;
-    simple_twist_deque.push_back(twist);
-
-    return simple_twist_deque;
-  }
-
-  // get iterator to the element that is right before start_time (if it does not exist, start_it =
-  // twist_buffer.begin())
-  auto start_it = twist_buffer.begin();
-
-  for (auto it = twist_buffer.begin(); it != twist_buffer.end(); ++it) {
-    if (rclcpp::Time(it->header.stamp) > start_time) {
-      break;
-    }
-    start_it = it;
-  }
-
-  // get iterator to the element that is right after end_time (if it does not exist, end_it =
-  // twist_buffer.end())
-  auto end_it = twist_buffer.end();
-  end_it--;
-  for (auto it = end_it; it != twist_buffer.begin(); --it) {
-    if (rclcpp::Time(it->header.stamp) < end_time) {
-      break;
-    }
-    end_it = it;
-  }
-
-  // Create result deque
-  std::deque<TwistWithCovarianceStamped> result_deque(start_it, end_it);
-
-  // If the first element is later than start_time, add the first element to the front of the
-  // result_deque
-  if (rclcpp::Time(result_deque.front().header.stamp) > start_time) {
-    TwistWithCovarianceStamped start_twist = *start_it;
-    start_twist.header.stamp = start_time;
-    result_deque.push_front(start_twist);
-  } else {
-    if (result_deque.size() < 2) {
-      return result_deque;
-    }
-    // If the first element is earlier than start_time, interpolate the first element
-    rclcpp::Time time0 = rclcpp::Time(result_deque[0].header.stamp);
-    rclcpp::Time time1 = rclcpp::Time(result_deque[1].header.stamp);
-    double ratio = (start_time - time0).seconds() / (time1 - time0).seconds();
-    Twist twist0 = result_deque[0].twist.twist;
-    Twist twist1 = result_deque[1].twist.twist;
-    result_deque[0].twist.twist.linear.x = twist1.linear.x * ratio + twist0.linear.x * (1 - ratio);
-    result_deque[0].twist.twist.linear.y = twist1.linear.y * ratio + twist0.linear.y * (1 - ratio);
-    result_deque[0].twist.twist.linear.z = twist1.linear.z * ratio + twist0.linear.z * (1 - ratio);
-    result_deque[0].twist.twist.angular.x =
-      twist1.angular.x * ratio + twist0.angular.x * (1 - ratio);
-    result_deque[0].twist.twist.angular.y =
-      twist1.angular.y * ratio + twist0.angular.y * (1 - ratio);
-    result_deque[0].twist.twist.angular.z =
-      twist1.angular.z * ratio + twist0.angular.z * (1 - ratio);
-
-    result_deque[0].header.stamp = start_time;
-  }
-
-  // If the last element is earlier than end_time, add the last element to the back of the
-  // result_deque
-  if (rclcpp::Time(result_deque.back().header.stamp) < end_time) {
-    TwistWithCovarianceStamped end_twist = *end_it;
-    end_twist.header.stamp = end_time;
-    result_deque.push_back(end_twist);
-  } else {
-    if (result_deque.size() < 2) {
-      return result_deque;
-    }
-    // If the last element is later than end_time, interpolate the last element
-    rclcpp::Time time0 = rclcpp::Time(result_deque[result_deque.size() - 2].header.stamp);
-    rclcpp::Time time1 = rclcpp::Time(result_deque[result_deque.size() - 1].header.stamp);
-    double ratio = (end_time - time0).seconds() / (time1 - time0).seconds();
-    Twist twist0 = result_deque[result_deque.size() - 2].twist.twist;
-    Twist twist1 = result_deque[result_deque.size() - 1].twist.twist;
-    result_deque[result_deque.size() - 1].twist.twist.linear.x =
-      twist1.linear.x * ratio + twist0.linear.x * (1 - ratio);
-    result_deque[result_deque.size() - 1].twist.twist.linear.y =
-      twist1.linear.y * ratio + twist0.linear.y * (1 - ratio);
-    result_deque[result_deque.size() - 1].twist.twist.linear.z =
-      twist1.linear.z * ratio + twist0.linear.z * (1 - ratio);
-    result_deque[result_deque.size() - 1].twist.twist.angular.x =
-      twist1.angular.x * ratio + twist0.angular.x * (1 - ratio);
-    result_deque[result_deque.size() - 1].twist.twist.angular.y =
-      twist1.angular.y * ratio + twist0.angular.y * (1 - ratio);
-    result_deque[result_deque.size() - 1].twist.twist.angular.z =
-      twist1.angular.z * ratio + twist0.angular.z * (1 - ratio);
-
-    result_deque[result_deque.size() - 1].header.stamp = end_time;
-  }
-  return result_deque;
+  Pose estimated_pose;
+  tf2::toMsg(estimated_transform, estimated_pose);
+  return estimated_pose;
 }
 }  // namespace autoware::pose_instability_detector
 
@@ -0,0 +1,103 @@
+// Copyright 2023- Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pose_instability_detector/twist_history.hpp"
+
+#include <tf2/LinearMath/Quaternion.h>
+
+#include <algorithm>
+
+namespace autoware::pose_instability_detector
+{
+TwistHistory::TwistHistory(size_t capacity) : samples_(std::max<size_t>(capacity, 1))
+{
+}
+
+const TwistHistory::Sample & TwistHistory::at(size_t index) const
+{
+  return samples_[(head_ + index) % samples_.size()];
+}
+
+tf2::Transform TwistHistory::step(const Sample & sample, double dt_sec)
+{
+  const double angle = sample.angular.length() * dt_sec;
+  tf2::Quaternion delta_orientation(0.0, 0.0, 0.0, 1.0);
+  tf2::Quaternion half_orientation(0.0, 0.0, 0.0, 1.0);
+  if (sample.angular.length() > 0.0) {
+    const tf2::Vector3 axis = sample.angular.normalized();
+    delta_orientation.setRotation(axis, angle);
+    half_orientation.setRotation(axis, angle * 0.5);
+  }
+
+  // The linear velocity is rotated by the average of the orientations at both ends of the step
+  const tf2::Vector3 translation = tf2::quatRotate(half_orientation, sample.linear) * dt_sec;
+  return tf2::Transform(delta_orientation, translation);
+}
+
+void TwistHistory::push(int64_t stamp_ns, const Twist & twist)
+{
+  Sample sample;
+  sample.stamp_ns = stamp_ns;
+  sample.linear = tf2::Vector3(twist.linear.x, twist.linear.y, twist.linear.z);
+  sample.angular = tf2::Vector3(twist.angular.x, twist.angular.y, twist.angular.z);
+
+  if (size_ == 0) {
+    sample.pose.setIdentity();
+  } else {
+    const Sample & latest = at(size_ - 1);
+    if (stamp_ns < latest.stamp_ns) return;
+    const double dt_sec = static_cast<double>(stamp_ns - latest.stamp_ns) * 1e-9;
+    sample.pose = latest.pose * step(latest, dt_sec);
+    sample.pose.setRotation(sample.pose.getRotation().normalized());
+  }
+
+  if (size_ == samples_.size()) {
+    samples_[head_] = sample;
+    head_ = (head_ + 1) % samples_.size();
+  } else {
+    samples_[(head_ + size_) % samples_.size()] = sample;
+    ++size_;
+  }
+}
+
+void TwistHistory::clear()
+{
+  head_ = 0;
+  size_ = 0;
+}
+
+tf2::Transform TwistHistory::pose_at(int64_t stamp_ns) const
+{
+  // Find the latest sample which is not later than stamp_ns
+  size_t low = 0;
+  size_t high = size_;
+  while (low < high) {
+    const size_t mid = (low + high) / 2;
+    if (at(mid).stamp_ns <= stamp_ns) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  // Before the oldest sample, the oldest twist is extrapolated backwards
+  const Sample & sample = at(low == 0 ? 0 : low - 1);
+  return sample.pose * step(sample, static_cast<double>(stamp_ns - sample.stamp_ns) * 1e-9);
+}
+
+tf2::Transform TwistHistory::relative_motion(int64_t start_ns, int64_t end_ns) const
+{
+  return pose_at(start_ns).inverseTimes(pose_at(end_ns));
+}
+}  // namespace autoware::pose_instability_detector
@@ -0,0 +1,100 @@
+// Copyright 2023- Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/pose_instability_detector/twist_history.hpp"
+
+#include <tf2/LinearMath/Quaternion.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <utility>
+
+// Measure the cost of one dead reckoning over a fixed interval, as done on every odometry message,
+// against the length of the twist history. The reference integrates the twists in the interval one
+// by one as the detector did before.
+
+using autoware::pose_instability_detector::TwistHistory;
+using Twist = geometry_msgs::msg::Twist;
+
+tf2::Vector3 integrate_linearly(
+  const std::deque<std::pair<int64_t, Twist>> & twists, int64_t start_ns, int64_t end_ns)
+{
+  tf2::Quaternion orientation(0.0, 0.0, 0.0, 1.0);
+  tf2::Vector3 position(0.0, 0.0, 0.0);
+  for (size_t i = 0; i + 1 < twists.size(); ++i) {
+    const int64_t from = std::max(twists[i].first, start_ns);
+    const int64_t to = std::min(twists[i + 1].first, end_ns);
+    if (to <= from) continue;
+    const double dt = static_cast<double>(to - from) * 1e-9;
+    const Twist & twist = twists[i].second;
+    const tf2::Vector3 axis(twist.angular.x, twist.angular.y, twist.angular.z);
+    tf2::Quaternion delta(0.0, 0.0, 0.0, 1.0);
+    if (axis.length() > 0.0) delta.setRotation(axis.normalized(), axis.length() * dt);
+    const tf2::Quaternion next = (orientation * delta).normalized();
+    const tf2::Vector3 linear(twist.linear.x, twist.linear.y, twist.linear.z);
+    position += tf2::quatRotate(orientation.slerp(next, 0.5), linear) * dt;
+    orientation = next;
+  }
+  return position;
+}
+
+int main()
+{
+  constexpr int64_t twist_period_ns = 10'000'000;  // 100 Hz
+  constexpr int64_t interval_ns = 500'000'000;     // comparison_interval
+  constexpr int queries = 10000;
+
+  for (const size_t history_length : {100u, 1000u, 10000u, 100000u}) {
+    TwistHistory history(history_length);
+    std::deque<std::pair<int64_t, Twist>> twists;
+    Twist twist;
+    twist.linear.x = 10.0;
+    twist.angular.z = 0.1;
+    for (size_t i = 0; i < history_length; ++i) {
+      twist.angular.z = 0.1 * std::sin(static_cast<double>(i) * 0.01);
+      const auto stamp = static_cast<int64_t>(i) * twist_period_ns;
+      history.push(stamp, twist);
+      twists.emplace_back(stamp, twist);
+    }
+    const int64_t latest_ns = static_cast<int64_t>(history_length - 1) * twist_period_ns;
+
+    double checksum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+      const int64_t end_ns = latest_ns - (q % 10) * twist_period_ns / 3;
+      checksum += history.relative_motion(end_ns - interval_ns, end_ns).getOrigin().x();
+    }
+    const double history_us =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+      queries;
+
+    double reference_checksum = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+      const int64_t end_ns = latest_ns - (q % 10) * twist_period_ns / 3;
+      reference_checksum += integrate_linearly(twists, end_ns - interval_ns, end_ns).x();
+    }
+    const double reference_us =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+      queries;
+
+    std::cout << "history " << history_length << " twists: ring buffer " << history_us
+              << " [us], linear integration " << reference_us << " [us], mean |dx| difference "
+              << std::abs(checksum - reference_checksum) / queries << " [m]" << std::endl;
+  }
+  return 0;
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "autoware/pose_instability_detector/pose_instability_detector.hpp"
+#include "autoware/pose_instability_detector/twist_history.hpp"
 #include "test_message_helper_node.hpp"
 
 #include <ament_index_cpp/get_package_share_directory.hpp>
@@ -20,7 +21,9 @@
 
 #include <gtest/gtest.h>
 #include <rcl_yaml_param_parser/parser.h>
+#include <tf2/utils.h>
 
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -70,6 +73,22 @@ protected:
     executor_.remove_node(helper_);
   }
 
+  void spin_for_a_while()
+  {
+    for (int i = 0; i < 10; ++i) {
+      executor_.spin_some();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  void wait_for_diagnostics()
+  {
+    while (!helper_->received_diagnostic_array_flag) {
+      executor_.spin_some();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
   rclcpp::executors::SingleThreadedExecutor executor_;
   std::shared_ptr<autoware::pose_instability_detector::PoseInstabilityDetector> subject_;
   std::shared_ptr<TestMessageHelperNode> helper_;
@@ -88,31 +107,22 @@ TEST_F(TestPoseInstabilityDetector, output_ok_when_twist_matches_odometry)  // N
   timestamp.nanosec = 5e8;
   helper_->send_twist_message(timestamp, 2.0, 0.0, 0.0);
 
-  // process the above message (by timer_callback)
-  helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
-
   // send the twist message2 (move 1m in x direction)
   timestamp.sec = 1;
   timestamp.nanosec = 0;
   helper_->send_twist_message(timestamp, 2.0, 0.0, 0.0);
 
+  // process the above messages
+  spin_for_a_while();
+
   // send the second odometry message (finish x = 12)
+  helper_->received_diagnostic_array_flag = false;
   timestamp.sec = 2;
   timestamp.nanosec = 0;
   helper_->send_odometry_message(timestamp, 14.0, 0.0, 0.0);
 
-  executor_.spin_some();
-
-  // process the above messages (by timer_callback)
-  helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
+  // process the above message (by odometry callback)
+  wait_for_diagnostics();
 
   // check result
   const diagnostic_msgs::msg::DiagnosticStatus & diagnostic_status =
@@ -133,31 +143,22 @@ TEST_F(TestPoseInstabilityDetector, output_warn_when_twist_is_too_small)  // NOL
   timestamp.nanosec = 5e8;
   helper_->send_twist_message(timestamp, 0.2, 0.0, 0.0);
 
-  // process the above message (by timer_callback)
-  helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
-
   // send the twist message2 (move 0.1m in x direction)
   timestamp.sec = 1;
   timestamp.nanosec = 0;
   helper_->send_twist_message(timestamp, 0.2, 0.0, 0.0);
 
+  // process the above messages
+  spin_for_a_while();
+
   // send the second odometry message (finish x = 12)
+  helper_->received_diagnostic_array_flag = false;
   timestamp.sec = 2;
   timestamp.nanosec = 0;
   helper_->send_odometry_message(timestamp, 14.0, 0.0, 0.0);
 
-  executor_.spin_some();
-
-  // process the above messages (by timer_callback)
-  helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
+  // process the above message (by odometry callback)
+  wait_for_diagnostics();
 
   // check result
   const diagnostic_msgs::msg::DiagnosticStatus & diagnostic_status =
@@ -169,10 +170,8 @@ TEST_F(TestPoseInstabilityDetector, does_not_crash_even_if_abnormal_odometry_dat
 {
   // [Condition] There is no twist_msg between the two target odometry_msgs.
   // Normally this doesn't seem to happen.
-  // As far as I can think, this happens when the odometry msg stops (so the next timer callback
-  // will refer to the same odometry msg, and the timestamp difference will be calculated as 0)
-  // This test case shows that an error occurs when two odometry msgs come in close succession and
-  // there is no other odometry msg.
+  // As far as I can think, this happens when the odometry msg stops or two odometry msgs come in
+  // close succession (so the interval between the compared odometries is 0 or almost 0).
   // Referring again, this doesn't normally seem to happen in usual operation.
 
   builtin_interfaces::msg::Time timestamp{};
@@ -181,48 +180,152 @@ TEST_F(TestPoseInstabilityDetector, does_not_crash_even_if_abnormal_odometry_dat
   timestamp.sec = 0;
   timestamp.nanosec = 0;
   helper_->send_twist_message(timestamp, 0.2, 0.0, 0.0);
+  spin_for_a_while();
 
   // send the first odometry message after the first twist message
+  helper_->received_diagnostic_array_flag = false;
   timestamp.sec = 0;
   timestamp.nanosec = 5e8 + 1;
   helper_->send_odometry_message(timestamp, 10.0, 0.0, 0.0);
-
-  // process the above message (by timer_callback)
-  helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
+  wait_for_diagnostics();
 
   // send the second odometry message before the second twist message
+  helper_->received_diagnostic_array_flag = false;
   timestamp.sec = 0;
   timestamp.nanosec = 5e8 + 1e7;
   helper_->send_odometry_message(timestamp, 12.0, 0.0, 0.0);
+  wait_for_diagnostics();
 
   // send the twist message2
   timestamp.sec = 1;
   timestamp.nanosec = 0;
   helper_->send_twist_message(timestamp, 0.2, 0.0, 0.0);
+  spin_for_a_while();
 
-  // process the above messages (by timer_callback)
+  // send the second odometry message again
   helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
-
-  // provoke timer callback again
-  helper_->received_diagnostic_array_flag = false;
-  while (!helper_->received_diagnostic_array_flag) {
-    executor_.spin_some();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
+  timestamp.sec = 0;
+  timestamp.nanosec = 5e8 + 1e7;
+  helper_->send_odometry_message(timestamp, 12.0, 0.0, 0.0);
+  wait_for_diagnostics();
 
   // This test is OK if pose_instability_detector does not crash. The diagnostics status is not
   // checked.
   SUCCEED();
 }
 
+TEST_F(TestPoseInstabilityDetector, twists_are_used_after_time_goes_backwards)  // NOLINT
+{
+  // slow motion from x = 10 at t = 10 s
+  builtin_interfaces::msg::Time timestamp{};
+  timestamp.sec = 10;
+  timestamp.nanosec = 0;
+  helper_->send_odometry_message(timestamp, 10.0, 0.0, 0.0);
+  timestamp.nanosec = 5e8;
+  helper_->send_twist_message(timestamp, 0.2, 0.0, 0.0);
+  timestamp.sec = 11;
+  timestamp.nanosec = 0;
+  helper_->send_twist_message(timestamp, 0.2, 0.0, 0.0);
+  spin_for_a_while();
+
+  // the time goes back to 0 s (e.g. rosbag replay restarted) and the vehicle moves faster
+  timestamp.sec = 0;
+  timestamp.nanosec = 0;
+  helper_->send_odometry_message(timestamp, 10.0, 0.0, 0.0);
+  spin_for_a_while();
+  timestamp.nanosec = 5e8;
+  helper_->send_twist_message(timestamp, 2.0, 0.0, 0.0);
+  timestamp.sec = 1;
+  timestamp.nanosec = 0;
+  helper_->send_twist_message(timestamp, 2.0, 0.0, 0.0);
+  spin_for_a_while();
+
+  // the twists after the jump are integrated, not the ones before
+  helper_->received_diagnostic_array_flag = false;
+  timestamp.sec = 2;
+  timestamp.nanosec = 0;
+  helper_->send_odometry_message(timestamp, 14.0, 0.0, 0.0);
+  wait_for_diagnostics();
+
+  const diagnostic_msgs::msg::DiagnosticStatus & diagnostic_status =
+    helper_->received_diagnostic_array.status[0];
+  EXPECT_TRUE(diagnostic_status.level == diagnostic_msgs::msg::DiagnosticStatus::OK);
+}
+
+TEST(TwistHistory, straight_motion_is_integrated_between_any_stamps)  // NOLINT
+{
+  autoware::pose_instability_detector::TwistHistory history(100);
+  geometry_msgs::msg::Twist twist;
+  twist.linear.x = 2.0;
+  for (int i = 0; i < 10; ++i) {
+    history.push(static_cast<int64_t>(i) * 100'000'000, twist);
+  }
+
+  // inside, before and after the buffered stamps
+  EXPECT_NEAR(history.relative_motion(250'000'000, 750'000'000).getOrigin().x(), 1.0, 1e-9);
+  EXPECT_NEAR(history.relative_motion(-500'000'000, 0).getOrigin().x(), 1.0, 1e-9);
+  EXPECT_NEAR(history.relative_motion(900'000'000, 1'400'000'000).getOrigin().x(), 1.0, 1e-9);
+  EXPECT_NEAR(history.relative_motion(750'000'000, 250'000'000).getOrigin().x(), -1.0, 1e-9);
+}
+
+TEST(TwistHistory, circular_motion_matches_closed_form)  // NOLINT
+{
+  autoware::pose_instability_detector::TwistHistory history(1000);
+  geometry_msgs::msg::Twist twist;
+  twist.linear.x = 10.0;
+  twist.angular.z = 0.5;
+  for (int i = 0; i < 1000; ++i) {
+    history.push(static_cast<int64_t>(i) * 10'000'000, twist);
+  }
+
+  const double t = 2.0;
+  const tf2::Transform motion = history.relative_motion(3'000'000'000, 5'000'000'000);
+  const double w = twist.angular.z;
+  EXPECT_NEAR(motion.getOrigin().x(), twist.linear.x / w * std::sin(w * t), 1e-3);
+  EXPECT_NEAR(motion.getOrigin().y(), twist.linear.x / w * (1 - std::cos(w * t)), 1e-3);
+  EXPECT_NEAR(tf2::getYaw(motion.getRotation()), w * t, 1e-9);
+}
+
+TEST(TwistHistory, oldest_twists_are_dropped_when_full)  // NOLINT
+{
+  autoware::pose_instability_detector::TwistHistory history(10);
+  geometry_msgs::msg::Twist twist;
+  for (int i = 0; i < 25; ++i) {
+    twist.linear.x = (i < 20) ? 1.0 : 3.0;
+    history.push(static_cast<int64_t>(i) * 1'000'000'000, twist);
+  }
+  EXPECT_EQ(history.size(), 10u);
+
+  // An older twist is ignored
+  history.push(0, twist);
+  EXPECT_EQ(history.size(), 10u);
+
+  EXPECT_NEAR(history.relative_motion(18'000'000'000, 22'000'000'000).getOrigin().x(), 8.0, 1e-9);
+}
+
+TEST(TwistHistory, twists_before_the_latest_are_integrated_after_clear)  // NOLINT
+{
+  autoware::pose_instability_detector::TwistHistory history(10);
+  geometry_msgs::msg::Twist twist;
+  twist.linear.x = 1.0;
+  for (int i = 10; i < 20; ++i) {
+    history.push(static_cast<int64_t>(i) * 1'000'000'000, twist);
+  }
+  EXPECT_EQ(history.latest_stamp_ns(), 19'000'000'000);
+
+  history.clear();
+  EXPECT_TRUE(history.empty());
+
+  // the time went backwards, the twists are not ignored anymore
+  twist.linear.x = 3.0;
+  for (int i = 0; i < 5; ++i) {
+    history.push(static_cast<int64_t>(i) * 1'000'000'000, twist);
+  }
+  EXPECT_EQ(history.size(), 5u);
+  EXPECT_EQ(history.latest_stamp_ns(), 4'000'000'000);
+  EXPECT_NEAR(history.relative_motion(1'000'000'000, 3'000'000'000).getOrigin().x(), 6.0, 1e-9);
+}
+
 int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
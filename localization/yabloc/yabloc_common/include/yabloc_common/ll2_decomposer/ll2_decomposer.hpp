@@ -15,9 +15,12 @@
 #ifndef YABLOC_COMMON__LL2_DECOMPOSER__LL2_DECOMPOSER_HPP_
 #define YABLOC_COMMON__LL2_DECOMPOSER__LL2_DECOMPOSER_HPP_
 
+#include "yabloc_common/ll2_decomposer/ll2_tile_cache.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
+#include <geometry_msgs/msg/pose_stamped.hpp>
 #include <sensor_msgs/msg/image.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
@@ -26,8 +29,11 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace yabloc::ll2_decomposer
 {
@@ -38,9 +44,21 @@ public:
   using LaneletMapBin = autoware_map_msgs::msg::LaneletMapBin;
   using Marker = visualization_msgs::msg::Marker;
   using MarkerArray = visualization_msgs::msg::MarkerArray;
+  using PoseStamped = geometry_msgs::msg::PoseStamped;
 
   explicit Ll2Decomposer(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
 
+  // Decomposition of the whole map, which is published when tiling is disabled
+  static pcl::PointCloud<pcl::PointNormal> split_line_strings(
+    const lanelet::ConstLineStrings3d & line_strings);
+
+  static pcl::PointCloud<pcl::PointXYZL> load_bounding_boxes(
+    const lanelet::PolygonLayer & polygons, const std::set<std::string> & labels);
+
+  static lanelet::ConstLineStrings3d extract_specified_line_string(
+    const lanelet::LineStringLayer & line_string_layer,
+    const std::set<std::string> & visible_labels);
+
 private:
   rclcpp::Publisher<Cloud2>::SharedPtr pub_road_marking_;
   rclcpp::Publisher<Cloud2>::SharedPtr pub_sign_board_;
@@ -48,23 +66,30 @@ private:
   rclcpp::Publisher<MarkerArray>::SharedPtr pub_marker_;
 
   rclcpp::Subscription<LaneletMapBin>::SharedPtr sub_map_;
+  rclcpp::Subscription<PoseStamped>::SharedPtr sub_pose_;
   std::set<std::string> road_marking_labels_;
   std::set<std::string> sign_board_labels_;
   std::set<std::string> bounding_box_labels_;
 
+  // Tiled decomposition. It is disabled when tile_size is not positive.
+  const double tile_radius_;
+  const std::string cache_path_;
+  std::unique_ptr<Ll2TileCache> tile_cache_{nullptr};
+  bool tiles_ready_{false};
+  uint64_t map_hash_{0};
+  std::optional<PoseStamped> last_pose_{std::nullopt};
+  std::optional<std::vector<Ll2TileCache::TileKey>> published_keys_{std::nullopt};
+  std::set<uint32_t> published_bounding_box_labels_;
+
   void on_map(const LaneletMapBin & msg);
+  void on_pose(const PoseStamped & msg);
+
+  void load_tiles(const LaneletMapBin & msg);
+  void publish_tiles(const PoseStamped & pose);
 
   static pcl::PointNormal to_point_normal(
     const lanelet::ConstPoint3d & from, const lanelet::ConstPoint3d & to);
 
-  static pcl::PointCloud<pcl::PointNormal> split_line_strings(
-    const lanelet::ConstLineStrings3d & line_strings);
-
-  pcl::PointCloud<pcl::PointXYZL> load_bounding_boxes(const lanelet::PolygonLayer & polygons) const;
-
-  static lanelet::ConstLineStrings3d extract_specified_line_string(
-    const lanelet::LineStringLayer & line_string_layer,
-    const std::set<std::string> & visible_labels);
   static lanelet::ConstPolygons3d extract_specified_polygon(
     const lanelet::PolygonLayer & polygon_layer, const std::set<std::string> & visible_labels);
 
@@ -75,7 +100,7 @@ private:
     const lanelet::PolygonLayer & polygon_layer, const std::set<std::string> & labels,
     const std::string & ns);
 
-  void publish_additional_marker(const lanelet::LaneletMapPtr & lanelet_map);
+  MarkerArray make_additional_marker(const lanelet::LaneletMapPtr & lanelet_map);
 };
 }  // namespace yabloc::ll2_decomposer
 
@@ -0,0 +1,143 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YABLOC_COMMON__LL2_DECOMPOSER__LL2_TILE_CACHE_HPP_
+#define YABLOC_COMMON__LL2_DECOMPOSER__LL2_TILE_CACHE_HPP_
+
+#include <Eigen/Core>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yabloc::ll2_decomposer
+{
+// Decomposed lanelet2 elements in one grid cell
+struct Ll2Tile
+{
+  // Each point is a line segment; (x, y, z) is the start and (normal_x, normal_y, normal_z) is the
+  // end. A segment belongs to every tile which its bounding box overlaps.
+  pcl::PointCloud<pcl::PointNormal> road_marking;
+  pcl::PointCloud<pcl::PointNormal> sign_board;
+  // Index of each segment among the segments of the whole map, which tells apart the copies of a
+  // segment in several tiles
+  std::vector<uint32_t> road_marking_index;
+  std::vector<uint32_t> sign_board_index;
+  // Vertices of polygons labeled by the polygon index. A polygon belongs to every tile which its
+  // bounding box overlaps.
+  pcl::PointCloud<pcl::PointXYZL> bounding_box;
+};
+
+/**
+ * Lanelet2 decomposition split into square tiles which are built on demand
+ *
+ * The tiles are made either from a lanelet2 map (set_map) or from a cache file written by save()
+ * (load). When the tiles come from a file, the lanelet2 map does not have to be parsed at all and
+ * only the tiles around the vehicle are read into memory.
+ */
+class Ll2TileCache
+{
+public:
+  using TileKey = int64_t;
+
+  Ll2TileCache(
+    float tile_size, const std::set<std::string> & road_marking_labels,
+    const std::set<std::string> & sign_board_labels,
+    const std::set<std::string> & bounding_box_labels);
+
+  // Fingerprint of the serialized map which is used to validate the cache file
+  static uint64_t hash(const std::vector<uint8_t> & data);
+
+  // Index the elements of the map by tile. Nothing is decomposed until the tile is requested.
+  void set_map(const lanelet::LaneletMapPtr & lanelet_map, uint64_t map_hash);
+
+  // Return false if the file does not exist or was made from another map, labels or tile size
+  bool load(const std::string & path, uint64_t map_hash);
+
+  // Decompose all tiles and write them into the file
+  bool save(const std::string & path);
+
+  // Existing tiles which intersect the square of (2 * radius) around the position
+  std::vector<TileKey> keys_around(const Eigen::Vector2f & position, float radius) const;
+
+  // Concatenate the tiles, an element in several of them is gathered once. The decomposed tiles are
+  // kept until erase_except() is called.
+  Ll2Tile gather(const std::vector<TileKey> & keys);
+
+  // Release the decomposed tiles which are not in keys
+  void erase_except(const std::vector<TileKey> & keys);
+
+  size_t tile_num() const { return tile_keys_.size(); }
+  size_t decomposed_tile_num() const { return tiles_.size(); }
+
+private:
+  // Elements which overlap one tile with the index of their first segment or of the polygon, kept
+  // while the source is a lanelet2 map
+  using IndexedLineStrings = std::vector<std::pair<lanelet::ConstLineString3d, uint32_t>>;
+  struct MapEntry
+  {
+    IndexedLineStrings road_marking;
+    IndexedLineStrings sign_board;
+    std::vector<std::pair<lanelet::ConstPolygon3d, uint32_t>> bounding_box;
+  };
+
+  // Inclusive range of the tile indices
+  struct TileRange
+  {
+    int32_t ix_min;
+    int32_t iy_min;
+    int32_t ix_max;
+    int32_t iy_max;
+  };
+
+  // Location of one tile in the cache file
+  struct FileEntry
+  {
+    uint64_t offset;
+    uint32_t road_marking_num;
+    uint32_t sign_board_num;
+    uint32_t bounding_box_num;
+  };
+
+  const float tile_size_;
+  const std::set<std::string> road_marking_labels_;
+  const std::set<std::string> sign_board_labels_;
+  const std::set<std::string> bounding_box_labels_;
+  const uint64_t labels_hash_;
+
+  uint64_t map_hash_{0};
+  std::set<TileKey> tile_keys_;
+  std::unordered_map<TileKey, MapEntry> map_entries_;
+  std::unordered_map<TileKey, FileEntry> file_entries_;
+  std::ifstream file_;
+  std::unordered_map<TileKey, Ll2Tile> tiles_;
+
+  TileRange to_range(double x_min, double y_min, double x_max, double y_max) const;
+  TileRange to_range(const lanelet::ConstPoint3d & from, const lanelet::ConstPoint3d & to) const;
+  const Ll2Tile & tile(TileKey key);
+  Ll2Tile decompose(TileKey key, const MapEntry & entry) const;
+  Ll2Tile read(const FileEntry & entry);
+  void clear();
+};
+}  // namespace yabloc::ll2_decomposer
+
+#endif  // YABLOC_COMMON__LL2_DECOMPOSER__LL2_TILE_CACHE_HPP_
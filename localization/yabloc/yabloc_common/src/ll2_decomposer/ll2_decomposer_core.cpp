@@ -21,14 +21,22 @@
 #include <geometry_msgs/msg/polygon.hpp>
 
 #include <pcl_conversions/pcl_conversions.h>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
 
 #include <algorithm>
+#include <fstream>
+#include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace yabloc::ll2_decomposer
 {
-Ll2Decomposer::Ll2Decomposer(const rclcpp::NodeOptions & options) : Node("ll2_to_image", options)
+Ll2Decomposer::Ll2Decomposer(const rclcpp::NodeOptions & options)
+: Node("ll2_to_image", options),
+  tile_radius_(declare_parameter<double>("tile_radius")),
+  cache_path_(declare_parameter<std::string>("cache_path"))
 {
   using std::placeholders::_1;
   const rclcpp::QoS latch_qos = rclcpp::QoS(1).transient_local();
@@ -59,6 +67,14 @@ Ll2Decomposer::Ll2Decomposer(const rclcpp::NodeOptions & options) : Node("ll2_to
     RCLCPP_FATAL_STREAM(
       get_logger(), "There are no road marking labels. No LL2 elements will publish");
   }
+
+  const auto tile_size = static_cast<float>(declare_parameter<double>("tile_size"));
+  if (tile_size > 0) {
+    tile_cache_ = std::make_unique<Ll2TileCache>(
+      tile_size, road_marking_labels_, sign_board_labels_, bounding_box_labels_);
+    auto cb_pose = std::bind(&Ll2Decomposer::on_pose, this, _1);
+    sub_pose_ = create_subscription<PoseStamped>("~/input/pose", 10, cb_pose);
+  }
 }
 
 void print_attr(const lanelet::LaneletMapPtr & lanelet_map, const rclcpp::Logger & logger)
@@ -82,8 +98,59 @@ void print_attr(const lanelet::LaneletMapPtr & lanelet_map, const rclcpp::Logger
   }
 }
 
+namespace
+{
+// The markers are serialized next to the tile cache file, after the hash of their source
+bool save_marker(
+  const std::string & path, const uint64_t marker_hash,
+  const visualization_msgs::msg::MarkerArray & markers)
+{
+  rclcpp::Serialization<visualization_msgs::msg::MarkerArray> serialization;
+  rclcpp::SerializedMessage serialized;
+  serialization.serialize_message(&markers, &serialized);
+  const auto & rcl_serialized = serialized.get_rcl_serialized_message();
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&marker_hash), sizeof(marker_hash));
+  file.write(
+    reinterpret_cast<const char *>(rcl_serialized.buffer),
+    static_cast<std::streamsize>(rcl_serialized.buffer_length));
+  return file.good();
+}
+
+std::optional<visualization_msgs::msg::MarkerArray> load_marker(
+  const std::string & path, const uint64_t marker_hash)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) return std::nullopt;
+  const std::streamoff file_size = file.tellg();
+  if (file_size < static_cast<std::streamoff>(sizeof(marker_hash))) return std::nullopt;
+  file.seekg(0);
+
+  uint64_t file_hash = 0;
+  file.read(reinterpret_cast<char *>(&file_hash), sizeof(file_hash));
+  if (!file || file_hash != marker_hash) return std::nullopt;
+
+  const auto size = static_cast<size_t>(file_size) - sizeof(marker_hash);
+  rclcpp::SerializedMessage serialized(size);
+  auto & rcl_serialized = serialized.get_rcl_serialized_message();
+  file.read(reinterpret_cast<char *>(rcl_serialized.buffer), static_cast<std::streamsize>(size));
+  if (!file) return std::nullopt;
+  rcl_serialized.buffer_length = size;
+
+  visualization_msgs::msg::MarkerArray markers;
+  rclcpp::Serialization<visualization_msgs::msg::MarkerArray> serialization;
+  try {
+    serialization.deserialize_message(&serialized, &markers);
+  } catch (const rclcpp::exceptions::RCLError &) {
+    return std::nullopt;
+  }
+  return markers;
+}
+}  // namespace
+
 pcl::PointCloud<pcl::PointXYZL> Ll2Decomposer::load_bounding_boxes(
-  const lanelet::PolygonLayer & polygons) const
+  const lanelet::PolygonLayer & polygons, const std::set<std::string> & labels)
 {
   pcl::PointCloud<pcl::PointXYZL> cloud;
   int index = 0;
@@ -91,7 +158,7 @@ pcl::PointCloud<pcl::PointXYZL> Ll2Decomposer::load_bounding_boxes(
   for (const lanelet::ConstPolygon3d & polygon : polygons) {
     if (!polygon.hasAttribute(lanelet::AttributeName::Type)) continue;
     const lanelet::Attribute & attr = polygon.attribute(lanelet::AttributeName::Type);
-    if (bounding_box_labels_.count(attr.value()) == 0) continue;
+    if (labels.count(attr.value()) == 0) continue;
 
     for (const lanelet::ConstPoint3d & p : polygon) {
       pcl::PointXYZL xyzl;
@@ -109,6 +176,11 @@ pcl::PointCloud<pcl::PointXYZL> Ll2Decomposer::load_bounding_boxes(
 void Ll2Decomposer::on_map(const LaneletMapBin & msg)
 {
   RCLCPP_INFO_STREAM(get_logger(), "subscribed binary vector map");
+  if (tile_cache_) {
+    load_tiles(msg);
+    return;
+  }
+
   lanelet::LaneletMapPtr lanelet_map(new lanelet::LaneletMap);
   lanelet::utils::conversion::fromBinMsg(msg, lanelet_map);
   print_attr(lanelet_map, get_logger());
@@ -121,9 +193,10 @@ void Ll2Decomposer::on_map(const LaneletMapBin & msg)
   auto tmp2 = extract_specified_line_string(ls_layer, road_marking_labels_);
   pcl::PointCloud<pcl::PointNormal> ll2_sign_board = split_line_strings(tmp1);
   pcl::PointCloud<pcl::PointNormal> ll2_road_marking = split_line_strings(tmp2);
-  pcl::PointCloud<pcl::PointXYZL> ll2_bounding_box = load_bounding_boxes(po_layer);
+  pcl::PointCloud<pcl::PointXYZL> ll2_bounding_box =
+    load_bounding_boxes(po_layer, bounding_box_labels_);
 
-  publish_additional_marker(lanelet_map);
+  pub_marker_->publish(make_additional_marker(lanelet_map));
 
   common::publish_cloud(*pub_road_marking_, ll2_road_marking, stamp);
   common::publish_cloud(*pub_sign_board_, ll2_sign_board, stamp);
@@ -132,6 +205,99 @@ void Ll2Decomposer::on_map(const LaneletMapBin & msg)
   RCLCPP_INFO_STREAM(get_logger(), "succeeded map decomposing");
 }
 
+void Ll2Decomposer::load_tiles(const LaneletMapBin & msg)
+{
+  const uint64_t map_hash = Ll2TileCache::hash(msg.data);
+
+  // The same map is received again (e.g. the map loader restarted), the tiles and the bounding
+  // boxes which were published are still valid
+  if (tiles_ready_ && map_hash_ == map_hash) {
+    RCLCPP_INFO_STREAM(get_logger(), "the map is unchanged, the tiles are kept");
+    return;
+  }
+
+  // The markers depend on the map and on the sign board labels
+  std::vector<uint8_t> sign_board_labels;
+  for (const std::string & label : sign_board_labels_) {
+    sign_board_labels.insert(sign_board_labels.end(), label.begin(), label.end());
+    sign_board_labels.push_back('\n');
+  }
+  const uint64_t marker_hash = map_hash ^ Ll2TileCache::hash(sign_board_labels);
+  const std::string marker_path = cache_path_ + ".marker";
+
+  // When the cache file was made from the same map, the map is not even parsed
+  std::optional<MarkerArray> cached_marker = std::nullopt;
+  if (!cache_path_.empty()) cached_marker = load_marker(marker_path, marker_hash);
+  if (cached_marker && tile_cache_->load(cache_path_, map_hash)) {
+    RCLCPP_INFO_STREAM(
+      get_logger(), "loaded " << tile_cache_->tile_num() << " tiles from " << cache_path_);
+    // The markers were made at the previous startup
+    const rclcpp::Time now = get_clock()->now();
+    for (Marker & marker : cached_marker->markers) marker.header.stamp = now;
+    pub_marker_->publish(*cached_marker);
+  } else {
+    lanelet::LaneletMapPtr lanelet_map(new lanelet::LaneletMap);
+    lanelet::utils::conversion::fromBinMsg(msg, lanelet_map);
+    print_attr(lanelet_map, get_logger());
+    const MarkerArray marker = make_additional_marker(lanelet_map);
+    pub_marker_->publish(marker);
+    tile_cache_->set_map(lanelet_map, map_hash);
+
+    // Serve the tiles from the file afterwards so that the lanelet2 map can be released
+    if (!cache_path_.empty()) {
+      if (
+        tile_cache_->save(cache_path_) && tile_cache_->load(cache_path_, map_hash) &&
+        save_marker(marker_path, marker_hash, marker)) {
+        RCLCPP_INFO_STREAM(
+          get_logger(), "saved " << tile_cache_->tile_num() << " tiles to " << cache_path_);
+      } else {
+        RCLCPP_WARN_STREAM(get_logger(), "failed to write the decomposed map to " << cache_path_);
+      }
+    }
+  }
+
+  tiles_ready_ = true;
+  map_hash_ = map_hash;
+  published_keys_ = std::nullopt;
+  published_bounding_box_labels_.clear();
+  if (last_pose_) publish_tiles(*last_pose_);
+  RCLCPP_INFO_STREAM(get_logger(), "succeeded map indexing");
+}
+
+void Ll2Decomposer::on_pose(const PoseStamped & msg)
+{
+  last_pose_ = msg;
+  if (tiles_ready_) publish_tiles(msg);
+}
+
+void Ll2Decomposer::publish_tiles(const PoseStamped & pose)
+{
+  const Eigen::Vector2f position(
+    static_cast<float>(pose.pose.position.x), static_cast<float>(pose.pose.position.y));
+  const std::vector<Ll2TileCache::TileKey> keys =
+    tile_cache_->keys_around(position, static_cast<float>(tile_radius_));
+  if (published_keys_ && *published_keys_ == keys) return;
+
+  const Ll2Tile tiles = tile_cache_->gather(keys);
+  tile_cache_->erase_except(keys);
+
+  // NOTE: The bounding boxes are accumulated by the subscriber, so only new ones are published.
+  // A bounding box over several tiles is told apart by its label.
+  pcl::PointCloud<pcl::PointXYZL> new_bounding_box;
+  for (const pcl::PointXYZL & p : tiles.bounding_box) {
+    if (published_bounding_box_labels_.count(p.label) == 0) new_bounding_box.push_back(p);
+  }
+  for (const pcl::PointXYZL & p : new_bounding_box) published_bounding_box_labels_.insert(p.label);
+
+  const rclcpp::Time stamp = pose.header.stamp;
+  common::publish_cloud(*pub_road_marking_, tiles.road_marking, stamp);
+  common::publish_cloud(*pub_sign_board_, tiles.sign_board, stamp);
+  if (!new_bounding_box.empty()) {
+    common::publish_cloud(*pub_bounding_box_, new_bounding_box, stamp);
+  }
+  published_keys_ = keys;
+}
+
 pcl::PointCloud<pcl::PointNormal> Ll2Decomposer::split_line_strings(
   const lanelet::ConstLineStrings3d & line_strings)
 {
@@ -253,7 +419,8 @@ Ll2Decomposer::MarkerArray Ll2Decomposer::make_polygon_marker_msg(
   return marker_array;
 }
 
-void Ll2Decomposer::publish_additional_marker(const lanelet::LaneletMapPtr & lanelet_map)
+Ll2Decomposer::MarkerArray Ll2Decomposer::make_additional_marker(
+  const lanelet::LaneletMapPtr & lanelet_map)
 {
   auto marker1 =
     make_sign_marker_msg(lanelet_map->lineStringLayer, sign_board_labels_, "sign_board");
@@ -263,7 +430,7 @@ void Ll2Decomposer::publish_additional_marker(const lanelet::LaneletMapPtr & lan
 
   std::copy(marker2.markers.begin(), marker2.markers.end(), std::back_inserter(marker1.markers));
   std::copy(marker3.markers.begin(), marker3.markers.end(), std::back_inserter(marker1.markers));
-  pub_marker_->publish(marker1);
+  return marker1;
 }
 
 }  // namespace yabloc::ll2_decomposer
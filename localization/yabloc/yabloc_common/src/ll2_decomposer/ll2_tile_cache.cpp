@@ -0,0 +1,488 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_common/ll2_decomposer/ll2_tile_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace yabloc::ll2_decomposer
+{
+namespace
+{
+// Cache file layout (native endianness)
+//   header : magic[8], version, tile_size, map_hash, labels_hash, tile_num
+//   table  : tile_num x {key, offset, road_marking_num, sign_board_num, bounding_box_num, reserved}
+//   data   : for each tile, road_marking (6 floats and 1 uint32), sign_board (6 floats and 1
+//            uint32) and bounding_box (3 floats and 1 uint32) are stored in this order
+constexpr std::array<char, 8> file_magic = {'Y', 'B', 'L', 'L', '2', 'T', 'I', 'L'};
+constexpr uint32_t file_version = 2;
+constexpr size_t segment_record_size = 6 * sizeof(float) + sizeof(uint32_t);
+constexpr size_t bounding_box_record_size = 3 * sizeof(float) + sizeof(uint32_t);
+
+struct FileHeader
+{
+  std::array<char, 8> magic;
+  uint32_t version;
+  float tile_size;
+  uint64_t map_hash;
+  uint64_t labels_hash;
+  uint64_t tile_num;
+};
+
+struct FileTableEntry
+{
+  int64_t key;
+  uint64_t offset;
+  uint32_t road_marking_num;
+  uint32_t sign_board_num;
+  uint32_t bounding_box_num;
+  uint32_t reserved;
+};
+
+constexpr uint64_t fnv_offset = 0xcbf29ce484222325ULL;
+constexpr uint64_t fnv_prime = 0x100000001b3ULL;
+
+uint64_t fnv1a(const void * data, size_t size, uint64_t seed)
+{
+  const auto * bytes = static_cast<const uint8_t *>(data);
+  uint64_t h = seed;
+  for (size_t i = 0; i < size; ++i) {
+    h = (h ^ bytes[i]) * fnv_prime;
+  }
+  return h;
+}
+
+uint64_t hash_labels(
+  const std::set<std::string> & road_marking_labels,
+  const std::set<std::string> & sign_board_labels,
+  const std::set<std::string> & bounding_box_labels)
+{
+  uint64_t h = fnv_offset;
+  for (const auto * labels : {&road_marking_labels, &sign_board_labels, &bounding_box_labels}) {
+    for (const std::string & label : *labels) {
+      h = fnv1a(label.data(), label.size(), h);
+      h = fnv1a("\n", 1, h);
+    }
+    h = fnv1a("\t", 1, h);
+  }
+  return h;
+}
+
+Ll2TileCache::TileKey make_key(int32_t ix, int32_t iy)
+{
+  return (static_cast<int64_t>(ix) << 32) | static_cast<int64_t>(static_cast<uint32_t>(iy));
+}
+
+int32_t key_x(Ll2TileCache::TileKey key)
+{
+  return static_cast<int32_t>(key >> 32);
+}
+
+int32_t key_y(Ll2TileCache::TileKey key)
+{
+  return static_cast<int32_t>(static_cast<uint32_t>(key & 0xffffffff));
+}
+
+bool has_label(const lanelet::ConstLineString3d & line, const std::set<std::string> & labels)
+{
+  if (!line.hasAttribute(lanelet::AttributeName::Type)) return false;
+  return labels.count(line.attribute(lanelet::AttributeName::Type).value()) > 0;
+}
+
+pcl::PointNormal to_point_normal(
+  const lanelet::ConstPoint3d & from, const lanelet::ConstPoint3d & to)
+{
+  pcl::PointNormal pn;
+  pn.x = static_cast<float>(from.x());
+  pn.y = static_cast<float>(from.y());
+  pn.z = static_cast<float>(from.z());
+  pn.normal_x = static_cast<float>(to.x());
+  pn.normal_y = static_cast<float>(to.y());
+  pn.normal_z = static_cast<float>(to.z());
+  return pn;
+}
+
+void write_segments(
+  std::ofstream & ofs, const pcl::PointCloud<pcl::PointNormal> & segments,
+  const std::vector<uint32_t> & indices)
+{
+  std::vector<char> buffer(segments.size() * segment_record_size);
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const pcl::PointNormal & pn = segments.at(i);
+    const std::array<float, 6> v = {pn.x, pn.y, pn.z, pn.normal_x, pn.normal_y, pn.normal_z};
+    char * record = buffer.data() + segment_record_size * i;
+    std::memcpy(record, v.data(), sizeof(v));
+    std::memcpy(record + sizeof(v), &indices.at(i), sizeof(uint32_t));
+  }
+  ofs.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void read_segments(
+  std::ifstream & ifs, uint32_t num, pcl::PointCloud<pcl::PointNormal> & segments,
+  std::vector<uint32_t> & indices)
+{
+  std::vector<char> buffer(static_cast<size_t>(num) * segment_record_size);
+  ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  segments.resize(num);
+  indices.resize(num);
+  for (uint32_t i = 0; i < num; ++i) {
+    const char * record = buffer.data() + segment_record_size * i;
+    std::array<float, 6> v{};
+    std::memcpy(v.data(), record, sizeof(v));
+    std::memcpy(&indices.at(i), record + sizeof(v), sizeof(uint32_t));
+    pcl::PointNormal & pn = segments.at(i);
+    pn.x = v[0];
+    pn.y = v[1];
+    pn.z = v[2];
+    pn.normal_x = v[3];
+    pn.normal_y = v[4];
+    pn.normal_z = v[5];
+  }
+}
+}  // namespace
+
+Ll2TileCache::Ll2TileCache(
+  float tile_size, const std::set<std::string> & road_marking_labels,
+  const std::set<std::string> & sign_board_labels,
+  const std::set<std::string> & bounding_box_labels)
+: tile_size_(tile_size),
+  road_marking_labels_(road_marking_labels),
+  sign_board_labels_(sign_board_labels),
+  bounding_box_labels_(bounding_box_labels),
+  labels_hash_(hash_labels(road_marking_labels, sign_board_labels, bounding_box_labels))
+{
+}
+
+uint64_t Ll2TileCache::hash(const std::vector<uint8_t> & data)
+{
+  return fnv1a(data.data(), data.size(), fnv_offset);
+}
+
+Ll2TileCache::TileRange Ll2TileCache::to_range(
+  double x_min, double y_min, double x_max, double y_max) const
+{
+  return TileRange{
+    static_cast<int32_t>(std::floor(x_min / tile_size_)),
+    static_cast<int32_t>(std::floor(y_min / tile_size_)),
+    static_cast<int32_t>(std::floor(x_max / tile_size_)),
+    static_cast<int32_t>(std::floor(y_max / tile_size_))};
+}
+
+Ll2TileCache::TileRange Ll2TileCache::to_range(
+  const lanelet::ConstPoint3d & from, const lanelet::ConstPoint3d & to) const
+{
+  return to_range(
+    std::min(from.x(), to.x()), std::min(from.y(), to.y()), std::max(from.x(), to.x()),
+    std::max(from.y(), to.y()));
+}
+
+void Ll2TileCache::clear()
+{
+  tile_keys_.clear();
+  map_entries_.clear();
+  file_entries_.clear();
+  tiles_.clear();
+  if (file_.is_open()) file_.close();
+}
+
+void Ll2TileCache::set_map(const lanelet::LaneletMapPtr & lanelet_map, uint64_t map_hash)
+{
+  clear();
+  map_hash_ = map_hash;
+
+  // A line string is registered to every tile which the bounding box of at least one of its
+  // segments overlaps. The segments are numbered in the order of the untiled decomposition.
+  auto register_line = [this](
+                         const lanelet::ConstLineString3d & line, bool road_marking,
+                         uint32_t & segment_index) -> void {
+    std::set<TileKey> registered;
+    for (size_t i = 0; i + 1 < line.size(); ++i) {
+      const TileRange range = to_range(line[i], line[i + 1]);
+      for (int32_t ix = range.ix_min; ix <= range.ix_max; ++ix) {
+        for (int32_t iy = range.iy_min; iy <= range.iy_max; ++iy) {
+          registered.insert(make_key(ix, iy));
+        }
+      }
+    }
+    for (const TileKey key : registered) {
+      MapEntry & entry = map_entries_[key];
+      (road_marking ? entry.road_marking : entry.sign_board).emplace_back(line, segment_index);
+    }
+    if (!line.empty()) segment_index += static_cast<uint32_t>(line.size() - 1);
+  };
+
+  uint32_t road_marking_index = 0;
+  uint32_t sign_board_index = 0;
+  for (const lanelet::ConstLineString3d & line : lanelet_map->lineStringLayer) {
+    if (has_label(line, road_marking_labels_)) register_line(line, true, road_marking_index);
+    if (has_label(line, sign_board_labels_)) register_line(line, false, sign_board_index);
+  }
+
+  uint32_t polygon_index = 0;
+  for (const lanelet::ConstPolygon3d & polygon : lanelet_map->polygonLayer) {
+    if (!polygon.hasAttribute(lanelet::AttributeName::Type)) continue;
+    const lanelet::Attribute & attr = polygon.attribute(lanelet::AttributeName::Type);
+    if (bounding_box_labels_.count(attr.value()) == 0) continue;
+    if (!polygon.empty()) {
+      double x_min = polygon.front().x();
+      double y_min = polygon.front().y();
+      double x_max = x_min;
+      double y_max = y_min;
+      for (const lanelet::ConstPoint3d & p : polygon) {
+        x_min = std::min(x_min, p.x());
+        y_min = std::min(y_min, p.y());
+        x_max = std::max(x_max, p.x());
+        y_max = std::max(y_max, p.y());
+      }
+      const TileRange range = to_range(x_min, y_min, x_max, y_max);
+      for (int32_t ix = range.ix_min; ix <= range.ix_max; ++ix) {
+        for (int32_t iy = range.iy_min; iy <= range.iy_max; ++iy) {
+          map_entries_[make_key(ix, iy)].bounding_box.emplace_back(polygon, polygon_index);
+        }
+      }
+    }
+    polygon_index++;
+  }
+
+  for (const auto & [key, entry] : map_entries_) tile_keys_.insert(key);
+}
+
+Ll2Tile Ll2TileCache::decompose(TileKey key, const MapEntry & entry) const
+{
+  Ll2Tile tile;
+  const int32_t ix = key_x(key);
+  const int32_t iy = key_y(key);
+  auto split_line_strings = [this, ix, iy](
+                              const IndexedLineStrings & lines,
+                              pcl::PointCloud<pcl::PointNormal> & segments,
+                              std::vector<uint32_t> & indices) -> void {
+    for (const auto & [line, first_index] : lines) {
+      for (size_t i = 0; i + 1 < line.size(); ++i) {
+        const TileRange range = to_range(line[i], line[i + 1]);
+        if (ix < range.ix_min || range.ix_max < ix || iy < range.iy_min || range.iy_max < iy) {
+          continue;
+        }
+        segments.push_back(to_point_normal(line[i], line[i + 1]));
+        indices.push_back(first_index + static_cast<uint32_t>(i));
+      }
+    }
+  };
+  split_line_strings(entry.road_marking, tile.road_marking, tile.road_marking_index);
+  split_line_strings(entry.sign_board, tile.sign_board, tile.sign_board_index);
+
+  for (const auto & [polygon, index] : entry.bounding_box) {
+    for (const lanelet::ConstPoint3d & p : polygon) {
+      pcl::PointXYZL xyzl;
+      xyzl.x = static_cast<float>(p.x());
+      xyzl.y = static_cast<float>(p.y());
+      xyzl.z = static_cast<float>(p.z());
+      xyzl.label = index;
+      tile.bounding_box.push_back(xyzl);
+    }
+  }
+  return tile;
+}
+
+bool Ll2TileCache::save(const std::string & path)
+{
+  // Tiles read from a cache file can not be saved again
+  if (!file_entries_.empty()) return false;
+
+  // Write into a temporary file so that an interrupted run does not leave a broken cache
+  const std::string tmp_path = path + ".tmp";
+  std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+  if (!ofs) return false;
+
+  FileHeader header{};
+  header.magic = file_magic;
+  header.version = file_version;
+  header.tile_size = tile_size_;
+  header.map_hash = map_hash_;
+  header.labels_hash = labels_hash_;
+  header.tile_num = tile_keys_.size();
+  ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  // The table is written after the data because the sizes are known only after decomposition
+  std::vector<FileTableEntry> table;
+  table.reserve(tile_keys_.size());
+  uint64_t offset = sizeof(FileHeader) + sizeof(FileTableEntry) * tile_keys_.size();
+  ofs.seekp(static_cast<std::streamoff>(offset));
+
+  for (const TileKey key : tile_keys_) {
+    const Ll2Tile tile = decompose(key, map_entries_.at(key));
+    FileTableEntry row{};
+    row.key = key;
+    row.offset = offset;
+    row.road_marking_num = static_cast<uint32_t>(tile.road_marking.size());
+    row.sign_board_num = static_cast<uint32_t>(tile.sign_board.size());
+    row.bounding_box_num = static_cast<uint32_t>(tile.bounding_box.size());
+    table.push_back(row);
+
+    write_segments(ofs, tile.road_marking, tile.road_marking_index);
+    write_segments(ofs, tile.sign_board, tile.sign_board_index);
+    for (const pcl::PointXYZL & p : tile.bounding_box) {
+      ofs.write(reinterpret_cast<const char *>(&p.x), sizeof(float) * 3);
+      ofs.write(reinterpret_cast<const char *>(&p.label), sizeof(uint32_t));
+    }
+    offset += (row.road_marking_num + row.sign_board_num) * segment_record_size +
+              row.bounding_box_num * bounding_box_record_size;
+  }
+
+  ofs.seekp(sizeof(FileHeader));
+  ofs.write(
+    reinterpret_cast<const char *>(table.data()),
+    static_cast<std::streamsize>(table.size() * sizeof(FileTableEntry)));
+  ofs.close();
+  if (!ofs) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool Ll2TileCache::load(const std::string & path, uint64_t map_hash)
+{
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs) return false;
+
+  FileHeader header{};
+  ifs.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!ifs || header.magic != file_magic || header.version != file_version) return false;
+  if (header.tile_size != tile_size_ || header.labels_hash != labels_hash_) return false;
+  if (header.map_hash != map_hash) return false;
+
+  std::vector<FileTableEntry> table(header.tile_num);
+  ifs.read(
+    reinterpret_cast<char *>(table.data()),
+    static_cast<std::streamsize>(table.size() * sizeof(FileTableEntry)));
+  if (!ifs) return false;
+
+  clear();
+  map_hash_ = map_hash;
+  for (const FileTableEntry & row : table) {
+    tile_keys_.insert(row.key);
+    file_entries_[row.key] =
+      FileEntry{row.offset, row.road_marking_num, row.sign_board_num, row.bounding_box_num};
+  }
+  file_ = std::move(ifs);
+  return true;
+}
+
+Ll2Tile Ll2TileCache::read(const FileEntry & entry)
+{
+  Ll2Tile tile;
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(entry.offset));
+  read_segments(file_, entry.road_marking_num, tile.road_marking, tile.road_marking_index);
+  read_segments(file_, entry.sign_board_num, tile.sign_board, tile.sign_board_index);
+
+  tile.bounding_box.resize(entry.bounding_box_num);
+  for (pcl::PointXYZL & p : tile.bounding_box) {
+    file_.read(reinterpret_cast<char *>(&p.x), sizeof(float) * 3);
+    file_.read(reinterpret_cast<char *>(&p.label), sizeof(uint32_t));
+  }
+  return tile;
+}
+
+const Ll2Tile & Ll2TileCache::tile(TileKey key)
+{
+  auto itr = tiles_.find(key);
+  if (itr != tiles_.end()) return itr->second;
+
+  if (auto map_itr = map_entries_.find(key); map_itr != map_entries_.end()) {
+    return tiles_.emplace(key, decompose(key, map_itr->second)).first->second;
+  }
+  if (auto file_itr = file_entries_.find(key); file_itr != file_entries_.end()) {
+    return tiles_.emplace(key, read(file_itr->second)).first->second;
+  }
+  return tiles_.emplace(key, Ll2Tile{}).first->second;
+}
+
+std::vector<Ll2TileCache::TileKey> Ll2TileCache::keys_around(
+  const Eigen::Vector2f & position, float radius) const
+{
+  const auto ix_min = static_cast<int32_t>(std::floor((position.x() - radius) / tile_size_));
+  const auto ix_max = static_cast<int32_t>(std::floor((position.x() + radius) / tile_size_));
+  const auto iy_min = static_cast<int32_t>(std::floor((position.y() - radius) / tile_size_));
+  const auto iy_max = static_cast<int32_t>(std::floor((position.y() + radius) / tile_size_));
+
+  std::vector<TileKey> keys;
+  for (int32_t ix = ix_min; ix <= ix_max; ++ix) {
+    for (int32_t iy = iy_min; iy <= iy_max; ++iy) {
+      const TileKey key = make_key(ix, iy);
+      if (tile_keys_.count(key) > 0) keys.push_back(key);
+    }
+  }
+  return keys;
+}
+
+Ll2Tile Ll2TileCache::gather(const std::vector<TileKey> & keys)
+{
+  // The elements over several tiles are taken from the first of them
+  auto gather_segments = [](
+                           const pcl::PointCloud<pcl::PointNormal> & segments,
+                           const std::vector<uint32_t> & indices,
+                           std::unordered_set<uint32_t> & gathered_indices,
+                           pcl::PointCloud<pcl::PointNormal> & gathered_segments,
+                           std::vector<uint32_t> & gathered_segment_indices) -> void {
+    for (size_t i = 0; i < segments.size(); ++i) {
+      if (!gathered_indices.insert(indices.at(i)).second) continue;
+      gathered_segments.push_back(segments.at(i));
+      gathered_segment_indices.push_back(indices.at(i));
+    }
+  };
+
+  Ll2Tile gathered;
+  std::unordered_set<uint32_t> road_marking_indices;
+  std::unordered_set<uint32_t> sign_board_indices;
+  std::unordered_map<uint32_t, TileKey> bounding_box_tiles;
+  for (const TileKey key : keys) {
+    const Ll2Tile & t = tile(key);
+    gather_segments(
+      t.road_marking, t.road_marking_index, road_marking_indices, gathered.road_marking,
+      gathered.road_marking_index);
+    gather_segments(
+      t.sign_board, t.sign_board_index, sign_board_indices, gathered.sign_board,
+      gathered.sign_board_index);
+    for (const pcl::PointXYZL & p : t.bounding_box) {
+      if (bounding_box_tiles.emplace(p.label, key).first->second == key) {
+        gathered.bounding_box.push_back(p);
+      }
+    }
+  }
+  return gathered;
+}
+
+void Ll2TileCache::erase_except(const std::vector<TileKey> & keys)
+{
+  for (auto itr = tiles_.begin(); itr != tiles_.end();) {
+    if (std::find(keys.begin(), keys.end(), itr->first) == keys.end()) {
+      itr = tiles_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+
+}  // namespace yabloc::ll2_decomposer
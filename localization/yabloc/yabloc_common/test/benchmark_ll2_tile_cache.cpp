@@ -0,0 +1,144 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_common/ll2_decomposer/ll2_tile_cache.hpp"
+
+#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
+
+#include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
+
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+// Compare the startup of the whole map decomposition with the tiled decomposition (built from the
+// map, and read from the cache file) on synthetic grid maps of growing size.
+
+using yabloc::ll2_decomposer::Ll2Tile;
+using yabloc::ll2_decomposer::Ll2TileCache;
+
+// Lane lines every 3.5 m along x and y with a vertex every 5 m in a square of the given extent
+lanelet::LaneletMapPtr create_grid_map(double extent)
+{
+  lanelet::LaneletMapPtr map(new lanelet::LaneletMap);
+  for (double u = 0.0; u < extent; u += 3.5) {
+    lanelet::Points3d along_x;
+    lanelet::Points3d along_y;
+    for (double v = 0.0; v < extent; v += 5.0) {
+      along_x.emplace_back(lanelet::utils::getId(), v, u, 0.0);
+      along_y.emplace_back(lanelet::utils::getId(), u, v, 0.0);
+    }
+    for (auto & points : {along_x, along_y}) {
+      lanelet::LineString3d line(lanelet::utils::getId(), points);
+      line.attributes()[lanelet::AttributeName::Type] = "line_thin";
+      map->add(line);
+    }
+  }
+  return map;
+}
+
+size_t count_segments(const lanelet::LaneletMapPtr & map)
+{
+  size_t n = 0;
+  for (const lanelet::ConstLineString3d & line : map->lineStringLayer) {
+    n += line.size() > 0 ? line.size() - 1 : 0;
+  }
+  return n;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+  const std::set<std::string> road_marking_labels = {"line_thin"};
+  const std::string cache_path =
+    (std::filesystem::temp_directory_path() / "benchmark_ll2_tile_cache.bin").string();
+  constexpr float tile_size = 100.f;
+  constexpr float tile_radius = 200.f;
+
+  for (const double extent : {1000.0, 2000.0, 4000.0}) {
+    autoware_map_msgs::msg::LaneletMapBin msg;
+    {
+      const lanelet::LaneletMapPtr map = create_grid_map(extent);
+      lanelet::utils::conversion::toBinMsg(map, &msg);
+    }
+    const uint64_t map_hash = Ll2TileCache::hash(msg.data);
+
+    // Whole map: parse and decompose every segment as the node does without tiling
+    auto start = std::chrono::steady_clock::now();
+    lanelet::LaneletMapPtr map(new lanelet::LaneletMap);
+    lanelet::utils::conversion::fromBinMsg(msg, map);
+    const size_t whole_segments = count_segments(map);
+    Ll2TileCache whole(static_cast<float>(extent) * 2.f, road_marking_labels, {}, {});
+    whole.set_map(map, map_hash);
+    const Ll2Tile whole_tile = whole.gather(whole.keys_around({0.f, 0.f}, 0.f));
+    const double whole_ms = elapsed_ms(start);
+
+    // Tiled from the map: parse and index, then decompose the tiles around the vehicle
+    start = std::chrono::steady_clock::now();
+    lanelet::LaneletMapPtr tiled_map(new lanelet::LaneletMap);
+    lanelet::utils::conversion::fromBinMsg(msg, tiled_map);
+    Ll2TileCache tiled(tile_size, road_marking_labels, {}, {});
+    tiled.set_map(tiled_map, map_hash);
+    const float center = static_cast<float>(extent) * 0.5f;
+    const Eigen::Vector2f position(center, center);
+    const Ll2Tile near_tile = tiled.gather(tiled.keys_around(position, tile_radius));
+    const double tiled_ms = elapsed_ms(start);
+
+    start = std::chrono::steady_clock::now();
+    tiled.save(cache_path);
+    const double save_ms = elapsed_ms(start);
+
+    // Tiled from the cache file: hash the message and read the tiles around the vehicle
+    start = std::chrono::steady_clock::now();
+    Ll2TileCache cached(tile_size, road_marking_labels, {}, {});
+    const bool loaded = cached.load(cache_path, Ll2TileCache::hash(msg.data));
+    const Ll2Tile cached_tile = cached.gather(cached.keys_around(position, tile_radius));
+    const double cached_ms = elapsed_ms(start);
+
+    // Every segment must be gathered exactly once
+    Ll2TileCache all(tile_size, road_marking_labels, {}, {});
+    all.load(cache_path, map_hash);
+    const size_t all_segments =
+      all.gather(all.keys_around(position, static_cast<float>(extent) * 2.f)).road_marking.size();
+
+    const double to_mb = sizeof(pcl::PointNormal) / 1024.0 / 1024.0;
+    std::cout << "map " << extent << " x " << extent << " [m], " << msg.data.size() / 1024 / 1024
+              << " [MB] serialized, " << whole_segments << " segments, "
+              << std::filesystem::file_size(cache_path) / 1024 / 1024 << " [MB] cache file\n"
+              << "  whole map     " << whole_ms << " [ms], "
+              << whole_tile.road_marking.size() * to_mb << " [MB] decomposed\n"
+              << "  tiled (map)   " << tiled_ms << " [ms], "
+              << near_tile.road_marking.size() * to_mb << " [MB] decomposed, save " << save_ms
+              << " [ms]\n"
+              << "  tiled (cache) " << cached_ms << " [ms], "
+              << cached_tile.road_marking.size() * to_mb << " [MB] decomposed, "
+              << (loaded ? "loaded" : "NOT loaded") << "\n"
+              << "  segments in all tiles " << all_segments << " / " << whole_segments
+              << std::endl;
+  }
+
+  std::remove(cache_path.c_str());
+  return 0;
+}
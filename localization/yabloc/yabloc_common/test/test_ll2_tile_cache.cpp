@@ -0,0 +1,319 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_common/ll2_decomposer/ll2_decomposer.hpp"
+#include "yabloc_common/ll2_decomposer/ll2_tile_cache.hpp"
+
+#include <lanelet2_core/utility/Utilities.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using yabloc::ll2_decomposer::Ll2Decomposer;
+using yabloc::ll2_decomposer::Ll2Tile;
+using yabloc::ll2_decomposer::Ll2TileCache;
+
+namespace
+{
+constexpr float tile_size = 10.f;
+const std::set<std::string> road_marking_labels = {"line_thin", "pedestrian_marking"};
+const std::set<std::string> sign_board_labels = {"sign-board"};
+const std::set<std::string> bounding_box_labels = {"bounding_box"};
+
+using Segment = std::array<float, 6>;
+
+// The coordinates are multiples of 0.25 so that the tiles of an element do not depend on the
+// rounding to float. Some line strings, segments and polygons span many tiles.
+lanelet::LaneletMapPtr create_random_map(std::mt19937 & engine)
+{
+  std::uniform_int_distribution<int> position(-400, 400);
+  std::uniform_int_distribution<int> short_step(-12, 12);
+  std::uniform_int_distribution<int> long_step(-200, 200);
+  std::uniform_int_distribution<int> vertex_num(2, 6);
+  std::uniform_int_distribution<int> polygon_size(1, 120);
+  const std::array<std::string, 5> line_types = {
+    "line_thin", "pedestrian_marking", "sign-board", "virtual", "curbstone"};
+  std::uniform_int_distribution<size_t> line_type(0, line_types.size() - 1);
+  auto to_coordinate = [](int v) { return 0.25 * v; };
+
+  lanelet::LaneletMapPtr map(new lanelet::LaneletMap);
+  for (int n = 0; n < 150; ++n) {
+    int x = position(engine);
+    int y = position(engine);
+    const bool long_line = n % 5 == 0;
+    lanelet::Points3d points;
+    const int num = vertex_num(engine);
+    for (int i = 0; i < num; ++i) {
+      points.emplace_back(lanelet::utils::getId(), to_coordinate(x), to_coordinate(y), 1.0);
+      x += long_line ? long_step(engine) : short_step(engine);
+      y += long_line ? long_step(engine) : short_step(engine);
+    }
+    lanelet::LineString3d line(lanelet::utils::getId(), points);
+    line.attributes()[lanelet::AttributeName::Type] = line_types.at(line_type(engine));
+    map->add(line);
+  }
+
+  for (int n = 0; n < 40; ++n) {
+    const int x = position(engine);
+    const int y = position(engine);
+    const int w = polygon_size(engine);
+    const int h = polygon_size(engine);
+    lanelet::Points3d points;
+    points.emplace_back(lanelet::utils::getId(), to_coordinate(x), to_coordinate(y), 0.0);
+    points.emplace_back(lanelet::utils::getId(), to_coordinate(x + w), to_coordinate(y), 0.0);
+    points.emplace_back(lanelet::utils::getId(), to_coordinate(x + w), to_coordinate(y + h), 0.0);
+    points.emplace_back(lanelet::utils::getId(), to_coordinate(x), to_coordinate(y + h), 0.0);
+    lanelet::Polygon3d polygon(lanelet::utils::getId(), points);
+    polygon.attributes()[lanelet::AttributeName::Type] = n % 4 == 0 ? "other" : "bounding_box";
+    map->add(polygon);
+  }
+  return map;
+}
+
+Segment to_segment(const pcl::PointNormal & pn)
+{
+  return {pn.x, pn.y, pn.z, pn.normal_x, pn.normal_y, pn.normal_z};
+}
+
+// The bounding box of the segment or the polygon overlaps the tiles in [min, max)
+bool overlaps(
+  float x_min, float y_min, float x_max, float y_max, const Eigen::Vector2f & min,
+  const Eigen::Vector2f & max)
+{
+  return min.x() <= x_max && x_min < max.x() && min.y() <= y_max && y_min < max.y();
+}
+
+bool overlaps(const Segment & s, const Eigen::Vector2f & min, const Eigen::Vector2f & max)
+{
+  return overlaps(
+    std::min(s[0], s[3]), std::min(s[1], s[4]), std::max(s[0], s[3]), std::max(s[1], s[4]), min,
+    max);
+}
+
+// The segments are identified by their index in the untiled decomposition
+void expect_segments(
+  const pcl::PointCloud<pcl::PointNormal> & gathered, const std::vector<uint32_t> & indices,
+  const pcl::PointCloud<pcl::PointNormal> & untiled, const Eigen::Vector2f & min,
+  const Eigen::Vector2f & max)
+{
+  ASSERT_EQ(gathered.size(), indices.size());
+  std::set<uint32_t> gathered_indices;
+  for (size_t i = 0; i < gathered.size(); ++i) {
+    ASSERT_LT(indices.at(i), untiled.size());
+    EXPECT_EQ(to_segment(gathered.at(i)), to_segment(untiled.at(indices.at(i))));
+    EXPECT_TRUE(gathered_indices.insert(indices.at(i)).second) << "duplicated " << indices.at(i);
+  }
+
+  std::set<uint32_t> expected_indices;
+  for (size_t i = 0; i < untiled.size(); ++i) {
+    if (overlaps(to_segment(untiled.at(i)), min, max)) {
+      expected_indices.insert(static_cast<uint32_t>(i));
+    }
+  }
+  EXPECT_EQ(gathered_indices, expected_indices);
+}
+
+using Polygons = std::map<uint32_t, std::vector<std::array<float, 3>>>;
+
+Polygons to_polygons(const pcl::PointCloud<pcl::PointXYZL> & cloud)
+{
+  Polygons polygons;
+  for (const pcl::PointXYZL & p : cloud) polygons[p.label].push_back({p.x, p.y, p.z});
+  return polygons;
+}
+
+void expect_bounding_boxes(
+  const pcl::PointCloud<pcl::PointXYZL> & gathered, const pcl::PointCloud<pcl::PointXYZL> & untiled,
+  const Eigen::Vector2f & min, const Eigen::Vector2f & max)
+{
+  Polygons expected;
+  for (const auto & [label, vertices] : to_polygons(untiled)) {
+    float x_min = vertices.front()[0];
+    float y_min = vertices.front()[1];
+    float x_max = x_min;
+    float y_max = y_min;
+    for (const auto & v : vertices) {
+      x_min = std::min(x_min, v[0]);
+      y_min = std::min(y_min, v[1]);
+      x_max = std::max(x_max, v[0]);
+      y_max = std::max(y_max, v[1]);
+    }
+    if (overlaps(x_min, y_min, x_max, y_max, min, max)) expected[label] = vertices;
+  }
+  EXPECT_EQ(to_polygons(gathered), expected);
+}
+
+void expect_same_tiles(const Ll2Tile & a, const Ll2Tile & b)
+{
+  ASSERT_EQ(a.road_marking.size(), b.road_marking.size());
+  ASSERT_EQ(a.sign_board.size(), b.sign_board.size());
+  ASSERT_EQ(a.bounding_box.size(), b.bounding_box.size());
+  for (size_t i = 0; i < a.road_marking.size(); ++i) {
+    EXPECT_EQ(to_segment(a.road_marking.at(i)), to_segment(b.road_marking.at(i)));
+  }
+  for (size_t i = 0; i < a.sign_board.size(); ++i) {
+    EXPECT_EQ(to_segment(a.sign_board.at(i)), to_segment(b.sign_board.at(i)));
+  }
+  EXPECT_EQ(a.road_marking_index, b.road_marking_index);
+  EXPECT_EQ(a.sign_board_index, b.sign_board_index);
+  EXPECT_EQ(to_polygons(a.bounding_box), to_polygons(b.bounding_box));
+}
+
+class Ll2TileCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::mt19937 engine(0);
+    map_ = create_random_map(engine);
+    path_ = (std::filesystem::temp_directory_path() /
+             ("test_ll2_tile_cache_" + std::to_string(getpid()) + ".bin"))
+              .string();
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  static Ll2TileCache make_cache()
+  {
+    return Ll2TileCache(tile_size, road_marking_labels, sign_board_labels, bounding_box_labels);
+  }
+
+  lanelet::LaneletMapPtr map_;
+  std::string path_;
+};
+}  // namespace
+
+TEST_F(Ll2TileCacheTest, GatherMatchesUntiledDecomposition)
+{
+  Ll2TileCache cache = make_cache();
+  cache.set_map(map_, 1);
+
+  const pcl::PointCloud<pcl::PointNormal> road_marking = Ll2Decomposer::split_line_strings(
+    Ll2Decomposer::extract_specified_line_string(map_->lineStringLayer, road_marking_labels));
+  const pcl::PointCloud<pcl::PointNormal> sign_board = Ll2Decomposer::split_line_strings(
+    Ll2Decomposer::extract_specified_line_string(map_->lineStringLayer, sign_board_labels));
+  const pcl::PointCloud<pcl::PointXYZL> bounding_box =
+    Ll2Decomposer::load_bounding_boxes(map_->polygonLayer, bounding_box_labels);
+  ASSERT_FALSE(road_marking.empty());
+  ASSERT_FALSE(sign_board.empty());
+  ASSERT_FALSE(bounding_box.empty());
+
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<float> position(-120.f, 120.f);
+  std::uniform_real_distribution<float> radius(0.f, 30.f);
+  for (int trial = 0; trial < 200; ++trial) {
+    const Eigen::Vector2f center(position(engine), position(engine));
+    const float r = radius(engine);
+    // The query covers every tile which intersects the square around the center
+    const Eigen::Vector2f min(
+      std::floor((center.x() - r) / tile_size) * tile_size,
+      std::floor((center.y() - r) / tile_size) * tile_size);
+    const Eigen::Vector2f max(
+      (std::floor((center.x() + r) / tile_size) + 1.f) * tile_size,
+      (std::floor((center.y() + r) / tile_size) + 1.f) * tile_size);
+
+    const Ll2Tile tile = cache.gather(cache.keys_around(center, r));
+    SCOPED_TRACE("center " + std::to_string(center.x()) + ", " + std::to_string(center.y()));
+    expect_segments(tile.road_marking, tile.road_marking_index, road_marking, min, max);
+    expect_segments(tile.sign_board, tile.sign_board_index, sign_board, min, max);
+    expect_bounding_boxes(tile.bounding_box, bounding_box, min, max);
+    if (trial % 10 == 0) cache.erase_except({});
+  }
+
+  // All the tiles hold the whole map once
+  const Ll2Tile all = cache.gather(cache.keys_around({0.f, 0.f}, 1000.f));
+  EXPECT_EQ(all.road_marking.size(), road_marking.size());
+  EXPECT_EQ(all.sign_board.size(), sign_board.size());
+  EXPECT_EQ(all.bounding_box.size(), bounding_box.size());
+}
+
+TEST_F(Ll2TileCacheTest, SaveAndLoad)
+{
+  Ll2TileCache cache = make_cache();
+  cache.set_map(map_, 1);
+  ASSERT_TRUE(cache.save(path_));
+
+  Ll2TileCache loaded = make_cache();
+  ASSERT_TRUE(loaded.load(path_, 1));
+  EXPECT_EQ(loaded.tile_num(), cache.tile_num());
+  EXPECT_EQ(loaded.decomposed_tile_num(), 0U);
+
+  // Tile by tile, and gathered around the positions
+  for (const Ll2TileCache::TileKey key : cache.keys_around({0.f, 0.f}, 1000.f)) {
+    expect_same_tiles(loaded.gather({key}), cache.gather({key}));
+  }
+  for (const Eigen::Vector2f & center : {Eigen::Vector2f(0.f, 0.f), Eigen::Vector2f(55.f, -35.f)}) {
+    const std::vector<Ll2TileCache::TileKey> keys = cache.keys_around(center, 25.f);
+    ASSERT_EQ(loaded.keys_around(center, 25.f), keys);
+    expect_same_tiles(loaded.gather(keys), cache.gather(keys));
+  }
+
+  // A cache made from a file can not be saved again
+  EXPECT_FALSE(loaded.save(path_));
+}
+
+TEST_F(Ll2TileCacheTest, LoadRejectsStaleFile)
+{
+  Ll2TileCache missing = make_cache();
+  EXPECT_FALSE(missing.load(path_, 1));
+
+  Ll2TileCache cache = make_cache();
+  cache.set_map(map_, 1);
+  ASSERT_TRUE(cache.save(path_));
+
+  // The map changed
+  Ll2TileCache other_map = make_cache();
+  EXPECT_FALSE(other_map.load(path_, 2));
+  EXPECT_EQ(other_map.tile_num(), 0U);
+
+  // The labels changed
+  Ll2TileCache other_road_marking(tile_size, {"line_thin"}, sign_board_labels, bounding_box_labels);
+  EXPECT_FALSE(other_road_marking.load(path_, 1));
+  Ll2TileCache other_sign_board(
+    tile_size, road_marking_labels, {"sign-board", "virtual"}, bounding_box_labels);
+  EXPECT_FALSE(other_sign_board.load(path_, 1));
+  Ll2TileCache other_bounding_box(tile_size, road_marking_labels, sign_board_labels, {});
+  EXPECT_FALSE(other_bounding_box.load(path_, 1));
+  // A label moved from a kind of element to another
+  Ll2TileCache moved_label(
+    tile_size, {"line_thin"}, {"pedestrian_marking", "sign-board"}, bounding_box_labels);
+  EXPECT_FALSE(moved_label.load(path_, 1));
+
+  // The tile size changed
+  Ll2TileCache other_tile_size(
+    tile_size * 2.f, road_marking_labels, sign_board_labels, bounding_box_labels);
+  EXPECT_FALSE(other_tile_size.load(path_, 1));
+
+  // A rejected file does not discard the tiles which were already there
+  Ll2TileCache reused = make_cache();
+  reused.set_map(map_, 1);
+  const size_t tile_num = reused.tile_num();
+  EXPECT_FALSE(reused.load(path_, 2));
+  EXPECT_EQ(reused.tile_num(), tile_num);
+
+  Ll2TileCache same = make_cache();
+  EXPECT_TRUE(same.load(path_, 1));
+  EXPECT_EQ(same.tile_num(), cache.tile_num());
+}
@@ -29,9 +29,17 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace yabloc
@@ -95,6 +103,15 @@ struct CostMapValue
   bool unmapped;    // true/false
 };
 
+struct CostMapStatistics
+{
+  size_t sync_builds{0};     // tiles built inline in at(), i.e. stalls of the caller
+  size_t async_builds{0};    // tiles built by the background builder
+  size_t stalls_avoided{0};  // tiles first touched by at() after being prefetched
+  size_t discarded{0};       // prefetched tiles dropped because the input changed
+  size_t evicted{0};         // tiles evicted as least recently used
+};
+
 class HierarchicalCostMap
 {
 public:
@@ -106,6 +123,10 @@ public:
   using BgPolygon = boost::geometry::model::polygon<BgPoint>;
 
   explicit HierarchicalCostMap(rclcpp::Node * node);
+  ~HierarchicalCostMap();
+
+  HierarchicalCostMap(const HierarchicalCostMap &) = delete;
+  HierarchicalCostMap & operator=(const HierarchicalCostMap &) = delete;
 
   void set_cloud(const pcl::PointCloud<pcl::PointNormal> & cloud);
   void set_bounding_box(const pcl::PointCloud<pcl::PointXYZL> & cloud);
@@ -126,26 +147,80 @@ public:
 
   void set_height(float height);
 
+  /**
+   * Request the background builder to generate the areas around the position and ahead of it
+   *
+   * Completed tiles are swapped in at the next call of at() or prefetch(), so the caller is not
+   * blocked by build_map() when the vehicle crosses the area boundary.
+   *
+   * @param[in] position Real scale position at world frame
+   * @param[in] heading Unit vector of the vehicle heading at world frame
+   */
+  void prefetch(const Eigen::Vector2f & position, const Eigen::Vector2f & heading);
+
+  CostMapStatistics statistics() const { return statistics_; }
+
 private:
+  using Cloud = pcl::PointCloud<pcl::PointNormal>;
+
+  struct CostMapTile
+  {
+    cv::Mat image;
+    uint64_t last_access{0};
+    bool prefetched{false};
+  };
+
+  // NOTE: A snapshot of the inputs so that the builder never reads members touched by the caller
+  struct BuildRequest
+  {
+    Area area;
+    uint64_t generation{0};
+    std::shared_ptr<const Cloud> cloud;
+    std::shared_ptr<const std::vector<BgPolygon>> bounding_boxes;
+    std::optional<float> height;
+  };
+
   const float max_range_;
   const float image_size_;
   const size_t max_map_count_;
+  const bool async_build_;
+  const int prefetch_count_;
   rclcpp::Logger logger_;
   std::optional<float> height_{std::nullopt};
 
   common::GammaConverter gamma_converter_{4.0f};
 
-  std::unordered_map<Area, bool, Area> map_accessed_;
+  uint64_t access_count_{0};
+  CostMapStatistics statistics_;
 
   std::list<Area> generated_map_history_;
-  std::optional<pcl::PointCloud<pcl::PointNormal>> cloud_;
-  std::vector<BgPolygon> bounding_boxes_;
-  std::unordered_map<Area, cv::Mat, Area> cost_maps_;
+  std::shared_ptr<const Cloud> cloud_{nullptr};
+  std::shared_ptr<const std::vector<BgPolygon>> bounding_boxes_{
+    std::make_shared<std::vector<BgPolygon>>()};
+  std::unordered_map<Area, CostMapTile, Area> cost_maps_;
+
+  // Background builder. Everything below is guarded by builder_mutex_
+  std::thread builder_thread_;
+  mutable std::mutex builder_mutex_;
+  std::condition_variable builder_condition_;
+  bool builder_stopped_{false};
+  uint64_t generation_{0};
+  std::deque<BuildRequest> request_queue_;
+  std::unordered_set<Area, Area> requested_areas_;
+  std::vector<std::pair<Area, cv::Mat>> built_tiles_;
+  size_t discarded_count_{0};
 
   cv::Point to_cv_point(const Area & area, const Eigen::Vector2f & p) const;
-  void build_map(const Area & area);
+  BuildRequest make_request(const Area & area) const;
+  cv::Mat build_map(const BuildRequest & request) const;
+  void insert_tile(const Area & area, cv::Mat image, bool prefetched);
+
+  void run_builder();
+  void invalidate_requests();
+  void adopt_built_tiles();
 
-  cv::Mat create_available_area_image(const Area & area) const;
+  cv::Mat create_available_area_image(
+    const Area & area, const std::vector<BgPolygon> & bounding_boxes) const;
 };
 }  // namespace yabloc
 
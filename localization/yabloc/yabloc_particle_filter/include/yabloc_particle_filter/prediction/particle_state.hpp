@@ -0,0 +1,91 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef YABLOC_PARTICLE_FILTER__PREDICTION__PARTICLE_STATE_HPP_
+#define YABLOC_PARTICLE_FILTER__PREDICTION__PARTICLE_STATE_HPP_
+
+#include <Eigen/Core>
+#include <yabloc_particle_filter/msg/particle_array.hpp>
+
+#include <geometry_msgs/msg/pose.hpp>
+#include <std_msgs/msg/header.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace yabloc::modularized_particle_filter
+{
+/**
+ * Structure-of-arrays representation of the planar particles handled by the predictor
+ *
+ * Particles of yabloc only have x, y, yaw degrees of freedom (z is overwritten by the ground
+ * height), so keeping them as plain arrays lets the motion update and the resampling run over
+ * contiguous memory instead of geometry_msgs poses. The message is built only at publish time.
+ */
+struct ParticleState
+{
+  using ParticleArray = yabloc_particle_filter::msg::ParticleArray;
+
+  std_msgs::msg::Header header;
+  int32_t id{0};
+
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<float> yaw;
+  std::vector<float> weight;
+
+  [[nodiscard]] size_t size() const { return x.size(); }
+  void resize(size_t size);
+
+  static ParticleState from_msg(const ParticleArray & particle_array);
+  // NOTE: particle_array is reused to avoid reallocation of the particles on every publish
+  void to_msg(ParticleArray & particle_array) const;
+};
+
+/**
+ * Batched gaussian noise generator
+ *
+ * Uniform samples come from a counter based hash so that each lane is independent, and they are
+ * converted by Box-Muller which yields two samples per logarithm.
+ */
+class NormalNoiseGenerator
+{
+public:
+  explicit NormalNoiseGenerator(uint64_t seed);
+
+  // Fill `size` samples of N(0, 1) into output
+  void fill(float * output, size_t size);
+
+private:
+  uint64_t counter_;
+  std::vector<float> u1_;
+  std::vector<float> u2_;
+};
+
+/**
+ * Apply constant twist motion with gaussian noise on the velocities to all particles
+ *
+ * This is equivalent to `pose *= SE3::exp(xi * dt)` with xi = (linear_x + noise, 0, 0, 0, 0,
+ * angular_z + noise) for planar poses.
+ */
+void predict_particles(
+  ParticleState & state, float linear_x, float angular_z, float linear_std, float angular_std,
+  float dt, float height, NormalNoiseGenerator & generator);
+
+geometry_msgs::msg::Pose get_mean_pose(const ParticleState & state);
+
+}  // namespace yabloc::modularized_particle_filter
+
+#endif  // YABLOC_PARTICLE_FILTER__PREDICTION__PARTICLE_STATE_HPP_
@@ -16,6 +16,7 @@
 #define YABLOC_PARTICLE_FILTER__PREDICTION__PREDICTOR_HPP_
 
 #include "yabloc_particle_filter/common/visualize.hpp"
+#include "yabloc_particle_filter/prediction/particle_state.hpp"
 #include "yabloc_particle_filter/prediction/resampler.hpp"
 
 #include <Eigen/Geometry>
@@ -86,7 +87,10 @@ private:
   bool yabloc_activated_{true};
   PoseCovStamped::ConstSharedPtr latest_ekf_pose_ptr_{nullptr};
 
-  std::optional<ParticleArray> particle_array_opt_{std::nullopt};
+  // NOTE: Particles are kept as arrays and converted into the message only when published
+  std::optional<ParticleState> particle_state_opt_{std::nullopt};
+  ParticleArray particle_array_msg_;
+  NormalNoiseGenerator noise_generator_;
   std::optional<TwistCovStamped> latest_twist_opt_{std::nullopt};
   std::optional<double> previous_resampling_time_opt_{std::nullopt};
 
@@ -106,7 +110,7 @@ private:
   void initialize_particles(const PoseCovStamped & initialpose);
   //
   void update_with_dynamic_noise(
-    ParticleArray & particle_array, const TwistCovStamped & twist, double dt) const;
+    ParticleState & particles, const TwistCovStamped & twist, double dt);
   //
   void publish_mean_pose(const geometry_msgs::msg::Pose & mean_pose, const rclcpp::Time & stamp);
   void publish_range_marker(const Eigen::Vector3f & pos, const Eigen::Vector3f & tangent);
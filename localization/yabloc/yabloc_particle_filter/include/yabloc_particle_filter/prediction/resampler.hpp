@@ -16,10 +16,13 @@
 #define YABLOC_PARTICLE_FILTER__PREDICTION__RESAMPLER_HPP_
 
 #include "yabloc_particle_filter/msg/particle_array.hpp"
+#include "yabloc_particle_filter/prediction/particle_state.hpp"
 #include "yabloc_particle_filter/prediction/resampling_history.hpp"
 
 #include <rclcpp/logger.hpp>
 
+#include <vector>
+
 namespace yabloc::modularized_particle_filter
 {
 class ResamplingSkipException : public std::runtime_error
@@ -41,6 +44,12 @@ public:
 
   ParticleArray resample(const ParticleArray & predicted_particles);
 
+  // Same as above but in place on the structure-of-arrays particles
+  void add_weight_retroactively(
+    ParticleState & predicted_particles, const ParticleArray & weighted_particles);
+
+  void resample(ParticleState & predicted_particles);
+
 private:
   // Number of updates to keep resampling history.
   // Resampling records prior to this will not be kept.
@@ -55,11 +64,19 @@ private:
   // Indicates how many times the particles were resampled.
   int latest_resampling_generation_;
 
+  // Buffer to gather resampled particles without reallocation
+  ParticleState resampled_state_;
+
   // Random generator from 0 to 1
   [[nodiscard]] static double random_from_01_uniformly();
   // Check the sanity of the particles obtained from the particle corrector.
   [[nodiscard]] bool check_weighted_particles_validity(
     const ParticleArray & weighted_particles) const;
+  // The m-th element is the index of the current particle which the m-th weighted particle became
+  [[nodiscard]] std::vector<int> make_index_table(const ParticleArray & weighted_particles) const;
+  // Draw the indices of the successors and record them as a new generation of the history
+  template <typename WeightAt>
+  const std::vector<int> & draw_successors(WeightAt weight_at);
 };
 }  // namespace yabloc::modularized_particle_filter
 
@@ -169,6 +169,12 @@ void CameraParticleCorrector::on_line_segments(const PointCloud2 & line_segments
   }
 
   cost_map_.set_height(static_cast<float>(mean_pose.position.z));
+  {
+    // Let the background builder generate the areas which the vehicle is heading to
+    const Eigen::Affine3f mean_affine = common::pose_to_affine(mean_pose);
+    const Eigen::Vector2f heading = mean_affine.rotation().col(0).topRows(2).normalized();
+    cost_map_.prefetch(mean_affine.translation().topRows(2), heading);
+  }
 
   if (publish_weighted_particles) {
     for (auto & particle : weighted_particles.particles) {
@@ -238,6 +244,10 @@ void CameraParticleCorrector::on_line_segments(const PointCloud2 & line_segments
     ss << "-- Camera particle corrector --" << std::endl;
     ss << (enable_switch_ ? "ENABLED" : "disabled") << std::endl;
     ss << "time: " << stop_watch.toc() << std::endl;
+    const CostMapStatistics statistics = cost_map_.statistics();
+    ss << "cost map sync builds: " << statistics.sync_builds << std::endl;
+    ss << "cost map async builds: " << statistics.async_builds << std::endl;
+    ss << "cost map stalls avoided: " << statistics.stalls_avoided << std::endl;
     msg.data = ss.str();
     pub_string_->publish(msg);
   }
@@ -22,6 +22,8 @@
 
 #include <boost/geometry/geometry.hpp>
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace yabloc
@@ -32,11 +34,27 @@ HierarchicalCostMap::HierarchicalCostMap(rclcpp::Node * node)
 : max_range_(static_cast<float>(node->declare_parameter<float>("max_range"))),
   image_size_(static_cast<float>(node->declare_parameter<int>("image_size"))),
   max_map_count_(10),
+  async_build_(node->declare_parameter<bool>("async_build")),
+  prefetch_count_(static_cast<int>(node->declare_parameter<int>("prefetch_count"))),
   logger_(node->get_logger())
 {
   Area::unit_length = max_range_;
   float gamma = static_cast<float>(node->declare_parameter<float>("gamma"));
   gamma_converter_.reset(gamma);
+
+  if (async_build_) {
+    builder_thread_ = std::thread(&HierarchicalCostMap::run_builder, this);
+  }
+}
+
+HierarchicalCostMap::~HierarchicalCostMap()
+{
+  {
+    std::lock_guard<std::mutex> lock(builder_mutex_);
+    builder_stopped_ = true;
+  }
+  builder_condition_.notify_all();
+  if (builder_thread_.joinable()) builder_thread_.join();
 }
 
 cv::Point2i HierarchicalCostMap::to_cv_point(const Area & area, const Eigen::Vector2f & p) const
@@ -49,18 +67,32 @@ cv::Point2i HierarchicalCostMap::to_cv_point(const Area & area, const Eigen::Vec
 
 CostMapValue HierarchicalCostMap::at(const Eigen::Vector2f & position)
 {
-  if (!cloud_.has_value()) {
+  if (!cloud_) {
     return CostMapValue{0.5f, 0, true};
   }
 
   Area key(position);
-  if (cost_maps_.count(key) == 0) {
-    build_map(key);
+  auto itr = cost_maps_.find(key);
+  if (itr == cost_maps_.end()) {
+    // NOTE: The background builder may have just finished it
+    if (async_build_) adopt_built_tiles();
+    itr = cost_maps_.find(key);
+  }
+  if (itr == cost_maps_.end()) {
+    insert_tile(key, build_map(make_request(key)), false);
+    statistics_.sync_builds++;
+    itr = cost_maps_.find(key);
+  }
+
+  CostMapTile & tile = itr->second;
+  tile.last_access = access_count_;
+  if (tile.prefetched) {
+    tile.prefetched = false;
+    statistics_.stalls_avoided++;
   }
-  map_accessed_[key] = true;
 
   cv::Point2i tmp = to_cv_point(key, position);
-  cv::Vec3b b3 = cost_maps_.at(key).ptr<cv::Vec3b>(tmp.y)[tmp.x];
+  cv::Vec3b b3 = tile.image.ptr<cv::Vec3b>(tmp.y)[tmp.x];
   return {static_cast<float>(b3[0]) / 255.f, b3[1], b3[2] == 1};
 }
 
@@ -70,7 +102,7 @@ void HierarchicalCostMap::set_height(float height)
     if (std::abs(*height_ - height) > 2) {
       generated_map_history_.clear();
       cost_maps_.clear();
-      map_accessed_.clear();
+      invalidate_requests();
     }
   }
 
@@ -80,30 +112,138 @@ void HierarchicalCostMap::set_height(float height)
 void HierarchicalCostMap::set_bounding_box(const pcl::PointCloud<pcl::PointXYZL> & cloud)
 {
   if (cloud.empty()) return;
+  auto bounding_boxes = std::make_shared<std::vector<BgPolygon>>(*bounding_boxes_);
   BgPolygon poly;
 
   std::optional<uint32_t> last_label = std::nullopt;
   for (const pcl::PointXYZL p : cloud) {
     if (last_label) {
       if ((*last_label) != p.label) {
-        bounding_boxes_.push_back(poly);
+        bounding_boxes->push_back(poly);
         poly.outer().clear();
       }
     }
     poly.outer().push_back(BgPoint(p.x, p.y));
     last_label = p.label;
   }
-  bounding_boxes_.push_back(poly);
+  bounding_boxes->push_back(poly);
+  bounding_boxes_ = std::move(bounding_boxes);
+  invalidate_requests();
 }
 
 void HierarchicalCostMap::set_cloud(const pcl::PointCloud<pcl::PointNormal> & cloud)
 {
-  cloud_ = cloud;
+  cloud_ = std::make_shared<const Cloud>(cloud);
+  invalidate_requests();
+}
+
+void HierarchicalCostMap::prefetch(
+  const Eigen::Vector2f & position, const Eigen::Vector2f & heading)
+{
+  if (!async_build_ || !cloud_) return;
+
+  adopt_built_tiles();
+
+  // Walk along the heading by a half area so that no area on the predicted path is skipped, and
+  // request the lateral neighbours as well because particles and line segments spread sideways.
+  const float step = Area::unit_length * 0.5f;
+  const Eigen::Vector2f lateral(-heading.y(), heading.x());
+  std::vector<Area> candidates;
+  for (int i = 0; i <= 2 * prefetch_count_; ++i) {
+    const Eigen::Vector2f center = position + heading * (step * static_cast<float>(i));
+    candidates.emplace_back(center);
+    candidates.emplace_back(Eigen::Vector2f(center + lateral * step));
+    candidates.emplace_back(Eigen::Vector2f(center - lateral * step));
+  }
+
+  size_t requested = 0;
+  {
+    std::lock_guard<std::mutex> lock(builder_mutex_);
+    for (const Area & area : candidates) {
+      if (cost_maps_.count(area) != 0) continue;
+      if (requested_areas_.count(area) != 0) continue;
+      requested_areas_.insert(area);
+      request_queue_.push_back(make_request(area));
+      requested++;
+    }
+  }
+  if (requested > 0) builder_condition_.notify_one();
+}
+
+HierarchicalCostMap::BuildRequest HierarchicalCostMap::make_request(const Area & area) const
+{
+  BuildRequest request;
+  request.area = area;
+  request.generation = generation_;
+  request.cloud = cloud_;
+  request.bounding_boxes = bounding_boxes_;
+  request.height = height_;
+  return request;
+}
+
+void HierarchicalCostMap::insert_tile(const Area & area, cv::Mat image, bool prefetched)
+{
+  CostMapTile & tile = cost_maps_[area];
+  tile.image = std::move(image);
+  tile.last_access = access_count_;
+  tile.prefetched = prefetched;
+  generated_map_history_.push_back(area);
+}
+
+void HierarchicalCostMap::run_builder()
+{
+  while (true) {
+    BuildRequest request;
+    {
+      std::unique_lock<std::mutex> lock(builder_mutex_);
+      builder_condition_.wait(lock, [this] { return builder_stopped_ || !request_queue_.empty(); });
+      if (builder_stopped_) return;
+      request = std::move(request_queue_.front());
+      request_queue_.pop_front();
+    }
+
+    cv::Mat image = build_map(request);
+
+    std::lock_guard<std::mutex> lock(builder_mutex_);
+    requested_areas_.erase(request.area);
+    if (request.generation != generation_) {
+      discarded_count_++;
+      continue;
+    }
+    built_tiles_.emplace_back(request.area, std::move(image));
+  }
+}
+
+void HierarchicalCostMap::invalidate_requests()
+{
+  std::lock_guard<std::mutex> lock(builder_mutex_);
+  generation_++;
+  discarded_count_ += request_queue_.size() + built_tiles_.size();
+  request_queue_.clear();
+  requested_areas_.clear();
+  built_tiles_.clear();
+}
+
+void HierarchicalCostMap::adopt_built_tiles()
+{
+  std::vector<std::pair<Area, cv::Mat>> built_tiles;
+  {
+    std::lock_guard<std::mutex> lock(builder_mutex_);
+    built_tiles.swap(built_tiles_);
+    statistics_.discarded = discarded_count_;
+  }
+
+  for (auto & [area, image] : built_tiles) {
+    // NOTE: at() may have built the same area synchronously in the meantime
+    if (cost_maps_.count(area) != 0) continue;
+    insert_tile(area, std::move(image), true);
+    statistics_.async_builds++;
+  }
 }
 
-void HierarchicalCostMap::build_map(const Area & area)
+cv::Mat HierarchicalCostMap::build_map(const BuildRequest & request) const
 {
-  if (!cloud_.has_value()) return;
+  const Area & area = request.area;
 
   cv::Mat image =
     255 *
@@ -116,10 +256,10 @@ void HierarchicalCostMap::build_map(const Area & area)
   };
 
   // TODO(KYabuuchi) We can speed up by skipping too far line_segments
-  for (const auto pn : cloud_.value()) {
-    if (height_) {
-      if (std::abs(pn.z - *height_) > 4) continue;
-      if (std::abs(pn.normal_z - *height_) > 4) continue;
+  for (const auto pn : *request.cloud) {
+    if (request.height) {
+      if (std::abs(pn.z - *request.height) > 4) continue;
+      if (std::abs(pn.normal_z - *request.height) > 4) continue;
     }
 
     cv::Point2i from = cv_point(pn.getVector3fMap());
@@ -143,18 +283,16 @@ void HierarchicalCostMap::build_map(const Area & area)
   cv::Mat whole_orientation = direct_cost_map(orientation, image);
 
   // channel-3
-  cv::Mat available_area = create_available_area_image(area);
+  cv::Mat available_area = create_available_area_image(area, *request.bounding_boxes);
 
   cv::Mat directed_cost_map;
   cv::merge(
     std::vector<cv::Mat>{gamma_converter_(distance), whole_orientation, available_area},
     directed_cost_map);
 
-  cost_maps_[area] = directed_cost_map;
-  generated_map_history_.push_back(area);
-
   RCLCPP_INFO_STREAM(
     logger_, "succeeded to build map " << area(area) << " " << area.real_scale().transpose());
+  return directed_cost_map;
 }
 
 HierarchicalCostMap::MarkerArray HierarchicalCostMap::show_map_range() const
@@ -231,25 +369,33 @@ cv::Mat HierarchicalCostMap::get_map_image(const Pose & pose)
 
 void HierarchicalCostMap::erase_obsolete()
 {
-  if (cost_maps_.size() < max_map_count_) return;
-
-  for (auto itr = generated_map_history_.begin(); itr != generated_map_history_.end();) {
-    if (map_accessed_[*itr]) {
-      ++itr;
-      continue;
-    }
-    cost_maps_.erase(*itr);
-    itr = generated_map_history_.erase(itr);
+  // NOTE: Tiles touched since the last call are never evicted
+  const uint64_t current_access_count = access_count_++;
+  if (cost_maps_.size() <= max_map_count_) return;
+
+  // Evict the least recently used tiles
+  std::vector<std::pair<uint64_t, Area>> candidates;
+  for (const auto & [area, tile] : cost_maps_) {
+    if (tile.last_access < current_access_count) candidates.emplace_back(tile.last_access, area);
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const auto & a, const auto & b) {
+    return a.first < b.first;
+  });
+
+  for (const auto & candidate : candidates) {
+    if (cost_maps_.size() <= max_map_count_) break;
+    cost_maps_.erase(candidate.second);
+    generated_map_history_.remove(candidate.second);
+    statistics_.evicted++;
   }
-
-  map_accessed_.clear();
 }
 
-cv::Mat HierarchicalCostMap::create_available_area_image(const Area & area) const
+cv::Mat HierarchicalCostMap::create_available_area_image(
+  const Area & area, const std::vector<BgPolygon> & bounding_boxes) const
 {
   cv::Mat available_area =
     cv::Mat::zeros(cv::Size(static_cast<int>(image_size_), static_cast<int>(image_size_)), CV_8UC1);
-  if (bounding_boxes_.empty()) return available_area;
+  if (bounding_boxes.empty()) return available_area;
 
   // Define current area
   using BgBox = boost::geometry::model::box<BgPoint>;
@@ -261,7 +407,7 @@ cv::Mat HierarchicalCostMap::create_available_area_image(const Area & area) cons
 
   std::vector<std::vector<cv::Point2i>> contours;
 
-  for (const BgPolygon & box : bounding_boxes_) {
+  for (const BgPolygon & box : bounding_boxes) {
     if (boost::geometry::disjoint(area_polygon, box)) {
       continue;
     }
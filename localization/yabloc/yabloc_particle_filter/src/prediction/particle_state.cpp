@@ -0,0 +1,231 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/prediction/particle_state.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace yabloc::modularized_particle_filter
+{
+namespace
+{
+constexpr float two_pi = static_cast<float>(2.0 * M_PI);
+
+uint64_t split_mix_64(uint64_t x)
+{
+  uint64_t z = x + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Branchless sine and cosine so that the loops below can be vectorized by the compiler.
+// The polynomials are the ones of cephes sinf/cosf and the error is below 1e-6 in [-pi, pi].
+inline void sin_cos(float angle, float & sin_out, float & cos_out)
+{
+  constexpr float two_over_pi = static_cast<float>(2.0 / M_PI);
+  constexpr float dp1 = 1.5703125f;
+  constexpr float dp2 = 4.837512969970703125e-4f;
+  constexpr float dp3 = 7.54978995489188216e-8f;
+
+  const float quadrant_f = std::floor(angle * two_over_pi + 0.5f);
+  const auto quadrant = static_cast<int32_t>(quadrant_f);
+  const float r = ((angle - quadrant_f * dp1) - quadrant_f * dp2) - quadrant_f * dp3;
+  const float r2 = r * r;
+
+  constexpr float s1 = -1.6666654611e-1f;
+  constexpr float s2 = 8.3321608736e-3f;
+  constexpr float s3 = -1.9515295891e-4f;
+  constexpr float c1 = 4.166664568298827e-2f;
+  constexpr float c2 = -1.388731625493765e-3f;
+  constexpr float c3 = 2.443315711809948e-5f;
+  const float s = ((s3 * r2 + s2) * r2 + s1) * r2 * r + r;
+  const float c = ((c3 * r2 + c2) * r2 + c1) * r2 * r2 - 0.5f * r2 + 1.f;
+
+  const bool swap = (quadrant & 1) != 0;
+  const float sin_abs = swap ? c : s;
+  const float cos_abs = swap ? s : c;
+  sin_out = (quadrant & 2) != 0 ? -sin_abs : sin_abs;
+  cos_out = ((quadrant + 1) & 2) != 0 ? -cos_abs : cos_abs;
+}
+}  // namespace
+
+void ParticleState::resize(size_t size)
+{
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+  yaw.resize(size);
+  weight.resize(size);
+}
+
+ParticleState ParticleState::from_msg(const ParticleArray & particle_array)
+{
+  ParticleState state;
+  state.header = particle_array.header;
+  state.id = particle_array.id;
+  state.resize(particle_array.particles.size());
+
+  for (size_t i = 0; i < particle_array.particles.size(); ++i) {
+    const auto & particle = particle_array.particles[i];
+    const auto & q = particle.pose.orientation;
+    state.x[i] = static_cast<float>(particle.pose.position.x);
+    state.y[i] = static_cast<float>(particle.pose.position.y);
+    state.z[i] = static_cast<float>(particle.pose.position.z);
+    state.yaw[i] = static_cast<float>(
+      std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z)));
+    state.weight[i] = particle.weight;
+  }
+  return state;
+}
+
+void ParticleState::to_msg(ParticleArray & particle_array) const
+{
+  particle_array.header = header;
+  particle_array.id = id;
+  particle_array.particles.resize(size());
+
+  for (size_t i = 0; i < size(); ++i) {
+    auto & particle = particle_array.particles[i];
+    float half_sin = 0.f;
+    float half_cos = 0.f;
+    sin_cos(yaw[i] * 0.5f, half_sin, half_cos);
+    particle.pose.position.x = x[i];
+    particle.pose.position.y = y[i];
+    particle.pose.position.z = z[i];
+    particle.pose.orientation.w = half_cos;
+    particle.pose.orientation.x = 0.0;
+    particle.pose.orientation.y = 0.0;
+    particle.pose.orientation.z = half_sin;
+    particle.weight = weight[i];
+  }
+}
+
+NormalNoiseGenerator::NormalNoiseGenerator(uint64_t seed) : counter_(split_mix_64(seed))
+{
+}
+
+void NormalNoiseGenerator::fill(float * output, size_t size)
+{
+  const size_t pairs = (size + 1) / 2;
+  u1_.resize(pairs);
+  u2_.resize(pairs);
+
+  // Two 24-bit uniform samples from each hash. u1 is in (0, 1] to keep log() finite
+  constexpr float scale = 1.f / static_cast<float>(1 << 24);
+  for (size_t i = 0; i < pairs; ++i) {
+    const uint64_t h = split_mix_64(counter_ + i);
+    u1_[i] = static_cast<float>((h >> 40) + 1) * scale;
+    u2_[i] = static_cast<float>(h & 0xffffff) * scale;
+  }
+  counter_ += pairs;
+
+  for (size_t i = 0; i < pairs; ++i) {
+    u1_[i] = std::sqrt(-2.f * std::log(u1_[i]));
+  }
+
+  const size_t full_pairs = size / 2;
+  for (size_t i = 0; i < full_pairs; ++i) {
+    float s = 0.f;
+    float c = 0.f;
+    sin_cos(two_pi * u2_[i] - static_cast<float>(M_PI), s, c);
+    output[2 * i] = u1_[i] * c;
+    output[2 * i + 1] = u1_[i] * s;
+  }
+  if (full_pairs < pairs) {
+    float s = 0.f;
+    float c = 0.f;
+    sin_cos(two_pi * u2_[full_pairs] - static_cast<float>(M_PI), s, c);
+    output[2 * full_pairs] = u1_[full_pairs] * c;
+  }
+}
+
+void predict_particles(
+  ParticleState & state, float linear_x, float angular_z, float linear_std, float angular_std,
+  float dt, float height, NormalNoiseGenerator & generator)
+{
+  const size_t n = state.size();
+  thread_local std::vector<float> noise;
+  noise.resize(2 * n);
+  generator.fill(noise.data(), 2 * n);
+  const float * linear_noise = noise.data();
+  const float * angular_noise = noise.data() + n;
+
+  float * x = state.x.data();
+  float * y = state.y.data();
+  float * z = state.z.data();
+  float * yaw = state.yaw.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    const float distance = (linear_x + linear_std * linear_noise[i]) * dt;
+    const float theta = (angular_z + angular_std * angular_noise[i]) * dt;
+
+    // Translation of SE3::exp in the body frame: distance * (sin(theta), 1 - cos(theta)) / theta
+    float sin_theta = 0.f;
+    float cos_theta = 0.f;
+    sin_cos(theta, sin_theta, cos_theta);
+    const bool small = std::abs(theta) < 1e-3f;
+    const float theta2 = theta * theta;
+    const float safe_theta = small ? 1.f : theta;
+    const float a = small ? 1.f - theta2 / 6.f : sin_theta / safe_theta;
+    const float b = small ? theta * 0.5f - theta * theta2 / 24.f : (1.f - cos_theta) / safe_theta;
+    const float dx = distance * a;
+    const float dy = distance * b;
+
+    float sin_yaw = 0.f;
+    float cos_yaw = 0.f;
+    sin_cos(yaw[i], sin_yaw, cos_yaw);
+    x[i] += cos_yaw * dx - sin_yaw * dy;
+    y[i] += sin_yaw * dx + cos_yaw * dy;
+    z[i] = height;
+
+    // Keep yaw in [-pi, pi) so that the float precision does not decay
+    const float new_yaw = yaw[i] + theta;
+    yaw[i] = new_yaw - two_pi * std::floor(new_yaw / two_pi + 0.5f);
+  }
+}
+
+geometry_msgs::msg::Pose get_mean_pose(const ParticleState & state)
+{
+  double sum_weight = 0;
+  double sum_x = 0;
+  double sum_y = 0;
+  double sum_z = 0;
+  double sum_sin = 0;
+  double sum_cos = 0;
+  for (size_t i = 0; i < state.size(); ++i) {
+    const double w = state.weight[i];
+    float s = 0.f;
+    float c = 0.f;
+    sin_cos(state.yaw[i], s, c);
+    sum_weight += w;
+    sum_x += w * state.x[i];
+    sum_y += w * state.y[i];
+    sum_z += w * state.z[i];
+    sum_sin += w * s;
+    sum_cos += w * c;
+  }
+
+  geometry_msgs::msg::Pose mean_pose;
+  mean_pose.position.x = sum_x / sum_weight;
+  mean_pose.position.y = sum_y / sum_weight;
+  mean_pose.position.z = sum_z / sum_weight;
+  const double mean_yaw = std::atan2(sum_sin, sum_cos);
+  mean_pose.orientation.w = std::cos(mean_yaw / 2.0);
+  mean_pose.orientation.z = std::sin(mean_yaw / 2.0);
+  return mean_pose;
+}
+
+}  // namespace yabloc::modularized_particle_filter
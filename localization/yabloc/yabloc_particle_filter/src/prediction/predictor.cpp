@@ -19,6 +19,7 @@
 #include "yabloc_particle_filter/prediction/resampler.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/SVD>
 #include <sophus/geometry.hpp>
 #include <yabloc_common/pose_conversions.hpp>
 
@@ -29,6 +30,7 @@
 #include <memory>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 namespace yabloc::modularized_particle_filter
 {
@@ -42,7 +44,8 @@ Predictor::Predictor(const rclcpp::NodeOptions & options)
     static_cast<float>(declare_parameter<float>("static_linear_covariance"))),
   static_angular_covariance_(
     static_cast<float>(declare_parameter<float>("static_angular_covariance"))),
-  cov_xx_yy_{this->template declare_parameter<std::vector<double>>("cov_xx_yy")}
+  cov_xx_yy_{this->template declare_parameter<std::vector<double>>("cov_xx_yy")},
+  noise_generator_(util::seed_gen())
 {
   tf2_broadcaster_ = std::make_unique<tf2_ros::TransformBroadcaster>(*this);
 
@@ -138,10 +141,10 @@ void Predictor::on_initial_pose(const PoseCovStamped::ConstSharedPtr initialpose
 void Predictor::initialize_particles(const PoseCovStamped & initialpose)
 {
   RCLCPP_INFO_STREAM(this->get_logger(), "initialize_particles");
-  yabloc_particle_filter::msg::ParticleArray particle_array{};
-  particle_array.header = initialpose.header;
-  particle_array.id = 0;
-  particle_array.particles.resize(number_of_particles_);
+  ParticleState particles;
+  particles.header = initialpose.header;
+  particles.id = 0;
+  particles.resize(number_of_particles_);
 
   Eigen::Matrix2d cov;
   cov(0, 0) = initialpose.pose.covariance[6 * 0 + 0];
@@ -149,25 +152,29 @@ void Predictor::initialize_particles(const PoseCovStamped & initialpose)
   cov(1, 0) = initialpose.pose.covariance[6 * 1 + 0];
   cov(1, 1) = initialpose.pose.covariance[6 * 1 + 1];
 
-  const double yaw = tf2::getYaw(initialpose.pose.pose.orientation);
-  const double yaw_std = std::sqrt(initialpose.pose.covariance[6 * 5 + 5]);
-
-  for (auto & particle : particle_array.particles) {
-    geometry_msgs::msg::Pose pose = initialpose.pose.pose;
-    const Eigen::Vector2d noise = util::nrand_2d(cov);
-    pose.position.x += noise.x();
-    pose.position.y += noise.y();
-
-    auto noised_yaw = static_cast<float>(util::normalize_radian(yaw + util::nrand(yaw_std)));
-    pose.orientation.w = std::cos(noised_yaw / 2.0);
-    pose.orientation.x = 0.0;
-    pose.orientation.y = 0.0;
-    pose.orientation.z = std::sin(noised_yaw / 2.0);
-
-    particle.pose = pose;
-    particle.weight = 1.0;
+  // Decompose the covariance once instead of for every particle as util::nrand_2d() does
+  Eigen::JacobiSVD<Eigen::Matrix2d> svd;
+  svd.compute(cov, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  const Eigen::Matrix2f u = svd.matrixU().cast<float>();
+  const Eigen::Vector2f std_xy = svd.singularValues().cwiseMax(0.01).cwiseSqrt().cast<float>();
+
+  const auto & position = initialpose.pose.pose.position;
+  const auto yaw = static_cast<float>(tf2::getYaw(initialpose.pose.pose.orientation));
+  const auto yaw_std = static_cast<float>(std::sqrt(initialpose.pose.covariance[6 * 5 + 5]));
+
+  std::vector<float> noise(3 * number_of_particles_);
+  noise_generator_.fill(noise.data(), noise.size());
+  for (int i = 0; i < number_of_particles_; ++i) {
+    const Eigen::Vector2f xy(std_xy.x() * noise[3 * i], std_xy.y() * noise[3 * i + 1]);
+    const Eigen::Vector2f offset = u * xy;
+    particles.x[i] = static_cast<float>(position.x) + offset.x();
+    particles.y[i] = static_cast<float>(position.y) + offset.y();
+    particles.z[i] = static_cast<float>(position.z);
+    particles.yaw[i] = static_cast<float>(
+      util::normalize_radian(static_cast<double>(yaw + yaw_std * noise[3 * i + 2])));
+    particles.weight[i] = 1.0f;
   }
-  particle_array_opt_ = particle_array;
+  particle_state_opt_ = std::move(particles);
 
   // We have to initialize resampler every particles initialization,
   // because resampler has particles resampling history and it will be outdate.
@@ -190,7 +197,7 @@ void Predictor::on_twist_cov(const TwistCovStamped::ConstSharedPtr twist_cov)
 }
 
 void Predictor::update_with_dynamic_noise(
-  ParticleArray & particle_array, const TwistCovStamped & twist, double dt) const
+  ParticleState & particles, const TwistCovStamped & twist, double dt)
 {
   // linear & angular velocity
   const auto linear_x = static_cast<float>(twist.twist.twist.linear.x);
@@ -204,18 +211,9 @@ void Predictor::update_with_dynamic_noise(
     std_angular_z * std::clamp(std::sqrt(std::abs(linear_x)), 0.1f, 1.0f);
   const float truncated_linear_std = std::clamp(std_linear_x * linear_x, 0.1f, 2.0f);
 
-  for (auto & particle : particle_array.particles) {
-    Sophus::SE3f se3_pose = common::pose_to_se3(particle.pose);
-    Eigen::Matrix<float, 6, 1> noised_xi;
-    noised_xi.setZero();
-    noised_xi(0) = linear_x + util::nrand(truncated_linear_std);
-    noised_xi(5) = angular_z + util::nrand(truncated_angular_std);
-    se3_pose *= Sophus::SE3f::exp(noised_xi * dt);
-
-    geometry_msgs::msg::Pose pose = common::se3_to_pose(se3_pose);
-    pose.position.z = ground_height_;
-    particle.pose = pose;
-  }
+  predict_particles(
+    particles, linear_x, angular_z, truncated_linear_std, truncated_angular_std,
+    static_cast<float>(dt), ground_height_, noise_generator_);
 }
 
 void Predictor::on_timer()
@@ -226,8 +224,8 @@ void Predictor::on_timer()
   if (!yabloc_activated_) {
     return;
   }
-  // Return if particle_array is not initialized yet
-  if (!particle_array_opt_.has_value()) {
+  // Return if particles are not initialized yet
+  if (!particle_state_opt_.has_value()) {
     return;
   }
   // Return if twist is not subscribed yet
@@ -235,49 +233,46 @@ void Predictor::on_timer()
     return;
   }
   //
-  ParticleArray particle_array = particle_array_opt_.value();
+  ParticleState & particles = particle_state_opt_.value();
   const rclcpp::Time current_time = this->now();
-  const rclcpp::Time msg_time = particle_array.header.stamp;
+  const rclcpp::Time msg_time = particles.header.stamp;
   const double dt = (current_time - msg_time).seconds();
-  particle_array.header.stamp = current_time;
+  particles.header.stamp = current_time;
 
   // ==========================================================================
   // Prediction section
-  // NOTE: Sometimes particle_array.header.stamp is ancient due to lagged pose_initializer
+  // NOTE: Sometimes particles.header.stamp is ancient due to lagged pose_initializer
   if (dt < 0.0 || dt > 1.0) {
     RCLCPP_WARN_STREAM(get_logger(), "time stamp is wrong? " << dt);
-    particle_array_opt_->header.stamp = current_time;
     return;
   }
 
-  update_with_dynamic_noise(particle_array, latest_twist_opt_.value(), dt);
+  update_with_dynamic_noise(particles, latest_twist_opt_.value(), dt);
 
   // ==========================================================================
   // Post-process section
   //
-  predicted_particles_pub_->publish(particle_array);
+  particles.to_msg(particle_array_msg_);
+  predicted_particles_pub_->publish(particle_array_msg_);
   //
-  publish_mean_pose(get_mean_pose(particle_array), this->now());
+  publish_mean_pose(get_mean_pose(particles), this->now());
   // If visualizer exists,
   if (visualizer_ptr_) {
-    visualizer_ptr_->publish(particle_array);
+    visualizer_ptr_->publish(particle_array_msg_);
   }
-
-  particle_array_opt_ = particle_array;
 }
 
 void Predictor::on_weighted_particles(const ParticleArray::ConstSharedPtr weighted_particles_ptr)
 {
-  // NOTE: **We need not to check particle_array_opt.has_value().**
+  // NOTE: **We need not to check particle_state_opt.has_value().**
   // Since the weighted_particles is generated from messages published from this node,
-  // the particle_array must have an entity in this function.
-  ParticleArray particle_array = particle_array_opt_.value();
+  // the particles must have an entity in this function.
+  ParticleState & particles = particle_state_opt_.value();
 
   // ==========================================================================
   // From here, weighting section
   try {
-    particle_array =
-      resampler_ptr_->add_weight_retroactively(particle_array, *weighted_particles_ptr);
+    resampler_ptr_->add_weight_retroactively(particles, *weighted_particles_ptr);
   } catch (const ResamplingSkipException & e) {
     // Do nothing (just skipping the resample())
     RCLCPP_INFO_STREAM(this->get_logger(), "skipped resampling");
@@ -285,7 +280,7 @@ void Predictor::on_weighted_particles(const ParticleArray::ConstSharedPtr weight
 
   // ==========================================================================
   // From here, resampling section
-  const double current_time = rclcpp::Time(particle_array.header.stamp).seconds();
+  const double current_time = rclcpp::Time(particles.header.stamp).seconds();
   try {
     // Exit if previous resampling time is not valid.
     if (!previous_resampling_time_opt_.has_value()) {
@@ -297,15 +292,12 @@ void Predictor::on_weighted_particles(const ParticleArray::ConstSharedPtr weight
       throw ResamplingSkipException("it is not time to resample");
     }
 
-    particle_array = resampler_ptr_->resample(particle_array);
+    resampler_ptr_->resample(particles);
     previous_resampling_time_opt_ = current_time;
   } catch (const ResamplingSkipException & e) {
     void();
     // Do nothing (just skipping the resample())
   }
-
-  // ==========================================================================
-  particle_array_opt_ = particle_array;
 }
 
 void Predictor::publish_mean_pose(
@@ -340,7 +332,7 @@ void Predictor::publish_mean_pose(
   // Publish TF
   {
     geometry_msgs::msg::TransformStamped transform;
-    transform.header.stamp = particle_array_opt_->header.stamp;
+    transform.header.stamp = particle_state_opt_->header.stamp;
     transform.header.frame_id = "map";
     transform.child_frame_id = "particle_filter";
     transform.transform.translation.x = mean_pose.position.x;
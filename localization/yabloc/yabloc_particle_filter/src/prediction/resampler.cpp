@@ -18,6 +18,7 @@
 
 #include <boost/range/adaptor/indexed.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <random>
@@ -61,14 +62,9 @@ bool RetroactiveResampler::check_weighted_particles_validity(
   return true;
 }
 
-RetroactiveResampler::ParticleArray RetroactiveResampler::add_weight_retroactively(
-  const ParticleArray & predicted_particles, const ParticleArray & weighted_particles)
+std::vector<int> RetroactiveResampler::make_index_table(
+  const ParticleArray & weighted_particles) const
 {
-  if (!check_weighted_particles_validity(weighted_particles)) {
-    RCLCPP_ERROR_STREAM(logger_, "weighted_particles has invalid data");
-    throw ResamplingSkipException("weighted_particles has invalid data");
-  }
-
   // Initialize corresponding index lookup table
   // The m-th address has the m-th particle's parent index
   std::vector<int> index_table(weighted_particles.particles.size());
@@ -81,6 +77,18 @@ RetroactiveResampler::ParticleArray RetroactiveResampler::add_weight_retroactive
       index_table[m] = resampling_history_[generation][index_table[m]];
     }
   }
+  return index_table;
+}
+
+RetroactiveResampler::ParticleArray RetroactiveResampler::add_weight_retroactively(
+  const ParticleArray & predicted_particles, const ParticleArray & weighted_particles)
+{
+  if (!check_weighted_particles_validity(weighted_particles)) {
+    RCLCPP_ERROR_STREAM(logger_, "weighted_particles has invalid data");
+    throw ResamplingSkipException("weighted_particles has invalid data");
+  }
+
+  const std::vector<int> index_table = make_index_table(weighted_particles);
 
   ParticleArray weighted_particles_updated = predicted_particles;
 
@@ -99,17 +107,41 @@ RetroactiveResampler::ParticleArray RetroactiveResampler::add_weight_retroactive
   return weighted_particles_updated;
 }
 
-RetroactiveResampler::ParticleArray RetroactiveResampler::resample(
-  const ParticleArray & predicted_particles)
+void RetroactiveResampler::add_weight_retroactively(
+  ParticleState & predicted_particles, const ParticleArray & weighted_particles)
+{
+  if (!check_weighted_particles_validity(weighted_particles)) {
+    RCLCPP_ERROR_STREAM(logger_, "weighted_particles has invalid data");
+    throw ResamplingSkipException("weighted_particles has invalid data");
+  }
+
+  const std::vector<int> index_table = make_index_table(weighted_particles);
+
+  // Add weights to current particles
+  std::vector<float> & weights = predicted_particles.weight;
+  float sum_weight = 0;
+  for (int m = 0; m < number_of_particles_; m++) {
+    weights[m] *= weighted_particles.particles[index_table[m]].weight;
+    sum_weight += weights[m];
+  }
+
+  // Normalize all weight
+  const float sum_weight_inv = 1.f / sum_weight;
+  for (float & weight : weights) {
+    weight *= sum_weight_inv;
+  }
+}
+
+template <typename WeightAt>
+const std::vector<int> & RetroactiveResampler::draw_successors(WeightAt weight_at)
 {
-  ParticleArray resampled_particles{predicted_particles};
   latest_resampling_generation_++;
-  resampled_particles.id = latest_resampling_generation_;
 
   // Summation of current weights
-  const double sum_weight = std::accumulate(
-    predicted_particles.particles.begin(), predicted_particles.particles.end(), 0.0,
-    [](double weight, const Particle & ps) { return weight + ps.weight; });
+  double sum_weight = 0.0;
+  for (int m = 0; m < number_of_particles_; m++) {
+    sum_weight += weight_at(m);
+  }
   // Inverse of the summation of current weight
   const double sum_weight_inv = 1.0 / sum_weight;
   // Inverse of the number of particle
@@ -124,9 +156,11 @@ RetroactiveResampler::ParticleArray RetroactiveResampler::resample(
   }
 
   auto n_th_normalized_weight = [&](int index) -> double {
-    return predicted_particles.particles.at(index).weight * sum_weight_inv;
+    return weight_at(index) * sum_weight_inv;
   };
 
+  std::vector<int> & successors = resampling_history_[latest_resampling_generation_];
+
   //
   int predicted_particle_index = 0;
   double accumulated_normalized_weights = n_th_normalized_weight(0);
@@ -141,12 +175,8 @@ RetroactiveResampler::ParticleArray RetroactiveResampler::resample(
       predicted_particle_index++;
       accumulated_normalized_weights += n_th_normalized_weight(predicted_particle_index);
     }
-    // Copy particle to resampled variable
-    resampled_particles.particles[m] = predicted_particles.particles[predicted_particle_index];
-    // Reset weight uniformly
-    resampled_particles.particles[m].weight = static_cast<float>(num_of_particles_inv);
     // Make history
-    resampling_history_[latest_resampling_generation_][m] = predicted_particle_index;
+    successors[m] = predicted_particle_index;
   }
 
   // NOTE: This check wastes the computation time
@@ -155,9 +185,55 @@ RetroactiveResampler::ParticleArray RetroactiveResampler::resample(
     throw std::runtime_error("resampling_history may be broken");
   }
 
+  return successors;
+}
+
+RetroactiveResampler::ParticleArray RetroactiveResampler::resample(
+  const ParticleArray & predicted_particles)
+{
+  const std::vector<int> & successors = draw_successors(
+    [&](int index) -> double { return predicted_particles.particles.at(index).weight; });
+
+  ParticleArray resampled_particles{predicted_particles};
+  resampled_particles.id = latest_resampling_generation_;
+
+  const auto uniform_weight = static_cast<float>(1.0 / static_cast<double>(number_of_particles_));
+  for (int m = 0; m < number_of_particles_; m++) {
+    // Copy particle to resampled variable
+    resampled_particles.particles[m] = predicted_particles.particles[successors[m]];
+    // Reset weight uniformly
+    resampled_particles.particles[m].weight = uniform_weight;
+  }
+
   return resampled_particles;
 }
 
+void RetroactiveResampler::resample(ParticleState & predicted_particles)
+{
+  const std::vector<float> & weights = predicted_particles.weight;
+  const std::vector<int> & successors =
+    draw_successors([&](int index) -> double { return weights.at(index); });
+
+  // Gather the successors into the buffer and swap it with the predicted one
+  resampled_state_.resize(predicted_particles.size());
+  for (int m = 0; m < number_of_particles_; m++) {
+    const int index = successors[m];
+    resampled_state_.x[m] = predicted_particles.x[index];
+    resampled_state_.y[m] = predicted_particles.y[index];
+    resampled_state_.z[m] = predicted_particles.z[index];
+    resampled_state_.yaw[m] = predicted_particles.yaw[index];
+  }
+  std::swap(resampled_state_.x, predicted_particles.x);
+  std::swap(resampled_state_.y, predicted_particles.y);
+  std::swap(resampled_state_.z, predicted_particles.z);
+  std::swap(resampled_state_.yaw, predicted_particles.yaw);
+
+  // Reset weight uniformly
+  const auto uniform_weight = static_cast<float>(1.0 / static_cast<double>(number_of_particles_));
+  std::fill(predicted_particles.weight.begin(), predicted_particles.weight.end(), uniform_weight);
+  predicted_particles.id = latest_resampling_generation_;
+}
+
 double RetroactiveResampler::random_from_01_uniformly()
 {
   static std::default_random_engine engine(0);
@@ -0,0 +1,124 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/ll2_cost_map/hierarchical_cost_map.hpp"
+
+#include <autoware_utils_system/stop_watch.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Drive straight through a synthetic grid of road markings and measure how long each corrector
+// cycle is blocked by the cost map, with and without the background tile builder.
+
+pcl::PointCloud<pcl::PointNormal> create_road_markings(float extent, float interval)
+{
+  pcl::PointCloud<pcl::PointNormal> cloud;
+  for (float u = -extent; u < extent; u += interval) {
+    for (float v = -extent; v < extent; v += 5.f) {
+      pcl::PointNormal pn;
+      // lines along x
+      pn.x = v;
+      pn.y = u;
+      pn.z = 0;
+      pn.normal_x = v + 3.f;
+      pn.normal_y = u;
+      pn.normal_z = 0;
+      cloud.push_back(pn);
+      // lines along y
+      pn.x = u;
+      pn.y = v;
+      pn.normal_x = u;
+      pn.normal_y = v + 3.f;
+      cloud.push_back(pn);
+    }
+  }
+  return cloud;
+}
+
+struct Result
+{
+  double mean_ms{0};
+  double max_ms{0};
+  yabloc::CostMapStatistics statistics;
+};
+
+Result run(bool async_build, const pcl::PointCloud<pcl::PointNormal> & cloud, int cycles)
+{
+  rclcpp::NodeOptions options;
+  options.parameter_overrides(
+    {{"max_range", 40.0}, {"image_size", 800}, {"gamma", 5.0}, {"async_build", async_build},
+     {"prefetch_count", 1}});
+  rclcpp::Node node("benchmark_hierarchical_cost_map", options);
+  yabloc::HierarchicalCostMap cost_map(&node);
+  cost_map.set_cloud(cloud);
+  cost_map.set_height(0.f);
+
+  std::default_random_engine engine(0);
+  std::normal_distribution<float> spread(0.f, 5.f);
+  autoware_utils_system::StopWatch<std::chrono::milliseconds> stop_watch;
+
+  const Eigen::Vector2f heading(1.f, 0.f);
+  const float speed = 2.f;  // [m/cycle]
+
+  Result result;
+  for (int i = 0; i < cycles; ++i) {
+    const Eigen::Vector2f position(-200.f + speed * static_cast<float>(i), 1.f);
+
+    stop_watch.tic();
+    cost_map.prefetch(position, heading);
+    // Sample ahead of the vehicle as projected line segments do
+    for (int j = 0; j < 2000; ++j) {
+      const Eigen::Vector2f offset(std::abs(spread(engine)) * 3.f, spread(engine));
+      cost_map.at(position + offset);
+    }
+    cost_map.erase_obsolete();
+    const double elapsed = stop_watch.toc();
+
+    result.mean_ms += elapsed / cycles;
+    result.max_ms = std::max(result.max_ms, elapsed);
+
+    // The corrector runs at camera rate; give the builder the idle time it would have
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  result.statistics = cost_map.statistics();
+  return result;
+}
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  const auto cloud = create_road_markings(400.f, 10.f);
+  constexpr int cycles = 150;
+  std::cout << "road marking segments: " << cloud.size() << ", cycles: " << cycles << std::endl;
+
+  for (const bool async_build : {false, true}) {
+    const Result result = run(async_build, cloud, cycles);
+    std::cout << (async_build ? "async" : "sync ") << " mean " << result.mean_ms << " [ms]"
+              << " max " << result.max_ms << " [ms]"
+              << " sync_builds " << result.statistics.sync_builds << " async_builds "
+              << result.statistics.async_builds << " stalls_avoided "
+              << result.statistics.stalls_avoided << " evicted " << result.statistics.evicted
+              << std::endl;
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/common/prediction_util.hpp"
+#include "yabloc_particle_filter/prediction/particle_state.hpp"
+#include "yabloc_particle_filter/prediction/resampler.hpp"
+
+#include <autoware_utils_system/stop_watch.hpp>
+#include <sophus/se3.hpp>
+#include <yabloc_common/pose_conversions.hpp>
+
+#include <iostream>
+#include <vector>
+
+// Compare one predict+resample cycle of the message based particles (SE3::exp per particle, as
+// the predictor used to do) with the structure-of-arrays particles.
+
+namespace mpf = yabloc::modularized_particle_filter;
+using ParticleArray = yabloc_particle_filter::msg::ParticleArray;
+
+constexpr float linear_x = 10.f;
+constexpr float angular_z = 0.1f;
+constexpr float linear_std = 0.5f;
+constexpr float angular_std = 0.05f;
+constexpr float dt = 0.02f;
+
+void predict_msg(ParticleArray & particle_array)
+{
+  for (auto & particle : particle_array.particles) {
+    Sophus::SE3f se3_pose = yabloc::common::pose_to_se3(particle.pose);
+    Eigen::Matrix<float, 6, 1> noised_xi;
+    noised_xi.setZero();
+    noised_xi(0) = linear_x + mpf::util::nrand(linear_std);
+    noised_xi(5) = angular_z + mpf::util::nrand(angular_std);
+    se3_pose *= Sophus::SE3f::exp(noised_xi * dt);
+
+    geometry_msgs::msg::Pose pose = yabloc::common::se3_to_pose(se3_pose);
+    pose.position.z = 0;
+    particle.pose = pose;
+  }
+}
+
+ParticleArray make_weights(int number_of_particles)
+{
+  ParticleArray weighted;
+  weighted.id = 0;
+  weighted.particles.resize(number_of_particles);
+  for (int i = 0; i < number_of_particles; ++i) {
+    weighted.particles[i].weight = 1.f + static_cast<float>(i % 7);
+  }
+  return weighted;
+}
+
+int main()
+{
+  constexpr int cycles = 50;
+  autoware_utils_system::StopWatch<std::chrono::microseconds> stop_watch;
+
+  for (const int number_of_particles : {500, 1000, 5000, 10000}) {
+    const ParticleArray weighted = make_weights(number_of_particles);
+
+    // Message based
+    double msg_predict = 0;
+    double msg_resample = 0;
+    {
+      mpf::RetroactiveResampler resampler(number_of_particles, 100);
+      ParticleArray particle_array;
+      particle_array.particles.resize(number_of_particles);
+      for (auto & p : particle_array.particles) {
+        p.pose.orientation.w = 1.0;
+        p.weight = 1.f;
+      }
+      for (int i = 0; i < cycles; ++i) {
+        stop_watch.tic();
+        predict_msg(particle_array);
+        msg_predict += stop_watch.toc() / cycles;
+
+        stop_watch.tic();
+        ParticleArray weighted_now = weighted;
+        weighted_now.id = particle_array.id;
+        particle_array = resampler.add_weight_retroactively(particle_array, weighted_now);
+        particle_array = resampler.resample(particle_array);
+        msg_resample += stop_watch.toc() / cycles;
+      }
+    }
+
+    // Structure of arrays
+    double soa_predict = 0;
+    double soa_resample = 0;
+    double soa_publish = 0;
+    {
+      mpf::RetroactiveResampler resampler(number_of_particles, 100);
+      mpf::NormalNoiseGenerator generator(0);
+      mpf::ParticleState particles;
+      particles.resize(number_of_particles);
+      std::fill(particles.weight.begin(), particles.weight.end(), 1.f);
+      ParticleArray particle_array;
+      for (int i = 0; i < cycles; ++i) {
+        stop_watch.tic();
+        mpf::predict_particles(
+          particles, linear_x, angular_z, linear_std, angular_std, dt, 0.f, generator);
+        soa_predict += stop_watch.toc() / cycles;
+
+        stop_watch.tic();
+        ParticleArray weighted_now = weighted;
+        weighted_now.id = particles.id;
+        resampler.add_weight_retroactively(particles, weighted_now);
+        resampler.resample(particles);
+        soa_resample += stop_watch.toc() / cycles;
+
+        stop_watch.tic();
+        particles.to_msg(particle_array);
+        soa_publish += stop_watch.toc() / cycles;
+      }
+    }
+
+    std::cout << "particles " << number_of_particles << "\n"
+              << "  msg predict " << msg_predict << " [us] resample " << msg_resample << " [us]\n"
+              << "  soa predict " << soa_predict << " [us] resample " << soa_resample
+              << " [us] to_msg " << soa_publish << " [us]" << std::endl;
+  }
+  return 0;
+}
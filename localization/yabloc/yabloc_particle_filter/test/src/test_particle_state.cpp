@@ -0,0 +1,125 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "yabloc_particle_filter/prediction/particle_state.hpp"
+#include "yabloc_particle_filter/prediction/resampler.hpp"
+
+#include <sophus/se3.hpp>
+#include <yabloc_common/pose_conversions.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace mpf = yabloc::modularized_particle_filter;
+using ParticleArray = yabloc_particle_filter::msg::ParticleArray;
+
+constexpr int particle_count = 100;
+
+mpf::ParticleState make_particles()
+{
+  mpf::ParticleState particles;
+  particles.resize(particle_count);
+  for (int i = 0; i < particle_count; ++i) {
+    particles.x[i] = static_cast<float>(i);
+    particles.y[i] = -static_cast<float>(i);
+    particles.z[i] = 0.f;
+    particles.yaw[i] = static_cast<float>(-M_PI + 2.0 * M_PI * i / particle_count);
+    particles.weight[i] = 1.f;
+  }
+  return particles;
+}
+
+TEST(ParticleStateTestSuite, conversion)
+{
+  const mpf::ParticleState particles = make_particles();
+  ParticleArray msg;
+  particles.to_msg(msg);
+  ASSERT_EQ(msg.particles.size(), particles.size());
+
+  const mpf::ParticleState converted = mpf::ParticleState::from_msg(msg);
+  for (int i = 0; i < particle_count; ++i) {
+    EXPECT_FLOAT_EQ(converted.x[i], particles.x[i]);
+    EXPECT_FLOAT_EQ(converted.y[i], particles.y[i]);
+    EXPECT_NEAR(std::cos(converted.yaw[i] - particles.yaw[i]), 1.0, 1e-6);
+  }
+}
+
+TEST(ParticleStateTestSuite, predictionMatchesSe3)
+{
+  mpf::ParticleState particles = make_particles();
+  ParticleArray before;
+  particles.to_msg(before);
+
+  constexpr float linear_x = 10.f;
+  constexpr float angular_z = 0.3f;
+  constexpr float dt = 0.1f;
+  mpf::NormalNoiseGenerator generator(0);
+  mpf::predict_particles(particles, linear_x, angular_z, 0.f, 0.f, dt, 1.f, generator);
+
+  Eigen::Matrix<float, 6, 1> xi;
+  xi << linear_x, 0, 0, 0, 0, angular_z;
+  for (int i = 0; i < particle_count; ++i) {
+    const Sophus::SE3f expected =
+      yabloc::common::pose_to_se3(before.particles[i].pose) * Sophus::SE3f::exp(xi * dt);
+    EXPECT_NEAR(particles.x[i], expected.translation().x(), 1e-3);
+    EXPECT_NEAR(particles.y[i], expected.translation().y(), 1e-3);
+    EXPECT_FLOAT_EQ(particles.z[i], 1.f);
+    const Eigen::Vector3f axis = expected.so3().matrix().col(0);
+    EXPECT_NEAR(particles.yaw[i], std::atan2(axis.y(), axis.x()), 1e-4);
+  }
+}
+
+TEST(ParticleStateTestSuite, normalNoise)
+{
+  mpf::NormalNoiseGenerator generator(0);
+  std::vector<float> samples(100001);
+  generator.fill(samples.data(), samples.size());
+
+  const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+  double variance = 0;
+  for (const float s : samples) variance += (s - mean) * (s - mean) / samples.size();
+  EXPECT_NEAR(mean, 0.0, 0.02);
+  EXPECT_NEAR(variance, 1.0, 0.02);
+}
+
+TEST(ParticleStateTestSuite, resampling)
+{
+  mpf::RetroactiveResampler resampler(particle_count, 10);
+  mpf::ParticleState particles = make_particles();
+  for (int i = 0; i < particle_count; ++i) {
+    particles.x[i] = i < particle_count / 2 ? 1.f : -1.f;
+  }
+
+  ParticleArray weighted;
+  weighted.id = 0;
+  weighted.particles.resize(particle_count);
+  for (int i = 0; i < particle_count; ++i) {
+    weighted.particles[i].weight = i < particle_count / 2 ? 2.f : 1.f;
+  }
+
+  resampler.add_weight_retroactively(particles, weighted);
+  const float sum = std::accumulate(particles.weight.begin(), particles.weight.end(), 0.f);
+  EXPECT_NEAR(sum, 1.f, 1e-4);
+
+  resampler.resample(particles);
+  EXPECT_EQ(particles.id, 1);
+  EXPECT_EQ(particles.size(), static_cast<size_t>(particle_count));
+  for (const float w : particles.weight) EXPECT_FLOAT_EQ(w, 1.f / particle_count);
+
+  const float centroid = std::accumulate(particles.x.begin(), particles.x.end(), 0.f);
+  EXPECT_GT(centroid, 0.f);
+}
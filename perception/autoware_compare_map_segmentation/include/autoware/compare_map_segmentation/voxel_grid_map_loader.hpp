@@ -15,6 +15,8 @@
 #ifndef AUTOWARE__COMPARE_MAP_SEGMENTATION__VOXEL_GRID_MAP_LOADER_HPP_
 #define AUTOWARE__COMPARE_MAP_SEGMENTATION__VOXEL_GRID_MAP_LOADER_HPP_
 
+#include "autoware/compare_map_segmentation/voxel_occupancy_index.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_map_msgs/srv/get_differential_point_cloud_map.hpp>
@@ -29,6 +31,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 
 #include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -91,6 +94,11 @@ public:
 
 class VoxelGridMapLoader
 {
+public:
+  using VoxelGridPointXYZ = VoxelGridEx<pcl::PointXYZ>;
+  using FilteredPointCloud = typename pcl::Filter<pcl::PointXYZ>::PointCloud;
+  using FilteredPointCloudPtr = typename FilteredPointCloud::Ptr;
+
 protected:
   rclcpp::Logger logger_;
 
@@ -99,6 +107,8 @@ protected:
   double voxel_leaf_size_z_{};
   double downsize_ratio_z_axis_;
   bool debug_ = false;
+  /** \brief Whether is_close_to_map of the loader answers the queries with the occupancy index */
+  bool use_occupancy_index_ = true;
 
   // interfaces
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr downsampled_map_pub_;
@@ -108,10 +118,17 @@ protected:
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
     const pcl::VoxelGrid<pcl::PointXYZ> & voxel_grid);
 
+  /** \brief Index of the space within voxel_leaf_size_ of the downsampled map, or nullptr if the
+   * loader does not use it */
+  std::shared_ptr<const VoxelOccupancyIndex> create_occupancy_index(
+    const FilteredPointCloud & downsampled_map) const;
+  /** \brief Check the point with the index first, the neighbor voxels are searched only when the
+   * point is in a boundary cell of the index */
+  bool is_close_to_map_voxels(
+    const pcl::PointXYZ & point, const double distance_threshold, const FilteredPointCloudPtr & map,
+    const VoxelGridPointXYZ & voxel, const VoxelOccupancyIndex * occupancy_index) const;
+
 public:
-  using VoxelGridPointXYZ = VoxelGridEx<pcl::PointXYZ>;
-  using FilteredPointCloud = typename pcl::Filter<pcl::PointXYZ>::PointCloud;
-  using FilteredPointCloudPtr = typename FilteredPointCloud::Ptr;
   explicit VoxelGridMapLoader(
     rclcpp::Node * node, double leaf_size, double downsize_ratio_z_axis,
     std::string * tf_map_input_frame);
@@ -119,16 +136,20 @@ public:
   virtual ~VoxelGridMapLoader() = default;
 
   virtual bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) = 0;
+  /** \brief Check the points in parallel, is_close is set to 1 for the points close to the map */
+  virtual void check_close_to_map(
+    const std::vector<pcl::PointXYZ> & points, const double distance_threshold,
+    std::vector<std::uint8_t> & is_close);
   static bool is_close_to_neighbor_voxels(
-    const pcl::PointXYZ & point, const double distance_threshold, VoxelGridPointXYZ & voxel,
+    const pcl::PointXYZ & point, const double distance_threshold, const VoxelGridPointXYZ & voxel,
     pcl::search::Search<pcl::PointXYZ>::Ptr tree);
   bool is_close_to_neighbor_voxels(
     const pcl::PointXYZ & point, const double distance_threshold, const FilteredPointCloudPtr & map,
-    VoxelGridPointXYZ & voxel) const;
+    const VoxelGridPointXYZ & voxel) const;
   bool is_in_voxel(
     const pcl::PointXYZ & src_point, const pcl::PointXYZ & target_point,
     const double distance_threshold, const FilteredPointCloudPtr & map,
-    VoxelGridPointXYZ & voxel) const;
+    const VoxelGridPointXYZ & voxel) const;
 
   void publish_downsampled_map(const pcl::PointCloud<pcl::PointXYZ> & downsampled_pc);
   std::string * tf_map_input_frame_;
@@ -143,6 +164,7 @@ class VoxelGridStaticMapLoader : public VoxelGridMapLoader
 protected:
   VoxelGridPointXYZ voxel_grid_;
   FilteredPointCloudPtr voxel_map_ptr_;
+  std::shared_ptr<const VoxelOccupancyIndex> occupancy_index_;
   std::atomic_bool is_initialized_{false};
 
   // interface of map subscription
@@ -165,9 +187,39 @@ protected:
     FilteredPointCloudPtr map_cell_pc_ptr;
     float min_b_x, min_b_y, max_b_x, max_b_y;
     pcl::search::Search<pcl::PointXYZ>::Ptr map_cell_kdtree;
+    std::shared_ptr<const VoxelOccupancyIndex> occupancy_index;
   };
 
-  using VoxelGridDict = typename std::map<std::string, struct MapGridVoxelInfo>;
+  /** \brief Loaded map grids. A snapshot is never modified after it is published, so that the
+   * queries read it without taking dynamic_map_loader_mutex_ */
+  struct MapGridSnapshot
+  {
+    /** \brief x-coordinate of map grid which should belong to array[0][0] */
+    double origin_x{0.0};
+    /** \brief y-coordinate of map grid which should belong to array[0][0] */
+    double origin_y{0.0};
+    double map_grid_size_x{-1.0};
+    double map_grid_size_y{-1.0};
+    int map_grids_x{0};
+    int map_grids_y{0};
+    /** \brief Array to hold loaded map grid positions for fast map grid searching */
+    std::vector<std::shared_ptr<const MapGridVoxelInfo>> grids;
+
+    /** \brief Map grid that the position belongs to, or nullptr if it is not loaded */
+    inline const MapGridVoxelInfo * at(const double x, const double y) const
+    {
+      const double grid_x = std::floor((x - origin_x) / map_grid_size_x);
+      const double grid_y = std::floor((y - origin_y) / map_grid_size_y);
+      if (!(grid_x >= 0.0 && grid_x < map_grids_x && grid_y >= 0.0 && grid_y < map_grids_y)) {
+        return nullptr;
+      }
+      return grids[static_cast<std::size_t>(grid_x) +
+                   static_cast<std::size_t>(map_grids_x) * static_cast<std::size_t>(grid_y)]
+        .get();
+    }
+  };
+
+  using VoxelGridDict = typename std::map<std::string, std::shared_ptr<const MapGridVoxelInfo>>;
 
   /** \brief Map to hold loaded map grid id and it's voxel filter */
   VoxelGridDict current_voxel_grid_dict_;
@@ -192,19 +244,18 @@ protected:
   double origin_x_remainder_ = 0.0;
   double origin_y_remainder_ = 0.0;
 
-  /** \brief Array to hold loaded map grid positions for fast map grid searching.
-   */
-  std::vector<std::shared_ptr<MapGridVoxelInfo>> current_voxel_grid_array_;
+  /** \brief Latest map grids, accessed with std::atomic_load and std::atomic_store */
+  std::shared_ptr<const MapGridSnapshot> map_grid_snapshot_;
 
-  /** \brief Array size in x axis */
-  int map_grids_x_;
-  /** \brief Array size in y axis */
-  int map_grids_y_;
+  inline std::shared_ptr<const MapGridSnapshot> getMapGridSnapshot() const
+  {
+    return std::atomic_load(&map_grid_snapshot_);
+  }
 
-  /** \brief x-coordinate of map grid which should belong to array[0][0] */
-  float origin_x_;
-  /** \brief y-coordinate of map grid which should belong to array[0][0] */
-  float origin_y_;
+  /** \brief Check the point with the map grids of a snapshot */
+  virtual bool is_close_to_map_grid(
+    const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+    const double distance_threshold) const;
 
 public:
   explicit VoxelGridDynamicMapLoader(
@@ -218,21 +269,19 @@ public:
     const double map_update_distance_threshold);
   void request_update_map(const geometry_msgs::msg::Point & position);
   bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
-  /** \brief Check if point close to map pointcloud in the */
-  bool is_close_to_next_map_grid(
-    const pcl::PointXYZ & point, const int current_map_grid_index, const double distance_threshold,
-    const double origin_x, const double origin_y, const double map_grid_size_x,
-    const double map_grid_size_y, const int map_grids_x);
+  void check_close_to_map(
+    const std::vector<pcl::PointXYZ> & points, const double distance_threshold,
+    std::vector<std::uint8_t> & is_close) override;
 
   inline pcl::PointCloud<pcl::PointXYZ> getCurrentDownsampledMapPc()
   {
     pcl::PointCloud<pcl::PointXYZ> output;
     std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
     for (const auto & kv : current_voxel_grid_dict_) {
-      if (kv.second.map_cell_pc_ptr == nullptr) {
+      if (kv.second->map_cell_pc_ptr == nullptr) {
         continue;
       }
-      output = output + *(kv.second.map_cell_pc_ptr);
+      output = output + *(kv.second->map_cell_pc_ptr);
     }
     return output;
   }
@@ -262,38 +311,52 @@ public:
     updateVoxelGridArray();
   }
 
-  /** Update loaded map grid array for fast searching*/
+  /** Update loaded map grid array for fast searching. The queries keep the previous snapshot until
+   * they finish with it */
   virtual inline void updateVoxelGridArray()
   {
-    std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    origin_x_ = std::floor((current_position_.value().x - map_loader_radius_) / map_grid_size_x_) *
-                  map_grid_size_x_ +
-                origin_x_remainder_;
-    origin_y_ = std::floor((current_position_.value().y - map_loader_radius_) / map_grid_size_y_) *
-                  map_grid_size_y_ +
-                origin_y_remainder_;
-
-    map_grids_x_ = static_cast<int>(
-      std::ceil((current_position_.value().x + map_loader_radius_ - origin_x_) / map_grid_size_x_));
-    map_grids_y_ = static_cast<int>(
-      std::ceil((current_position_.value().y + map_loader_radius_ - origin_y_) / map_grid_size_y_));
-
-    if (map_grids_x_ * map_grids_y_ == 0) {
-      return;
-    }
+    auto snapshot = std::make_shared<MapGridSnapshot>();
+    {
+      std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
+      snapshot->map_grid_size_x = map_grid_size_x_;
+      snapshot->map_grid_size_y = map_grid_size_y_;
+      snapshot->origin_x =
+        std::floor((current_position_.value().x - map_loader_radius_) / map_grid_size_x_) *
+          map_grid_size_x_ +
+        origin_x_remainder_;
+      snapshot->origin_y =
+        std::floor((current_position_.value().y - map_loader_radius_) / map_grid_size_y_) *
+          map_grid_size_y_ +
+        origin_y_remainder_;
+
+      snapshot->map_grids_x = static_cast<int>(std::ceil(
+        (current_position_.value().x + map_loader_radius_ - snapshot->origin_x) /
+        map_grid_size_x_));
+      snapshot->map_grids_y = static_cast<int>(std::ceil(
+        (current_position_.value().y + map_loader_radius_ - snapshot->origin_y) /
+        map_grid_size_y_));
+
+      if (snapshot->map_grids_x <= 0 || snapshot->map_grids_y <= 0) {
+        return;
+      }
 
-    current_voxel_grid_array_.assign(
-      map_grids_x_ * map_grid_size_y_, std::make_shared<MapGridVoxelInfo>());
-    for (const auto & kv : current_voxel_grid_dict_) {
-      int index = static_cast<int>(
-        std::floor((kv.second.min_b_x - origin_x_) / map_grid_size_x_) +
-        map_grids_x_ * std::floor((kv.second.min_b_y - origin_y_) / map_grid_size_y_));
-      // TODO(1222-takeshi): check if index is valid
-      if (index >= map_grids_x_ * map_grids_y_ || index < 0) {
-        continue;
+      snapshot->grids.assign(
+        static_cast<std::size_t>(snapshot->map_grids_x) * snapshot->map_grids_y, nullptr);
+      for (const auto & kv : current_voxel_grid_dict_) {
+        const int grid_x = static_cast<int>(
+          std::floor((kv.second->min_b_x - snapshot->origin_x) / map_grid_size_x_));
+        const int grid_y = static_cast<int>(
+          std::floor((kv.second->min_b_y - snapshot->origin_y) / map_grid_size_y_));
+        if (
+          grid_x < 0 || grid_x >= snapshot->map_grids_x || grid_y < 0 ||
+          grid_y >= snapshot->map_grids_y) {
+          continue;
+        }
+        snapshot->grids.at(grid_x + snapshot->map_grids_x * grid_y) = kv.second;
       }
-      current_voxel_grid_array_.at(index) = std::make_shared<MapGridVoxelInfo>(kv.second);
     }
+    std::atomic_store(
+      &map_grid_snapshot_, std::shared_ptr<const MapGridSnapshot>(std::move(snapshot)));
   }
 
   inline void removeMapCell(const std::string & map_cell_id_to_remove)
@@ -337,22 +400,24 @@ public:
     map_cell_voxel_grid_tmp.setSaveLeafLayout(true);
     map_cell_voxel_grid_tmp.filter(*map_cell_downsampled_pc_ptr_tmp);
 
-    MapGridVoxelInfo current_voxel_grid_list_item;
-    current_voxel_grid_list_item.min_b_x = map_cell_to_add.metadata.min_x;
-    current_voxel_grid_list_item.min_b_y = map_cell_to_add.metadata.min_y;
-    current_voxel_grid_list_item.max_b_x = map_cell_to_add.metadata.max_x;
-    current_voxel_grid_list_item.max_b_y = map_cell_to_add.metadata.max_y;
+    auto current_voxel_grid_list_item = std::make_shared<MapGridVoxelInfo>();
+    current_voxel_grid_list_item->min_b_x = map_cell_to_add.metadata.min_x;
+    current_voxel_grid_list_item->min_b_y = map_cell_to_add.metadata.min_y;
+    current_voxel_grid_list_item->max_b_x = map_cell_to_add.metadata.max_x;
+    current_voxel_grid_list_item->max_b_y = map_cell_to_add.metadata.max_y;
 
-    current_voxel_grid_list_item.map_cell_voxel_grid.set_voxel_grid(
+    current_voxel_grid_list_item->map_cell_voxel_grid.set_voxel_grid(
       &(map_cell_voxel_grid_tmp.leaf_layout_), map_cell_voxel_grid_tmp.get_min_b(),
       map_cell_voxel_grid_tmp.get_max_b(), map_cell_voxel_grid_tmp.get_div_b(),
       map_cell_voxel_grid_tmp.get_divb_mul(), map_cell_voxel_grid_tmp.get_inverse_leaf_size());
 
-    current_voxel_grid_list_item.map_cell_pc_ptr.reset(new pcl::PointCloud<pcl::PointXYZ>);
-    current_voxel_grid_list_item.map_cell_pc_ptr = std::move(map_cell_downsampled_pc_ptr_tmp);
+    current_voxel_grid_list_item->occupancy_index =
+      create_occupancy_index(*map_cell_downsampled_pc_ptr_tmp);
+    current_voxel_grid_list_item->map_cell_pc_ptr = std::move(map_cell_downsampled_pc_ptr_tmp);
     // add
     std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    current_voxel_grid_dict_.insert({map_cell_to_add.cell_id, current_voxel_grid_list_item});
+    current_voxel_grid_dict_.insert(
+      {map_cell_to_add.cell_id, std::move(current_voxel_grid_list_item)});
   }
 };
 
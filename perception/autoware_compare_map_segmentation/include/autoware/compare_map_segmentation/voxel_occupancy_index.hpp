@@ -0,0 +1,81 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__COMPARE_MAP_SEGMENTATION__VOXEL_OCCUPANCY_INDEX_HPP_
+#define AUTOWARE__COMPARE_MAP_SEGMENTATION__VOXEL_OCCUPANCY_INDEX_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::compare_map_segmentation
+{
+
+/**
+ * \brief Occupancy of the space dilated by the distance threshold around the map points.
+ *
+ * A point is close to the map when some map point is within distance_threshold in x and y and
+ * within distance_threshold_z in z, which is what the neighbor voxel search of
+ * VoxelGridMapLoader checks. The space is divided into cells of half the thresholds, and each cell
+ * is marked as close when all of it is close to a single map point, or as boundary when only a
+ * part of it is. A query is then one hash lookup, and only the points in the boundary cells need
+ * the exact search.
+ */
+class VoxelOccupancyIndex
+{
+public:
+  enum class Occupancy : std::uint8_t { FAR = 0, BOUNDARY = 1, CLOSE = 2 };
+
+  VoxelOccupancyIndex(const double distance_threshold, const double distance_threshold_z);
+
+  /** \brief Mark the cells around the given map points, the voxel centroids of the map */
+  void build(const pcl::PointCloud<pcl::PointXYZ> & map_points);
+
+  Occupancy query(const pcl::PointXYZ & point) const;
+
+  double get_distance_threshold() const { return distance_threshold_; }
+  double get_distance_threshold_z() const { return distance_threshold_z_; }
+  std::size_t size() const { return num_entries_; }
+
+private:
+  // An entry holds the 2x2x2 cells in a voxel of the thresholds, as bits of the masks
+  struct Entry
+  {
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t z;
+    std::uint8_t close_mask;
+    std::uint8_t boundary_mask;
+  };
+
+  static std::size_t hash(const std::int32_t x, const std::int32_t y, const std::int32_t z);
+  Entry & find_or_insert(const std::int32_t x, const std::int32_t y, const std::int32_t z);
+  void rehash(const std::size_t capacity);
+
+  double distance_threshold_;
+  double distance_threshold_z_;
+  double inverse_cell_size_;
+  double inverse_cell_size_z_;
+
+  // open addressing with linear probing, an entry with no bits set is empty
+  std::vector<Entry> entries_;
+  std::size_t num_entries_{0};
+};
+
+}  // namespace autoware::compare_map_segmentation
+
+#endif  // AUTOWARE__COMPARE_MAP_SEGMENTATION__VOXEL_OCCUPANCY_INDEX_HPP_
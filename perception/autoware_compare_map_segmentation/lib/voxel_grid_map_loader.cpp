@@ -17,6 +17,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::compare_map_segmentation
@@ -82,6 +83,29 @@ bool VoxelGridMapLoader::isFeasibleWithPCLVoxelGrid(
   return true;
 }
 
+std::shared_ptr<const VoxelOccupancyIndex> VoxelGridMapLoader::create_occupancy_index(
+  const FilteredPointCloud & downsampled_map) const
+{
+  if (!use_occupancy_index_) {
+    return nullptr;
+  }
+  auto occupancy_index =
+    std::make_shared<VoxelOccupancyIndex>(voxel_leaf_size_, voxel_leaf_size_z_);
+  occupancy_index->build(downsampled_map);
+  return occupancy_index;
+}
+
+void VoxelGridMapLoader::check_close_to_map(
+  const std::vector<pcl::PointXYZ> & points, const double distance_threshold,
+  std::vector<std::uint8_t> & is_close)
+{
+  is_close.resize(points.size());
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    is_close[i] = is_close_to_map(points[i], distance_threshold) ? 1 : 0;
+  }
+}
+
 void VoxelGridMapLoader::publish_downsampled_map(
   const pcl::PointCloud<pcl::PointXYZ> & downsampled_pc)
 {
@@ -92,7 +116,7 @@ void VoxelGridMapLoader::publish_downsampled_map(
 }
 
 bool VoxelGridMapLoader::is_close_to_neighbor_voxels(
-  const pcl::PointXYZ & point, const double distance_threshold, VoxelGridPointXYZ & voxel,
+  const pcl::PointXYZ & point, const double distance_threshold, const VoxelGridPointXYZ & voxel,
   pcl::search::Search<pcl::PointXYZ>::Ptr tree)
 {
   const int index = voxel.getCentroidIndexAt(voxel.getGridCoordinates(point.x, point.y, point.z));
@@ -112,7 +136,7 @@ bool VoxelGridMapLoader::is_close_to_neighbor_voxels(
 
 bool VoxelGridMapLoader::is_close_to_neighbor_voxels(
   const pcl::PointXYZ & point, const double distance_threshold, const FilteredPointCloudPtr & map,
-  VoxelGridPointXYZ & voxel) const
+  const VoxelGridPointXYZ & voxel) const
 {
   // check map downsampled pc
   double distance_threshold_z = downsize_ratio_z_axis_ * distance_threshold;
@@ -277,7 +301,7 @@ bool VoxelGridMapLoader::is_close_to_neighbor_voxels(
 bool VoxelGridMapLoader::is_in_voxel(
   const pcl::PointXYZ & src_point, const pcl::PointXYZ & target_point,
   const double distance_threshold, const FilteredPointCloudPtr & map,
-  VoxelGridPointXYZ & voxel) const
+  const VoxelGridPointXYZ & voxel) const
 {
   int voxel_index =
     voxel.getCentroidIndexAt(voxel.getGridCoordinates(src_point.x, src_point.y, src_point.z));
@@ -295,6 +319,26 @@ bool VoxelGridMapLoader::is_in_voxel(
   return false;
 }
 
+bool VoxelGridMapLoader::is_close_to_map_voxels(
+  const pcl::PointXYZ & point, const double distance_threshold, const FilteredPointCloudPtr & map,
+  const VoxelGridPointXYZ & voxel, const VoxelOccupancyIndex * occupancy_index) const
+{
+  // the index marks the space within voxel_leaf_size_, it answers only that threshold
+  if (
+    occupancy_index != nullptr &&
+    distance_threshold == occupancy_index->get_distance_threshold()) {
+    switch (occupancy_index->query(point)) {
+      case VoxelOccupancyIndex::Occupancy::CLOSE:
+        return true;
+      case VoxelOccupancyIndex::Occupancy::FAR:
+        return false;
+      case VoxelOccupancyIndex::Occupancy::BOUNDARY:
+        break;
+    }
+  }
+  return is_close_to_neighbor_voxels(point, distance_threshold, map, voxel);
+}
+
 VoxelGridStaticMapLoader::VoxelGridStaticMapLoader(
   rclcpp::Node * node, double leaf_size, double downsize_ratio_z_axis,
   std::string * tf_map_input_frame)
@@ -323,6 +367,7 @@ void VoxelGridStaticMapLoader::onMapCallback(
   voxel_grid_.setInputCloud(map_pcl_ptr);
   voxel_grid_.setSaveLeafLayout(true);
   voxel_grid_.filter(*voxel_map_ptr_);
+  occupancy_index_ = create_occupancy_index(*voxel_map_ptr_);
   is_initialized_.store(true, std::memory_order_release);
 
   if (debug_) {
@@ -335,10 +380,8 @@ bool VoxelGridStaticMapLoader::is_close_to_map(
   if (!is_initialized_.load(std::memory_order_acquire)) {
     return false;
   }
-  if (is_close_to_neighbor_voxels(point, distance_threshold, voxel_map_ptr_, voxel_grid_)) {
-    return true;
-  }
-  return false;
+  return is_close_to_map_voxels(
+    point, distance_threshold, voxel_map_ptr_, voxel_grid_, occupancy_index_.get());
 }
 
 VoxelGridDynamicMapLoader::VoxelGridDynamicMapLoader(
@@ -380,90 +423,66 @@ void VoxelGridDynamicMapLoader::onEstimatedPoseCallback(nav_msgs::msg::Odometry:
   std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
   current_position_ = msg->pose.pose.position;
 }
-bool VoxelGridDynamicMapLoader::is_close_to_next_map_grid(
-  const pcl::PointXYZ & point, const int current_map_grid_index, const double distance_threshold,
-  const double origin_x, const double origin_y, const double map_grid_size_x,
-  const double map_grid_size_y, const int map_grids_x)
+bool VoxelGridDynamicMapLoader::is_close_to_map_grid(
+  const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+  const double distance_threshold) const
 {
-  int neighbor_map_grid_index = static_cast<int>(
-    std::floor((point.x - origin_x) / map_grid_size_x) +
-    map_grids_x * std::floor((point.y - origin_y) / map_grid_size_y));
-  std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
+  // Compare point with map grid that point belong to
+  const auto * current_map_grid = map_grid.at(point.x, point.y);
   if (
-    static_cast<size_t>(neighbor_map_grid_index) >= current_voxel_grid_array_.size() ||
-    neighbor_map_grid_index == current_map_grid_index ||
-    current_voxel_grid_array_.at(neighbor_map_grid_index) != nullptr) {
-    return false;
-  }
-  if (is_close_to_neighbor_voxels(
-        point, distance_threshold,
-        current_voxel_grid_array_.at(neighbor_map_grid_index)->map_cell_pc_ptr,
-        current_voxel_grid_array_.at(neighbor_map_grid_index)->map_cell_voxel_grid)) {
+    current_map_grid != nullptr &&
+    is_close_to_map_voxels(
+      point, distance_threshold, current_map_grid->map_cell_pc_ptr,
+      current_map_grid->map_cell_voxel_grid, current_map_grid->occupancy_index.get())) {
     return true;
   }
-  return false;
-}
 
-bool VoxelGridDynamicMapLoader::is_close_to_map(
-  const pcl::PointXYZ & point, const double distance_threshold)
-{
-  double origin_x, origin_y, map_grid_size_x, map_grid_size_y;
-  int map_grids_x, map_grid_index;
-  {
-    std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    if (current_voxel_grid_dict_.size() == 0) {
-      return false;
-    }
-    origin_x = origin_x_;
-    origin_y = origin_y_;
-    map_grid_size_x = map_grid_size_x_;
-    map_grid_size_y = map_grid_size_y_;
-    map_grids_x = map_grids_x_;
-    // Compare point with map grid that point belong to
-
-    map_grid_index = static_cast<int>(
-      std::floor((point.x - origin_x) / map_grid_size_x) +
-      map_grids_x * std::floor((point.y - origin_y) / map_grid_size_y));
-
-    if (static_cast<size_t>(map_grid_index) >= current_voxel_grid_array_.size()) {
-      return false;
+  // Compare point with the neighbor map cells if point close to map cell boundary
+  const std::pair<double, double> neighbor_offsets[] = {
+    {-distance_threshold, 0.0},
+    {distance_threshold, 0.0},
+    {0.0, -distance_threshold},
+    {0.0, distance_threshold}};
+  for (const auto & [offset_x, offset_y] : neighbor_offsets) {
+    const auto * neighbor_map_grid = map_grid.at(point.x + offset_x, point.y + offset_y);
+    if (neighbor_map_grid == nullptr || neighbor_map_grid == current_map_grid) {
+      continue;
     }
-    if (
-      current_voxel_grid_array_.at(map_grid_index) != nullptr &&
-      is_close_to_neighbor_voxels(
-        point, distance_threshold, current_voxel_grid_array_.at(map_grid_index)->map_cell_pc_ptr,
-        current_voxel_grid_array_.at(map_grid_index)->map_cell_voxel_grid)) {
+    if (is_close_to_map_voxels(
+          point, distance_threshold, neighbor_map_grid->map_cell_pc_ptr,
+          neighbor_map_grid->map_cell_voxel_grid, neighbor_map_grid->occupancy_index.get())) {
       return true;
     }
   }
+  return false;
+}
 
-  // Compare point with the neighbor map cells if point close to map cell boundary
-
-  if (is_close_to_next_map_grid(
-        pcl::PointXYZ(point.x - distance_threshold, point.y, point.z), map_grid_index,
-        distance_threshold, origin_x, origin_y, map_grid_size_x, map_grid_size_y, map_grids_x)) {
-    return true;
-  }
-
-  if (is_close_to_next_map_grid(
-        pcl::PointXYZ(point.x + distance_threshold, point.y, point.z), map_grid_index,
-        distance_threshold, origin_x, origin_y, map_grid_size_x, map_grid_size_y, map_grids_x)) {
-    return true;
+bool VoxelGridDynamicMapLoader::is_close_to_map(
+  const pcl::PointXYZ & point, const double distance_threshold)
+{
+  const auto map_grid = getMapGridSnapshot();
+  if (map_grid == nullptr) {
+    return false;
   }
+  return is_close_to_map_grid(*map_grid, point, distance_threshold);
+}
 
-  if (is_close_to_next_map_grid(
-        pcl::PointXYZ(point.x, point.y - distance_threshold, point.z), map_grid_index,
-        distance_threshold, origin_x, origin_y, map_grid_size_x, map_grid_size_y, map_grids_x)) {
-    return true;
+void VoxelGridDynamicMapLoader::check_close_to_map(
+  const std::vector<pcl::PointXYZ> & points, const double distance_threshold,
+  std::vector<std::uint8_t> & is_close)
+{
+  is_close.assign(points.size(), 0);
+  // all the points are checked with the same map grids
+  const auto map_grid = getMapGridSnapshot();
+  if (map_grid == nullptr) {
+    return;
   }
-  if (is_close_to_next_map_grid(
-        pcl::PointXYZ(point.x, point.y + distance_threshold, point.z), map_grid_index,
-        distance_threshold, origin_x, origin_y, map_grid_size_x, map_grid_size_y, map_grids_x)) {
-    return true;
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    is_close[i] = is_close_to_map_grid(*map_grid, points[i], distance_threshold) ? 1 : 0;
   }
-
-  return false;
 }
+
 void VoxelGridDynamicMapLoader::timer_callback()
 {
   std::optional<geometry_msgs::msg::Point> current_position;
@@ -0,0 +1,228 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/compare_map_segmentation/voxel_occupancy_index.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace autoware::compare_map_segmentation
+{
+namespace
+{
+// margin for the cells to be marked as close, against the rounding of the coordinates
+constexpr double close_margin = 1e-6;
+
+std::int64_t floor_div2(const std::int64_t value)
+{
+  return value >= 0 ? value / 2 : (value - 1) / 2;
+}
+
+bool to_cell_index(const double value, const double inverse_cell_size, std::int64_t & index)
+{
+  const double scaled = std::floor(value * inverse_cell_size);
+  // the voxels of the thresholds are indexed with int32_t
+  if (!(std::abs(scaled) < static_cast<double>(std::numeric_limits<std::int32_t>::max()))) {
+    return false;
+  }
+  index = static_cast<std::int64_t>(scaled);
+  return true;
+}
+
+// Cells of one axis around a map point, as 2 bits for each voxel in [first_voxel, last_voxel]
+struct AxisCells
+{
+  std::int64_t first_voxel{};
+  std::int64_t last_voxel{};
+  std::array<std::uint8_t, 4> touched_bits{};
+  std::array<std::uint8_t, 4> close_bits{};
+};
+
+bool get_axis_cells(
+  const double value, const double threshold, const double inverse_cell_size, AxisCells & cells)
+{
+  std::int64_t first_cell = 0;
+  std::int64_t last_cell = 0;
+  if (
+    !to_cell_index(value - threshold, inverse_cell_size, first_cell) ||
+    !to_cell_index(value + threshold, inverse_cell_size, last_cell)) {
+    return false;
+  }
+  const double cell_size = 1.0 / inverse_cell_size;
+  cells.first_voxel = floor_div2(first_cell);
+  cells.last_voxel = floor_div2(last_cell);
+  cells.touched_bits.fill(0);
+  cells.close_bits.fill(0);
+  for (std::int64_t cell = first_cell; cell <= last_cell; ++cell) {
+    const auto voxel = static_cast<std::size_t>(floor_div2(cell) - cells.first_voxel);
+    const auto bit = static_cast<std::uint8_t>(1U << (cell - 2 * floor_div2(cell)));
+    cells.touched_bits[voxel] |= bit;
+    // the whole cell is strictly within the threshold
+    if (
+      static_cast<double>(cell) * cell_size > value - threshold + close_margin &&
+      static_cast<double>(cell + 1) * cell_size < value + threshold - close_margin) {
+      cells.close_bits[voxel] |= bit;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+VoxelOccupancyIndex::VoxelOccupancyIndex(
+  const double distance_threshold, const double distance_threshold_z)
+: distance_threshold_(distance_threshold),
+  distance_threshold_z_(distance_threshold_z),
+  inverse_cell_size_(2.0 / distance_threshold),
+  inverse_cell_size_z_(2.0 / distance_threshold_z)
+{
+}
+
+std::size_t VoxelOccupancyIndex::hash(
+  const std::int32_t x, const std::int32_t y, const std::int32_t z)
+{
+  std::uint64_t h = std::uint64_t{static_cast<std::uint32_t>(x)} * 0x9E3779B97F4A7C15ULL;
+  h ^= std::uint64_t{static_cast<std::uint32_t>(y)} * 0xC2B2AE3D27D4EB4FULL;
+  h ^= std::uint64_t{static_cast<std::uint32_t>(z)} * 0x165667B19E3779F9ULL;
+  return static_cast<std::size_t>(h ^ (h >> 29));
+}
+
+void VoxelOccupancyIndex::rehash(const std::size_t capacity)
+{
+  std::vector<Entry> old_entries(capacity, Entry{0, 0, 0, 0, 0});
+  std::swap(entries_, old_entries);
+  const std::size_t mask = capacity - 1;
+  for (const auto & entry : old_entries) {
+    if ((entry.close_mask | entry.boundary_mask) == 0) {
+      continue;
+    }
+    std::size_t slot = hash(entry.x, entry.y, entry.z) & mask;
+    while ((entries_[slot].close_mask | entries_[slot].boundary_mask) != 0) {
+      slot = (slot + 1) & mask;
+    }
+    entries_[slot] = entry;
+  }
+}
+
+VoxelOccupancyIndex::Entry & VoxelOccupancyIndex::find_or_insert(
+  const std::int32_t x, const std::int32_t y, const std::int32_t z)
+{
+  // keep the load factor under 0.5 so that the probe sequences stay short
+  if (2 * (num_entries_ + 1) > entries_.size()) {
+    rehash(entries_.empty() ? 1024 : 2 * entries_.size());
+  }
+  const std::size_t mask = entries_.size() - 1;
+  std::size_t slot = hash(x, y, z) & mask;
+  while (true) {
+    Entry & entry = entries_[slot];
+    if ((entry.close_mask | entry.boundary_mask) == 0) {
+      entry.x = x;
+      entry.y = y;
+      entry.z = z;
+      ++num_entries_;
+      return entry;
+    }
+    if (entry.x == x && entry.y == y && entry.z == z) {
+      return entry;
+    }
+    slot = (slot + 1) & mask;
+  }
+}
+
+void VoxelOccupancyIndex::build(const pcl::PointCloud<pcl::PointXYZ> & map_points)
+{
+  entries_.clear();
+  num_entries_ = 0;
+
+  AxisCells cells_x;
+  AxisCells cells_y;
+  AxisCells cells_z;
+  for (const auto & point : map_points.points) {
+    if (
+      !get_axis_cells(point.x, distance_threshold_, inverse_cell_size_, cells_x) ||
+      !get_axis_cells(point.y, distance_threshold_, inverse_cell_size_, cells_y) ||
+      !get_axis_cells(point.z, distance_threshold_z_, inverse_cell_size_z_, cells_z)) {
+      continue;
+    }
+
+    for (std::int64_t vz = cells_z.first_voxel; vz <= cells_z.last_voxel; ++vz) {
+      const auto iz = static_cast<std::size_t>(vz - cells_z.first_voxel);
+      for (std::int64_t vy = cells_y.first_voxel; vy <= cells_y.last_voxel; ++vy) {
+        const auto iy = static_cast<std::size_t>(vy - cells_y.first_voxel);
+        for (std::int64_t vx = cells_x.first_voxel; vx <= cells_x.last_voxel; ++vx) {
+          const auto ix = static_cast<std::size_t>(vx - cells_x.first_voxel);
+          std::uint8_t touched_mask = 0;
+          std::uint8_t close_mask = 0;
+          for (unsigned int bit = 0; bit < 8; ++bit) {
+            const unsigned int bx = bit & 1U;
+            const unsigned int by = (bit >> 1) & 1U;
+            const unsigned int bz = (bit >> 2) & 1U;
+            if (
+              (cells_x.touched_bits[ix] >> bx) & (cells_y.touched_bits[iy] >> by) &
+              (cells_z.touched_bits[iz] >> bz) & 1U) {
+              touched_mask |= static_cast<std::uint8_t>(1U << bit);
+            }
+            if (
+              (cells_x.close_bits[ix] >> bx) & (cells_y.close_bits[iy] >> by) &
+              (cells_z.close_bits[iz] >> bz) & 1U) {
+              close_mask |= static_cast<std::uint8_t>(1U << bit);
+            }
+          }
+          Entry & entry = find_or_insert(
+            static_cast<std::int32_t>(vx), static_cast<std::int32_t>(vy),
+            static_cast<std::int32_t>(vz));
+          entry.close_mask |= close_mask;
+          entry.boundary_mask |= static_cast<std::uint8_t>(touched_mask & ~close_mask);
+        }
+      }
+    }
+  }
+}
+
+VoxelOccupancyIndex::Occupancy VoxelOccupancyIndex::query(const pcl::PointXYZ & point) const
+{
+  std::int64_t cell_x = 0;
+  std::int64_t cell_y = 0;
+  std::int64_t cell_z = 0;
+  if (
+    entries_.empty() || !to_cell_index(point.x, inverse_cell_size_, cell_x) ||
+    !to_cell_index(point.y, inverse_cell_size_, cell_y) ||
+    !to_cell_index(point.z, inverse_cell_size_z_, cell_z)) {
+    return Occupancy::FAR;
+  }
+  const auto x = static_cast<std::int32_t>(floor_div2(cell_x));
+  const auto y = static_cast<std::int32_t>(floor_div2(cell_y));
+  const auto z = static_cast<std::int32_t>(floor_div2(cell_z));
+  const auto bit = static_cast<std::uint8_t>(
+    1U << ((cell_x - 2 * x) | ((cell_y - 2 * y) << 1) | ((cell_z - 2 * z) << 2)));
+
+  const std::size_t mask = entries_.size() - 1;
+  std::size_t slot = hash(x, y, z) & mask;
+  while (true) {
+    const Entry & entry = entries_[slot];
+    if ((entry.close_mask | entry.boundary_mask) == 0) {
+      return Occupancy::FAR;
+    }
+    if (entry.x == x && entry.y == y && entry.z == z) {
+      if (entry.close_mask & bit) {
+        return Occupancy::CLOSE;
+      }
+      return (entry.boundary_mask & bit) ? Occupancy::BOUNDARY : Occupancy::FAR;
+    }
+    slot = (slot + 1) & mask;
+  }
+}
+
+}  // namespace autoware::compare_map_segmentation
@@ -29,7 +29,13 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <rcutils/filesystem.h>  // To be replaced by std::filesystem in C++17
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <utility>
 
 namespace autoware::compare_map_segmentation
 {
@@ -41,6 +47,18 @@ CompareElevationMapFilterComponent::CompareElevationMapFilterComponent(
   layer_name_ = declare_parameter<std::string>("map_layer_name");
   height_diff_thresh_ = declare_parameter<float>("height_diff_thresh");
   map_frame_ = declare_parameter<std::string>("map_frame");
+  use_tiled_elevation_map_ = declare_parameter<bool>("use_tiled_elevation_map");
+  elevation_map_tile_directory_ = declare_parameter<std::string>("elevation_map_tile_directory");
+
+  if (use_tiled_elevation_map_) {
+    // the tiles are written by the elevation map loader, wait for their index and then watch it
+    // for a new map
+    tile_timer_ = this->create_wall_timer(
+      std::chrono::seconds(1),
+      std::bind(&CompareElevationMapFilterComponent::openTiledElevationMap, this));
+    openTiledElevationMap();
+    return;
+  }
 
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -51,6 +69,38 @@ CompareElevationMapFilterComponent::CompareElevationMapFilterComponent(
       &CompareElevationMapFilterComponent::elevationMapCallback, this, std::placeholders::_1));
 }
 
+void CompareElevationMapFilterComponent::openTiledElevationMap()
+{
+  // the loader writes a new index when the map changes, the map is opened again when the hash in
+  // the index differs from the hash of the open map
+  using autoware::elevation_map_loader::readElevationMapTileIndexHeader;
+  const auto index_header = readElevationMapTileIndexHeader(elevation_map_tile_directory_);
+  const bool is_open = tiled_elevation_map_.isOpen();
+  if (index_header && is_open && index_header->map_hash == tiled_elevation_map_.getMapHash()) {
+    return;
+  }
+  autoware::elevation_map_loader::TiledElevationMap tiled_elevation_map;
+  if (!index_header || !tiled_elevation_map.open(elevation_map_tile_directory_)) {
+    // the open map is kept until a valid index is written
+    if (!is_open) {
+      RCLCPP_INFO_THROTTLE(
+        get_logger(), *get_clock(), 5000, "Waiting for the tiled elevation map in %s",
+        elevation_map_tile_directory_.c_str());
+    }
+    return;
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    tiled_elevation_map_ = std::move(tiled_elevation_map);
+  }
+  RCLCPP_INFO(
+    get_logger(), "Tiled elevation map with %lu tiles has been %s",
+    tiled_elevation_map_.getNumTiles(), is_open ? "reopened" : "opened");
+  if (!is_open) {
+    subscribe();
+  }
+}
+
 void CompareElevationMapFilterComponent::elevationMapCallback(
   const grid_map_msgs::msg::GridMap::ConstSharedPtr elevation_map)
 {
@@ -68,6 +118,11 @@ void CompareElevationMapFilterComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
 {
+  if (use_tiled_elevation_map_) {
+    filterWithTiledElevationMap(input, output);
+    return;
+  }
+
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
 
@@ -90,6 +145,51 @@ void CompareElevationMapFilterComponent::filter(
   output.header.stamp = input->header.stamp;
   output.header.frame_id = elevation_map_.getFrameId();
 }
+
+void CompareElevationMapFilterComponent::filterWithTiledElevationMap(
+  const PointCloud2ConstPtr & input, PointCloud2 & output)
+{
+  std::scoped_lock lock(mutex_);
+  pcl::PointCloud<pcl::PointXYZ> pcl_input;
+  pcl::PointCloud<pcl::PointXYZ> pcl_output;
+  pcl::fromROSMsg(*input, pcl_input);
+
+  // the tiles under the cloud are mapped, and the others unmapped
+  const std::size_t num_points = pcl_input.points.size();
+  xs_.resize(num_points);
+  ys_.resize(num_points);
+  heights_.resize(num_points);
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const auto & point = pcl_input.points[i];
+    xs_[i] = point.x;
+    ys_[i] = point.y;
+    if (std::isfinite(point.x) && std::isfinite(point.y)) {
+      min_x = std::min(min_x, point.x);
+      min_y = std::min(min_y, point.y);
+      max_x = std::max(max_x, point.x);
+      max_y = std::max(max_y, point.y);
+    }
+  }
+  tiled_elevation_map_.updateWindow(min_x, min_y, max_x, max_y);
+  tiled_elevation_map_.computeHeights(xs_.data(), ys_.data(), num_points, heights_.data());
+
+  // the heights are NaN outside the map, as the points outside the elevation map are removed
+  pcl_output.points.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const float height_diff = pcl_input.points[i].z - heights_[i];
+    if (height_diff > height_diff_thresh_) {
+      pcl_output.points.push_back(pcl_input.points[i]);
+    }
+  }
+
+  pcl::toROSMsg(pcl_output, output);
+  output.header.stamp = input->header.stamp;
+  output.header.frame_id = map_frame_;
+}
 }  // namespace autoware::compare_map_segmentation
 
 #include <rclcpp_components/register_node_macro.hpp>
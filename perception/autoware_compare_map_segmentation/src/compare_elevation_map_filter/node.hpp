@@ -15,6 +15,7 @@
 #ifndef COMPARE_ELEVATION_MAP_FILTER__NODE_HPP_
 #define COMPARE_ELEVATION_MAP_FILTER__NODE_HPP_
 
+#include "autoware/elevation_map_loader/elevation_map_tiles.hpp"
 #include "autoware/pointcloud_preprocessor/filter.hpp"
 
 #include <grid_map_core/GridMap.hpp>
@@ -25,6 +26,7 @@
 #include <grid_map_msgs/msg/grid_map.hpp>
 
 #include <string>
+#include <vector>
 namespace autoware::compare_map_segmentation
 {
 class CompareElevationMapFilterComponent : public autoware::pointcloud_preprocessor::Filter
@@ -44,9 +46,21 @@ private:
   std::string map_frame_;
   double height_diff_thresh_;
 
+  // the tiled elevation map written by autoware_elevation_map_loader, used instead of the
+  // elevation_map topic when use_tiled_elevation_map_ is set
+  bool use_tiled_elevation_map_;
+  std::string elevation_map_tile_directory_;
+  rclcpp::TimerBase::SharedPtr tile_timer_;
+  autoware::elevation_map_loader::TiledElevationMap tiled_elevation_map_;
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<float> heights_;
+
   void setVerbosityLevelToDebugIfFlagSet();
   void processPointcloud(grid_map::GridMapPclLoader * gridMapPclLoader);
   void elevationMapCallback(const grid_map_msgs::msg::GridMap::ConstSharedPtr elevation_map);
+  void openTiledElevationMap();
+  void filterWithTiledElevationMap(const PointCloud2ConstPtr & input, PointCloud2 & output);
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
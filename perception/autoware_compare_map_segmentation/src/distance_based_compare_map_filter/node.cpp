@@ -21,6 +21,7 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -72,36 +73,22 @@ bool DistanceBasedStaticMapLoader::is_close_to_map(
   }
   return true;
 }
-bool DistanceBasedDynamicMapLoader::is_close_to_map(
-  const pcl::PointXYZ & point, const double distance_threshold)
+bool DistanceBasedDynamicMapLoader::is_close_to_map_grid(
+  const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+  const double distance_threshold) const
 {
-  std::shared_ptr<pcl::search::Search<pcl::PointXYZ>> map_cell_kdtree;
-  {
-    std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    if (current_voxel_grid_dict_.size() == 0) {
-      return false;
-    }
-    if (!isFinite(point)) {
-      return false;
-    }
-
-    const int map_grid_index = static_cast<int>(
-      std::floor((point.x - origin_x_) / map_grid_size_x_) +
-      map_grids_x_ * std::floor((point.y - origin_y_) / map_grid_size_y_));
+  if (!isFinite(point)) {
+    return false;
+  }
 
-    if (static_cast<size_t>(map_grid_index) >= current_voxel_grid_array_.size()) {
-      return false;
-    }
-    const auto & current_voxel_grid = current_voxel_grid_array_.at(map_grid_index);
-    if (current_voxel_grid == nullptr) {
-      return false;
-    }
-    map_cell_kdtree = current_voxel_grid->map_cell_kdtree;
+  const auto * current_voxel_grid = map_grid.at(point.x, point.y);
+  if (current_voxel_grid == nullptr || current_voxel_grid->map_cell_kdtree == nullptr) {
+    return false;
   }
 
   std::vector<int> nn_indices(1);
   std::vector<float> nn_distances(1);
-  if (!map_cell_kdtree->nearestKSearch(point, 1, nn_indices, nn_distances)) {
+  if (!current_voxel_grid->map_cell_kdtree->nearestKSearch(point, 1, nn_indices, nn_distances)) {
     return false;
   }
 
@@ -147,18 +134,26 @@ void DistanceBasedCompareMapFilterComponent::filter(
   int offset_y = input->fields[pcl::getFieldIndex(*input, "y")].offset;
   int offset_z = input->fields[pcl::getFieldIndex(*input, "z")].offset;
 
+  const size_t num_points = input->data.size() / point_step;
+  std::vector<pcl::PointXYZ> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t global_offset = i * point_step;
+    std::memcpy(&points[i].x, &input->data[global_offset + offset_x], sizeof(float));
+    std::memcpy(&points[i].y, &input->data[global_offset + offset_y], sizeof(float));
+    std::memcpy(&points[i].z, &input->data[global_offset + offset_z], sizeof(float));
+  }
+  // the points are checked in parallel, then the points far from the map are copied in order
+  std::vector<std::uint8_t> is_close;
+  distance_based_map_loader_->check_close_to_map(points, distance_threshold_, is_close);
+
   output.data.resize(input->data.size());
   output.point_step = point_step;
   size_t output_size = 0;
-  for (size_t global_offset = 0; global_offset < input->data.size(); global_offset += point_step) {
-    pcl::PointXYZ point{};
-    std::memcpy(&point.x, &input->data[global_offset + offset_x], sizeof(float));
-    std::memcpy(&point.y, &input->data[global_offset + offset_y], sizeof(float));
-    std::memcpy(&point.z, &input->data[global_offset + offset_z], sizeof(float));
-    if (distance_based_map_loader_->is_close_to_map(point, distance_threshold_)) {
+  for (size_t i = 0; i < num_points; ++i) {
+    if (is_close[i]) {
       continue;
     }
-    std::memcpy(&output.data[output_size], &input->data[global_offset], point_step);
+    std::memcpy(&output.data[output_size], &input->data[i * point_step], point_step);
     output_size += point_step;
   }
   output.header = input->header;
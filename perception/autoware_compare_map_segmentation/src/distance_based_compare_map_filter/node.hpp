@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace autoware::compare_map_segmentation
 {
@@ -52,6 +53,11 @@ public:
 
 class DistanceBasedDynamicMapLoader : public VoxelGridDynamicMapLoader
 {
+protected:
+  bool is_close_to_map_grid(
+    const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+    const double distance_threshold) const override;
+
 public:
   DistanceBasedDynamicMapLoader(
     rclcpp::Node * node, double leaf_size, std::string * tf_map_input_frame,
@@ -60,7 +66,6 @@ public:
   {
     RCLCPP_INFO(logger_, "DistanceBasedDynamicMapLoader initialized.\n");
   }
-  bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
 
   inline void addMapCellAndFilter(
     const autoware_map_msgs::msg::PointCloudMapCellWithID & map_cell_to_add) override
@@ -77,11 +82,11 @@ public:
     auto map_cell_voxel_input_tmp_ptr =
       std::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_cell_pc_tmp);
 
-    MapGridVoxelInfo current_voxel_grid_list_item;
-    current_voxel_grid_list_item.min_b_x = map_cell_to_add.metadata.min_x;
-    current_voxel_grid_list_item.min_b_y = map_cell_to_add.metadata.min_y;
-    current_voxel_grid_list_item.max_b_x = map_cell_to_add.metadata.max_x;
-    current_voxel_grid_list_item.max_b_y = map_cell_to_add.metadata.max_y;
+    auto current_voxel_grid_list_item = std::make_shared<MapGridVoxelInfo>();
+    current_voxel_grid_list_item->min_b_x = map_cell_to_add.metadata.min_x;
+    current_voxel_grid_list_item->min_b_y = map_cell_to_add.metadata.min_y;
+    current_voxel_grid_list_item->max_b_x = map_cell_to_add.metadata.max_x;
+    current_voxel_grid_list_item->max_b_y = map_cell_to_add.metadata.max_y;
 
     // add kdtree
     pcl::search::Search<pcl::PointXYZ>::Ptr tree_tmp;
@@ -93,11 +98,12 @@ public:
       }
     }
     tree_tmp->setInputCloud(map_cell_voxel_input_tmp_ptr);
-    current_voxel_grid_list_item.map_cell_kdtree = tree_tmp;
+    current_voxel_grid_list_item->map_cell_kdtree = tree_tmp;
 
     // add
     std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    current_voxel_grid_dict_.insert({map_cell_to_add.cell_id, current_voxel_grid_list_item});
+    current_voxel_grid_dict_.insert(
+      {map_cell_to_add.cell_id, std::move(current_voxel_grid_list_item)});
   }
 };
 
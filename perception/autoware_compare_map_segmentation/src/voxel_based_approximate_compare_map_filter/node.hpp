@@ -38,6 +38,8 @@ public:
     std::string * tf_map_input_frame)
   : VoxelGridStaticMapLoader(node, leaf_size, downsize_ratio_z_axis, tf_map_input_frame)
   {
+    // only the voxel that the point belongs to is checked
+    use_occupancy_index_ = false;
     RCLCPP_INFO(logger_, "VoxelBasedApproximateStaticMapLoader initialized.\n");
   }
   bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
@@ -45,6 +47,11 @@ public:
 
 class VoxelBasedApproximateDynamicMapLoader : public VoxelGridDynamicMapLoader
 {
+protected:
+  bool is_close_to_map_grid(
+    const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+    const double distance_threshold) const override;
+
 public:
   VoxelBasedApproximateDynamicMapLoader(
     rclcpp::Node * node, double leaf_size, double downsize_ratio_z_axis,
@@ -52,9 +59,9 @@ public:
   : VoxelGridDynamicMapLoader(
       node, leaf_size, downsize_ratio_z_axis, tf_map_input_frame, main_callback_group)
   {
+    use_occupancy_index_ = false;
     RCLCPP_INFO(logger_, "VoxelBasedApproximateDynamicMapLoader initialized.\n");
   }
-  bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
 };
 
 class VoxelBasedApproximateCompareMapFilterComponent
@@ -29,6 +29,7 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.hpp>
 #endif
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -238,18 +239,26 @@ void VoxelBasedCompareMapFilterComponent::filter(
   int offset_y = input->fields[pcl::getFieldIndex(*input, "y")].offset;
   int offset_z = input->fields[pcl::getFieldIndex(*input, "z")].offset;
 
+  const size_t num_points = input->data.size() / point_step;
+  std::vector<pcl::PointXYZ> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t global_offset = i * point_step;
+    std::memcpy(&points[i].x, &input->data[global_offset + offset_x], sizeof(float));
+    std::memcpy(&points[i].y, &input->data[global_offset + offset_y], sizeof(float));
+    std::memcpy(&points[i].z, &input->data[global_offset + offset_z], sizeof(float));
+  }
+  // the points are checked in parallel, then the points far from the map are copied in order
+  std::vector<std::uint8_t> is_close;
+  voxel_grid_map_loader_->check_close_to_map(points, distance_threshold_, is_close);
+
   output.data.resize(input->data.size());
   output.point_step = point_step;
   size_t output_size = 0;
-  for (size_t global_offset = 0; global_offset < input->data.size(); global_offset += point_step) {
-    pcl::PointXYZ point{};
-    std::memcpy(&point.x, &input->data[global_offset + offset_x], sizeof(float));
-    std::memcpy(&point.y, &input->data[global_offset + offset_y], sizeof(float));
-    std::memcpy(&point.z, &input->data[global_offset + offset_z], sizeof(float));
-    if (voxel_grid_map_loader_->is_close_to_map(point, distance_threshold_)) {
+  for (size_t i = 0; i < num_points; ++i) {
+    if (is_close[i]) {
       continue;
     }
-    std::memcpy(&output.data[output_size], &input->data[global_offset], point_step);
+    std::memcpy(&output.data[output_size], &input->data[i * point_step], point_step);
     output_size += point_step;
   }
   output.header = input->header;
@@ -21,6 +21,7 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -81,32 +82,17 @@ bool VoxelDistanceBasedStaticMapLoader::is_close_to_map(
   return false;
 }
 
-bool VoxelDistanceBasedDynamicMapLoader::is_close_to_map(
-  const pcl::PointXYZ & point, const double distance_threshold)
+bool VoxelDistanceBasedDynamicMapLoader::is_close_to_map_grid(
+  const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+  const double distance_threshold) const
 {
-  std::shared_ptr<pcl::search::Search<pcl::PointXYZ>> map_cell_kdtree;
-  VoxelGridPointXYZ map_cell_voxel_grid;
-  {
-    std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    if (current_voxel_grid_dict_.size() == 0) {
-      return false;
-    }
-
-    const int map_grid_index = static_cast<int>(
-      std::floor((point.x - origin_x_) / map_grid_size_x_) +
-      map_grids_x_ * std::floor((point.y - origin_y_) / map_grid_size_y_));
-
-    if (static_cast<size_t>(map_grid_index) >= current_voxel_grid_array_.size()) {
-      return false;
-    }
-    if (current_voxel_grid_array_.at(map_grid_index) == nullptr) {
-      return false;
-    }
-    map_cell_voxel_grid = current_voxel_grid_array_.at(map_grid_index)->map_cell_voxel_grid;
-    map_cell_kdtree = current_voxel_grid_array_.at(map_grid_index)->map_cell_kdtree;
+  const auto * current_voxel_grid = map_grid.at(point.x, point.y);
+  if (current_voxel_grid == nullptr) {
+    return false;
   }
   return is_close_to_neighbor_voxels(
-    point, distance_threshold, map_cell_voxel_grid, map_cell_kdtree);
+    point, distance_threshold, current_voxel_grid->map_cell_voxel_grid,
+    current_voxel_grid->map_cell_kdtree);
 }
 
 VoxelDistanceBasedCompareMapFilterComponent::VoxelDistanceBasedCompareMapFilterComponent(
@@ -190,18 +176,26 @@ void VoxelDistanceBasedCompareMapFilterComponent::filter(
   int offset_y = input->fields[pcl::getFieldIndex(*input, "y")].offset;
   int offset_z = input->fields[pcl::getFieldIndex(*input, "z")].offset;
 
+  const size_t num_points = input->data.size() / point_step;
+  std::vector<pcl::PointXYZ> points(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t global_offset = i * point_step;
+    std::memcpy(&points[i].x, &input->data[global_offset + offset_x], sizeof(float));
+    std::memcpy(&points[i].y, &input->data[global_offset + offset_y], sizeof(float));
+    std::memcpy(&points[i].z, &input->data[global_offset + offset_z], sizeof(float));
+  }
+  // the points are checked in parallel, then the points far from the map are copied in order
+  std::vector<std::uint8_t> is_close;
+  voxel_distance_based_map_loader_->check_close_to_map(points, distance_threshold_, is_close);
+
   output.data.resize(input->data.size());
   output.point_step = point_step;
   size_t output_size = 0;
-  for (size_t global_offset = 0; global_offset < input->data.size(); global_offset += point_step) {
-    pcl::PointXYZ point{};
-    std::memcpy(&point.x, &input->data[global_offset + offset_x], sizeof(float));
-    std::memcpy(&point.y, &input->data[global_offset + offset_y], sizeof(float));
-    std::memcpy(&point.z, &input->data[global_offset + offset_z], sizeof(float));
-    if (voxel_distance_based_map_loader_->is_close_to_map(point, distance_threshold_)) {
+  for (size_t i = 0; i < num_points; ++i) {
+    if (is_close[i]) {
       continue;
     }
-    std::memcpy(&output.data[output_size], &input->data[global_offset], point_step);
+    std::memcpy(&output.data[output_size], &input->data[i * point_step], point_step);
     output_size += point_step;
   }
 
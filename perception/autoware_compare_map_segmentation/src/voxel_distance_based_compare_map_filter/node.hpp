@@ -57,6 +57,10 @@ public:
 class VoxelDistanceBasedDynamicMapLoader : public VoxelGridDynamicMapLoader
 {
 protected:
+  bool is_close_to_map_grid(
+    const MapGridSnapshot & map_grid, const pcl::PointXYZ & point,
+    const double distance_threshold) const override;
+
 private:
   FilteredPointCloudConstPtr map_ptr_;
   /* data */
@@ -69,7 +73,6 @@ public:
   {
     RCLCPP_INFO(logger_, "VoxelDistanceBasedDynamicMapLoader initialized.\n");
   }
-  bool is_close_to_map(const pcl::PointXYZ & point, const double distance_threshold) override;
 
   inline void addMapCellAndFilter(
     const autoware_map_msgs::msg::PointCloudMapCellWithID & map_cell_to_add) override
@@ -94,19 +97,18 @@ public:
     map_cell_voxel_grid_tmp.setSaveLeafLayout(true);
     map_cell_voxel_grid_tmp.filter(*map_cell_downsampled_pc_ptr_tmp);
 
-    MapGridVoxelInfo current_voxel_grid_list_item;
-    current_voxel_grid_list_item.min_b_x = map_cell_to_add.metadata.min_x;
-    current_voxel_grid_list_item.min_b_y = map_cell_to_add.metadata.min_y;
-    current_voxel_grid_list_item.max_b_x = map_cell_to_add.metadata.max_x;
-    current_voxel_grid_list_item.max_b_y = map_cell_to_add.metadata.max_y;
+    auto current_voxel_grid_list_item = std::make_shared<MapGridVoxelInfo>();
+    current_voxel_grid_list_item->min_b_x = map_cell_to_add.metadata.min_x;
+    current_voxel_grid_list_item->min_b_y = map_cell_to_add.metadata.min_y;
+    current_voxel_grid_list_item->max_b_x = map_cell_to_add.metadata.max_x;
+    current_voxel_grid_list_item->max_b_y = map_cell_to_add.metadata.max_y;
 
-    current_voxel_grid_list_item.map_cell_voxel_grid.set_voxel_grid(
+    current_voxel_grid_list_item->map_cell_voxel_grid.set_voxel_grid(
       &(map_cell_voxel_grid_tmp.leaf_layout_), map_cell_voxel_grid_tmp.get_min_b(),
       map_cell_voxel_grid_tmp.get_max_b(), map_cell_voxel_grid_tmp.get_div_b(),
       map_cell_voxel_grid_tmp.get_divb_mul(), map_cell_voxel_grid_tmp.get_inverse_leaf_size());
 
-    current_voxel_grid_list_item.map_cell_pc_ptr.reset(new pcl::PointCloud<pcl::PointXYZ>);
-    current_voxel_grid_list_item.map_cell_pc_ptr = std::move(map_cell_downsampled_pc_ptr_tmp);
+    current_voxel_grid_list_item->map_cell_pc_ptr = std::move(map_cell_downsampled_pc_ptr_tmp);
 
     // add kdtree
     pcl::search::Search<pcl::PointXYZ>::Ptr tree_tmp;
@@ -118,11 +120,12 @@ public:
       }
     }
     tree_tmp->setInputCloud(map_cell_voxel_input_tmp_ptr);
-    current_voxel_grid_list_item.map_cell_kdtree = tree_tmp;
+    current_voxel_grid_list_item->map_cell_kdtree = tree_tmp;
 
     // add
     std::lock_guard<std::mutex> lock(dynamic_map_loader_mutex_);
-    current_voxel_grid_dict_.insert({map_cell_to_add.cell_id, current_voxel_grid_list_item});
+    current_voxel_grid_dict_.insert(
+      {map_cell_to_add.cell_id, std::move(current_voxel_grid_list_item)});
   }
 };
 
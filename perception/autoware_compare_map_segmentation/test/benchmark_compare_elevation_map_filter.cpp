@@ -0,0 +1,246 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/elevation_map_loader/elevation_map_tiles.hpp"
+
+#include <grid_map_core/GridMap.hpp>
+#include <grid_map_cv/GridMapCvConverter.hpp>
+#include <grid_map_ros/GridMapRosConverter.hpp>
+
+#include <grid_map_msgs/msg/grid_map.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measure the startup, the memory and the filtering of compare_elevation_map_filter with a
+// synthetic 2500m x 2000m (5 km^2) elevation map of 0.3m cells and a cloud of 200k points within
+// 100m of the ego vehicle. The previous implementation is reproduced as the baseline: the whole
+// grid map is converted from the message, copied and converted to an image as in
+// elevationMapCallback, and each point is interpolated with GridMap::atPosition. The tiled
+// elevation map is opened from its index, the tiles under the cloud are memory-mapped and the
+// heights are interpolated in one batch. The resident memory is read from /proc/self/status before
+// the startup and after the filtering of each, the tiled map being measured first.
+
+namespace
+{
+using autoware::elevation_map_loader::ElevationMapTileCoordinate;
+using autoware::elevation_map_loader::ElevationMapTileHeader;
+using autoware::elevation_map_loader::TiledElevationMap;
+using Clock = std::chrono::steady_clock;
+
+constexpr double map_length_x = 2500.0;
+constexpr double map_length_y = 2000.0;
+constexpr double resolution = 0.3;
+constexpr std::uint32_t tile_size = 128;
+constexpr std::size_t num_points = 200000;
+constexpr float height_diff_thresh = 0.15f;
+const std::string layer_name = "elevation";
+
+float getTerrainHeight(const double x, const double y)
+{
+  return static_cast<float>(5.0 * std::sin(x / 200.0) + 3.0 * std::cos(y / 150.0));
+}
+
+// the resident memory of the process in MB
+double getResidentMemory()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmRSS:", 0) == 0) {
+      return std::stod(line.substr(6)) / 1024.0;
+    }
+  }
+  return 0.0;
+}
+
+double getElapsedMs(const Clock::time_point & start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// the tiles of the map, which starts at the origin
+void writeTiles(const std::filesystem::path & directory)
+{
+  const double tile_length = resolution * tile_size;
+  const auto num_tiles_x = static_cast<std::int32_t>(std::ceil(map_length_x / tile_length));
+  const auto num_tiles_y = static_cast<std::int32_t>(std::ceil(map_length_y / tile_length));
+  std::vector<ElevationMapTileCoordinate> tiles;
+  std::vector<float> samples;
+  for (std::int32_t tile_y = 0; tile_y < num_tiles_y; ++tile_y) {
+    for (std::int32_t tile_x = 0; tile_x < num_tiles_x; ++tile_x) {
+      samples.clear();
+      for (std::uint32_t j = 0; j <= tile_size; ++j) {
+        for (std::uint32_t i = 0; i <= tile_size; ++i) {
+          samples.push_back(getTerrainHeight(
+            (static_cast<double>(tile_x) * tile_size + i) * resolution,
+            (static_cast<double>(tile_y) * tile_size + j) * resolution));
+        }
+      }
+      ElevationMapTileHeader header{};
+      header.tile_size = tile_size;
+      header.tile_x = tile_x;
+      header.tile_y = tile_y;
+      header.resolution = resolution;
+      autoware::elevation_map_loader::writeElevationMapTile(directory, header, samples);
+      tiles.push_back({tile_x, tile_y});
+    }
+  }
+  autoware::elevation_map_loader::writeElevationMapTileIndex(
+    directory, tile_size, resolution, tiles, 0);
+}
+
+grid_map_msgs::msg::GridMap::UniquePtr createGridMapMessage()
+{
+  grid_map::GridMap map({layer_name});
+  map.setFrameId("map");
+  map.setGeometry(
+    grid_map::Length(map_length_x, map_length_y), resolution,
+    grid_map::Position(map_length_x / 2.0, map_length_y / 2.0));
+  for (grid_map::GridMapIterator iterator(map); !iterator.isPastEnd(); ++iterator) {
+    grid_map::Position position;
+    map.getPosition(*iterator, position);
+    map.at(layer_name, *iterator) = getTerrainHeight(position.x(), position.y());
+  }
+  return grid_map::GridMapRosConverter::toMessage(map);
+}
+
+struct Cloud
+{
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> zs;
+};
+
+// half of the points on the ground and half of them above it
+Cloud createCloud(const double ego_x, const double ego_y)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> angle_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<double> range_distribution(2.0, 100.0);
+  std::uniform_real_distribution<float> height_distribution(0.0f, 2.0f);
+  Cloud cloud;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double angle = angle_distribution(engine);
+    const double range = range_distribution(engine);
+    const double x = ego_x + range * std::cos(angle);
+    const double y = ego_y + range * std::sin(angle);
+    cloud.xs.push_back(static_cast<float>(x));
+    cloud.ys.push_back(static_cast<float>(y));
+    cloud.zs.push_back(
+      getTerrainHeight(x, y) + (i % 2 == 0 ? 0.05f : 0.3f + height_distribution(engine)));
+  }
+  return cloud;
+}
+
+template <class F>
+double measure(const F & function)
+{
+  constexpr int iterations = 20;
+  function();  // warm up
+  const auto start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+  return getElapsedMs(start) / iterations;
+}
+}  // namespace
+
+int main()
+{
+  const auto directory = std::filesystem::temp_directory_path() /
+                         ("benchmark_compare_elevation_map_filter_" + std::to_string(::getpid()));
+  std::filesystem::create_directories(directory);
+  auto start = Clock::now();
+  writeTiles(directory);
+  const double write_ms = getElapsedMs(start);
+  const auto message = createGridMapMessage();
+  const auto cloud = createCloud(1200.0, 900.0);
+  std::cout << "map: " << map_length_x << "m x " << map_length_y << "m, resolution " << resolution
+            << "m, points: " << num_points << ", tiles written in " << write_ms << " ms"
+            << std::endl;
+
+  // tiled elevation map
+  double rss = getResidentMemory();
+  start = Clock::now();
+  TiledElevationMap tiled_map;
+  tiled_map.open(directory);
+  const double tiled_startup_ms = getElapsedMs(start);
+  std::size_t tiled_kept = 0;
+  std::vector<float> heights(num_points);
+  const double tiled_filter_ms = measure([&]() {
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+    for (std::size_t i = 0; i < num_points; ++i) {
+      min_x = std::min(min_x, cloud.xs[i]);
+      min_y = std::min(min_y, cloud.ys[i]);
+      max_x = std::max(max_x, cloud.xs[i]);
+      max_y = std::max(max_y, cloud.ys[i]);
+    }
+    tiled_map.updateWindow(min_x, min_y, max_x, max_y);
+    tiled_map.computeHeights(cloud.xs.data(), cloud.ys.data(), num_points, heights.data());
+    tiled_kept = 0;
+    for (std::size_t i = 0; i < num_points; ++i) {
+      tiled_kept += cloud.zs[i] - heights[i] > height_diff_thresh;
+    }
+  });
+  const double tiled_rss = getResidentMemory() - rss;
+  std::cout << "tiled elevation map: startup " << tiled_startup_ms << " ms, resident memory +"
+            << tiled_rss << " MB (" << tiled_map.getNumMappedTiles() << " of "
+            << tiled_map.getNumTiles() << " tiles mapped), filter " << tiled_filter_ms
+            << " ms, kept " << tiled_kept << " points" << std::endl;
+
+  // whole grid map, as in elevationMapCallback and filter
+  rss = getResidentMemory();
+  start = Clock::now();
+  grid_map::GridMap elevation_map;
+  grid_map::GridMapRosConverter::fromMessage(*message, elevation_map);
+  grid_map::Matrix elevation_map_data = elevation_map.get(layer_name);
+  cv::Mat elevation_image;
+  grid_map::GridMapCvConverter::toImage<uint16_t, 1>(
+    elevation_map, layer_name, CV_16UC1, elevation_map.get(layer_name).minCoeffOfFinites(),
+    elevation_map.get(layer_name).maxCoeffOfFinites(), elevation_image);
+  const double grid_map_startup_ms = getElapsedMs(start);
+  std::size_t grid_map_kept = 0;
+  const double grid_map_filter_ms = measure([&]() {
+    grid_map_kept = 0;
+    for (std::size_t i = 0; i < num_points; ++i) {
+      const grid_map::Position position(cloud.xs[i], cloud.ys[i]);
+      if (elevation_map.isInside(position)) {
+        const float elevation_value = elevation_map.atPosition(
+          layer_name, position, grid_map::InterpolationMethods::INTER_LINEAR);
+        grid_map_kept += cloud.zs[i] - elevation_value > height_diff_thresh;
+      }
+    }
+  });
+  const double grid_map_rss = getResidentMemory() - rss;
+  std::cout << "whole grid map: startup " << grid_map_startup_ms << " ms, resident memory +"
+            << grid_map_rss << " MB, filter " << grid_map_filter_ms << " ms, kept "
+            << grid_map_kept << " points" << std::endl;
+
+  std::filesystem::remove_all(directory);
+  return 0;
+}
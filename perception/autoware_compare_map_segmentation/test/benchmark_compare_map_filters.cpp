@@ -0,0 +1,206 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/distance_based_compare_map_filter/node.hpp"
+#include "../src/voxel_based_approximate_compare_map_filter/node.hpp"
+#include "../src/voxel_distance_based_compare_map_filter/node.hpp"
+#include "autoware/compare_map_segmentation/voxel_grid_map_loader.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measure the map queries of the compare map filters with a 200m x 200m ground map with walls and
+// a cloud of 200k points, most of them on the ground as a lidar would see them. Each loader is
+// measured with a serial loop of is_close_to_map, as the filters did, and with check_close_to_map,
+// which the filters use now. The voxel based filter is also measured without the occupancy index,
+// which is the 27 voxel search of the previous implementation. The compare elevation map filter is
+// not included since it compares the points with an elevation grid map, not with a pointcloud map.
+// The static map loaders are used so that no map server is needed, the dynamic map loaders query
+// the map grids in the same way. The number of threads is given by OMP_NUM_THREADS.
+
+namespace
+{
+using autoware::compare_map_segmentation::DistanceBasedStaticMapLoader;
+using autoware::compare_map_segmentation::VoxelBasedApproximateStaticMapLoader;
+using autoware::compare_map_segmentation::VoxelDistanceBasedStaticMapLoader;
+using autoware::compare_map_segmentation::VoxelGridStaticMapLoader;
+
+constexpr double distance_threshold = 0.5;
+constexpr double downsize_ratio_z_axis = 0.5;
+
+class NoIndexVoxelGridStaticMapLoader : public VoxelGridStaticMapLoader
+{
+public:
+  NoIndexVoxelGridStaticMapLoader(
+    rclcpp::Node * node, double leaf_size, double downsize_ratio_z_axis,
+    std::string * tf_map_input_frame)
+  : VoxelGridStaticMapLoader(node, leaf_size, downsize_ratio_z_axis, tf_map_input_frame)
+  {
+    use_occupancy_index_ = false;
+  }
+};
+
+float groundHeight(const float x, const float y)
+{
+  return 0.02f * x + 0.5f * std::sin(0.05f * y);
+}
+
+sensor_msgs::msg::PointCloud2::ConstSharedPtr makeMap()
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> position_distribution(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> noise_distribution(-0.03f, 0.03f);
+  std::uniform_real_distribution<float> wall_height_distribution(0.0f, 5.0f);
+
+  pcl::PointCloud<pcl::PointXYZ> map;
+  for (int i = 0; i < 2000000; ++i) {
+    const float x = position_distribution(engine);
+    const float y = position_distribution(engine);
+    map.push_back(pcl::PointXYZ(x, y, groundHeight(x, y) + noise_distribution(engine)));
+  }
+  // walls of the buildings along the road
+  for (int i = 0; i < 500000; ++i) {
+    const float x = (i % 2 == 0 ? -15.0f : 15.0f) + noise_distribution(engine);
+    const float y = position_distribution(engine);
+    map.push_back(pcl::PointXYZ(x, y, groundHeight(x, y) + wall_height_distribution(engine)));
+  }
+
+  auto map_msg = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  pcl::toROSMsg(map, *map_msg);
+  map_msg->header.frame_id = "map";
+  return map_msg;
+}
+
+std::vector<pcl::PointXYZ> makeInput()
+{
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<float> angle_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<float> noise_distribution(-0.05f, 0.05f);
+  std::uniform_real_distribution<float> object_height_distribution(0.3f, 2.0f);
+
+  std::vector<pcl::PointXYZ> points;
+  for (int i = 0; i < 200000; ++i) {
+    const float angle = angle_distribution(engine);
+    const float range = 3.0f + 0.6f * static_cast<float>(i % 128);
+    const float x = range * std::cos(angle);
+    const float y = range * std::sin(angle);
+    // one point in ten is on an object which is not in the map
+    const float height = i % 10 == 0 ? object_height_distribution(engine) : 0.0f;
+    points.emplace_back(x, y, groundHeight(x, y) + height + noise_distribution(engine));
+  }
+  return points;
+}
+
+// The loaders declare their parameters, so each of them is given its own node
+rclcpp::Node::SharedPtr makeNode(const std::string & name)
+{
+  rclcpp::NodeOptions node_options;
+  node_options.append_parameter_override("publish_debug_pcd", false);
+  return std::make_shared<rclcpp::Node>(name, node_options);
+}
+
+template <class F>
+double measure(const F & function)
+{
+  constexpr int iterations = 5;
+  function();  // warm up
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+           .count() /
+         iterations;
+}
+
+void run(
+  const std::string & name, VoxelGridStaticMapLoader & loader,
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & map,
+  const std::vector<pcl::PointXYZ> & points)
+{
+  loader.onMapCallback(map);
+
+  std::vector<std::uint8_t> is_close(points.size());
+  const double serial_ms = measure([&]() {
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      is_close[i] = loader.is_close_to_map(points[i], distance_threshold) ? 1 : 0;
+    }
+  });
+  const double batch_ms =
+    measure([&]() { loader.check_close_to_map(points, distance_threshold, is_close); });
+
+  std::size_t num_close = 0;
+  for (const auto close : is_close) {
+    num_close += close;
+  }
+  std::cout << name << ": is_close_to_map " << serial_ms << " ms, check_close_to_map " << batch_ms
+            << " ms, removed points " << num_close << std::endl;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  std::string tf_map_input_frame;
+
+  const auto map = makeMap();
+  const auto points = makeInput();
+  std::cout << "map points: " << map->width * map->height << ", input points: " << points.size()
+            << std::endl;
+
+  {
+    const auto node = makeNode("benchmark_voxel_based_without_index");
+    NoIndexVoxelGridStaticMapLoader loader(
+      node.get(), distance_threshold, downsize_ratio_z_axis, &tf_map_input_frame);
+    run("voxel_based (without index)", loader, map, points);
+  }
+  {
+    const auto node = makeNode("benchmark_voxel_based");
+    VoxelGridStaticMapLoader loader(
+      node.get(), distance_threshold, downsize_ratio_z_axis, &tf_map_input_frame);
+    run("voxel_based", loader, map, points);
+  }
+  {
+    const auto node = makeNode("benchmark_voxel_based_approximate");
+    VoxelBasedApproximateStaticMapLoader loader(
+      node.get(), distance_threshold, downsize_ratio_z_axis, &tf_map_input_frame);
+    run("voxel_based_approximate", loader, map, points);
+  }
+  {
+    const auto node = makeNode("benchmark_voxel_distance_based");
+    VoxelDistanceBasedStaticMapLoader loader(
+      node.get(), distance_threshold, downsize_ratio_z_axis, &tf_map_input_frame);
+    run("voxel_distance_based", loader, map, points);
+  }
+  {
+    const auto node = makeNode("benchmark_distance_based");
+    DistanceBasedStaticMapLoader loader(node.get(), distance_threshold, &tf_map_input_frame);
+    run("distance_based", loader, map, points);
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,125 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/compare_map_segmentation/voxel_occupancy_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+using autoware::compare_map_segmentation::VoxelOccupancyIndex;
+using Occupancy = VoxelOccupancyIndex::Occupancy;
+
+namespace
+{
+bool is_close_brute_force(
+  const pcl::PointCloud<pcl::PointXYZ> & map, const pcl::PointXYZ & point,
+  const double distance_threshold, const double distance_threshold_z)
+{
+  for (const auto & map_point : map.points) {
+    if (
+      std::abs(static_cast<double>(map_point.x) - point.x) < distance_threshold &&
+      std::abs(static_cast<double>(map_point.y) - point.y) < distance_threshold &&
+      std::abs(static_cast<double>(map_point.z) - point.z) < distance_threshold_z) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+TEST(VoxelOccupancyIndexTest, EmptyMap)
+{
+  VoxelOccupancyIndex index(0.5, 1.0);
+  index.build(pcl::PointCloud<pcl::PointXYZ>{});
+  EXPECT_EQ(index.size(), 0u);
+  EXPECT_EQ(index.query(pcl::PointXYZ(0.0f, 0.0f, 0.0f)), Occupancy::FAR);
+}
+
+TEST(VoxelOccupancyIndexTest, SinglePoint)
+{
+  VoxelOccupancyIndex index(0.5, 0.5);
+  pcl::PointCloud<pcl::PointXYZ> map;
+  map.push_back(pcl::PointXYZ(0.1f, -0.1f, 0.0f));
+  index.build(map);
+
+  EXPECT_EQ(index.query(pcl::PointXYZ(0.1f, -0.1f, 0.0f)), Occupancy::CLOSE);
+  EXPECT_EQ(index.query(pcl::PointXYZ(2.0f, 0.0f, 0.0f)), Occupancy::FAR);
+  EXPECT_EQ(index.query(pcl::PointXYZ(0.0f, 0.0f, -3.0f)), Occupancy::FAR);
+  EXPECT_NE(index.query(pcl::PointXYZ(0.55f, -0.1f, 0.0f)), Occupancy::CLOSE);
+}
+
+TEST(VoxelOccupancyIndexTest, NonFinitePoint)
+{
+  VoxelOccupancyIndex index(0.5, 0.5);
+  pcl::PointCloud<pcl::PointXYZ> map;
+  map.push_back(pcl::PointXYZ(0.0f, 0.0f, 0.0f));
+  map.push_back(pcl::PointXYZ(NAN, 0.0f, 0.0f));
+  index.build(map);
+
+  EXPECT_EQ(index.query(pcl::PointXYZ(NAN, 0.0f, 0.0f)), Occupancy::FAR);
+  EXPECT_EQ(index.query(pcl::PointXYZ(0.0f, INFINITY, 0.0f)), Occupancy::FAR);
+}
+
+// CLOSE and FAR must agree with the exact search, only BOUNDARY is left to it
+TEST(VoxelOccupancyIndexTest, AgreeWithBruteForce)
+{
+  constexpr double distance_threshold = 0.3;
+  constexpr double distance_threshold_z = 0.6;
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> jitter_distribution(-0.1f, 0.1f);
+  std::uniform_real_distribution<float> query_distribution(0.0f, 12.0f);
+  std::uniform_real_distribution<float> height_distribution(-1.0f, 1.0f);
+
+  // a sloped ground with one point in each voxel of the threshold, as the downsampled map, far
+  // from the origin
+  const auto ground_height = [](const float x) { return 0.05f * x; };
+  pcl::PointCloud<pcl::PointXYZ> map;
+  for (int ix = 0; ix < 40; ++ix) {
+    for (int iy = 0; iy < 40; ++iy) {
+      const float x = ix * 0.3f + jitter_distribution(engine);
+      map.push_back(pcl::PointXYZ(
+        x + 1000.0f, iy * 0.3f + jitter_distribution(engine) - 1000.0f,
+        ground_height(x) + jitter_distribution(engine)));
+    }
+  }
+  VoxelOccupancyIndex index(distance_threshold, distance_threshold_z);
+  index.build(map);
+
+  int num_close = 0;
+  int num_boundary = 0;
+  for (int i = 0; i < 20000; ++i) {
+    const float x = query_distribution(engine);
+    const pcl::PointXYZ point(
+      x + 1000.0f, query_distribution(engine) - 1000.0f,
+      ground_height(x) + height_distribution(engine));
+    const bool is_close =
+      is_close_brute_force(map, point, distance_threshold, distance_threshold_z);
+    switch (index.query(point)) {
+      case Occupancy::CLOSE:
+        ASSERT_TRUE(is_close);
+        ++num_close;
+        break;
+      case Occupancy::FAR:
+        ASSERT_FALSE(is_close);
+        break;
+      case Occupancy::BOUNDARY:
+        ++num_boundary;
+        break;
+    }
+  }
+  // most of the points close to the ground should be answered without the exact search
+  EXPECT_GT(num_close, num_boundary);
+}
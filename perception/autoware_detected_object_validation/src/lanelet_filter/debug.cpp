@@ -101,7 +101,7 @@ std::optional<visualization_msgs::msg::Marker> createPolygonMarker(
 
 template <typename ObjsMsgType, typename ObjMsgType>
 void ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::publishDebugMarkers(
-  rclcpp::Time stamp, const LinearRing2d & hull, const std::vector<BoxAndLanelet> & lanelets)
+  rclcpp::Time stamp, const LinearRing2d & hull, const LaneletCandidates & lanelets)
 {
   using visualization_msgs::msg::Marker;
   using visualization_msgs::msg::MarkerArray;
@@ -121,11 +121,11 @@ void ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::publishDebugMarkers(
   if (auto marker = createPolygonMarker(hull, stamp, lanelet_range, ++marker_id, color); marker) {
     marker_array.markers.push_back(std::move(*marker));
   }
-  for (const auto & box_and_lanelet : lanelets) {
+  for (const auto & lanelet : lanelets) {
     color.r = 0.2;
     color.g = 0.5;
     color.b = 1.0;
-    auto p = box_and_lanelet.second.polygon;
+    const auto & p = lanelet->polygon;
     if (auto marker = createPolygonMarker(p, stamp, roi, ++marker_id, color); marker) {
       marker_array.markers.push_back(std::move(*marker));
     }
@@ -38,6 +38,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <string>
@@ -48,8 +49,6 @@ namespace autoware::detected_object_validation
 {
 namespace lanelet_filter
 {
-using TriangleMesh = std::vector<std::array<Eigen::Vector3d, 3>>;
-
 template <typename ObjsMsgType, typename ObjMsgType>
 ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::ObjectLaneletFilterBase(
   const std::string & node_name, const rclcpp::NodeOptions & node_options)
@@ -132,190 +131,6 @@ bool isInPolygon(
   return boost::geometry::distance(p, polygon) < radius + eps;
 }
 
-LinearRing2d expandPolygon(const LinearRing2d & polygon, double distance)
-{
-  autoware_utils::MultiPolygon2d multi_polygon;
-  bg::strategy::buffer::distance_symmetric<double> distance_strategy(distance);
-  bg::strategy::buffer::join_miter join_strategy;
-  bg::strategy::buffer::end_flat end_strategy;
-  bg::strategy::buffer::point_circle circle_strategy;
-  bg::strategy::buffer::side_straight side_strategy;
-
-  bg::buffer(
-    polygon, multi_polygon, distance_strategy, side_strategy, join_strategy, end_strategy,
-    circle_strategy);
-
-  if (multi_polygon.empty()) {
-    return polygon;
-  }
-
-  return multi_polygon.front().outer();
-}
-
-TriangleMesh createTriangleMeshFromLanelet(const lanelet::ConstLanelet & lanelet)
-{
-  TriangleMesh mesh;
-
-  const lanelet::ConstLineString3d & left = lanelet.leftBound();
-  const lanelet::ConstLineString3d & right = lanelet.rightBound();
-
-  // bounds should have same number of points
-  // if not the same, first check the first shared points then we will check it from the tail
-  // since we don't have the original set of 3 points,
-  // we will approximate the 3d mesh with this way
-  size_t n_left = left.size();
-  size_t n_right = right.size();
-  const size_t n_shared = std::min(n_left, n_right);
-  if (n_shared < 2) return mesh;
-
-  // take 2 points from each side and create 2 triangles
-  for (size_t i = 0; i < n_shared - 1; ++i) {
-    const Eigen::Vector3d a_l(left[i].x(), left[i].y(), left[i].z());
-    const Eigen::Vector3d b_l(left[i + 1].x(), left[i + 1].y(), left[i + 1].z());
-    const Eigen::Vector3d a_r(right[i].x(), right[i].y(), right[i].z());
-    const Eigen::Vector3d b_r(right[i + 1].x(), right[i + 1].y(), right[i + 1].z());
-
-    //
-    // b_l .--. b_r
-    //     |\ |
-    //     | \|
-    //     .--.
-    // a_l      a_r
-    //
-    mesh.push_back({a_l, b_l, a_r});
-    mesh.push_back({b_l, b_r, a_r});
-  }
-
-  // triangulation of the remaining unmatched parts from the tail
-  if (n_left > n_right) {
-    size_t i = n_left - 1;
-    size_t j = n_right - 1;
-    const size_t n_extra = n_left - n_right;
-
-    for (size_t k = 0; k < n_extra; ++k) {
-      // we need at least 2 points from each side
-      if (i < 1 || j < 1) break;
-
-      const Eigen::Vector3d a_l(left[i - 1].x(), left[i - 1].y(), left[i - 1].z());
-      const Eigen::Vector3d b_l(left[i].x(), left[i].y(), left[i].z());
-      const Eigen::Vector3d a_r(right[j - 1].x(), right[j - 1].y(), right[j - 1].z());
-      const Eigen::Vector3d b_r(right[j].x(), right[j].y(), right[j].z());
-
-      mesh.push_back({b_l, a_l, b_r});
-      mesh.push_back({a_l, a_r, b_r});
-
-      --i;
-      --j;
-    }
-  } else if (n_right > n_left) {
-    size_t i = n_left - 1;
-    size_t j = n_right - 1;
-    const size_t n_extra = n_right - n_left;
-
-    for (size_t k = 0; k < n_extra; ++k) {
-      if (i < 1 || j < 1) break;
-
-      const Eigen::Vector3d a_l(left[i - 1].x(), left[i - 1].y(), left[i - 1].z());
-      const Eigen::Vector3d b_l(left[i].x(), left[i].y(), left[i].z());
-      const Eigen::Vector3d a_r(right[j - 1].x(), right[j - 1].y(), right[j - 1].z());
-      const Eigen::Vector3d b_r(right[j].x(), right[j].y(), right[j].z());
-
-      mesh.push_back({b_l, a_l, b_r});
-      mesh.push_back({a_l, a_r, b_r});
-
-      --i;
-      --j;
-    }
-  }
-
-  return mesh;
-}
-
-// compute a normal vector that is pointing the Z+ from given triangle points
-Eigen::Vector3d computeFaceNormal(const std::array<Eigen::Vector3d, 3> & triangle_points)
-{
-  const Eigen::Vector3d v1 = triangle_points[1] - triangle_points[0];
-  const Eigen::Vector3d v2 = triangle_points[2] - triangle_points[0];
-  Eigen::Vector3d normal = v1.cross(v2);
-
-  // ensure the normal is pointing upward (Z+)
-  if (normal.z() < 0) {
-    normal = -normal;
-  }
-
-  return normal.normalized();
-}
-
-// checks whether a point is located above the lanelet triangle plane
-// that is closest in the perpendicular direction
-bool isPointAboveLaneletMesh(
-  const Eigen::Vector3d & point, const lanelet::ConstLanelet & lanelet, const double & offset,
-  const double & min_distance, const double & max_distance)
-{
-  const TriangleMesh mesh = createTriangleMeshFromLanelet(lanelet);
-
-  if (mesh.empty()) return true;
-
-  // for the query point
-  double query_point_min_abs_dist = std::numeric_limits<double>::infinity();
-  // for top and bottom point
-  double top_min_dist = std::numeric_limits<double>::infinity();
-  double top_min_abs_dist = std::numeric_limits<double>::infinity();
-  double bottom_min_dist = std::numeric_limits<double>::infinity();
-  double bottom_min_abs_dist = std::numeric_limits<double>::infinity();
-
-  // search the most nearest surface from the query point
-  for (const auto & tri : mesh) {
-    const Eigen::Vector3d plane_normal_vec = computeFaceNormal(tri);
-
-    // std::cos(M_PI / 3.0) -> 0.5;
-    // in some environment, or more recent c++, it can be constexpr
-    constexpr double cos_threshold = 0.5;
-    const double cos_of_normal_and_z = plane_normal_vec.dot(Eigen::Vector3d::UnitZ());
-
-    // if angle is too steep, consider as above for safety
-    if (cos_of_normal_and_z < cos_threshold) {
-      return true;
-    }
-
-    Eigen::Vector3d vec_to_point = point - tri[0];
-    double signed_dist = plane_normal_vec.dot(vec_to_point);
-
-    double abs_dist = std::abs(signed_dist);
-    if (abs_dist < query_point_min_abs_dist) {
-      query_point_min_abs_dist = abs_dist;
-
-      // check top side
-      vec_to_point = (point + offset * plane_normal_vec) - tri[0];
-      signed_dist = plane_normal_vec.dot(vec_to_point);
-
-      abs_dist = std::abs(signed_dist);
-      if (abs_dist < top_min_abs_dist) {
-        top_min_dist = signed_dist;
-        top_min_abs_dist = abs_dist;
-      }
-
-      // check bottom side
-      vec_to_point = (point - offset * plane_normal_vec) - tri[0];
-      signed_dist = plane_normal_vec.dot(vec_to_point);
-
-      abs_dist = std::abs(signed_dist);
-      if (abs_dist < bottom_min_abs_dist) {
-        bottom_min_dist = signed_dist;
-        bottom_min_abs_dist = abs_dist;
-      }
-    }
-  }
-
-  // if at least one point is within the range, we consider it to be in the range
-  if (
-    (min_distance <= top_min_dist && top_min_dist <= max_distance) ||
-    (min_distance <= bottom_min_dist && bottom_min_dist <= max_distance))
-    return true;
-  else
-    return false;
-}
-
 template <typename ObjsMsgType, typename ObjMsgType>
 void ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::mapCallback(
   const autoware_map_msgs::msg::LaneletMapBin::ConstSharedPtr map_msg)
@@ -323,6 +138,7 @@ void ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::mapCallback(
   lanelet_frame_id_ = map_msg->header.frame_id;
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
+  lanelet_index_ = LaneletIndex(*lanelet_map_ptr_, filter_settings_.lanelet_extra_margin);
 }
 
 template <typename ObjsMsgType, typename ObjMsgType>
@@ -350,26 +166,34 @@ void ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::objectCallback(
   }
 
   if (!transformed_objects.objects.empty()) {
-    // calculate convex hull
-    const auto convex_hull = getConvexHull(transformed_objects);
-
-    // get intersected lanelets
-    std::vector<BoxAndLanelet> intersected_lanelets_with_bbox = getIntersectedLanelets(convex_hull);
-
-    // create R-Tree with intersected_lanelets for fast search
-    bgi::rtree<BoxAndLanelet, RtreeAlgo> local_rtree;
-    for (const auto & bbox_and_lanelet : intersected_lanelets_with_bbox) {
-      local_rtree.insert(bbox_and_lanelet);
+    if (filter_settings_.debug) {
+      // calculate convex hull and show the lanelets around the objects
+      const auto convex_hull = getConvexHull(transformed_objects);
+      Box bbox_of_convex_hull;
+      bg::envelope(convex_hull, bbox_of_convex_hull);
+      LaneletCandidates intersected_lanelets;
+      lanelet_index_.query(bbox_of_convex_hull, intersected_lanelets);
+      intersected_lanelets.erase(
+        std::remove_if(
+          intersected_lanelets.begin(), intersected_lanelets.end(),
+          [&convex_hull](const IndexedLanelet * lanelet) {
+            return !bg::intersects(convex_hull, lanelet->polygon);
+          }),
+        intersected_lanelets.end());
+      publishDebugMarkers(input_msg->header.stamp, convex_hull, intersected_lanelets);
     }
 
-    if (filter_settings_.debug) {
-      publishDebugMarkers(input_msg->header.stamp, convex_hull, intersected_lanelets_with_bbox);
+    // filtering process, the objects are checked in parallel and kept in the input order
+    const auto & objects = transformed_objects.objects;
+    std::vector<std::uint8_t> filter_pass(objects.size(), 0);
+#pragma omp parallel for schedule(dynamic)
+    for (size_t index = 0; index < objects.size(); ++index) {
+      filter_pass[index] = filterObject(objects[index]) ? 1 : 0;
     }
-    // filtering process
-    for (size_t index = 0; index < transformed_objects.objects.size(); ++index) {
-      const auto & transformed_object = transformed_objects.objects.at(index);
-      const auto & input_object = input_msg->objects.at(index);
-      filterObject(transformed_object, input_object, local_rtree, output_object_msg);
+    for (size_t index = 0; index < objects.size(); ++index) {
+      if (filter_pass[index]) {
+        output_object_msg.objects.emplace_back(input_msg->objects.at(index));
+      }
     }
   }
 
@@ -390,71 +214,64 @@ void ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::objectCallback(
 
 template <typename ObjsMsgType, typename ObjMsgType>
 bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::filterObject(
-  const ObjMsgType & transformed_object, const ObjMsgType & input_object,
-  const bgi::rtree<BoxAndLanelet, RtreeAlgo> & local_rtree, ObjsMsgType & output_object_msg)
+  const ObjMsgType & transformed_object) const
 {
   const auto & label = transformed_object.classification.front().label;
-  if (filter_target_.isTarget(label)) {
-    // no tree, then no intersection
-    if (local_rtree.empty()) {
-      return false;
-    }
+  if (!filter_target_.isTarget(label)) {
+    return true;
+  }
 
-    // create a 2D polygon from the object for querying
-    Polygon2d object_polygon;
-    if (utils::hasBoundingBox(transformed_object)) {
-      const auto footprint = setFootprint(transformed_object);
-      for (const auto & point : footprint.points) {
-        const geometry_msgs::msg::Point32 point_transformed = autoware_utils::transform_point(
-          point, transformed_object.kinematics.pose_with_covariance.pose);
-        object_polygon.outer().emplace_back(point_transformed.x, point_transformed.y);
-      }
-      object_polygon.outer().push_back(object_polygon.outer().front());
-    } else {
-      object_polygon = getConvexHullFromObjectFootprint(transformed_object);
-    }
+  // no lanelet, then no intersection
+  if (lanelet_index_.empty()) {
+    return false;
+  }
 
-    // create a bounding box from polygon for searching the local R-tree
-    bg::model::box<bg::model::d2::point_xy<double>> bbox_of_convex_hull;
-    bg::envelope(object_polygon, bbox_of_convex_hull);
-    std::vector<BoxAndLanelet> candidates;
-    // only use the lanelets that intersect with the object's bounding box
-    local_rtree.query(bgi::intersects(bbox_of_convex_hull), std::back_inserter(candidates));
-
-    bool filter_pass = true;
-    // 1. is polygon overlap with road lanelets or shoulder lanelets
-    if (filter_settings_.lanelet_xy_overlap_filter) {
-      filter_pass = isObjectOverlapLanelets(transformed_object, object_polygon, candidates);
+  // create a 2D polygon from the object for querying
+  Polygon2d object_polygon;
+  if (utils::hasBoundingBox(transformed_object)) {
+    const auto footprint = setFootprint(transformed_object);
+    for (const auto & point : footprint.points) {
+      const geometry_msgs::msg::Point32 point_transformed = autoware_utils::transform_point(
+        point, transformed_object.kinematics.pose_with_covariance.pose);
+      object_polygon.outer().emplace_back(point_transformed.x, point_transformed.y);
     }
+    object_polygon.outer().push_back(object_polygon.outer().front());
+  } else {
+    object_polygon = getConvexHullFromObjectFootprint(transformed_object);
+  }
 
-    // 2. check if objects velocity is the same with the lanelet direction
-    const bool orientation_not_available =
-      transformed_object.kinematics.orientation_availability ==
-      autoware_perception_msgs::msg::TrackedObjectKinematics::UNAVAILABLE;
-    if (filter_settings_.lanelet_direction_filter && !orientation_not_available && filter_pass) {
-      filter_pass = isSameDirectionWithLanelets(transformed_object, candidates);
-    }
+  // create a bounding box from polygon for searching the lanelet index
+  Box bbox_of_convex_hull;
+  bg::envelope(object_polygon, bbox_of_convex_hull);
+  LaneletCandidates candidates;
+  // only use the lanelets that intersect with the object's bounding box
+  lanelet_index_.query(bbox_of_convex_hull, candidates);
+
+  bool filter_pass = true;
+  // 1. is polygon overlap with road lanelets or shoulder lanelets
+  if (filter_settings_.lanelet_xy_overlap_filter) {
+    filter_pass = isObjectOverlapLanelets(transformed_object, object_polygon, candidates);
+  }
 
-    // 3. check if the object is above the lanelets
-    if (filter_settings_.lanelet_object_elevation_filter && filter_pass) {
-      filter_pass = isObjectAboveLanelet(transformed_object, candidates);
-    }
+  // 2. check if objects velocity is the same with the lanelet direction
+  const bool orientation_not_available =
+    transformed_object.kinematics.orientation_availability ==
+    autoware_perception_msgs::msg::TrackedObjectKinematics::UNAVAILABLE;
+  if (filter_settings_.lanelet_direction_filter && !orientation_not_available && filter_pass) {
+    filter_pass = isSameDirectionWithLanelets(transformed_object, candidates);
+  }
 
-    // push back to output object
-    if (filter_pass) {
-      output_object_msg.objects.emplace_back(input_object);
-      return true;
-    }
-  } else {
-    output_object_msg.objects.emplace_back(input_object);
-    return true;
+  // 3. check if the object is above the lanelets
+  if (filter_settings_.lanelet_object_elevation_filter && filter_pass) {
+    filter_pass = isObjectAboveLanelet(transformed_object, candidates);
   }
-  return false;
+
+  return filter_pass;
 }
 
 template <typename ObjsMsgType, typename ObjMsgType>
 geometry_msgs::msg::Polygon ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::setFootprint(
-  const ObjMsgType & detected_object)
+  const ObjMsgType & detected_object) const
 {
   geometry_msgs::msg::Polygon footprint;
   if (detected_object.shape.type == autoware_perception_msgs::msg::Shape::BOUNDING_BOX) {
@@ -480,7 +297,7 @@ geometry_msgs::msg::Polygon ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::se
 
 template <typename ObjsMsgType, typename ObjMsgType>
 LinearRing2d ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::getConvexHull(
-  const ObjsMsgType & detected_objects)
+  const ObjsMsgType & detected_objects) const
 {
   MultiPoint2d candidate_points;
   for (const auto & object : detected_objects.objects) {
@@ -501,7 +318,7 @@ LinearRing2d ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::getConvexHull(
 
 template <typename ObjsMsgType, typename ObjMsgType>
 Polygon2d ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::getConvexHullFromObjectFootprint(
-  const ObjMsgType & object)
+  const ObjMsgType & object) const
 {
   MultiPoint2d candidate_points;
   const auto & pos = object.kinematics.pose_with_covariance.pose.position;
@@ -517,73 +334,10 @@ Polygon2d ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::getConvexHullFromObj
   return convex_hull;
 }
 
-// fetch the intersected candidate lanelets with bounding box and then
-// check the intersections among the lanelets and the convex hull
-template <typename ObjsMsgType, typename ObjMsgType>
-std::vector<BoxAndLanelet> ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::getIntersectedLanelets(
-  const LinearRing2d & convex_hull)
-{
-  std::vector<BoxAndLanelet> intersected_lanelets_with_bbox;
-
-  // convert convex_hull to a 2D bounding box for searching in the LaneletMap
-  bg::model::box<bg::model::d2::point_xy<double>> bbox_of_convex_hull;
-  bg::envelope(convex_hull, bbox_of_convex_hull);
-  const lanelet::BoundingBox2d bbox2d(
-    lanelet::BasicPoint2d(
-      bg::get<bg::min_corner, 0>(bbox_of_convex_hull),
-      bg::get<bg::min_corner, 1>(bbox_of_convex_hull)),
-    lanelet::BasicPoint2d(
-      bg::get<bg::max_corner, 0>(bbox_of_convex_hull),
-      bg::get<bg::max_corner, 1>(bbox_of_convex_hull)));
-
-  const lanelet::Lanelets candidate_lanelets = lanelet_map_ptr_->laneletLayer.search(bbox2d);
-  for (const auto & lanelet : candidate_lanelets) {
-    // only check the road lanelets and road shoulder lanelets
-    if (
-      lanelet.hasAttribute(lanelet::AttributeName::Subtype) &&
-      (lanelet.attribute(lanelet::AttributeName::Subtype).value() ==
-         lanelet::AttributeValueString::Road ||
-       lanelet.attribute(lanelet::AttributeName::Subtype).value() == "road_shoulder")) {
-      if (bg::intersects(convex_hull, lanelet.polygon2d().basicPolygon())) {
-        // create bbox using boost for making the R-tree in later phase
-        auto polygon = getPolygon(lanelet);
-        Box boost_bbox;
-        bg::envelope(polygon, boost_bbox);
-
-        intersected_lanelets_with_bbox.emplace_back(
-          std::make_pair(boost_bbox, PolygonAndLanelet{polygon, lanelet}));
-      }
-    }
-  }
-
-  return intersected_lanelets_with_bbox;
-}
-
-template <typename ObjsMsgType, typename ObjMsgType>
-lanelet::BasicPolygon2d ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::getPolygon(
-  const lanelet::ConstLanelet & lanelet)
-{
-  if (filter_settings_.lanelet_extra_margin <= 0) {
-    return lanelet.polygon2d().basicPolygon();
-  }
-
-  auto lanelet_polygon = lanelet.polygon2d().basicPolygon();
-  Polygon2d polygon;
-  bg::assign_points(polygon, lanelet_polygon);
-
-  bg::correct(polygon);
-  auto polygon_result = expandPolygon(polygon.outer(), filter_settings_.lanelet_extra_margin);
-  lanelet::BasicPolygon2d result;
-
-  bg::assign_points(result, polygon_result);
-
-  return result;
-}
-
 template <typename ObjsMsgType, typename ObjMsgType>
 bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isObjectOverlapLanelets(
   const ObjMsgType & object, const Polygon2d & polygon,
-  const std::vector<BoxAndLanelet> & lanelet_candidates)
+  const LaneletCandidates & lanelet_candidates) const
 {
   // if object has bounding box, use polygon overlap
   if (utils::hasBoundingBox(object)) {
@@ -594,7 +348,7 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isObjectOverlapLanelets(
         autoware_utils::transform_point(point, object.kinematics.pose_with_covariance.pose);
 
       for (const auto & candidate : lanelet_candidates) {
-        if (isInPolygon(point_transformed.x, point_transformed.y, candidate.second.polygon, 0.0)) {
+        if (isInPolygon(point_transformed.x, point_transformed.y, candidate->polygon, 0.0)) {
           return true;
         }
       }
@@ -605,10 +359,10 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isObjectOverlapLanelets(
 
 template <typename ObjsMsgType, typename ObjMsgType>
 bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isPolygonOverlapLanelets(
-  const Polygon2d & polygon, const std::vector<BoxAndLanelet> & lanelet_candidates)
+  const Polygon2d & polygon, const LaneletCandidates & lanelet_candidates) const
 {
-  for (const auto & box_and_lanelet : lanelet_candidates) {
-    if (!bg::disjoint(polygon, box_and_lanelet.second.polygon)) {
+  for (const auto & candidate : lanelet_candidates) {
+    if (!bg::disjoint(polygon, candidate->polygon)) {
       return true;
     }
   }
@@ -618,7 +372,7 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isPolygonOverlapLanelets(
 
 template <typename ObjsMsgType, typename ObjMsgType>
 bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isSameDirectionWithLanelets(
-  const ObjMsgType & object, const std::vector<BoxAndLanelet> & lanelet_candidates)
+  const ObjMsgType & object, const LaneletCandidates & lanelet_candidates) const
 {
   const double object_yaw = tf2::getYaw(object.kinematics.pose_with_covariance.pose.orientation);
   const double object_velocity_norm = std::hypot(
@@ -633,15 +387,15 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isSameDirectionWithLanele
     return true;
   }
 
-  for (const auto & box_and_lanelet : lanelet_candidates) {
+  for (const auto & candidate : lanelet_candidates) {
     const bool is_in_lanelet =
-      isInPolygon(object.kinematics.pose_with_covariance.pose, box_and_lanelet.second.polygon, 0.0);
+      isInPolygon(object.kinematics.pose_with_covariance.pose, candidate->polygon, 0.0);
     if (!is_in_lanelet) {
       continue;
     }
 
     const double lane_yaw = lanelet::utils::getLaneletAngle(
-      box_and_lanelet.second.lanelet, object.kinematics.pose_with_covariance.pose.position);
+      candidate->lanelet, object.kinematics.pose_with_covariance.pose.position);
     const double delta_yaw = object_velocity_yaw - lane_yaw;
     const double normalized_delta_yaw = autoware_utils::normalize_radian(delta_yaw);
     const double abs_norm_delta_yaw = std::fabs(normalized_delta_yaw);
@@ -656,7 +410,7 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isSameDirectionWithLanele
 
 template <typename ObjsMsgType, typename ObjMsgType>
 bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isObjectAboveLanelet(
-  const ObjMsgType & object, const std::vector<BoxAndLanelet> & lanelet_candidates)
+  const ObjMsgType & object, const LaneletCandidates & lanelet_candidates) const
 {
   // assuming the positions are already the center of the cluster (convex hull)
   // for an exact calculation of the center from the points,
@@ -668,13 +422,12 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isObjectAboveLanelet(
   const Eigen::Vector3d centroid(cx, cy, cz);
   const double half_dim_z = object.shape.dimensions.z * 0.5;
 
-  lanelet::ConstLanelet nearest_lanelet;
+  const IndexedLanelet * nearest_lanelet = nullptr;
   double closest_lanelet_z_dist = std::numeric_limits<double>::infinity();
 
   // search for the nearest lanelet along the z-axis in case roads are layered
   for (const auto & candidate_lanelet : lanelet_candidates) {
-    const lanelet::ConstLanelet llt = candidate_lanelet.second.lanelet;
-    const lanelet::ConstLineString3d line = llt.leftBound();
+    const lanelet::ConstLineString3d line = candidate_lanelet->lanelet.leftBound();
     if (line.empty()) continue;
 
     // assuming the roads have enough height difference to distinguish each other
@@ -684,12 +437,17 @@ bool ObjectLaneletFilterBase<ObjsMsgType, ObjMsgType>::isObjectAboveLanelet(
     // use the closest lanelet in z axis
     if (dist_z < closest_lanelet_z_dist) {
       closest_lanelet_z_dist = dist_z;
-      nearest_lanelet = llt;
+      nearest_lanelet = candidate_lanelet;
     }
   }
 
+  // no lanelet to compare with, consider as above as with an empty mesh
+  if (!nearest_lanelet) {
+    return true;
+  }
+
   return isPointAboveLaneletMesh(
-    centroid, nearest_lanelet, half_dim_z, filter_settings_.min_elevation_threshold,
+    centroid, nearest_lanelet->mesh, half_dim_z, filter_settings_.min_elevation_threshold,
     filter_settings_.max_elevation_threshold);
 }
 
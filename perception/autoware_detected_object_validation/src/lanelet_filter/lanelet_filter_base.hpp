@@ -16,6 +16,7 @@
 #define LANELET_FILTER__LANELET_FILTER_BASE_HPP_
 
 #include "autoware/detected_object_validation/utils/utils.hpp"
+#include "lanelet_index.hpp"
 #include "autoware_lanelet2_extension/utility/utilities.hpp"
 #include "autoware_utils/geometry/geometry.hpp"
 #include "autoware_utils/ros/debug_publisher.hpp"
@@ -27,8 +28,6 @@
 #include "autoware_map_msgs/msg/lanelet_map_bin.hpp"
 #include <visualization_msgs/msg/marker_array.hpp>
 
-#include <boost/geometry/index/rtree.hpp>
-
 #include <lanelet2_core/Forward.h>
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <tf2_ros/buffer.h>
@@ -44,22 +43,9 @@ namespace autoware::detected_object_validation
 {
 namespace lanelet_filter
 {
-using autoware_utils::LinearRing2d;
 using autoware_utils::MultiPoint2d;
 using autoware_utils::Polygon2d;
-
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-using Point2d = bg::model::point<double, 2, bg::cs::cartesian>;
-using Box = boost::geometry::model::box<Point2d>;
-
-struct PolygonAndLanelet
-{
-  lanelet::BasicPolygon2d polygon;
-  lanelet::ConstLanelet lanelet;
-};
-using BoxAndLanelet = std::pair<Box, PolygonAndLanelet>;
-using RtreeAlgo = bgi::rstar<16>;
+using LaneletCandidates = std::vector<const IndexedLanelet *>;
 
 template <typename ObjsMsgType, typename ObjMsgType>
 class ObjectLaneletFilterBase : public rclcpp::Node
@@ -73,7 +59,7 @@ private:
   void mapCallback(const autoware_map_msgs::msg::LaneletMapBin::ConstSharedPtr);
 
   void publishDebugMarkers(
-    rclcpp::Time stamp, const LinearRing2d & hull, const std::vector<BoxAndLanelet> & lanelets);
+    rclcpp::Time stamp, const LinearRing2d & hull, const LaneletCandidates & lanelets);
 
   typename rclcpp::Publisher<ObjsMsgType>::SharedPtr object_pub_;
   rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr viz_pub_;
@@ -85,6 +71,8 @@ private:
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   std::string lanelet_frame_id_;
+  // road and road shoulder lanelets of the map, built when the map is received
+  LaneletIndex lanelet_index_;
 
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
@@ -107,25 +95,22 @@ private:
     bool debug;
   } filter_settings_;
 
-  bool filterObject(
-    const ObjMsgType & transformed_object, const ObjMsgType & input_object,
-    const bg::index::rtree<BoxAndLanelet, RtreeAlgo> & local_rtree,
-    ObjsMsgType & output_object_msg);
-  LinearRing2d getConvexHull(const ObjsMsgType &);
-  Polygon2d getConvexHullFromObjectFootprint(const ObjMsgType & object);
-  std::vector<BoxAndLanelet> getIntersectedLanelets(const LinearRing2d &);
+  // the checks of an object only read the settings and the lanelet index, so that the objects
+  // can be filtered in parallel
+  bool filterObject(const ObjMsgType & transformed_object) const;
+  LinearRing2d getConvexHull(const ObjsMsgType &) const;
+  Polygon2d getConvexHullFromObjectFootprint(const ObjMsgType & object) const;
   bool isObjectOverlapLanelets(
     const ObjMsgType & object, const Polygon2d & polygon,
-    const std::vector<BoxAndLanelet> & lanelet_candidates);
+    const LaneletCandidates & lanelet_candidates) const;
   bool isPolygonOverlapLanelets(
-    const Polygon2d & polygon, const std::vector<BoxAndLanelet> & lanelet_candidates);
+    const Polygon2d & polygon, const LaneletCandidates & lanelet_candidates) const;
   bool isSameDirectionWithLanelets(
-    const ObjMsgType & object, const std::vector<BoxAndLanelet> & lanelet_candidates);
+    const ObjMsgType & object, const LaneletCandidates & lanelet_candidates) const;
   bool isObjectAboveLanelet(
-    const ObjMsgType & object, const std::vector<BoxAndLanelet> & lanelet_candidates);
-  geometry_msgs::msg::Polygon setFootprint(const ObjMsgType &);
+    const ObjMsgType & object, const LaneletCandidates & lanelet_candidates) const;
+  geometry_msgs::msg::Polygon setFootprint(const ObjMsgType &) const;
 
-  lanelet::BasicPolygon2d getPolygon(const lanelet::ConstLanelet & lanelet);
   std::unique_ptr<autoware_utils::PublishedTimePublisher> published_time_publisher_;
 };
 
@@ -0,0 +1,301 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lanelet_index.hpp"
+
+#include <boost/geometry/algorithms/buffer.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/geometry/Lanelet.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace autoware::detected_object_validation
+{
+namespace lanelet_filter
+{
+namespace
+{
+bool isRoadOrShoulder(const lanelet::ConstLanelet & lanelet)
+{
+  if (!lanelet.hasAttribute(lanelet::AttributeName::Subtype)) {
+    return false;
+  }
+  const auto & subtype = lanelet.attribute(lanelet::AttributeName::Subtype).value();
+  return subtype == lanelet::AttributeValueString::Road || subtype == "road_shoulder";
+}
+
+TriangleMesh createTriangleMeshFromLanelet(const lanelet::ConstLanelet & lanelet)
+{
+  TriangleMesh mesh;
+
+  const lanelet::ConstLineString3d & left = lanelet.leftBound();
+  const lanelet::ConstLineString3d & right = lanelet.rightBound();
+
+  // bounds should have same number of points
+  // if not the same, first check the first shared points then we will check it from the tail
+  // since we don't have the original set of 3 points,
+  // we will approximate the 3d mesh with this way
+  size_t n_left = left.size();
+  size_t n_right = right.size();
+  const size_t n_shared = std::min(n_left, n_right);
+  if (n_shared < 2) return mesh;
+
+  // take 2 points from each side and create 2 triangles
+  for (size_t i = 0; i < n_shared - 1; ++i) {
+    const Eigen::Vector3d a_l(left[i].x(), left[i].y(), left[i].z());
+    const Eigen::Vector3d b_l(left[i + 1].x(), left[i + 1].y(), left[i + 1].z());
+    const Eigen::Vector3d a_r(right[i].x(), right[i].y(), right[i].z());
+    const Eigen::Vector3d b_r(right[i + 1].x(), right[i + 1].y(), right[i + 1].z());
+
+    //
+    // b_l .--. b_r
+    //     |\ |
+    //     | \|
+    //     .--.
+    // a_l      a_r
+    //
+    mesh.push_back({a_l, b_l, a_r});
+    mesh.push_back({b_l, b_r, a_r});
+  }
+
+  // triangulation of the remaining unmatched parts from the tail
+  if (n_left > n_right) {
+    size_t i = n_left - 1;
+    size_t j = n_right - 1;
+    const size_t n_extra = n_left - n_right;
+
+    for (size_t k = 0; k < n_extra; ++k) {
+      // we need at least 2 points from each side
+      if (i < 1 || j < 1) break;
+
+      const Eigen::Vector3d a_l(left[i - 1].x(), left[i - 1].y(), left[i - 1].z());
+      const Eigen::Vector3d b_l(left[i].x(), left[i].y(), left[i].z());
+      const Eigen::Vector3d a_r(right[j - 1].x(), right[j - 1].y(), right[j - 1].z());
+      const Eigen::Vector3d b_r(right[j].x(), right[j].y(), right[j].z());
+
+      mesh.push_back({b_l, a_l, b_r});
+      mesh.push_back({a_l, a_r, b_r});
+
+      --i;
+      --j;
+    }
+  } else if (n_right > n_left) {
+    size_t i = n_left - 1;
+    size_t j = n_right - 1;
+    const size_t n_extra = n_right - n_left;
+
+    for (size_t k = 0; k < n_extra; ++k) {
+      if (i < 1 || j < 1) break;
+
+      const Eigen::Vector3d a_l(left[i - 1].x(), left[i - 1].y(), left[i - 1].z());
+      const Eigen::Vector3d b_l(left[i].x(), left[i].y(), left[i].z());
+      const Eigen::Vector3d a_r(right[j - 1].x(), right[j - 1].y(), right[j - 1].z());
+      const Eigen::Vector3d b_r(right[j].x(), right[j].y(), right[j].z());
+
+      mesh.push_back({b_l, a_l, b_r});
+      mesh.push_back({a_l, a_r, b_r});
+
+      --i;
+      --j;
+    }
+  }
+
+  return mesh;
+}
+
+// compute a normal vector that is pointing the Z+ from given triangle points
+Eigen::Vector3d computeFaceNormal(const std::array<Eigen::Vector3d, 3> & triangle_points)
+{
+  const Eigen::Vector3d v1 = triangle_points[1] - triangle_points[0];
+  const Eigen::Vector3d v2 = triangle_points[2] - triangle_points[0];
+  Eigen::Vector3d normal = v1.cross(v2);
+
+  // ensure the normal is pointing upward (Z+)
+  if (normal.z() < 0) {
+    normal = -normal;
+  }
+
+  return normal.normalized();
+}
+}  // namespace
+
+LaneletIndex::LaneletIndex(const lanelet::LaneletMap & lanelet_map, const double extra_margin)
+{
+  std::vector<std::pair<Box, std::size_t>> boxes;
+  for (const auto & lanelet : lanelet_map.laneletLayer) {
+    // only check the road lanelets and road shoulder lanelets
+    if (!isRoadOrShoulder(lanelet)) {
+      continue;
+    }
+    // the centerline is computed and cached by the lanelet on the first access, compute it here
+    // so that the direction filter only reads it from the filtering threads
+    static_cast<void>(lanelet.centerline());
+
+    IndexedLanelet indexed_lanelet;
+    indexed_lanelet.lanelet = lanelet;
+    indexed_lanelet.polygon = getExpandedPolygon(lanelet, extra_margin);
+    bg::envelope(indexed_lanelet.polygon, indexed_lanelet.box);
+    indexed_lanelet.mesh = createLaneletMesh(lanelet);
+
+    boxes.emplace_back(indexed_lanelet.box, lanelets_.size());
+    lanelets_.push_back(std::move(indexed_lanelet));
+  }
+  // bulk loading gives a better tree than inserting the lanelets one by one
+  rtree_ = bgi::rtree<std::pair<Box, std::size_t>, RtreeAlgo>(boxes.begin(), boxes.end());
+}
+
+void LaneletIndex::query(const Box & box, std::vector<const IndexedLanelet *> & result) const
+{
+  result.clear();
+  if (rtree_.empty()) {
+    return;
+  }
+  std::vector<std::pair<Box, std::size_t>> hits;
+  rtree_.query(bgi::intersects(box), std::back_inserter(hits));
+  // the order of the tree depends on how it was built, keep the order of the map instead
+  std::sort(hits.begin(), hits.end(), [](const auto & a, const auto & b) {
+    return a.second < b.second;
+  });
+  result.reserve(hits.size());
+  for (const auto & hit : hits) {
+    result.push_back(&lanelets_[hit.second]);
+  }
+}
+
+LinearRing2d expandPolygon(const LinearRing2d & polygon, double distance)
+{
+  autoware_utils::MultiPolygon2d multi_polygon;
+  bg::strategy::buffer::distance_symmetric<double> distance_strategy(distance);
+  bg::strategy::buffer::join_miter join_strategy;
+  bg::strategy::buffer::end_flat end_strategy;
+  bg::strategy::buffer::point_circle circle_strategy;
+  bg::strategy::buffer::side_straight side_strategy;
+
+  bg::buffer(
+    polygon, multi_polygon, distance_strategy, side_strategy, join_strategy, end_strategy,
+    circle_strategy);
+
+  if (multi_polygon.empty()) {
+    return polygon;
+  }
+
+  return multi_polygon.front().outer();
+}
+
+lanelet::BasicPolygon2d getExpandedPolygon(
+  const lanelet::ConstLanelet & lanelet, const double extra_margin)
+{
+  if (extra_margin <= 0) {
+    return lanelet.polygon2d().basicPolygon();
+  }
+
+  auto lanelet_polygon = lanelet.polygon2d().basicPolygon();
+  autoware_utils::Polygon2d polygon;
+  bg::assign_points(polygon, lanelet_polygon);
+
+  bg::correct(polygon);
+  auto polygon_result = expandPolygon(polygon.outer(), extra_margin);
+  lanelet::BasicPolygon2d result;
+
+  bg::assign_points(result, polygon_result);
+
+  return result;
+}
+
+LaneletMesh createLaneletMesh(const lanelet::ConstLanelet & lanelet)
+{
+  LaneletMesh mesh;
+  mesh.triangles = createTriangleMeshFromLanelet(lanelet);
+  mesh.normals.reserve(mesh.triangles.size());
+
+  // std::cos(M_PI / 3.0) -> 0.5;
+  // in some environment, or more recent c++, it can be constexpr
+  constexpr double cos_threshold = 0.5;
+  for (const auto & tri : mesh.triangles) {
+    const Eigen::Vector3d plane_normal_vec = computeFaceNormal(tri);
+    const double cos_of_normal_and_z = plane_normal_vec.dot(Eigen::Vector3d::UnitZ());
+    // if angle is too steep, consider as above for safety
+    if (cos_of_normal_and_z < cos_threshold) {
+      mesh.has_steep_triangle = true;
+    }
+    mesh.normals.push_back(plane_normal_vec);
+  }
+  return mesh;
+}
+
+bool isPointAboveLaneletMesh(
+  const Eigen::Vector3d & point, const LaneletMesh & mesh, const double & offset,
+  const double & min_distance, const double & max_distance)
+{
+  if (mesh.triangles.empty() || mesh.has_steep_triangle) return true;
+
+  // for the query point
+  double query_point_min_abs_dist = std::numeric_limits<double>::infinity();
+  // for top and bottom point
+  double top_min_dist = std::numeric_limits<double>::infinity();
+  double top_min_abs_dist = std::numeric_limits<double>::infinity();
+  double bottom_min_dist = std::numeric_limits<double>::infinity();
+  double bottom_min_abs_dist = std::numeric_limits<double>::infinity();
+
+  // search the most nearest surface from the query point
+  for (size_t i = 0; i < mesh.triangles.size(); ++i) {
+    const auto & tri = mesh.triangles[i];
+    const Eigen::Vector3d & plane_normal_vec = mesh.normals[i];
+
+    Eigen::Vector3d vec_to_point = point - tri[0];
+    double signed_dist = plane_normal_vec.dot(vec_to_point);
+
+    double abs_dist = std::abs(signed_dist);
+    if (abs_dist < query_point_min_abs_dist) {
+      query_point_min_abs_dist = abs_dist;
+
+      // check top side
+      vec_to_point = (point + offset * plane_normal_vec) - tri[0];
+      signed_dist = plane_normal_vec.dot(vec_to_point);
+
+      abs_dist = std::abs(signed_dist);
+      if (abs_dist < top_min_abs_dist) {
+        top_min_dist = signed_dist;
+        top_min_abs_dist = abs_dist;
+      }
+
+      // check bottom side
+      vec_to_point = (point - offset * plane_normal_vec) - tri[0];
+      signed_dist = plane_normal_vec.dot(vec_to_point);
+
+      abs_dist = std::abs(signed_dist);
+      if (abs_dist < bottom_min_abs_dist) {
+        bottom_min_dist = signed_dist;
+        bottom_min_abs_dist = abs_dist;
+      }
+    }
+  }
+
+  // if at least one point is within the range, we consider it to be in the range
+  if (
+    (min_distance <= top_min_dist && top_min_dist <= max_distance) ||
+    (min_distance <= bottom_min_dist && bottom_min_dist <= max_distance))
+    return true;
+  else
+    return false;
+}
+
+}  // namespace lanelet_filter
+}  // namespace autoware::detected_object_validation
@@ -0,0 +1,109 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LANELET_FILTER__LANELET_INDEX_HPP_
+#define LANELET_FILTER__LANELET_INDEX_HPP_
+
+#include "autoware_utils/geometry/boost_geometry.hpp"
+
+#include <Eigen/Core>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace autoware::detected_object_validation
+{
+namespace lanelet_filter
+{
+using autoware_utils::LinearRing2d;
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+using Point2d = bg::model::point<double, 2, bg::cs::cartesian>;
+using Box = boost::geometry::model::box<Point2d>;
+using RtreeAlgo = bgi::rstar<16>;
+
+using TriangleMesh = std::vector<std::array<Eigen::Vector3d, 3>>;
+
+/** \brief Triangles between the bounds of a lanelet, used by the elevation filter */
+struct LaneletMesh
+{
+  TriangleMesh triangles;
+  // normals of the triangles pointing to Z+
+  std::vector<Eigen::Vector3d> normals;
+  // a triangle is too steep to tell above from below, then every point is considered as above
+  bool has_steep_triangle = false;
+};
+
+/** \brief Road or road shoulder lanelet with the geometry the filters check the objects with */
+struct IndexedLanelet
+{
+  lanelet::ConstLanelet lanelet;
+  // lanelet polygon expanded by the extra margin
+  lanelet::BasicPolygon2d polygon;
+  // envelope of the expanded polygon
+  Box box;
+  LaneletMesh mesh;
+};
+
+/**
+ * \brief Spatial index of the road and road shoulder lanelets of a map.
+ *
+ * The index is built once when the map is received, so that the objects only query the R-tree
+ * instead of searching the map, expanding the lanelet polygons and triangulating the lanelets for
+ * every message. The index is not modified after construction, so it can be queried from several
+ * threads at once.
+ */
+class LaneletIndex
+{
+public:
+  LaneletIndex() = default;
+  LaneletIndex(const lanelet::LaneletMap & lanelet_map, const double extra_margin);
+
+  bool empty() const { return lanelets_.empty(); }
+  std::size_t size() const { return lanelets_.size(); }
+  const std::vector<IndexedLanelet> & lanelets() const { return lanelets_; }
+
+  /** \brief Get the lanelets whose box intersects with the given box, in the order of the map */
+  void query(const Box & box, std::vector<const IndexedLanelet *> & result) const;
+
+private:
+  std::vector<IndexedLanelet> lanelets_;
+  bgi::rtree<std::pair<Box, std::size_t>, RtreeAlgo> rtree_;
+};
+
+LinearRing2d expandPolygon(const LinearRing2d & polygon, double distance);
+
+lanelet::BasicPolygon2d getExpandedPolygon(
+  const lanelet::ConstLanelet & lanelet, const double extra_margin);
+
+LaneletMesh createLaneletMesh(const lanelet::ConstLanelet & lanelet);
+
+// checks whether a point is located above the lanelet triangle plane
+// that is closest in the perpendicular direction
+bool isPointAboveLaneletMesh(
+  const Eigen::Vector3d & point, const LaneletMesh & mesh, const double & offset,
+  const double & min_distance, const double & max_distance);
+
+}  // namespace lanelet_filter
+}  // namespace autoware::detected_object_validation
+
+#endif  // LANELET_FILTER__LANELET_INDEX_HPP_
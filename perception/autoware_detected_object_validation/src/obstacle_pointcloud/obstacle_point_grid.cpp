@@ -0,0 +1,109 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_point_grid.hpp"
+
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <limits>
+
+namespace autoware::detected_object_validation
+{
+namespace obstacle_pointcloud
+{
+
+ObstaclePointGrid::ObstaclePointGrid(const double cell_size)
+: default_cell_size_(cell_size), cell_size_(cell_size), inverse_cell_size_(1.0 / cell_size)
+{
+}
+
+void ObstaclePointGrid::build(const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  points_.clear();
+  cell_begin_.clear();
+  input_points_.clear();
+  num_cells_x_ = 0;
+  num_cells_y_ = 0;
+
+  const std::size_t num_points = static_cast<std::size_t>(cloud.width) * cloud.height;
+  if (num_points == 0) {
+    return;
+  }
+
+  // read the points and their bounds in one pass over the message
+  input_points_.reserve(num_points);
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    if (!std::isfinite(*iter_x) || !std::isfinite(*iter_y) || !std::isfinite(*iter_z)) {
+      continue;
+    }
+    input_points_.emplace_back(*iter_x, *iter_y, *iter_z);
+    min_x = std::min(min_x, *iter_x);
+    min_y = std::min(min_y, *iter_y);
+    max_x = std::max(max_x, *iter_x);
+    max_y = std::max(max_y, *iter_y);
+  }
+  if (input_points_.empty()) {
+    return;
+  }
+
+  cell_size_ = default_cell_size_;
+  const double extent_x = static_cast<double>(max_x) - min_x;
+  const double extent_y = static_cast<double>(max_y) - min_y;
+  const double area = (extent_x + cell_size_) * (extent_y + cell_size_);
+  if (area > static_cast<double>(max_num_cells) * cell_size_ * cell_size_) {
+    cell_size_ = std::sqrt(area / static_cast<double>(max_num_cells));
+  }
+  inverse_cell_size_ = 1.0 / cell_size_;
+  origin_x_ = min_x;
+  origin_y_ = min_y;
+  num_cells_x_ = static_cast<std::size_t>(extent_x * inverse_cell_size_) + 1;
+  num_cells_y_ = static_cast<std::size_t>(extent_y * inverse_cell_size_) + 1;
+
+  // counting sort of the points by cell
+  cell_begin_.assign(num_cells_x_ * num_cells_y_ + 1, 0);
+  input_cells_.resize(input_points_.size());
+  for (std::size_t i = 0; i < input_points_.size(); ++i) {
+    const auto cell_x = std::min(
+      static_cast<std::size_t>((input_points_[i].x - origin_x_) * inverse_cell_size_),
+      num_cells_x_ - 1);
+    const auto cell_y = std::min(
+      static_cast<std::size_t>((input_points_[i].y - origin_y_) * inverse_cell_size_),
+      num_cells_y_ - 1);
+    const auto cell = static_cast<std::uint32_t>(cell_y * num_cells_x_ + cell_x);
+    input_cells_[i] = cell;
+    ++cell_begin_[cell + 1];
+  }
+  for (std::size_t cell = 1; cell < cell_begin_.size(); ++cell) {
+    cell_begin_[cell] += cell_begin_[cell - 1];
+  }
+  // cell_begin_[cell] is used as the insertion position of the cell, then restored
+  points_.resize(input_points_.size());
+  for (std::size_t i = 0; i < input_points_.size(); ++i) {
+    points_[cell_begin_[input_cells_[i]]++] = input_points_[i];
+  }
+  for (std::size_t cell = cell_begin_.size() - 1; cell > 0; --cell) {
+    cell_begin_[cell] = cell_begin_[cell - 1];
+  }
+  cell_begin_[0] = 0;
+}
+
+}  // namespace obstacle_pointcloud
+}  // namespace autoware::detected_object_validation
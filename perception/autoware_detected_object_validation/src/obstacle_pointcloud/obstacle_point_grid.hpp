@@ -0,0 +1,108 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_POINTCLOUD__OBSTACLE_POINT_GRID_HPP_
+#define OBSTACLE_POINTCLOUD__OBSTACLE_POINT_GRID_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl/point_types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::detected_object_validation
+{
+namespace obstacle_pointcloud
+{
+
+/**
+ * \brief Uniform 2D grid of the obstacle points, shared by all the objects of a frame.
+ *
+ * The points are read from the PointCloud2 message and sorted into the cells with a counting
+ * sort, so that the points of a cell are contiguous. An object then only visits the cells
+ * overlapping its search area. The grid is not modified by the queries, so that the objects can be
+ * validated in parallel. The buffers are kept between the frames.
+ */
+class ObstaclePointGrid
+{
+public:
+  explicit ObstaclePointGrid(const double cell_size = 0.5);
+
+  /** \brief Sort the finite points of the cloud into the cells, the cloud needs x, y and z */
+  void build(const sensor_msgs::msg::PointCloud2 & cloud);
+
+  bool empty() const { return points_.empty(); }
+  std::size_t size() const { return points_.size(); }
+  double getCellSize() const { return cell_size_; }
+
+  /** \brief Call function(point) for the points in the cells overlapping the given xy box */
+  template <class F>
+  void forEachPointInBox(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    F && function) const
+  {
+    if (
+      points_.empty() || !(min_x <= max_x) || !(min_y <= max_y) || max_x < origin_x_ ||
+      max_y < origin_y_ || min_x > origin_x_ + static_cast<double>(num_cells_x_) * cell_size_ ||
+      min_y > origin_y_ + static_cast<double>(num_cells_y_) * cell_size_) {
+      return;
+    }
+    const auto to_cell = [this](const double value, const double origin, const std::size_t size) {
+      const double index = std::floor((value - origin) * inverse_cell_size_);
+      return static_cast<std::size_t>(
+        std::clamp(index, 0.0, static_cast<double>(size - 1)));
+    };
+    const std::size_t first_x = to_cell(min_x, origin_x_, num_cells_x_);
+    const std::size_t last_x = to_cell(max_x, origin_x_, num_cells_x_);
+    const std::size_t first_y = to_cell(min_y, origin_y_, num_cells_y_);
+    const std::size_t last_y = to_cell(max_y, origin_y_, num_cells_y_);
+    for (std::size_t y = first_y; y <= last_y; ++y) {
+      // the cells of a row are contiguous, so are their points
+      const std::size_t row = y * num_cells_x_;
+      const std::uint32_t end = cell_begin_[row + last_x + 1];
+      for (std::uint32_t i = cell_begin_[row + first_x]; i < end; ++i) {
+        function(points_[i]);
+      }
+    }
+  }
+
+private:
+  // the cells are enlarged for the frames whose points are spread too far for this number of cells
+  static constexpr std::size_t max_num_cells = 1U << 22;
+
+  double default_cell_size_;
+  double cell_size_;
+  double inverse_cell_size_;
+  double origin_x_{0.0};
+  double origin_y_{0.0};
+  std::size_t num_cells_x_{0};
+  std::size_t num_cells_y_{0};
+
+  // first point of each cell in points_, and the end of the last cell
+  std::vector<std::uint32_t> cell_begin_;
+  std::vector<pcl::PointXYZ> points_;
+
+  // buffers of the build
+  std::vector<pcl::PointXYZ> input_points_;
+  std::vector<std::uint32_t> input_cells_;
+};
+
+}  // namespace obstacle_pointcloud
+}  // namespace autoware::detected_object_validation
+
+#endif  // OBSTACLE_POINTCLOUD__OBSTACLE_POINT_GRID_HPP_
@@ -21,6 +21,8 @@
 
 #include <boost/geometry.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -42,6 +44,54 @@ namespace obstacle_pointcloud
 namespace bg = boost::geometry;
 using Shape = autoware_perception_msgs::msg::Shape;
 using Polygon2d = autoware_utils::Polygon2d;
+using Point2d = autoware_utils::Point2d;
+using Box2d = bg::model::box<Point2d>;
+
+namespace
+{
+// crossing number test of the point with the polygon, as pcl::CropHull does for 2D hulls
+bool isPointInPolygon(const double x, const double y, const Polygon2d & polygon)
+{
+  const auto & ring = polygon.outer();
+  bool in_polygon = false;
+  double x_old = ring.back().x();
+  double y_old = ring.back().y();
+  for (const auto & vertex : ring) {
+    const double x_new = vertex.x();
+    const double y_new = vertex.y();
+    const bool is_increasing = x_new > x_old;
+    const double x1 = is_increasing ? x_old : x_new;
+    const double y1 = is_increasing ? y_old : y_new;
+    const double x2 = is_increasing ? x_new : x_old;
+    const double y2 = is_increasing ? y_new : y_old;
+    if ((x_new < x) == (x <= x_old) && (y - y1) * (x2 - x1) < (y2 - y1) * (x - x1)) {
+      in_polygon = !in_polygon;
+    }
+    x_old = x_new;
+    y_old = y_new;
+  }
+  return in_polygon;
+}
+
+// the area to search for an object, the whole search circle only when the neighbor points are
+// needed for the debugger
+Box2d getSearchBox(
+  const geometry_msgs::msg::Point & position, const float search_radius, const Polygon2d & polygon,
+  const bool search_whole_radius)
+{
+  Point2d min_corner(position.x - search_radius, position.y - search_radius);
+  Point2d max_corner(position.x + search_radius, position.y + search_radius);
+  if (!search_whole_radius) {
+    Box2d polygon_box;
+    bg::envelope(polygon, polygon_box);
+    min_corner.x() = std::max(min_corner.x(), polygon_box.min_corner().x());
+    min_corner.y() = std::max(min_corner.y(), polygon_box.min_corner().y());
+    max_corner.x() = std::min(max_corner.x(), polygon_box.max_corner().x());
+    max_corner.y() = std::min(max_corner.y(), polygon_box.max_corner().y());
+  }
+  return Box2d(min_corner, max_corner);
+}
+}  // namespace
 
 Validator::Validator(const PointsNumThresholdParam & points_num_threshold_param)
 {
@@ -52,7 +102,7 @@ Validator::Validator(const PointsNumThresholdParam & points_num_threshold_param)
 }
 
 size_t Validator::getThresholdPointCloud(
-  const autoware_perception_msgs::msg::DetectedObject & object)
+  const autoware_perception_msgs::msg::DetectedObject & object) const
 {
   const auto object_label_id = object.classification.front().label;
   const auto object_distance = std::hypot(
@@ -67,95 +117,73 @@ size_t Validator::getThresholdPointCloud(
   return threshold_pc;
 }
 
-Validator2D::Validator2D(PointsNumThresholdParam & points_num_threshold_param)
-: Validator(points_num_threshold_param)
+bool Validator::setInputCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_cloud)
 {
+  obstacle_point_grid_.build(*input_cloud);
+  return !obstacle_point_grid_.empty();
 }
 
-bool Validator2D::setKdtreeInputCloud(
-  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_cloud)
+bool Validator::validate_object(
+  const autoware_perception_msgs::msg::DetectedObject & transformed_object,
+  ObjectDebugPointCloud * debug_pointcloud) const
 {
-  obstacle_pointcloud_.reset(new pcl::PointCloud<pcl::PointXY>);
-  pcl::fromROSMsg(*input_cloud, *obstacle_pointcloud_);
-  if (obstacle_pointcloud_->empty()) {
+  const auto search_radius = getMaxRadius(transformed_object);
+  if (!search_radius) {
     return false;
   }
+  const auto num =
+    getPointCloudWithinObject(transformed_object, search_radius.value(), debug_pointcloud);
+  if (!num) return true;
 
-  kdtree_ = pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
-  kdtree_->setInputCloud(obstacle_pointcloud_);
-
-  return true;
+  size_t threshold_pointcloud_num = getThresholdPointCloud(transformed_object);
+  if (num.value() > threshold_pointcloud_num) {
+    return true;
+  }
+  return false;  // remove object
 }
-pcl::PointCloud<pcl::PointXYZ>::Ptr Validator2D::convertToXYZ(
-  const pcl::PointCloud<pcl::PointXY>::Ptr & pointcloud_xy)
+
+Validator2D::Validator2D(PointsNumThresholdParam & points_num_threshold_param)
+: Validator(points_num_threshold_param)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_xyz(new pcl::PointCloud<pcl::PointXYZ>);
-  pointcloud_xyz->reserve(pointcloud_xy->size());
-  for (const auto & point : *pointcloud_xy) {
-    pointcloud_xyz->push_back(pcl::PointXYZ(point.x, point.y, 0.0));
-  }
-  return pointcloud_xyz;
 }
 
 std::optional<size_t> Validator2D::getPointCloudWithinObject(
-  const autoware_perception_msgs::msg::DetectedObject & object,
-  const pcl::PointCloud<pcl::PointXY>::Ptr pointcloud)
+  const autoware_perception_msgs::msg::DetectedObject & object, const float search_radius,
+  ObjectDebugPointCloud * debug_pointcloud) const
 {
-  std::vector<pcl::Vertices> vertices_array;
-  pcl::Vertices vertices;
   Polygon2d poly2d =
     autoware_utils::to_polygon2d(object.kinematics.pose_with_covariance.pose, object.shape);
   if (bg::is_empty(poly2d)) return std::nullopt;
 
-  pcl::PointCloud<pcl::PointXYZ>::Ptr poly3d(new pcl::PointCloud<pcl::PointXYZ>);
-
-  for (size_t i = 0; i < poly2d.outer().size(); ++i) {
-    vertices.vertices.emplace_back(i);
-    vertices_array.emplace_back(vertices);
-    poly3d->emplace_back(poly2d.outer().at(i).x(), poly2d.outer().at(i).y(), 0.0);
-  }
-  cropped_pointcloud_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::CropHull<pcl::PointXYZ> cropper;  // don't be implemented PointXY by PCL
-  cropper.setInputCloud(convertToXYZ(pointcloud));
-  cropper.setDim(2);
-  cropper.setHullIndices(vertices_array);
-  cropper.setHullCloud(poly3d);
-  cropper.setCropOutside(true);
-  cropper.filter(*cropped_pointcloud_);
-  return cropped_pointcloud_->size();
-}
-
-bool Validator2D::validate_object(
-  const autoware_perception_msgs::msg::DetectedObject & transformed_object)
-{
-  // get neighbor_pointcloud of object
-  neighbor_pointcloud_.reset(new pcl::PointCloud<pcl::PointXY>);
-  std::vector<int> indices;
-  std::vector<float> distances;
-  const auto search_radius = getMaxRadius(transformed_object);
-  if (!search_radius) {
-    return false;
-  }
-  kdtree_->radiusSearch(
-    pcl::PointXY(
-      transformed_object.kinematics.pose_with_covariance.pose.position.x,
-      transformed_object.kinematics.pose_with_covariance.pose.position.y),
-    search_radius.value(), indices, distances);
-  for (const auto & index : indices) {
-    neighbor_pointcloud_->push_back(obstacle_pointcloud_->at(index));
-  }
-  const auto num = getPointCloudWithinObject(transformed_object, neighbor_pointcloud_);
-  if (!num) return true;
-
-  size_t threshold_pointcloud_num = getThresholdPointCloud(transformed_object);
-  if (num.value() > threshold_pointcloud_num) {
-    return true;
-  }
-  return false;  // remove object
+  const auto & position = object.kinematics.pose_with_covariance.pose.position;
+  const double search_radius_sq = static_cast<double>(search_radius) * search_radius;
+  const auto search_box = getSearchBox(position, search_radius, poly2d, debug_pointcloud);
+  size_t num_points = 0;
+  obstacle_point_grid_.forEachPointInBox(
+    search_box.min_corner().x(), search_box.min_corner().y(), search_box.max_corner().x(),
+    search_box.max_corner().y(), [&](const pcl::PointXYZ & point) {
+      const double dx = point.x - position.x;
+      const double dy = point.y - position.y;
+      if (dx * dx + dy * dy > search_radius_sq) {
+        return;
+      }
+      if (debug_pointcloud) {
+        debug_pointcloud->neighbor_pointcloud->push_back(pcl::PointXYZ(point.x, point.y, 0.0));
+      }
+      if (!isPointInPolygon(point.x, point.y, poly2d)) {
+        return;
+      }
+      ++num_points;
+      if (debug_pointcloud) {
+        debug_pointcloud->pointcloud_within_object->push_back(
+          pcl::PointXYZ(point.x, point.y, 0.0));
+      }
+    });
+  return num_points;
 }
 
 std::optional<float> Validator2D::getMaxRadius(
-  const autoware_perception_msgs::msg::DetectedObject & object)
+  const autoware_perception_msgs::msg::DetectedObject & object) const
 {
   if (object.shape.type == Shape::BOUNDING_BOX || object.shape.type == Shape::CYLINDER) {
     return std::hypot(object.shape.dimensions.x * 0.5f, object.shape.dimensions.y * 0.5f);
@@ -175,21 +203,8 @@ Validator3D::Validator3D(PointsNumThresholdParam & points_num_threshold_param)
 : Validator(points_num_threshold_param)
 {
 }
-bool Validator3D::setKdtreeInputCloud(
-  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_cloud)
-{
-  obstacle_pointcloud_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*input_cloud, *obstacle_pointcloud_);
-  if (obstacle_pointcloud_->empty()) {
-    return false;
-  }
-  // setup kdtree_
-  kdtree_ = pcl::make_shared<pcl::search::KdTree<pcl::PointXYZ>>(false);
-  kdtree_->setInputCloud(obstacle_pointcloud_);
-  return true;
-}
 std::optional<float> Validator3D::getMaxRadius(
-  const autoware_perception_msgs::msg::DetectedObject & object)
+  const autoware_perception_msgs::msg::DetectedObject & object) const
 {
   if (object.shape.type == Shape::BOUNDING_BOX || object.shape.type == Shape::CYLINDER) {
     auto square_radius = (object.shape.dimensions.x * 0.5f) * (object.shape.dimensions.x * 0.5f) +
@@ -209,11 +224,9 @@ std::optional<float> Validator3D::getMaxRadius(
 }
 
 std::optional<size_t> Validator3D::getPointCloudWithinObject(
-  const autoware_perception_msgs::msg::DetectedObject & object,
-  const pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud)
+  const autoware_perception_msgs::msg::DetectedObject & object, const float search_radius,
+  ObjectDebugPointCloud * debug_pointcloud) const
 {
-  std::vector<pcl::Vertices> vertices_array;
-  pcl::Vertices vertices;
   auto const & object_position = object.kinematics.pose_with_covariance.pose.position;
   auto const object_height = object.shape.dimensions.x;
   auto z_min = object_position.z - object_height / 2.0f;
@@ -222,60 +235,30 @@ std::optional<size_t> Validator3D::getPointCloudWithinObject(
     autoware_utils::to_polygon2d(object.kinematics.pose_with_covariance.pose, object.shape);
   if (bg::is_empty(poly2d)) return std::nullopt;
 
-  pcl::PointCloud<pcl::PointXYZ>::Ptr poly3d(new pcl::PointCloud<pcl::PointXYZ>);
-  for (size_t i = 0; i < poly2d.outer().size(); ++i) {
-    vertices.vertices.emplace_back(i);
-    vertices_array.emplace_back(vertices);
-    poly3d->emplace_back(poly2d.outer().at(i).x(), poly2d.outer().at(i).y(), 0.0);
-  }
-
-  pcl::PointCloud<pcl::PointXYZ>::Ptr cropped_pointcloud_2d(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::CropHull<pcl::PointXYZ> cropper;
-  cropper.setInputCloud(neighbor_pointcloud);
-  cropper.setDim(2);
-  cropper.setHullIndices(vertices_array);
-  cropper.setHullCloud(poly3d);
-  cropper.setCropOutside(true);
-  cropper.filter(*cropped_pointcloud_2d);
-
-  cropped_pointcloud_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  cropped_pointcloud_->reserve(cropped_pointcloud_2d->size());
-  for (const auto & point : *cropped_pointcloud_2d) {
-    if (point.z > z_min && point.z < z_max) {
-      cropped_pointcloud_->push_back(point);
-    }
-  }
-  return cropped_pointcloud_->size();
-}
-
-bool Validator3D::validate_object(
-  const autoware_perception_msgs::msg::DetectedObject & transformed_object)
-{
-  neighbor_pointcloud_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  std::vector<int> indices;
-  std::vector<float> distances;
-  const auto search_radius = getMaxRadius(transformed_object);
-  if (!search_radius) {
-    return false;
-  }
-  kdtree_->radiusSearch(
-    pcl::PointXYZ(
-      transformed_object.kinematics.pose_with_covariance.pose.position.x,
-      transformed_object.kinematics.pose_with_covariance.pose.position.y,
-      transformed_object.kinematics.pose_with_covariance.pose.position.z),
-    search_radius.value(), indices, distances);
-  for (const auto & index : indices) {
-    neighbor_pointcloud_->push_back(obstacle_pointcloud_->at(index));
-  }
-
-  const auto num = getPointCloudWithinObject(transformed_object, neighbor_pointcloud_);
-  if (!num) return true;
-
-  size_t threshold_pointcloud_num = getThresholdPointCloud(transformed_object);
-  if (num.value() > threshold_pointcloud_num) {
-    return true;
-  }
-  return false;  // remove object
+  const double search_radius_sq = static_cast<double>(search_radius) * search_radius;
+  const auto search_box = getSearchBox(object_position, search_radius, poly2d, debug_pointcloud);
+  size_t num_points = 0;
+  obstacle_point_grid_.forEachPointInBox(
+    search_box.min_corner().x(), search_box.min_corner().y(), search_box.max_corner().x(),
+    search_box.max_corner().y(), [&](const pcl::PointXYZ & point) {
+      const double dx = point.x - object_position.x;
+      const double dy = point.y - object_position.y;
+      const double dz = point.z - object_position.z;
+      if (dx * dx + dy * dy + dz * dz > search_radius_sq) {
+        return;
+      }
+      if (debug_pointcloud) {
+        debug_pointcloud->neighbor_pointcloud->push_back(point);
+      }
+      if (!isPointInPolygon(point.x, point.y, poly2d) || !(point.z > z_min && point.z < z_max)) {
+        return;
+      }
+      ++num_points;
+      if (debug_pointcloud) {
+        debug_pointcloud->pointcloud_within_object->push_back(point);
+      }
+    });
+  return num_points;
 }
 
 ObstaclePointCloudBasedValidator::ObstaclePointCloudBasedValidator(
@@ -338,16 +321,21 @@ void ObstaclePointCloudBasedValidator::onObjectsAndObstaclePointCloud(
     return;
   }
   bool validation_is_ready = true;
-  if (!validator_->setKdtreeInputCloud(input_obstacle_pointcloud)) {
+  if (!validator_->setInputCloud(input_obstacle_pointcloud)) {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), 5,
       "obstacle pointcloud is empty! Can not validate objects.");
     validation_is_ready = false;
   }
 
-  for (size_t i = 0; i < transformed_objects.objects.size(); ++i) {
-    const auto & transformed_object = transformed_objects.objects.at(i);
-    const auto & object = input_objects->objects.at(i);
+  // validate the objects in parallel, then sort them out in the input order
+  const auto & objects = transformed_objects.objects;
+  std::vector<std::uint8_t> is_validated(objects.size(), 0);
+  std::vector<std::uint8_t> is_too_far(objects.size(), 0);
+  std::vector<ObjectDebugPointCloud> debug_pointclouds(debugger_ ? objects.size() : 0);
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & transformed_object = objects.at(i);
     // check object distance
     const double distance_sq =
       transformed_object.kinematics.pose_with_covariance.pose.position.x *
@@ -355,18 +343,26 @@ void ObstaclePointCloudBasedValidator::onObjectsAndObstaclePointCloud(
       transformed_object.kinematics.pose_with_covariance.pose.position.y *
         transformed_object.kinematics.pose_with_covariance.pose.position.y;
     if (distance_sq > validate_max_distance_sq_) {
+      is_too_far[i] = 1;
+      continue;
+    }
+    is_validated[i] =
+      validation_is_ready &&
+      validator_->validate_object(transformed_object, debugger_ ? &debug_pointclouds[i] : nullptr);
+  }
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & object = input_objects->objects.at(i);
+    if (is_too_far[i]) {
       // pass to output
       output.objects.push_back(object);
       continue;
     }
-
-    const auto validated =
-      validation_is_ready ? validator_->validate_object(transformed_object) : false;
     if (debugger_) {
-      debugger_->addNeighborPointcloud(validator_->getDebugNeighborPointCloud());
-      debugger_->addPointcloudWithinPolygon(validator_->getDebugPointCloudWithinObject());
+      debugger_->addNeighborPointcloud(debug_pointclouds[i].neighbor_pointcloud);
+      debugger_->addPointcloudWithinPolygon(debug_pointclouds[i].pointcloud_within_object);
     }
-    if (validated) {
+    if (is_validated[i]) {
       output.objects.push_back(object);
     } else {
       removed_objects.objects.push_back(object);
@@ -21,6 +21,7 @@
 #include "autoware_utils/ros/published_time_publisher.hpp"
 #include "autoware_utils/system/stop_watch.hpp"
 #include "debugger.hpp"
+#include "obstacle_point_grid.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -30,13 +31,8 @@
 #include <message_filters/subscriber.h>
 #include <message_filters/sync_policies/approximate_time.h>
 #include <message_filters/synchronizer.h>
-#include <pcl/filters/crop_hull.h>
-#include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/search/pcl_search.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
@@ -56,82 +52,62 @@ struct PointsNumThresholdParam
   std::vector<double> min_points_and_distance_ratio;
 };
 
+// points found for an object, for the debugger
+struct ObjectDebugPointCloud
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud{new pcl::PointCloud<pcl::PointXYZ>};
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_within_object{
+    new pcl::PointCloud<pcl::PointXYZ>};
+};
+
 class Validator
 {
 private:
   PointsNumThresholdParam points_num_threshold_param_;
 
 protected:
-  pcl::PointCloud<pcl::PointXYZ>::Ptr cropped_pointcloud_;
+  ObstaclePointGrid obstacle_point_grid_;
 
 public:
   explicit Validator(const PointsNumThresholdParam & points_num_threshold_param);
-  inline pcl::PointCloud<pcl::PointXYZ>::Ptr getDebugPointCloudWithinObject() const
-  {
-    return cropped_pointcloud_;
-  }
-
-  virtual bool setKdtreeInputCloud(
-    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_pointcloud) = 0;
-  virtual bool validate_object(
-    const autoware_perception_msgs::msg::DetectedObject & transformed_object) = 0;
+
+  bool setInputCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_cloud);
+  // the validation only reads the grid, so that several objects can be validated at once
+  bool validate_object(
+    const autoware_perception_msgs::msg::DetectedObject & transformed_object,
+    ObjectDebugPointCloud * debug_pointcloud = nullptr) const;
   virtual std::optional<float> getMaxRadius(
-    const autoware_perception_msgs::msg::DetectedObject & object) = 0;
-  size_t getThresholdPointCloud(const autoware_perception_msgs::msg::DetectedObject & object);
-  virtual pcl::PointCloud<pcl::PointXYZ>::Ptr getDebugNeighborPointCloud() = 0;
+    const autoware_perception_msgs::msg::DetectedObject & object) const = 0;
+  size_t getThresholdPointCloud(const autoware_perception_msgs::msg::DetectedObject & object) const;
+  // count the obstacle points within the search radius and the object
+  virtual std::optional<size_t> getPointCloudWithinObject(
+    const autoware_perception_msgs::msg::DetectedObject & object, const float search_radius,
+    ObjectDebugPointCloud * debug_pointcloud) const = 0;
 
   virtual ~Validator() = default;
 };
 
 class Validator2D : public Validator
 {
-private:
-  pcl::PointCloud<pcl::PointXY>::Ptr obstacle_pointcloud_;
-  pcl::PointCloud<pcl::PointXY>::Ptr neighbor_pointcloud_;
-  pcl::search::Search<pcl::PointXY>::Ptr kdtree_;
-
 public:
   explicit Validator2D(PointsNumThresholdParam & points_num_threshold_param);
 
-  static pcl::PointCloud<pcl::PointXYZ>::Ptr convertToXYZ(
-    const pcl::PointCloud<pcl::PointXY>::Ptr & pointcloud_xy);
-  inline pcl::PointCloud<pcl::PointXYZ>::Ptr getDebugNeighborPointCloud() override
-  {
-    return convertToXYZ(neighbor_pointcloud_);
-  }
-
-  bool setKdtreeInputCloud(
-    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_cloud) override;
-  bool validate_object(
-    const autoware_perception_msgs::msg::DetectedObject & transformed_object) override;
   std::optional<float> getMaxRadius(
-    const autoware_perception_msgs::msg::DetectedObject & object) override;
+    const autoware_perception_msgs::msg::DetectedObject & object) const override;
   std::optional<size_t> getPointCloudWithinObject(
-    const autoware_perception_msgs::msg::DetectedObject & object,
-    const pcl::PointCloud<pcl::PointXY>::Ptr pointcloud);
+    const autoware_perception_msgs::msg::DetectedObject & object, const float search_radius,
+    ObjectDebugPointCloud * debug_pointcloud) const override;
 };
 class Validator3D : public Validator
 {
-private:
-  pcl::PointCloud<pcl::PointXYZ>::Ptr obstacle_pointcloud_;
-  pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud_;
-  pcl::search::Search<pcl::PointXYZ>::Ptr kdtree_;
-
 public:
   explicit Validator3D(PointsNumThresholdParam & points_num_threshold_param);
-  inline pcl::PointCloud<pcl::PointXYZ>::Ptr getDebugNeighborPointCloud() override
-  {
-    return neighbor_pointcloud_;
-  }
-  bool setKdtreeInputCloud(
-    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_cloud) override;
-  bool validate_object(
-    const autoware_perception_msgs::msg::DetectedObject & transformed_object) override;
+
   std::optional<float> getMaxRadius(
-    const autoware_perception_msgs::msg::DetectedObject & object) override;
+    const autoware_perception_msgs::msg::DetectedObject & object) const override;
   std::optional<size_t> getPointCloudWithinObject(
-    const autoware_perception_msgs::msg::DetectedObject & object,
-    const pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud);
+    const autoware_perception_msgs::msg::DetectedObject & object, const float search_radius,
+    ObjectDebugPointCloud * debug_pointcloud) const override;
 };
 
 class ObstaclePointCloudBasedValidator : public rclcpp::Node
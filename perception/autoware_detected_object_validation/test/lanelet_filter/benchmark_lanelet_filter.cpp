@@ -0,0 +1,266 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/lanelet_filter/lanelet_index.hpp"
+
+#include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/geometry/algorithms/disjoint.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/geometry/BoundingBox.h>
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Measure the lanelet checks of the object lanelet filter on a synthetic map of 3.5 m wide and
+// 20 m long road lanelets over 1 km x 1 km, with messages of 50 to 400 box objects spread over a
+// 200 m x 200 m area around the ego vehicle. The previous implementation is reproduced as the
+// baseline: for each message it searches the map with the convex hull of the objects, expands the
+// polygons of the lanelets, builds a local R-tree, and triangulates the nearest lanelet for each
+// elevation check. The lanelet index is built once, then each object only queries it, in parallel.
+// The number of threads is given by OMP_NUM_THREADS.
+
+using autoware::detected_object_validation::lanelet_filter::Box;
+using autoware::detected_object_validation::lanelet_filter::createLaneletMesh;
+using autoware::detected_object_validation::lanelet_filter::expandPolygon;
+using autoware::detected_object_validation::lanelet_filter::getExpandedPolygon;
+using autoware::detected_object_validation::lanelet_filter::IndexedLanelet;
+using autoware::detected_object_validation::lanelet_filter::isPointAboveLaneletMesh;
+using autoware::detected_object_validation::lanelet_filter::LaneletIndex;
+using autoware::detected_object_validation::lanelet_filter::RtreeAlgo;
+using autoware_utils::LinearRing2d;
+using autoware_utils::MultiPoint2d;
+using autoware_utils::Polygon2d;
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+constexpr double extra_margin = 0.5;
+constexpr double min_elevation = -0.5;
+constexpr double max_elevation = 1.0;
+
+struct Object
+{
+  Polygon2d polygon;
+  Eigen::Vector3d centroid;
+  double height;
+};
+
+lanelet::LaneletMapPtr createGridMap()
+{
+  lanelet::LaneletMapPtr map(new lanelet::LaneletMap);
+  for (double y = -500.0; y < 500.0; y += 3.5) {
+    for (double x = -500.0; x < 500.0; x += 20.0) {
+      lanelet::Points3d left;
+      lanelet::Points3d right;
+      for (double s = 0.0; s <= 20.0; s += 5.0) {
+        left.emplace_back(lanelet::utils::getId(), x + s, y + 3.5, 0.01 * (x + s));
+        right.emplace_back(lanelet::utils::getId(), x + s, y, 0.01 * (x + s));
+      }
+      lanelet::Lanelet lanelet(
+        lanelet::utils::getId(), lanelet::LineString3d(lanelet::utils::getId(), left),
+        lanelet::LineString3d(lanelet::utils::getId(), right));
+      lanelet.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+      map->add(lanelet);
+    }
+  }
+  return map;
+}
+
+std::vector<Object> createObjects(const std::size_t num_objects)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position_distribution(-100.0, 100.0);
+  std::uniform_real_distribution<double> yaw_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<double> height_distribution(-1.0, 3.0);
+
+  std::vector<Object> objects(num_objects);
+  for (auto & object : objects) {
+    const double x = position_distribution(engine);
+    const double y = position_distribution(engine);
+    const double yaw = yaw_distribution(engine);
+    for (const auto & [dx, dy] : {std::make_pair(2.4, 0.9), std::make_pair(2.4, -0.9),
+                                  std::make_pair(-2.4, -0.9), std::make_pair(-2.4, 0.9)}) {
+      object.polygon.outer().emplace_back(
+        x + dx * std::cos(yaw) - dy * std::sin(yaw), y + dx * std::sin(yaw) + dy * std::cos(yaw));
+    }
+    object.polygon.outer().push_back(object.polygon.outer().front());
+    object.height = 1.5;
+    object.centroid = Eigen::Vector3d(x, y, 0.01 * x + height_distribution(engine));
+  }
+  return objects;
+}
+
+// the xy overlap and the elevation checks of the filter
+bool isObjectOnLanelets(
+  const Object & object, const std::vector<const IndexedLanelet *> & candidates,
+  const bool use_cached_mesh)
+{
+  bool overlap = false;
+  for (const auto * candidate : candidates) {
+    if (!bg::disjoint(object.polygon, candidate->polygon)) {
+      overlap = true;
+      break;
+    }
+  }
+  if (!overlap) {
+    return false;
+  }
+  const IndexedLanelet * nearest_lanelet = nullptr;
+  double closest_lanelet_z_dist = std::numeric_limits<double>::infinity();
+  for (const auto * candidate : candidates) {
+    const double diff_z = object.centroid.z() - candidate->lanelet.leftBound()[0].z();
+    if (diff_z * diff_z < closest_lanelet_z_dist) {
+      closest_lanelet_z_dist = diff_z * diff_z;
+      nearest_lanelet = candidate;
+    }
+  }
+  if (use_cached_mesh) {
+    return isPointAboveLaneletMesh(
+      object.centroid, nearest_lanelet->mesh, 0.5 * object.height, min_elevation, max_elevation);
+  }
+  return isPointAboveLaneletMesh(
+    object.centroid, createLaneletMesh(nearest_lanelet->lanelet), 0.5 * object.height,
+    min_elevation, max_elevation);
+}
+
+// the previous implementation, which builds a local index of the lanelets for each message
+std::vector<std::uint8_t> filterWithLocalRtree(
+  const lanelet::LaneletMap & map, const std::vector<Object> & objects)
+{
+  MultiPoint2d candidate_points;
+  for (const auto & object : objects) {
+    candidate_points.insert(
+      candidate_points.end(), object.polygon.outer().begin(), object.polygon.outer().end());
+  }
+  LinearRing2d convex_hull;
+  bg::convex_hull(candidate_points, convex_hull);
+  convex_hull = expandPolygon(convex_hull, extra_margin);
+
+  Box bbox_of_convex_hull;
+  bg::envelope(convex_hull, bbox_of_convex_hull);
+  const lanelet::BoundingBox2d bbox2d(
+    lanelet::BasicPoint2d(
+      bg::get<bg::min_corner, 0>(bbox_of_convex_hull),
+      bg::get<bg::min_corner, 1>(bbox_of_convex_hull)),
+    lanelet::BasicPoint2d(
+      bg::get<bg::max_corner, 0>(bbox_of_convex_hull),
+      bg::get<bg::max_corner, 1>(bbox_of_convex_hull)));
+
+  std::vector<IndexedLanelet> intersected_lanelets;
+  for (const auto & lanelet : map.laneletLayer.search(bbox2d)) {
+    if (bg::intersects(convex_hull, lanelet.polygon2d().basicPolygon())) {
+      IndexedLanelet intersected_lanelet;
+      intersected_lanelet.lanelet = lanelet;
+      intersected_lanelet.polygon = getExpandedPolygon(lanelet, extra_margin);
+      bg::envelope(intersected_lanelet.polygon, intersected_lanelet.box);
+      intersected_lanelets.push_back(std::move(intersected_lanelet));
+    }
+  }
+  bgi::rtree<std::pair<Box, std::size_t>, RtreeAlgo> local_rtree;
+  for (std::size_t i = 0; i < intersected_lanelets.size(); ++i) {
+    local_rtree.insert(std::make_pair(intersected_lanelets[i].box, i));
+  }
+
+  std::vector<std::uint8_t> filter_pass(objects.size(), 0);
+  std::vector<std::pair<Box, std::size_t>> hits;
+  std::vector<const IndexedLanelet *> candidates;
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    Box bbox;
+    bg::envelope(objects[i].polygon, bbox);
+    hits.clear();
+    local_rtree.query(bgi::intersects(bbox), std::back_inserter(hits));
+    candidates.clear();
+    for (const auto & hit : hits) {
+      candidates.push_back(&intersected_lanelets[hit.second]);
+    }
+    filter_pass[i] = isObjectOnLanelets(objects[i], candidates, false) ? 1 : 0;
+  }
+  return filter_pass;
+}
+
+std::vector<std::uint8_t> filterWithLaneletIndex(
+  const LaneletIndex & index, const std::vector<Object> & objects)
+{
+  std::vector<std::uint8_t> filter_pass(objects.size(), 0);
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    Box bbox;
+    bg::envelope(objects[i].polygon, bbox);
+    std::vector<const IndexedLanelet *> candidates;
+    index.query(bbox, candidates);
+    filter_pass[i] = isObjectOnLanelets(objects[i], candidates, true) ? 1 : 0;
+  }
+  return filter_pass;
+}
+
+template <class F>
+double measure(const F & function)
+{
+  constexpr int iterations = 20;
+  function();  // warm up
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+           .count() /
+         iterations;
+}
+
+std::size_t count(const std::vector<std::uint8_t> & filter_pass)
+{
+  std::size_t n = 0;
+  for (const auto pass : filter_pass) {
+    n += pass;
+  }
+  return n;
+}
+}  // namespace
+
+int main()
+{
+  const auto map = createGridMap();
+
+  const auto start = std::chrono::steady_clock::now();
+  const LaneletIndex index(*map, extra_margin);
+  const double build_ms =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "lanelets: " << index.size() << ", index build " << build_ms << " ms" << std::endl;
+
+  for (const std::size_t num_objects : {50, 100, 200, 400}) {
+    const auto objects = createObjects(num_objects);
+    std::vector<std::uint8_t> local_pass;
+    std::vector<std::uint8_t> index_pass;
+    const double local_ms = measure([&]() { local_pass = filterWithLocalRtree(*map, objects); });
+    const double index_ms = measure([&]() { index_pass = filterWithLaneletIndex(index, objects); });
+    std::cout << "objects: " << num_objects << ", local R-tree " << local_ms
+              << " ms, lanelet index " << index_ms << " ms, kept objects " << count(local_pass)
+              << " / " << count(index_pass) << std::endl;
+  }
+  return 0;
+}
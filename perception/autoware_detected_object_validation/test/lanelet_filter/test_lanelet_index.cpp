@@ -0,0 +1,120 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/lanelet_filter/lanelet_index.hpp"
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/primitives/LineString.h>
+#include <lanelet2_core/primitives/Point.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <string>
+#include <vector>
+
+using autoware::detected_object_validation::lanelet_filter::Box;
+using autoware::detected_object_validation::lanelet_filter::IndexedLanelet;
+using autoware::detected_object_validation::lanelet_filter::isPointAboveLaneletMesh;
+using autoware::detected_object_validation::lanelet_filter::LaneletIndex;
+using autoware::detected_object_validation::lanelet_filter::Point2d;
+
+namespace
+{
+/// @brief Create a 10[m] long and 3[m] wide lanelet along the x axis starting at (x, y)
+lanelet::Lanelet createLanelet(
+  const double x, const double y, const std::string & subtype, const double slope = 0.0)
+{
+  lanelet::Point3d p1_left(lanelet::utils::getId(), x, y + 1.5, 0.0);
+  lanelet::Point3d p2_left(lanelet::utils::getId(), x + 10.0, y + 1.5, 10.0 * slope);
+  lanelet::Point3d p1_right(lanelet::utils::getId(), x, y - 1.5, 0.0);
+  lanelet::Point3d p2_right(lanelet::utils::getId(), x + 10.0, y - 1.5, 10.0 * slope);
+  lanelet::LineString3d left(lanelet::utils::getId(), {p1_left, p2_left});
+  lanelet::LineString3d right(lanelet::utils::getId(), {p1_right, p2_right});
+  lanelet::Lanelet lanelet(lanelet::utils::getId(), left, right);
+  lanelet.attributes()[lanelet::AttributeName::Subtype] = subtype;
+  return lanelet;
+}
+
+std::vector<const IndexedLanelet *> query(
+  const LaneletIndex & index, const double min_x, const double min_y, const double max_x,
+  const double max_y)
+{
+  std::vector<const IndexedLanelet *> result;
+  index.query(Box(Point2d(min_x, min_y), Point2d(max_x, max_y)), result);
+  return result;
+}
+}  // namespace
+
+TEST(LaneletIndexTest, EmptyMap)
+{
+  const lanelet::LaneletMap lanelet_map;
+  const LaneletIndex index(lanelet_map, 0.0);
+  EXPECT_TRUE(index.empty());
+  EXPECT_TRUE(query(index, -100.0, -100.0, 100.0, 100.0).empty());
+}
+
+TEST(LaneletIndexTest, OnlyRoadAndRoadShoulder)
+{
+  lanelet::LaneletMap lanelet_map;
+  lanelet_map.add(createLanelet(0.0, 0.0, lanelet::AttributeValueString::Road));
+  lanelet_map.add(createLanelet(0.0, 10.0, "road_shoulder"));
+  lanelet_map.add(createLanelet(0.0, 20.0, lanelet::AttributeValueString::Crosswalk));
+
+  const LaneletIndex index(lanelet_map, 0.0);
+  EXPECT_EQ(index.size(), 2U);
+  EXPECT_EQ(query(index, 4.0, -1.0, 6.0, 1.0).size(), 1U);
+  EXPECT_EQ(query(index, 4.0, 9.0, 6.0, 11.0).size(), 1U);
+  EXPECT_TRUE(query(index, 4.0, 19.0, 6.0, 21.0).empty());
+  EXPECT_EQ(query(index, -1.0, -1.0, 11.0, 21.0).size(), 2U);
+}
+
+TEST(LaneletIndexTest, ExtraMargin)
+{
+  lanelet::LaneletMap lanelet_map;
+  lanelet_map.add(createLanelet(0.0, 0.0, lanelet::AttributeValueString::Road));
+
+  // the box just outside of the lanelet is only found with the margin
+  EXPECT_TRUE(query(LaneletIndex(lanelet_map, 0.0), 4.0, 1.8, 6.0, 2.0).empty());
+  const LaneletIndex index(lanelet_map, 0.5);
+  const auto result = query(index, 4.0, 1.8, 6.0, 2.0);
+  ASSERT_EQ(result.size(), 1U);
+  EXPECT_NEAR(boost::geometry::get<boost::geometry::max_corner, 1>(result.front()->box), 2.0, 1e-6);
+}
+
+TEST(LaneletIndexTest, MeshIsCached)
+{
+  lanelet::LaneletMap lanelet_map;
+  lanelet_map.add(createLanelet(0.0, 0.0, lanelet::AttributeValueString::Road));
+  lanelet_map.add(createLanelet(0.0, 10.0, lanelet::AttributeValueString::Road, 5.0));
+
+  const LaneletIndex index(lanelet_map, 0.0);
+  const auto flat = query(index, 4.0, -1.0, 6.0, 1.0);
+  ASSERT_EQ(flat.size(), 1U);
+  EXPECT_EQ(flat.front()->mesh.triangles.size(), 2U);
+  EXPECT_EQ(flat.front()->mesh.normals.size(), 2U);
+  EXPECT_FALSE(flat.front()->mesh.has_steep_triangle);
+
+  // 1.0[m] high object on the road, and in the air
+  const auto & flat_mesh = flat.front()->mesh;
+  EXPECT_TRUE(isPointAboveLaneletMesh(Eigen::Vector3d(5.0, 0.0, 0.5), flat_mesh, 0.5, 0.0, 1.0));
+  EXPECT_FALSE(isPointAboveLaneletMesh(Eigen::Vector3d(5.0, 0.0, 5.0), flat_mesh, 0.5, 0.0, 1.0));
+
+  // a steep lanelet can not tell above from below
+  const auto steep = query(index, 4.0, 9.0, 6.0, 11.0);
+  ASSERT_EQ(steep.size(), 1U);
+  EXPECT_TRUE(steep.front()->mesh.has_steep_triangle);
+  EXPECT_TRUE(
+    isPointAboveLaneletMesh(Eigen::Vector3d(5.0, 10.0, 100.0), steep.front()->mesh, 0.5, 0.0, 1.0));
+}
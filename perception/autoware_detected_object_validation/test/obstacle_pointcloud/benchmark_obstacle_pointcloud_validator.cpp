@@ -0,0 +1,173 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/obstacle_pointcloud/obstacle_pointcloud_validator.hpp"
+#include "kdtree_reference.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+#include <tf2/LinearMath/Quaternion.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measure the validation of 50 to 300 objects against an obstacle cloud of 200k points within
+// 100 m around the ego vehicle, most of them in clusters as the obstacles are. The previous
+// implementation is reproduced as the baseline: it converts the cloud to PCL and builds a k-d
+// tree for each frame, then searches the neighbors of each object and crops them with CropHull.
+// The validators build the point grid from the PointCloud2 message and count the points of the
+// objects from the overlapped cells only. The objects are validated serially here, the node
+// validates them in parallel with OpenMP.
+
+using autoware::detected_object_validation::obstacle_pointcloud::PointsNumThresholdParam;
+using autoware::detected_object_validation::obstacle_pointcloud::Validator;
+using autoware::detected_object_validation::obstacle_pointcloud::Validator2D;
+using autoware::detected_object_validation::obstacle_pointcloud::Validator3D;
+using autoware_perception_msgs::msg::DetectedObject;
+using autoware_perception_msgs::msg::ObjectClassification;
+using autoware_perception_msgs::msg::Shape;
+
+namespace
+{
+constexpr std::size_t num_points = 200000;
+
+PointsNumThresholdParam createParam()
+{
+  PointsNumThresholdParam param;
+  param.min_points_num = std::vector<int64_t>(8, 10);
+  param.max_points_num = std::vector<int64_t>(8, 10);
+  param.min_points_and_distance_ratio = std::vector<double>(8, 800.0);
+  return param;
+}
+
+std::vector<DetectedObject> createObjects(const std::size_t num_objects)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position_distribution(-80.0, 80.0);
+  std::uniform_real_distribution<double> yaw_distribution(-M_PI, M_PI);
+
+  std::vector<DetectedObject> objects(num_objects);
+  for (auto & object : objects) {
+    ObjectClassification classification;
+    classification.label = ObjectClassification::CAR;
+    classification.probability = 1.0;
+    object.classification.push_back(classification);
+    auto & pose = object.kinematics.pose_with_covariance.pose;
+    pose.position.x = position_distribution(engine);
+    pose.position.y = position_distribution(engine);
+    pose.position.z = 0.8;
+    tf2::Quaternion quaternion;
+    quaternion.setRPY(0.0, 0.0, yaw_distribution(engine));
+    pose.orientation.x = quaternion.x();
+    pose.orientation.y = quaternion.y();
+    pose.orientation.z = quaternion.z();
+    pose.orientation.w = quaternion.w();
+    object.shape.type = Shape::BOUNDING_BOX;
+    object.shape.dimensions.x = 4.5;
+    object.shape.dimensions.y = 1.8;
+    object.shape.dimensions.z = 1.6;
+  }
+  return objects;
+}
+
+// half of the points are on the objects, the others are spread around
+sensor_msgs::msg::PointCloud2::ConstSharedPtr createObstacleCloud(
+  const std::vector<DetectedObject> & objects)
+{
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<float> position_distribution(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> height_distribution(0.0f, 2.0f);
+  std::normal_distribution<float> cluster_distribution(0.0f, 1.2f);
+
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    if (i % 2 == 0) {
+      const auto & position = objects[(i / 2) % objects.size()].kinematics.pose_with_covariance
+                                .pose.position;
+      cloud.push_back(pcl::PointXYZ(
+        position.x + cluster_distribution(engine), position.y + cluster_distribution(engine),
+        height_distribution(engine)));
+    } else {
+      cloud.push_back(pcl::PointXYZ(
+        position_distribution(engine), position_distribution(engine),
+        height_distribution(engine)));
+    }
+  }
+  auto msg = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  pcl::toROSMsg(cloud, *msg);
+  return msg;
+}
+
+std::vector<std::size_t> countWithGrid(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & msg,
+  const std::vector<DetectedObject> & objects, Validator & validator)
+{
+  validator.setInputCloud(msg);
+  std::vector<std::size_t> counts;
+  for (const auto & object : objects) {
+    counts.push_back(
+      validator.getPointCloudWithinObject(object, validator.getMaxRadius(object).value(), nullptr)
+        .value());
+  }
+  return counts;
+}
+
+template <class F>
+double measure(const F & function)
+{
+  constexpr int iterations = 10;
+  function();  // warm up
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+           .count() /
+         iterations;
+}
+}  // namespace
+
+int main()
+{
+  auto param = createParam();
+  Validator2D validator_2d(param);
+  Validator3D validator_3d(param);
+
+  for (const std::size_t num_objects : {50, 100, 200, 300}) {
+    const auto objects = createObjects(num_objects);
+    const auto msg = createObstacleCloud(objects);
+
+    std::vector<std::size_t> kdtree_counts;
+    std::vector<std::size_t> grid_counts;
+    const double kdtree_ms =
+      measure([&]() { kdtree_counts = countWithKdtree3D(*msg, objects, validator_3d); });
+    const double grid_3d_ms =
+      measure([&]() { grid_counts = countWithGrid(msg, objects, validator_3d); });
+    const double grid_2d_ms = measure([&]() { countWithGrid(msg, objects, validator_2d); });
+
+    std::size_t num_different = 0;
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      num_different += kdtree_counts[i] != grid_counts[i];
+    }
+    std::cout << "objects: " << num_objects << ", points: " << num_points << ", k-d tree (3D) "
+              << kdtree_ms << " ms, grid (3D) " << grid_3d_ms << " ms, grid (2D) " << grid_2d_ms
+              << " ms, objects with different counts " << num_different << std::endl;
+  }
+  return 0;
+}
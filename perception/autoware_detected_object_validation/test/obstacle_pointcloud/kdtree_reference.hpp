@@ -0,0 +1,150 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef OBSTACLE_POINTCLOUD__KDTREE_REFERENCE_HPP_
+#define OBSTACLE_POINTCLOUD__KDTREE_REFERENCE_HPP_
+
+#include "../../src/obstacle_pointcloud/obstacle_pointcloud_validator.hpp"
+
+#include <autoware_utils/geometry/boost_polygon_utils.hpp>
+
+#include <pcl/filters/crop_hull.h>
+#include <pcl/search/kdtree.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <vector>
+
+// The previous validation path, which the point grid replaced: the cloud is converted to PCL and
+// searched with a k-d tree for each frame, then the neighbors of each object are cropped with
+// CropHull. The validators must count the same points.
+
+/**
+ * @brief Crop the neighbor points with the footprint of the object as the previous validators did.
+ *
+ * @return the cropped points, in the footprint for the 2D validator, also in the height range of
+ * the object for the 3D validator
+ */
+inline std::size_t cropHull(
+  const autoware_perception_msgs::msg::DetectedObject & object,
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & neighbor_pointcloud, const bool use_height)
+{
+  const auto poly2d =
+    autoware_utils::to_polygon2d(object.kinematics.pose_with_covariance.pose, object.shape);
+  std::vector<pcl::Vertices> vertices_array;
+  pcl::Vertices vertices;
+  pcl::PointCloud<pcl::PointXYZ>::Ptr poly3d(new pcl::PointCloud<pcl::PointXYZ>);
+  for (std::size_t i = 0; i < poly2d.outer().size(); ++i) {
+    vertices.vertices.emplace_back(i);
+    vertices_array.emplace_back(vertices);
+    poly3d->emplace_back(poly2d.outer().at(i).x(), poly2d.outer().at(i).y(), 0.0);
+  }
+  pcl::PointCloud<pcl::PointXYZ> cropped_pointcloud;
+  pcl::CropHull<pcl::PointXYZ> cropper;
+  cropper.setInputCloud(neighbor_pointcloud);
+  cropper.setDim(2);
+  cropper.setHullIndices(vertices_array);
+  cropper.setHullCloud(poly3d);
+  cropper.setCropOutside(true);
+  cropper.filter(cropped_pointcloud);
+  if (!use_height) {
+    return cropped_pointcloud.size();
+  }
+
+  // the height of the object is taken from dimensions.x, as the 3D validator does
+  const auto & position = object.kinematics.pose_with_covariance.pose.position;
+  const double z_min = position.z - object.shape.dimensions.x / 2.0;
+  const double z_max = position.z + object.shape.dimensions.x / 2.0;
+  std::size_t count = 0;
+  for (const auto & point : cropped_pointcloud) {
+    count += point.z > z_min && point.z < z_max;
+  }
+  return count;
+}
+
+/**
+ * @brief The number of points within each object for the previous 2D validator
+ *
+ * @param num_neighbors if not null, receives the number of points within the search radius of each
+ * object
+ */
+inline std::vector<std::size_t> countWithKdtree2D(
+  const sensor_msgs::msg::PointCloud2 & msg,
+  const std::vector<autoware_perception_msgs::msg::DetectedObject> & objects,
+  const autoware::detected_object_validation::obstacle_pointcloud::Validator & validator,
+  std::vector<std::size_t> * num_neighbors = nullptr)
+{
+  pcl::PointCloud<pcl::PointXY>::Ptr obstacle_pointcloud(new pcl::PointCloud<pcl::PointXY>);
+  pcl::fromROSMsg(msg, *obstacle_pointcloud);
+  pcl::search::KdTree<pcl::PointXY> kdtree(false);
+  kdtree.setInputCloud(obstacle_pointcloud);
+
+  std::vector<std::size_t> counts;
+  std::vector<int> indices;
+  std::vector<float> distances;
+  for (const auto & object : objects) {
+    const auto & position = object.kinematics.pose_with_covariance.pose.position;
+    pcl::PointXY search_point;
+    search_point.x = position.x;
+    search_point.y = position.y;
+    kdtree.radiusSearch(search_point, validator.getMaxRadius(object).value(), indices, distances);
+    if (num_neighbors) {
+      num_neighbors->push_back(indices.size());
+    }
+    pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
+    for (const auto index : indices) {
+      const auto & point = obstacle_pointcloud->at(index);
+      neighbor_pointcloud->push_back(pcl::PointXYZ(point.x, point.y, 0.0));
+    }
+    counts.push_back(cropHull(object, neighbor_pointcloud, false));
+  }
+  return counts;
+}
+
+/**
+ * @brief The number of points within each object for the previous 3D validator
+ *
+ * @param num_neighbors if not null, receives the number of points within the search radius of each
+ * object
+ */
+inline std::vector<std::size_t> countWithKdtree3D(
+  const sensor_msgs::msg::PointCloud2 & msg,
+  const std::vector<autoware_perception_msgs::msg::DetectedObject> & objects,
+  const autoware::detected_object_validation::obstacle_pointcloud::Validator & validator,
+  std::vector<std::size_t> * num_neighbors = nullptr)
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr obstacle_pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::fromROSMsg(msg, *obstacle_pointcloud);
+  pcl::search::KdTree<pcl::PointXYZ> kdtree(false);
+  kdtree.setInputCloud(obstacle_pointcloud);
+
+  std::vector<std::size_t> counts;
+  std::vector<int> indices;
+  std::vector<float> distances;
+  for (const auto & object : objects) {
+    const auto & position = object.kinematics.pose_with_covariance.pose.position;
+    kdtree.radiusSearch(
+      pcl::PointXYZ(position.x, position.y, position.z), validator.getMaxRadius(object).value(),
+      indices, distances);
+    if (num_neighbors) {
+      num_neighbors->push_back(indices.size());
+    }
+    pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
+    for (const auto index : indices) {
+      neighbor_pointcloud->push_back(obstacle_pointcloud->at(index));
+    }
+    counts.push_back(cropHull(object, neighbor_pointcloud, true));
+  }
+  return counts;
+}
+
+#endif  // OBSTACLE_POINTCLOUD__KDTREE_REFERENCE_HPP_
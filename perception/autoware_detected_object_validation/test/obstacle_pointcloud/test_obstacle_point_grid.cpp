@@ -0,0 +1,278 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../../src/obstacle_pointcloud/obstacle_point_grid.hpp"
+#include "../../src/obstacle_pointcloud/obstacle_pointcloud_validator.hpp"
+#include "kdtree_reference.hpp"
+
+#include <autoware_utils/geometry/boost_polygon_utils.hpp>
+
+#include <gtest/gtest.h>
+#include <pcl/point_cloud.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using autoware::detected_object_validation::obstacle_pointcloud::ObjectDebugPointCloud;
+using autoware::detected_object_validation::obstacle_pointcloud::ObstaclePointGrid;
+using autoware::detected_object_validation::obstacle_pointcloud::PointsNumThresholdParam;
+using autoware::detected_object_validation::obstacle_pointcloud::Validator;
+using autoware::detected_object_validation::obstacle_pointcloud::Validator2D;
+using autoware::detected_object_validation::obstacle_pointcloud::Validator3D;
+using autoware_perception_msgs::msg::DetectedObject;
+using autoware_perception_msgs::msg::Shape;
+
+namespace
+{
+sensor_msgs::msg::PointCloud2 toMsg(const pcl::PointCloud<pcl::PointXYZ> & cloud)
+{
+  sensor_msgs::msg::PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  return msg;
+}
+
+size_t countInBox(
+  const ObstaclePointGrid & grid, const double min_x, const double min_y, const double max_x,
+  const double max_y)
+{
+  size_t count = 0;
+  grid.forEachPointInBox(min_x, min_y, max_x, max_y, [&](const pcl::PointXYZ & point) {
+    if (point.x >= min_x && point.x <= max_x && point.y >= min_y && point.y <= max_y) {
+      ++count;
+    }
+  });
+  return count;
+}
+
+PointsNumThresholdParam createParam()
+{
+  PointsNumThresholdParam param;
+  param.min_points_num = std::vector<int64_t>(8, 10);
+  param.max_points_num = std::vector<int64_t>(8, 10);
+  param.min_points_and_distance_ratio = std::vector<double>(8, 800.0);
+  return param;
+}
+
+// boxes, cylinders and convex polygons with random poses and sizes
+std::vector<DetectedObject> createRandomObjects(
+  const std::size_t num_objects, std::mt19937 & engine)
+{
+  std::uniform_real_distribution<double> position_distribution(-30.0, 30.0);
+  std::uniform_real_distribution<double> height_distribution(0.0, 2.0);
+  std::uniform_real_distribution<double> yaw_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size_distribution(0.3, 5.0);
+  std::uniform_real_distribution<double> unit_distribution(0.0, 1.0);
+  std::uniform_int_distribution<int> num_vertices_distribution(3, 8);
+
+  std::vector<DetectedObject> objects(num_objects);
+  for (std::size_t i = 0; i < num_objects; ++i) {
+    auto & object = objects[i];
+    auto & pose = object.kinematics.pose_with_covariance.pose;
+    pose.position.x = position_distribution(engine);
+    pose.position.y = position_distribution(engine);
+    pose.position.z = height_distribution(engine);
+    const double yaw = yaw_distribution(engine);
+    pose.orientation.z = std::sin(yaw / 2.0);
+    pose.orientation.w = std::cos(yaw / 2.0);
+    object.shape.dimensions.x = size_distribution(engine);
+    object.shape.dimensions.y = size_distribution(engine);
+    object.shape.dimensions.z = size_distribution(engine);
+    if (i % 3 == 0) {
+      object.shape.type = Shape::BOUNDING_BOX;
+    } else if (i % 3 == 1) {
+      object.shape.type = Shape::CYLINDER;
+      object.shape.dimensions.y = object.shape.dimensions.x;
+    } else {
+      // the vertices on an ellipse around the origin make a convex footprint
+      object.shape.type = Shape::POLYGON;
+      const int num_vertices = num_vertices_distribution(engine);
+      for (int j = 0; j < num_vertices; ++j) {
+        const double angle = 2.0 * M_PI * (j + 0.8 * unit_distribution(engine)) / num_vertices;
+        geometry_msgs::msg::Point32 vertex;
+        vertex.x = 0.5 * object.shape.dimensions.x * std::cos(angle);
+        vertex.y = 0.5 * object.shape.dimensions.y * std::sin(angle);
+        object.shape.footprint.points.push_back(vertex);
+      }
+    }
+  }
+  return objects;
+}
+
+// The points are spread over the search area of each object, and some are put just inside and just
+// outside the search radius and the corners of the object, so that a point which the validator
+// and the previous path classify differently would be caught. The relative offsets from the
+// boundaries are far larger than the float rounding of the previous path.
+sensor_msgs::msg::PointCloud2::ConstSharedPtr createCloudAroundObjects(
+  const std::vector<DetectedObject> & objects, const Validator & validator, const bool is_3d,
+  std::mt19937 & engine)
+{
+  std::uniform_real_distribution<double> symmetric_distribution(-1.0, 1.0);
+  std::uniform_real_distribution<double> offset_distribution(1e-3, 1e-2);
+  std::uniform_real_distribution<float> background_distribution(-40.0f, 40.0f);
+  std::normal_distribution<double> direction_distribution(0.0, 1.0);
+  // a random relative offset from a boundary, inward or outward
+  const auto getBoundaryScale = [&]() {
+    const double offset = offset_distribution(engine);
+    return symmetric_distribution(engine) < 0.0 ? 1.0 - offset : 1.0 + offset;
+  };
+
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  for (const auto & object : objects) {
+    const auto & position = object.kinematics.pose_with_covariance.pose.position;
+    const double radius = validator.getMaxRadius(object).value();
+    for (int i = 0; i < 300; ++i) {
+      cloud.push_back(pcl::PointXYZ(
+        position.x + 1.2 * radius * symmetric_distribution(engine),
+        position.y + 1.2 * radius * symmetric_distribution(engine),
+        position.z + 1.2 * radius * symmetric_distribution(engine)));
+    }
+    // around the search sphere of the 3D validator, or the search circle of the 2D validator
+    for (int i = 0; i < 200; ++i) {
+      const double dx = direction_distribution(engine);
+      const double dy = direction_distribution(engine);
+      const double dz = is_3d ? direction_distribution(engine) : 0.0;
+      const double scale = radius * getBoundaryScale() / std::sqrt(dx * dx + dy * dy + dz * dz);
+      cloud.push_back(pcl::PointXYZ(
+        position.x + dx * scale, position.y + dy * scale,
+        is_3d ? position.z + dz * scale : position.z + radius * symmetric_distribution(engine)));
+    }
+    // around the corners of the footprint, at the top and the bottom of the search sphere
+    const auto polygon =
+      autoware_utils::to_polygon2d(object.kinematics.pose_with_covariance.pose, object.shape);
+    for (const auto & vertex : polygon.outer()) {
+      for (const double side : {-1.0, 1.0}) {
+        const double scale = getBoundaryScale();
+        const double dz = is_3d ? side * 0.5 * object.shape.dimensions.z
+                                : radius * symmetric_distribution(engine);
+        cloud.push_back(pcl::PointXYZ(
+          position.x + (vertex.x() - position.x) * scale,
+          position.y + (vertex.y() - position.y) * scale, position.z + dz * scale));
+      }
+    }
+  }
+  for (int i = 0; i < 5000; ++i) {
+    cloud.push_back(pcl::PointXYZ(
+      background_distribution(engine), background_distribution(engine),
+      background_distribution(engine) / 20.0f));
+  }
+  auto msg = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  pcl::toROSMsg(cloud, *msg);
+  return msg;
+}
+}  // namespace
+
+TEST(ObstaclePointGridTest, EmptyCloud)
+{
+  ObstaclePointGrid grid;
+  grid.build(toMsg(pcl::PointCloud<pcl::PointXYZ>{}));
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(countInBox(grid, -10.0, -10.0, 10.0, 10.0), 0U);
+}
+
+TEST(ObstaclePointGridTest, SkipNonFinitePoints)
+{
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  cloud.push_back(pcl::PointXYZ(1.0f, 1.0f, 0.0f));
+  cloud.push_back(pcl::PointXYZ(NAN, 1.0f, 0.0f));
+  cloud.push_back(pcl::PointXYZ(1.0f, INFINITY, 0.0f));
+
+  ObstaclePointGrid grid;
+  grid.build(toMsg(cloud));
+  EXPECT_EQ(grid.size(), 1U);
+  EXPECT_EQ(countInBox(grid, 0.0, 0.0, 2.0, 2.0), 1U);
+  // outside of the grid
+  EXPECT_EQ(countInBox(grid, 10.0, 10.0, 20.0, 20.0), 0U);
+}
+
+// every point in the box must be visited, whatever the cells are
+TEST(ObstaclePointGridTest, AgreeWithBruteForce)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> position_distribution(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> size_distribution(0.0f, 8.0f);
+
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  for (int i = 0; i < 20000; ++i) {
+    cloud.push_back(
+      pcl::PointXYZ(position_distribution(engine), position_distribution(engine), 0.0f));
+  }
+  // a far point which makes the cells larger than the default
+  cloud.push_back(pcl::PointXYZ(5000.0f, -5000.0f, 0.0f));
+
+  ObstaclePointGrid grid(0.5);
+  grid.build(toMsg(cloud));
+  EXPECT_EQ(grid.size(), cloud.size());
+  EXPECT_GT(grid.getCellSize(), 0.5);
+
+  for (int i = 0; i < 200; ++i) {
+    const double min_x = position_distribution(engine);
+    const double min_y = position_distribution(engine);
+    const double max_x = min_x + size_distribution(engine);
+    const double max_y = min_y + size_distribution(engine);
+    size_t expected = 0;
+    for (const auto & point : cloud) {
+      if (point.x >= min_x && point.x <= max_x && point.y >= min_y && point.y <= max_y) {
+        ++expected;
+      }
+    }
+    ASSERT_EQ(countInBox(grid, min_x, min_y, max_x, max_y), expected);
+  }
+}
+
+// the validators must count the points found by the previous k-d tree and CropHull path
+TEST(ObstaclePointCloudValidatorTest, AgreeWithKdtreeAndCropHull)
+{
+  auto param = createParam();
+  Validator2D validator_2d(param);
+  Validator3D validator_3d(param);
+  std::mt19937 engine(0);
+
+  for (int trial = 0; trial < 5; ++trial) {
+    const auto objects = createRandomObjects(30, engine);
+    for (const bool is_3d : {false, true}) {
+      Validator & validator = is_3d ? static_cast<Validator &>(validator_3d) : validator_2d;
+      const auto msg = createCloudAroundObjects(objects, validator, is_3d, engine);
+      std::vector<std::size_t> expected_num_neighbors;
+      const auto expected_counts =
+        is_3d ? countWithKdtree3D(*msg, objects, validator, &expected_num_neighbors)
+              : countWithKdtree2D(*msg, objects, validator, &expected_num_neighbors);
+      ASSERT_TRUE(validator.setInputCloud(msg));
+
+      std::size_t num_points_within_objects = 0;
+      for (std::size_t i = 0; i < objects.size(); ++i) {
+        const auto & object = objects[i];
+        const float search_radius = validator.getMaxRadius(object).value();
+        const auto count = validator.getPointCloudWithinObject(object, search_radius, nullptr);
+        ASSERT_TRUE(count);
+        EXPECT_EQ(count.value(), expected_counts[i])
+          << "trial " << trial << ", 3D " << is_3d << ", object " << i;
+
+        // the debugger searches the whole radius for the neighbor points
+        ObjectDebugPointCloud debug_pointcloud;
+        const auto debug_count =
+          validator.getPointCloudWithinObject(object, search_radius, &debug_pointcloud);
+        ASSERT_TRUE(debug_count);
+        EXPECT_EQ(debug_count.value(), expected_counts[i]);
+        EXPECT_EQ(debug_pointcloud.neighbor_pointcloud->size(), expected_num_neighbors[i])
+          << "trial " << trial << ", 3D " << is_3d << ", object " << i;
+        EXPECT_EQ(debug_pointcloud.pointcloud_within_object->size(), expected_counts[i]);
+        num_points_within_objects += expected_counts[i];
+      }
+      EXPECT_GT(num_points_within_objects, 0U);
+    }
+  }
+}
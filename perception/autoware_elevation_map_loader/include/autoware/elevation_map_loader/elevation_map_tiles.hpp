@@ -0,0 +1,173 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__ELEVATION_MAP_LOADER__ELEVATION_MAP_TILES_HPP_
+#define AUTOWARE__ELEVATION_MAP_LOADER__ELEVATION_MAP_TILES_HPP_
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace autoware::elevation_map_loader
+{
+
+/*
+ * Tiled elevation map format
+ *
+ * The elevation is sampled on a lattice aligned with the origin of the map frame, the sample (i, j)
+ * being at (i * resolution, j * resolution). The lattice is split into square tiles of tile_size
+ * cells, the tile (tile_x, tile_y) covering
+ * [tile_x * tile_size * resolution, (tile_x + 1) * tile_size * resolution) in x, and the same in y.
+ * A tile stores the (tile_size + 1) x (tile_size + 1) samples on its border and inside, so that the
+ * bilinear interpolation of any position in the tile reads only the tile. The samples are floats
+ * stored row by row in y, NaN where the elevation is unknown.
+ *
+ * Each tile is a file "tile_<tile_x>_<tile_y>.bin" made of an ElevationMapTileHeader followed by
+ * the samples, so that the samples of a memory-mapped tile are used in place. The file "index.bin"
+ * made of an ElevationMapTileIndexHeader followed by the tile coordinates lists the tiles of the
+ * map, and is written after the tiles. The index records a hash of the tiles, so that a reader
+ * tells a rewritten map from the map it opened.
+ */
+
+constexpr std::uint32_t elevation_map_tile_version = 2;
+
+struct ElevationMapTileHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t tile_size;
+  std::int32_t tile_x;
+  std::int32_t tile_y;
+  double resolution;
+  // the key of the points and parameters the tile was built from, used as the build cache key
+  std::uint64_t source_hash;
+};
+
+struct ElevationMapTileIndexHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t tile_size;
+  double resolution;
+  std::uint64_t num_tiles;
+  // the hash of the source hashes of the tiles, which changes when a tile of the map changes
+  std::uint64_t map_hash;
+};
+
+struct ElevationMapTileCoordinate
+{
+  std::int32_t tile_x;
+  std::int32_t tile_y;
+};
+
+std::string getElevationMapTileFileName(const std::int32_t tile_x, const std::int32_t tile_y);
+
+/** \brief The number of samples of a tile, (tile_size + 1)^2 */
+std::size_t getNumTileSamples(const std::uint32_t tile_size);
+
+/** \brief Write a tile atomically, through a temporary file renamed over the tile */
+bool writeElevationMapTile(
+  const std::filesystem::path & directory, const ElevationMapTileHeader & header,
+  const std::vector<float> & samples);
+
+/** \brief The header of a valid tile file, std::nullopt if the file is missing or broken */
+std::optional<ElevationMapTileHeader> readElevationMapTileHeader(
+  const std::filesystem::path & tile_path);
+
+bool writeElevationMapTileIndex(
+  const std::filesystem::path & directory, const std::uint32_t tile_size, const double resolution,
+  const std::vector<ElevationMapTileCoordinate> & tiles, const std::uint64_t map_hash);
+
+/** \brief The header of a valid index in the directory, std::nullopt if it is missing or broken */
+std::optional<ElevationMapTileIndexHeader> readElevationMapTileIndexHeader(
+  const std::filesystem::path & directory);
+
+/** \brief 64-bit FNV-1a hash of a byte range, chained through the seed */
+std::uint64_t hashBytes(
+  const void * data, const std::size_t size, const std::uint64_t seed = 14695981039346656037ULL);
+
+/**
+ * \brief Read-only view of a tiled elevation map which maps the tiles on demand.
+ *
+ * Only the tiles around the last queried area are mapped, so that the memory used does not depend
+ * on the size of the map. The samples are read in place from the mapped files and the pages are
+ * shared with the page cache.
+ */
+class TiledElevationMap
+{
+public:
+  /** \brief Read the index of the map in the directory, without mapping any tile */
+  bool open(const std::filesystem::path & directory);
+  bool isOpen() const { return !tile_exists_.empty(); }
+
+  /**
+   * \brief Map the tiles overlapping the area expanded by margin tiles and unmap the others.
+   * \return the number of mapped tiles
+   */
+  std::size_t updateWindow(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    const int margin = 1);
+
+  /**
+   * \brief Bilinear interpolation of the elevation at the positions (xs[i], ys[i]).
+   *
+   * The heights are NaN outside the mapped tiles and where a surrounding sample is unknown.
+   */
+  void computeHeights(
+    const float * xs, const float * ys, const std::size_t size, float * heights) const;
+
+  double getResolution() const { return resolution_; }
+  std::uint32_t getTileSize() const { return tile_size_; }
+  std::size_t getNumTiles() const { return num_tiles_; }
+  std::uint64_t getMapHash() const { return map_hash_; }
+  std::size_t getNumMappedTiles() const { return mapped_slots_.size(); }
+
+private:
+  void unmapTile(const std::size_t slot);
+  bool mapTile(const std::size_t slot);
+
+  std::filesystem::path directory_;
+  double resolution_{0.0};
+  double inverse_resolution_{0.0};
+  std::uint32_t tile_size_{0};
+  std::size_t num_tiles_{0};
+  std::uint64_t map_hash_{0};
+
+  // the tiles are kept in a dense table over the bounding box of the tiles of the map
+  std::int32_t min_tile_x_{0};
+  std::int32_t min_tile_y_{0};
+  std::int32_t num_tiles_x_{0};
+  std::int32_t num_tiles_y_{0};
+  std::vector<std::uint8_t> tile_exists_;
+  std::vector<std::unique_ptr<boost::iostreams::mapped_file_source>> mapped_tiles_;
+  // the samples of each mapped tile, nullptr for the others
+  std::vector<const float *> tile_samples_;
+  std::vector<std::size_t> mapped_slots_;
+
+  // buffers of computeHeights
+  mutable std::vector<std::int32_t> slots_;
+  mutable std::vector<std::int32_t> offsets_;
+  mutable std::vector<float> weights_x_;
+  mutable std::vector<float> weights_y_;
+};
+
+}  // namespace autoware::elevation_map_loader
+
+#endif  // AUTOWARE__ELEVATION_MAP_LOADER__ELEVATION_MAP_TILES_HPP_
@@ -16,6 +16,7 @@
 
 #include "elevation_map_loader_node.hpp"
 
+#include "autoware/elevation_map_loader/elevation_map_tiles.hpp"
 #include "autoware/grid_map_utils/polygon_iterator.hpp"
 
 #include <Eigen/Core>
@@ -43,10 +44,18 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <sensor_msgs/msg/point_cloud2.h>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -77,6 +86,15 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
   use_elevation_map_cloud_publisher_ =
     this->declare_parameter("use_elevation_map_cloud_publisher", false);
   elevation_map_directory_ = this->declare_parameter("elevation_map_directory", "path_default");
+  use_tiled_elevation_map_ = this->declare_parameter("use_tiled_elevation_map", false);
+  elevation_map_tile_directory_ =
+    this->declare_parameter("elevation_map_tile_directory", "path_default");
+  const int tile_size = this->declare_parameter<int>("tile_size", 128);
+  if (tile_size > 0) {
+    tile_size_ = static_cast<std::uint32_t>(tile_size);
+  } else {
+    throw std::runtime_error("tile_size should be larger than 0.");
+  }
   const bool use_lane_filter = this->declare_parameter("use_lane_filter", false);
   data_manager_.use_lane_filter_ = use_lane_filter;
 
@@ -133,6 +151,13 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
 
 void ElevationMapLoaderNode::publish()
 {
+  if (use_tiled_elevation_map_) {
+    // the filters read the tiles from the directory, the whole map is neither built nor published
+    createTiledElevationMap();
+    is_elevation_map_published_ = true;
+    return;
+  }
+
   struct stat info;
   if (stat(data_manager_.elevation_map_path_->c_str(), &info) != 0) {
     RCLCPP_INFO(this->get_logger(), "Starting elevation map generation from pointcloud map");
@@ -344,7 +369,10 @@ void ElevationMapLoaderNode::createElevationMap()
     elevation_map_ = grid_map_pcl_loader->getGridMap();
   }
   if (use_inpaint_) {
-    inpaintElevationMap(inpaint_radius_);
+    RCLCPP_INFO(
+      this->get_logger(), "Starting elevation map inpainting (radius: %.2f)", inpaint_radius_);
+    inpaintElevationMap(elevation_map_, lane_filter_.road_lanelets_, inpaint_radius_);
+    RCLCPP_INFO(this->get_logger(), "Elevation map inpainting has been completed");
   }
   saveElevationMap();
 }
@@ -360,19 +388,227 @@ void ElevationMapLoaderNode::createElevationMapFromPointcloud(
     start, "Elevation map generation completed. Processing time: ", this->get_logger());
 }
 
-void ElevationMapLoaderNode::inpaintElevationMap(const float radius)
+double ElevationMapLoaderNode::getGridMapResolution() const
+{
+  // the resolution is given by the GridMap parameters, read through the geometry of a small cloud
+  grid_map::GridMapPclLoader grid_map_pcl_loader(rclcpp::get_logger("grid_map_logger"));
+  grid_map_pcl_loader.loadParameters(param_file_path_);
+  auto cloud = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  cloud->push_back(pcl::PointXYZ(0.0, 0.0, 0.0));
+  cloud->push_back(pcl::PointXYZ(1.0, 1.0, 0.0));
+  grid_map_pcl_loader.setInputCloud(cloud);
+  grid_map_pcl_loader.initializeGridMapGeometryFromInputCloud();
+  return grid_map_pcl_loader.getGridMap().getResolution();
+}
+
+void ElevationMapLoaderNode::createTiledElevationMap()
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  const std::filesystem::path directory(elevation_map_tile_directory_);
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    RCLCPP_ERROR(
+      this->get_logger(), "Failed to create the elevation map tile directory %s: %s",
+      directory.c_str(), error.message().c_str());
+    return;
+  }
+
+  const double resolution = getGridMapResolution();
+  const double tile_length = resolution * tile_size_;
+  // the points around a tile are used for the clusters and the inpainting near its border
+  const double margin = (use_inpaint_ ? inpaint_radius_ : 0.0) + 2.0 * resolution;
+  const auto toTile = [&](const double value) {
+    return static_cast<std::int32_t>(std::floor(value / tile_length));
+  };
+
+  // the points of each tile and of its margin, the tiles of the map are the tiles with points
+  using TileKey = std::pair<std::int32_t, std::int32_t>;
+  const auto & points = data_manager_.map_pcl_ptr_->points;
+  std::map<TileKey, std::vector<std::size_t>> tile_point_indices;
+  std::set<TileKey> map_tiles;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto & point = points[i];
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      continue;
+    }
+    map_tiles.emplace(toTile(point.x), toTile(point.y));
+    for (std::int32_t tile_y = toTile(point.y - margin); tile_y <= toTile(point.y + margin);
+         ++tile_y) {
+      for (std::int32_t tile_x = toTile(point.x - margin); tile_x <= toTile(point.x + margin);
+           ++tile_x) {
+        tile_point_indices[{tile_x, tile_y}].push_back(i);
+      }
+    }
+  }
+
+  // the build cache key of a tile covers its points, its lanelets and the parameters
+  std::uint64_t settings_hash = hashBytes(layer_name_.data(), layer_name_.size());
+  {
+    std::ifstream param_file(param_file_path_, std::ios::binary);
+    const std::string param_file_content(
+      (std::istreambuf_iterator<char>(param_file)), std::istreambuf_iterator<char>());
+    settings_hash = hashBytes(param_file_content.data(), param_file_content.size(), settings_hash);
+    const double settings[] = {
+      resolution, static_cast<double>(tile_size_), static_cast<double>(use_inpaint_),
+      inpaint_radius_, static_cast<double>(lane_filter_.use_lane_filter_),
+      lane_filter_.lane_margin_};
+    settings_hash = hashBytes(settings, sizeof(settings), settings_hash);
+  }
+  struct LaneletBox
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+  std::vector<LaneletBox> lanelet_boxes;
+  if (lane_filter_.use_lane_filter_) {
+    for (const auto & lanelet : lane_filter_.road_lanelets_) {
+      LaneletBox box{
+        std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+      for (const auto & p : lanelet.polygon2d().basicPolygon()) {
+        box.min_x = std::min(box.min_x, p.x() - lane_filter_.lane_margin_);
+        box.min_y = std::min(box.min_y, p.y() - lane_filter_.lane_margin_);
+        box.max_x = std::max(box.max_x, p.x() + lane_filter_.lane_margin_);
+        box.max_y = std::max(box.max_y, p.y() + lane_filter_.lane_margin_);
+      }
+      lanelet_boxes.push_back(box);
+    }
+  }
+
+  auto grid_map_logger = rclcpp::get_logger("grid_map_logger");
+  grid_map_logger.set_level(rclcpp::Logger::Level::Error);
+  std::vector<ElevationMapTileCoordinate> tiles;
+  std::size_t num_built_tiles = 0;
+  // the identity of the map in the index, so that the filters open the map again when it changes
+  std::uint64_t map_hash = settings_hash;
+  for (const auto & tile : map_tiles) {
+    const auto [tile_x, tile_y] = tile;
+    const auto & point_indices = tile_point_indices.at(tile);
+    tiles.push_back({tile_x, tile_y});
+    const double min_x = tile_x * tile_length - margin;
+    const double min_y = tile_y * tile_length - margin;
+    const double max_x = (tile_x + 1) * tile_length + margin;
+    const double max_y = (tile_y + 1) * tile_length + margin;
+
+    std::uint64_t source_hash = settings_hash;
+    for (const auto i : point_indices) {
+      const float xyz[] = {points[i].x, points[i].y, points[i].z};
+      source_hash = hashBytes(xyz, sizeof(xyz), source_hash);
+    }
+    lanelet::ConstLanelets road_lanelets;
+    for (std::size_t i = 0; i < lanelet_boxes.size(); ++i) {
+      const auto & box = lanelet_boxes[i];
+      if (box.min_x <= max_x && box.min_y <= max_y && box.max_x >= min_x && box.max_y >= min_y) {
+        const auto & lanelet = lane_filter_.road_lanelets_[i];
+        road_lanelets.push_back(lanelet);
+        for (const auto & p : lanelet.polygon2d().basicPolygon()) {
+          const double xy[] = {p.x(), p.y()};
+          source_hash = hashBytes(xy, sizeof(xy), source_hash);
+        }
+      }
+    }
+
+    map_hash = hashBytes(&tiles.back(), sizeof(tiles.back()), map_hash);
+    map_hash = hashBytes(&source_hash, sizeof(source_hash), map_hash);
+
+    const auto header = readElevationMapTileHeader(
+      directory / getElevationMapTileFileName(tile_x, tile_y));
+    if (
+      header && header->source_hash == source_hash && header->tile_size == tile_size_ &&
+      header->resolution == resolution) {
+      continue;
+    }
+
+    auto tile_cloud = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+    tile_cloud->points.reserve(point_indices.size());
+    for (const auto i : point_indices) {
+      tile_cloud->points.push_back(points[i]);
+    }
+    tile_cloud->width = tile_cloud->points.size();
+    tile_cloud->height = 1;
+    grid_map::GridMap tile_map;
+    {
+      grid_map::GridMapPclLoader grid_map_pcl_loader(grid_map_logger);
+      grid_map_pcl_loader.loadParameters(param_file_path_);
+      grid_map_pcl_loader.setInputCloud(tile_cloud);
+      grid_map_pcl_loader.preProcessInputCloud();
+      grid_map_pcl_loader.initializeGridMapGeometryFromInputCloud();
+      grid_map_pcl_loader.addLayerFromInputCloud(layer_name_);
+      tile_map = grid_map_pcl_loader.getGridMap();
+    }
+    if (use_inpaint_ && tile_map.get(layer_name_).array().isFinite().any()) {
+      inpaintElevationMap(tile_map, road_lanelets, inpaint_radius_);
+    }
+
+    // resample the elevation on the samples of the tile
+    std::vector<float> samples;
+    samples.reserve(getNumTileSamples(tile_size_));
+    for (std::uint32_t j = 0; j <= tile_size_; ++j) {
+      for (std::uint32_t i = 0; i <= tile_size_; ++i) {
+        const grid_map::Position position(
+          (static_cast<double>(tile_x) * tile_size_ + i) * resolution,
+          (static_cast<double>(tile_y) * tile_size_ + j) * resolution);
+        samples.push_back(
+          tile_map.isInside(position)
+            ? tile_map.atPosition(
+                layer_name_, position, grid_map::InterpolationMethods::INTER_LINEAR)
+            : std::numeric_limits<float>::quiet_NaN());
+      }
+    }
+    ElevationMapTileHeader tile_header{};
+    tile_header.tile_size = tile_size_;
+    tile_header.tile_x = tile_x;
+    tile_header.tile_y = tile_y;
+    tile_header.resolution = resolution;
+    tile_header.source_hash = source_hash;
+    if (!writeElevationMapTile(directory, tile_header, samples)) {
+      RCLCPP_ERROR(
+        this->get_logger(), "Failed to write the elevation map tile (%d, %d)", tile_x, tile_y);
+    }
+    ++num_built_tiles;
+  }
+
+  // the tiles of a previous map are removed
+  std::unordered_set<std::string> tile_file_names;
+  tile_file_names.reserve(tiles.size());
+  for (const auto & tile : tiles) {
+    tile_file_names.insert(getElevationMapTileFileName(tile.tile_x, tile.tile_y));
+  }
+  for (const auto & entry : std::filesystem::directory_iterator(directory, error)) {
+    const auto file_name = entry.path().filename().string();
+    if (file_name.rfind("tile_", 0) == 0 && tile_file_names.count(file_name) == 0) {
+      std::filesystem::remove(entry.path(), error);
+    }
+  }
+  if (!writeElevationMapTileIndex(directory, tile_size_, resolution, tiles, map_hash)) {
+    RCLCPP_ERROR(this->get_logger(), "Failed to write the elevation map tile index");
+    return;
+  }
+  grid_map::grid_map_pcl::printTimeElapsedToRosInfoStream(
+    start,
+    "Tiled elevation map has been written to " + directory.string() + ", " +
+      std::to_string(num_built_tiles) + " of " + std::to_string(tiles.size()) +
+      " tiles built. Processing time: ",
+    this->get_logger());
+}
+
+void ElevationMapLoaderNode::inpaintElevationMap(
+  grid_map::GridMap & elevation_map, const lanelet::ConstLanelets & road_lanelets,
+  const float radius) const
 {
-  RCLCPP_INFO(this->get_logger(), "Starting elevation map inpainting (radius: %.2f)", radius);
   // Convert elevation layer to OpenCV image to fill in holes.
   // Get the inpaint mask (nonzero pixels indicate where values need to be filled in).
   namespace bg = boost::geometry;
   using autoware_utils::Point2d;
 
-  elevation_map_.add("inpaint_mask", 0.0);
+  elevation_map.add("inpaint_mask", 0.0);
 
-  elevation_map_.setBasicLayers(std::vector<std::string>());
+  elevation_map.setBasicLayers(std::vector<std::string>());
   if (lane_filter_.use_lane_filter_) {
-    for (const auto & lanelet : lane_filter_.road_lanelets_) {
+    for (const auto & lanelet : road_lanelets) {
       auto lane_polygon = lanelet.polygon2d().basicPolygon();
       grid_map::Polygon polygon;
 
@@ -392,38 +628,37 @@ void ElevationMapLoaderNode::inpaintElevationMap(const float radius)
       for (const auto & p : lane_polygon) {
         polygon.addVertex(grid_map::Position(p[0], p[1]));
       }
-      for (autoware::grid_map_utils::PolygonIterator iterator(elevation_map_, polygon);
+      for (autoware::grid_map_utils::PolygonIterator iterator(elevation_map, polygon);
            !iterator.isPastEnd(); ++iterator) {
-        if (!elevation_map_.isValid(*iterator, layer_name_)) {
-          elevation_map_.at("inpaint_mask", *iterator) = 1.0;
+        if (!elevation_map.isValid(*iterator, layer_name_)) {
+          elevation_map.at("inpaint_mask", *iterator) = 1.0;
         }
       }
     }
   } else {
-    for (grid_map::GridMapIterator iterator(elevation_map_); !iterator.isPastEnd(); ++iterator) {
-      if (!elevation_map_.isValid(*iterator, layer_name_)) {
-        elevation_map_.at("inpaint_mask", *iterator) = 1.0;
+    for (grid_map::GridMapIterator iterator(elevation_map); !iterator.isPastEnd(); ++iterator) {
+      if (!elevation_map.isValid(*iterator, layer_name_)) {
+        elevation_map.at("inpaint_mask", *iterator) = 1.0;
       }
     }
   }
   cv::Mat original_image;
   cv::Mat mask;
   cv::Mat filled_image;
-  const float min_value = elevation_map_.get(layer_name_).minCoeffOfFinites();
-  const float max_value = elevation_map_.get(layer_name_).maxCoeffOfFinites();
+  const float min_value = elevation_map.get(layer_name_).minCoeffOfFinites();
+  const float max_value = elevation_map.get(layer_name_).maxCoeffOfFinites();
 
   grid_map::GridMapCvConverter::toImage<unsigned char, 3>(
-    elevation_map_, layer_name_, CV_8UC3, min_value, max_value, original_image);
+    elevation_map, layer_name_, CV_8UC3, min_value, max_value, original_image);
   grid_map::GridMapCvConverter::toImage<unsigned char, 1>(
-    elevation_map_, "inpaint_mask", CV_8UC1, mask);
+    elevation_map, "inpaint_mask", CV_8UC1, mask);
 
-  const float radius_in_pixels = radius / elevation_map_.getResolution();
+  const float radius_in_pixels = radius / elevation_map.getResolution();
   cv::inpaint(original_image, mask, filled_image, radius_in_pixels, cv::INPAINT_NS);
 
   grid_map::GridMapCvConverter::addLayerFromImage<unsigned char, 3>(
-    filled_image, layer_name_, elevation_map_, min_value, max_value);
-  elevation_map_.erase("inpaint_mask");
-  RCLCPP_INFO(this->get_logger(), "Elevation map inpainting has been completed");
+    filled_image, layer_name_, elevation_map, min_value, max_value);
+  elevation_map.erase("inpaint_mask");
 }
 
 pcl::PointCloud<pcl::PointXYZ>::Ptr ElevationMapLoaderNode::createPointcloudFromElevationMap()
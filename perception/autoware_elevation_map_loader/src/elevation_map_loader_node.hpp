@@ -33,6 +33,7 @@
 #include <pcl/pcl_base.h>
 #include <pcl/point_types.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -94,7 +95,11 @@ private:
   void setVerbosityLevelToDebugIfFlagSet();
   void createElevationMapFromPointcloud(
     const pcl::shared_ptr<grid_map::GridMapPclLoader> & grid_map_pcl_loader);
-  void inpaintElevationMap(const float radius);
+  void createTiledElevationMap();
+  double getGridMapResolution() const;
+  void inpaintElevationMap(
+    grid_map::GridMap & elevation_map, const lanelet::ConstLanelets & road_lanelets,
+    const float radius) const;
   pcl::PointCloud<pcl::PointXYZ>::Ptr createPointcloudFromElevationMap();
   void saveElevationMap();
 
@@ -106,6 +111,9 @@ private:
   float inpaint_radius_;
   unsigned int sequential_map_load_num_;
   bool use_elevation_map_cloud_publisher_;
+  bool use_tiled_elevation_map_;
+  std::string elevation_map_tile_directory_;
+  std::uint32_t tile_size_;
   std::string param_file_path_;
   bool is_map_metadata_received_ = false;
   bool is_map_received_ = false;
@@ -0,0 +1,375 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/elevation_map_loader/elevation_map_tiles.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace autoware::elevation_map_loader
+{
+namespace
+{
+constexpr char tile_magic[8] = {'A', 'W', 'E', 'M', 'T', 'I', 'L', 'E'};
+constexpr char index_magic[8] = {'A', 'W', 'E', 'M', 'I', 'N', 'D', 'X'};
+constexpr char index_file_name[] = "index.bin";
+
+std::size_t getTileFileSize(const std::uint32_t tile_size)
+{
+  return sizeof(ElevationMapTileHeader) + getNumTileSamples(tile_size) * sizeof(float);
+}
+
+bool isValidIndexHeader(const ElevationMapTileIndexHeader & header)
+{
+  return std::memcmp(header.magic, index_magic, sizeof(index_magic)) == 0 &&
+         header.version == elevation_map_tile_version && header.tile_size != 0 &&
+         header.resolution > 0.0 && header.num_tiles != 0;
+}
+}  // namespace
+
+std::string getElevationMapTileFileName(const std::int32_t tile_x, const std::int32_t tile_y)
+{
+  return "tile_" + std::to_string(tile_x) + "_" + std::to_string(tile_y) + ".bin";
+}
+
+std::size_t getNumTileSamples(const std::uint32_t tile_size)
+{
+  return (static_cast<std::size_t>(tile_size) + 1) * (static_cast<std::size_t>(tile_size) + 1);
+}
+
+bool writeElevationMapTile(
+  const std::filesystem::path & directory, const ElevationMapTileHeader & header,
+  const std::vector<float> & samples)
+{
+  if (samples.size() != getNumTileSamples(header.tile_size)) {
+    return false;
+  }
+  ElevationMapTileHeader file_header = header;
+  std::memcpy(file_header.magic, tile_magic, sizeof(tile_magic));
+  file_header.version = elevation_map_tile_version;
+
+  const auto tile_path =
+    directory / getElevationMapTileFileName(file_header.tile_x, file_header.tile_y);
+  auto temporary_path = tile_path;
+  temporary_path += ".tmp";
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&file_header), sizeof(file_header));
+    file.write(
+      reinterpret_cast<const char *>(samples.data()),
+      static_cast<std::streamsize>(samples.size() * sizeof(float)));
+    if (!file.good()) {
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary_path, tile_path, error);
+  return !error;
+}
+
+std::optional<ElevationMapTileHeader> readElevationMapTileHeader(
+  const std::filesystem::path & tile_path)
+{
+  std::ifstream file(tile_path, std::ios::binary);
+  ElevationMapTileHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return std::nullopt;
+  }
+  std::error_code error;
+  const auto file_size = std::filesystem::file_size(tile_path, error);
+  if (
+    error || std::memcmp(header.magic, tile_magic, sizeof(tile_magic)) != 0 ||
+    header.version != elevation_map_tile_version || header.tile_size == 0 ||
+    file_size != getTileFileSize(header.tile_size)) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+bool writeElevationMapTileIndex(
+  const std::filesystem::path & directory, const std::uint32_t tile_size, const double resolution,
+  const std::vector<ElevationMapTileCoordinate> & tiles, const std::uint64_t map_hash)
+{
+  ElevationMapTileIndexHeader header;
+  std::memcpy(header.magic, index_magic, sizeof(index_magic));
+  header.version = elevation_map_tile_version;
+  header.tile_size = tile_size;
+  header.resolution = resolution;
+  header.num_tiles = tiles.size();
+  header.map_hash = map_hash;
+
+  const auto index_path = directory / index_file_name;
+  auto temporary_path = index_path;
+  temporary_path += ".tmp";
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(
+      reinterpret_cast<const char *>(tiles.data()),
+      static_cast<std::streamsize>(tiles.size() * sizeof(ElevationMapTileCoordinate)));
+    if (!file.good()) {
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary_path, index_path, error);
+  return !error;
+}
+
+std::optional<ElevationMapTileIndexHeader> readElevationMapTileIndexHeader(
+  const std::filesystem::path & directory)
+{
+  std::ifstream file(directory / index_file_name, std::ios::binary);
+  ElevationMapTileIndexHeader header;
+  if (
+    !file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    !isValidIndexHeader(header)) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+std::uint64_t hashBytes(const void * data, const std::size_t size, const std::uint64_t seed)
+{
+  constexpr std::uint64_t prime = 1099511628211ULL;
+  const auto * bytes = static_cast<const unsigned char *>(data);
+  std::uint64_t hash = seed;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * prime;
+  }
+  return hash;
+}
+
+bool TiledElevationMap::open(const std::filesystem::path & directory)
+{
+  for (const auto slot : mapped_slots_) {
+    unmapTile(slot);
+  }
+  mapped_slots_.clear();
+  tile_exists_.clear();
+  mapped_tiles_.clear();
+  tile_samples_.clear();
+  num_tiles_ = 0;
+  map_hash_ = 0;
+
+  // the header and the tiles are read from the same file, which the loader may replace meanwhile
+  std::ifstream file(directory / index_file_name, std::ios::binary);
+  ElevationMapTileIndexHeader header;
+  if (
+    !file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    !isValidIndexHeader(header)) {
+    return false;
+  }
+  std::vector<ElevationMapTileCoordinate> tiles(header.num_tiles);
+  if (!file.read(
+        reinterpret_cast<char *>(tiles.data()),
+        static_cast<std::streamsize>(tiles.size() * sizeof(ElevationMapTileCoordinate)))) {
+    return false;
+  }
+
+  std::int32_t max_tile_x = std::numeric_limits<std::int32_t>::lowest();
+  std::int32_t max_tile_y = std::numeric_limits<std::int32_t>::lowest();
+  min_tile_x_ = std::numeric_limits<std::int32_t>::max();
+  min_tile_y_ = std::numeric_limits<std::int32_t>::max();
+  for (const auto & tile : tiles) {
+    min_tile_x_ = std::min(min_tile_x_, tile.tile_x);
+    min_tile_y_ = std::min(min_tile_y_, tile.tile_y);
+    max_tile_x = std::max(max_tile_x, tile.tile_x);
+    max_tile_y = std::max(max_tile_y, tile.tile_y);
+  }
+  num_tiles_x_ = max_tile_x - min_tile_x_ + 1;
+  num_tiles_y_ = max_tile_y - min_tile_y_ + 1;
+  const auto num_slots = static_cast<std::size_t>(num_tiles_x_) * num_tiles_y_;
+
+  directory_ = directory;
+  tile_size_ = header.tile_size;
+  resolution_ = header.resolution;
+  inverse_resolution_ = 1.0 / header.resolution;
+  num_tiles_ = tiles.size();
+  map_hash_ = header.map_hash;
+  tile_exists_.assign(num_slots, 0);
+  mapped_tiles_.resize(num_slots);
+  tile_samples_.assign(num_slots, nullptr);
+  for (const auto & tile : tiles) {
+    tile_exists_
+      [static_cast<std::size_t>(tile.tile_y - min_tile_y_) * num_tiles_x_ + tile.tile_x -
+       min_tile_x_] = 1;
+  }
+  return true;
+}
+
+std::size_t TiledElevationMap::updateWindow(
+  const double min_x, const double min_y, const double max_x, const double max_y, const int margin)
+{
+  if (!isOpen()) {
+    return 0;
+  }
+  // the tile range in the table, empty when the area does not overlap the map
+  const double tile_length = resolution_ * tile_size_;
+  const auto toSlotRange = [&](const double min, const double max, const std::int32_t min_tile,
+                               const std::int32_t num_tiles) {
+    const double first = std::floor(min / tile_length) - margin - min_tile;
+    const double last = std::floor(max / tile_length) + margin - min_tile;
+    return std::make_pair(
+      static_cast<std::int32_t>(std::clamp(first, 0.0, static_cast<double>(num_tiles))),
+      static_cast<std::int32_t>(std::clamp(last, -1.0, static_cast<double>(num_tiles - 1))));
+  };
+  std::pair<std::int32_t, std::int32_t> range_x{0, -1};
+  std::pair<std::int32_t, std::int32_t> range_y{0, -1};
+  // also rejects NaN
+  if (min_x <= max_x && min_y <= max_y) {
+    range_x = toSlotRange(min_x, max_x, min_tile_x_, num_tiles_x_);
+    range_y = toSlotRange(min_y, max_y, min_tile_y_, num_tiles_y_);
+  }
+  const auto isInWindow = [&](const std::size_t slot) {
+    const auto slot_x = static_cast<std::int32_t>(slot % num_tiles_x_);
+    const auto slot_y = static_cast<std::int32_t>(slot / num_tiles_x_);
+    return range_x.first <= slot_x && slot_x <= range_x.second && range_y.first <= slot_y &&
+           slot_y <= range_y.second;
+  };
+
+  std::vector<std::size_t> kept_slots;
+  for (const auto slot : mapped_slots_) {
+    if (isInWindow(slot)) {
+      kept_slots.push_back(slot);
+    } else {
+      unmapTile(slot);
+    }
+  }
+  mapped_slots_ = std::move(kept_slots);
+
+  for (std::int32_t slot_y = range_y.first; slot_y <= range_y.second; ++slot_y) {
+    for (std::int32_t slot_x = range_x.first; slot_x <= range_x.second; ++slot_x) {
+      const auto slot = static_cast<std::size_t>(slot_y) * num_tiles_x_ + slot_x;
+      if (tile_exists_[slot] && !tile_samples_[slot] && mapTile(slot)) {
+        mapped_slots_.push_back(slot);
+      }
+    }
+  }
+  return mapped_slots_.size();
+}
+
+void TiledElevationMap::computeHeights(
+  const float * xs, const float * ys, const std::size_t size, float * heights) const
+{
+  if (!isOpen()) {
+    std::fill(heights, heights + size, std::numeric_limits<float>::quiet_NaN());
+    return;
+  }
+  slots_.resize(size);
+  offsets_.resize(size);
+  weights_x_.resize(size);
+  weights_y_.resize(size);
+
+  // the tile, the first sample and the weights of each position. The positions are taken from the
+  // corner of the table in float, and the loop is kept free of branches and of calls so that it is
+  // vectorized.
+  const auto origin_x = static_cast<float>(min_tile_x_ * resolution_ * tile_size_);
+  const auto origin_y = static_cast<float>(min_tile_y_ * resolution_ * tile_size_);
+  const auto inverse_resolution = static_cast<float>(inverse_resolution_);
+  const auto tile_size = static_cast<float>(tile_size_);
+  const float inverse_tile_size = 1.0f / tile_size;
+  const float num_samples_x = static_cast<float>(num_tiles_x_) * tile_size;
+  const float num_samples_y = static_cast<float>(num_tiles_y_) * tile_size;
+  const std::int32_t num_tiles_x = num_tiles_x_;
+  const std::int32_t num_tiles_y = num_tiles_y_;
+  const std::int32_t row_size = static_cast<std::int32_t>(tile_size_) + 1;
+  std::int32_t * __restrict slots = slots_.data();
+  std::int32_t * __restrict offsets = offsets_.data();
+  float * __restrict weights_x = weights_x_.data();
+  float * __restrict weights_y = weights_y_.data();
+#pragma omp simd
+  for (std::size_t i = 0; i < size; ++i) {
+    // the position in samples from the corner of the table
+    const float u = (xs[i] - origin_x) * inverse_resolution;
+    const float v = (ys[i] - origin_y) * inverse_resolution;
+    // also rejects NaN, the non-short-circuit operators keep the loop free of branches
+    const bool is_inside =
+      (u >= 0.0f) & (u < num_samples_x) & (v >= 0.0f) & (v < num_samples_y);
+    const float inside_u = is_inside ? u : 0.0f;
+    const float inside_v = is_inside ? v : 0.0f;
+    // the positions are not negative, so that the conversions round down. The product by the
+    // inverse of a tile size which is not a power of two rounds up to the number of tiles just
+    // before the far borders, so that the tiles are clamped to the last ones.
+    const std::int32_t tile_x =
+      std::min(static_cast<std::int32_t>(inside_u * inverse_tile_size), num_tiles_x - 1);
+    const std::int32_t tile_y =
+      std::min(static_cast<std::int32_t>(inside_v * inverse_tile_size), num_tiles_y - 1);
+    const float local_u =
+      std::clamp(inside_u - static_cast<float>(tile_x) * tile_size, 0.0f, tile_size);
+    const float local_v =
+      std::clamp(inside_v - static_cast<float>(tile_y) * tile_size, 0.0f, tile_size);
+    const std::int32_t sample_x = std::min(static_cast<std::int32_t>(local_u), row_size - 2);
+    const std::int32_t sample_y = std::min(static_cast<std::int32_t>(local_v), row_size - 2);
+    slots[i] = is_inside ? tile_y * num_tiles_x + tile_x : -1;
+    offsets[i] = sample_y * row_size + sample_x;
+    weights_x[i] = local_u - static_cast<float>(sample_x);
+    weights_y[i] = local_v - static_cast<float>(sample_y);
+  }
+
+  for (std::size_t i = 0; i < size; ++i) {
+    const float * samples = slots[i] < 0 ? nullptr : tile_samples_[slots[i]];
+    if (!samples) {
+      heights[i] = std::numeric_limits<float>::quiet_NaN();
+      continue;
+    }
+    const float * sample = samples + offsets[i];
+    const float wx = weights_x[i];
+    const float wy = weights_y[i];
+    // NaN when one of the samples is unknown
+    const float bottom = sample[0] + (sample[1] - sample[0]) * wx;
+    const float top = sample[row_size] + (sample[row_size + 1] - sample[row_size]) * wx;
+    heights[i] = bottom + (top - bottom) * wy;
+  }
+}
+
+void TiledElevationMap::unmapTile(const std::size_t slot)
+{
+  mapped_tiles_[slot].reset();
+  tile_samples_[slot] = nullptr;
+}
+
+bool TiledElevationMap::mapTile(const std::size_t slot)
+{
+  const auto tile_x = static_cast<std::int32_t>(slot % num_tiles_x_) + min_tile_x_;
+  const auto tile_y = static_cast<std::int32_t>(slot / num_tiles_x_) + min_tile_y_;
+  const auto tile_path = directory_ / getElevationMapTileFileName(tile_x, tile_y);
+  const auto header = readElevationMapTileHeader(tile_path);
+  if (
+    !header || header->tile_x != tile_x || header->tile_y != tile_y ||
+    header->tile_size != tile_size_ || header->resolution != resolution_) {
+    return false;
+  }
+  try {
+    auto mapped_tile = std::make_unique<boost::iostreams::mapped_file_source>(tile_path.string());
+    if (!mapped_tile->is_open() || mapped_tile->size() != getTileFileSize(tile_size_)) {
+      return false;
+    }
+    tile_samples_[slot] =
+      reinterpret_cast<const float *>(mapped_tile->data() + sizeof(ElevationMapTileHeader));
+    mapped_tiles_[slot] = std::move(mapped_tile);
+  } catch (const std::exception &) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace autoware::elevation_map_loader
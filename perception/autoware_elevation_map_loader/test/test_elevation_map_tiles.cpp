@@ -0,0 +1,256 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/elevation_map_loader/elevation_map_tiles.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using autoware::elevation_map_loader::ElevationMapTileCoordinate;
+using autoware::elevation_map_loader::ElevationMapTileHeader;
+using autoware::elevation_map_loader::getElevationMapTileFileName;
+using autoware::elevation_map_loader::getNumTileSamples;
+using autoware::elevation_map_loader::readElevationMapTileHeader;
+using autoware::elevation_map_loader::readElevationMapTileIndexHeader;
+using autoware::elevation_map_loader::TiledElevationMap;
+using autoware::elevation_map_loader::writeElevationMapTile;
+using autoware::elevation_map_loader::writeElevationMapTileIndex;
+
+namespace
+{
+constexpr std::uint32_t tile_size = 16;
+constexpr double resolution = 0.5;
+
+// bilinear interpolation is exact on a plane
+float getPlaneHeight(const double x, const double y)
+{
+  return static_cast<float>(0.1 * x - 0.05 * y + 2.0);
+}
+
+class TiledElevationMapTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    directory_ = std::filesystem::temp_directory_path() /
+                 ("test_elevation_map_tiles_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(directory_);
+    std::filesystem::create_directories(directory_);
+  }
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  // the 4 x 2 tiles from (min_tile_x, min_tile_y), [-2, 2) x [-1, 1) by default, with a plane
+  void writePlaneMap(
+    const std::uint32_t tile_size = ::tile_size, const double resolution = ::resolution,
+    const std::int32_t min_tile_x = -2, const std::int32_t min_tile_y = -1,
+    const std::uint64_t map_hash = 0)
+  {
+    std::vector<ElevationMapTileCoordinate> tiles;
+    for (std::int32_t tile_y = min_tile_y; tile_y < min_tile_y + 2; ++tile_y) {
+      for (std::int32_t tile_x = min_tile_x; tile_x < min_tile_x + 4; ++tile_x) {
+        ElevationMapTileHeader header{};
+        header.tile_size = tile_size;
+        header.tile_x = tile_x;
+        header.tile_y = tile_y;
+        header.resolution = resolution;
+        header.source_hash = 0;
+        std::vector<float> samples;
+        for (std::uint32_t j = 0; j <= tile_size; ++j) {
+          for (std::uint32_t i = 0; i <= tile_size; ++i) {
+            samples.push_back(getPlaneHeight(
+              (tile_x * static_cast<double>(tile_size) + i) * resolution,
+              (tile_y * static_cast<double>(tile_size) + j) * resolution));
+          }
+        }
+        ASSERT_TRUE(writeElevationMapTile(directory_, header, samples));
+        tiles.push_back({tile_x, tile_y});
+      }
+    }
+    ASSERT_TRUE(writeElevationMapTileIndex(directory_, tile_size, resolution, tiles, map_hash));
+  }
+
+  std::filesystem::path directory_;
+};
+}  // namespace
+
+TEST_F(TiledElevationMapTest, OpenFailsWithoutIndex)
+{
+  TiledElevationMap map;
+  EXPECT_FALSE(map.open(directory_));
+  EXPECT_FALSE(map.isOpen());
+}
+
+TEST_F(TiledElevationMapTest, ANewMapIsToldByTheHashOfTheIndex)
+{
+  EXPECT_FALSE(readElevationMapTileIndexHeader(directory_));
+  writePlaneMap(tile_size, resolution, -2, -1, 1);
+  TiledElevationMap map;
+  ASSERT_TRUE(map.open(directory_));
+  EXPECT_EQ(map.getMapHash(), 1U);
+  auto index_header = readElevationMapTileIndexHeader(directory_);
+  ASSERT_TRUE(index_header);
+  EXPECT_EQ(index_header->map_hash, 1U);
+  EXPECT_EQ(index_header->num_tiles, 8U);
+
+  // the loader writes the map moved to [0, 4) x [0, 2), the open map is kept until it is reopened
+  writePlaneMap(tile_size, resolution, 0, 0, 2);
+  index_header = readElevationMapTileIndexHeader(directory_);
+  ASSERT_TRUE(index_header);
+  EXPECT_EQ(index_header->map_hash, 2U);
+  EXPECT_EQ(map.getMapHash(), 1U);
+
+  ASSERT_TRUE(map.open(directory_));
+  EXPECT_EQ(map.getMapHash(), 2U);
+  EXPECT_EQ(map.updateWindow(0.0, 0.0, 31.9, 15.9, 0), 8U);
+  const float x = 30.0f;
+  const float y = 15.0f;
+  float height = 0.0f;
+  map.computeHeights(&x, &y, 1, &height);
+  EXPECT_NEAR(height, getPlaneHeight(x, y), 1e-4);
+}
+
+TEST_F(TiledElevationMapTest, HeightsOfAPlane)
+{
+  writePlaneMap();
+  TiledElevationMap map;
+  ASSERT_TRUE(map.open(directory_));
+  EXPECT_EQ(map.getNumTiles(), 8U);
+  EXPECT_EQ(map.updateWindow(-16.0, -8.0, 15.9, 7.9, 0), 8U);
+
+  // also on the borders of the tiles and of the map
+  const std::vector<float> xs = {0.0f, -0.13f, 7.99f, 8.0f, -16.0f, 15.99f, 3.3f, 16.0f, -16.1f};
+  const std::vector<float> ys = {0.0f, 0.71f, -8.0f, 7.99f, -3.2f, 0.2f, 7.999f, 0.0f, 0.0f};
+  std::vector<float> heights(xs.size());
+  map.computeHeights(xs.data(), ys.data(), xs.size(), heights.data());
+  for (std::size_t i = 0; i + 2 < xs.size(); ++i) {
+    EXPECT_NEAR(heights[i], getPlaneHeight(xs[i], ys[i]), 1e-4) << i;
+  }
+  // outside the map
+  EXPECT_TRUE(std::isnan(heights[xs.size() - 2]));
+  EXPECT_TRUE(std::isnan(heights[xs.size() - 1]));
+}
+
+TEST_F(TiledElevationMapTest, OnlyTheTilesOfTheWindowAreMapped)
+{
+  writePlaneMap();
+  TiledElevationMap map;
+  ASSERT_TRUE(map.open(directory_));
+  EXPECT_EQ(map.getNumMappedTiles(), 0U);
+
+  // the tile (-2, -1) and its neighbors
+  EXPECT_EQ(map.updateWindow(-15.0, -7.0, -14.0, -6.0, 1), 4U);
+  const std::vector<float> xs = {-15.0f, 12.0f};
+  const std::vector<float> ys = {-7.0f, 4.0f};
+  std::vector<float> heights(xs.size());
+  map.computeHeights(xs.data(), ys.data(), xs.size(), heights.data());
+  EXPECT_NEAR(heights[0], getPlaneHeight(xs[0], ys[0]), 1e-4);
+  // the tile (1, 0) is not mapped
+  EXPECT_TRUE(std::isnan(heights[1]));
+
+  // the window moves to the tile (1, 0)
+  EXPECT_EQ(map.updateWindow(12.0, 4.0, 12.0, 4.0, 0), 1U);
+  map.computeHeights(xs.data(), ys.data(), xs.size(), heights.data());
+  EXPECT_TRUE(std::isnan(heights[0]));
+  EXPECT_NEAR(heights[1], getPlaneHeight(xs[1], ys[1]), 1e-4);
+
+  // outside the map
+  EXPECT_EQ(map.updateWindow(1000.0, 1000.0, 1001.0, 1001.0, 1), 0U);
+  EXPECT_EQ(map.updateWindow(NAN, 0.0, 1.0, 1.0, 1), 0U);
+}
+
+TEST_F(TiledElevationMapTest, HeightsOnTheFarBordersWithTileSizesNotPowersOfTwo)
+{
+  // the division by these tile sizes is not exact in float, the positions just before the far
+  // borders of the map must stay in the last tiles. The map starts at the origin and the
+  // resolutions are powers of two, so that the positions in samples are exact.
+  for (const std::uint32_t non_power_of_two_tile_size : {125U, 250U, 500U, 1000U}) {
+    for (const double map_resolution : {1.0, 0.5}) {
+      writePlaneMap(non_power_of_two_tile_size, map_resolution, 0, 0);
+      TiledElevationMap map;
+      ASSERT_TRUE(map.open(directory_));
+      const auto size = static_cast<float>(non_power_of_two_tile_size * map_resolution);
+      ASSERT_EQ(map.updateWindow(0.0, 0.0, 4.0 * size, 2.0 * size, 0), 8U);
+
+      std::vector<float> xs;
+      std::vector<float> ys;
+      float x = 4.0f * size;
+      float y = 2.0f * size;
+      for (int i = 0; i < 16; ++i) {
+        x = std::nextafter(x, 0.0f);
+        y = std::nextafter(y, 0.0f);
+        // the far border in x, in y, and the far corner
+        xs.insert(xs.end(), {x, 0.5f * size, x, 0.0f, x});
+        ys.insert(ys.end(), {0.5f * size, y, y, y, 0.0f});
+      }
+      std::vector<float> heights(xs.size());
+      map.computeHeights(xs.data(), ys.data(), xs.size(), heights.data());
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_NEAR(heights[i], getPlaneHeight(xs[i], ys[i]), 1e-3)
+          << "tile_size: " << non_power_of_two_tile_size << ", x: " << xs[i] << ", y: " << ys[i];
+      }
+    }
+  }
+}
+
+TEST_F(TiledElevationMapTest, UnknownSamples)
+{
+  ElevationMapTileHeader header{};
+  header.tile_size = tile_size;
+  header.resolution = resolution;
+  std::vector<float> samples(getNumTileSamples(tile_size), 1.0f);
+  // the sample (2, 3)
+  samples[3 * (tile_size + 1) + 2] = NAN;
+  ASSERT_TRUE(writeElevationMapTile(directory_, header, samples));
+  ASSERT_TRUE(writeElevationMapTileIndex(directory_, tile_size, resolution, {{0, 0}}, 0));
+
+  TiledElevationMap map;
+  ASSERT_TRUE(map.open(directory_));
+  EXPECT_EQ(map.updateWindow(0.0, 0.0, 1.0, 1.0), 1U);
+  const std::vector<float> xs = {0.8f, 1.2f, 1.6f, 4.0f};
+  const std::vector<float> ys = {1.2f, 1.2f, 1.2f, 4.0f};
+  std::vector<float> heights(xs.size());
+  map.computeHeights(xs.data(), ys.data(), xs.size(), heights.data());
+  // the cells around the sample (2, 3) at (1.0, 1.5)
+  EXPECT_TRUE(std::isnan(heights[0]));
+  EXPECT_TRUE(std::isnan(heights[1]));
+  EXPECT_FLOAT_EQ(heights[2], 1.0f);
+  EXPECT_FLOAT_EQ(heights[3], 1.0f);
+}
+
+TEST_F(TiledElevationMapTest, BrokenTilesAreRejected)
+{
+  writePlaneMap();
+  const auto tile_path = directory_ / getElevationMapTileFileName(0, 0);
+  ASSERT_TRUE(readElevationMapTileHeader(tile_path));
+  std::filesystem::resize_file(tile_path, 100);
+  EXPECT_FALSE(readElevationMapTileHeader(tile_path));
+  EXPECT_FALSE(readElevationMapTileHeader(directory_ / "missing.bin"));
+
+  TiledElevationMap map;
+  ASSERT_TRUE(map.open(directory_));
+  // the broken tile (0, 0) is not mapped
+  EXPECT_EQ(map.updateWindow(-16.0, -8.0, 15.9, 7.9, 0), 7U);
+  const float x = 1.0f;
+  const float y = 1.0f;
+  float height = 0.0f;
+  map.computeHeights(&x, &y, 1, &height);
+  EXPECT_TRUE(std::isnan(height));
+}
@@ -31,7 +31,9 @@
 
 #include "node.hpp"
 
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -48,7 +50,6 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     grid_width_ = 1000;
     grid_height_ = 1000;
     grid_precision_ = 0.2;
-    ray_ground_filter::generateColors(colors_, color_num_);
 
     min_x_ = declare_parameter<double>("min_x");
     max_x_ = declare_parameter<double>("max_x");
@@ -82,64 +83,56 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
   }
 }
 
-void RayGroundFilterComponent::ConvertXYZIToRTZColor(
-  const pcl::PointCloud<PointType_>::Ptr in_cloud, PointCloudXYZRTColor & out_organized_points,
-  std::vector<pcl::PointIndices> & out_radial_divided_indices,
-  std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds)
+void RayGroundFilterComponent::LoadPoints(const PointCloud2::ConstSharedPtr & in_cloud_ptr)
 {
   std::unique_ptr<ScopedTimeTrack> st_ptr;
   if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
 
-  out_organized_points.resize(in_cloud->points.size());
-  out_radial_divided_indices.clear();
-  out_radial_divided_indices.resize(radial_dividers_num_);
-  out_radial_ordered_clouds.resize(radial_dividers_num_);
-
-  for (size_t i = 0; i < in_cloud->points.size(); i++) {
-    PointXYZRTColor new_point;
-    auto radius = static_cast<float>(sqrt(
-      in_cloud->points[i].x * in_cloud->points[i].x +
-      in_cloud->points[i].y * in_cloud->points[i].y));
-    auto theta =
-      static_cast<float>(atan2(in_cloud->points[i].y, in_cloud->points[i].x)) * 180 / M_PI;
-    if (theta < 0) {
-      theta += 360;
+  const size_t num_points = static_cast<size_t>(in_cloud_ptr->width) * in_cloud_ptr->height;
+  xs_.resize(num_points);
+  ys_.resize(num_points);
+  zs_.resize(num_points);
+
+  // read the float coordinates directly, other layouts are converted by PCL
+  const auto find_offset = [&in_cloud_ptr](const std::string & name) -> int {
+    for (const auto & field : in_cloud_ptr->fields) {
+      if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+        return static_cast<int>(field.offset);
+      }
     }
-    if (theta >= 360) {
-      theta -= 360;
+    return -1;
+  };
+  const int x_offset = find_offset("x");
+  const int y_offset = find_offset("y");
+  const int z_offset = find_offset("z");
+  if (
+    x_offset < 0 || y_offset < 0 || z_offset < 0 ||
+    in_cloud_ptr->data.size() < num_points * in_cloud_ptr->point_step) {
+    pcl::PointCloud<PointType_> cloud;
+    pcl::fromROSMsg(*in_cloud_ptr, cloud);
+    xs_.resize(cloud.size());
+    ys_.resize(cloud.size());
+    zs_.resize(cloud.size());
+    for (size_t i = 0; i < cloud.size(); ++i) {
+      xs_[i] = cloud.points[i].x;
+      ys_[i] = cloud.points[i].y;
+      zs_[i] = cloud.points[i].z;
     }
-    auto radial_div = static_cast<size_t>(floor(theta / radial_divider_angle_));
-
-    new_point.point.x = in_cloud->points[i].x;
-    new_point.point.y = in_cloud->points[i].y;
-    new_point.point.z = in_cloud->points[i].z;
-    // new_point.ring = in_cloud->points[i].ring;
-    new_point.radius = radius;
-    new_point.theta = theta;
-    new_point.radial_div = radial_div;
-    new_point.red = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[0]);
-    new_point.green = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[1]);
-    new_point.blue = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[2]);
-    new_point.original_index = i;
-
-    out_organized_points[i] = new_point;
-
-    // radial divisions
-    out_radial_divided_indices[radial_div].indices.push_back(i);
-
-    out_radial_ordered_clouds[radial_div].push_back(new_point);
-  }  // end for
-
-  // order radial points on each division
-#pragma omp for
-  for (size_t i = 0; i < radial_dividers_num_; i++) {
-    std::sort(
-      out_radial_ordered_clouds[i].begin(), out_radial_ordered_clouds[i].end(),
-      [](const PointXYZRTColor & a, const PointXYZRTColor & b) { return a.radius < b.radius; });
+    return;
+  }
+
+  const uint8_t * data = in_cloud_ptr->data.data();
+  const size_t point_step = in_cloud_ptr->point_step;
+  for (size_t i = 0; i < num_points; ++i) {
+    const uint8_t * point = data + i * point_step;
+    std::memcpy(&xs_[i], point + x_offset, sizeof(float));
+    std::memcpy(&ys_[i], point + y_offset, sizeof(float));
+    std::memcpy(&zs_[i], point + z_offset, sizeof(float));
   }
 }
 
-boost::optional<float> RayGroundFilterComponent::calcPointVehicleIntersection(const Point & point)
+boost::optional<float> RayGroundFilterComponent::calcPointVehicleIntersection(
+  const Point & point) const
 {
   bg::model::linestring<Point> ls = {{0.0, 0.0}, point};
   std::vector<Point> collision_points;
@@ -163,104 +156,6 @@ void RayGroundFilterComponent::setVehicleFootprint(
   vehicle_footprint_.outer().push_back(Point(min_x, min_y));  // left back
 }
 
-void RayGroundFilterComponent::ClassifyPointCloud(
-  std::vector<PointCloudXYZRTColor> & in_radial_ordered_clouds,
-  pcl::PointIndices & out_ground_indices, pcl::PointIndices & out_no_ground_indices)
-{
-  std::unique_ptr<ScopedTimeTrack> st_ptr;
-  if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
-
-  out_ground_indices.indices.clear();
-  out_no_ground_indices.indices.clear();
-#pragma omp for
-  for (size_t i = 0; i < in_radial_ordered_clouds.size();
-       i++)  // sweep through each radial division
-  {
-    float prev_radius = 0.f;
-    float prev_height = 0.f;
-    bool prev_ground = false;
-    bool current_ground = false;
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size();
-         j++)  // loop through each point in the radial div
-    {
-      double local_max_slope = local_max_slope_;
-      if (j == 0) {
-        local_max_slope = initial_max_slope_;
-        if (use_vehicle_footprint_) {
-          // calc intersection of vehicle footprint and initial point vector
-          const auto radius = calcPointVehicleIntersection(
-            Point{in_radial_ordered_clouds[i][j].point.x, in_radial_ordered_clouds[i][j].point.y});
-          if (radius) {
-            prev_radius = *radius;
-          } else {
-            // This case may happen if point was detected inside vehicle footprint for example
-            // RCLCPP_ERROR(
-            //   this->get_logger(),
-            //   "failed to find intersection of initial point line and vehicle footprint");
-            continue;
-          }
-        }
-      }
-
-      float points_distance = in_radial_ordered_clouds[i][j].radius - prev_radius;
-      float height_threshold = tan(DEG2RAD(local_max_slope)) * points_distance;
-      float current_height = in_radial_ordered_clouds[i][j].point.z;
-      float general_height_threshold =
-        tan(DEG2RAD(general_max_slope_)) * in_radial_ordered_clouds[i][j].radius;
-
-      // for points which are very close causing the height threshold to be tiny,
-      // set a minimum value
-      if (height_threshold < min_height_threshold_) {
-        height_threshold = min_height_threshold_;
-      }
-      // only check points which radius is larger than the concentric_divider
-      if (points_distance < concentric_divider_distance_) {
-        current_ground = prev_ground;
-      } else {
-        // check current point height against the LOCAL threshold (previous point)
-        if (
-          current_height <= (prev_height + height_threshold) &&
-          current_height >= (prev_height - height_threshold)) {
-          // Check again using general geometry (radius from origin)
-          // if previous points wasn't ground
-          if (!prev_ground) {
-            if (
-              current_height <= general_height_threshold &&
-              current_height >= -general_height_threshold) {
-              current_ground = true;
-            } else {
-              current_ground = false;
-            }
-          } else {
-            current_ground = true;
-          }
-        } else {
-          // check if previous point is too far from previous one, if so classify again
-          if (
-            points_distance > reclass_distance_threshold_ &&
-            (current_height <= general_height_threshold &&
-             current_height >= -general_height_threshold)) {
-            current_ground = true;
-          } else {
-            current_ground = false;
-          }
-        }
-      }  // end larger than concentric_divider
-
-      if (current_ground) {
-        out_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
-        prev_ground = true;
-      } else {
-        out_no_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
-        prev_ground = false;
-      }
-
-      prev_radius = in_radial_ordered_clouds[i][j].radius;
-      prev_height = in_radial_ordered_clouds[i][j].point.z;
-    }
-  }
-}
-
 // [ROS 2-port]: removed
 // bool RayGroundFilterComponent::child_init()
 // {
@@ -289,7 +184,7 @@ void RayGroundFilterComponent::initializePointCloud2(
 }
 
 void RayGroundFilterComponent::ExtractPointsIndices(
-  const PointCloud2::ConstSharedPtr in_cloud_ptr, const pcl::PointIndices & in_indices,
+  const PointCloud2::ConstSharedPtr in_cloud_ptr, const std::vector<std::uint8_t> & in_is_ground,
   PointCloud2::SharedPtr ground_cloud_msg_ptr, PointCloud2::SharedPtr no_ground_cloud_msg_ptr)
 {
   std::unique_ptr<ScopedTimeTrack> st_ptr;
@@ -300,15 +195,8 @@ void RayGroundFilterComponent::ExtractPointsIndices(
   int point_step = in_cloud_ptr->point_step;
   size_t ground_count = 0;
   size_t no_ground_count = 0;
-  std::vector<bool> is_ground_idx(in_cloud_ptr->width, false);
-  for (const auto & idx : in_indices.indices) {
-    if (std::size_t(idx) >= is_ground_idx.size()) {
-      continue;
-    }
-    is_ground_idx[idx] = true;
-  }
-  for (size_t i = 0; i < is_ground_idx.size(); ++i) {
-    if (is_ground_idx[i]) {
+  for (size_t i = 0; i < in_cloud_ptr->width; ++i) {
+    if (i < in_is_ground.size() && in_is_ground[i]) {
       std::memcpy(
         &ground_cloud_msg_ptr->data[ground_count * point_step], &in_cloud_ptr->data[i * point_step],
         point_step);
@@ -337,31 +225,41 @@ void RayGroundFilterComponent::filter(
 
   std::scoped_lock lock(mutex_);
 
-  pcl::PointCloud<PointType_>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<PointType_>);
-  pcl::fromROSMsg(*input, *current_sensor_cloud_ptr);
-
-  PointCloudXYZRTColor organized_points;
-  std::vector<pcl::PointIndices> radial_division_indices;
-  std::vector<PointCloudXYZRTColor> radial_ordered_clouds;
-
-  radial_dividers_num_ = ceil(360 / radial_divider_angle_);
+  LoadPoints(input);
 
-  ConvertXYZIToRTZColor(
-    current_sensor_cloud_ptr, organized_points, radial_division_indices, radial_ordered_clouds);
-
-  pcl::PointIndices ground_indices, no_ground_indices;
-
-  ClassifyPointCloud(radial_ordered_clouds, ground_indices, no_ground_indices);
-
-  pcl::PointCloud<PointType_>::Ptr ground_cloud_ptr(new pcl::PointCloud<PointType_>);
-  pcl::PointCloud<PointType_>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<PointType_>);
-  pcl::PointCloud<pcl::PointXYZRGB>::Ptr radials_cloud_ptr(new pcl::PointCloud<pcl::PointXYZRGB>);
+  {
+    std::unique_ptr<ScopedTimeTrack> inner_st_ptr;
+    if (time_keeper_) {
+      inner_st_ptr = std::make_unique<ScopedTimeTrack>("classify", *time_keeper_);
+    }
+    RayGroundParameters param;
+    param.general_max_slope = general_max_slope_;
+    param.local_max_slope = local_max_slope_;
+    param.initial_max_slope = initial_max_slope_;
+    param.radial_divider_angle = radial_divider_angle_;
+    param.concentric_divider_distance = concentric_divider_distance_;
+    param.min_height_threshold = min_height_threshold_;
+    param.reclass_distance_threshold = reclass_distance_threshold_;
+
+    RayGroundEngine::InitialRadiusFunction initial_radius_function;
+    if (use_vehicle_footprint_) {
+      // calc intersection of vehicle footprint and initial point vector
+      initial_radius_function = [this](const float x, const float y) -> std::optional<float> {
+        const auto radius = calcPointVehicleIntersection(Point{x, y});
+        if (!radius) {
+          return std::nullopt;
+        }
+        return *radius;
+      };
+    }
+    ray_ground_engine_.classify(param, xs_, ys_, zs_, initial_radius_function, is_ground_);
+  }
 
   sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_msg_ptr(
     new sensor_msgs::msg::PointCloud2);
   sensor_msgs::msg::PointCloud2::SharedPtr ground_cloud_msg_ptr(new sensor_msgs::msg::PointCloud2);
 
-  ExtractPointsIndices(input, ground_indices, ground_cloud_msg_ptr, no_ground_cloud_msg_ptr);
+  ExtractPointsIndices(input, is_ground_, ground_cloud_msg_ptr, no_ground_cloud_msg_ptr);
   output = *no_ground_cloud_msg_ptr;
 }
 
@@ -61,7 +61,7 @@
 #endif
 
 #include "autoware/pointcloud_preprocessor/filter.hpp"
-#include "gencolors.hpp"
+#include "ray_ground_engine.hpp"
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
@@ -72,6 +72,7 @@
 #include <boost/optional.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -86,25 +87,6 @@ class RayGroundFilterComponent : public autoware::pointcloud_preprocessor::Filte
 {
   typedef pcl::PointXYZ PointType_;
 
-  struct PointXYZRTColor
-  {
-    pcl::PointXYZ point;
-
-    size_t ring;  // ring number if available
-
-    float radius;  // cylindrical coords on XY Plane
-    float theta;   // angle deg on XY plane
-
-    size_t radial_div;  // index of the radial division to which this point belongs to
-
-    size_t red;    // Red component  [0-255]
-    size_t green;  // Green Component[0-255]
-    size_t blue;   // Blue component [0-255]
-
-    size_t original_index;  // index of this point in the source pointcloud
-  };
-  typedef std::vector<PointXYZRTColor> PointCloudXYZRTColor;
-
 protected:
   void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
@@ -120,8 +102,6 @@ private:
   double
     reclass_distance_threshold_;  // distance between points at which re classification will occur
 
-  size_t radial_dividers_num_;
-
   size_t grid_width_;
   size_t grid_height_;
   double grid_precision_;
@@ -136,8 +116,6 @@ private:
   Polygon vehicle_footprint_;
   bool use_vehicle_footprint_;
 
-  std::vector<cv::Scalar> colors_;
-  const size_t color_num_ = 10;                          // different number of color to generate
   pcl::PointCloud<PointType_>::Ptr previous_cloud_ptr_;  // holds the previous groundless result of
                                                          // ground classification
 
@@ -146,6 +124,13 @@ private:
     detailed_processing_time_publisher_;
   std::shared_ptr<autoware_utils::TimeKeeper> time_keeper_;
 
+  RayGroundEngine ray_ground_engine_;
+  // the coordinates of the input points, reused between the callbacks
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<float> zs_;
+  std::vector<std::uint8_t> is_ground_;
+
   /*!
    * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
    * @param[in] in_target_frame Coordinate system to perform transform
@@ -156,45 +141,24 @@ private:
    */
 
   /*!
-   *
-   * @param[in] in_cloud Input Point Cloud to be organized in radial segments
-   * @param[out] out_organized_points Custom Point Cloud filled with XYZRTZColor data
-   * @param[out] out_radial_divided_indices Indices of the points in the original cloud for each
-   * radial segment
-   * @param[out] out_radial_ordered_clouds Vector of Points Clouds, each element will contain the
-   * points ordered
-   */
-  void ConvertXYZIToRTZColor(
-    const pcl::PointCloud<PointType_>::Ptr in_cloud, PointCloudXYZRTColor & out_organized_points,
-    std::vector<pcl::PointIndices> & out_radial_divided_indices,
-    std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds);
-
-  /*!
-   * Classifies Points in the PointCloud as Ground and Not Ground
-   * @param in_radial_ordered_clouds Vector of an Ordered PointsCloud ordered by radial distance
-   * from the origin
-   * @param out_ground_indices Returns the indices of the points classified as ground in the
-   * original PointCloud
-   * @param out_no_ground_indices Returns the indices of the points classified as not ground in the
-   * original PointCloud
+   * Copies the coordinates of the points of the PointCloud into xs_, ys_ and zs_
+   * @param in_cloud_ptr Input PointCloud
    */
-  void ClassifyPointCloud(
-    std::vector<PointCloudXYZRTColor> & in_radial_ordered_clouds,
-    pcl::PointIndices & out_ground_indices, pcl::PointIndices & out_no_ground_indices);
+  void LoadPoints(const PointCloud2::ConstSharedPtr & in_cloud_ptr);
 
   /*!
    * Returns the resulting complementary PointCloud, one with the points kept and the other removed
-   * as indicated in the indices
+   * as indicated by the ground flags
    * @param in_cloud_ptr Input PointCloud to which the extraction will be performed
-   * @param in_indices Indices of the points to be both removed and kept
-   * @param out_only_indices_cloud_ptr Resulting PointCloud with the indices kept
-   * @param out_removed_indices_cloud_ptr Resulting PointCloud with the indices removed
+   * @param in_is_ground Ground flag of each point of the input PointCloud
+   * @param out_only_indices_cloud_ptr Resulting PointCloud with the ground points
+   * @param out_removed_indices_cloud_ptr Resulting PointCloud with the other points
    */
   void ExtractPointsIndices(
-    const PointCloud2::ConstSharedPtr in_cloud_ptr, const pcl::PointIndices & in_indices,
+    const PointCloud2::ConstSharedPtr in_cloud_ptr, const std::vector<std::uint8_t> & in_is_ground,
     PointCloud2::SharedPtr ground_cloud_msg_ptr, PointCloud2::SharedPtr no_ground_cloud_msg_ptr);
 
-  boost::optional<float> calcPointVehicleIntersection(const Point & point);
+  boost::optional<float> calcPointVehicleIntersection(const Point & point) const;
 
   void setVehicleFootprint(
     const double min_x, const double max_x, const double min_y, const double max_y);
@@ -0,0 +1,284 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray_ground_engine.hpp"
+
+#include <pcl/pcl_macros.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace autoware::ground_segmentation
+{
+namespace
+{
+constexpr float pi = M_PI;
+constexpr float half_pi = M_PI / 2.0;
+constexpr float two_pi = 2.0 * M_PI;
+
+// the size of the radius buckets of the counting sort, the points of a bucket are sorted by radius
+// afterwards
+constexpr float radius_bucket_size = 0.1f;
+constexpr std::int32_t max_num_radius_buckets = 4096;
+
+// the distance to the border of a ray, in radians, under which the ray of a point is computed
+// again with atan2 as in the previous classification. It is larger than the error of
+// approximateAtan2 and the few float roundings of the azimuth, which are up to 2pi. It is divided
+// by the ray width, so that more points are computed again when the rays are narrow.
+constexpr float ray_border_tolerance =
+  3e-7f + 4.0f * two_pi * std::numeric_limits<float>::epsilon();
+
+// atan2 with an absolute error below 3e-7 rad. The octant corrections are weights instead of
+// selects of values, which GCC does not if-convert, so that the loops over the points are
+// vectorized.
+inline float approximateAtan2(const float y, const float x)
+{
+  const float abs_x = std::abs(x);
+  const float abs_y = std::abs(y);
+  const float a = std::min(abs_x, abs_y) /
+                  std::max(std::max(abs_x, abs_y), std::numeric_limits<float>::min());
+  const float s = a * a;
+  // minimax polynomial of atan(a) / a over [0, 1] in s = a^2
+  float r = -4.054567010e-03f;
+  r = r * s + 2.186295758e-02f;
+  r = r * s - 5.591232720e-02f;
+  r = r * s + 9.642197447e-02f;
+  r = r * s - 1.390862965e-01f;
+  r = r * s + 1.994656569e-01f;
+  r = r * s - 3.332986079e-01f;
+  r = r * s + 9.999993356e-01f;
+  r *= a;
+  const float swapped = std::signbit(abs_x - abs_y) ? 1.0f : 0.0f;
+  r += swapped * (half_pi - 2.0f * r);
+  const float negative_x = x < 0.0f ? 1.0f : 0.0f;
+  r += negative_x * (pi - 2.0f * r);
+  return std::copysign(r, y);
+}
+}  // namespace
+
+void RayGroundEngine::computeRays(
+  const std::vector<float> & xs, const std::vector<float> & ys, const double radial_divider_angle)
+{
+  const std::size_t size = xs.size();
+  radii_.resize(size);
+  rays_.resize(size);
+  buckets_.resize(size);
+  near_ray_border_.resize(size);
+
+  const float * __restrict x_ptr = xs.data();
+  const float * __restrict y_ptr = ys.data();
+  float * __restrict radius_ptr = radii_.data();
+  std::int32_t * __restrict ray_ptr = rays_.data();
+  std::uint8_t * __restrict near_ray_border_ptr = near_ray_border_.data();
+  const float inv_radial_divider_angle = static_cast<float>(180.0 / M_PI / radial_divider_angle);
+  const float ray_fraction_tolerance = ray_border_tolerance * inv_radial_divider_angle;
+  const auto num_rays = static_cast<std::int32_t>(num_rays_);
+  float max_radius = 0.0f;
+#pragma omp simd reduction(max : max_radius)
+  for (std::size_t i = 0; i < size; ++i) {
+    const float x = x_ptr[i];
+    const float y = y_ptr[i];
+    const float radius = std::sqrt(x * x + y * y);
+    radius_ptr[i] = radius;
+    max_radius = std::max(max_radius, radius);
+
+    // azimuth in [0, 2pi] in ray widths, 2pi being the ray 0
+    const float theta = approximateAtan2(y, x);
+    const float negative_theta = std::signbit(theta) ? 1.0f : 0.0f;
+    const float ray_position = (theta + negative_theta * two_pi) * inv_radial_divider_angle;
+    std::int32_t ray = static_cast<std::int32_t>(ray_position);
+    const float ray_fraction = ray_position - static_cast<float>(ray);
+    near_ray_border_ptr[i] =
+      (ray_fraction < ray_fraction_tolerance) | (ray_fraction > 1.0f - ray_fraction_tolerance);
+    ray = ray >= num_rays ? ray - num_rays : ray;
+    ray_ptr[i] = std::min(std::max(ray, 0), num_rays - 1);
+  }
+
+  // the few points near the border of two rays are put in the ray of the previous classification
+  for (std::size_t i = 0; i < size; ++i) {
+    if (!near_ray_border_ptr[i]) {
+      continue;
+    }
+    // the same atan2 as the previous classification
+    auto theta = static_cast<float>(atan2(y_ptr[i], x_ptr[i])) * 180 / M_PI;
+    if (theta < 0) {
+      theta += 360;
+    }
+    if (theta >= 360) {
+      theta -= 360;
+    }
+    const auto ray = static_cast<std::int32_t>(std::floor(theta / radial_divider_angle));
+    ray_ptr[i] = std::min(std::max(ray, 0), num_rays - 1);
+  }
+
+  // the buckets are enlarged for the far points so that the counts stay small
+  const auto num_buckets = std::min(
+    static_cast<std::int32_t>(max_radius / radius_bucket_size) + 1, max_num_radius_buckets);
+  num_radius_buckets_ = static_cast<std::size_t>(num_buckets);
+  const float inv_bucket_size = static_cast<float>(num_buckets - 1) / std::max(max_radius, 1e-3f);
+  std::int32_t * __restrict bucket_ptr = buckets_.data();
+#pragma omp simd
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto bucket = static_cast<std::int32_t>(radius_ptr[i] * inv_bucket_size);
+    bucket_ptr[i] = std::min(std::max(bucket, 0), num_buckets - 1);
+  }
+}
+
+void RayGroundEngine::sortPoints()
+{
+  const std::size_t size = rays_.size();
+  bucket_order_.resize(size);
+  order_.resize(size);
+
+  // by radius bucket
+  bucket_offsets_.assign(num_radius_buckets_ + 1, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    ++bucket_offsets_[buckets_[i] + 1];
+  }
+  std::partial_sum(bucket_offsets_.begin(), bucket_offsets_.end(), bucket_offsets_.begin());
+  for (std::size_t i = 0; i < size; ++i) {
+    bucket_order_[bucket_offsets_[buckets_[i]]++] = static_cast<std::uint32_t>(i);
+  }
+
+  // then by ray, keeping the order of the buckets in each ray
+  ray_offsets_.assign(num_rays_ + 1, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    ++ray_offsets_[rays_[i] + 1];
+  }
+  std::partial_sum(ray_offsets_.begin(), ray_offsets_.end(), ray_offsets_.begin());
+  ray_cursors_.assign(ray_offsets_.begin(), ray_offsets_.end() - 1);
+  for (const auto index : bucket_order_) {
+    order_[ray_cursors_[rays_[index]]++] = index;
+  }
+}
+
+void RayGroundEngine::classifyRay(
+  const RayGroundParameters & param, const std::size_t ray, const std::vector<float> & xs,
+  const std::vector<float> & ys, const std::vector<float> & zs,
+  const InitialRadiusFunction & initial_radius_function, std::vector<std::uint8_t> & is_ground)
+{
+  const std::size_t begin = ray_offsets_[ray];
+  const std::size_t end = ray_offsets_[ray + 1];
+  if (begin == end) {
+    return;
+  }
+
+  // the points are ordered by bucket, an insertion sort orders them by radius in almost linear
+  // time. The sort is stable so that the points of the same radius are in the input order.
+  for (std::size_t i = begin + 1; i < end; ++i) {
+    const std::uint32_t index = order_[i];
+    const float radius = radii_[index];
+    std::size_t j = i;
+    for (; begin < j && radius < radii_[order_[j - 1]]; --j) {
+      order_[j] = order_[j - 1];
+    }
+    order_[j] = index;
+  }
+  for (std::size_t i = begin; i < end; ++i) {
+    sorted_radii_[i] = radii_[order_[i]];
+    sorted_zs_[i] = zs[order_[i]];
+  }
+
+  // general slope test, computed as in the previous classification
+  const double tan_general_max_slope = std::tan(DEG2RAD(param.general_max_slope));
+  const float * __restrict radius_ptr = sorted_radii_.data();
+  const float * __restrict z_ptr = sorted_zs_.data();
+  std::uint8_t * __restrict in_general_slope_ptr = sorted_in_general_slope_.data();
+#pragma omp simd
+  for (std::size_t i = begin; i < end; ++i) {
+    const auto general_height_threshold =
+      static_cast<float>(tan_general_max_slope * radius_ptr[i]);
+    in_general_slope_ptr[i] =
+      (z_ptr[i] <= general_height_threshold) & (z_ptr[i] >= -general_height_threshold);
+  }
+
+  // local slope scan from the origin
+  const double tan_local_max_slope = std::tan(DEG2RAD(param.local_max_slope));
+  const double tan_initial_max_slope = std::tan(DEG2RAD(param.initial_max_slope));
+  float prev_radius = 0.f;
+  float prev_height = 0.f;
+  bool prev_ground = false;
+  bool current_ground = false;
+  for (std::size_t i = begin; i < end; ++i) {
+    double tan_max_slope = tan_local_max_slope;
+    if (i == begin) {
+      tan_max_slope = tan_initial_max_slope;
+      if (initial_radius_function) {
+        const auto radius = initial_radius_function(xs[order_[i]], ys[order_[i]]);
+        if (!radius) {
+          continue;
+        }
+        prev_radius = *radius;
+      }
+    }
+
+    const float points_distance = sorted_radii_[i] - prev_radius;
+    auto height_threshold = static_cast<float>(tan_max_slope * points_distance);
+    const float current_height = sorted_zs_[i];
+    const bool in_general_slope = sorted_in_general_slope_[i];
+
+    // for points which are very close causing the height threshold to be tiny,
+    // set a minimum value
+    if (height_threshold < param.min_height_threshold) {
+      height_threshold = static_cast<float>(param.min_height_threshold);
+    }
+    if (points_distance < param.concentric_divider_distance) {
+      current_ground = prev_ground;
+    } else if (
+      current_height <= (prev_height + height_threshold) &&
+      current_height >= (prev_height - height_threshold)) {
+      // check again against the general slope if the previous point was not ground
+      current_ground = prev_ground || in_general_slope;
+    } else {
+      // classify again against the general slope if the previous point is far
+      current_ground = points_distance > param.reclass_distance_threshold && in_general_slope;
+    }
+
+    is_ground[order_[i]] = current_ground;
+    prev_ground = current_ground;
+    prev_radius = sorted_radii_[i];
+    prev_height = current_height;
+  }
+}
+
+void RayGroundEngine::classify(
+  const RayGroundParameters & param, const std::vector<float> & xs, const std::vector<float> & ys,
+  const std::vector<float> & zs, const InitialRadiusFunction & initial_radius_function,
+  std::vector<std::uint8_t> & is_ground)
+{
+  const std::size_t size = xs.size();
+  is_ground.assign(size, 0);
+  if (size == 0) {
+    return;
+  }
+
+  // stage 1: ray and radius of the points, and ordering by ray and radius
+  num_rays_ = static_cast<std::size_t>(std::ceil(360.0 / param.radial_divider_angle));
+  computeRays(xs, ys, param.radial_divider_angle);
+  sortPoints();
+
+  // stage 2: classification of the rays, each ray writes its own range of the buffers
+  sorted_radii_.resize(size);
+  sorted_zs_.resize(size);
+  sorted_in_general_slope_.resize(size);
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t ray = 0; ray < num_rays_; ++ray) {
+    classifyRay(param, ray, xs, ys, zs, initial_radius_function, is_ground);
+  }
+}
+
+}  // namespace autoware::ground_segmentation
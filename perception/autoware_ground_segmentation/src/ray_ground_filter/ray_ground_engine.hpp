@@ -0,0 +1,105 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RAY_GROUND_FILTER__RAY_GROUND_ENGINE_HPP_
+#define RAY_GROUND_FILTER__RAY_GROUND_ENGINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace autoware::ground_segmentation
+{
+struct RayGroundParameters
+{
+  double general_max_slope;            // degrees
+  double local_max_slope;              // degrees
+  double initial_max_slope;            // degrees
+  double radial_divider_angle;         // degrees
+  double concentric_divider_distance;  // meters
+  double min_height_threshold;         // meters
+  double reclass_distance_threshold;   // meters
+};
+
+/**
+ * @brief Ground classification of RayGroundFilterComponent over flat buffers of points.
+ *
+ * The classification runs in two stages:
+ * 1. The radius and the ray of each point are computed by a vectorized loop, the azimuth being a
+ *    polynomial approximation of atan2. Only the points near the border of two rays are computed
+ *    again with atan2, so that the rays are the ones of the previous classification. The points
+ *    are then ordered by ray and radius with two counting sorts, by radius bucket then by ray,
+ *    into a single buffer.
+ * 2. The rays are classified in parallel. The test of each point against the general slope does
+ *    not depend on the other points and is vectorized, then each ray is scanned from the origin
+ *    against the local slope as in the previous classification.
+ *
+ * The buffers are reused between the calls, an instance must not be shared by threads.
+ */
+class RayGroundEngine
+{
+public:
+  /**
+   * @brief the distance from the origin to the vehicle footprint along the direction of (x, y),
+   *        nullopt if the direction does not cross the footprint
+   */
+  using InitialRadiusFunction = std::function<std::optional<float>(const float x, const float y)>;
+
+  /**
+   * @brief classify the points, is_ground being resized to the number of points
+   *
+   * @param initial_radius_function the start of the scan of each ray, from the origin if empty.
+   *        The first point of a ray is left as not ground if the function returns nullopt. It is
+   *        called from several threads.
+   */
+  void classify(
+    const RayGroundParameters & param, const std::vector<float> & xs,
+    const std::vector<float> & ys, const std::vector<float> & zs,
+    const InitialRadiusFunction & initial_radius_function, std::vector<std::uint8_t> & is_ground);
+
+private:
+  void computeRays(
+    const std::vector<float> & xs, const std::vector<float> & ys,
+    const double radial_divider_angle);
+  void sortPoints();
+  void classifyRay(
+    const RayGroundParameters & param, const std::size_t ray, const std::vector<float> & xs,
+    const std::vector<float> & ys, const std::vector<float> & zs,
+    const InitialRadiusFunction & initial_radius_function, std::vector<std::uint8_t> & is_ground);
+
+  std::size_t num_rays_{0};
+  std::size_t num_radius_buckets_{0};
+  std::vector<float> radii_;
+  std::vector<std::int32_t> rays_;
+  std::vector<std::int32_t> buckets_;
+  std::vector<std::uint8_t> near_ray_border_;
+
+  // the indices of the points ordered by radius bucket, then by ray and radius bucket
+  std::vector<std::uint32_t> bucket_order_;
+  std::vector<std::uint32_t> order_;
+  std::vector<std::uint32_t> bucket_offsets_;
+  // the points of the ray i are order_[ray_offsets_[i]] to order_[ray_offsets_[i + 1] - 1]
+  std::vector<std::uint32_t> ray_offsets_;
+  std::vector<std::uint32_t> ray_cursors_;
+
+  // the radius, height and general slope test of the ordered points
+  std::vector<float> sorted_radii_;
+  std::vector<float> sorted_zs_;
+  std::vector<std::uint8_t> sorted_in_general_slope_;
+};
+}  // namespace autoware::ground_segmentation
+
+#endif  // RAY_GROUND_FILTER__RAY_GROUND_ENGINE_HPP_
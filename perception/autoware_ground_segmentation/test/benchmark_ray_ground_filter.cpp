@@ -0,0 +1,244 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/ray_ground_filter/ray_ground_engine.hpp"
+
+#include <pcl/pcl_macros.h>
+#include <pcl/point_types.h>
+
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Measure the ground classification of ray_ground_filter on scans of 32, 64 and 128 beams of 1800
+// points, with the default parameters. The scene is a ground of small slopes with walls and noise.
+// The baseline is the previous classification, which copied the points into a vector of points
+// with color per ray, sorted each ray with std::sort and classified the rays one after the other.
+// The engine is measured with one thread and with all the threads. The points of the same radius
+// in a ray, frequent in this scene, are in an unspecified order after std::sort, so the
+// classification is also compared to the baseline with a stable sort, which is the order of the
+// engine.
+
+namespace
+{
+using autoware::ground_segmentation::RayGroundEngine;
+using autoware::ground_segmentation::RayGroundParameters;
+using Clock = std::chrono::steady_clock;
+
+// the default parameters of config/ray_ground_filter.param.yaml
+RayGroundParameters createParameters()
+{
+  RayGroundParameters param;
+  param.general_max_slope = 8.0;
+  param.local_max_slope = 6.0;
+  param.initial_max_slope = 3.0;
+  param.radial_divider_angle = 1.0;
+  param.concentric_divider_distance = 0.0;
+  param.min_height_threshold = 0.15;
+  param.reclass_distance_threshold = 0.1;
+  return param;
+}
+
+struct PointXYZRTColor
+{
+  pcl::PointXYZ point;
+  size_t ring;
+  float radius;
+  float theta;
+  size_t radial_div;
+  size_t red;
+  size_t green;
+  size_t blue;
+  size_t original_index;
+};
+
+// the previous ConvertXYZIToRTZColor and ClassifyPointCloud of RayGroundFilterComponent, with a
+// stable sort of the rays if stable_sort
+void baselineClassify(
+  const RayGroundParameters & param, const std::vector<pcl::PointXYZ> & cloud,
+  std::vector<std::uint8_t> & is_ground, const bool stable_sort = false)
+{
+  const auto radial_dividers_num = static_cast<size_t>(ceil(360 / param.radial_divider_angle));
+  std::vector<PointXYZRTColor> organized_points(cloud.size());
+  std::vector<std::vector<size_t>> radial_divided_indices(radial_dividers_num);
+  std::vector<std::vector<PointXYZRTColor>> radial_ordered_clouds(radial_dividers_num);
+  for (size_t i = 0; i < cloud.size(); i++) {
+    PointXYZRTColor new_point;
+    auto radius = static_cast<float>(sqrt(cloud[i].x * cloud[i].x + cloud[i].y * cloud[i].y));
+    auto theta = static_cast<float>(atan2(cloud[i].y, cloud[i].x)) * 180 / M_PI;
+    if (theta < 0) {
+      theta += 360;
+    }
+    if (theta >= 360) {
+      theta -= 360;
+    }
+    auto radial_div = static_cast<size_t>(floor(theta / param.radial_divider_angle));
+    new_point.point = cloud[i];
+    new_point.radius = radius;
+    new_point.theta = theta;
+    new_point.radial_div = radial_div;
+    new_point.red = new_point.green = new_point.blue = radial_div % 10;
+    new_point.original_index = i;
+    organized_points[i] = new_point;
+    radial_divided_indices[radial_div].push_back(i);
+    radial_ordered_clouds[radial_div].push_back(new_point);
+  }
+  const auto compare_radius = [](const auto & a, const auto & b) { return a.radius < b.radius; };
+  for (auto & ray : radial_ordered_clouds) {
+    if (stable_sort) {
+      std::stable_sort(ray.begin(), ray.end(), compare_radius);
+    } else {
+      std::sort(ray.begin(), ray.end(), compare_radius);
+    }
+  }
+
+  is_ground.assign(cloud.size(), 0);
+  for (const auto & ray : radial_ordered_clouds) {
+    float prev_radius = 0.f;
+    float prev_height = 0.f;
+    bool prev_ground = false;
+    bool current_ground = false;
+    for (size_t j = 0; j < ray.size(); j++) {
+      const double local_max_slope = j == 0 ? param.initial_max_slope : param.local_max_slope;
+      float points_distance = ray[j].radius - prev_radius;
+      float height_threshold = tan(DEG2RAD(local_max_slope)) * points_distance;
+      float current_height = ray[j].point.z;
+      float general_height_threshold = tan(DEG2RAD(param.general_max_slope)) * ray[j].radius;
+      if (height_threshold < param.min_height_threshold) {
+        height_threshold = param.min_height_threshold;
+      }
+      if (points_distance < param.concentric_divider_distance) {
+        current_ground = prev_ground;
+      } else if (
+        current_height <= (prev_height + height_threshold) &&
+        current_height >= (prev_height - height_threshold)) {
+        current_ground = prev_ground || (current_height <= general_height_threshold &&
+                                         current_height >= -general_height_threshold);
+      } else {
+        current_ground = points_distance > param.reclass_distance_threshold &&
+                         (current_height <= general_height_threshold &&
+                          current_height >= -general_height_threshold);
+      }
+      is_ground[ray[j].original_index] = current_ground;
+      prev_ground = current_ground;
+      prev_radius = ray[j].radius;
+      prev_height = ray[j].point.z;
+    }
+  }
+}
+
+// a scan of num_beams beams from 1.8 m high, over a ground of small slopes with walls of 2 m
+// height on it
+std::vector<pcl::PointXYZ> createScan(const int num_beams, std::mt19937 & engine)
+{
+  std::normal_distribution<float> noise_distribution(0.0f, 0.02f);
+  constexpr float sensor_height = 1.8f;
+  constexpr float max_range = 120.0f;
+  std::vector<pcl::PointXYZ> cloud;
+  for (int beam = 0; beam < num_beams; ++beam) {
+    // beams from -25 to +15 degrees
+    const float tan_pitch = std::tan(DEG2RAD(-25.0f + 40.0f * beam / num_beams));
+    for (int step = 0; step < 1800; ++step) {
+      const float azimuth = DEG2RAD(0.2f * step);
+      // the first wall hit by the beam, the walls being every 13 m on a part of the azimuths
+      std::optional<float> range;
+      float z = 0.0f;
+      for (float wall_range = 6.0f; wall_range < max_range; wall_range += 13.0f) {
+        const float beam_height = sensor_height + wall_range * tan_pitch;
+        if (beam_height < 0.0f) {
+          break;
+        }
+        if (std::fmod(azimuth * 7.0f + wall_range, 6.283f) < 1.2f && beam_height < 2.0f) {
+          range = wall_range;
+          z = beam_height;
+          break;
+        }
+      }
+      // else the ground, no return above the horizon
+      if (!range && tan_pitch < 0.0f) {
+        range = sensor_height / -tan_pitch;
+      }
+      if (!range || max_range < *range) {
+        continue;
+      }
+      const float x = *range * std::cos(azimuth);
+      const float y = *range * std::sin(azimuth);
+      cloud.push_back(pcl::PointXYZ(x, y, z + 0.01f * x + noise_distribution(engine)));
+    }
+  }
+  return cloud;
+}
+
+// the mean time in ms of f, after a warm-up run
+template <typename F>
+double measure(F && f, const int num_iterations)
+{
+  f();
+  const auto start = Clock::now();
+  for (int i = 0; i < num_iterations; ++i) {
+    f();
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / num_iterations;
+}
+}  // namespace
+
+int main()
+{
+  std::mt19937 engine(0);
+  const auto param = createParameters();
+  const int max_threads = omp_get_max_threads();
+  for (const int num_beams : {32, 64, 128}) {
+    const auto cloud = createScan(num_beams, engine);
+    std::vector<float> xs, ys, zs;
+    for (const auto & point : cloud) {
+      xs.push_back(point.x);
+      ys.push_back(point.y);
+      zs.push_back(point.z);
+    }
+
+    std::vector<std::uint8_t> baseline_is_ground;
+    const double baseline_ms =
+      measure([&]() { baselineClassify(param, cloud, baseline_is_ground); }, 10);
+    RayGroundEngine ray_ground_engine;
+    std::vector<std::uint8_t> is_ground;
+    omp_set_num_threads(1);
+    const double single_thread_ms =
+      measure([&]() { ray_ground_engine.classify(param, xs, ys, zs, {}, is_ground); }, 10);
+    omp_set_num_threads(max_threads);
+    const double multi_thread_ms =
+      measure([&]() { ray_ground_engine.classify(param, xs, ys, zs, {}, is_ground); }, 10);
+
+    std::vector<std::uint8_t> stable_baseline_is_ground;
+    baselineClassify(param, cloud, stable_baseline_is_ground, true);
+    std::size_t num_differences = 0;
+    std::size_t num_stable_differences = 0;
+    for (std::size_t i = 0; i < is_ground.size(); ++i) {
+      num_differences += is_ground[i] != baseline_is_ground[i];
+      num_stable_differences += is_ground[i] != stable_baseline_is_ground[i];
+    }
+    std::cout << "beams: " << num_beams << ", points: " << cloud.size() << ", baseline "
+              << baseline_ms << " ms, engine " << single_thread_ms << " ms with 1 thread, "
+              << multi_thread_ms << " ms with " << max_threads << " threads, points classified "
+              << "differently: " << num_differences << " (" << num_stable_differences
+              << " with a stable sort)" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,264 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/ray_ground_filter/ray_ground_engine.hpp"
+
+#include <pcl/pcl_macros.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::ground_segmentation::RayGroundEngine;
+using autoware::ground_segmentation::RayGroundParameters;
+
+// the default parameters of config/ray_ground_filter.param.yaml
+RayGroundParameters createParameters()
+{
+  RayGroundParameters param;
+  param.general_max_slope = 8.0;
+  param.local_max_slope = 6.0;
+  param.initial_max_slope = 3.0;
+  param.radial_divider_angle = 1.0;
+  param.concentric_divider_distance = 0.0;
+  param.min_height_threshold = 0.15;
+  param.reclass_distance_threshold = 0.1;
+  return param;
+}
+
+struct ReferencePoint
+{
+  float x;
+  float y;
+  float z;
+  float radius;
+  std::size_t original_index;
+};
+
+// the previous classification of RayGroundFilterComponent, the points of each ray being sorted by
+// radius with a stable sort so that the order of the points of the same radius is defined
+std::vector<std::uint8_t> referenceClassify(
+  const RayGroundParameters & param, const std::vector<float> & xs, const std::vector<float> & ys,
+  const std::vector<float> & zs, const RayGroundEngine::InitialRadiusFunction & initial_radius)
+{
+  const auto radial_dividers_num = static_cast<std::size_t>(ceil(360 / param.radial_divider_angle));
+  std::vector<std::vector<ReferencePoint>> rays(radial_dividers_num);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    auto radius = static_cast<float>(sqrt(xs[i] * xs[i] + ys[i] * ys[i]));
+    auto theta = static_cast<float>(atan2(ys[i], xs[i])) * 180 / M_PI;
+    if (theta < 0) {
+      theta += 360;
+    }
+    if (theta >= 360) {
+      theta -= 360;
+    }
+    auto radial_div = static_cast<std::size_t>(floor(theta / param.radial_divider_angle));
+    rays[radial_div].push_back(ReferencePoint{xs[i], ys[i], zs[i], radius, i});
+  }
+
+  std::vector<std::uint8_t> is_ground(xs.size(), 0);
+  for (auto & ray : rays) {
+    std::stable_sort(ray.begin(), ray.end(), [](const auto & a, const auto & b) {
+      return a.radius < b.radius;
+    });
+    float prev_radius = 0.f;
+    float prev_height = 0.f;
+    bool prev_ground = false;
+    bool current_ground = false;
+    for (std::size_t j = 0; j < ray.size(); j++) {
+      double local_max_slope = param.local_max_slope;
+      if (j == 0) {
+        local_max_slope = param.initial_max_slope;
+        if (initial_radius) {
+          const auto radius = initial_radius(ray[j].x, ray[j].y);
+          if (!radius) {
+            continue;
+          }
+          prev_radius = *radius;
+        }
+      }
+      float points_distance = ray[j].radius - prev_radius;
+      float height_threshold = tan(DEG2RAD(local_max_slope)) * points_distance;
+      float current_height = ray[j].z;
+      float general_height_threshold = tan(DEG2RAD(param.general_max_slope)) * ray[j].radius;
+      if (height_threshold < param.min_height_threshold) {
+        height_threshold = param.min_height_threshold;
+      }
+      if (points_distance < param.concentric_divider_distance) {
+        current_ground = prev_ground;
+      } else {
+        if (
+          current_height <= (prev_height + height_threshold) &&
+          current_height >= (prev_height - height_threshold)) {
+          if (!prev_ground) {
+            current_ground = current_height <= general_height_threshold &&
+                             current_height >= -general_height_threshold;
+          } else {
+            current_ground = true;
+          }
+        } else {
+          current_ground = points_distance > param.reclass_distance_threshold &&
+                           (current_height <= general_height_threshold &&
+                            current_height >= -general_height_threshold);
+        }
+      }
+      is_ground[ray[j].original_index] = current_ground;
+      prev_ground = current_ground;
+      prev_radius = ray[j].radius;
+      prev_height = ray[j].z;
+    }
+  }
+  return is_ground;
+}
+
+// a scan of a ground of small slopes with boxes on it, a ring out of four being on the borders of
+// the rays
+void createScan(
+  const std::size_t num_rings, std::mt19937 & engine, std::vector<float> & xs,
+  std::vector<float> & ys, std::vector<float> & zs)
+{
+  std::normal_distribution<float> noise_distribution(0.0f, 0.02f);
+  std::uniform_real_distribution<float> azimuth_distribution(0.1f, 0.9f);
+  xs.clear();
+  ys.clear();
+  zs.clear();
+  for (std::size_t ring = 0; ring < num_rings; ++ring) {
+    const float range = 2.0f + 1.5f * static_cast<float>(ring);
+    for (int ray = 0; ray < 360; ++ray) {
+      const float azimuth_offset = ring % 4 == 0 ? 0.0f : azimuth_distribution(engine);
+      const float azimuth = static_cast<float>(DEG2RAD(ray + azimuth_offset));
+      const float x = range * std::cos(azimuth);
+      const float y = range * std::sin(azimuth);
+      float z = 0.02f * x + 0.01f * y + noise_distribution(engine);
+      // boxes of 1.5 m height
+      if (std::abs(std::fmod(x + 100.0f, 17.0f) - 8.0f) < 2.0f && std::abs(y) < 6.0f) {
+        z += 1.5f;
+      }
+      xs.push_back(x);
+      ys.push_back(y);
+      zs.push_back(z);
+    }
+  }
+}
+
+// points of random heights on the borders of all the rays
+void createBorderScan(
+  const double radial_divider_angle, std::mt19937 & engine, std::vector<float> & xs,
+  std::vector<float> & ys, std::vector<float> & zs)
+{
+  std::uniform_real_distribution<float> range_distribution(1.0f, 80.0f);
+  std::uniform_real_distribution<float> z_distribution(-0.3f, 0.6f);
+  xs.clear();
+  ys.clear();
+  zs.clear();
+  const auto num_rays = static_cast<int>(std::ceil(360.0 / radial_divider_angle));
+  for (int ray = 0; ray < num_rays; ++ray) {
+    const double azimuth = DEG2RAD(ray * radial_divider_angle);
+    for (int i = 0; i < 4; ++i) {
+      const double range = range_distribution(engine);
+      xs.push_back(static_cast<float>(range * std::cos(azimuth)));
+      ys.push_back(static_cast<float>(range * std::sin(azimuth)));
+      zs.push_back(z_distribution(engine));
+    }
+  }
+}
+}  // namespace
+
+TEST(RayGroundEngine, test_classify_matches_reference)
+{
+  std::mt19937 engine(0);
+  RayGroundEngine ray_ground_engine;
+  const auto param = createParameters();
+  std::vector<float> xs, ys, zs;
+  std::vector<std::uint8_t> is_ground;
+  // the buffers are reused between the calls
+  for (const std::size_t num_rings : {1, 16, 64, 16}) {
+    createScan(num_rings, engine, xs, ys, zs);
+    ray_ground_engine.classify(param, xs, ys, zs, {}, is_ground);
+    EXPECT_EQ(is_ground, referenceClassify(param, xs, ys, zs, {}));
+  }
+  EXPECT_GT(std::count(is_ground.begin(), is_ground.end(), 1), 0);
+  EXPECT_GT(std::count(is_ground.begin(), is_ground.end(), 0), 0);
+}
+
+TEST(RayGroundEngine, test_classify_with_initial_radius)
+{
+  std::mt19937 engine(1);
+  RayGroundEngine ray_ground_engine;
+  auto param = createParameters();
+  param.concentric_divider_distance = 0.5;
+  std::vector<float> xs, ys, zs;
+  createScan(32, engine, xs, ys, zs);
+  // the footprint is not crossed by the rays of positive y
+  const RayGroundEngine::InitialRadiusFunction initial_radius =
+    [](const float, const float y) -> std::optional<float> {
+    if (0.0f < y) {
+      return std::nullopt;
+    }
+    return 1.5f;
+  };
+  std::vector<std::uint8_t> is_ground;
+  ray_ground_engine.classify(param, xs, ys, zs, initial_radius, is_ground);
+  EXPECT_EQ(is_ground, referenceClassify(param, xs, ys, zs, initial_radius));
+}
+
+TEST(RayGroundEngine, test_classify_random_points)
+{
+  std::mt19937 engine(2);
+  std::uniform_real_distribution<float> xy_distribution(-80.0f, 80.0f);
+  std::uniform_real_distribution<float> z_distribution(-0.5f, 2.0f);
+  RayGroundEngine ray_ground_engine;
+  auto param = createParameters();
+  param.radial_divider_angle = 0.7;
+  std::vector<float> xs, ys, zs;
+  for (int i = 0; i < 50000; ++i) {
+    xs.push_back(xy_distribution(engine));
+    ys.push_back(xy_distribution(engine));
+    zs.push_back(z_distribution(engine));
+  }
+  std::vector<std::uint8_t> is_ground;
+  ray_ground_engine.classify(param, xs, ys, zs, {}, is_ground);
+  EXPECT_EQ(is_ground, referenceClassify(param, xs, ys, zs, {}));
+}
+
+TEST(RayGroundEngine, test_classify_fine_rays)
+{
+  // the azimuth is rounded to more ray widths than for the default rays
+  std::mt19937 engine(3);
+  RayGroundEngine ray_ground_engine;
+  auto param = createParameters();
+  std::vector<float> xs, ys, zs;
+  std::vector<std::uint8_t> is_ground;
+  for (const double radial_divider_angle : {0.2, 0.1}) {
+    param.radial_divider_angle = radial_divider_angle;
+    createBorderScan(radial_divider_angle, engine, xs, ys, zs);
+    ray_ground_engine.classify(param, xs, ys, zs, {}, is_ground);
+    EXPECT_EQ(is_ground, referenceClassify(param, xs, ys, zs, {})) << radial_divider_angle;
+  }
+}
+
+TEST(RayGroundEngine, test_classify_empty)
+{
+  RayGroundEngine ray_ground_engine;
+  std::vector<std::uint8_t> is_ground(3, 1);
+  ray_ground_engine.classify(createParameters(), {}, {}, {}, {}, is_ground);
+  EXPECT_TRUE(is_ground.empty());
+}
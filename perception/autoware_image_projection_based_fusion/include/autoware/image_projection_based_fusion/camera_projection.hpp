@@ -24,7 +24,9 @@
 
 #include <image_geometry/pinhole_camera_model.h>
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace autoware::image_projection_based_fusion
 {
@@ -43,6 +45,9 @@ public:
   CameraProjection() : cell_width_(1.0), cell_height_(1.0), unrectify_(false) {}
   void initialize();
   std::function<bool(const cv::Point3d &, Eigen::Vector2d &)> calcImageProjectedPoint;
+  void calcImageProjectedPoints(
+    const std::vector<float> & xs, const std::vector<float> & ys, const std::vector<float> & zs,
+    std::vector<Eigen::Vector2d> & projected_points, std::vector<std::uint8_t> & is_projected);
   sensor_msgs::msg::CameraInfo getCameraInfo();
   bool isOutsideHorizontalView(const float px, const float pz);
   bool isOutsideVerticalView(const float py, const float pz);
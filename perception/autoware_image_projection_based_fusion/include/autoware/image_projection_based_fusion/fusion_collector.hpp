@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace autoware::image_projection_based_fusion
@@ -99,12 +100,23 @@ public:
   void show_debug_message();
 
 private:
+  void fuse_rois(const std::size_t rois_id, const typename Msg2D::ConstSharedPtr & rois_msg);
+  void fuse_waiting_rois();
+  void preprocess_output();
+  void drop_partial_result();
+
   std::shared_ptr<FusionNode<Msg3D, Msg2D, ExportObj>> ros2_parent_node_;
   rclcpp::TimerBase::SharedPtr timer_;
   std::size_t rois_number_;
   typename Msg3D::ConstSharedPtr msg3d_{nullptr};
   std::vector<Det2dStatus<Msg2D>> det2d_status_list_;
   std::unordered_map<std::size_t, typename Msg2D::ConstSharedPtr> id_to_rois_map_;
+  // the ids of id_to_rois_map_ in arrival order, in which the ROIs are fused
+  std::vector<std::size_t> rois_ids_in_arrival_order_;
+  // partial result of the ROIs fused so far, the message is reused by the next collections
+  typename Msg3D::SharedPtr output_det3d_msg_;
+  bool is_output_preprocessed_{false};
+  std::unordered_set<std::size_t> fused_rois_ids_;
   bool is_first_msg3d_{false};
   bool debug_mode_;
   std::mutex fusion_mutex_;
@@ -68,6 +68,9 @@ public:
     const std::string & node_name, const rclcpp::NodeOptions & options, int queue_size);
 
   virtual void preprocess(Msg3D & output_msg);
+  // the ROIs are fused on their arrival, so the fusions of several msg3d can be interleaved and
+  // a collector can be reset between preprocess and postprocess, which drops its partial result
+  virtual void discard_partial_result(const Msg3D & processing_msg);
   virtual void fuse_on_single_image(
     const Msg3D & input_msg3d, const Det2dStatus<Msg2D> & det2d_status,
     const Msg2D & input_rois_msg, Msg3D & output_msg) = 0;
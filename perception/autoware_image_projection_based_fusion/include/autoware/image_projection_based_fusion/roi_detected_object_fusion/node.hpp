@@ -39,6 +39,8 @@ public:
 private:
   void preprocess(DetectedObjects & output_msg) override;
 
+  void discard_partial_result(const DetectedObjects & processing_msg) override;
+
   void fuse_on_single_image(
     const DetectedObjects & input_object_msg, const Det2dStatus<RoiMsgType> & det2d_status,
     const RoiMsgType & input_rois_msg, DetectedObjects & output_object_msg) override;
@@ -17,8 +17,10 @@
 
 #include "autoware/image_projection_based_fusion/fusion_node.hpp"
 
+#include <autoware/image_projection_based_fusion/utils/roi_raster.hpp>
 #include <autoware/image_projection_based_fusion/utils/utils.hpp>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -38,6 +40,8 @@ private:
     const PointCloudMsgType & input_pointcloud_msg, const Det2dStatus<RoiMsgType> & det2d_status,
     const RoiMsgType & input_rois_msg, PointCloudMsgType & output_pointcloud_msg) override;
 
+  void discard_partial_result(const PointCloudMsgType & pointcloud_msg) override;
+
   void postprocess(const PointCloudMsgType & pointcloud_msg, ClusterMsgType & output_msg) override;
 
   void publish(const ClusterMsgType & output_msg) override;
@@ -50,7 +54,9 @@ private:
   double roi_scale_factor_{1.0};
   bool override_class_with_unknown_{false};
 
-  std::vector<ClusterObjType> output_fused_objects_;
+  // the clusters of each pointcloud timestamp, until its ROIs are all fused
+  std::map<int64_t, std::vector<ClusterObjType>> output_fused_objects_map_;
+  RoiRaster roi_raster_;
 };
 
 }  // namespace autoware::image_projection_based_fusion
@@ -20,8 +20,10 @@
 #include <autoware/image_projection_based_fusion/utils/utils.hpp>
 #include <image_transport/image_transport.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -46,6 +48,8 @@ private:
     const PointCloudMsgType & input_pointcloud_msg, const Det2dStatus<Image> & det2d_status,
     const Image & input_mask, PointCloudMsgType & output_pointcloud_msg) override;
 
+  void discard_partial_result(const PointCloudMsgType & pointcloud_msg) override;
+
   inline void copyPointCloud(
     const PointCloudMsgType & input, const int point_step, const size_t global_offset,
     PointCloudMsgType & output, size_t & output_pointcloud_size)
@@ -70,7 +74,8 @@ private:
     {"CURBSTONE", false},     {"CROSSWALK", false},    {"VEGETATION", false}, {"SKY", false}};
 
   bool is_publish_debug_mask_;
-  std::unordered_set<size_t> filter_global_offset_set_;
+  // the offsets of the filtered points for each pointcloud timestamp, until its masks are all fused
+  std::unordered_map<int64_t, std::unordered_set<size_t>> filter_global_offset_set_map_;
 };
 
 }  // namespace autoware::image_projection_based_fusion
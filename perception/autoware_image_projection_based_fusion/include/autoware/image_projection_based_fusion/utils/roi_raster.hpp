@@ -0,0 +1,109 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__IMAGE_PROJECTION_BASED_FUSION__UTILS__ROI_RASTER_HPP_
+#define AUTOWARE__IMAGE_PROJECTION_BASED_FUSION__UTILS__ROI_RASTER_HPP_
+
+#include <sensor_msgs/msg/region_of_interest.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::image_projection_based_fusion
+{
+
+/**
+ * \brief The scaled ROIs of one image rasterized into a bitset image.
+ *
+ * Each cell of the raster holds one bit per ROI, set for the ROIs overlapping the cell. The ROIs
+ * containing a point are then found from the bits of the cell under the point, and checked with
+ * the same comparisons as isPointInsideRoi so that the result does not depend on the cell size.
+ * The buffers are kept between the images.
+ */
+class RoiRaster
+{
+public:
+  explicit RoiRaster(const double cell_size = 8.0);
+
+  /** \brief Rasterize the ROIs scaled by roi_scale_factor, the ROI indices are kept */
+  void build(
+    const std::vector<sensor_msgs::msg::RegionOfInterest> & rois, const double roi_scale_factor);
+
+  bool empty() const { return boxes_.empty(); }
+  std::size_t size() const { return boxes_.size(); }
+  double getCellSize() const { return cell_size_; }
+
+  /** \brief Call function(roi_index) for the ROIs containing the point, in ascending order */
+  template <class F>
+  void forEachRoiContaining(const double px, const double py, F && function) const
+  {
+    // also rejects NaN
+    if (!(px >= min_x_ && px <= max_x_ && py >= min_y_ && py <= max_y_)) {
+      return;
+    }
+    const std::uint64_t * words =
+      &bits_[(toCell(py, min_y_, num_cells_y_) * num_cells_x_ + toCell(px, min_x_, num_cells_x_)) *
+             num_words_];
+    for (std::size_t w = 0; w < num_words_; ++w) {
+      for (std::uint64_t word = words[w]; word != 0; word &= word - 1) {
+        const std::size_t index = w * 64 + static_cast<std::size_t>(__builtin_ctzll(word));
+        const Box & box = boxes_[index];
+        if (box.min_x <= px && box.min_y <= py && box.max_x >= px && box.max_y >= py) {
+          function(index);
+        }
+      }
+    }
+  }
+
+private:
+  struct Box
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  // the cells are enlarged for the ROIs spread too far for this number of cells
+  static constexpr std::size_t max_num_cells = 1U << 20;
+
+  // monotonic in value, so that a point inside a box is in a cell covered by the box
+  std::size_t toCell(const double value, const double origin, const std::size_t size) const
+  {
+    const double index = std::floor((value - origin) * inverse_cell_size_);
+    return static_cast<std::size_t>(std::clamp(index, 0.0, static_cast<double>(size - 1)));
+  }
+
+  double default_cell_size_;
+  double cell_size_;
+  double inverse_cell_size_;
+  double min_x_{0.0};
+  double min_y_{0.0};
+  double max_x_{-1.0};
+  double max_y_{-1.0};
+  std::size_t num_cells_x_{0};
+  std::size_t num_cells_y_{0};
+  std::size_t num_words_{0};
+
+  std::vector<Box> boxes_;
+  // num_words_ words of bits for each cell
+  std::vector<std::uint64_t> bits_;
+};
+
+}  // namespace autoware::image_projection_based_fusion
+
+#endif  // AUTOWARE__IMAGE_PROJECTION_BASED_FUSION__UTILS__ROI_RASTER_HPP_
@@ -212,6 +212,70 @@ bool CameraProjection::calcRawImageProjectedPointWithApproximation(
   return true;
 }
 
+/**
+ * @brief Calculate the projections of a batch of 3D points given as arrays of coordinates.
+ * The results are the same as calcImageProjectedPoint for each point, but the projection mode is
+ * resolved once for the batch and the pinhole projection runs over the arrays so that it can be
+ * vectorized. The points behind the camera are not projected.
+ * @param is_projected Set to 1 for the points which are projected on the image plane, 0 otherwise.
+ */
+void CameraProjection::calcImageProjectedPoints(
+  const std::vector<float> & xs, const std::vector<float> & ys, const std::vector<float> & zs,
+  std::vector<Eigen::Vector2d> & projected_points, std::vector<std::uint8_t> & is_projected)
+{
+  const std::size_t num_points = xs.size();
+  projected_points.resize(num_points);
+  is_projected.resize(num_points);
+
+  // same arithmetic as PinholeCameraModel::project3dToPixel
+  const double fx = camera_model_.fx();
+  const double fy = camera_model_.fy();
+  const double cx = camera_model_.cx();
+  const double cy = camera_model_.cy();
+  const double tx = camera_model_.Tx();
+  const double ty = camera_model_.Ty();
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double z = zs[i];
+    projected_points[i] << (fx * xs[i] + tx) / z + cx, (fy * ys[i] + ty) / z + cy;
+    is_projected[i] = z > 0.0;
+  }
+
+  if (use_approximation_ && unrectify_) {
+    for (std::size_t i = 0; i < num_points; ++i) {
+      if (!is_projected[i]) continue;
+      // round to a near grid cell, the indices are checked before the conversion to int
+      const double grid_idx_x = std::floor(projected_points[i].x() * inv_cell_width_);
+      const double grid_idx_y = std::floor(projected_points[i].y() * inv_cell_height_);
+      if (
+        !(grid_idx_x >= 0.0 && grid_idx_x < grid_width_ && grid_idx_y >= 0.0 &&
+          grid_idx_y < grid_height_)) {
+        is_projected[i] = 0;
+        continue;
+      }
+      const uint32_t grid_index =
+        static_cast<int>(grid_idx_y) * grid_width_ + static_cast<int>(grid_idx_x);
+      projected_points[i] << projection_cache_[grid_index].x, projection_cache_[grid_index].y;
+    }
+    return;
+  }
+
+  const double width = static_cast<double>(image_width_);
+  const double height = static_cast<double>(image_height_);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const double u = projected_points[i].x();
+    const double v = projected_points[i].y();
+    is_projected[i] = is_projected[i] && u >= 0.0 && u < width && v >= 0.0 && v < height;
+  }
+  if (unrectify_) {
+    for (std::size_t i = 0; i < num_points; ++i) {
+      if (!is_projected[i]) continue;
+      const cv::Point2d raw_image_point = camera_model_.unrectifyPoint(
+        cv::Point2d(projected_points[i].x(), projected_points[i].y()));
+      projected_points[i] << raw_image_point.x, raw_image_point.y;
+    }
+  }
+}
+
 sensor_msgs::msg::CameraInfo CameraProjection::getCameraInfo()
 {
   return camera_info_;
@@ -19,6 +19,7 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -38,6 +39,7 @@ FusionCollector<Msg3D, Msg2D, ExportObj>::FusionCollector(
   debug_mode_(debug_mode)
 {
   status_ = CollectorStatus::Idle;
+  output_det3d_msg_ = std::make_shared<Msg3D>();
 
   auto init_timeout_sec = 1.0;  // This will be overwritten when input come
   const auto period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -94,7 +96,11 @@ void FusionCollector<Msg3D, Msg2D, ExportObj>::process_msg3d(
     }
   }
 
+  // the ROIs fused with a previous msg3d are fused again with this one
+  drop_partial_result();
   msg3d_ = msg3d;
+  // the ROIs which arrived before the msg3d are fused now, the next ones on their arrival
+  fuse_waiting_rois();
   if (ready_to_fuse()) {
     fusion_callback();
   }
@@ -124,12 +130,72 @@ void FusionCollector<Msg3D, Msg2D, ExportObj>::process_rois(
     }
   }
 
+  if (fused_rois_ids_.find(rois_id) != fused_rois_ids_.end()) {
+    // the partial result has the previous ROIs of this camera, fuse all the ROIs again
+    drop_partial_result();
+  }
+  if (id_to_rois_map_.find(rois_id) != id_to_rois_map_.end()) {
+    // the latest ROIs of a camera arrived last
+    rois_ids_in_arrival_order_.erase(std::find(
+      rois_ids_in_arrival_order_.begin(), rois_ids_in_arrival_order_.end(), rois_id));
+  }
+  rois_ids_in_arrival_order_.push_back(rois_id);
   id_to_rois_map_[rois_id] = rois_msg;
+  // fuse the ROIs on their arrival, so that only the export is left for the last ones
+  fuse_waiting_rois();
   if (ready_to_fuse()) {
     fusion_callback();
   }
 }
 
+template <class Msg3D, class Msg2D, class ExportObj>
+void FusionCollector<Msg3D, Msg2D, ExportObj>::fuse_rois(
+  const std::size_t rois_id, const typename Msg2D::ConstSharedPtr & rois_msg)
+{
+  preprocess_output();
+  ros2_parent_node_->fuse_on_single_image(
+    *msg3d_, det2d_status_list_[rois_id], *rois_msg, *output_det3d_msg_);
+  fused_rois_ids_.insert(rois_id);
+}
+
+template <class Msg3D, class Msg2D, class ExportObj>
+void FusionCollector<Msg3D, Msg2D, ExportObj>::fuse_waiting_rois()
+{
+  if (!msg3d_) {
+    return;
+  }
+  for (const auto rois_id : rois_ids_in_arrival_order_) {
+    // the ROIs without camera info are left to the fusion callback, it may arrive until then
+    if (
+      fused_rois_ids_.find(rois_id) == fused_rois_ids_.end() &&
+      det2d_status_list_[rois_id].camera_projector_ptr != nullptr) {
+      fuse_rois(rois_id, id_to_rois_map_.at(rois_id));
+    }
+  }
+}
+
+template <class Msg3D, class Msg2D, class ExportObj>
+void FusionCollector<Msg3D, Msg2D, ExportObj>::preprocess_output()
+{
+  if (is_output_preprocessed_) {
+    return;
+  }
+  // copy assignment keeps the buffers of the previous collection
+  *output_det3d_msg_ = *msg3d_;
+  ros2_parent_node_->preprocess(*output_det3d_msg_);
+  is_output_preprocessed_ = true;
+}
+
+template <class Msg3D, class Msg2D, class ExportObj>
+void FusionCollector<Msg3D, Msg2D, ExportObj>::drop_partial_result()
+{
+  if (is_output_preprocessed_) {
+    ros2_parent_node_->discard_partial_result(*output_det3d_msg_);
+  }
+  is_output_preprocessed_ = false;
+  fused_rois_ids_.clear();
+}
+
 template <class Msg3D, class Msg2D, class ExportObj>
 bool FusionCollector<Msg3D, Msg2D, ExportObj>::ready_to_fuse()
 {
@@ -169,21 +235,24 @@ void FusionCollector<Msg3D, Msg2D, ExportObj>::fusion_callback()
     return;
   }
 
-  typename Msg3D::SharedPtr output_det3d_msg = std::make_shared<Msg3D>(*msg3d_);
-  ros2_parent_node_->preprocess(*output_det3d_msg);
-
-  for (const auto & [rois_id, rois_msg] : id_to_rois_map_) {
+  // the ROIs are fused on their arrival, only the ones whose camera info was missing are left
+  preprocess_output();
+  for (const auto rois_id : rois_ids_in_arrival_order_) {
+    if (fused_rois_ids_.find(rois_id) != fused_rois_ids_.end()) {
+      continue;
+    }
     if (det2d_status_list_[rois_id].camera_projector_ptr == nullptr) {
       RCLCPP_WARN_THROTTLE(
         ros2_parent_node_->get_logger(), *ros2_parent_node_->get_clock(), 5000,
         "no camera info. id is %zu", rois_id);
       continue;
     }
-    ros2_parent_node_->fuse_on_single_image(
-      *msg3d_, det2d_status_list_[rois_id], *rois_msg, *output_det3d_msg);
+    fuse_rois(rois_id, id_to_rois_map_.at(rois_id));
   }
 
-  ros2_parent_node_->export_process(output_det3d_msg, id_to_stamp_map, fusion_collector_info_);
+  ros2_parent_node_->export_process(output_det3d_msg_, id_to_stamp_map, fusion_collector_info_);
+  is_output_preprocessed_ = false;
+  fused_rois_ids_.clear();
   status_ = CollectorStatus::Finished;
 }
 
@@ -235,8 +304,10 @@ void FusionCollector<Msg3D, Msg2D, ExportObj>::reset()
 {
   std::lock_guard<std::mutex> lock(fusion_mutex_);
 
+  drop_partial_result();
   status_ = CollectorStatus::Idle;  // Reset status to Idle
   id_to_rois_map_.clear();
+  rois_ids_in_arrival_order_.clear();
   msg3d_ = nullptr;
   fusion_collector_info_ = nullptr;
   is_first_msg3d_ = false;
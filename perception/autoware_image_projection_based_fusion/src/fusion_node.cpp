@@ -286,6 +286,14 @@ void FusionNode<Msg3D, Msg2D, ExportObj>::preprocess([[maybe_unused]] Msg3D & ou
   // This function can be overridden by derived classes if needed.
 }
 
+template <class Msg3D, class Msg2D, class ExportObj>
+void FusionNode<Msg3D, Msg2D, ExportObj>::discard_partial_result(
+  [[maybe_unused]] const Msg3D & processing_msg)
+{
+  // Default implementation: No state is kept between preprocess and postprocess.
+  // This function must be overridden by derived classes which keep a state for each msg3d.
+}
+
 template <class Msg3D, class Msg2D, class ExportObj>
 void FusionNode<Msg3D, Msg2D, ExportObj>::export_process(
   typename Msg3D::SharedPtr & output_det3d_msg,
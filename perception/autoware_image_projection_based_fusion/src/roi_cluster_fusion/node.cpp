@@ -22,6 +22,7 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -99,6 +100,10 @@ void RoiClusterFusionNode::fuse_on_single_image(
   }
 
   std::map<std::size_t, RegionOfInterest> m_cluster_roi;
+  // buffers of the batched projection, reused for the clusters
+  std::vector<float> xs, ys, zs;
+  std::vector<Eigen::Vector2d> projected_points;
+  std::vector<std::uint8_t> is_projected;
 
   for (std::size_t i = 0; i < input_cluster_msg.feature_objects.size(); ++i) {
     if (input_cluster_msg.feature_objects.at(i).feature.cluster.data.empty()) {
@@ -119,32 +124,41 @@ void RoiClusterFusionNode::fuse_on_single_image(
       input_cluster_msg.feature_objects.at(i).feature.cluster, transformed_cluster,
       transform_stamped);
 
-    int min_x(camera_info.width), min_y(camera_info.height), max_x(0), max_y(0);
-    std::vector<Eigen::Vector2d> projected_points;
-    projected_points.reserve(transformed_cluster.data.size());
+    xs.clear();
+    ys.clear();
+    zs.clear();
     for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
          iter_y(transformed_cluster, "y"), iter_z(transformed_cluster, "z");
          iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
       if (*iter_z <= 0.0) {
         continue;
       }
+      xs.push_back(*iter_x);
+      ys.push_back(*iter_y);
+      zs.push_back(*iter_z);
+    }
+    det2d_status.camera_projector_ptr->calcImageProjectedPoints(
+      xs, ys, zs, projected_points, is_projected);
 
-      Eigen::Vector2d projected_point;
-      if (det2d_status.camera_projector_ptr->calcImageProjectedPoint(
-            cv::Point3d(*iter_x, *iter_y, *iter_z), projected_point)) {
-        const int px = static_cast<int>(projected_point.x());
-        const int py = static_cast<int>(projected_point.y());
+    int min_x(camera_info.width), min_y(camera_info.height), max_x(0), max_y(0);
+    bool has_projected_point = false;
+    for (std::size_t j = 0; j < projected_points.size(); ++j) {
+      if (!is_projected[j]) {
+        continue;
+      }
+      const auto & projected_point = projected_points[j];
+      const int px = static_cast<int>(projected_point.x());
+      const int py = static_cast<int>(projected_point.y());
 
-        min_x = std::min(px, min_x);
-        min_y = std::min(py, min_y);
-        max_x = std::max(px, max_x);
-        max_y = std::max(py, max_y);
+      min_x = std::min(px, min_x);
+      min_y = std::min(py, min_y);
+      max_x = std::max(px, max_x);
+      max_y = std::max(py, max_y);
 
-        projected_points.push_back(projected_point);
-        if (debugger_) debugger_->obstacle_points_.push_back(projected_point);
-      }
+      has_projected_point = true;
+      if (debugger_) debugger_->obstacle_points_.push_back(projected_point);
     }
-    if (projected_points.empty()) {
+    if (!has_projected_point) {
       continue;
     }
 
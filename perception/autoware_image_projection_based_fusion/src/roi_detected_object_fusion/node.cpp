@@ -347,6 +347,15 @@ void RoiDetectedObjectFusionNode::postprocess(
   ignored_object_flags_map_.erase(timestamp_nsec);
 }
 
+void RoiDetectedObjectFusionNode::discard_partial_result(const DetectedObjects & processing_msg)
+{
+  int64_t timestamp_nsec = processing_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+                           processing_msg.header.stamp.nanosec;
+  passthrough_object_flags_map_.erase(timestamp_nsec);
+  fused_object_flags_map_.erase(timestamp_nsec);
+  ignored_object_flags_map_.erase(timestamp_nsec);
+}
+
 }  // namespace autoware::image_projection_based_fusion
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -19,7 +19,9 @@
 
 #include <autoware_utils/system/time_keeper.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -130,6 +132,14 @@ void RoiPointCloudFusionNode::fuse_on_single_image(
     cluster.fields = input_pointcloud_msg.fields;
     cluster.data.reserve(input_pointcloud_msg.data.size());
   }
+  // gather the points in the horizontal view to project them in one batch
+  std::vector<float> xs, ys, zs;
+  std::vector<std::size_t> offsets;
+  const std::size_t num_points = input_pointcloud_msg.data.size() / point_step;
+  xs.reserve(num_points);
+  ys.reserve(num_points);
+  zs.reserve(num_points);
+  offsets.reserve(num_points);
   for (size_t offset = 0; offset < input_pointcloud_msg.data.size(); offset += point_step) {
     const float transformed_x =
       *reinterpret_cast<const float *>(&transformed_cloud.data[offset + x_offset]);
@@ -140,38 +150,53 @@ void RoiPointCloudFusionNode::fuse_on_single_image(
     if (det2d_status.camera_projector_ptr->isOutsideHorizontalView(transformed_x, transformed_z)) {
       continue;
     }
+    xs.push_back(transformed_x);
+    ys.push_back(transformed_y);
+    zs.push_back(transformed_z);
+    offsets.push_back(offset);
+  }
+  std::vector<Eigen::Vector2d> projected_points;
+  std::vector<std::uint8_t> is_projected;
+  det2d_status.camera_projector_ptr->calcImageProjectedPoints(
+    xs, ys, zs, projected_points, is_projected);
+
+  // the ROIs containing a point are looked up in the raster instead of checking all of them
+  std::vector<sensor_msgs::msg::RegionOfInterest> check_rois;
+  check_rois.reserve(output_objs.size());
+  for (const auto & feature_obj : output_objs) {
+    check_rois.push_back(feature_obj.feature.roi);
+  }
+  roi_raster_.build(check_rois, roi_scale_factor_);
 
-    Eigen::Vector2d projected_point;
-    if (det2d_status.camera_projector_ptr->calcImageProjectedPoint(
-          cv::Point3d(transformed_x, transformed_y, transformed_z), projected_point)) {
-      for (std::size_t i = 0; i < output_objs.size(); ++i) {
-        auto & feature_obj = output_objs.at(i);
-        const auto & check_roi = feature_obj.feature.roi;
-        auto & cluster = clusters.at(i);
-
-        const double px = projected_point.x();
-        const double py = projected_point.y();
-
-        // is not correct to skip fusion and keep a cluster with a partial of points
-        if (isPointInsideRoi(check_roi, px, py, roi_scale_factor_)) {
-          // append point data to clusters data vector
-          cluster.data.insert(
-            cluster.data.end(), &input_pointcloud_msg.data[offset],
-            &input_pointcloud_msg.data[offset + point_step]);
-        }
-      }
-      if (debugger_) {
-        // add all points inside image to debug
-        debug_image_points.push_back(projected_point);
-      }
+  for (std::size_t j = 0; j < offsets.size(); ++j) {
+    if (!is_projected[j]) {
+      continue;
+    }
+    const auto & projected_point = projected_points[j];
+    const std::size_t offset = offsets[j];
+    // is not correct to skip fusion and keep a cluster with a partial of points
+    roi_raster_.forEachRoiContaining(
+      projected_point.x(), projected_point.y(), [&](const std::size_t i) {
+        // append point data to clusters data vector
+        auto & cluster = clusters[i];
+        cluster.data.insert(
+          cluster.data.end(), &input_pointcloud_msg.data[offset],
+          &input_pointcloud_msg.data[offset + point_step]);
+      });
+    if (debugger_) {
+      // add all points inside image to debug
+      debug_image_points.push_back(projected_point);
     }
   }
 
-  // refine and update output_fused_objects_
+  // refine and update the output fused objects of this pointcloud
+  const int64_t timestamp_nsec =
+    input_pointcloud_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+    input_pointcloud_msg.header.stamp.nanosec;
   updateOutputFusedObjects(
     output_objs, clusters, input_pointcloud_msg, input_rois_msg.header, tf_buffer_,
     min_cluster_size_, max_cluster_size_, cluster_2d_tolerance_, max_object_size_,
-    output_fused_objects_);
+    output_fused_objects_map_[timestamp_nsec]);
 
   // publish debug image
   if (debugger_) {
@@ -188,9 +213,14 @@ void RoiPointCloudFusionNode::postprocess(
   if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
 
   output_msg.header = pointcloud_msg.header;
-  output_msg.feature_objects = output_fused_objects_;
-
-  output_fused_objects_.clear();
+  output_msg.feature_objects.clear();
+  const int64_t timestamp_nsec = pointcloud_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+                                 pointcloud_msg.header.stamp.nanosec;
+  const auto it = output_fused_objects_map_.find(timestamp_nsec);
+  if (it != output_fused_objects_map_.end()) {
+    output_msg.feature_objects = std::move(it->second);
+    output_fused_objects_map_.erase(it);
+  }
 
   // publish debug cluster
   if (cluster_debug_pub_->get_subscription_count() > 0) {
@@ -200,6 +230,13 @@ void RoiPointCloudFusionNode::postprocess(
   }
 }
 
+void RoiPointCloudFusionNode::discard_partial_result(const PointCloudMsgType & pointcloud_msg)
+{
+  const int64_t timestamp_nsec = pointcloud_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+                                 pointcloud_msg.header.stamp.nanosec;
+  output_fused_objects_map_.erase(timestamp_nsec);
+}
+
 void RoiPointCloudFusionNode::publish(const ClusterMsgType & output_msg)
 {
   const auto objects_sub_count =
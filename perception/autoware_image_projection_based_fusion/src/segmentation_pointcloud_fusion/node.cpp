@@ -21,6 +21,8 @@
 #include <perception_utils/run_length_encoder.hpp>
 
 #include <memory>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -114,6 +116,10 @@ void SegmentPointCloudFusionNode::fuse_on_single_image(
   int y_offset = input_pointcloud_msg.fields[pcl::getFieldIndex(input_pointcloud_msg, "y")].offset;
   int z_offset = input_pointcloud_msg.fields[pcl::getFieldIndex(input_pointcloud_msg, "z")].offset;
 
+  const int64_t timestamp_nsec =
+    input_pointcloud_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+    input_pointcloud_msg.header.stamp.nanosec;
+  auto & filter_global_offset_set = filter_global_offset_set_map_[timestamp_nsec];
   for (size_t global_offset = 0; global_offset < transformed_cloud.data.size();
        global_offset += point_step) {
     float transformed_x =
@@ -145,7 +151,7 @@ void SegmentPointCloudFusionNode::fuse_on_single_image(
       continue;
     }
 
-    filter_global_offset_set_.insert(global_offset);
+    filter_global_offset_set.insert(global_offset);
   }
 }
 
@@ -161,10 +167,16 @@ void SegmentPointCloudFusionNode::postprocess(
   output_msg.data.resize(pointcloud_msg.data.size());
   const int point_step = pointcloud_msg.point_step;
 
+  const int64_t timestamp_nsec = pointcloud_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+                                 pointcloud_msg.header.stamp.nanosec;
+  const std::unordered_set<size_t> filter_global_offset_set =
+    std::move(filter_global_offset_set_map_[timestamp_nsec]);
+  filter_global_offset_set_map_.erase(timestamp_nsec);
+
   size_t output_pointcloud_size = 0;
   for (size_t global_offset = 0; global_offset < pointcloud_msg.data.size();
        global_offset += point_step) {
-    if (filter_global_offset_set_.find(global_offset) == filter_global_offset_set_.end()) {
+    if (filter_global_offset_set.find(global_offset) == filter_global_offset_set.end()) {
       copyPointCloud(pointcloud_msg, point_step, global_offset, output_msg, output_pointcloud_size);
     }
   }
@@ -178,11 +190,16 @@ void SegmentPointCloudFusionNode::postprocess(
     output_msg.row_step = 0;
     output_msg.width = 0;
   }
-
-  filter_global_offset_set_.clear();
   return;
 }
 
+void SegmentPointCloudFusionNode::discard_partial_result(const PointCloudMsgType & pointcloud_msg)
+{
+  const int64_t timestamp_nsec = pointcloud_msg.header.stamp.sec * static_cast<int64_t>(1e9) +
+                                 pointcloud_msg.header.stamp.nanosec;
+  filter_global_offset_set_map_.erase(timestamp_nsec);
+}
+
 }  // namespace autoware::image_projection_based_fusion
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -0,0 +1,87 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/image_projection_based_fusion/utils/roi_raster.hpp"
+
+#include <limits>
+
+namespace autoware::image_projection_based_fusion
+{
+
+RoiRaster::RoiRaster(const double cell_size)
+: default_cell_size_(cell_size), cell_size_(cell_size), inverse_cell_size_(1.0 / cell_size)
+{
+}
+
+void RoiRaster::build(
+  const std::vector<sensor_msgs::msg::RegionOfInterest> & rois, const double roi_scale_factor)
+{
+  boxes_.clear();
+  bits_.clear();
+  min_x_ = std::numeric_limits<double>::max();
+  min_y_ = std::numeric_limits<double>::max();
+  max_x_ = std::numeric_limits<double>::lowest();
+  max_y_ = std::numeric_limits<double>::lowest();
+  num_cells_x_ = 0;
+  num_cells_y_ = 0;
+  num_words_ = 0;
+  if (rois.empty()) {
+    return;
+  }
+
+  // the boxes are computed as in isPointInsideRoi
+  boxes_.reserve(rois.size());
+  for (const auto & roi : rois) {
+    const auto scaled_width = static_cast<double>(roi.width) * roi_scale_factor;
+    const auto scaled_height = static_cast<double>(roi.height) * roi_scale_factor;
+    Box box;
+    box.min_x = static_cast<double>(roi.x_offset) - (scaled_width - roi.width) / 2.0;
+    box.min_y = static_cast<double>(roi.y_offset) - (scaled_height - roi.height) / 2.0;
+    box.max_x = box.min_x + scaled_width;
+    box.max_y = box.min_y + scaled_height;
+    boxes_.push_back(box);
+    min_x_ = std::min(min_x_, box.min_x);
+    min_y_ = std::min(min_y_, box.min_y);
+    max_x_ = std::max(max_x_, box.max_x);
+    max_y_ = std::max(max_y_, box.max_y);
+  }
+
+  cell_size_ = default_cell_size_;
+  const double area = (max_x_ - min_x_ + cell_size_) * (max_y_ - min_y_ + cell_size_);
+  if (area > static_cast<double>(max_num_cells) * cell_size_ * cell_size_) {
+    cell_size_ = std::sqrt(area / static_cast<double>(max_num_cells));
+  }
+  inverse_cell_size_ = 1.0 / cell_size_;
+  num_cells_x_ = static_cast<std::size_t>((max_x_ - min_x_) * inverse_cell_size_) + 1;
+  num_cells_y_ = static_cast<std::size_t>((max_y_ - min_y_) * inverse_cell_size_) + 1;
+  num_words_ = (boxes_.size() + 63) / 64;
+
+  bits_.assign(num_cells_x_ * num_cells_y_ * num_words_, 0);
+  for (std::size_t i = 0; i < boxes_.size(); ++i) {
+    const Box & box = boxes_[i];
+    const std::size_t first_x = toCell(box.min_x, min_x_, num_cells_x_);
+    const std::size_t last_x = toCell(box.max_x, min_x_, num_cells_x_);
+    const std::size_t first_y = toCell(box.min_y, min_y_, num_cells_y_);
+    const std::size_t last_y = toCell(box.max_y, min_y_, num_cells_y_);
+    const std::size_t word = i / 64;
+    const std::uint64_t bit = std::uint64_t{1} << (i % 64);
+    for (std::size_t y = first_y; y <= last_y; ++y) {
+      for (std::size_t x = first_x; x <= last_x; ++x) {
+        bits_[(y * num_cells_x_ + x) * num_words_ + word] |= bit;
+      }
+    }
+  }
+}
+
+}  // namespace autoware::image_projection_based_fusion
@@ -0,0 +1,252 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/image_projection_based_fusion/roi_pointcloud_fusion/node.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Measure the end-to-end latency of roi_pointcloud_fusion, from the arrival of the last input of a
+// frame to the publication of its output, with 6 and 8 cameras. Each frame has a pointcloud of
+// 100k points and 30 unknown ROIs for each camera, and the callbacks are called directly in the
+// arrival order. When the pointcloud arrives last, all the ROIs are fused after the last arrival,
+// which is what the previous pipeline did for every arrival order. When the ROIs arrive last, the
+// collector has fused the other ROIs on their arrival and only the last ROIs and the export are
+// left.
+
+namespace
+{
+using autoware::image_projection_based_fusion::CameraProjection;
+using autoware::image_projection_based_fusion::ClusterMsgType;
+using autoware::image_projection_based_fusion::PointCloudMsgType;
+using autoware::image_projection_based_fusion::RoiMsgType;
+using autoware::image_projection_based_fusion::RoiPointCloudFusionNode;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t num_points = 100000;
+constexpr std::size_t num_rois = 30;
+constexpr int num_frames = 20;
+
+class BenchmarkNode : public RoiPointCloudFusionNode
+{
+public:
+  explicit BenchmarkNode(const rclcpp::NodeOptions & options) : RoiPointCloudFusionNode(options)
+  {
+    // all the cameras look forward from the same optical frame
+    geometry_msgs::msg::TransformStamped transform;
+    transform.header.frame_id = "camera";
+    transform.child_frame_id = "base_link";
+    transform.transform.rotation.x = 0.5;
+    transform.transform.rotation.y = -0.5;
+    transform.transform.rotation.z = 0.5;
+    transform.transform.rotation.w = 0.5;
+    tf_buffer_.setTransform(transform, "benchmark", true);
+  }
+
+  // must be called before the first message, the collectors copy the camera projections
+  void set_camera_info(const sensor_msgs::msg::CameraInfo & camera_info)
+  {
+    for (auto & det2d_status : det2d_status_list_) {
+      det2d_status.camera_projector_ptr =
+        std::make_shared<CameraProjection>(camera_info, 1.0, 1.0, false, false);
+      det2d_status.camera_projector_ptr->initialize();
+    }
+  }
+
+  void receive_pointcloud(const PointCloudMsgType::ConstSharedPtr & msg) { sub_callback(msg); }
+  void receive_rois(const RoiMsgType::ConstSharedPtr & msg, const std::size_t rois_id)
+  {
+    rois_callback(msg, rois_id);
+  }
+
+  Clock::time_point publish_time;
+  int num_published{0};
+
+private:
+  void publish([[maybe_unused]] const ClusterMsgType & output_msg) override
+  {
+    publish_time = Clock::now();
+    ++num_published;
+  }
+};
+
+rclcpp::NodeOptions createNodeOptions(const std::size_t num_cameras)
+{
+  rclcpp::NodeOptions options;
+  options.parameter_overrides({
+    {"rois_number", static_cast<int>(num_cameras)},
+    {"rois_timestamp_offsets", std::vector<double>(num_cameras, 0.0)},
+    {"rois_timeout_sec", 0.5},
+    {"msg3d_timeout_sec", 0.05},
+    {"point_project_to_unrectified_image", std::vector<bool>(num_cameras, false)},
+    {"approximate_camera_projection", std::vector<bool>(num_cameras, false)},
+    {"approximation_grid_cell_width", 1.0},
+    {"approximation_grid_cell_height", 1.0},
+    {"filter_scope_min_x", -100.0},
+    {"filter_scope_min_y", -100.0},
+    {"filter_scope_min_z", -100.0},
+    {"filter_scope_max_x", 100.0},
+    {"filter_scope_max_y", 100.0},
+    {"filter_scope_max_z", 100.0},
+    {"debug_mode", false},
+    {"collector_debug_mode", false},
+    {"publish_processing_time_detail", false},
+    {"publish_previous_but_late_output_msg", false},
+    {"rosbag_length", 10.0},
+    {"matching_strategy.type", "naive"},
+    {"matching_strategy.threshold", 0.05},
+    {"fuse_unknown_only", true},
+    {"min_cluster_size", 2},
+    {"max_cluster_size", 20},
+    {"cluster_2d_tolerance", 0.5},
+    {"roi_scale_factor", 1.0},
+    {"max_object_size", 2.0},
+    {"override_class_with_unknown", false},
+  });
+  return options;
+}
+
+sensor_msgs::msg::CameraInfo createCameraInfo()
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.header.frame_id = "camera";
+  camera_info.width = 1440;
+  camera_info.height = 1080;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = {0.0, 0.0, 0.0, 0.0, 0.0};
+  camera_info.k = {1000.0, 0.0, 720.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 1.0};
+  camera_info.r = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  camera_info.p = {1000.0, 0.0, 720.0, 0.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+  return camera_info;
+}
+
+PointCloudMsgType createPointcloud()
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> x_distribution(1.0f, 80.0f);
+  std::uniform_real_distribution<float> y_distribution(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> z_distribution(-2.0f, 3.0f);
+
+  PointCloudMsgType msg;
+  msg.header.frame_id = "base_link";
+  msg.height = 1;
+  sensor_msgs::PointCloud2Modifier modifier(msg);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(num_points);
+  sensor_msgs::PointCloud2Iterator<float> iter_x(msg, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(msg, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(msg, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    *iter_x = x_distribution(engine);
+    *iter_y = y_distribution(engine);
+    *iter_z = z_distribution(engine);
+  }
+  return msg;
+}
+
+RoiMsgType createRois(const std::size_t rois_id)
+{
+  std::mt19937 engine(rois_id + 1);
+  std::uniform_int_distribution<uint32_t> x_distribution(0, 1300);
+  std::uniform_int_distribution<uint32_t> y_distribution(300, 700);
+  std::uniform_int_distribution<uint32_t> size_distribution(20, 200);
+
+  RoiMsgType msg;
+  msg.header.frame_id = "camera";
+  for (std::size_t i = 0; i < num_rois; ++i) {
+    autoware::image_projection_based_fusion::DetectedObjectWithFeature feature_object;
+    autoware_perception_msgs::msg::ObjectClassification classification;
+    classification.label = autoware_perception_msgs::msg::ObjectClassification::UNKNOWN;
+    classification.probability = 1.0;
+    feature_object.object.classification.push_back(classification);
+    feature_object.feature.roi.x_offset = x_distribution(engine);
+    feature_object.feature.roi.y_offset = y_distribution(engine);
+    feature_object.feature.roi.width = size_distribution(engine);
+    feature_object.feature.roi.height = size_distribution(engine);
+    msg.feature_objects.push_back(feature_object);
+  }
+  return msg;
+}
+
+// the mean latency in ms from the last arrival of a frame to its publication
+double measure(const std::size_t num_cameras, const bool pointcloud_arrives_last)
+{
+  auto node = std::make_shared<BenchmarkNode>(createNodeOptions(num_cameras));
+  node->set_camera_info(createCameraInfo());
+
+  const auto pointcloud = createPointcloud();
+  std::vector<RoiMsgType> rois(num_cameras);
+  for (std::size_t rois_id = 0; rois_id < num_cameras; ++rois_id) {
+    rois[rois_id] = createRois(rois_id);
+  }
+
+  double total_ms = 0.0;
+  for (int frame = 0; frame < num_frames; ++frame) {
+    const rclcpp::Time stamp(1, frame * 100000000, RCL_ROS_TIME);
+    auto pointcloud_msg = std::make_shared<PointCloudMsgType>(pointcloud);
+    pointcloud_msg->header.stamp = stamp;
+    std::vector<RoiMsgType::ConstSharedPtr> rois_msgs;
+    for (const auto & rois_msg : rois) {
+      auto msg = std::make_shared<RoiMsgType>(rois_msg);
+      msg->header.stamp = stamp;
+      rois_msgs.push_back(msg);
+    }
+
+    Clock::time_point last_arrival;
+    if (pointcloud_arrives_last) {
+      for (std::size_t rois_id = 0; rois_id < num_cameras; ++rois_id) {
+        node->receive_rois(rois_msgs[rois_id], rois_id);
+      }
+      last_arrival = Clock::now();
+      node->receive_pointcloud(pointcloud_msg);
+    } else {
+      node->receive_pointcloud(pointcloud_msg);
+      for (std::size_t rois_id = 0; rois_id + 1 < num_cameras; ++rois_id) {
+        node->receive_rois(rois_msgs[rois_id], rois_id);
+      }
+      last_arrival = Clock::now();
+      node->receive_rois(rois_msgs.back(), num_cameras - 1);
+    }
+    total_ms +=
+      std::chrono::duration<double, std::milli>(node->publish_time - last_arrival).count();
+  }
+  if (node->num_published != num_frames) {
+    std::cerr << "published " << node->num_published << " / " << num_frames << " frames"
+              << std::endl;
+  }
+  return total_ms / num_frames;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  for (const std::size_t num_cameras : {6, 8}) {
+    const double all_after_last_ms = measure(num_cameras, true);
+    const double incremental_ms = measure(num_cameras, false);
+    std::cout << "cameras: " << num_cameras << ", points: " << num_points
+              << ", ROIs per camera: " << num_rois
+              << ", last arrival to publish: pointcloud last (all the ROIs fused) "
+              << all_after_last_ms << " ms, ROIs last (fused on arrival) " << incremental_ms
+              << " ms" << std::endl;
+  }
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,185 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/image_projection_based_fusion/camera_projection.hpp"
+#include "autoware/image_projection_based_fusion/utils/geometry.hpp"
+#include "autoware/image_projection_based_fusion/utils/roi_raster.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measure the assignment of the points of one camera to the ROIs in roi_pointcloud_fusion, with
+// 150k points in front of a 1440 x 1080 camera and 20 to 400 ROIs. The previous implementation is
+// reproduced as the baseline: each point is projected through the std::function of
+// CameraProjection, then checked against every ROI. The new path projects the points in one batch
+// and looks the ROIs up in the raster of the ROIs. Each projection mode of the camera is measured.
+
+using autoware::image_projection_based_fusion::CameraProjection;
+using autoware::image_projection_based_fusion::isPointInsideRoi;
+using autoware::image_projection_based_fusion::RoiRaster;
+using sensor_msgs::msg::RegionOfInterest;
+
+namespace
+{
+constexpr std::size_t num_points = 150000;
+constexpr double roi_scale_factor = 1.1;
+
+struct Points
+{
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> zs;
+};
+
+sensor_msgs::msg::CameraInfo createCameraInfo()
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.width = 1440;
+  camera_info.height = 1080;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = {-0.1, 0.01, 0.001, -0.001, 0.0};
+  camera_info.k = {1000.0, 0.0, 720.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 1.0};
+  camera_info.r = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  camera_info.p = {1000.0, 0.0, 720.0, 0.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+  return camera_info;
+}
+
+Points createPoints()
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> x_distribution(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> y_distribution(-3.0f, 3.0f);
+  std::uniform_real_distribution<float> z_distribution(1.0f, 80.0f);
+  Points points;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    points.xs.push_back(x_distribution(engine));
+    points.ys.push_back(y_distribution(engine));
+    points.zs.push_back(z_distribution(engine));
+  }
+  return points;
+}
+
+std::vector<RegionOfInterest> createRois(const std::size_t num_rois)
+{
+  std::mt19937 engine(1);
+  std::uniform_int_distribution<uint32_t> x_distribution(0, 1300);
+  std::uniform_int_distribution<uint32_t> y_distribution(300, 700);
+  std::uniform_int_distribution<uint32_t> size_distribution(20, 250);
+  std::vector<RegionOfInterest> rois(num_rois);
+  for (auto & roi : rois) {
+    roi.x_offset = x_distribution(engine);
+    roi.y_offset = y_distribution(engine);
+    roi.width = size_distribution(engine);
+    roi.height = size_distribution(engine);
+  }
+  return rois;
+}
+
+// the number of points of each ROI
+std::vector<std::size_t> assignWithLoop(
+  CameraProjection & projection, const Points & points, const std::vector<RegionOfInterest> & rois)
+{
+  std::vector<std::size_t> counts(rois.size(), 0);
+  for (std::size_t j = 0; j < points.xs.size(); ++j) {
+    if (projection.isOutsideHorizontalView(points.xs[j], points.zs[j])) {
+      continue;
+    }
+    Eigen::Vector2d projected_point;
+    if (projection.calcImageProjectedPoint(
+          cv::Point3d(points.xs[j], points.ys[j], points.zs[j]), projected_point)) {
+      for (std::size_t i = 0; i < rois.size(); ++i) {
+        if (isPointInsideRoi(rois[i], projected_point.x(), projected_point.y(), roi_scale_factor)) {
+          ++counts[i];
+        }
+      }
+    }
+  }
+  return counts;
+}
+
+std::vector<std::size_t> assignWithRaster(
+  CameraProjection & projection, const Points & points, const std::vector<RegionOfInterest> & rois,
+  RoiRaster & raster)
+{
+  Points visible_points;
+  for (std::size_t j = 0; j < points.xs.size(); ++j) {
+    if (projection.isOutsideHorizontalView(points.xs[j], points.zs[j])) {
+      continue;
+    }
+    visible_points.xs.push_back(points.xs[j]);
+    visible_points.ys.push_back(points.ys[j]);
+    visible_points.zs.push_back(points.zs[j]);
+  }
+  std::vector<Eigen::Vector2d> projected_points;
+  std::vector<std::uint8_t> is_projected;
+  projection.calcImageProjectedPoints(
+    visible_points.xs, visible_points.ys, visible_points.zs, projected_points, is_projected);
+
+  raster.build(rois, roi_scale_factor);
+  std::vector<std::size_t> counts(rois.size(), 0);
+  for (std::size_t j = 0; j < projected_points.size(); ++j) {
+    if (is_projected[j]) {
+      raster.forEachRoiContaining(
+        projected_points[j].x(), projected_points[j].y(),
+        [&](const std::size_t i) { ++counts[i]; });
+    }
+  }
+  return counts;
+}
+
+template <class F>
+double measure(const F & function)
+{
+  constexpr int iterations = 10;
+  function();  // warm up
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    function();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+           .count() /
+         iterations;
+}
+}  // namespace
+
+int main()
+{
+  const auto points = createPoints();
+  RoiRaster raster;
+
+  for (const auto & [unrectify, use_approximation] :
+       {std::make_pair(false, false), std::make_pair(true, false), std::make_pair(true, true)}) {
+    CameraProjection projection(createCameraInfo(), 2.0, 2.0, unrectify, use_approximation);
+    projection.initialize();
+    std::cout << "unrectify: " << unrectify << ", use_approximation: " << use_approximation
+              << std::endl;
+
+    for (const std::size_t num_rois : {20, 50, 100, 200, 400}) {
+      const auto rois = createRois(num_rois);
+      std::vector<std::size_t> loop_counts;
+      std::vector<std::size_t> raster_counts;
+      const double loop_ms =
+        measure([&]() { loop_counts = assignWithLoop(projection, points, rois); });
+      const double raster_ms =
+        measure([&]() { raster_counts = assignWithRaster(projection, points, rois, raster); });
+      std::cout << "  rois: " << num_rois << ", points: " << num_points << ", per point loop "
+                << loop_ms << " ms, batch and raster " << raster_ms << " ms, same result "
+                << (loop_counts == raster_counts ? "yes" : "no") << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,514 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/image_projection_based_fusion/fusion_collector.hpp"
+#include "autoware/image_projection_based_fusion/roi_detected_object_fusion/node.hpp"
+#include "autoware/image_projection_based_fusion/roi_pointcloud_fusion/node.hpp"
+#include "autoware/image_projection_based_fusion/segmentation_pointcloud_fusion/node.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The partial result of a collector against a collector which receives the msg3d then only the
+// last ROIs of each camera. The ROIs are fused on their arrival, so a duplicated ROI message, a
+// replaced msg3d or a reset must drop what was fused before, including the state that each node
+// keeps for the msg3d between preprocess and postprocess.
+
+namespace
+{
+using autoware::image_projection_based_fusion::CameraProjection;
+using autoware::image_projection_based_fusion::ClusterMsgType;
+using autoware::image_projection_based_fusion::Det2dStatus;
+using autoware::image_projection_based_fusion::DetectedObjects;
+using autoware::image_projection_based_fusion::DetectedObjectWithFeature;
+using autoware::image_projection_based_fusion::FusionCollector;
+using autoware::image_projection_based_fusion::FusionNode;
+using autoware::image_projection_based_fusion::Image;
+using autoware::image_projection_based_fusion::NaiveCollectorInfo;
+using autoware::image_projection_based_fusion::PointCloudMsgType;
+using autoware::image_projection_based_fusion::RoiDetectedObjectFusionNode;
+using autoware::image_projection_based_fusion::RoiMsgType;
+using autoware::image_projection_based_fusion::RoiPointCloudFusionNode;
+using autoware::image_projection_based_fusion::SegmentPointCloudFusionNode;
+using autoware_perception_msgs::msg::DetectedObject;
+using autoware_perception_msgs::msg::ObjectClassification;
+using autoware_perception_msgs::msg::Shape;
+
+constexpr std::size_t num_cameras = 2;
+constexpr double fx = 1000.0;
+constexpr double cx = 720.0;
+constexpr double cy = 540.0;
+const rclcpp::Time stamp(1, 100000000, RCL_ROS_TIME);
+
+// an object in front of the cameras for each camera, whose ROI covers only this object
+constexpr double object_x = 10.0;
+constexpr double object_y[num_cameras] = {3.0, -3.0};
+constexpr double object_size = 2.0;
+
+std::vector<rclcpp::Parameter> createCommonParameters()
+{
+  return {
+    {"rois_number", static_cast<int>(num_cameras)},
+    {"rois_timestamp_offsets", std::vector<double>(num_cameras, 0.0)},
+    {"rois_timeout_sec", 0.5},
+    {"msg3d_timeout_sec", 0.05},
+    {"point_project_to_unrectified_image", std::vector<bool>(num_cameras, false)},
+    {"approximate_camera_projection", std::vector<bool>(num_cameras, false)},
+    {"approximation_grid_cell_width", 1.0},
+    {"approximation_grid_cell_height", 1.0},
+    {"filter_scope_min_x", -100.0},
+    {"filter_scope_min_y", -100.0},
+    {"filter_scope_min_z", -100.0},
+    {"filter_scope_max_x", 100.0},
+    {"filter_scope_max_y", 100.0},
+    {"filter_scope_max_z", 100.0},
+    {"debug_mode", false},
+    {"collector_debug_mode", false},
+    {"publish_processing_time_detail", false},
+    {"publish_previous_but_late_output_msg", false},
+    {"rosbag_length", 10.0},
+    {"matching_strategy.type", "naive"},
+    {"matching_strategy.threshold", 0.05},
+  };
+}
+
+sensor_msgs::msg::CameraInfo createCameraInfo()
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.header.frame_id = "camera";
+  camera_info.width = 1440;
+  camera_info.height = 1080;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = {0.0, 0.0, 0.0, 0.0, 0.0};
+  camera_info.k = {fx, 0.0, cx, 0.0, fx, cy, 0.0, 0.0, 1.0};
+  camera_info.r = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  camera_info.p = {fx, 0.0, cx, 0.0, 0.0, fx, cy, 0.0, 0.0, 0.0, 1.0, 0.0};
+  return camera_info;
+}
+
+// a block of points at each object, behind the cameras for variant 1
+PointCloudMsgType createPointcloud(const int variant)
+{
+  PointCloudMsgType msg;
+  msg.header.frame_id = "base_link";
+  msg.header.stamp = stamp;
+  msg.height = 1;
+  sensor_msgs::PointCloud2Modifier modifier(msg);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(num_cameras * 27);
+  sensor_msgs::PointCloud2Iterator<float> iter_x(msg, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(msg, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(msg, "z");
+  for (const double y : object_y) {
+    for (int i = 0; i < 27; ++i, ++iter_x, ++iter_y, ++iter_z) {
+      const double x = object_x + 0.2 * (i % 3 - 1);
+      *iter_x = static_cast<float>(variant == 0 ? x : -x);
+      *iter_y = static_cast<float>(y + 0.2 * (i / 3 % 3 - 1));
+      *iter_z = static_cast<float>(0.2 * (i / 9 - 1));
+    }
+  }
+  return msg;
+}
+
+// the unknown ROI of the box around the object of the camera
+DetectedObjectWithFeature createObjectRoi(const std::size_t rois_id)
+{
+  // the camera looks along x of base_link, its x and y are -y and -z of base_link
+  double min_u = std::numeric_limits<double>::max();
+  double min_v = std::numeric_limits<double>::max();
+  double max_u = std::numeric_limits<double>::lowest();
+  double max_v = std::numeric_limits<double>::lowest();
+  for (const double dx : {-0.5, 0.5}) {
+    for (const double dy : {-0.5, 0.5}) {
+      for (const double dz : {-0.5, 0.5}) {
+        const double depth = object_x + dx * object_size;
+        const double u = cx - fx * (object_y[rois_id] + dy * object_size) / depth;
+        const double v = cy - fx * dz * object_size / depth;
+        min_u = std::min(min_u, u);
+        min_v = std::min(min_v, v);
+        max_u = std::max(max_u, u);
+        max_v = std::max(max_v, v);
+      }
+    }
+  }
+
+  DetectedObjectWithFeature feature_object;
+  ObjectClassification classification;
+  classification.label = ObjectClassification::UNKNOWN;
+  classification.probability = 1.0;
+  feature_object.object.classification.push_back(classification);
+  feature_object.object.existence_probability = 1.0;
+  feature_object.feature.roi.x_offset = static_cast<uint32_t>(std::floor(min_u));
+  feature_object.feature.roi.y_offset = static_cast<uint32_t>(std::floor(min_v));
+  feature_object.feature.roi.width = static_cast<uint32_t>(std::ceil(max_u - std::floor(min_u)));
+  feature_object.feature.roi.height = static_cast<uint32_t>(std::ceil(max_v - std::floor(min_v)));
+  return feature_object;
+}
+
+// the ROI of the object of the camera for variant 0, no ROI for variant 1
+RoiMsgType createRois(const std::size_t rois_id, const int variant)
+{
+  RoiMsgType msg;
+  msg.header.frame_id = "camera";
+  msg.header.stamp = stamp;
+  if (variant == 0) {
+    msg.feature_objects.push_back(createObjectRoi(rois_id));
+  }
+  return msg;
+}
+
+// Each type gives the parameters of its node and two variants of its messages. The ROIs of
+// variant 0 fuse into the output, those of variant 1 fuse nothing, and the msg3d of variant 1 is
+// behind the cameras.
+struct RoiDetectedObjectFusion
+{
+  using Node = RoiDetectedObjectFusionNode;
+  using Msg3D = DetectedObjects;
+  using Msg2D = RoiMsgType;
+  using ExportObj = DetectedObjects;
+
+  static std::vector<rclcpp::Parameter> createParameters()
+  {
+    auto parameters = createCommonParameters();
+    parameters.emplace_back(
+      "passthrough_lower_bound_probability_thresholds", std::vector<double>(8, 0.35));
+    parameters.emplace_back("trust_distances", std::vector<double>(8, 50.0));
+    parameters.emplace_back("min_iou_threshold", 0.5);
+    parameters.emplace_back("use_roi_probability", false);
+    parameters.emplace_back("roi_probability_threshold", 0.5);
+    std::vector<int64_t> can_assign_matrix(64, 0);
+    for (std::size_t i = 0; i < 8; ++i) {
+      can_assign_matrix[i * 8 + i] = 1;
+    }
+    parameters.emplace_back("can_assign_matrix", can_assign_matrix);
+    return parameters;
+  }
+
+  // the objects of low existence probability are kept only if they are fused
+  static Msg3D createMsg3d(const int variant)
+  {
+    Msg3D msg;
+    msg.header.frame_id = "base_link";
+    msg.header.stamp = stamp;
+    for (const double y : object_y) {
+      DetectedObject object;
+      ObjectClassification classification;
+      classification.label = ObjectClassification::UNKNOWN;
+      classification.probability = 1.0;
+      object.classification.push_back(classification);
+      object.existence_probability = 0.1;
+      object.kinematics.pose_with_covariance.pose.position.x = variant == 0 ? object_x : -object_x;
+      object.kinematics.pose_with_covariance.pose.position.y = y;
+      object.kinematics.pose_with_covariance.pose.orientation.w = 1.0;
+      object.shape.type = Shape::BOUNDING_BOX;
+      object.shape.dimensions.x = object_size;
+      object.shape.dimensions.y = object_size;
+      object.shape.dimensions.z = object_size;
+      msg.objects.push_back(object);
+    }
+    return msg;
+  }
+
+  static Msg2D createMsg2d(const std::size_t rois_id, const int variant)
+  {
+    return createRois(rois_id, variant);
+  }
+};
+
+struct RoiPointCloudFusion
+{
+  using Node = RoiPointCloudFusionNode;
+  using Msg3D = PointCloudMsgType;
+  using Msg2D = RoiMsgType;
+  using ExportObj = ClusterMsgType;
+
+  static std::vector<rclcpp::Parameter> createParameters()
+  {
+    auto parameters = createCommonParameters();
+    parameters.emplace_back("fuse_unknown_only", true);
+    parameters.emplace_back("min_cluster_size", 2);
+    parameters.emplace_back("max_cluster_size", 100);
+    parameters.emplace_back("cluster_2d_tolerance", 0.5);
+    parameters.emplace_back("roi_scale_factor", 1.0);
+    parameters.emplace_back("max_object_size", 2.0);
+    parameters.emplace_back("override_class_with_unknown", false);
+    return parameters;
+  }
+
+  static Msg3D createMsg3d(const int variant) { return createPointcloud(variant); }
+
+  static Msg2D createMsg2d(const std::size_t rois_id, const int variant)
+  {
+    return createRois(rois_id, variant);
+  }
+};
+
+struct SegmentPointCloudFusion
+{
+  using Node = SegmentPointCloudFusionNode;
+  using Msg3D = PointCloudMsgType;
+  using Msg2D = Image;
+  using ExportObj = PointCloudMsgType;
+
+  static constexpr uint8_t unknown = 0;
+  static constexpr uint8_t building = 1;
+
+  static std::vector<rclcpp::Parameter> createParameters()
+  {
+    auto parameters = createCommonParameters();
+    parameters.emplace_back("filter_distance_threshold", 60.0);
+    for (const auto * label :
+         {"UNKNOWN", "BUILDING", "WALL", "OBSTACLE", "TRAFFIC_LIGHT", "TRAFFIC_SIGN", "PERSON",
+          "VEHICLE", "BIKE", "ROAD", "SIDEWALK", "ROAD_PAINT", "CURBSTONE", "CROSSWALK",
+          "VEGETATION", "SKY"}) {
+      parameters.emplace_back(
+        std::string("filter_semantic_label_target.") + label, std::string(label) == "BUILDING");
+    }
+    parameters.emplace_back("is_publish_debug_mask", false);
+    return parameters;
+  }
+
+  static Msg3D createMsg3d(const int variant) { return createPointcloud(variant); }
+
+  // a run length encoded mask of buildings on the top half for camera 0 and on the bottom half
+  // for camera 1, which cover the upper and the lower points of both objects
+  static Msg2D createMsg2d(const std::size_t rois_id, const int variant)
+  {
+    Msg2D msg;
+    msg.header.frame_id = "camera";
+    msg.header.stamp = stamp;
+    msg.height = 4;
+    msg.width = 4;
+    const auto append_run = [&msg](const uint8_t label, const int length) {
+      const std::size_t offset = msg.data.size();
+      msg.data.resize(offset + sizeof(uint8_t) + sizeof(int));
+      msg.data[offset] = label;
+      std::memcpy(&msg.data[offset + 1], &length, sizeof(int));
+    };
+    const bool building_on_top = variant == 0 && rois_id == 0;
+    const bool building_on_bottom = variant == 0 && rois_id == 1;
+    append_run(building_on_top ? building : unknown, 8);
+    append_run(building_on_bottom ? building : unknown, 8);
+    return msg;
+  }
+};
+
+template <class Fusion>
+class TestNode : public Fusion::Node
+{
+public:
+  explicit TestNode(const rclcpp::NodeOptions & options) : Fusion::Node(options)
+  {
+    // all the cameras look forward from the same optical frame
+    geometry_msgs::msg::TransformStamped transform;
+    transform.header.frame_id = "camera";
+    transform.child_frame_id = "base_link";
+    transform.transform.rotation.x = 0.5;
+    transform.transform.rotation.y = -0.5;
+    transform.transform.rotation.z = 0.5;
+    transform.transform.rotation.w = 0.5;
+    this->tf_buffer_.setTransform(transform, "test", true);
+  }
+
+  std::vector<Det2dStatus<typename Fusion::Msg2D>> createDet2dStatusList(
+    const std::vector<bool> & with_camera_info) const
+  {
+    auto det2d_status_list = this->det2d_status_list_;
+    for (std::size_t rois_id = 0; rois_id < det2d_status_list.size(); ++rois_id) {
+      if (with_camera_info.at(rois_id)) {
+        det2d_status_list[rois_id].camera_projector_ptr = createCameraProjection();
+      }
+    }
+    return det2d_status_list;
+  }
+
+  static std::shared_ptr<CameraProjection> createCameraProjection()
+  {
+    auto camera_projector =
+      std::make_shared<CameraProjection>(createCameraInfo(), 1.0, 1.0, false, false);
+    camera_projector->initialize();
+    return camera_projector;
+  }
+
+  std::vector<typename Fusion::ExportObj> outputs;
+
+private:
+  void publish(const typename Fusion::ExportObj & output_msg) override
+  {
+    outputs.push_back(output_msg);
+  }
+};
+
+template <class Fusion>
+class FusionCollectorTest : public ::testing::Test
+{
+protected:
+  using Msg3D = typename Fusion::Msg3D;
+  using Msg2D = typename Fusion::Msg2D;
+  using ExportObj = typename Fusion::ExportObj;
+  using Collector = FusionCollector<Msg3D, Msg2D, ExportObj>;
+  using Rois = std::vector<std::pair<std::size_t, int>>;
+
+  void SetUp() override { rclcpp::init(0, nullptr); }
+  void TearDown() override { (void)rclcpp::shutdown(); }
+
+  static std::shared_ptr<TestNode<Fusion>> createNode()
+  {
+    rclcpp::NodeOptions options;
+    options.parameter_overrides(Fusion::createParameters());
+    return std::make_shared<TestNode<Fusion>>(options);
+  }
+
+  static std::shared_ptr<Collector> createCollector(
+    const std::shared_ptr<TestNode<Fusion>> & node,
+    const std::vector<bool> & with_camera_info = std::vector<bool>(num_cameras, true))
+  {
+    auto collector = std::make_shared<Collector>(
+      std::shared_ptr<FusionNode<Msg3D, Msg2D, ExportObj>>(node), num_cameras,
+      node->createDet2dStatusList(with_camera_info), false);
+    collector->set_info(std::make_shared<NaiveCollectorInfo>(stamp.seconds(), 0.05));
+    return collector;
+  }
+
+  static void receiveMsg3d(Collector & collector, const int variant)
+  {
+    collector.process_msg3d(std::make_shared<Msg3D>(Fusion::createMsg3d(variant)), 0.05);
+  }
+
+  static void receiveRois(Collector & collector, const std::size_t rois_id, const int variant)
+  {
+    collector.process_rois(
+      rois_id, std::make_shared<Msg2D>(Fusion::createMsg2d(rois_id, variant)), 0.5);
+  }
+
+  // the output of a new collector which receives the msg3d, then the ROIs in the given order
+  static ExportObj fuse(const int msg3d_variant, const Rois & rois)
+  {
+    auto node = createNode();
+    auto collector = createCollector(node);
+    receiveMsg3d(*collector, msg3d_variant);
+    for (const auto & [rois_id, variant] : rois) {
+      receiveRois(*collector, rois_id, variant);
+    }
+    EXPECT_EQ(node->outputs.size(), 1U);
+    return node->outputs.empty() ? ExportObj{} : node->outputs.back();
+  }
+
+  static ExportObj lastOutput(const TestNode<Fusion> & node)
+  {
+    EXPECT_FALSE(node.outputs.empty());
+    return node.outputs.empty() ? ExportObj{} : node.outputs.back();
+  }
+};
+
+using FusionTypes =
+  ::testing::Types<RoiDetectedObjectFusion, RoiPointCloudFusion, SegmentPointCloudFusion>;
+TYPED_TEST_SUITE(FusionCollectorTest, FusionTypes);
+}  // namespace
+
+TYPED_TEST(FusionCollectorTest, FuseRoisInArrivalOrder)
+{
+  auto node = this->createNode();
+  auto collector = this->createCollector(node);
+  // the ROIs which arrived before the msg3d are fused when it arrives
+  this->receiveRois(*collector, 1, 0);
+  this->receiveRois(*collector, 0, 0);
+  EXPECT_TRUE(node->outputs.empty());
+  this->receiveMsg3d(*collector, 0);
+  ASSERT_EQ(node->outputs.size(), 1U);
+  EXPECT_EQ(node->outputs.back(), this->fuse(0, {{1, 0}, {0, 0}}));
+}
+
+TYPED_TEST(FusionCollectorTest, DuplicatedRoisRestartPartialResult)
+{
+  // the scenario is not trivial: the first ROIs of camera 0 change the output
+  ASSERT_NE(this->fuse(0, {{0, 0}, {1, 1}}), this->fuse(0, {{0, 1}, {1, 1}}));
+
+  auto node = this->createNode();
+  auto collector = this->createCollector(node);
+  this->receiveMsg3d(*collector, 0);
+  this->receiveRois(*collector, 0, 0);
+  this->receiveRois(*collector, 0, 1);
+  this->receiveRois(*collector, 1, 1);
+  EXPECT_EQ(this->lastOutput(*node), this->fuse(0, {{0, 1}, {1, 1}}));
+}
+
+TYPED_TEST(FusionCollectorTest, ReplacedMsg3dRestartsPartialResult)
+{
+  ASSERT_NE(this->fuse(0, {{0, 0}, {1, 0}}), this->fuse(1, {{0, 0}, {1, 0}}));
+
+  auto node = this->createNode();
+  auto collector = this->createCollector(node);
+  this->receiveMsg3d(*collector, 0);
+  this->receiveRois(*collector, 0, 0);
+  // the same timestamp, so that the state of the node for the first msg3d must be discarded
+  this->receiveMsg3d(*collector, 1);
+  this->receiveRois(*collector, 1, 0);
+  EXPECT_EQ(this->lastOutput(*node), this->fuse(1, {{0, 0}, {1, 0}}));
+}
+
+TYPED_TEST(FusionCollectorTest, ResetDiscardsPartialResult)
+{
+  ASSERT_NE(this->fuse(0, {{0, 0}, {1, 1}}), this->fuse(0, {{0, 1}, {1, 1}}));
+
+  auto node = this->createNode();
+  auto collector = this->createCollector(node);
+  this->receiveMsg3d(*collector, 0);
+  this->receiveRois(*collector, 0, 0);
+  collector->reset();
+  EXPECT_TRUE(node->outputs.empty());
+  collector->set_info(std::make_shared<NaiveCollectorInfo>(stamp.seconds(), 0.05));
+
+  // the collector is reused for the same timestamp, as when the messages are received again
+  this->receiveMsg3d(*collector, 0);
+  this->receiveRois(*collector, 0, 1);
+  this->receiveRois(*collector, 1, 1);
+  EXPECT_EQ(this->lastOutput(*node), this->fuse(0, {{0, 1}, {1, 1}}));
+}
+
+TYPED_TEST(FusionCollectorTest, CameraInfoArrivesBeforeFusion)
+{
+  auto node = this->createNode();
+  auto collector = this->createCollector(node, {true, false});
+  this->receiveMsg3d(*collector, 0);
+  // the ROIs of camera 1 are not fused on their arrival, but when all the ROIs are there
+  this->receiveRois(*collector, 1, 0);
+  collector->add_camera_projection(1, TestNode<TypeParam>::createCameraProjection());
+  this->receiveRois(*collector, 0, 0);
+  EXPECT_EQ(this->lastOutput(*node), this->fuse(0, {{1, 0}, {0, 0}}));
+}
+
+TYPED_TEST(FusionCollectorTest, MissingCameraInfo)
+{
+  ASSERT_NE(this->fuse(0, {{0, 0}, {1, 0}}), this->fuse(0, {{0, 0}, {1, 1}}));
+
+  auto node = this->createNode();
+  auto collector = this->createCollector(node, {true, false});
+  this->receiveMsg3d(*collector, 0);
+  this->receiveRois(*collector, 0, 0);
+  this->receiveRois(*collector, 1, 0);
+  // the ROIs of camera 1 are skipped
+  EXPECT_EQ(this->lastOutput(*node), this->fuse(0, {{0, 0}, {1, 1}}));
+}
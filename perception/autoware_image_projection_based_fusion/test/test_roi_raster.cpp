@@ -0,0 +1,153 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/image_projection_based_fusion/camera_projection.hpp"
+#include "autoware/image_projection_based_fusion/utils/geometry.hpp"
+#include "autoware/image_projection_based_fusion/utils/roi_raster.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using autoware::image_projection_based_fusion::CameraProjection;
+using autoware::image_projection_based_fusion::isPointInsideRoi;
+using autoware::image_projection_based_fusion::RoiRaster;
+using sensor_msgs::msg::RegionOfInterest;
+
+namespace
+{
+RegionOfInterest createRoi(
+  const uint32_t x_offset, const uint32_t y_offset, const uint32_t width, const uint32_t height)
+{
+  RegionOfInterest roi;
+  roi.x_offset = x_offset;
+  roi.y_offset = y_offset;
+  roi.width = width;
+  roi.height = height;
+  return roi;
+}
+
+std::vector<std::size_t> getContainingRois(const RoiRaster & raster, double px, double py)
+{
+  std::vector<std::size_t> indices;
+  raster.forEachRoiContaining(px, py, [&](const std::size_t i) { indices.push_back(i); });
+  return indices;
+}
+
+sensor_msgs::msg::CameraInfo createCameraInfo()
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.width = 1440;
+  camera_info.height = 1080;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = {-0.1, 0.01, 0.001, -0.001, 0.0};
+  camera_info.k = {1000.0, 0.0, 720.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 1.0};
+  camera_info.r = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  camera_info.p = {1000.0, 0.0, 720.0, 0.0, 0.0, 1000.0, 540.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+  return camera_info;
+}
+}  // namespace
+
+TEST(RoiRasterTest, EmptyRois)
+{
+  RoiRaster raster;
+  raster.build({}, 1.0);
+  EXPECT_TRUE(raster.empty());
+  EXPECT_TRUE(getContainingRois(raster, 10.0, 10.0).empty());
+}
+
+TEST(RoiRasterTest, InclusiveBoundsAndScale)
+{
+  RoiRaster raster;
+  raster.build({createRoi(100, 100, 50, 20), createRoi(120, 110, 10, 10)}, 1.2);
+  // the first ROI is scaled to [95, 155] x [98, 122]
+  EXPECT_EQ(getContainingRois(raster, 95.0, 98.0), (std::vector<std::size_t>{0}));
+  EXPECT_EQ(getContainingRois(raster, 155.0, 122.0), (std::vector<std::size_t>{0}));
+  EXPECT_EQ(getContainingRois(raster, 125.0, 115.0), (std::vector<std::size_t>{0, 1}));
+  EXPECT_TRUE(getContainingRois(raster, 94.9, 110.0).empty());
+  EXPECT_TRUE(getContainingRois(raster, NAN, 110.0).empty());
+}
+
+// the same ROIs as isPointInsideRoi, in the same order, with more than 64 ROIs
+TEST(RoiRasterTest, AgreeWithIsPointInsideRoi)
+{
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<uint32_t> offset_distribution(0, 1400);
+  std::uniform_int_distribution<uint32_t> size_distribution(0, 300);
+  std::uniform_real_distribution<double> point_distribution(-100.0, 1600.0);
+
+  std::vector<RegionOfInterest> rois;
+  for (int i = 0; i < 150; ++i) {
+    rois.push_back(createRoi(
+      offset_distribution(engine), offset_distribution(engine), size_distribution(engine),
+      size_distribution(engine)));
+  }
+  for (const double roi_scale_factor : {1.0, 1.1, 0.7}) {
+    RoiRaster raster;
+    raster.build(rois, roi_scale_factor);
+    for (int j = 0; j < 20000; ++j) {
+      // also the corners of the ROIs, which are on the cell borders
+      const auto & roi = rois[j % rois.size()];
+      const double px = j % 3 == 0 ? roi.x_offset : point_distribution(engine);
+      const double py = j % 3 == 0 ? roi.y_offset + roi.height : point_distribution(engine);
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < rois.size(); ++i) {
+        if (isPointInsideRoi(rois[i], px, py, roi_scale_factor)) {
+          expected.push_back(i);
+        }
+      }
+      ASSERT_EQ(getContainingRois(raster, px, py), expected);
+    }
+  }
+}
+
+// the batch gives the same projections as calcImageProjectedPoint in each mode
+TEST(CameraProjectionTest, BatchAgreeWithSinglePoint)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> xy_distribution(-30.0f, 30.0f);
+  std::uniform_real_distribution<float> z_distribution(-5.0f, 60.0f);
+  std::vector<float> xs, ys, zs;
+  for (int i = 0; i < 10000; ++i) {
+    xs.push_back(xy_distribution(engine));
+    ys.push_back(xy_distribution(engine));
+    zs.push_back(z_distribution(engine));
+  }
+
+  for (const auto & [unrectify, use_approximation] :
+       {std::make_pair(false, false), std::make_pair(true, false), std::make_pair(true, true)}) {
+    CameraProjection projection(createCameraInfo(), 2.0, 2.0, unrectify, use_approximation);
+    projection.initialize();
+    std::vector<Eigen::Vector2d> projected_points;
+    std::vector<std::uint8_t> is_projected;
+    projection.calcImageProjectedPoints(xs, ys, zs, projected_points, is_projected);
+    ASSERT_EQ(projected_points.size(), xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      if (zs[i] <= 0.0f) {
+        EXPECT_FALSE(is_projected[i]);
+        continue;
+      }
+      Eigen::Vector2d expected;
+      const bool expected_is_projected =
+        projection.calcImageProjectedPoint(cv::Point3d(xs[i], ys[i], zs[i]), expected);
+      ASSERT_EQ(static_cast<bool>(is_projected[i]), expected_is_projected);
+      if (expected_is_projected) {
+        EXPECT_EQ(projected_points[i], expected);
+      }
+    }
+  }
+}
@@ -25,6 +25,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <Eigen/SparseCore>
 
 #include "autoware_perception_msgs/msg/detected_objects.hpp"
 
@@ -36,6 +37,9 @@
 namespace autoware::object_merger
 {
 
+// score of each pair of objects, only the pairs which passed all the gates are stored
+using ScoreMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
 class DataAssociation
 {
 private:
@@ -43,6 +47,8 @@ private:
   Eigen::MatrixXd max_dist_matrix_;
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
+  // for each label of objects1, the max distance to an object0 it can be assigned to
+  std::vector<double> max_dist_per_label_;
   const double score_threshold_;
   std::unique_ptr<autoware::object_merger::gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
 
@@ -51,12 +57,28 @@ public:
   DataAssociation(
     std::vector<int> can_assign_vector, std::vector<double> max_dist_vector,
     std::vector<double> max_rad_vector, std::vector<double> min_iou_vector);
+  /**
+   * @brief solve the assignment of the score matrix
+   *
+   * @note the pairs are split into the connected components of the graph of the stored scores,
+   *       each component being solved separately, so that the solver only sees small dense
+   *       matrices
+   */
   void assign(
-    const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
+    const ScoreMatrix & src, std::unordered_map<int, int> & direct_assignment,
     std::unordered_map<int, int> & reverse_assignment);
-  Eigen::MatrixXd calcScoreMatrix(
+  /**
+   * @brief calc score matrix between objects1 (rows) and objects0 (columns)
+   *
+   * @note objects0 are indexed in an R-tree, and each object1 is only scored against the objects0
+   *       within the max distance of its label. The rows are scored in parallel.
+   */
+  ScoreMatrix calcScoreMatrix(
     const autoware_perception_msgs::msg::DetectedObjects & objects0,
     const autoware_perception_msgs::msg::DetectedObjects & objects1);
+  double calcScoreBetweenObjects(
+    const autoware_perception_msgs::msg::DetectedObject & object0,
+    const autoware_perception_msgs::msg::DetectedObject & object1) const;
   virtual ~DataAssociation() {}
 };
 
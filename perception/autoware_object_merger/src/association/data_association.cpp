@@ -18,14 +18,39 @@
 #include "autoware/object_recognition_utils/object_recognition_utils.hpp"
 #include "autoware_utils/geometry/geometry.hpp"
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include <algorithm>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace
 {
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+// Define point and box types for R-tree
+typedef bg::model::point<double, 2, bg::cs::cartesian> Point;
+typedef bg::model::box<Point> Box;
+typedef std::pair<Point, size_t> ValueType;  // Point and object index
+
+int findRoot(std::vector<int> & parents, int node)
+{
+  while (parents[node] != node) {
+    parents[node] = parents[parents[node]];
+    node = parents[node];
+  }
+  return node;
+}
+
 double getFormedYawAngle(
   const geometry_msgs::msg::Quaternion & quat0, const geometry_msgs::msg::Quaternion & quat1,
   const bool distinguish_front_or_back = true)
@@ -78,101 +103,178 @@ DataAssociation::DataAssociation(
       min_iou_vector.data(), min_iou_label_num, min_iou_label_num);
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
+  // the search radius of the R-tree query for each label of objects1
+  max_dist_per_label_.assign(max_dist_matrix_.rows(), 0.0);
+  for (int object1_label = 0; object1_label < max_dist_matrix_.rows(); ++object1_label) {
+    for (int object0_label = 0; object0_label < max_dist_matrix_.cols(); ++object0_label) {
+      if (can_assign_matrix_(object1_label, object0_label)) {
+        max_dist_per_label_.at(object1_label) = std::max(
+          max_dist_per_label_.at(object1_label), max_dist_matrix_(object1_label, object0_label));
+      }
+    }
+  }
 
   gnn_solver_ptr_ = std::make_unique<autoware::object_merger::gnn_solver::MuSSP>();
 }
 
 void DataAssociation::assign(
-  const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
+  const ScoreMatrix & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(src.rows());
-  for (int row = 0; row < src.rows(); ++row) {
-    score.at(row).resize(src.cols());
-    for (int col = 0; col < src.cols(); ++col) {
-      score.at(row).at(col) = src(row, col);
+  // Split the pairs into connected components, the rows being the nodes [0, rows) and the columns
+  // the nodes [rows, rows + cols)
+  const int num_rows = static_cast<int>(src.rows());
+  const int num_cols = static_cast<int>(src.cols());
+  std::vector<int> parents(num_rows + num_cols);
+  std::iota(parents.begin(), parents.end(), 0);
+  std::vector<bool> has_pair(num_rows + num_cols, false);
+  for (int row = 0; row < num_rows; ++row) {
+    for (ScoreMatrix::InnerIterator itr(src, row); itr; ++itr) {
+      if (itr.value() < score_threshold_) continue;
+      const int col_node = num_rows + static_cast<int>(itr.col());
+      parents[findRoot(parents, col_node)] = findRoot(parents, row);
+      has_pair[row] = true;
+      has_pair[col_node] = true;
     }
   }
-  // Solve
-  gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
-
-  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
-    if (src(itr->first, itr->second) < score_threshold_) {
-      itr = direct_assignment.erase(itr);
-      continue;
+  // rows and columns of each component, in the index order
+  std::vector<std::pair<std::vector<int>, std::vector<int>>> components;
+  std::unordered_map<int, size_t> component_indices;
+  for (int node = 0; node < num_rows + num_cols; ++node) {
+    if (!has_pair[node]) continue;
+    const auto [itr, inserted] =
+      component_indices.try_emplace(findRoot(parents, node), components.size());
+    if (inserted) components.emplace_back();
+    if (node < num_rows) {
+      components.at(itr->second).first.push_back(node);
     } else {
-      ++itr;
+      components.at(itr->second).second.push_back(node - num_rows);
     }
   }
-  for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
-    if (src(itr->second, itr->first) < score_threshold_) {
-      itr = reverse_assignment.erase(itr);
+
+  // Solve
+  for (const auto & [rows, cols] : components) {
+    if (rows.size() == 1 && cols.size() == 1) {
+      direct_assignment[rows.front()] = cols.front();
+      reverse_assignment[cols.front()] = rows.front();
       continue;
-    } else {
-      ++itr;
+    }
+    std::vector<std::vector<double>> score(rows.size(), std::vector<double>(cols.size(), 0.0));
+    for (size_t i = 0; i < rows.size(); ++i) {
+      for (size_t j = 0; j < cols.size(); ++j) {
+        score.at(i).at(j) = src.coeff(rows.at(i), cols.at(j));
+      }
+    }
+    std::unordered_map<int, int> component_direct_assignment, component_reverse_assignment;
+    gnn_solver_ptr_->maximizeLinearAssignment(
+      score, &component_direct_assignment, &component_reverse_assignment);
+    for (const auto & [i, j] : component_direct_assignment) {
+      if (score.at(i).at(j) < score_threshold_) continue;
+      direct_assignment[rows.at(i)] = cols.at(j);
+      reverse_assignment[cols.at(j)] = rows.at(i);
     }
   }
 }
 
-Eigen::MatrixXd DataAssociation::calcScoreMatrix(
+ScoreMatrix DataAssociation::calcScoreMatrix(
   const autoware_perception_msgs::msg::DetectedObjects & objects0,
   const autoware_perception_msgs::msg::DetectedObjects & objects1)
 {
-  Eigen::MatrixXd score_matrix =
-    Eigen::MatrixXd::Zero(objects1.objects.size(), objects0.objects.size());
+  ScoreMatrix score_matrix(objects1.objects.size(), objects0.objects.size());
+  if (objects0.objects.empty() || objects1.objects.empty()) {
+    return score_matrix;
+  }
+
+  // Build R-tree of objects0
+  std::vector<ValueType> rtree_points;
+  rtree_points.reserve(objects0.objects.size());
+  for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
+    const auto & position =
+      objects0.objects.at(objects0_idx).kinematics.pose_with_covariance.pose.position;
+    rtree_points.emplace_back(Point(position.x, position.y), objects0_idx);
+  }
+  const bgi::rtree<ValueType, bgi::quadratic<16>> rtree(rtree_points.begin(), rtree_points.end());
+
+  // For each object1, score the nearby objects0
+  std::vector<std::vector<Eigen::Triplet<double>>> row_scores(objects1.objects.size());
+#pragma omp parallel for schedule(dynamic)
   for (size_t objects1_idx = 0; objects1_idx < objects1.objects.size(); ++objects1_idx) {
     const autoware_perception_msgs::msg::DetectedObject & object1 =
       objects1.objects.at(objects1_idx);
     const std::uint8_t object1_label =
       autoware::object_recognition_utils::getHighestProbLabel(object1.classification);
+    const double max_dist = max_dist_per_label_.at(object1_label);
+    if (max_dist <= 0.0) continue;
 
-    for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
-      const autoware_perception_msgs::msg::DetectedObject & object0 =
-        objects0.objects.at(objects0_idx);
-      const std::uint8_t object0_label =
-        autoware::object_recognition_utils::getHighestProbLabel(object0.classification);
+    const auto & position = object1.kinematics.pose_with_covariance.pose.position;
+    const Box query_box(
+      Point(position.x - max_dist, position.y - max_dist),
+      Point(position.x + max_dist, position.y + max_dist));
+    std::vector<ValueType> nearby_objects0;
+    rtree.query(bgi::within(query_box), std::back_inserter(nearby_objects0));
 
-      double score = 0.0;
-      if (can_assign_matrix_(object1_label, object0_label)) {
-        const double max_dist = max_dist_matrix_(object1_label, object0_label);
-        const double dist = autoware_utils::calc_distance2d(
-          object0.kinematics.pose_with_covariance.pose.position,
-          object1.kinematics.pose_with_covariance.pose.position);
-
-        bool passed_gate = true;
-        // dist gate
-        {  // passed_gate is always true
-          if (max_dist < dist) passed_gate = false;
-        }
-        // angle gate
-        if (passed_gate) {
-          const double max_rad = max_rad_matrix_(object1_label, object0_label);
-          const double angle = getFormedYawAngle(
-            object0.kinematics.pose_with_covariance.pose.orientation,
-            object1.kinematics.pose_with_covariance.pose.orientation, false);
-          if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle))
-            passed_gate = false;
-        }
-        // 2d iou gate
-        if (passed_gate) {
-          const double min_iou = min_iou_matrix_(object1_label, object0_label);
-          const double min_union_iou_area = 1e-2;
-          const double iou =
-            autoware::object_recognition_utils::get2dIoU(object0, object1, min_union_iou_area);
-          if (iou < min_iou) passed_gate = false;
-        }
-
-        // all gate is passed
-        if (passed_gate) {
-          score = (max_dist - std::min(dist, max_dist)) / max_dist;
-          if (score < score_threshold_) score = 0.0;
-        }
+    for (const auto & [point, objects0_idx] : nearby_objects0) {
+      const double score = calcScoreBetweenObjects(objects0.objects.at(objects0_idx), object1);
+      if (0.0 < score) {
+        row_scores.at(objects1_idx).emplace_back(
+          static_cast<int>(objects1_idx), static_cast<int>(objects0_idx), score);
       }
-      score_matrix(objects1_idx, objects0_idx) = score;
     }
   }
 
+  std::vector<Eigen::Triplet<double>> scores;
+  for (const auto & row_score : row_scores) {
+    scores.insert(scores.end(), row_score.begin(), row_score.end());
+  }
+  score_matrix.setFromTriplets(scores.begin(), scores.end());
   return score_matrix;
 }
 
+double DataAssociation::calcScoreBetweenObjects(
+  const autoware_perception_msgs::msg::DetectedObject & object0,
+  const autoware_perception_msgs::msg::DetectedObject & object1) const
+{
+  const std::uint8_t object1_label =
+    autoware::object_recognition_utils::getHighestProbLabel(object1.classification);
+  const std::uint8_t object0_label =
+    autoware::object_recognition_utils::getHighestProbLabel(object0.classification);
+
+  double score = 0.0;
+  if (can_assign_matrix_(object1_label, object0_label)) {
+    const double max_dist = max_dist_matrix_(object1_label, object0_label);
+    const double dist = autoware_utils::calc_distance2d(
+      object0.kinematics.pose_with_covariance.pose.position,
+      object1.kinematics.pose_with_covariance.pose.position);
+
+    bool passed_gate = true;
+    // dist gate
+    {  // passed_gate is always true
+      if (max_dist < dist) passed_gate = false;
+    }
+    // angle gate
+    if (passed_gate) {
+      const double max_rad = max_rad_matrix_(object1_label, object0_label);
+      const double angle = getFormedYawAngle(
+        object0.kinematics.pose_with_covariance.pose.orientation,
+        object1.kinematics.pose_with_covariance.pose.orientation, false);
+      if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle)) passed_gate = false;
+    }
+    // 2d iou gate
+    if (passed_gate) {
+      const double min_iou = min_iou_matrix_(object1_label, object0_label);
+      const double min_union_iou_area = 1e-2;
+      const double iou =
+        autoware::object_recognition_utils::get2dIoU(object0, object1, min_union_iou_area);
+      if (iou < min_iou) passed_gate = false;
+    }
+
+    // all gate is passed
+    if (passed_gate) {
+      score = (max_dist - std::min(dist, max_dist)) / max_dist;
+      if (score < score_threshold_) score = 0.0;
+    }
+  }
+  return score;
+}
+
 }  // namespace autoware::object_merger
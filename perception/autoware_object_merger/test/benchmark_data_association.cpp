@@ -0,0 +1,191 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/object_merger/association/data_association.hpp"
+#include "autoware/object_merger/association/solver/gnn_solver.hpp"
+
+#include <autoware_perception_msgs/msg/object_classification.hpp>
+#include <autoware_perception_msgs/msg/shape.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Measure the association of object_association_merger for 50 to 500 objects per input. The
+// objects are cars, trucks, pedestrians and unknown objects spread over 200 m x 200 m, and the
+// second input detects 80% of the objects of the first one with noise, plus as many false
+// positives. The baseline is the previous association, which scored every pair of objects into a
+// dense matrix and solved the assignment of the whole matrix. The association scores only the
+// pairs found by the R-tree query and solves each connected component of the scored pairs
+// separately.
+
+namespace
+{
+using autoware::object_merger::DataAssociation;
+using autoware::object_merger::ScoreMatrix;
+using autoware_perception_msgs::msg::DetectedObject;
+using autoware_perception_msgs::msg::DetectedObjects;
+using Label = autoware_perception_msgs::msg::ObjectClassification;
+using Clock = std::chrono::steady_clock;
+
+// the default parameters of config/data_association_matrix.param.yaml
+std::unique_ptr<DataAssociation> createDataAssociation()
+{
+  const std::vector<int> can_assign_matrix = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0,
+    0, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 1, 1, 1};
+  const std::vector<double> max_dist_matrix = {
+    4.0, 4.0, 5.0, 5.0, 5.0, 2.0, 2.0, 2.0, 4.0, 2.0, 5.0, 5.0, 5.0, 1.0, 1.0, 1.0,
+    5.0, 5.0, 5.0, 5.0, 5.0, 1.0, 1.0, 1.0, 5.0, 5.0, 5.0, 5.0, 5.0, 1.0, 1.0, 1.0,
+    5.0, 5.0, 5.0, 5.0, 5.0, 1.0, 1.0, 1.0, 2.0, 1.0, 1.0, 1.0, 1.0, 3.0, 3.0, 3.0,
+    2.0, 1.0, 1.0, 1.0, 1.0, 3.0, 3.0, 3.0, 2.0, 1.0, 1.0, 1.0, 1.0, 3.0, 3.0, 2.0};
+  std::vector<double> max_rad_matrix(64, 3.150);
+  for (const int row : {1, 2, 3, 4}) {
+    for (const int col : {1, 2, 3, 4}) {
+      max_rad_matrix.at(row * 8 + col) = 1.047;
+    }
+  }
+  std::vector<double> min_iou_matrix(64, 0.1);
+  for (const int row : {1, 2, 3, 4}) {
+    for (const int col : {1, 2, 3, 4}) {
+      min_iou_matrix.at(row * 8 + col) = (row == 1) != (col == 1) ? 0.2 : 0.3;
+    }
+  }
+  return std::make_unique<DataAssociation>(
+    can_assign_matrix, max_dist_matrix, max_rad_matrix, min_iou_matrix);
+}
+
+DetectedObject createObject(
+  const std::uint8_t label, const double x, const double y, const double yaw)
+{
+  DetectedObject object;
+  Label classification;
+  classification.label = label;
+  classification.probability = 1.0;
+  object.classification.push_back(classification);
+  object.existence_probability = 1.0;
+  object.kinematics.pose_with_covariance.pose.position.x = x;
+  object.kinematics.pose_with_covariance.pose.position.y = y;
+  object.kinematics.pose_with_covariance.pose.orientation.z = std::sin(yaw / 2.0);
+  object.kinematics.pose_with_covariance.pose.orientation.w = std::cos(yaw / 2.0);
+  object.shape.type = autoware_perception_msgs::msg::Shape::BOUNDING_BOX;
+  const bool is_vehicle = label == Label::CAR || label == Label::TRUCK;
+  object.shape.dimensions.x = label == Label::TRUCK ? 8.0 : is_vehicle ? 4.5 : 0.6;
+  object.shape.dimensions.y = is_vehicle ? 2.0 : 0.6;
+  object.shape.dimensions.z = 1.5;
+  return object;
+}
+
+void createObjects(
+  const std::size_t num_objects, std::mt19937 & engine, DetectedObjects & objects0,
+  DetectedObjects & objects1)
+{
+  std::uniform_real_distribution<double> position_distribution(-100.0, 100.0);
+  std::uniform_real_distribution<double> yaw_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<double> ratio_distribution(0.0, 1.0);
+  std::normal_distribution<double> noise_distribution(0.0, 0.3);
+  const std::vector<std::uint8_t> labels = {
+    Label::CAR, Label::CAR, Label::TRUCK, Label::PEDESTRIAN, Label::UNKNOWN};
+
+  objects0.objects.clear();
+  objects1.objects.clear();
+  for (std::size_t i = 0; i < num_objects; ++i) {
+    const auto label = labels.at(i % labels.size());
+    const double x = position_distribution(engine);
+    const double y = position_distribution(engine);
+    const double yaw = yaw_distribution(engine);
+    objects0.objects.push_back(createObject(label, x, y, yaw));
+    if (ratio_distribution(engine) < 0.8) {
+      objects1.objects.push_back(createObject(
+        label, x + noise_distribution(engine), y + noise_distribution(engine),
+        yaw + 0.1 * noise_distribution(engine)));
+    }
+  }
+  while (objects1.objects.size() < num_objects) {
+    objects1.objects.push_back(createObject(
+      labels.at(objects1.objects.size() % labels.size()), position_distribution(engine),
+      position_distribution(engine), yaw_distribution(engine)));
+  }
+}
+
+// the previous association, every pair scored and the whole matrix solved
+void denseAssign(
+  const DataAssociation & data_association, const DetectedObjects & objects0,
+  const DetectedObjects & objects1, std::unordered_map<int, int> & direct_assignment)
+{
+  std::vector<std::vector<double>> score(
+    objects1.objects.size(), std::vector<double>(objects0.objects.size(), 0.0));
+  for (std::size_t i = 0; i < objects1.objects.size(); ++i) {
+    for (std::size_t j = 0; j < objects0.objects.size(); ++j) {
+      score.at(i).at(j) =
+        data_association.calcScoreBetweenObjects(objects0.objects.at(j), objects1.objects.at(i));
+    }
+  }
+  std::unordered_map<int, int> reverse_assignment;
+  autoware::object_merger::gnn_solver::MuSSP solver;
+  solver.maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
+    itr = score.at(itr->first).at(itr->second) < 0.01 ? direct_assignment.erase(itr) : ++itr;
+  }
+}
+
+// the mean time in ms of f, after a warm-up run
+template <typename F>
+double measure(F && f, const int num_iterations)
+{
+  f();
+  const auto start = Clock::now();
+  for (int i = 0; i < num_iterations; ++i) {
+    f();
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / num_iterations;
+}
+}  // namespace
+
+int main()
+{
+  std::mt19937 engine(0);
+  auto data_association = createDataAssociation();
+  for (const std::size_t num_objects : {50, 100, 200, 500}) {
+    DetectedObjects objects0;
+    DetectedObjects objects1;
+    createObjects(num_objects, engine, objects0, objects1);
+
+    std::unordered_map<int, int> dense_assignment;
+    const double dense_ms = measure(
+      [&]() {
+        dense_assignment.clear();
+        denseAssign(*data_association, objects0, objects1, dense_assignment);
+      },
+      10);
+    std::unordered_map<int, int> direct_assignment;
+    const double sparse_ms = measure(
+      [&]() {
+        direct_assignment.clear();
+        std::unordered_map<int, int> reverse_assignment;
+        const ScoreMatrix score_matrix = data_association->calcScoreMatrix(objects0, objects1);
+        data_association->assign(score_matrix, direct_assignment, reverse_assignment);
+      },
+      10);
+    std::cout << "objects per input: " << num_objects << ", dense " << dense_ms
+              << " ms, broad-phase and sparse assignment " << sparse_ms << " ms, "
+              << direct_assignment.size() << " / " << dense_assignment.size()
+              << " pairs, same assignment: "
+              << (direct_assignment == dense_assignment ? "yes" : "no") << std::endl;
+  }
+  return 0;
+}
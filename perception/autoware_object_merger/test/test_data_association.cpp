@@ -0,0 +1,216 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/object_merger/association/data_association.hpp"
+#include "autoware/object_merger/association/solver/gnn_solver.hpp"
+
+#include <autoware_perception_msgs/msg/object_classification.hpp>
+#include <autoware_perception_msgs/msg/shape.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using autoware::object_merger::DataAssociation;
+using autoware::object_merger::ScoreMatrix;
+using autoware_perception_msgs::msg::DetectedObject;
+using autoware_perception_msgs::msg::DetectedObjects;
+using Label = autoware_perception_msgs::msg::ObjectClassification;
+
+constexpr std::size_t num_labels = 8;
+
+// The max distances depend on both labels, so that the search distance of the R-tree query of a
+// label is larger than some of its gates. The IoU gate is disabled so that the distance gate
+// decides which pairs are scored, and the angle gate is enabled between the vehicles.
+std::unique_ptr<DataAssociation> createDataAssociation()
+{
+  std::vector<int> can_assign_matrix(num_labels * num_labels, 1);
+  std::vector<double> max_dist_matrix(num_labels * num_labels);
+  std::vector<double> max_rad_matrix(num_labels * num_labels, 3.150);
+  const std::vector<double> min_iou_matrix(num_labels * num_labels, 0.0);
+  for (std::size_t row = 0; row < num_labels; ++row) {
+    for (std::size_t col = 0; col < num_labels; ++col) {
+      max_dist_matrix.at(row * num_labels + col) = 1.0 + static_cast<double>((row + 2 * col) % 5);
+      if (row != 0 && col != 0 && row < 5 && col < 5) {
+        max_rad_matrix.at(row * num_labels + col) = 1.047;
+      }
+    }
+  }
+  // the pedestrians are not assigned to the vehicles
+  for (const std::size_t vehicle : {Label::CAR, Label::TRUCK, Label::BUS, Label::TRAILER}) {
+    can_assign_matrix.at(Label::PEDESTRIAN * num_labels + vehicle) = 0;
+    can_assign_matrix.at(vehicle * num_labels + Label::PEDESTRIAN) = 0;
+  }
+  return std::make_unique<DataAssociation>(
+    can_assign_matrix, max_dist_matrix, max_rad_matrix, min_iou_matrix);
+}
+
+DetectedObject createObject(
+  const std::uint8_t label, const double x, const double y, const double yaw)
+{
+  DetectedObject object;
+  Label classification;
+  classification.label = label;
+  classification.probability = 1.0;
+  object.classification.push_back(classification);
+  object.existence_probability = 1.0;
+  object.kinematics.pose_with_covariance.pose.position.x = x;
+  object.kinematics.pose_with_covariance.pose.position.y = y;
+  object.kinematics.pose_with_covariance.pose.orientation.z = std::sin(yaw / 2.0);
+  object.kinematics.pose_with_covariance.pose.orientation.w = std::cos(yaw / 2.0);
+  object.shape.type = autoware_perception_msgs::msg::Shape::BOUNDING_BOX;
+  object.shape.dimensions.x = 4.5;
+  object.shape.dimensions.y = 2.0;
+  object.shape.dimensions.z = 1.5;
+  return object;
+}
+
+// objects1 are around objects0 at distances close to the max distances, in all the directions so
+// that some of them are inside the query box of the R-tree but outside the distance gate, and the
+// objects are close enough to each other to make components of several pairs
+void createObjects(
+  const std::size_t num_objects, const double area_size, std::mt19937 & engine,
+  DetectedObjects & objects0, DetectedObjects & objects1)
+{
+  std::uniform_real_distribution<double> position_distribution(-area_size, area_size);
+  std::uniform_real_distribution<double> angle_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<double> distance_distribution(0.0, 5.2);
+  std::uniform_int_distribution<int> label_distribution(0, num_labels - 1);
+
+  objects0.objects.clear();
+  objects1.objects.clear();
+  for (std::size_t i = 0; i < num_objects; ++i) {
+    const double x = position_distribution(engine);
+    const double y = position_distribution(engine);
+    objects0.objects.push_back(createObject(
+      static_cast<std::uint8_t>(label_distribution(engine)), x, y, angle_distribution(engine)));
+    const double direction = angle_distribution(engine);
+    const double distance = distance_distribution(engine);
+    objects1.objects.push_back(createObject(
+      static_cast<std::uint8_t>(label_distribution(engine)), x + distance * std::cos(direction),
+      y + distance * std::sin(direction), angle_distribution(engine)));
+  }
+}
+
+// every pair scored into a dense matrix
+std::vector<std::vector<double>> calcDenseScoreMatrix(
+  const DataAssociation & data_association, const DetectedObjects & objects0,
+  const DetectedObjects & objects1)
+{
+  std::vector<std::vector<double>> score(
+    objects1.objects.size(), std::vector<double>(objects0.objects.size(), 0.0));
+  for (std::size_t i = 0; i < objects1.objects.size(); ++i) {
+    for (std::size_t j = 0; j < objects0.objects.size(); ++j) {
+      score.at(i).at(j) =
+        data_association.calcScoreBetweenObjects(objects0.objects.at(j), objects1.objects.at(i));
+    }
+  }
+  return score;
+}
+
+// the previous association, the whole dense matrix solved at once
+void denseAssign(
+  const std::vector<std::vector<double>> & score, std::unordered_map<int, int> & direct_assignment,
+  std::unordered_map<int, int> & reverse_assignment)
+{
+  autoware::object_merger::gnn_solver::MuSSP solver;
+  solver.maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
+    if (score.at(itr->first).at(itr->second) < 0.01) {
+      reverse_assignment.erase(itr->second);
+      itr = direct_assignment.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+}  // namespace
+
+TEST(DataAssociationTest, ScoreMatrixMatchesDenseScores)
+{
+  std::mt19937 engine(0);
+  auto data_association = createDataAssociation();
+  for (const double area_size : {5.0, 20.0, 100.0}) {
+    DetectedObjects objects0;
+    DetectedObjects objects1;
+    createObjects(200, area_size, engine, objects0, objects1);
+    const ScoreMatrix score_matrix = data_association->calcScoreMatrix(objects0, objects1);
+    const auto dense_score = calcDenseScoreMatrix(*data_association, objects0, objects1);
+    ASSERT_EQ(score_matrix.rows(), static_cast<Eigen::Index>(objects1.objects.size()));
+    ASSERT_EQ(score_matrix.cols(), static_cast<Eigen::Index>(objects0.objects.size()));
+
+    std::size_t num_scored_pairs = 0;
+    for (std::size_t i = 0; i < objects1.objects.size(); ++i) {
+      for (std::size_t j = 0; j < objects0.objects.size(); ++j) {
+        EXPECT_EQ(score_matrix.coeff(i, j), dense_score.at(i).at(j)) << i << ", " << j;
+        num_scored_pairs += 0.0 < dense_score.at(i).at(j);
+      }
+    }
+    // only the scored pairs are stored
+    EXPECT_EQ(static_cast<std::size_t>(score_matrix.nonZeros()), num_scored_pairs);
+    EXPECT_GT(num_scored_pairs, 0U);
+  }
+}
+
+TEST(DataAssociationTest, SparseAssignmentMatchesDenseAssignment)
+{
+  std::mt19937 engine(1);
+  auto data_association = createDataAssociation();
+  for (int trial = 0; trial < 30; ++trial) {
+    // from dense scenes of a few large components to sparse scenes of many small ones
+    const double area_size = 5.0 + 5.0 * trial;
+    DetectedObjects objects0;
+    DetectedObjects objects1;
+    createObjects(100, area_size, engine, objects0, objects1);
+
+    std::unordered_map<int, int> dense_direct_assignment;
+    std::unordered_map<int, int> dense_reverse_assignment;
+    denseAssign(
+      calcDenseScoreMatrix(*data_association, objects0, objects1), dense_direct_assignment,
+      dense_reverse_assignment);
+
+    std::unordered_map<int, int> direct_assignment;
+    std::unordered_map<int, int> reverse_assignment;
+    data_association->assign(
+      data_association->calcScoreMatrix(objects0, objects1), direct_assignment,
+      reverse_assignment);
+
+    EXPECT_EQ(direct_assignment, dense_direct_assignment) << "area size: " << area_size;
+    EXPECT_EQ(reverse_assignment, dense_reverse_assignment) << "area size: " << area_size;
+  }
+}
+
+TEST(DataAssociationTest, EmptyInputs)
+{
+  auto data_association = createDataAssociation();
+  DetectedObjects objects0;
+  DetectedObjects objects1;
+  objects1.objects.push_back(createObject(Label::CAR, 0.0, 0.0, 0.0));
+  const ScoreMatrix score_matrix = data_association->calcScoreMatrix(objects0, objects1);
+  EXPECT_EQ(score_matrix.rows(), 1);
+  EXPECT_EQ(score_matrix.cols(), 0);
+
+  std::unordered_map<int, int> direct_assignment;
+  std::unordered_map<int, int> reverse_assignment;
+  data_association->assign(score_matrix, direct_assignment, reverse_assignment);
+  EXPECT_TRUE(direct_assignment.empty());
+  EXPECT_TRUE(reverse_assignment.empty());
+}
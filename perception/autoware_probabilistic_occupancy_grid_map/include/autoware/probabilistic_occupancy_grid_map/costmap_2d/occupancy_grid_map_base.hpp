@@ -88,6 +88,11 @@ public:
     [[maybe_unused]] const Pose & robot_pose, [[maybe_unused]] const Pose & scan_origin) {};
 #endif
 
+  virtual void updateWithPointCloud(
+    [[maybe_unused]] const PointCloud2 & raw_pointcloud,
+    [[maybe_unused]] const PointCloud2 & obstacle_pointcloud,
+    [[maybe_unused]] const Pose & robot_pose, [[maybe_unused]] const Pose & scan_origin) {};
+
   void updateOrigin(double new_origin_x, double new_origin_y) override;
 
   void resetMaps() override;
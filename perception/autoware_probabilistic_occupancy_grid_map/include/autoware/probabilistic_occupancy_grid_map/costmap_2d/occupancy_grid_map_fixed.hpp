@@ -16,7 +16,12 @@
 #define AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__COSTMAP_2D__OCCUPANCY_GRID_MAP_FIXED_HPP_
 
 #include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_base.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/utils/polar_points_tensor.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/utils/utils_cpu.hpp"
+
+#ifdef USE_CUDA
 #include "autoware/probabilistic_occupancy_grid_map/utils/cuda_pointcloud.hpp"
+#endif
 
 namespace autoware::occupancy_grid_map
 {
@@ -32,17 +37,30 @@ public:
     const bool use_cuda, const unsigned int cells_size_x, const unsigned int cells_size_y,
     const float resolution);
 
+#ifdef USE_CUDA
   void updateWithPointCloud(
     const CudaPointCloud2 & raw_pointcloud, const CudaPointCloud2 & obstacle_pointcloud,
     const Pose & robot_pose, const Pose & scan_origin) override;
+#endif
+
+  void updateWithPointCloud(
+    const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
+    const Pose & robot_pose, const Pose & scan_origin) override;
 
   void initRosParam(rclcpp::Node & node) override;
 
 protected:
   double distance_margin_;
 
+  // Buffers of the cpu implementation
+  utils::PolarPointsTensor raw_points_polar_tensor_{2};
+  utils::PolarPointsTensor obstacle_points_polar_tensor_{2};
+  utils::cpu::ThreadBuffers thread_buffers_;
+
+#ifdef USE_CUDA
   autoware::cuda_utils::CudaUniquePtr<std::uint64_t[]> raw_points_tensor_;
   autoware::cuda_utils::CudaUniquePtr<std::uint64_t[]> obstacle_points_tensor_;
+#endif
 };
 
 }  // namespace costmap_2d
@@ -16,6 +16,8 @@
 #define AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__COSTMAP_2D__OCCUPANCY_GRID_MAP_PROJECTIVE_HPP_
 
 #include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_base.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/utils/polar_points_tensor.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/utils/utils_cpu.hpp"
 
 #include <grid_map_core/GridMap.hpp>
 
@@ -35,9 +37,15 @@ public:
     const bool use_cuda, const unsigned int cells_size_x, const unsigned int cells_size_y,
     const float resolution);
 
+#ifdef USE_CUDA
   void updateWithPointCloud(
     const CudaPointCloud2 & raw_pointcloud, const CudaPointCloud2 & obstacle_pointcloud,
     const Pose & robot_pose, const Pose & scan_origin) override;
+#endif
+
+  void updateWithPointCloud(
+    const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
+    const Pose & robot_pose, const Pose & scan_origin) override;
 
   void initRosParam(rclcpp::Node & node) override;
 
@@ -45,9 +53,16 @@ private:
   float projection_dz_threshold_;
   float obstacle_separation_threshold_;
 
+  // Buffers of the cpu implementation
+  utils::PolarPointsTensor raw_points_polar_tensor_{6};
+  utils::PolarPointsTensor obstacle_points_polar_tensor_{6};
+  utils::cpu::ThreadBuffers thread_buffers_;
+
+#ifdef USE_CUDA
   autoware::cuda_utils::CudaUniquePtr<std::uint64_t[]> raw_points_tensor_;
   autoware::cuda_utils::CudaUniquePtr<std::uint64_t[]> obstacle_points_tensor_;
   autoware::cuda_utils::CudaUniquePtr<Eigen::Vector3f> device_translation_scan_origin_;
+#endif
 };
 
 }  // namespace costmap_2d
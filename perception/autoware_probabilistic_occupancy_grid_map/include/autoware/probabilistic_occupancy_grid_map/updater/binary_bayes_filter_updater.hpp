@@ -24,6 +24,8 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <vector>
+
 namespace autoware::occupancy_grid_map
 {
 namespace costmap_2d
@@ -43,6 +45,9 @@ private:
   Eigen::Matrix2f probability_matrix_;
   double v_ratio_;
 
+  // applyBBF() of every pair of the measurement and the prior, indexed by (z << 8) | o
+  std::vector<unsigned char> bbf_table_;
+
 #ifdef USE_CUDA
   autoware::cuda_utils::CudaUniquePtr<float[]> device_probability_matrix_;
 #endif
@@ -22,6 +22,8 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 
+#include <vector>
+
 // LOBF means: Log Odds Bayes Filter
 // cspell: ignore LOBF
 
@@ -35,15 +37,15 @@ public:
   enum Index : size_t { OCCUPIED = 0U, FREE = 1U, NUM_STATES = 2U };
   OccupancyGridMapLOBFUpdater(
     const bool use_cuda, const unsigned int cells_size_x, const unsigned int cells_size_y,
-    const float resolution)
-  : OccupancyGridMapUpdaterInterface(use_cuda, cells_size_x, cells_size_y, resolution)
-  {
-  }
+    const float resolution);
   bool update(const OccupancyGridMapInterface & single_frame_occupancy_grid_map) override;
   void initRosParam(rclcpp::Node & node) override;
 
 private:
   inline unsigned char applyLOBF(const unsigned char & z, const unsigned char & o);
+
+  // applyLOBF() of every pair of the measurement and the prior, indexed by (z << 8) | o
+  std::vector<unsigned char> lobf_table_;
 };
 
 }  // namespace costmap_2d
@@ -0,0 +1,123 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__UTILS__POLAR_POINTS_TENSOR_HPP_
+#define AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__UTILS__POLAR_POINTS_TENSOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace autoware::occupancy_grid_map
+{
+namespace utils
+{
+
+// Same packing as the points tensors of the cuda kernels: (range_int << 32) | float bits
+inline std::uint64_t packElement(const std::uint64_t range_int, const float value)
+{
+  std::uint32_t value_int;
+  std::memcpy(&value_int, &value, sizeof(value_int));
+  return (range_int << 32) | value_int;
+}
+
+inline std::uint32_t unpackRange(const std::uint64_t element)
+{
+  return static_cast<std::uint32_t>(element >> 32);
+}
+
+inline float unpackValue(const std::uint64_t element)
+{
+  const auto value_int = static_cast<std::uint32_t>(element & 0xFFFFFFFF);
+  float value;
+  std::memcpy(&value, &value_int, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief Points binned by angle and range around the scan origin, for the cpu implementation.
+ * @details It holds the same elements as the dense points tensors of the cuda kernels, where each
+ * of the stride values of a bin is the minimum over the points in the bin, but only for the
+ * non-empty bins. They are stored contiguously per angle bin in ascending order of the range bin,
+ * so that the rays are walked without scanning the empty bins.
+ * Usage: resize(), then setPoint() or setInvalid() for every point (thread-safe for distinct
+ * points), then build().
+ */
+class PolarPointsTensor
+{
+public:
+  explicit PolarPointsTensor(const std::size_t stride) : stride_(stride) {}
+
+  void resize(const std::size_t num_points, const std::size_t angle_bins);
+
+  void setPoint(
+    const std::size_t point_index, const std::uint32_t angle_bin_index,
+    const std::uint32_t range_bin_index, const std::uint64_t * element)
+  {
+    point_angle_bins_[point_index] = angle_bin_index;
+    point_range_bins_[point_index] = range_bin_index;
+    std::memcpy(
+      point_elements_.data() + point_index * stride_, element, stride_ * sizeof(std::uint64_t));
+  }
+
+  void setInvalid(const std::size_t point_index) { point_angle_bins_[point_index] = invalid_bin; }
+
+  /**
+   * @brief Bin the points with a counting sort over the angle bins, and reduce each bin.
+   */
+  void build();
+
+  std::size_t getStride() const { return stride_; }
+  std::size_t getNumOfAngleBins() const { return bin_counts_.size(); }
+
+  // The bins of an angle bin are the entries in [getBegin(), getEnd())
+  std::size_t getBegin(const std::size_t angle_bin_index) const
+  {
+    return angle_offsets_[angle_bin_index];
+  }
+  std::size_t getEnd(const std::size_t angle_bin_index) const
+  {
+    return angle_offsets_[angle_bin_index] + bin_counts_[angle_bin_index];
+  }
+
+  std::uint32_t getRangeBin(const std::size_t entry) const { return range_bins_[entry]; }
+  const std::uint64_t * getElement(const std::size_t entry) const
+  {
+    return elements_.data() + entry * stride_;
+  }
+
+  static constexpr std::uint32_t invalid_bin = 0xFFFFFFFF;
+
+private:
+  std::size_t stride_;
+
+  // Points, in the order of the input
+  std::vector<std::uint32_t> point_angle_bins_;
+  std::vector<std::uint32_t> point_range_bins_;
+  std::vector<std::uint64_t> point_elements_;
+
+  // Bins, grouped by angle bin
+  std::vector<std::size_t> angle_offsets_;
+  std::vector<std::size_t> bin_counts_;
+  std::vector<std::uint64_t> sort_keys_;
+  std::vector<std::uint32_t> range_bins_;
+  std::vector<std::uint64_t> elements_;
+  std::vector<std::size_t> thread_counts_;
+};
+
+}  // namespace utils
+}  // namespace autoware::occupancy_grid_map
+
+#endif  // AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__UTILS__POLAR_POINTS_TENSOR_HPP_
@@ -0,0 +1,82 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__UTILS__UTILS_CPU_HPP_
+#define AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__UTILS__UTILS_CPU_HPP_
+
+#include "autoware/probabilistic_occupancy_grid_map/utils/polar_points_tensor.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace autoware::occupancy_grid_map
+{
+namespace utils::cpu
+{
+
+// Host counterparts of the device functions in utils_kernel.hpp
+
+void setCellValue(
+  float wx, float wy, float origin_x, float origin_y, float resolution_inv, int size_x, int size_y,
+  std::uint8_t value, std::uint8_t * costmap_tensor);
+
+void raytrace(
+  const float source_x, const float source_y, const float target_x, const float target_y,
+  const float origin_x, float origin_y, const float resolution_inv, const int size_x,
+  const int size_y, const std::uint8_t cost, std::uint8_t * costmap_tensor);
+
+/**
+ * @brief Ray from an obstacle to be traced as unknown space, optionally setting its end as free.
+ */
+struct RaySegment
+{
+  float source_x;
+  float source_y;
+  float target_x;
+  float target_y;
+  bool is_target_free;
+};
+
+/**
+ * @brief Buffers of the threads, kept between the updates to avoid the allocations.
+ */
+struct ThreadBuffers
+{
+  std::vector<std::uint8_t> costmaps;
+  std::vector<std::vector<RaySegment>> segments;
+};
+
+/**
+ * @brief Trace the rays from the scan origin to the raw points as free space.
+ * @details The rays are traced in parallel into a costmap per thread, which are merged at last.
+ */
+void fillEmptySpace(
+  const PolarPointsTensor & points_tensor, const float map_resolution_inv,
+  const float scan_origin_x, const float scan_origin_y, const float map_origin_x,
+  const float map_origin_y, const int num_cells_x, const int num_cells_y,
+  const std::uint8_t empty_value, ThreadBuffers & buffers, std::uint8_t * costmap_tensor);
+
+/**
+ * @brief Trace the segments collected by the threads, in the order of the threads.
+ */
+void applyRaySegments(
+  const ThreadBuffers & buffers, const float map_origin_x, const float map_origin_y,
+  const float map_resolution_inv, const int num_cells_x, const int num_cells_y,
+  const std::uint8_t free_space_value, const std::uint8_t no_information_value,
+  std::uint8_t * costmap_tensor);
+
+}  // namespace utils::cpu
+}  // namespace autoware::occupancy_grid_map
+
+#endif  // AUTOWARE__PROBABILISTIC_OCCUPANCY_GRID_MAP__UTILS__UTILS_CPU_HPP_
@@ -69,6 +69,7 @@
 #endif
 
 #include <algorithm>
+#include <limits>
 
 namespace autoware::occupancy_grid_map
 {
@@ -82,12 +83,12 @@ OccupancyGridMapInterface::OccupancyGridMapInterface(
 : Costmap2D(cells_size_x, cells_size_y, resolution, 0.f, 0.f, cost_value::NO_INFORMATION),
   use_cuda_(use_cuda)
 {
+  min_height_ = -std::numeric_limits<double>::infinity();
+  max_height_ = std::numeric_limits<double>::infinity();
+  resolution_inv_ = 1.0 / resolution_;
+
 #ifdef USE_CUDA
   if (use_cuda_) {
-    min_height_ = -std::numeric_limits<double>::infinity();
-    max_height_ = std::numeric_limits<double>::infinity();
-    resolution_inv_ = 1.0 / resolution_;
-
     const auto num_cells_x = this->getSizeInCellsX();
     const auto num_cells_y = this->getSizeInCellsY();
 
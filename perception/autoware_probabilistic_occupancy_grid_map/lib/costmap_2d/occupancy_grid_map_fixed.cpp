@@ -15,11 +15,16 @@
 #include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed.hpp"
 
 #include "autoware/probabilistic_occupancy_grid_map/cost_value/cost_value.hpp"
-#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed_kernel.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed_cpu.hpp"
 #include "autoware/probabilistic_occupancy_grid_map/utils/utils.hpp"
+
+#ifdef USE_CUDA
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed_kernel.hpp"
 #include "autoware/probabilistic_occupancy_grid_map/utils/utils_kernel.hpp"
 
 #include <autoware/cuda_utils/cuda_unique_ptr.hpp>
+#endif
+
 #include <autoware_utils/math/unit_conversion.hpp>
 #include <grid_map_costmap_2d/grid_map_costmap_2d.hpp>
 #include <pcl_ros/transforms.hpp>
@@ -48,6 +53,7 @@ OccupancyGridMapFixedBlindSpot::OccupancyGridMapFixedBlindSpot(
   const float resolution)
 : OccupancyGridMapInterface(use_cuda, cells_size_x, cells_size_y, resolution)
 {
+#ifdef USE_CUDA
   if (use_cuda_) {
     const size_t angle_bin_size =
       ((max_angle_ - min_angle_) * angle_increment_inv_) + size_t(1 /*margin*/);
@@ -62,8 +68,11 @@ OccupancyGridMapFixedBlindSpot::OccupancyGridMapFixedBlindSpot(
     obstacle_points_tensor_ =
       autoware::cuda_utils::make_unique<std::uint64_t[]>(2 * angle_bin_size * range_bin_size);
   }
+#endif
 }
 
+#ifdef USE_CUDA
+
 /**
  * @brief update Gridmap with PointCloud
  *
@@ -157,6 +166,76 @@ void OccupancyGridMapFixedBlindSpot::updateWithPointCloud(
     range_resolution_inv, origin_x_, origin_y_, num_cells_x, num_cells_y,
     cost_value::LETHAL_OBSTACLE, device_costmap_.get(), stream_);
 }
+#endif
+
+/**
+ * @brief update Gridmap with PointCloud on cpu, in the same way as the cuda implementation
+ *
+ * @param raw_pointcloud raw point cloud on a certain frame (usually base_link)
+ * @param obstacle_pointcloud raw point cloud on a certain frame (usually base_link)
+ * @param robot_pose frame of the input point cloud (usually base_link)
+ * @param scan_origin manually chosen grid map origin frame
+ */
+void OccupancyGridMapFixedBlindSpot::updateWithPointCloud(
+  const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
+  const Pose & robot_pose, const Pose & scan_origin)
+{
+  const size_t angle_bin_size =
+    ((max_angle_ - min_angle_) * angle_increment_inv_) + size_t(1 /*margin*/);
+
+  // Transform Matrix from base_link to map frame
+  mat_map_ = utils::getTransformMatrix(robot_pose);
+
+  const auto scan2map_pose = utils::getInversePose(scan_origin);  // scan -> map transform pose
+
+  // Transform Matrix from map frame to scan frame
+  mat_scan_ = utils::getTransformMatrix(scan2map_pose);
+
+  const auto map_res = this->getResolution();
+  const auto num_cells_x = this->getSizeInCellsX();
+  const auto num_cells_y = this->getSizeInCellsY();
+  const std::size_t range_bin_size =
+    static_cast<std::size_t>(std::sqrt(2) * std::max(num_cells_x, num_cells_y) / 2.0) + 1;
+
+  std::fill(costmap_, costmap_ + num_cells_x * num_cells_y, cost_value::NO_INFORMATION);
+
+  Eigen::Matrix3f rotation_map = mat_map_.block<3, 3>(0, 0);
+  Eigen::Vector3f translation_map = mat_map_.block<3, 1>(0, 3);
+
+  Eigen::Matrix3f rotation_scan = mat_scan_.block<3, 3>(0, 0);
+  Eigen::Vector3f translation_scan = mat_scan_.block<3, 1>(0, 3);
+
+  const std::size_t num_raw_points = raw_pointcloud.width * raw_pointcloud.height;
+  float range_resolution_inv = 1.0 / map_res;
+
+  map_fixed::prepareTensor(
+    reinterpret_cast<const float *>(raw_pointcloud.data.data()), num_raw_points,
+    raw_pointcloud.point_step / sizeof(float), angle_bin_size, range_bin_size, min_height_,
+    max_height_, min_angle_, angle_increment_inv_, range_resolution_inv, rotation_map,
+    translation_map, rotation_scan, translation_scan, raw_points_polar_tensor_);
+
+  const std::size_t num_obstacle_points = obstacle_pointcloud.width * obstacle_pointcloud.height;
+
+  map_fixed::prepareTensor(
+    reinterpret_cast<const float *>(obstacle_pointcloud.data.data()), num_obstacle_points,
+    obstacle_pointcloud.point_step / sizeof(float), angle_bin_size, range_bin_size, min_height_,
+    max_height_, min_angle_, angle_increment_inv_, range_resolution_inv, rotation_map,
+    translation_map, rotation_scan, translation_scan, obstacle_points_polar_tensor_);
+
+  utils::cpu::fillEmptySpace(
+    raw_points_polar_tensor_, range_resolution_inv, scan_origin.position.x,
+    scan_origin.position.y, origin_x_, origin_y_, num_cells_x, num_cells_y, cost_value::FREE_SPACE,
+    thread_buffers_, costmap_);
+
+  map_fixed::fillUnknownSpace(
+    raw_points_polar_tensor_, obstacle_points_polar_tensor_, distance_margin_, range_bin_size,
+    range_resolution_inv, origin_x_, origin_y_, num_cells_x, num_cells_y, cost_value::FREE_SPACE,
+    cost_value::NO_INFORMATION, thread_buffers_, costmap_);
+
+  map_fixed::fillObstacles(
+    obstacle_points_polar_tensor_, range_resolution_inv, origin_x_, origin_y_, num_cells_x,
+    num_cells_y, cost_value::LETHAL_OBSTACLE, costmap_);
+}
 
 void OccupancyGridMapFixedBlindSpot::initRosParam(rclcpp::Node & node)
 {
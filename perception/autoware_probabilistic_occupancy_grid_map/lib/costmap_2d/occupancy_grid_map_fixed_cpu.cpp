@@ -0,0 +1,234 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed_cpu.hpp"
+
+#include <omp.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace autoware::occupancy_grid_map
+{
+namespace costmap_2d::map_fixed
+{
+
+static constexpr float RANGE_DISCRETIZATION_RESOLUTION = 0.001f;
+
+using utils::unpackRange;
+using utils::unpackValue;
+
+void prepareTensor(
+  const float * input_pointcloud, const std::size_t num_points, const std::size_t points_step,
+  const std::size_t angle_bins, const std::size_t range_bins, const float min_height,
+  const float max_height, const float min_angle, const float angle_increment_inv,
+  const float range_resolution_inv, const Eigen::Matrix3f & rotation_map,
+  const Eigen::Vector3f & translation_map, const Eigen::Matrix3f & rotation_scan,
+  const Eigen::Vector3f & translation_scan, utils::PolarPointsTensor & points_tensor)
+{
+  points_tensor.resize(num_points, angle_bins);
+
+#pragma omp parallel for schedule(static)
+  for (std::size_t idx = 0; idx < num_points; ++idx) {
+    Eigen::Map<const Eigen::Vector3f> point(input_pointcloud + idx * points_step);
+
+    if (
+      point.z() > max_height || point.z() < min_height || !std::isfinite(point.x()) ||
+      !std::isfinite(point.y()) || !std::isfinite(point.z())) {
+      points_tensor.setInvalid(idx);
+      continue;
+    }
+
+    Eigen::Vector3f map_point = rotation_map * point + translation_map;
+    Eigen::Vector3f scan_point = rotation_scan * map_point + translation_scan;
+
+    float angle = std::atan2(scan_point.y(), scan_point.x());
+    int angle_bin_index = static_cast<int>((angle - min_angle) * angle_increment_inv);
+    float range = std::sqrt(scan_point.y() * scan_point.y() + scan_point.x() * scan_point.x());
+    int range_bin_index = static_cast<int>(range * range_resolution_inv);
+
+    if (
+      angle_bin_index < 0 || static_cast<std::size_t>(angle_bin_index) >= angle_bins ||
+      range_bin_index < 0 || static_cast<std::size_t>(range_bin_index) >= range_bins) {
+      points_tensor.setInvalid(idx);
+      continue;
+    }
+
+    std::uint64_t range_int = static_cast<std::int64_t>(range / RANGE_DISCRETIZATION_RESOLUTION);
+    const std::uint64_t element[2] = {
+      utils::packElement(range_int, map_point.x()), utils::packElement(range_int, map_point.y())};
+    points_tensor.setPoint(idx, angle_bin_index, range_bin_index, element);
+  }
+
+  points_tensor.build();
+}
+
+void fillUnknownSpace(
+  const utils::PolarPointsTensor & raw_points_tensor,
+  const utils::PolarPointsTensor & obstacle_points_tensor, const float distance_margin,
+  const std::size_t range_bins, const float map_resolution_inv, const float map_origin_x,
+  const float map_origin_y, const int num_cells_x, const int num_cells_y,
+  std::uint8_t free_space_value, std::uint8_t no_information_value,
+  utils::cpu::ThreadBuffers & buffers, std::uint8_t * costmap_tensor)
+{
+  const auto angle_bins = static_cast<int>(obstacle_points_tensor.getNumOfAngleBins());
+  const auto last_range_bin_index = static_cast<std::uint32_t>(range_bins - 1);
+  buffers.segments.resize(omp_get_max_threads());
+  for (auto & segments : buffers.segments) {
+    segments.clear();
+  }
+
+  // The segments are collected in the order of the angle bins, and traced in the same order
+#pragma omp parallel
+  {
+    auto & segments = buffers.segments[omp_get_thread_num()];
+
+#pragma omp for schedule(static)
+    for (int angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+      const auto raw_end = raw_points_tensor.getEnd(angle_bin_index);
+      const auto obs_end = obstacle_points_tensor.getEnd(angle_bin_index);
+
+      // The search of the kernel ends at the last range bin, which is taken even if it does not
+      // satisfy the condition
+      const std::uint64_t * last_raw_element =
+        (raw_end > raw_points_tensor.getBegin(angle_bin_index) &&
+         raw_points_tensor.getRangeBin(raw_end - 1) == last_range_bin_index)
+          ? raw_points_tensor.getElement(raw_end - 1)
+          : nullptr;
+
+      auto raw_entry = raw_points_tensor.getBegin(angle_bin_index);
+      for (auto obs_entry = obstacle_points_tensor.getBegin(angle_bin_index); obs_entry < obs_end;
+           ++obs_entry) {
+        const auto range_bin_index = obstacle_points_tensor.getRangeBin(obs_entry);
+        if (range_bin_index == last_range_bin_index) {
+          continue;
+        }
+
+        const std::uint64_t * obs_element = obstacle_points_tensor.getElement(obs_entry);
+        std::uint32_t obs_range_int = unpackRange(obs_element[0]);
+        float obs_range = obs_range_int * RANGE_DISCRETIZATION_RESOLUTION;
+        float obs_world_x = unpackValue(obs_element[0]);
+        float obs_world_y = unpackValue(obs_element[1]);
+
+        if (obs_world_x < map_origin_x || obs_world_y < map_origin_y) {
+          continue;
+        }
+
+        while (raw_entry < raw_end && raw_points_tensor.getRangeBin(raw_entry) <= range_bin_index) {
+          ++raw_entry;
+        }
+
+        const std::uint64_t * next_raw_element = last_raw_element;
+        for (auto entry = raw_entry;
+             entry < raw_end && raw_points_tensor.getRangeBin(entry) < last_range_bin_index;
+             ++entry) {
+          const float next_raw_range =
+            unpackRange(raw_points_tensor.getElement(entry)[0]) * RANGE_DISCRETIZATION_RESOLUTION;
+          if (std::abs(next_raw_range - obs_range) > distance_margin) {
+            next_raw_element = raw_points_tensor.getElement(entry);
+            break;
+          }
+        }
+
+        const std::uint64_t * next_obs_element =
+          obs_entry + 1 < obs_end ? obstacle_points_tensor.getElement(obs_entry + 1) : nullptr;
+
+        if (next_obs_element == nullptr) {
+          if (
+            next_raw_element == nullptr || unpackValue(next_raw_element[0]) < map_origin_x ||
+            unpackValue(next_raw_element[1]) < map_origin_y) {
+            continue;
+          }
+
+          // if there is no more obstacles after the current one but there are more raw points
+          // the space between the current obstacle and the next raw point flagged as
+          // no_information_value
+          segments.push_back(
+            {obs_world_x, obs_world_y, unpackValue(next_raw_element[0]),
+             unpackValue(next_raw_element[1]), true});
+          continue;
+        }
+
+        const float next_obs_world_x = unpackValue(next_obs_element[0]);
+        const float next_obs_world_y = unpackValue(next_obs_element[1]);
+        float next_obs_range = unpackRange(next_obs_element[0]) * RANGE_DISCRETIZATION_RESOLUTION;
+        float obs_to_obs_distance = next_obs_range - obs_range;
+
+        if (obs_to_obs_distance <= distance_margin) {
+          continue;
+        } else if (next_raw_element == nullptr) {
+          // fill with no information between obstacles
+
+          if (next_obs_world_x < map_origin_x || next_obs_world_y < map_origin_y) {
+            continue;
+          }
+
+          segments.push_back(
+            {obs_world_x, obs_world_y, next_obs_world_x, next_obs_world_y, false});
+          continue;
+        }
+
+        const float next_raw_world_x = unpackValue(next_raw_element[0]);
+        const float next_raw_world_y = unpackValue(next_raw_element[1]);
+        float next_raw_range = unpackRange(next_raw_element[0]) * RANGE_DISCRETIZATION_RESOLUTION;
+        float raw_to_obs_distance = std::abs(next_raw_range - obs_range);
+
+        if (raw_to_obs_distance < obs_to_obs_distance) {
+          // fill with free space between raw and obstacle
+
+          if (next_raw_world_x < map_origin_x || next_raw_world_y < map_origin_y) {
+            continue;
+          }
+
+          segments.push_back({obs_world_x, obs_world_y, next_raw_world_x, next_raw_world_y, true});
+        } else {
+          // fill with no information between obstacles
+
+          if (next_obs_world_x < map_origin_x || next_obs_world_y < map_origin_y) {
+            continue;
+          }
+
+          segments.push_back(
+            {obs_world_x, obs_world_y, next_obs_world_x, next_obs_world_y, false});
+        }
+      }
+    }
+  }
+
+  utils::cpu::applyRaySegments(
+    buffers, map_origin_x, map_origin_y, map_resolution_inv, num_cells_x, num_cells_y,
+    free_space_value, no_information_value, costmap_tensor);
+}
+
+void fillObstacles(
+  const utils::PolarPointsTensor & obstacle_points_tensor, const float map_resolution_inv,
+  const float map_origin_x, const float map_origin_y, const int num_cells_x, const int num_cells_y,
+  std::uint8_t obstacle_value, std::uint8_t * costmap_tensor)
+{
+  // The kernel also traces from each obstacle to the element it reads as the next one, which is
+  // the obstacle itself, so only the cells of the obstacles are set
+  const auto angle_bins = obstacle_points_tensor.getNumOfAngleBins();
+  for (std::size_t angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+    const auto end = obstacle_points_tensor.getEnd(angle_bin_index);
+    for (auto entry = obstacle_points_tensor.getBegin(angle_bin_index); entry < end; ++entry) {
+      const std::uint64_t * element = obstacle_points_tensor.getElement(entry);
+      utils::cpu::setCellValue(
+        unpackValue(element[0]), unpackValue(element[1]), map_origin_x, map_origin_y,
+        map_resolution_inv, num_cells_x, num_cells_y, obstacle_value, costmap_tensor);
+    }
+  }
+}
+
+}  // namespace costmap_2d::map_fixed
+}  // namespace autoware::occupancy_grid_map
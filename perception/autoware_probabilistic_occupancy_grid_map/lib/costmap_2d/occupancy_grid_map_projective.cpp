@@ -15,9 +15,13 @@
 #include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_projective.hpp"
 
 #include "autoware/probabilistic_occupancy_grid_map/cost_value/cost_value.hpp"
-#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_projective_kernel.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_projective_cpu.hpp"
 #include "autoware/probabilistic_occupancy_grid_map/utils/utils.hpp"
 
+#ifdef USE_CUDA
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_projective_kernel.hpp"
+#endif
+
 #include <autoware_utils/math/unit_conversion.hpp>
 #include <grid_map_costmap_2d/grid_map_costmap_2d.hpp>
 #include <grid_map_ros/grid_map_ros.hpp>
@@ -40,6 +44,7 @@ OccupancyGridMapProjectiveBlindSpot::OccupancyGridMapProjectiveBlindSpot(
   const float resolution)
 : OccupancyGridMapInterface(use_cuda, cells_size_x, cells_size_y, resolution)
 {
+#ifdef USE_CUDA
   if (use_cuda) {
     const size_t angle_bin_size =
       ((max_angle_ - min_angle_) * angle_increment_inv_) + size_t(1 /*margin*/);
@@ -55,8 +60,11 @@ OccupancyGridMapProjectiveBlindSpot::OccupancyGridMapProjectiveBlindSpot(
       autoware::cuda_utils::make_unique<std::uint64_t[]>(7 * angle_bin_size * range_bin_size);
     device_translation_scan_origin_ = autoware::cuda_utils::make_unique<Eigen::Vector3f>();
   }
+#endif
 }
 
+#ifdef USE_CUDA
+
 /**
  * @brief update Gridmap with PointCloud in 3D manner
  *
@@ -160,6 +168,82 @@ void OccupancyGridMapProjectiveBlindSpot::updateWithPointCloud(
 
   cudaStreamSynchronize(stream_);
 }
+#endif
+
+/**
+ * @brief update Gridmap with PointCloud in 3D manner on cpu, in the same way as the cuda
+ * implementation
+ *
+ * @param raw_pointcloud raw point cloud on a certain frame (usually base_link)
+ * @param obstacle_pointcloud raw point cloud on a certain frame (usually base_link)
+ * @param robot_pose frame of the input point cloud (usually base_link)
+ * @param scan_origin manually chosen grid map origin frame
+ */
+void OccupancyGridMapProjectiveBlindSpot::updateWithPointCloud(
+  const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
+  const Pose & robot_pose, const Pose & scan_origin)
+{
+  const size_t angle_bin_size =
+    ((max_angle_ - min_angle_) * angle_increment_inv_) + size_t(1 /*margin*/);
+
+  // Transform from base_link to map frame
+  mat_map_ = utils::getTransformMatrix(robot_pose);
+
+  const auto scan2map_pose = utils::getInversePose(scan_origin);  // scan -> map transform pose
+
+  // Transform Matrix from map frame to scan frame
+  mat_scan_ = utils::getTransformMatrix(scan2map_pose);
+
+  const auto map_res = this->getResolution();
+  const auto num_cells_x = this->getSizeInCellsX();
+  const auto num_cells_y = this->getSizeInCellsY();
+  const std::size_t range_bin_size =
+    static_cast<std::size_t>(std::sqrt(2) * std::max(num_cells_x, num_cells_y) / 2.0) + 1;
+
+  std::fill(costmap_, costmap_ + num_cells_x * num_cells_y, cost_value::NO_INFORMATION);
+
+  Eigen::Matrix3f rotation_map = mat_map_.block<3, 3>(0, 0);
+  Eigen::Vector3f translation_map = mat_map_.block<3, 1>(0, 3);
+
+  Eigen::Matrix3f rotation_scan = mat_scan_.block<3, 3>(0, 0);
+  Eigen::Vector3f translation_scan = mat_scan_.block<3, 1>(0, 3);
+
+  Eigen::Vector3f scan_origin_position(
+    scan_origin.position.x, scan_origin.position.y, scan_origin.position.z);
+
+  const std::size_t num_raw_points = raw_pointcloud.width * raw_pointcloud.height;
+  float range_resolution_inv = 1.0 / map_res;
+
+  map_projective::prepareRawTensor(
+    reinterpret_cast<const float *>(raw_pointcloud.data.data()), num_raw_points,
+    raw_pointcloud.point_step / sizeof(float), angle_bin_size, range_bin_size, min_height_,
+    max_height_, min_angle_, angle_increment_inv_, range_resolution_inv, rotation_map,
+    translation_map, rotation_scan, translation_scan, raw_points_polar_tensor_);
+
+  const std::size_t num_obstacle_points = obstacle_pointcloud.width * obstacle_pointcloud.height;
+
+  map_projective::prepareObstacleTensor(
+    reinterpret_cast<const float *>(obstacle_pointcloud.data.data()), num_obstacle_points,
+    obstacle_pointcloud.point_step / sizeof(float), angle_bin_size, range_bin_size, min_height_,
+    max_height_, min_angle_, angle_increment_inv_, range_resolution_inv, projection_dz_threshold_,
+    scan_origin_position, rotation_map, translation_map, rotation_scan, translation_scan,
+    obstacle_points_polar_tensor_);
+
+  utils::cpu::fillEmptySpace(
+    raw_points_polar_tensor_, range_resolution_inv, scan_origin.position.x,
+    scan_origin.position.y, origin_x_, origin_y_, num_cells_x, num_cells_y, cost_value::FREE_SPACE,
+    thread_buffers_, costmap_);
+
+  map_projective::fillUnknownSpace(
+    raw_points_polar_tensor_, obstacle_points_polar_tensor_, obstacle_separation_threshold_,
+    range_bin_size, range_resolution_inv, scan_origin.position.z, origin_x_, origin_y_,
+    robot_pose.position.z, num_cells_x, num_cells_y, cost_value::FREE_SPACE,
+    cost_value::NO_INFORMATION, thread_buffers_, costmap_);
+
+  map_projective::fillObstacles(
+    obstacle_points_polar_tensor_, range_resolution_inv, origin_x_, origin_y_, num_cells_x,
+    num_cells_y, cost_value::LETHAL_OBSTACLE, costmap_);
+}
 
 void OccupancyGridMapProjectiveBlindSpot::initRosParam(rclcpp::Node & node)
 {
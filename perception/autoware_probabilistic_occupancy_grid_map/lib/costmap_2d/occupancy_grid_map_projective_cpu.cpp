@@ -0,0 +1,309 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_projective_cpu.hpp"
+
+#include <omp.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace autoware::occupancy_grid_map
+{
+namespace costmap_2d::map_projective
+{
+
+static constexpr float RANGE_DISCRETIZATION_RESOLUTION = 0.001f;
+
+using utils::packElement;
+using utils::unpackRange;
+using utils::unpackValue;
+
+namespace
+{
+// As the kernel does, the range and the projected length of the obstacle are read from the raw
+// element
+bool isVisibleBeyondObstacle(
+  const std::uint64_t * raw_element, const float & scan_origin_z, const float & robot_pose_z)
+{
+  std::uint64_t raw_range_and_z = raw_element[2];
+  std::uint32_t raw_range_int = raw_range_and_z >> 32;
+  float raw_range = raw_range_int * RANGE_DISCRETIZATION_RESOLUTION;
+  float raw_world_z = unpackValue(raw_range_and_z);
+
+  std::uint64_t obstacle_range_and_pl = raw_element[3];
+  std::uint32_t obstacle_range_int = obstacle_range_and_pl >> 32;
+  float obstacle_range = obstacle_range_int * RANGE_DISCRETIZATION_RESOLUTION;
+  float obstacle_pl = unpackValue(obstacle_range_and_pl);
+
+  if (raw_range < obstacle_range) {
+    return false;
+  }
+
+  if (std::isinf(obstacle_pl)) {
+    return false;
+  }
+
+  // y = ax + b
+  const double a = -(scan_origin_z - robot_pose_z) / (obstacle_range + obstacle_pl);
+  const double b = scan_origin_z;
+  return raw_world_z > (a * raw_range + b);
+}
+
+template <typename ProjectionFunction>
+void prepareTensor(
+  const float * input_pointcloud, const std::size_t num_points, const std::size_t points_step,
+  const std::size_t angle_bins, const std::size_t range_bins, const float min_height,
+  const float max_height, const float min_angle, const float angle_increment_inv,
+  const float range_resolution_inv, const Eigen::Matrix3f & rotation_map,
+  const Eigen::Vector3f & translation_map, const Eigen::Matrix3f & rotation_scan,
+  const Eigen::Vector3f & translation_scan, const ProjectionFunction & project,
+  utils::PolarPointsTensor & points_tensor)
+{
+  points_tensor.resize(num_points, angle_bins);
+
+#pragma omp parallel for schedule(static)
+  for (std::size_t idx = 0; idx < num_points; ++idx) {
+    Eigen::Map<const Eigen::Vector3f> point(input_pointcloud + idx * points_step);
+
+    if (
+      point.z() > max_height || point.z() < min_height || !std::isfinite(point.x()) ||
+      !std::isfinite(point.y()) || !std::isfinite(point.z())) {
+      points_tensor.setInvalid(idx);
+      continue;
+    }
+
+    Eigen::Vector3f map_point = rotation_map * point + translation_map;
+    Eigen::Vector3f scan_point = rotation_scan * map_point + translation_scan;
+
+    float angle = std::atan2(scan_point.y(), scan_point.x());
+    int angle_bin_index = static_cast<int>((angle - min_angle) * angle_increment_inv);
+    float range = std::sqrt(scan_point.y() * scan_point.y() + scan_point.x() * scan_point.x());
+    int range_bin_index = static_cast<int>(range * range_resolution_inv);
+
+    if (
+      angle_bin_index < 0 || static_cast<std::size_t>(angle_bin_index) >= angle_bins ||
+      range_bin_index < 0 || static_cast<std::size_t>(range_bin_index) >= range_bins) {
+      points_tensor.setInvalid(idx);
+      continue;
+    }
+
+    // projected length, projected world x and y
+    float projection[3];
+    project(map_point, range, projection);
+
+    std::uint64_t range_int = static_cast<std::int64_t>(range / RANGE_DISCRETIZATION_RESOLUTION);
+    const std::uint64_t element[6] = {
+      packElement(range_int, map_point.x()), packElement(range_int, map_point.y()),
+      packElement(range_int, map_point.z()), packElement(range_int, projection[0]),
+      packElement(range_int, projection[1]), packElement(range_int, projection[2])};
+    points_tensor.setPoint(idx, angle_bin_index, range_bin_index, element);
+  }
+
+  points_tensor.build();
+}
+}  // namespace
+
+void prepareRawTensor(
+  const float * input_pointcloud, const std::size_t num_points, const std::size_t points_step,
+  const std::size_t angle_bins, const std::size_t range_bins, const float min_height,
+  const float max_height, const float min_angle, const float angle_increment_inv,
+  const float range_resolution_inv, const Eigen::Matrix3f & rotation_map,
+  const Eigen::Vector3f & translation_map, const Eigen::Matrix3f & rotation_scan,
+  const Eigen::Vector3f & translation_scan, utils::PolarPointsTensor & points_tensor)
+{
+  const auto project = [](const Eigen::Vector3f &, const float, float * projection) {
+    projection[0] = 0.f;
+    projection[1] = 0.f;
+    projection[2] = 0.f;
+  };
+
+  prepareTensor(
+    input_pointcloud, num_points, points_step, angle_bins, range_bins, min_height, max_height,
+    min_angle, angle_increment_inv, range_resolution_inv, rotation_map, translation_map,
+    rotation_scan, translation_scan, project, points_tensor);
+}
+
+void prepareObstacleTensor(
+  const float * input_pointcloud, const std::size_t num_points, const std::size_t points_step,
+  const std::size_t angle_bins, const std::size_t range_bins, const float min_height,
+  const float max_height, const float min_angle, const float angle_increment_inv,
+  const float range_resolution_inv, const float projection_dz_threshold,
+  const Eigen::Vector3f & translation_scan_origin, const Eigen::Matrix3f & rotation_map,
+  const Eigen::Vector3f & translation_map, const Eigen::Matrix3f & rotation_scan,
+  const Eigen::Vector3f & translation_scan, utils::PolarPointsTensor & points_tensor)
+{
+  const auto project = [&](
+                         const Eigen::Vector3f & map_point, const float range, float * projection) {
+    // The height of the scan origin is taken as is, as the kernel does
+    const float scan_z = translation_scan_origin.z();
+    const float obstacle_z = map_point.z() - translation_scan_origin.z();
+    const float dz = scan_z - obstacle_z;
+
+    if (dz > projection_dz_threshold) {
+      const float ratio = obstacle_z / dz;
+      projection[0] = range * ratio;
+      projection[1] = map_point.x() + (map_point.x() - translation_scan_origin.x()) * ratio;
+      projection[2] = map_point.y() + (map_point.y() - translation_scan_origin.y()) * ratio;
+    } else {
+      projection[0] = std::numeric_limits<float>::infinity();
+      projection[1] = std::numeric_limits<float>::infinity();
+      projection[2] = std::numeric_limits<float>::infinity();
+    }
+  };
+
+  prepareTensor(
+    input_pointcloud, num_points, points_step, angle_bins, range_bins, min_height, max_height,
+    min_angle, angle_increment_inv, range_resolution_inv, rotation_map, translation_map,
+    rotation_scan, translation_scan, project, points_tensor);
+}
+
+void fillUnknownSpace(
+  const utils::PolarPointsTensor & raw_points_tensor,
+  const utils::PolarPointsTensor & obstacle_points_tensor,
+  const float obstacle_separation_threshold, const std::size_t range_bins,
+  const float map_resolution_inv, const float scan_origin_z, const float map_origin_x,
+  const float map_origin_y, const float robot_pose_z, const int num_cells_x, const int num_cells_y,
+  std::uint8_t free_space_value, std::uint8_t no_information_value,
+  utils::cpu::ThreadBuffers & buffers, std::uint8_t * costmap_tensor)
+{
+  const auto angle_bins = static_cast<int>(obstacle_points_tensor.getNumOfAngleBins());
+  const auto last_range_bin_index = static_cast<std::uint32_t>(range_bins - 1);
+  buffers.segments.resize(omp_get_max_threads());
+  for (auto & segments : buffers.segments) {
+    segments.clear();
+  }
+
+  // The segments are collected in the order of the angle bins, and traced in the same order
+#pragma omp parallel
+  {
+    auto & segments = buffers.segments[omp_get_thread_num()];
+
+#pragma omp for schedule(static)
+    for (int angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+      const auto raw_end = raw_points_tensor.getEnd(angle_bin_index);
+      const auto obs_end = obstacle_points_tensor.getEnd(angle_bin_index);
+
+      // The search of the kernel ends at the last range bin, which is taken even if it does not
+      // satisfy the condition
+      const std::uint64_t * last_raw_element =
+        (raw_end > raw_points_tensor.getBegin(angle_bin_index) &&
+         raw_points_tensor.getRangeBin(raw_end - 1) == last_range_bin_index)
+          ? raw_points_tensor.getElement(raw_end - 1)
+          : nullptr;
+
+      auto raw_entry = raw_points_tensor.getBegin(angle_bin_index);
+      for (auto obs_entry = obstacle_points_tensor.getBegin(angle_bin_index); obs_entry < obs_end;
+           ++obs_entry) {
+        const auto range_bin_index = obstacle_points_tensor.getRangeBin(obs_entry);
+        if (range_bin_index == last_range_bin_index) {
+          continue;
+        }
+
+        const std::uint64_t * obs_element = obstacle_points_tensor.getElement(obs_entry);
+        std::uint32_t obs_range_int = unpackRange(obs_element[0]);
+        float obs_range = obs_range_int * RANGE_DISCRETIZATION_RESOLUTION;
+        float obs_world_x = unpackValue(obs_element[0]);
+        float obs_world_y = unpackValue(obs_element[1]);
+        float obs_world_px = unpackValue(obs_element[4]);
+        float obs_world_py = unpackValue(obs_element[5]);
+
+        if (obs_world_x < map_origin_x || obs_world_y < map_origin_y) {
+          continue;
+        }
+
+        while (raw_entry < raw_end && raw_points_tensor.getRangeBin(raw_entry) <= range_bin_index) {
+          ++raw_entry;
+        }
+
+        const std::uint64_t * next_raw_element = last_raw_element;
+        for (auto entry = raw_entry;
+             entry < raw_end && raw_points_tensor.getRangeBin(entry) < last_range_bin_index;
+             ++entry) {
+          if (isVisibleBeyondObstacle(
+                raw_points_tensor.getElement(entry), scan_origin_z, robot_pose_z)) {
+            next_raw_element = raw_points_tensor.getElement(entry);
+            break;
+          }
+        }
+
+        const std::uint64_t * next_obs_element =
+          obs_entry + 1 < obs_end ? obstacle_points_tensor.getElement(obs_entry + 1) : nullptr;
+
+        if (next_raw_element == nullptr || next_obs_element == nullptr) {
+          segments.push_back({obs_world_x, obs_world_y, obs_world_px, obs_world_py, false});
+          continue;
+        }
+
+        const float next_obs_world_x = unpackValue(next_obs_element[0]);
+        const float next_obs_world_y = unpackValue(next_obs_element[1]);
+        float next_obs_range = unpackRange(next_obs_element[0]) * RANGE_DISCRETIZATION_RESOLUTION;
+        float obs_to_obs_distance = next_obs_range - obs_range;
+
+        const float next_raw_world_x = unpackValue(next_raw_element[0]);
+        const float next_raw_world_y = unpackValue(next_raw_element[1]);
+        float next_raw_range = unpackRange(next_raw_element[0]) * RANGE_DISCRETIZATION_RESOLUTION;
+        float raw_to_obs_distance = std::abs(next_raw_range - obs_range);
+
+        if (obs_to_obs_distance <= obstacle_separation_threshold) {
+          continue;
+        }
+
+        if (raw_to_obs_distance < obs_to_obs_distance) {
+          if (next_raw_world_x < map_origin_x || next_raw_world_y < map_origin_y) {
+            continue;
+          }
+
+          segments.push_back({obs_world_x, obs_world_y, next_raw_world_x, next_raw_world_y, true});
+        } else {
+          // fill with no information between obstacles
+
+          if (next_obs_world_x < map_origin_x || next_obs_world_y < map_origin_y) {
+            continue;
+          }
+
+          segments.push_back(
+            {obs_world_x, obs_world_y, next_obs_world_x, next_obs_world_y, false});
+        }
+      }
+    }
+  }
+
+  utils::cpu::applyRaySegments(
+    buffers, map_origin_x, map_origin_y, map_resolution_inv, num_cells_x, num_cells_y,
+    free_space_value, no_information_value, costmap_tensor);
+}
+
+void fillObstacles(
+  const utils::PolarPointsTensor & obstacle_points_tensor, const float map_resolution_inv,
+  const float map_origin_x, const float map_origin_y, const int num_cells_x, const int num_cells_y,
+  std::uint8_t obstacle_value, std::uint8_t * costmap_tensor)
+{
+  // The kernel also traces from each obstacle to the element it reads as the next one, which is
+  // the obstacle itself, so only the cells of the obstacles are set
+  const auto angle_bins = obstacle_points_tensor.getNumOfAngleBins();
+  for (std::size_t angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+    const auto end = obstacle_points_tensor.getEnd(angle_bin_index);
+    for (auto entry = obstacle_points_tensor.getBegin(angle_bin_index); entry < end; ++entry) {
+      const std::uint64_t * element = obstacle_points_tensor.getElement(entry);
+      utils::cpu::setCellValue(
+        unpackValue(element[0]), unpackValue(element[1]), map_origin_x, map_origin_y,
+        map_resolution_inv, num_cells_x, num_cells_y, obstacle_value, costmap_tensor);
+    }
+  }
+}
+
+}  // namespace costmap_2d::map_projective
+}  // namespace autoware::occupancy_grid_map
@@ -47,6 +47,13 @@ void OccupancyGridMapBBFUpdater::initRosParam(rclcpp::Node & node)
     node.declare_parameter<double>("probability_matrix.free_to_occupied");
   v_ratio_ = node.declare_parameter<double>("v_ratio");
 
+  bbf_table_.resize(256 * 256);
+  for (unsigned int z = 0; z < 256; z++) {
+    for (unsigned int o = 0; o < 256; o++) {
+      bbf_table_[(z << 8) | o] = applyBBF(z, o);
+    }
+  }
+
 #ifdef USE_CUDA
   if (use_cuda_) {
     device_probability_matrix_ =
@@ -119,11 +126,12 @@ bool OccupancyGridMapBBFUpdater::update(
     return false;
 #endif
   } else {
-    for (unsigned int x = 0; x < getSizeInCellsX(); x++) {
-      for (unsigned int y = 0; y < getSizeInCellsY(); y++) {
-        unsigned int index = getIndex(x, y);
-        costmap_[index] = applyBBF(single_frame_occupancy_grid_map.getCost(x, y), costmap_[index]);
-      }
+    // The cells are updated in the order of the memory with the lookup table
+    const unsigned char * measurement = single_frame_occupancy_grid_map.getCharMap();
+    const unsigned char * table = bbf_table_.data();
+    const std::size_t num_cells = getSizeInCellsX() * getSizeInCellsY();
+    for (std::size_t index = 0; index < num_cells; index++) {
+      costmap_[index] = table[(measurement[index] << 8) | costmap_[index]];
     }
   }
 
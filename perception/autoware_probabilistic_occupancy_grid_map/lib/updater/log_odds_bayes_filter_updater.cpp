@@ -29,6 +29,19 @@ namespace autoware::occupancy_grid_map
 namespace costmap_2d
 {
 
+OccupancyGridMapLOBFUpdater::OccupancyGridMapLOBFUpdater(
+  const bool use_cuda, const unsigned int cells_size_x, const unsigned int cells_size_y,
+  const float resolution)
+: OccupancyGridMapUpdaterInterface(use_cuda, cells_size_x, cells_size_y, resolution)
+{
+  lobf_table_.resize(256 * 256);
+  for (unsigned int z = 0; z < 256; z++) {
+    for (unsigned int o = 0; o < 256; o++) {
+      lobf_table_[(z << 8) | o] = applyLOBF(z, o);
+    }
+  }
+}
+
 void OccupancyGridMapLOBFUpdater::initRosParam(rclcpp::Node & /*node*/)
 {
   // nothing to load
@@ -80,14 +93,15 @@ bool OccupancyGridMapLOBFUpdater::update(
 #else
   if (use_cuda_) {
     RCLCPP_ERROR(logger_, "The code was compiled without cuda.");
-    return;
+    return false;
 #endif
   } else {
-    for (unsigned int x = 0; x < getSizeInCellsX(); x++) {
-      for (unsigned int y = 0; y < getSizeInCellsY(); y++) {
-        unsigned int index = getIndex(x, y);
-        costmap_[index] = applyLOBF(single_frame_occupancy_grid_map.getCost(x, y), costmap_[index]);
-      }
+    // The cells are updated in the order of the memory with the lookup table
+    const unsigned char * measurement = single_frame_occupancy_grid_map.getCharMap();
+    const unsigned char * table = lobf_table_.data();
+    const std::size_t num_cells = getSizeInCellsX() * getSizeInCellsY();
+    for (std::size_t index = 0; index < num_cells; index++) {
+      costmap_[index] = table[(measurement[index] << 8) | costmap_[index]];
     }
   }
 
@@ -0,0 +1,110 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/probabilistic_occupancy_grid_map/utils/polar_points_tensor.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+
+namespace autoware::occupancy_grid_map
+{
+namespace utils
+{
+
+void PolarPointsTensor::resize(const std::size_t num_points, const std::size_t angle_bins)
+{
+  point_angle_bins_.resize(num_points);
+  point_range_bins_.resize(num_points);
+  point_elements_.resize(num_points * stride_);
+  angle_offsets_.resize(angle_bins + 1);
+  bin_counts_.resize(angle_bins);
+}
+
+void PolarPointsTensor::build()
+{
+  const std::size_t num_points = point_angle_bins_.size();
+  const std::size_t angle_bins = bin_counts_.size();
+  sort_keys_.resize(num_points);
+  range_bins_.resize(num_points);
+  elements_.resize(num_points * stride_);
+  thread_counts_.assign(static_cast<std::size_t>(omp_get_max_threads()) * angle_bins, 0);
+
+#pragma omp parallel
+  {
+    const auto num_threads = static_cast<std::size_t>(omp_get_num_threads());
+    const auto thread_index = static_cast<std::size_t>(omp_get_thread_num());
+    const std::size_t points_begin = num_points * thread_index / num_threads;
+    const std::size_t points_end = num_points * (thread_index + 1) / num_threads;
+    std::size_t * counts = thread_counts_.data() + thread_index * angle_bins;
+
+    for (std::size_t i = points_begin; i < points_end; ++i) {
+      if (point_angle_bins_[i] != invalid_bin) {
+        ++counts[point_angle_bins_[i]];
+      }
+    }
+
+#pragma omp barrier
+#pragma omp single
+    {
+      // The offsets are given in the order of (angle bin, thread)
+      std::size_t offset = 0;
+      for (std::size_t angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+        angle_offsets_[angle_bin_index] = offset;
+        for (std::size_t t = 0; t < num_threads; ++t) {
+          const std::size_t count = thread_counts_[t * angle_bins + angle_bin_index];
+          thread_counts_[t * angle_bins + angle_bin_index] = offset;
+          offset += count;
+        }
+      }
+      angle_offsets_[angle_bins] = offset;
+    }
+
+    for (std::size_t i = points_begin; i < points_end; ++i) {
+      if (point_angle_bins_[i] != invalid_bin) {
+        sort_keys_[counts[point_angle_bins_[i]]++] =
+          (static_cast<std::uint64_t>(point_range_bins_[i]) << 32) | i;
+      }
+    }
+
+#pragma omp barrier
+#pragma omp for schedule(dynamic, 64)
+    for (std::size_t angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+      const auto first = sort_keys_.begin() + angle_offsets_[angle_bin_index];
+      const auto last = sort_keys_.begin() + angle_offsets_[angle_bin_index + 1];
+      std::sort(first, last);
+
+      // Reduce the points of each bin, taking the minimum of each value as atomicMin does
+      std::size_t entry = angle_offsets_[angle_bin_index];
+      for (auto it = first; it != last; ++entry) {
+        const auto range_bin_index = static_cast<std::uint32_t>(*it >> 32);
+        std::uint64_t * element = elements_.data() + entry * stride_;
+        const std::uint64_t * point_element =
+          point_elements_.data() + (*it & 0xFFFFFFFF) * stride_;
+        std::copy(point_element, point_element + stride_, element);
+        for (++it; it != last && static_cast<std::uint32_t>(*it >> 32) == range_bin_index; ++it) {
+          point_element = point_elements_.data() + (*it & 0xFFFFFFFF) * stride_;
+          for (std::size_t k = 0; k < stride_; ++k) {
+            element[k] = std::min(element[k], point_element[k]);
+          }
+        }
+        range_bins_[entry] = range_bin_index;
+      }
+      bin_counts_[angle_bin_index] = entry - angle_offsets_[angle_bin_index];
+    }
+  }
+}
+
+}  // namespace utils
+}  // namespace autoware::occupancy_grid_map
@@ -0,0 +1,298 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2008, 2013, Willow Garage, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Author: Eitan Marder-Eppstein
+ *         David V. Lu!!
+ *********************************************************************/
+
+#include "autoware/probabilistic_occupancy_grid_map/utils/utils_cpu.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace autoware::occupancy_grid_map
+{
+namespace utils::cpu
+{
+
+inline bool worldToMap(
+  float wx, float wy, unsigned int & mx, unsigned int & my, float origin_x, float origin_y,
+  float resolution_inv, int size_x, int size_y)
+{
+  if (wx < origin_x || wy < origin_y) {
+    return false;
+  }
+
+  mx = static_cast<int>(std::floor((wx - origin_x) * resolution_inv));
+  my = static_cast<int>(std::floor((wy - origin_y) * resolution_inv));
+
+  if (mx < static_cast<unsigned int>(size_x) && my < static_cast<unsigned int>(size_y)) {
+    return true;
+  }
+
+  return false;
+}
+
+void setCellValue(
+  float wx, float wy, float origin_x, float origin_y, float resolution_inv, int size_x, int size_y,
+  std::uint8_t value, std::uint8_t * costmap_tensor)
+{
+  unsigned int mx, my;
+  if (!worldToMap(wx, wy, mx, my, origin_x, origin_y, resolution_inv, size_x, size_y)) {
+    return;
+  }
+
+  costmap_tensor[my * size_x + mx] = value;
+}
+
+inline void bresenham2D(
+  unsigned int abs_da, unsigned int abs_db, int error_b, int offset_a, int offset_b,
+  unsigned int offset, unsigned int max_length, std::uint8_t cost, std::uint8_t * costmap_tensor)
+{
+  unsigned int end = std::min(max_length, abs_da);
+  for (unsigned int i = 0; i < end; ++i) {
+    costmap_tensor[offset] = cost;
+    offset += offset_a;
+    error_b += abs_db;
+    if ((unsigned int)error_b >= abs_da) {
+      offset += offset_b;
+      error_b -= abs_da;
+    }
+  }
+  costmap_tensor[offset] = cost;
+}
+
+/**
+ * @brief  Raytrace a line and apply some action at each step
+ * @param  x0 The starting x coordinate
+ * @param  y0 The starting y coordinate
+ * @param  x1 The ending x coordinate
+ * @param  y1 The ending y coordinate
+ * @param  max_length The maximum desired length of the segment...
+ * allows you to not go all the way to the endpoint
+ */
+inline void raytraceLine(
+  unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, unsigned int max_length,
+  unsigned int size_x, std::uint8_t cost, std::uint8_t * costmap_tensor)
+{
+  int dx = x1 - x0;
+  int dy = y1 - y0;
+
+  unsigned int abs_dx = std::abs(dx);
+  unsigned int abs_dy = std::abs(dy);
+
+  int offset_dx = dx > 0 ? 1 : -1;                              // sign(dx);
+  int offset_dy = static_cast<int>(dy > 0 ? size_x : -size_x);  // sign(dy) * size_x;
+
+  unsigned int offset = y0 * size_x + x0;
+
+  // we need to chose how much to scale our dominant dimension,
+  // based on the maximum length of the line
+  float dist = std::sqrt(static_cast<float>(dx * dx + dy * dy));  // hypot(dx, dy);
+  constexpr float epsilon = 1e-6;
+  float scale = (dist < epsilon) ? 1.0 : std::min(1.f, max_length / dist);
+  // if x is dominant
+  if (abs_dx >= abs_dy) {
+    int error_y = abs_dx / 2;
+
+    bresenham2D(
+      abs_dx, abs_dy, error_y, offset_dx, offset_dy, offset, (unsigned int)(scale * abs_dx), cost,
+      costmap_tensor);
+    return;
+  }
+
+  // otherwise y is dominant
+  int error_x = abs_dy / 2;
+
+  bresenham2D(
+    abs_dy, abs_dx, error_x, offset_dy, offset_dx, offset, (unsigned int)(scale * abs_dy), cost,
+    costmap_tensor);
+}
+
+void raytrace(
+  const float source_x, const float source_y, const float target_x, const float target_y,
+  const float origin_x, float origin_y, const float resolution_inv, const int size_x,
+  const int size_y, const std::uint8_t cost, std::uint8_t * costmap_tensor)
+{
+  // The projected points of the projective map may be infinite, which can not be clipped
+  if (!std::isfinite(target_x) || !std::isfinite(target_y)) {
+    return;
+  }
+
+  unsigned int x0{};
+  unsigned int y0{};
+  const float ox{source_x};
+  const float oy{source_y};
+
+  if (!worldToMap(ox, oy, x0, y0, origin_x, origin_y, resolution_inv, size_x, size_y)) {
+    return;
+  }
+
+  // we can pre-compute the endpoints of the map outside of the inner loop... we'll need these later
+  const float resolution = 1.0 / resolution_inv;
+  const float map_end_x = origin_x + size_x * resolution;
+  const float map_end_y = origin_y + size_y * resolution;
+
+  float wx = target_x;
+  float wy = target_y;
+
+  // now we also need to make sure that the endpoint we're ray-tracing
+  // to isn't off the costmap and scale if necessary
+  const float a = wx - ox;
+  const float b = wy - oy;
+
+  // the minimum value to raytrace from is the origin
+  if (wx < origin_x) {
+    const float t = (origin_x - ox) / a;
+    wx = origin_x;
+    wy = oy + b * t;
+  }
+  if (wy < origin_y) {
+    const float t = (origin_y - oy) / b;
+    wx = ox + a * t;
+    wy = origin_y;
+  }
+
+  // the maximum value to raytrace to is the end of the map
+  if (wx > map_end_x) {
+    const float t = (map_end_x - ox) / a;
+    wx = map_end_x - .001;
+    wy = oy + b * t;
+  }
+  if (wy > map_end_y) {
+    const float t = (map_end_y - oy) / b;
+    wx = ox + a * t;
+    wy = map_end_y - .001;
+  }
+
+  // now that the vector is scaled correctly... we'll get the map coordinates of its endpoint
+  unsigned int x1{};
+  unsigned int y1{};
+
+  // check for legality just in case
+  if (!worldToMap(wx, wy, x1, y1, origin_x, origin_y, resolution_inv, size_x, size_y)) {
+    return;
+  }
+
+  constexpr unsigned int cell_raytrace_range = 10000;  // large number to ignore range threshold
+  raytraceLine(x0, y0, x1, y1, cell_raytrace_range, size_x, cost, costmap_tensor);
+}
+
+void fillEmptySpace(
+  const PolarPointsTensor & points_tensor, const float map_resolution_inv,
+  const float scan_origin_x, const float scan_origin_y, const float map_origin_x,
+  const float map_origin_y, const int num_cells_x, const int num_cells_y,
+  const std::uint8_t empty_value, ThreadBuffers & buffers, std::uint8_t * costmap_tensor)
+{
+  const std::size_t num_cells = static_cast<std::size_t>(num_cells_x) * num_cells_y;
+  const auto angle_bins = static_cast<int>(points_tensor.getNumOfAngleBins());
+  buffers.costmaps.resize(static_cast<std::size_t>(omp_get_max_threads()) * num_cells);
+
+  // The traced cells are marked with 1 in the costmap of each thread
+#pragma omp parallel
+  {
+    const auto num_threads = omp_get_num_threads();
+    std::uint8_t * thread_costmap =
+      buffers.costmaps.data() + static_cast<std::size_t>(omp_get_thread_num()) * num_cells;
+    std::fill(thread_costmap, thread_costmap + num_cells, 0);
+
+#pragma omp for schedule(dynamic, 16)
+    for (int angle_bin_index = 0; angle_bin_index < angle_bins; ++angle_bin_index) {
+      const auto end = points_tensor.getEnd(angle_bin_index);
+      for (auto entry = points_tensor.getBegin(angle_bin_index); entry < end; ++entry) {
+        const std::uint64_t * element = points_tensor.getElement(entry);
+        const float world_x = unpackValue(element[0]);
+        const float world_y = unpackValue(element[1]);
+
+        if (world_x < map_origin_x || world_y < map_origin_y) {
+          continue;
+        }
+
+        raytrace(
+          scan_origin_x, scan_origin_y, world_x, world_y, map_origin_x, map_origin_y,
+          map_resolution_inv, num_cells_x, num_cells_y, 1, thread_costmap);
+      }
+    }
+
+#pragma omp for schedule(static)
+    for (std::size_t i = 0; i < num_cells; ++i) {
+      std::uint8_t is_traced = 0;
+      for (int t = 0; t < num_threads; ++t) {
+        is_traced |= buffers.costmaps[t * num_cells + i];
+      }
+      costmap_tensor[i] = is_traced ? empty_value : costmap_tensor[i];
+    }
+  }
+}
+
+void applyRaySegments(
+  const ThreadBuffers & buffers, const float map_origin_x, const float map_origin_y,
+  const float map_resolution_inv, const int num_cells_x, const int num_cells_y,
+  const std::uint8_t free_space_value, const std::uint8_t no_information_value,
+  std::uint8_t * costmap_tensor)
+{
+  for (const auto & segments : buffers.segments) {
+    for (const auto & segment : segments) {
+      raytrace(
+        segment.source_x, segment.source_y, segment.target_x, segment.target_y, map_origin_x,
+        map_origin_y, map_resolution_inv, num_cells_x, num_cells_y, no_information_value,
+        costmap_tensor);
+
+      if (segment.is_target_free) {
+        setCellValue(
+          segment.target_x, segment.target_y, map_origin_x, map_origin_y, map_resolution_inv,
+          num_cells_x, num_cells_y, free_space_value, costmap_tensor);
+      }
+    }
+  }
+}
+
+}  // namespace utils::cpu
+}  // namespace autoware::occupancy_grid_map
@@ -41,6 +41,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 
 namespace autoware::occupancy_grid_map
 {
@@ -50,6 +51,12 @@ using costmap_2d::OccupancyGridMapFixedBlindSpot;
 using costmap_2d::OccupancyGridMapProjectiveBlindSpot;
 using geometry_msgs::msg::Pose;
 
+#ifdef USE_CUDA
+static constexpr bool use_cuda = true;
+#else
+static constexpr bool use_cuda = false;
+#endif
+
 PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
   const rclcpp::NodeOptions & node_options)
 : Node("pointcloud_based_occupancy_grid_map_node", node_options)
@@ -84,26 +91,26 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
   const std::string updater_type = this->declare_parameter<std::string>("updater_type");
   if (updater_type == "binary_bayes_filter") {
     occupancy_grid_map_updater_ptr_ = std::make_unique<OccupancyGridMapBBFUpdater>(
-      true, map_length / map_resolution, map_length / map_resolution, map_resolution);
+      use_cuda, map_length / map_resolution, map_length / map_resolution, map_resolution);
   } else {
     RCLCPP_WARN(
       get_logger(),
       "specified occupancy grid map updater type [%s] is not found, use binary_bayes_filter",
       updater_type.c_str());
     occupancy_grid_map_updater_ptr_ = std::make_unique<OccupancyGridMapBBFUpdater>(
-      true, map_length / map_resolution, map_length / map_resolution, map_resolution);
+      use_cuda, map_length / map_resolution, map_length / map_resolution, map_resolution);
   }
 
   const std::string grid_map_type = this->declare_parameter<std::string>("grid_map_type");
 
   if (grid_map_type == "OccupancyGridMapProjectiveBlindSpot") {
     occupancy_grid_map_ptr_ = std::make_unique<OccupancyGridMapProjectiveBlindSpot>(
-      true, occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
+      use_cuda, occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
       occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
       occupancy_grid_map_updater_ptr_->getResolution());
   } else if (grid_map_type == "OccupancyGridMapFixedBlindSpot") {
     occupancy_grid_map_ptr_ = std::make_unique<OccupancyGridMapFixedBlindSpot>(
-      true, occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
+      use_cuda, occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
       occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
       occupancy_grid_map_updater_ptr_->getResolution());
   } else {
@@ -112,11 +119,12 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
       "specified occupancy grid map type [%s] is not found, use OccupancyGridMapFixedBlindSpot",
       grid_map_type.c_str());
     occupancy_grid_map_ptr_ = std::make_unique<OccupancyGridMapFixedBlindSpot>(
-      true, occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
+      use_cuda, occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
       occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
       occupancy_grid_map_updater_ptr_->getResolution());
   }
 
+#ifdef USE_CUDA
   cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking);
   raw_pointcloud_.stream = stream_;
   obstacle_pointcloud_.stream = stream_;
@@ -125,6 +133,7 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
 
   device_rotation_ = autoware::cuda_utils::make_unique<Eigen::Matrix3f>();
   device_translation_ = autoware::cuda_utils::make_unique<Eigen::Vector3f>();
+#endif
 
   occupancy_grid_map_ptr_->initRosParam(*this);
   occupancy_grid_map_updater_ptr_->initRosParam(*this);
@@ -160,7 +169,11 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
 void PointcloudBasedOccupancyGridMapNode::obstaclePointcloudCallback(
   const PointCloud2::ConstSharedPtr & input_obstacle_msg)
 {
+#ifdef USE_CUDA
   obstacle_pointcloud_.fromROSMsgAsync(input_obstacle_msg);
+#else
+  obstacle_pointcloud_ = *input_obstacle_msg;
+#endif
 
   if (obstacle_pointcloud_.header.stamp == raw_pointcloud_.header.stamp) {
     onPointcloudWithObstacleAndRaw();
@@ -170,7 +183,11 @@ void PointcloudBasedOccupancyGridMapNode::obstaclePointcloudCallback(
 void PointcloudBasedOccupancyGridMapNode::rawPointcloudCallback(
   const PointCloud2::ConstSharedPtr & input_raw_msg)
 {
+#ifdef USE_CUDA
   raw_pointcloud_.fromROSMsgAsync(input_raw_msg);
+#else
+  raw_pointcloud_ = *input_raw_msg;
+#endif
 
   if (obstacle_pointcloud_.header.stamp == raw_pointcloud_.header.stamp) {
     onPointcloudWithObstacleAndRaw();
@@ -244,6 +261,7 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw()
   // Prepare for applying height filter
   if (use_height_filter_) {
     // Make sure that the frame is base_link
+#ifdef USE_CUDA
     if (raw_pointcloud_.header.frame_id != base_link_frame_) {
       if (!utils::transformPointcloudAsync(
             raw_pointcloud_, *tf2_, base_link_frame_, device_rotation_, device_translation_)) {
@@ -256,6 +274,22 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw()
         return;
       }
     }
+#else
+    if (raw_pointcloud_.header.frame_id != base_link_frame_) {
+      if (!utils::transformPointcloud(
+            raw_pointcloud_, *tf2_, base_link_frame_, transformed_pointcloud_)) {
+        return;
+      }
+      std::swap(raw_pointcloud_, transformed_pointcloud_);
+    }
+    if (obstacle_pointcloud_.header.frame_id != base_link_frame_) {
+      if (!utils::transformPointcloud(
+            obstacle_pointcloud_, *tf2_, base_link_frame_, transformed_pointcloud_)) {
+        return;
+      }
+      std::swap(obstacle_pointcloud_, transformed_pointcloud_);
+    }
+#endif
     occupancy_grid_map_ptr_->setHeightLimit(min_height_, max_height_);
   } else {
     occupancy_grid_map_ptr_->setHeightLimit(
@@ -296,7 +330,9 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw()
     if (time_keeper_)
       inner_st_ptr = std::make_unique<ScopedTimeTrack>("publish_occupancy_grid_map", *time_keeper_);
 
+#ifdef USE_CUDA
     occupancy_grid_map_ptr_->copyDeviceCostmapToHost();
+#endif
 
     // publish
     occupancy_grid_map_pub_->publish(OccupancyGridMapToMsgPtr(
@@ -310,7 +346,9 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw()
 
     // Update with bayes filter
     occupancy_grid_map_updater_ptr_->update(*occupancy_grid_map_ptr_);
+#ifdef USE_CUDA
     occupancy_grid_map_updater_ptr_->copyDeviceCostmapToHost();
+#endif
 
     // publish
     occupancy_grid_map_pub_->publish(OccupancyGridMapToMsgPtr(
@@ -18,7 +18,9 @@
 #include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_base.hpp"
 #include "autoware/probabilistic_occupancy_grid_map/updater/binary_bayes_filter_updater.hpp"
 #include "autoware/probabilistic_occupancy_grid_map/updater/ogm_updater_interface.hpp"
+#ifdef USE_CUDA
 #include "autoware/probabilistic_occupancy_grid_map/utils/cuda_pointcloud.hpp"
+#endif
 
 #include <autoware_utils/ros/debug_publisher.hpp>
 #include <autoware_utils/ros/diagnostics_interface.hpp>
@@ -31,7 +33,9 @@
 #include <sensor_msgs/msg/laser_scan.hpp>
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#ifdef USE_CUDA
 #include <cuda_runtime.h>
+#endif
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
@@ -79,12 +83,18 @@ private:
   std::unique_ptr<OccupancyGridMapInterface> occupancy_grid_map_ptr_;
   std::unique_ptr<OccupancyGridMapUpdaterInterface> occupancy_grid_map_updater_ptr_;
 
+#ifdef USE_CUDA
   cudaStream_t stream_;
   CudaPointCloud2 raw_pointcloud_;
   CudaPointCloud2 obstacle_pointcloud_;
 
   autoware::cuda_utils::CudaUniquePtr<Eigen::Matrix3f> device_rotation_;
   autoware::cuda_utils::CudaUniquePtr<Eigen::Vector3f> device_translation_;
+#else
+  PointCloud2 raw_pointcloud_;
+  PointCloud2 obstacle_pointcloud_;
+  PointCloud2 transformed_pointcloud_;
+#endif
 
   // ROS Parameters
   std::string map_frame_;
@@ -0,0 +1,183 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/probabilistic_occupancy_grid_map/cost_value/cost_value.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed_cpu.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_projective_cpu.hpp"
+
+#include <Eigen/Core>
+
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Measure one update of the single frame map by the cpu implementation with a cloud of 200k points
+// in a 150m x 150m grid of 0.5m, which is the size of the pointcloud based map in the default
+// configuration. The number of threads is given by OMP_NUM_THREADS.
+
+namespace
+{
+using autoware::occupancy_grid_map::cost_value::FREE_SPACE;
+using autoware::occupancy_grid_map::cost_value::LETHAL_OBSTACLE;
+using autoware::occupancy_grid_map::cost_value::NO_INFORMATION;
+namespace map_fixed = autoware::occupancy_grid_map::costmap_2d::map_fixed;
+namespace map_projective = autoware::occupancy_grid_map::costmap_2d::map_projective;
+namespace utils = autoware::occupancy_grid_map::utils;
+
+constexpr std::size_t points_step = 4;  // x, y, z, intensity
+
+// Ground points on rings around the sensor and obstacle points on walls of boxes, as a lidar with
+// 128 channels would see them
+void makeClouds(std::vector<float> & raw_cloud, std::vector<float> & obstacle_cloud)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> angle_distribution(-M_PI, M_PI);
+  std::uniform_real_distribution<float> noise_distribution(-0.05f, 0.05f);
+
+  constexpr std::size_t num_raw_points = 200000;
+  constexpr std::size_t num_boxes = 200;
+  std::vector<Eigen::Vector3f> boxes;  // center x, center y, half size
+  std::uniform_real_distribution<float> position_distribution(-70.0f, 70.0f);
+  std::uniform_real_distribution<float> size_distribution(0.5f, 3.0f);
+  for (std::size_t i = 0; i < num_boxes; ++i) {
+    boxes.emplace_back(
+      position_distribution(engine), position_distribution(engine), size_distribution(engine));
+  }
+
+  for (std::size_t i = 0; i < num_raw_points; ++i) {
+    const float angle = angle_distribution(engine);
+    const float range = 3.0f + 0.6f * static_cast<float>(i % 128);
+    float x = range * std::cos(angle);
+    float y = range * std::sin(angle);
+    float z = noise_distribution(engine);
+    bool is_obstacle = false;
+    for (const auto & box : boxes) {
+      if (std::abs(x - box.x()) < box.z() && std::abs(y - box.y()) < box.z()) {
+        z = 0.2f + 1.5f * std::abs(noise_distribution(engine)) * 20.0f;
+        is_obstacle = true;
+        break;
+      }
+    }
+    const float point[points_step] = {x, y, z, 0.0f};
+    raw_cloud.insert(raw_cloud.end(), point, point + points_step);
+    if (is_obstacle) {
+      obstacle_cloud.insert(obstacle_cloud.end(), point, point + points_step);
+    }
+  }
+}
+}  // namespace
+
+int main()
+{
+  std::vector<float> raw_cloud;
+  std::vector<float> obstacle_cloud;
+  makeClouds(raw_cloud, obstacle_cloud);
+  const std::size_t num_raw_points = raw_cloud.size() / points_step;
+  const std::size_t num_obstacle_points = obstacle_cloud.size() / points_step;
+
+  const float map_length = 150.0f;
+  const float map_resolution = 0.5f;
+  const int num_cells = static_cast<int>(map_length / map_resolution);
+  const float map_origin = -map_length / 2.0f;
+  const float min_angle = -M_PI;
+  const float angle_increment_inv = 1.0f / (0.1f * M_PI / 180.0f);
+  const std::size_t angle_bins = static_cast<std::size_t>(2.0f * M_PI * angle_increment_inv) + 1;
+  const std::size_t range_bins = static_cast<std::size_t>(std::sqrt(2) * num_cells / 2.0) + 1;
+  const float resolution_inv = 1.0f / map_resolution;
+
+  // The sensor is at 2m above the origin of the map, which is base_link
+  const Eigen::Matrix3f rotation = Eigen::Matrix3f::Identity();
+  const Eigen::Vector3f translation_map = Eigen::Vector3f::Zero();
+  const Eigen::Vector3f scan_origin(0.0f, 0.0f, 2.0f);
+  const Eigen::Vector3f translation_scan = -scan_origin;
+
+  utils::PolarPointsTensor raw_tensor(2);
+  utils::PolarPointsTensor obstacle_tensor(2);
+  utils::PolarPointsTensor raw_projective_tensor(6);
+  utils::PolarPointsTensor obstacle_projective_tensor(6);
+  utils::cpu::ThreadBuffers buffers;
+  std::vector<std::uint8_t> costmap(num_cells * num_cells);
+
+  const auto update_fixed = [&]() {
+    std::fill(costmap.begin(), costmap.end(), NO_INFORMATION);
+    map_fixed::prepareTensor(
+      raw_cloud.data(), num_raw_points, points_step, angle_bins, range_bins, -1.0f, 2.0f,
+      min_angle, angle_increment_inv, resolution_inv, rotation, translation_map, rotation,
+      translation_scan, raw_tensor);
+    map_fixed::prepareTensor(
+      obstacle_cloud.data(), num_obstacle_points, points_step, angle_bins, range_bins, -1.0f,
+      2.0f, min_angle, angle_increment_inv, resolution_inv, rotation, translation_map, rotation,
+      translation_scan, obstacle_tensor);
+    utils::cpu::fillEmptySpace(
+      raw_tensor, resolution_inv, scan_origin.x(), scan_origin.y(), map_origin, map_origin,
+      num_cells, num_cells, FREE_SPACE, buffers, costmap.data());
+    map_fixed::fillUnknownSpace(
+      raw_tensor, obstacle_tensor, 1.0f, range_bins, resolution_inv, map_origin, map_origin,
+      num_cells, num_cells, FREE_SPACE, NO_INFORMATION, buffers, costmap.data());
+    map_fixed::fillObstacles(
+      obstacle_tensor, resolution_inv, map_origin, map_origin, num_cells, num_cells,
+      LETHAL_OBSTACLE, costmap.data());
+  };
+
+  const auto update_projective = [&]() {
+    std::fill(costmap.begin(), costmap.end(), NO_INFORMATION);
+    map_projective::prepareRawTensor(
+      raw_cloud.data(), num_raw_points, points_step, angle_bins, range_bins, -1.0f, 2.0f,
+      min_angle, angle_increment_inv, resolution_inv, rotation, translation_map, rotation,
+      translation_scan, raw_projective_tensor);
+    map_projective::prepareObstacleTensor(
+      obstacle_cloud.data(), num_obstacle_points, points_step, angle_bins, range_bins, -1.0f,
+      2.0f, min_angle, angle_increment_inv, resolution_inv, 0.01f, scan_origin, rotation,
+      translation_map, rotation, translation_scan, obstacle_projective_tensor);
+    utils::cpu::fillEmptySpace(
+      raw_projective_tensor, resolution_inv, scan_origin.x(), scan_origin.y(), map_origin,
+      map_origin, num_cells, num_cells, FREE_SPACE, buffers, costmap.data());
+    map_projective::fillUnknownSpace(
+      raw_projective_tensor, obstacle_projective_tensor, 1.0f, range_bins, resolution_inv,
+      scan_origin.z(), map_origin, map_origin, 0.0f, num_cells, num_cells, FREE_SPACE,
+      NO_INFORMATION, buffers, costmap.data());
+    map_projective::fillObstacles(
+      obstacle_projective_tensor, resolution_inv, map_origin, map_origin, num_cells, num_cells,
+      LETHAL_OBSTACLE, costmap.data());
+  };
+
+  constexpr int iterations = 50;
+  const auto measure = [&](const auto & update) {
+    update();  // warm up the buffers
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      update();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+             .count() /
+           iterations;
+  };
+
+  const double fixed_ms = measure(update_fixed);
+  const double projective_ms = measure(update_projective);
+
+  std::cout << "threads: " << omp_get_max_threads() << ", raw points: " << num_raw_points
+            << ", obstacle points: " << num_obstacle_points << ", cells: " << num_cells << "x"
+            << num_cells << std::endl;
+  std::cout << "OccupancyGridMapFixedBlindSpot: " << fixed_ms << " ms/update" << std::endl;
+  std::cout << "OccupancyGridMapProjectiveBlindSpot: " << projective_ms << " ms/update"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,362 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/probabilistic_occupancy_grid_map/cost_value/cost_value.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/costmap_2d/occupancy_grid_map_fixed_cpu.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/fusion_policy/fusion_policy.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/updater/binary_bayes_filter_updater.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/updater/log_odds_bayes_filter_updater.hpp"
+#include "autoware/probabilistic_occupancy_grid_map/utils/utils_cpu.hpp"
+
+#include <Eigen/Core>
+#include <rclcpp/rclcpp.hpp>
+
+#include <geometry_msgs/msg/pose.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// The cpu implementation against the implementations it replaces: the updaters applying the
+// filters cell by cell, and the ray tracing of the laserscan based map with nav2_costmap_2d.
+
+// cspell: ignore LOBF
+
+namespace
+{
+using autoware::occupancy_grid_map::cost_value::FREE_SPACE;
+using autoware::occupancy_grid_map::cost_value::LETHAL_OBSTACLE;
+using autoware::occupancy_grid_map::cost_value::NO_INFORMATION;
+using autoware::occupancy_grid_map::costmap_2d::OccupancyGridMap;
+using autoware::occupancy_grid_map::costmap_2d::OccupancyGridMapBBFUpdater;
+using autoware::occupancy_grid_map::costmap_2d::OccupancyGridMapLOBFUpdater;
+namespace map_fixed = autoware::occupancy_grid_map::costmap_2d::map_fixed;
+namespace utils = autoware::occupancy_grid_map::utils;
+
+// config/binary_bayes_filter_updater.param.yaml
+constexpr double occupied_to_occupied = 0.95;
+constexpr double occupied_to_free = 0.05;
+constexpr double free_to_occupied = 0.2;
+constexpr double free_to_free = 0.8;
+constexpr double v_ratio = 0.1;
+
+// OccupancyGridMapBBFUpdater::applyBBF() before the lookup table
+unsigned char referenceBBF(const unsigned char z, const unsigned char o)
+{
+  constexpr float cost2p = 1.f / 255.f;
+  const float po = o * cost2p;
+  float pz{};
+  float not_pz{};
+  float po_hat{};
+  if (z == LETHAL_OBSTACLE) {
+    pz = static_cast<float>(occupied_to_occupied);
+    not_pz = static_cast<float>(occupied_to_free);
+    po_hat = ((po * pz) / ((po * pz) + ((1.f - po) * not_pz)));
+  } else if (z == FREE_SPACE) {
+    pz = 1.f - static_cast<float>(free_to_free);
+    not_pz = 1.f - static_cast<float>(free_to_occupied);
+    po_hat = ((po * pz) / ((po * pz) + ((1.f - po) * not_pz)));
+  } else if (z == NO_INFORMATION) {
+    const float inv_v_ratio = 1.f / v_ratio;
+    po_hat = ((po + (0.5f * inv_v_ratio)) / ((1.f * inv_v_ratio) + 1.f));
+  }
+  return std::min(
+    std::max(
+      static_cast<unsigned char>(std::lround(po_hat * 255.f)), static_cast<unsigned char>(1)),
+    static_cast<unsigned char>(254));
+}
+
+// OccupancyGridMapLOBFUpdater::applyLOBF() before the lookup table
+unsigned char referenceLOBF(const unsigned char z, const unsigned char o)
+{
+  using autoware::occupancy_grid_map::fusion_policy::convertCharToProbability;
+  using autoware::occupancy_grid_map::fusion_policy::convertProbabilityToChar;
+  using autoware::occupancy_grid_map::fusion_policy::log_odds_fusion::logOddsFusion;
+
+  constexpr unsigned char unknown = NO_INFORMATION;
+  constexpr unsigned char unknown_margin = 1;
+  constexpr double tau = 0.75;
+  constexpr double sample_time = 0.1;
+
+  if (z >= unknown - unknown_margin && z <= unknown + unknown_margin) {
+    char diff = static_cast<char>(o) - static_cast<char>(unknown);
+    const double decay = std::exp(-sample_time / tau);
+    const double fused = static_cast<double>(unknown) + static_cast<double>(diff) * decay;
+    return static_cast<unsigned char>(fused);
+  }
+  const std::vector<double> probability = {
+    convertCharToProbability(z), convertCharToProbability(o)};
+  return convertProbabilityToChar(logOddsFusion(probability));
+}
+
+// A 256 x 256 measurement where the cell (x, y) has the value x, so that the updater gets every
+// pair of the measurement and its prior y
+constexpr unsigned int num_values = 256;
+
+void setAllPairs(OccupancyGridMap & measurement, nav2_costmap_2d::Costmap2D & updater)
+{
+  for (unsigned int y = 0; y < num_values; ++y) {
+    for (unsigned int x = 0; x < num_values; ++x) {
+      measurement.getCharMap()[measurement.getIndex(x, y)] = static_cast<unsigned char>(x);
+      updater.getCharMap()[updater.getIndex(x, y)] = static_cast<unsigned char>(y);
+    }
+  }
+}
+
+// The geometry of the maps of the ray tracing tests
+constexpr unsigned int num_cells = 200;
+constexpr float resolution = 0.5f;
+constexpr float map_origin = -50.0f;
+constexpr float map_end = map_origin + num_cells * resolution;
+
+float cellCenter(const int index)
+{
+  return map_origin + (static_cast<float>(index) + 0.5f) * resolution;
+}
+
+// Points inside the map away from the borders of their cells, and points outside whose ray leaves
+// the map through the middle of a border cell, so that the single and double precision clipping
+// of the rays give the same cells
+std::vector<Eigen::Vector2f> createTargets(
+  const Eigen::Vector2f & source, const std::size_t num_points, std::mt19937 & engine)
+{
+  std::uniform_int_distribution<int> cell_distribution(0, num_cells - 1);
+  std::uniform_real_distribution<float> offset_distribution(-0.3f * resolution, 0.3f * resolution);
+  std::uniform_real_distribution<float> scale_distribution(1.05f, 4.0f);
+  std::uniform_int_distribution<int> side_distribution(0, 5);
+
+  std::vector<Eigen::Vector2f> targets;
+  while (targets.size() < num_points) {
+    const int side = side_distribution(engine);
+    const float border_position = cellCenter(cell_distribution(engine));
+    if (side >= 4) {
+      targets.emplace_back(
+        cellCenter(cell_distribution(engine)) + offset_distribution(engine),
+        cellCenter(cell_distribution(engine)) + offset_distribution(engine));
+      continue;
+    }
+    const float border = side % 2 == 0 ? map_origin : map_end;
+    const Eigen::Vector2f exit = side < 2 ? Eigen::Vector2f(border, border_position)
+                                          : Eigen::Vector2f(border_position, border);
+    const Eigen::Vector2f target = source + scale_distribution(engine) * (exit - source);
+    // the ray must leave the map through a single border
+    const float other = side < 2 ? target.y() : target.x();
+    if (other < map_origin || other >= map_end) {
+      continue;
+    }
+    targets.push_back(target);
+  }
+  return targets;
+}
+
+sensor_msgs::msg::PointCloud2 createPointCloud(const std::vector<Eigen::Vector2f> & points)
+{
+  sensor_msgs::msg::PointCloud2 pointcloud;
+  sensor_msgs::PointCloud2Modifier modifier(pointcloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(points.size());
+  sensor_msgs::PointCloud2Iterator<float> iter_x(pointcloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(pointcloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(pointcloud, "z");
+  for (const auto & point : points) {
+    *iter_x = point.x();
+    *iter_y = point.y();
+    *iter_z = 0.0f;
+    ++iter_x;
+    ++iter_y;
+    ++iter_z;
+  }
+  return pointcloud;
+}
+}  // namespace
+
+TEST(OccupancyGridMapCpu, BBFUpdaterMatchesReference)
+{
+  rclcpp::NodeOptions options;
+  options.parameter_overrides({
+    {"probability_matrix.occupied_to_occupied", occupied_to_occupied},
+    {"probability_matrix.occupied_to_free", occupied_to_free},
+    {"probability_matrix.free_to_occupied", free_to_occupied},
+    {"probability_matrix.free_to_free", free_to_free},
+    {"v_ratio", v_ratio},
+  });
+  rclcpp::Node node("test_occupancy_grid_map_cpu", options);
+
+  OccupancyGridMap measurement(num_values, num_values, resolution);
+  OccupancyGridMapBBFUpdater updater(false, num_values, num_values, resolution);
+  updater.initRosParam(node);
+  // the first update only moves the updater to the origin of the measurement
+  ASSERT_TRUE(updater.update(measurement));
+
+  setAllPairs(measurement, updater);
+  ASSERT_TRUE(updater.update(measurement));
+  for (unsigned int y = 0; y < num_values; ++y) {
+    for (unsigned int x = 0; x < num_values; ++x) {
+      EXPECT_EQ(
+        updater.getCost(x, y),
+        referenceBBF(static_cast<unsigned char>(x), static_cast<unsigned char>(y)))
+        << "measurement: " << x << ", prior: " << y;
+    }
+  }
+}
+
+TEST(OccupancyGridMapCpu, LOBFUpdaterMatchesReference)
+{
+  OccupancyGridMap measurement(num_values, num_values, resolution);
+  OccupancyGridMapLOBFUpdater updater(false, num_values, num_values, resolution);
+  ASSERT_TRUE(updater.update(measurement));
+
+  setAllPairs(measurement, updater);
+  ASSERT_TRUE(updater.update(measurement));
+  for (unsigned int y = 0; y < num_values; ++y) {
+    for (unsigned int x = 0; x < num_values; ++x) {
+      EXPECT_EQ(
+        updater.getCost(x, y),
+        referenceLOBF(static_cast<unsigned char>(x), static_cast<unsigned char>(y)))
+        << "measurement: " << x << ", prior: " << y;
+    }
+  }
+}
+
+TEST(OccupancyGridMapCpu, RaytraceMatchesReference)
+{
+  std::mt19937 engine(0);
+  for (const Eigen::Vector2f source :
+       {Eigen::Vector2f(cellCenter(100), cellCenter(100)),
+        Eigen::Vector2f(cellCenter(3), cellCenter(150)),
+        Eigen::Vector2f(cellCenter(190), cellCenter(7))}) {
+    const auto targets = createTargets(source, 2000, engine);
+
+    OccupancyGridMap reference_map(num_cells, num_cells, resolution);
+    reference_map.updateOrigin(map_origin, map_origin);
+    ASSERT_DOUBLE_EQ(reference_map.getOriginX(), map_origin);
+    reference_map.resetMaps();
+    geometry_msgs::msg::Pose robot_pose;
+    robot_pose.position.x = source.x();
+    robot_pose.position.y = source.y();
+    reference_map.raytrace2D(createPointCloud(targets), robot_pose);
+
+    std::vector<std::uint8_t> costmap(num_cells * num_cells, NO_INFORMATION);
+    for (const auto & target : targets) {
+      utils::cpu::raytrace(
+        source.x(), source.y(), target.x(), target.y(), map_origin, map_origin, 1.0f / resolution,
+        num_cells, num_cells, FREE_SPACE, costmap.data());
+    }
+    for (const auto & target : targets) {
+      utils::cpu::setCellValue(
+        target.x(), target.y(), map_origin, map_origin, 1.0f / resolution, num_cells, num_cells,
+        LETHAL_OBSTACLE, costmap.data());
+    }
+
+    for (unsigned int y = 0; y < num_cells; ++y) {
+      for (unsigned int x = 0; x < num_cells; ++x) {
+        EXPECT_EQ(costmap[y * num_cells + x], reference_map.getCost(x, y))
+          << "source: " << source.transpose() << ", cell: " << x << ", " << y;
+      }
+    }
+    EXPECT_GT(std::count(costmap.begin(), costmap.end(), FREE_SPACE), 0);
+  }
+
+  // the infinite projections of the projective map are skipped
+  std::vector<std::uint8_t> costmap(num_cells * num_cells, NO_INFORMATION);
+  const float inf = std::numeric_limits<float>::infinity();
+  utils::cpu::raytrace(
+    0.0f, 0.0f, inf, 1.0f, map_origin, map_origin, 1.0f / resolution, num_cells, num_cells,
+    FREE_SPACE, costmap.data());
+  utils::cpu::raytrace(
+    0.0f, 0.0f, std::nanf(""), -inf, map_origin, map_origin, 1.0f / resolution, num_cells,
+    num_cells, FREE_SPACE, costmap.data());
+  EXPECT_EQ(
+    static_cast<std::size_t>(std::count(costmap.begin(), costmap.end(), NO_INFORMATION)),
+    costmap.size());
+}
+
+TEST(OccupancyGridMapCpu, FillEmptySpaceMatchesSerialRaytrace)
+{
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<float> position_distribution(-80.0f, 80.0f);
+  std::uniform_int_distribution<int> value_distribution(0, 255);
+  constexpr std::size_t points_step = 4;
+  std::vector<float> cloud;
+  for (int i = 0; i < 20000; ++i) {
+    const float point[points_step] = {
+      position_distribution(engine), position_distribution(engine), 0.0f, 0.0f};
+    cloud.insert(cloud.end(), point, point + points_step);
+  }
+
+  const float resolution_inv = 1.0f / resolution;
+  const float min_angle = -M_PI;
+  const float angle_increment_inv = 1.0f / (0.1f * M_PI / 180.0f);
+  const std::size_t angle_bins = static_cast<std::size_t>(2.0f * M_PI * angle_increment_inv) + 1;
+  const std::size_t range_bins = static_cast<std::size_t>(std::sqrt(2) * num_cells / 2.0) + 1;
+  const Eigen::Vector2f scan_origin(1.3f, -2.1f);
+  utils::PolarPointsTensor tensor(2);
+  map_fixed::prepareTensor(
+    cloud.data(), cloud.size() / points_step, points_step, angle_bins, range_bins, -1.0f, 1.0f,
+    min_angle, angle_increment_inv, resolution_inv, Eigen::Matrix3f::Identity(),
+    Eigen::Vector3f::Zero(), Eigen::Matrix3f::Identity(),
+    Eigen::Vector3f(-scan_origin.x(), -scan_origin.y(), 0.0f), tensor);
+
+  // the cells which are not traced keep their values
+  std::vector<std::uint8_t> initial_costmap(num_cells * num_cells);
+  for (auto & value : initial_costmap) {
+    value = static_cast<std::uint8_t>(value_distribution(engine));
+  }
+
+  auto expected = initial_costmap;
+  for (std::size_t angle_bin = 0; angle_bin < tensor.getNumOfAngleBins(); ++angle_bin) {
+    for (auto entry = tensor.getBegin(angle_bin); entry < tensor.getEnd(angle_bin); ++entry) {
+      const std::uint64_t * element = tensor.getElement(entry);
+      const float world_x = utils::unpackValue(element[0]);
+      const float world_y = utils::unpackValue(element[1]);
+      if (world_x < map_origin || world_y < map_origin) {
+        continue;
+      }
+      utils::cpu::raytrace(
+        scan_origin.x(), scan_origin.y(), world_x, world_y, map_origin, map_origin,
+        resolution_inv, num_cells, num_cells, FREE_SPACE, expected.data());
+    }
+  }
+
+  const int max_threads = omp_get_max_threads();
+  utils::cpu::ThreadBuffers buffers;
+  for (const int num_threads : {1, 3, 8}) {
+    omp_set_num_threads(num_threads);
+    auto costmap = initial_costmap;
+    utils::cpu::fillEmptySpace(
+      tensor, resolution_inv, scan_origin.x(), scan_origin.y(), map_origin, map_origin, num_cells,
+      num_cells, FREE_SPACE, buffers, costmap.data());
+    EXPECT_EQ(costmap, expected) << "threads: " << num_threads;
+  }
+  omp_set_num_threads(max_threads);
+  EXPECT_NE(expected, initial_costmap);
+}
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -40,9 +40,11 @@ private:
 public:
   BoundingBoxShapeModel();
   explicit BoundingBoxShapeModel(
-    const boost::optional<ReferenceYawInfo> & ref_yaw_info, bool use_boost_bbox_optimizer = false);
+    const boost::optional<ReferenceYawInfo> & ref_yaw_info, bool use_boost_bbox_optimizer = false,
+    int bbox_optimizer_coarse_step = 1);
   boost::optional<ReferenceYawInfo> ref_yaw_info_;
   bool use_boost_bbox_optimizer_;
+  int bbox_optimizer_coarse_step_;
 
   ~BoundingBoxShapeModel() {}
 
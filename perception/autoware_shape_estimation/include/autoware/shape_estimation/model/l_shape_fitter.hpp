@@ -0,0 +1,74 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__SHAPE_ESTIMATION__MODEL__L_SHAPE_FITTER_HPP_
+#define AUTOWARE__SHAPE_ESTIMATION__MODEL__L_SHAPE_FITTER_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <limits>
+#include <vector>
+
+namespace autoware::shape_estimation
+{
+namespace model
+{
+
+/**
+ * \brief Search-based rectangle fitting (Algo.2 of the L-shape fitting paper) over an angle table.
+ *
+ * The candidate angles are the ones of the search of BoundingBoxShapeModel, from min_angle to
+ * max_angle in steps of 1 degree, and their sin/cos are computed once per search range and reused
+ * by the next searches over the same range. The points are stored as arrays of x and y, so that
+ * the projection and the closeness criterion of an angle are computed by vectorized loops over the
+ * points. The buffers are reused between the searches, an instance must not be shared by threads.
+ */
+class LShapeFitter
+{
+public:
+  /**
+   * \brief The candidate angle with the largest closeness criterion, the first one on a tie.
+   *
+   * With coarse_step > 1, only every coarse_step-th angle is evaluated first, then the angles
+   * between the neighbors of the best of them. This is faster but may miss a maximum narrower than
+   * coarse_step degrees.
+   */
+  float optimize(
+    const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle,
+    const int coarse_step = 1);
+
+private:
+  void updateAngleTable(const float min_angle, const float max_angle);
+  float calcClosenessCriterion(const float cos_theta, const float sin_theta);
+  void evaluate(const std::size_t angle_index);
+
+  float table_min_angle_{std::numeric_limits<float>::quiet_NaN()};
+  float table_max_angle_{std::numeric_limits<float>::quiet_NaN()};
+  std::vector<float> thetas_;
+  std::vector<float> cos_thetas_;
+  std::vector<float> sin_thetas_;
+
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<float> c_1_;
+  std::vector<float> c_2_;
+  // the closeness criterion of each angle, negative for the angles not evaluated
+  std::vector<float> q_;
+};
+
+}  // namespace model
+}  // namespace autoware::shape_estimation
+
+#endif  // AUTOWARE__SHAPE_ESTIMATION__MODEL__L_SHAPE_FITTER_HPP_
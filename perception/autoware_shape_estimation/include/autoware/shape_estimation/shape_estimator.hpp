@@ -67,9 +67,12 @@ private:
   bool use_corrector_;
   bool use_filter_;
   bool use_boost_bbox_optimizer_;
+  int bbox_optimizer_coarse_step_;
 
 public:
-  ShapeEstimator(bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer = false);
+  ShapeEstimator(
+    bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer = false,
+    int bbox_optimizer_coarse_step = 1);
 
   virtual ~ShapeEstimator() = default;
 
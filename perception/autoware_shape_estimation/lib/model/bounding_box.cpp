@@ -16,6 +16,8 @@
 
 #include "autoware/shape_estimation/model/bounding_box.hpp"
 
+#include "autoware/shape_estimation/model/l_shape_fitter.hpp"
+
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -50,13 +52,16 @@ namespace model
 constexpr float epsilon = 0.001;
 
 BoundingBoxShapeModel::BoundingBoxShapeModel()
-: ref_yaw_info_(boost::none), use_boost_bbox_optimizer_(false)
+: ref_yaw_info_(boost::none), use_boost_bbox_optimizer_(false), bbox_optimizer_coarse_step_(1)
 {
 }
 
 BoundingBoxShapeModel::BoundingBoxShapeModel(
-  const boost::optional<ReferenceYawInfo> & ref_yaw_info, bool use_boost_bbox_optimizer)
-: ref_yaw_info_(ref_yaw_info), use_boost_bbox_optimizer_(use_boost_bbox_optimizer)
+  const boost::optional<ReferenceYawInfo> & ref_yaw_info, bool use_boost_bbox_optimizer,
+  int bbox_optimizer_coarse_step)
+: ref_yaw_info_(ref_yaw_info),
+  use_boost_bbox_optimizer_(use_boost_bbox_optimizer),
+  bbox_optimizer_coarse_step_(bbox_optimizer_coarse_step)
 {
 }
 
@@ -203,33 +208,10 @@ float BoundingBoxShapeModel::calcClosenessCriterion(
 float BoundingBoxShapeModel::optimize(
   const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
 {
-  std::vector<std::pair<float /*theta*/, float /*q*/>> Q;
-  constexpr float angle_resolution = M_PI / 180.0;
-  for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
-    Eigen::Vector2f e_1;
-    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
-    Eigen::Vector2f e_2;
-    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
-    std::vector<float> C_1;                    // col.5, Algo.2
-    std::vector<float> C_2;                    // col.6, Algo.2
-    for (const auto & point : cluster) {
-      C_1.push_back(point.x * e_1.x() + point.y * e_1.y());
-      C_2.push_back(point.x * e_2.x() + point.y * e_2.y());
-    }
-    float q = calcClosenessCriterion(C_1, C_2);  // col.7, Algo.2
-    Q.push_back(std::make_pair(theta, q));       // col.8, Algo.2
-  }
-
-  float theta_star{0.0};  // col.10, Algo.2
-  float max_q = 0.0;
-  for (size_t i = 0; i < Q.size(); ++i) {
-    if (max_q < Q.at(i).second || i == 0) {
-      max_q = Q.at(i).second;
-      theta_star = Q.at(i).first;
-    }
-  }
-
-  return theta_star;
+  // the models are created for each cluster, the fitter of the thread keeps its angle table and
+  // buffers between the clusters
+  thread_local LShapeFitter l_shape_fitter;
+  return l_shape_fitter.optimize(cluster, min_angle, max_angle, bbox_optimizer_coarse_step_);
 }
 
 float BoundingBoxShapeModel::boostOptimize(
@@ -0,0 +1,155 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/shape_estimation/model/l_shape_fitter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace autoware::shape_estimation
+{
+namespace model
+{
+
+namespace
+{
+constexpr float epsilon = 0.001;
+constexpr float angle_resolution = M_PI / 180.0;
+}  // namespace
+
+void LShapeFitter::updateAngleTable(const float min_angle, const float max_angle)
+{
+  if (min_angle == table_min_angle_ && max_angle == table_max_angle_) {
+    return;
+  }
+  table_min_angle_ = min_angle;
+  table_max_angle_ = max_angle;
+
+  // the angles are accumulated as in BoundingBoxShapeModel so that the searched angles are the same
+  thetas_.clear();
+  cos_thetas_.clear();
+  sin_thetas_.clear();
+  for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
+    thetas_.push_back(theta);
+    cos_thetas_.push_back(std::cos(theta));
+    sin_thetas_.push_back(std::sin(theta));
+  }
+}
+
+float LShapeFitter::calcClosenessCriterion(const float cos_theta, const float sin_theta)
+{
+  // Paper : Algo.4 Closeness Criterion
+  const std::size_t size = xs_.size();
+  const float * __restrict xs = xs_.data();
+  const float * __restrict ys = ys_.data();
+  float * __restrict c_1 = c_1_.data();
+  float * __restrict c_2 = c_2_.data();
+
+  float min_c_1 = std::numeric_limits<float>::max();
+  float max_c_1 = std::numeric_limits<float>::lowest();
+  float min_c_2 = std::numeric_limits<float>::max();
+  float max_c_2 = std::numeric_limits<float>::lowest();
+#pragma omp simd reduction(min : min_c_1, min_c_2) reduction(max : max_c_1, max_c_2)
+  for (std::size_t i = 0; i < size; ++i) {
+    // col.5 and col.6, Algo.2
+    const float c_1_i = xs[i] * cos_theta + ys[i] * sin_theta;
+    const float c_2_i = xs[i] * -sin_theta + ys[i] * cos_theta;
+    c_1[i] = c_1_i;
+    c_2[i] = c_2_i;
+    // col.2 and col.3, Algo.4
+    min_c_1 = std::min(min_c_1, c_1_i);
+    max_c_1 = std::max(max_c_1, c_1_i);
+    min_c_2 = std::min(min_c_2, c_2_i);
+    max_c_2 = std::max(max_c_2, c_2_i);
+  }
+
+  constexpr float d_min = 0.1 * 0.1;
+  constexpr float d_max = 0.4 * 0.4;
+  float beta = 0;  // col.6, Algo.4
+#pragma omp simd reduction(+ : beta)
+  for (std::size_t i = 0; i < size; ++i) {
+    // col.4 and col.5, Algo.4
+    const float v_1 = std::min(max_c_1 - c_1[i], c_1[i] - min_c_1);
+    const float v_2 = std::min(max_c_2 - c_2[i], c_2[i] - min_c_2);
+    const float d = std::min(v_1 * v_1, v_2 * v_2);
+    // the points farther than d_max from both edges are weighted out instead of skipped, so that
+    // the loop has no branch
+    const float weight = d <= d_max ? 1.0f : 0.0f;
+    beta += weight / std::max(d, d_min);
+  }
+  return beta;
+}
+
+void LShapeFitter::evaluate(const std::size_t angle_index)
+{
+  if (q_[angle_index] < 0.0f) {
+    q_[angle_index] = calcClosenessCriterion(cos_thetas_[angle_index], sin_thetas_[angle_index]);
+  }
+}
+
+float LShapeFitter::optimize(
+  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle,
+  const int coarse_step)
+{
+  updateAngleTable(min_angle, max_angle);
+  const std::size_t num_angles = thetas_.size();
+  if (num_angles == 0) {
+    return 0.0;
+  }
+
+  const std::size_t size = cluster.size();
+  xs_.resize(size);
+  ys_.resize(size);
+  c_1_.resize(size);
+  c_2_.resize(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    xs_[i] = cluster[i].x;
+    ys_[i] = cluster[i].y;
+  }
+
+  // coarse search, the last angle is always evaluated so that the whole range is covered
+  const std::size_t step = static_cast<std::size_t>(std::max(coarse_step, 1));
+  q_.assign(num_angles, -1.0f);
+  for (std::size_t i = 0; i < num_angles; i += step) {
+    evaluate(i);
+  }
+  evaluate(num_angles - 1);
+
+  const auto find_best_angle = [this, num_angles]() {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < num_angles; ++i) {
+      if (q_[best] < q_[i]) {
+        best = i;
+      }
+    }
+    return best;
+  };
+
+  // fine search between the neighbors of the best coarse angle
+  std::size_t best = find_best_angle();
+  if (step > 1) {
+    const std::size_t begin = best < step ? 0 : best - step + 1;
+    const std::size_t end = std::min(best + step, num_angles);
+    for (std::size_t i = begin; i < end; ++i) {
+      evaluate(i);
+    }
+    best = find_best_angle();
+  }
+  return thetas_[best];
+}
+
+}  // namespace model
+}  // namespace autoware::shape_estimation
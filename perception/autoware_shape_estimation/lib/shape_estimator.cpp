@@ -26,10 +26,13 @@ namespace autoware::shape_estimation
 
 using Label = autoware_perception_msgs::msg::ObjectClassification;
 
-ShapeEstimator::ShapeEstimator(bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer)
+ShapeEstimator::ShapeEstimator(
+  bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer,
+  int bbox_optimizer_coarse_step)
 : use_corrector_(use_corrector),
   use_filter_(use_filter),
-  use_boost_bbox_optimizer_(use_boost_bbox_optimizer)
+  use_boost_bbox_optimizer_(use_boost_bbox_optimizer),
+  bbox_optimizer_coarse_step_(bbox_optimizer_coarse_step)
 {
 }
 
@@ -83,7 +86,8 @@ bool ShapeEstimator::estimateOriginalShapeAndPose(
   if (
     label == Label::CAR || label == Label::TRUCK || label == Label::BUS ||
     label == Label::TRAILER || label == Label::MOTORCYCLE || label == Label::BICYCLE) {
-    model_ptr.reset(new model::BoundingBoxShapeModel(ref_yaw_info, use_boost_bbox_optimizer_));
+    model_ptr.reset(new model::BoundingBoxShapeModel(
+      ref_yaw_info, use_boost_bbox_optimizer_, bbox_optimizer_coarse_step_));
   } else if (label == Label::PEDESTRIAN) {
     model_ptr.reset(new model::CylinderShapeModel());
   } else {
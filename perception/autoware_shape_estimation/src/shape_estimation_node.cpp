@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace autoware::shape_estimation
 {
@@ -50,11 +51,12 @@ ShapeEstimationNode::ShapeEstimationNode(const rclcpp::NodeOptions & node_option
   use_vehicle_reference_yaw_ = declare_parameter<bool>("use_vehicle_reference_yaw");
   use_vehicle_reference_shape_size_ = declare_parameter<bool>("use_vehicle_reference_shape_size");
   bool use_boost_bbox_optimizer = declare_parameter<bool>("use_boost_bbox_optimizer");
+  int bbox_optimizer_coarse_step = declare_parameter<int>("bbox_optimizer_coarse_step");
   fix_filtered_objects_label_to_unknown_ =
     declare_parameter<bool>("fix_filtered_objects_label_to_unknown");
   RCLCPP_INFO(this->get_logger(), "using boost shape estimation : %d", use_boost_bbox_optimizer);
-  estimator_ =
-    std::make_unique<ShapeEstimator>(use_corrector, use_filter, use_boost_bbox_optimizer);
+  estimator_ = std::make_unique<ShapeEstimator>(
+    use_corrector, use_filter, use_boost_bbox_optimizer, bbox_optimizer_coarse_step);
 
 #ifdef USE_CUDA
   use_ml_shape_estimation_ = declare_parameter<bool>("model_params.use_ml_shape_estimator");
@@ -96,6 +98,51 @@ static bool label_is_vehicle(
          Label::TRAILER == label;
 }
 
+ShapeEstimationNode::ShapeEstimationResult ShapeEstimationNode::estimateShapeAndPose(
+  const DetectedObjectWithFeature & feature_object) const
+{
+  ShapeEstimationResult result;
+  const auto & object = feature_object.object;
+  const auto label = get_label(object.classification);
+  const auto is_vehicle = label_is_vehicle(label);
+  const auto & feature = feature_object.feature;
+  // convert ros to pcl
+  pcl::PointCloud<pcl::PointXYZ>::Ptr cluster(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::fromROSMsg(feature.cluster, *cluster);
+
+  // check cluster data
+  if (cluster->empty()) {
+    result.status = ShapeEstimationResult::Status::EMPTY_CLUSTER;
+    return result;
+  }
+
+#ifdef USE_CUDA
+  // If ml based shape estimation is enabled, the object is estimated in the input batch
+  if (is_vehicle && use_ml_shape_estimation_ && cluster->size() > min_points_) {
+    result.status = ShapeEstimationResult::Status::ML_ESTIMATION;
+    return result;
+  }
+#endif
+
+  // estimate shape and pose
+  boost::optional<ReferenceYawInfo> ref_yaw_info = boost::none;
+  boost::optional<ReferenceShapeSizeInfo> ref_shape_size_info = boost::none;
+  boost::optional<geometry_msgs::msg::Pose> ref_pose = boost::none;
+  if (use_vehicle_reference_yaw_ && is_vehicle) {
+    ref_yaw_info = ReferenceYawInfo{
+      static_cast<float>(tf2::getYaw(object.kinematics.pose_with_covariance.pose.orientation)),
+      autoware_utils::deg2rad(10)};
+  }
+  if (use_vehicle_reference_shape_size_ && is_vehicle) {
+    ref_shape_size_info = ReferenceShapeSizeInfo{object.shape, ReferenceShapeSizeInfo::Mode::Min};
+  }
+  const bool estimated_success = estimator_->estimateShapeAndPose(
+    label, *cluster, ref_yaw_info, ref_shape_size_info, ref_pose, result.shape, result.pose);
+  result.status = estimated_success ? ShapeEstimationResult::Status::SUCCEEDED
+                                    : ShapeEstimationResult::Status::FAILED;
+  return result;
+}
+
 void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstSharedPtr input_msg)
 {
   stop_watch_ptr_->toc("processing_time", true);
@@ -111,47 +158,32 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
   // Create ml model input batch
   DetectedObjectsWithFeature input_trt_batch;
 
-  // Estimate shape for each object and pack msg
-  for (const auto & feature_object : input_msg->feature_objects) {
-    const auto & object = feature_object.object;
-    const auto label = get_label(object.classification);
-    const auto is_vehicle = label_is_vehicle(label);
-    const auto & feature = feature_object.feature;
-    // convert ros to pcl
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cluster(new pcl::PointCloud<pcl::PointXYZ>);
-    pcl::fromROSMsg(feature.cluster, *cluster);
-
-    // check cluster data
-    if (cluster->empty()) {
+  // Estimate shape for each object in parallel, the clusters are independent
+  const auto & feature_objects = input_msg->feature_objects;
+  std::vector<ShapeEstimationResult> results(feature_objects.size());
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t i = 0; i < feature_objects.size(); ++i) {
+    results[i] = estimateShapeAndPose(feature_objects[i]);
+  }
+
+  // Pack msg in the input order
+  for (std::size_t i = 0; i < feature_objects.size(); ++i) {
+    const auto & feature_object = feature_objects[i];
+    const auto & result = results[i];
+    if (result.status == ShapeEstimationResult::Status::EMPTY_CLUSTER) {
       continue;
     }
 
 #ifdef USE_CUDA
     // If ml based shape estimation is enabled, add object to input batch and continue
-    if (is_vehicle && use_ml_shape_estimation_ && cluster->size() > min_points_) {
+    if (result.status == ShapeEstimationResult::Status::ML_ESTIMATION) {
       input_trt_batch.feature_objects.push_back(feature_object);
       continue;
     }
 #endif
 
-    // estimate shape and pose
-    autoware_perception_msgs::msg::Shape shape;
-    geometry_msgs::msg::Pose pose;
-    boost::optional<ReferenceYawInfo> ref_yaw_info = boost::none;
-    boost::optional<ReferenceShapeSizeInfo> ref_shape_size_info = boost::none;
-    boost::optional<geometry_msgs::msg::Pose> ref_pose = boost::none;
-    if (use_vehicle_reference_yaw_ && is_vehicle) {
-      ref_yaw_info = ReferenceYawInfo{
-        static_cast<float>(tf2::getYaw(object.kinematics.pose_with_covariance.pose.orientation)),
-        autoware_utils::deg2rad(10)};
-    }
-    if (use_vehicle_reference_shape_size_ && is_vehicle) {
-      ref_shape_size_info = ReferenceShapeSizeInfo{object.shape, ReferenceShapeSizeInfo::Mode::Min};
-    }
-    const bool estimated_success = estimator_->estimateShapeAndPose(
-      label, *cluster, ref_yaw_info, ref_shape_size_info, ref_pose, shape, pose);
-
     // If the shape estimation fails, change to Unknown object.
+    const bool estimated_success = result.status == ShapeEstimationResult::Status::SUCCEEDED;
     if (!fix_filtered_objects_label_to_unknown_ && !estimated_success) {
       continue;
     }
@@ -160,8 +192,8 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
       output_msg.feature_objects.back().object.classification.front().label = Label::UNKNOWN;
     }
 
-    output_msg.feature_objects.back().object.shape = shape;
-    output_msg.feature_objects.back().object.kinematics.pose_with_covariance.pose = pose;
+    output_msg.feature_objects.back().object.shape = result.shape;
+    output_msg.feature_objects.back().object.kinematics.pose_with_covariance.pose = result.pose;
   }
 
 #ifdef USE_CUDA
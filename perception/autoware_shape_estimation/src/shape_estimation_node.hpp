@@ -38,6 +38,7 @@ namespace autoware::shape_estimation
 
 using autoware_perception_msgs::msg::DetectedObjects;
 using tier4_perception_msgs::msg::DetectedObjectsWithFeature;
+using tier4_perception_msgs::msg::DetectedObjectWithFeature;
 class ShapeEstimationNode : public rclcpp::Node
 {
 private:
@@ -50,7 +51,18 @@ private:
   std::unique_ptr<autoware_utils::StopWatch<std::chrono::milliseconds>> stop_watch_ptr_;
   std::unique_ptr<autoware_utils::DebugPublisher> processing_time_publisher_;
 
+  struct ShapeEstimationResult
+  {
+    enum class Status { EMPTY_CLUSTER, ML_ESTIMATION, SUCCEEDED, FAILED };
+    Status status{Status::EMPTY_CLUSTER};
+    autoware_perception_msgs::msg::Shape shape;
+    geometry_msgs::msg::Pose pose;
+  };
+
   void callback(const DetectedObjectsWithFeature::ConstSharedPtr input_msg);
+  // thread safe, called in parallel for the objects of a message
+  ShapeEstimationResult estimateShapeAndPose(
+    const DetectedObjectWithFeature & feature_object) const;
 
   std::unique_ptr<ShapeEstimator> estimator_;
   bool use_vehicle_reference_yaw_;
@@ -0,0 +1,187 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/shape_estimation/model/l_shape_fitter.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Measure the search of the yaw of the L-shape fitting for clusters from a pedestrian-sized 50
+// points to a bus-sized 20000 points, over the default range of 90 degrees. The baseline is the
+// previous search, which computed the sin/cos of each angle and filled new vectors of projections
+// for each angle. The fitter is measured with a search of every angle, which finds the same angles,
+// and with a coarse-to-fine search of step 5 degrees. The last measure is a frame of 100 clusters
+// of mixed sizes searched one after the other and in parallel, as in the node.
+
+namespace
+{
+using autoware::shape_estimation::model::LShapeFitter;
+using Clock = std::chrono::steady_clock;
+
+constexpr float min_angle = 0.0;
+constexpr float max_angle = M_PI * 0.5;
+
+float calcClosenessCriterion(const std::vector<float> & C_1, const std::vector<float> & C_2)
+{
+  const float min_c_1 = *std::min_element(C_1.begin(), C_1.end());
+  const float max_c_1 = *std::max_element(C_1.begin(), C_1.end());
+  const float min_c_2 = *std::min_element(C_2.begin(), C_2.end());
+  const float max_c_2 = *std::max_element(C_2.begin(), C_2.end());
+
+  std::vector<float> D_1;
+  for (const auto & c_1_element : C_1) {
+    const float v = std::min(max_c_1 - c_1_element, c_1_element - min_c_1);
+    D_1.push_back(v * v);
+  }
+  std::vector<float> D_2;
+  for (const auto & c_2_element : C_2) {
+    const float v = std::min(max_c_2 - c_2_element, c_2_element - min_c_2);
+    D_2.push_back(v * v);
+  }
+  constexpr float d_min = 0.1 * 0.1;
+  constexpr float d_max = 0.4 * 0.4;
+  float beta = 0;
+  for (size_t i = 0; i < D_1.size(); ++i) {
+    if (d_max < std::min(D_1.at(i), D_2.at(i))) {
+      continue;
+    }
+    const float d = std::max(std::min(D_1.at(i), D_2.at(i)), d_min);
+    beta += 1.0 / d;
+  }
+  return beta;
+}
+
+// the previous search of BoundingBoxShapeModel
+float baselineOptimize(const pcl::PointCloud<pcl::PointXYZ> & cluster)
+{
+  std::vector<std::pair<float, float>> Q;
+  constexpr float angle_resolution = M_PI / 180.0;
+  for (float theta = min_angle; theta <= max_angle + 0.001f; theta += angle_resolution) {
+    const float cos_theta = std::cos(theta);
+    const float sin_theta = std::sin(theta);
+    std::vector<float> C_1;
+    std::vector<float> C_2;
+    for (const auto & point : cluster) {
+      C_1.push_back(point.x * cos_theta + point.y * sin_theta);
+      C_2.push_back(point.x * -sin_theta + point.y * cos_theta);
+    }
+    Q.push_back(std::make_pair(theta, calcClosenessCriterion(C_1, C_2)));
+  }
+  float theta_star{0.0};
+  float max_q = 0.0;
+  for (size_t i = 0; i < Q.size(); ++i) {
+    if (max_q < Q.at(i).second || i == 0) {
+      max_q = Q.at(i).second;
+      theta_star = Q.at(i).first;
+    }
+  }
+  return theta_star;
+}
+
+// an L-shaped cluster of about size points, with noise
+pcl::PointCloud<pcl::PointXYZ> createCluster(const std::size_t size, std::mt19937 & engine)
+{
+  std::uniform_real_distribution<float> yaw_distribution(0.0f, M_PI * 0.5);
+  std::uniform_real_distribution<float> ratio_distribution(0.0f, 1.0f);
+  std::normal_distribution<float> noise_distribution(0.0f, 0.05f);
+  const float length = 0.5f + 12.0f * std::min(size / 20000.0f, 1.0f);
+  const float width = 0.5f + 2.0f * std::min(size / 5000.0f, 1.0f);
+  const float yaw = yaw_distribution(engine);
+
+  pcl::PointCloud<pcl::PointXYZ> cluster;
+  for (std::size_t i = 0; i < size; ++i) {
+    // the points are on the long side or on the short side in proportion to their lengths
+    const float position = ratio_distribution(engine) * (length + width);
+    const float x = position < length ? position - length / 2 : -length / 2;
+    const float y = position < length ? width / 2 : position - length - width / 2;
+    const float noisy_x = x + noise_distribution(engine);
+    const float noisy_y = y + noise_distribution(engine);
+    cluster.push_back(pcl::PointXYZ(
+      noisy_x * std::cos(yaw) - noisy_y * std::sin(yaw) + 20.0f,
+      noisy_x * std::sin(yaw) + noisy_y * std::cos(yaw) + 5.0f, 0.0f));
+  }
+  return cluster;
+}
+
+// the difference of the yaws of two boxes, the box being the same after a rotation of 90 degrees
+float calcYawDifference(const float yaw_1, const float yaw_2)
+{
+  const float difference = std::fmod(std::abs(yaw_1 - yaw_2), static_cast<float>(M_PI * 0.5));
+  return std::min(difference, static_cast<float>(M_PI * 0.5) - difference);
+}
+
+// the mean time in us of f, after a warm-up run
+template <typename F>
+double measure(F && f, const int num_iterations)
+{
+  f();
+  const auto start = Clock::now();
+  for (int i = 0; i < num_iterations; ++i) {
+    f();
+  }
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / num_iterations;
+}
+}  // namespace
+
+int main()
+{
+  std::mt19937 engine(0);
+  volatile float sink = 0.0f;
+
+  for (const std::size_t size : {50, 200, 1000, 5000, 20000}) {
+    const auto cluster = createCluster(size, engine);
+    const int num_iterations = static_cast<int>(std::max<std::size_t>(20000 / size, 3));
+    LShapeFitter fitter;
+    const double baseline_us = measure([&]() { sink = baselineOptimize(cluster); }, num_iterations);
+    const double fitter_us =
+      measure([&]() { sink = fitter.optimize(cluster, min_angle, max_angle); }, num_iterations);
+    const double coarse_to_fine_us =
+      measure([&]() { sink = fitter.optimize(cluster, min_angle, max_angle, 5); }, num_iterations);
+    const float baseline_yaw = baselineOptimize(cluster);
+    const float yaw_difference =
+      calcYawDifference(fitter.optimize(cluster, min_angle, max_angle), baseline_yaw);
+    const float coarse_to_fine_yaw_difference =
+      calcYawDifference(fitter.optimize(cluster, min_angle, max_angle, 5), baseline_yaw);
+    std::cout << "points: " << size << ", baseline " << baseline_us << " us, fitter " << fitter_us
+              << " us (yaw difference " << yaw_difference << " rad), coarse-to-fine "
+              << coarse_to_fine_us << " us (yaw difference " << coarse_to_fine_yaw_difference
+              << " rad)" << std::endl;
+  }
+
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+  for (int i = 0; i < 100; ++i) {
+    clusters.push_back(createCluster(i % 10 == 0 ? 5000 : 300, engine));
+  }
+  std::vector<float> yaws(clusters.size());
+  const auto fit_frame = [&](const bool parallel) {
+#pragma omp parallel for schedule(dynamic) if (parallel)
+    for (std::size_t i = 0; i < clusters.size(); ++i) {
+      thread_local LShapeFitter fitter;
+      yaws[i] = fitter.optimize(clusters[i], min_angle, max_angle);
+    }
+  };
+  const double sequential_us = measure([&]() { fit_frame(false); }, 10);
+  const double parallel_us = measure([&]() { fit_frame(true); }, 10);
+  std::cout << "frame of " << clusters.size() << " clusters: sequential " << sequential_us
+            << " us, parallel " << parallel_us << " us with " << omp_get_max_threads()
+            << " threads" << std::endl;
+  return 0;
+}
@@ -0,0 +1,159 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/shape_estimation/model/l_shape_fitter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::shape_estimation::model::LShapeFitter;
+
+// the closeness criterion of the cluster at theta as computed by the previous search
+float calcReferenceClosenessCriterion(
+  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float theta)
+{
+  std::vector<float> C_1;
+  std::vector<float> C_2;
+  for (const auto & point : cluster) {
+    C_1.push_back(point.x * std::cos(theta) + point.y * std::sin(theta));
+    C_2.push_back(point.x * -std::sin(theta) + point.y * std::cos(theta));
+  }
+  const float min_c_1 = *std::min_element(C_1.begin(), C_1.end());
+  const float max_c_1 = *std::max_element(C_1.begin(), C_1.end());
+  const float min_c_2 = *std::min_element(C_2.begin(), C_2.end());
+  const float max_c_2 = *std::max_element(C_2.begin(), C_2.end());
+  float beta = 0;
+  for (size_t i = 0; i < C_1.size(); ++i) {
+    const float v_1 = std::min(max_c_1 - C_1[i], C_1[i] - min_c_1);
+    const float v_2 = std::min(max_c_2 - C_2[i], C_2[i] - min_c_2);
+    const float d = std::min(v_1 * v_1, v_2 * v_2);
+    if (0.4 * 0.4 < d) {
+      continue;
+    }
+    beta += 1.0 / std::max(d, 0.1f * 0.1f);
+  }
+  return beta;
+}
+
+// the angle found by the previous search, every degree from min_angle to max_angle
+float referenceOptimize(
+  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
+{
+  constexpr float angle_resolution = M_PI / 180.0;
+  float theta_star = 0.0;
+  float max_q = 0.0;
+  bool first = true;
+  for (float theta = min_angle; theta <= max_angle + 0.001f; theta += angle_resolution) {
+    const float q = calcReferenceClosenessCriterion(cluster, theta);
+    if (max_q < q || first) {
+      max_q = q;
+      theta_star = theta;
+      first = false;
+    }
+  }
+  return theta_star;
+}
+
+pcl::PointCloud<pcl::PointXYZ> createLShapeCluster(
+  const double length, const double width, const double yaw, const double noise,
+  std::mt19937 & engine)
+{
+  std::normal_distribution<double> noise_distribution(0.0, noise);
+  pcl::PointCloud<pcl::PointXYZ> cluster;
+  for (double x = -length / 2; x < length / 2; x += 0.05) {
+    cluster.push_back(pcl::PointXYZ(x, width / 2 + noise_distribution(engine), 0.0));
+  }
+  for (double y = -width / 2; y < width / 2; y += 0.05) {
+    cluster.push_back(pcl::PointXYZ(-length / 2 + noise_distribution(engine), y, 0.0));
+  }
+  for (auto & point : cluster) {
+    const double x = point.x;
+    const double y = point.y;
+    point.x = x * std::cos(yaw) - y * std::sin(yaw) + 10.0;
+    point.y = x * std::sin(yaw) + y * std::cos(yaw) - 5.0;
+  }
+  return cluster;
+}
+
+pcl::PointCloud<pcl::PointXYZ> createRandomCluster(const std::size_t size, std::mt19937 & engine)
+{
+  std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+  pcl::PointCloud<pcl::PointXYZ> cluster;
+  for (std::size_t i = 0; i < size; ++i) {
+    cluster.push_back(pcl::PointXYZ(distribution(engine), distribution(engine), 0.0f));
+  }
+  return cluster;
+}
+
+// the angle found by the fitter must be as good as the angle of the previous search, up to the
+// rounding of the sums of the criterion
+void expectAsGoodAsReference(
+  LShapeFitter & fitter, const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle,
+  const float max_angle)
+{
+  const float theta = fitter.optimize(cluster, min_angle, max_angle);
+  const float reference_theta = referenceOptimize(cluster, min_angle, max_angle);
+  const float q = calcReferenceClosenessCriterion(cluster, theta);
+  const float reference_q = calcReferenceClosenessCriterion(cluster, reference_theta);
+  EXPECT_GE(q, reference_q * (1.0f - 1e-4f));
+  EXPECT_GE(theta, min_angle);
+  EXPECT_LE(theta, max_angle + 0.001f);
+}
+}  // namespace
+
+TEST(LShapeFitter, test_optimize_matches_reference)
+{
+  std::mt19937 engine(0);
+  LShapeFitter fitter;
+  for (const double yaw : {0.0, 0.3, 0.8, 1.2, 1.5, 2.5}) {
+    const auto cluster = createLShapeCluster(4.5, 1.8, yaw, 0.03, engine);
+    expectAsGoodAsReference(fitter, cluster, 0.0, M_PI * 0.5);
+    EXPECT_FLOAT_EQ(
+      fitter.optimize(cluster, 0.0, M_PI * 0.5), referenceOptimize(cluster, 0.0, M_PI * 0.5));
+  }
+  for (const std::size_t size : {1, 2, 7, 33, 500}) {
+    const auto cluster = createRandomCluster(size, engine);
+    expectAsGoodAsReference(fitter, cluster, 0.0, M_PI * 0.5);
+  }
+}
+
+TEST(LShapeFitter, test_optimize_with_reference_yaw)
+{
+  std::mt19937 engine(1);
+  LShapeFitter fitter;
+  // the angle table is rebuilt when the range changes
+  for (const float ref_yaw : {0.2f, -2.9f, 1.0f, 1.0f}) {
+    const auto cluster = createLShapeCluster(12.0, 2.5, ref_yaw + 0.05, 0.05, engine);
+    const float search_range = 10.0 / 180.0 * M_PI;
+    expectAsGoodAsReference(fitter, cluster, ref_yaw - search_range, ref_yaw + search_range);
+  }
+}
+
+TEST(LShapeFitter, test_coarse_to_fine_optimize)
+{
+  std::mt19937 engine(2);
+  LShapeFitter fitter;
+  for (const double yaw : {0.1, 0.45, 0.9, 1.3}) {
+    const auto cluster = createLShapeCluster(4.5, 1.8, yaw, 0.02, engine);
+    const float theta = fitter.optimize(cluster, 0.0, M_PI * 0.5);
+    const float coarse_to_fine_theta = fitter.optimize(cluster, 0.0, M_PI * 0.5, 5);
+    EXPECT_NEAR(coarse_to_fine_theta, theta, 1.5 / 180.0 * M_PI);
+  }
+}
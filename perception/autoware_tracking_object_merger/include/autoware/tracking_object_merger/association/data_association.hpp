@@ -26,6 +26,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <Eigen/SparseCore>
 
 #include "autoware_perception_msgs/msg/detected_objects.hpp"
 #include "autoware_perception_msgs/msg/tracked_objects.hpp"
@@ -38,6 +39,9 @@
 
 namespace autoware::tracking_object_merger
 {
+// score of each pair of objects, only the pairs which passed all the gates are stored
+using ScoreMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
 class DataAssociation
 {
 private:
@@ -46,6 +50,8 @@ private:
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
   Eigen::MatrixXd max_velocity_diff_matrix_;
+  // for each label of objects1, the max distance to an object0 it can be assigned to
+  std::vector<double> max_dist_per_label_;
   const double score_threshold_;
   std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
 
@@ -55,21 +61,44 @@ public:
     std::vector<int> can_assign_vector, std::vector<double> max_dist_vector,
     std::vector<double> max_rad_vector, std::vector<double> min_iou_vector,
     std::vector<double> max_velocity_diff_vector);
+  /**
+   * @brief solve the assignment of the score matrix
+   *
+   * @note the pairs are split into the connected components of the graph of the stored scores,
+   *       each component being solved separately, so that the solver only sees small dense
+   *       matrices
+   */
   void assign(
-    const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
+    const ScoreMatrix & src, std::unordered_map<int, int> & direct_assignment,
     std::unordered_map<int, int> & reverse_assignment);
-  Eigen::MatrixXd calcScoreMatrix(
+  ScoreMatrix calcScoreMatrix(
     const autoware_perception_msgs::msg::TrackedObjects & objects0,
-    const autoware_perception_msgs::msg::TrackedObjects & objects1);
-  Eigen::MatrixXd calcScoreMatrix(
+    const autoware_perception_msgs::msg::TrackedObjects & objects1) const;
+  ScoreMatrix calcScoreMatrix(
     const autoware_perception_msgs::msg::TrackedObjects & objects0,
-    const std::vector<TrackerState> & trackers);
+    const std::vector<TrackerState> & trackers) const;
   double calcScoreBetweenObjects(
     const autoware_perception_msgs::msg::TrackedObject & object0,
     const autoware_perception_msgs::msg::TrackedObject & object1) const;
+  /**
+   * @brief the max distance between an object1 of the label and an object0 of positive score
+   */
+  double getMaxSearchDistance(const std::uint8_t object1_label) const;
   virtual ~DataAssociation() {}
 };
 
+/**
+ * @brief calc score matrix between objects1 (rows) and objects0 (columns), each row being scored by
+ *        its own data association
+ *
+ * @note objects0 are indexed in an R-tree, and each object1 is only scored against the objects0
+ *       within the max search distance of its data association. The rows are scored in parallel.
+ */
+ScoreMatrix calcScoreMatrix(
+  const autoware_perception_msgs::msg::TrackedObjects & objects0,
+  const std::vector<autoware_perception_msgs::msg::TrackedObject> & objects1,
+  const std::vector<const DataAssociation *> & data_associations);
+
 }  // namespace autoware::tracking_object_merger
 
 #endif  // AUTOWARE__TRACKING_OBJECT_MERGER__ASSOCIATION__DATA_ASSOCIATION_HPP_
@@ -19,14 +19,39 @@
 #include "autoware/tracking_object_merger/utils/utils.hpp"
 #include "autoware_utils/geometry/geometry.hpp"
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 namespace
 {
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+// Define point and box types for R-tree
+typedef bg::model::point<double, 2, bg::cs::cartesian> Point;
+typedef bg::model::box<Point> Box;
+typedef std::pair<Point, size_t> ValueType;  // Point and object index
+
+size_t findRoot(std::vector<size_t> & parents, size_t node)
+{
+  while (parents[node] != node) {
+    parents[node] = parents[parents[node]];
+    node = parents[node];
+  }
+  return node;
+}
+
 double getFormedYawAngle(
   const geometry_msgs::msg::Quaternion & quat0, const geometry_msgs::msg::Quaternion & quat1,
   const bool distinguish_front_or_back = true)
@@ -86,38 +111,78 @@ DataAssociation::DataAssociation(
       max_velocity_diff_vector.data(), max_velocity_diff_label_num, max_velocity_diff_label_num);
     max_velocity_diff_matrix_ = max_velocity_diff_matrix_tmp.transpose();
   }
+  // the search radius of the R-tree query for each label of objects1
+  max_dist_per_label_.assign(static_cast<size_t>(max_dist_matrix_.rows()), 0.0);
+  for (Eigen::Index object1_label = 0; object1_label < max_dist_matrix_.rows(); ++object1_label) {
+    for (Eigen::Index object0_label = 0; object0_label < max_dist_matrix_.cols(); ++object0_label) {
+      if (can_assign_matrix_(object1_label, object0_label)) {
+        auto & max_dist = max_dist_per_label_.at(static_cast<size_t>(object1_label));
+        max_dist = std::max(max_dist, max_dist_matrix_(object1_label, object0_label));
+      }
+    }
+  }
 
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
 
 void DataAssociation::assign(
-  const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
+  const ScoreMatrix & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(static_cast<size_t>(src.rows()));
-  for (int row = 0; row < src.rows(); ++row) {
-    score.at(static_cast<size_t>(row)).resize(static_cast<size_t>(src.cols()));
-    for (int col = 0; col < src.cols(); ++col) {
-      score.at(static_cast<size_t>(row)).at(static_cast<size_t>(col)) = src(row, col);
+  // Split the pairs into connected components, the rows being the nodes [0, rows) and the columns
+  // the nodes [rows, rows + cols)
+  const auto num_rows = static_cast<size_t>(src.rows());
+  const auto num_cols = static_cast<size_t>(src.cols());
+  std::vector<size_t> parents(num_rows + num_cols);
+  std::iota(parents.begin(), parents.end(), size_t{0});
+  std::vector<bool> has_pair(num_rows + num_cols, false);
+  for (Eigen::Index row = 0; row < src.rows(); ++row) {
+    for (ScoreMatrix::InnerIterator itr(src, row); itr; ++itr) {
+      if (itr.value() < score_threshold_) continue;
+      const size_t row_node = static_cast<size_t>(row);
+      const size_t col_node = num_rows + static_cast<size_t>(itr.col());
+      parents[findRoot(parents, col_node)] = findRoot(parents, row_node);
+      has_pair[row_node] = true;
+      has_pair[col_node] = true;
     }
   }
-  // Solve
-  gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
-
-  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
-    if (src(itr->first, itr->second) < score_threshold_) {
-      itr = direct_assignment.erase(itr);
-      continue;
+  // rows and columns of each component, in the index order
+  std::vector<std::pair<std::vector<int>, std::vector<int>>> components;
+  std::unordered_map<size_t, size_t> component_indices;
+  for (size_t node = 0; node < num_rows + num_cols; ++node) {
+    if (!has_pair[node]) continue;
+    const auto [itr, inserted] =
+      component_indices.try_emplace(findRoot(parents, node), components.size());
+    if (inserted) components.emplace_back();
+    if (node < num_rows) {
+      components.at(itr->second).first.push_back(static_cast<int>(node));
     } else {
-      ++itr;
+      components.at(itr->second).second.push_back(static_cast<int>(node - num_rows));
     }
   }
-  for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
-    if (src(itr->second, itr->first) < score_threshold_) {
-      itr = reverse_assignment.erase(itr);
+
+  // Solve
+  for (const auto & [rows, cols] : components) {
+    if (rows.size() == 1 && cols.size() == 1) {
+      direct_assignment[rows.front()] = cols.front();
+      reverse_assignment[cols.front()] = rows.front();
       continue;
-    } else {
-      ++itr;
+    }
+    std::vector<std::vector<double>> score(rows.size(), std::vector<double>(cols.size(), 0.0));
+    for (size_t i = 0; i < rows.size(); ++i) {
+      for (size_t j = 0; j < cols.size(); ++j) {
+        score.at(i).at(j) = src.coeff(rows.at(i), cols.at(j));
+      }
+    }
+    std::unordered_map<int, int> component_direct_assignment, component_reverse_assignment;
+    gnn_solver_ptr_->maximizeLinearAssignment(
+      score, &component_direct_assignment, &component_reverse_assignment);
+    for (const auto & [i, j] : component_direct_assignment) {
+      const auto row_idx = static_cast<size_t>(i);
+      const auto col_idx = static_cast<size_t>(j);
+      if (score.at(row_idx).at(col_idx) < score_threshold_) continue;
+      direct_assignment[rows.at(row_idx)] = cols.at(col_idx);
+      reverse_assignment[cols.at(col_idx)] = rows.at(row_idx);
     }
   }
 }
@@ -128,26 +193,14 @@ void DataAssociation::assign(
  *
  * @param objects0 : measurements
  * @param objects1 : base objects(tracker objects)
- * @return Eigen::MatrixXd
+ * @return ScoreMatrix
  */
-Eigen::MatrixXd DataAssociation::calcScoreMatrix(
+ScoreMatrix DataAssociation::calcScoreMatrix(
   const autoware_perception_msgs::msg::TrackedObjects & objects0,
-  const autoware_perception_msgs::msg::TrackedObjects & objects1)
+  const autoware_perception_msgs::msg::TrackedObjects & objects1) const
 {
-  Eigen::MatrixXd score_matrix = Eigen::MatrixXd::Zero(
-    static_cast<Eigen::Index>(objects1.objects.size()),
-    static_cast<Eigen::Index>(objects0.objects.size()));
-  for (size_t objects1_idx = 0; objects1_idx < objects1.objects.size(); ++objects1_idx) {
-    const auto & object1 = objects1.objects.at(objects1_idx);
-    for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
-      const auto & object0 = objects0.objects.at(objects0_idx);
-      const double score = calcScoreBetweenObjects(object0, object1);
-
-      score_matrix(
-        static_cast<Eigen::Index>(objects1_idx), static_cast<Eigen::Index>(objects0_idx)) = score;
-    }
-  }
-  return score_matrix;
+  const std::vector<const DataAssociation *> data_associations(objects1.objects.size(), this);
+  return tracking_object_merger::calcScoreMatrix(objects0, objects1.objects, data_associations);
 }
 
 /**
@@ -155,26 +208,24 @@ Eigen::MatrixXd DataAssociation::calcScoreMatrix(
  *
  * @param objects0 : measurements
  * @param objects1 : tracker inner objects
- * @return Eigen::MatrixXd
+ * @return ScoreMatrix
  */
-Eigen::MatrixXd DataAssociation::calcScoreMatrix(
+ScoreMatrix DataAssociation::calcScoreMatrix(
   const autoware_perception_msgs::msg::TrackedObjects & objects0,
-  const std::vector<TrackerState> & trackers)
+  const std::vector<TrackerState> & trackers) const
 {
-  Eigen::MatrixXd score_matrix = Eigen::MatrixXd::Zero(
-    static_cast<Eigen::Index>(trackers.size()), static_cast<Eigen::Index>(objects0.objects.size()));
-  for (size_t trackers_idx = 0; trackers_idx < trackers.size(); ++trackers_idx) {
-    const auto & object1 = trackers.at(trackers_idx).getObject();
-
-    for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
-      const auto & object0 = objects0.objects.at(objects0_idx);
-      const double score = calcScoreBetweenObjects(object0, object1);
-
-      score_matrix(
-        static_cast<Eigen::Index>(trackers_idx), static_cast<Eigen::Index>(objects0_idx)) = score;
-    }
+  std::vector<autoware_perception_msgs::msg::TrackedObject> objects1;
+  objects1.reserve(trackers.size());
+  for (const auto & tracker : trackers) {
+    objects1.push_back(tracker.getObject());
   }
-  return score_matrix;
+  const std::vector<const DataAssociation *> data_associations(objects1.size(), this);
+  return tracking_object_merger::calcScoreMatrix(objects0, objects1, data_associations);
+}
+
+double DataAssociation::getMaxSearchDistance(const std::uint8_t object1_label) const
+{
+  return max_dist_per_label_.at(object1_label);
 }
 
 double DataAssociation::calcScoreBetweenObjects(
@@ -237,4 +288,60 @@ double DataAssociation::calcScoreBetweenObjects(
   return score;
 }
 
+ScoreMatrix calcScoreMatrix(
+  const autoware_perception_msgs::msg::TrackedObjects & objects0,
+  const std::vector<autoware_perception_msgs::msg::TrackedObject> & objects1,
+  const std::vector<const DataAssociation *> & data_associations)
+{
+  ScoreMatrix score_matrix(
+    static_cast<Eigen::Index>(objects1.size()), static_cast<Eigen::Index>(objects0.objects.size()));
+  if (objects0.objects.empty() || objects1.empty()) {
+    return score_matrix;
+  }
+
+  // Build R-tree of objects0
+  std::vector<ValueType> rtree_points;
+  rtree_points.reserve(objects0.objects.size());
+  for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
+    const auto & position =
+      objects0.objects.at(objects0_idx).kinematics.pose_with_covariance.pose.position;
+    rtree_points.emplace_back(Point(position.x, position.y), objects0_idx);
+  }
+  const bgi::rtree<ValueType, bgi::quadratic<16>> rtree(rtree_points.begin(), rtree_points.end());
+
+  // For each object1, score the nearby objects0
+  std::vector<std::vector<Eigen::Triplet<double>>> row_scores(objects1.size());
+#pragma omp parallel for schedule(dynamic)
+  for (size_t objects1_idx = 0; objects1_idx < objects1.size(); ++objects1_idx) {
+    const auto & object1 = objects1.at(objects1_idx);
+    const auto & data_association = *data_associations.at(objects1_idx);
+    const double max_dist = data_association.getMaxSearchDistance(
+      autoware::object_recognition_utils::getHighestProbLabel(object1.classification));
+    if (max_dist <= 0.0) continue;
+
+    const auto & position = object1.kinematics.pose_with_covariance.pose.position;
+    const Box query_box(
+      Point(position.x - max_dist, position.y - max_dist),
+      Point(position.x + max_dist, position.y + max_dist));
+    std::vector<ValueType> nearby_objects0;
+    rtree.query(bgi::within(query_box), std::back_inserter(nearby_objects0));
+
+    for (const auto & [point, objects0_idx] : nearby_objects0) {
+      const double score =
+        data_association.calcScoreBetweenObjects(objects0.objects.at(objects0_idx), object1);
+      if (0.0 < score) {
+        row_scores.at(objects1_idx)
+          .emplace_back(static_cast<int>(objects1_idx), static_cast<int>(objects0_idx), score);
+      }
+    }
+  }
+
+  std::vector<Eigen::Triplet<double>> scores;
+  for (const auto & row_score : row_scores) {
+    scores.insert(scores.end(), row_score.begin(), row_score.end());
+  }
+  score_matrix.setFromTriplets(scores.begin(), scores.end());
+  return score_matrix;
+}
+
 }  // namespace autoware::tracking_object_merger
@@ -48,7 +48,7 @@ double getUnixTime(const std_msgs::msg::Header & header)
 }
 
 // calc association score matrix
-Eigen::MatrixXd calcScoreMatrixForAssociation(
+ScoreMatrix calcScoreMatrixForAssociation(
   const MEASUREMENT_STATE measurement_state,
   const autoware_perception_msgs::msg::TrackedObjects & objects0,
   const std::vector<TrackerState> & trackers,
@@ -59,33 +59,28 @@ Eigen::MatrixXd calcScoreMatrixForAssociation(
   // get current time
   const rclcpp::Time current_time = rclcpp::Time(objects0.header.stamp);
 
-  // calc score matrix
-  Eigen::MatrixXd score_matrix = Eigen::MatrixXd::Zero(
-    static_cast<Eigen::Index>(trackers.size()), static_cast<Eigen::Index>(objects0.objects.size()));
-  for (size_t trackers_idx = 0; trackers_idx < trackers.size(); ++trackers_idx) {
-    const auto & tracker_obj = trackers.at(trackers_idx);
-    const auto & object1 = tracker_obj.getObject();
+  // switch data association by input and trackers measurement state
+  // we assume that lidar and radar are exclusive
+  std::vector<autoware_perception_msgs::msg::TrackedObject> objects1;
+  std::vector<const DataAssociation *> data_associations;
+  objects1.reserve(trackers.size());
+  data_associations.reserve(trackers.size());
+  const auto input_has_lidar = measurement_state & MEASUREMENT_STATE::LIDAR;
+  for (const auto & tracker_obj : trackers) {
     const auto & tracker_state = tracker_obj.getCurrentMeasurementState(current_time);
-
-    for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
-      const auto & object0 = objects0.objects.at(objects0_idx);
-      // switch calc score function by input and trackers measurement state
-      // we assume that lidar and radar are exclusive
-      double score;
-      const auto input_has_lidar = measurement_state & MEASUREMENT_STATE::LIDAR;
-      const auto tracker_has_lidar = tracker_state & MEASUREMENT_STATE::LIDAR;
-      if (input_has_lidar && tracker_has_lidar) {
-        score = data_association_map.at("lidar-lidar")->calcScoreBetweenObjects(object0, object1);
-      } else if (!input_has_lidar && !tracker_has_lidar) {
-        score = data_association_map.at("radar-radar")->calcScoreBetweenObjects(object0, object1);
-      } else {
-        score = data_association_map.at("lidar-radar")->calcScoreBetweenObjects(object0, object1);
-      }
-      score_matrix(
-        static_cast<Eigen::Index>(trackers_idx), static_cast<Eigen::Index>(objects0_idx)) = score;
+    const auto tracker_has_lidar = tracker_state & MEASUREMENT_STATE::LIDAR;
+    objects1.push_back(tracker_obj.getObject());
+    if (input_has_lidar && tracker_has_lidar) {
+      data_associations.push_back(data_association_map.at("lidar-lidar").get());
+    } else if (!input_has_lidar && !tracker_has_lidar) {
+      data_associations.push_back(data_association_map.at("radar-radar").get());
+    } else {
+      data_associations.push_back(data_association_map.at("lidar-radar").get());
     }
   }
-  return score_matrix;
+
+  // calc score matrix
+  return calcScoreMatrix(objects0, objects1, data_associations);
 }
 
 DecorativeTrackerMergerNode::DecorativeTrackerMergerNode(const rclcpp::NodeOptions & node_options)
@@ -347,7 +342,7 @@ bool DecorativeTrackerMergerNode::decorativeMerger(
   /* global nearest neighbor */
   std::unordered_map<int, int> direct_assignment, reverse_assignment;
   const auto & objects1 = input_objects_msg->objects;
-  Eigen::MatrixXd score_matrix = calcScoreMatrixForAssociation(
+  const ScoreMatrix score_matrix = calcScoreMatrixForAssociation(
     input_sensor, *input_objects_msg, inner_tracker_objects_, data_association_map_);
   data_association_map_.at("lidar-lidar")
     ->assign(score_matrix, direct_assignment, reverse_assignment);
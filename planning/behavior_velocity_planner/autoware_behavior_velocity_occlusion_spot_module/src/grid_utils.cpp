@@ -78,12 +78,12 @@ bool isCollisionFree(
     for (const auto & point : polygon.outer()) {
       grid_polygon.addVertex({point.x(), point.y()});
     }
-    for (autoware::grid_map_utils::PolygonIterator iterator(grid, grid_polygon);
-         !iterator.isPastEnd(); ++iterator) {
-      const grid_map::Index & index = *iterator;
-      if (grid_data(index.x(), index.y()) == grid_utils::occlusion_cost_value::OCCUPIED) {
-        return false;
-      }
+    constexpr auto occupied = static_cast<float>(grid_utils::occlusion_cost_value::OCCUPIED);
+    const auto is_occupied = [&](const auto & block) { return (block.array() == occupied).any(); };
+    if (autoware::grid_map_utils::anyOfRowSpans(
+          grid_data, autoware::grid_map_utils::calculateRowSpans(grid, grid_polygon),
+          is_occupied)) {
+      return false;
     }
   } catch (const std::invalid_argument & e) {
     std::cerr << e.what() << std::endl;
@@ -37,17 +37,16 @@ void maskPolygons(grid_map::GridMap & grid_map, const ObstacleMasks & obstacle_m
   if (!obstacle_masks.positive_mask.outer().empty()) {
     const auto layer_copy = grid_map["layer"];
     layer.setConstant(0.0);
-    grid_map::Position position;
-    for (autoware::grid_map_utils::PolygonIterator iterator(
-           grid_map, convert(obstacle_masks.positive_mask));
-         !iterator.isPastEnd(); ++iterator)
-      layer((*iterator)(0), (*iterator)(1)) = layer_copy((*iterator)(0), (*iterator)(1));
+    const auto spans =
+      autoware::grid_map_utils::calculateRowSpans(grid_map, convert(obstacle_masks.positive_mask));
+    for (const auto & span : spans)
+      autoware::grid_map_utils::spanBlock(layer, span) =
+        autoware::grid_map_utils::spanBlock(layer_copy, span);
   }
 
   for (const auto & negative_mask : obstacle_masks.negative_masks)
-    for (autoware::grid_map_utils::PolygonIterator iterator(grid_map, convert(negative_mask));
-         !iterator.isPastEnd(); ++iterator)
-      layer((*iterator)(0), (*iterator)(1)) = 0.0;
+    autoware::grid_map_utils::fillRowSpans(
+      layer, autoware::grid_map_utils::calculateRowSpans(grid_map, convert(negative_mask)), 0.0f);
 }
 
 void threshold(grid_map::GridMap & grid_map, const double threshold)
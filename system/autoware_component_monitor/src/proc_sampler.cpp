@@ -0,0 +1,235 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "proc_sampler.hpp"
+
+#include "unit_conversions.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::component_monitor
+{
+namespace
+{
+// The file descriptors already opened are closed by their owners if this throws
+int open_or_throw(const std::string & path)
+{
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  return fd;
+}
+
+double monotonic_seconds()
+{
+  timespec ts{};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+// Return the number following the key, e.g. "MemTotal:       65532208 kB"
+std::uint64_t find_meminfo_value(const std::string & meminfo, const char * key)
+{
+  const auto pos = meminfo.find(key);
+  if (pos == std::string::npos) {
+    throw std::runtime_error(std::string("Failed to find ") + key + " in /proc/meminfo");
+  }
+  return std::strtoull(meminfo.c_str() + pos + std::char_traits<char>::length(key), nullptr, 10);
+}
+}  // namespace
+
+ProcSampler::ProcSampler(const pid_t pid)
+: pid_(pid),
+  jiffies_per_second_(static_cast<double>(sysconf(_SC_CLK_TCK))),
+  page_size_(static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE))),
+  task_dir_("/proc/" + std::to_string(pid) + "/task"),
+  task_dir_handle_(opendir(task_dir_.c_str()), &closedir),
+  stat_fd_(open_or_throw("/proc/" + std::to_string(pid) + "/stat")),
+  statm_fd_(open_or_throw("/proc/" + std::to_string(pid) + "/statm")),
+  meminfo_fd_(open_or_throw("/proc/meminfo"))
+{
+  if (task_dir_handle_ == nullptr) {
+    throw std::runtime_error("Failed to open " + task_dir_);
+  }
+  buffer_.resize(4096);
+}
+
+ProcSampler::FileDescriptor::FileDescriptor(FileDescriptor && other) noexcept
+: fd_(std::exchange(other.fd_, -1))
+{
+}
+
+ProcSampler::FileDescriptor & ProcSampler::FileDescriptor::operator=(
+  FileDescriptor && other) noexcept
+{
+  if (this != &other) {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+    fd_ = std::exchange(other.fd_, -1);
+  }
+  return *this;
+}
+
+ProcSampler::FileDescriptor::~FileDescriptor()
+{
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+const std::string & ProcSampler::read_fd(const int fd)
+{
+  buffer_.resize(buffer_.capacity());
+  while (true) {
+    // procfs regenerates the content when it is read from the beginning
+    const ssize_t size = pread(fd, buffer_.data(), buffer_.size(), 0);
+    if (size < 0) {
+      throw std::runtime_error("Failed to read procfs: errno " + std::to_string(errno));
+    }
+    if (static_cast<size_t>(size) < buffer_.size()) {
+      buffer_.resize(static_cast<size_t>(size));
+      return buffer_;
+    }
+    buffer_.resize(buffer_.size() * 2);
+  }
+}
+
+std::uint64_t ProcSampler::parse_stat_jiffies(const std::string & stat, std::string * name)
+{
+  // The command name may contain spaces and parentheses, so look for the last ')'
+  const auto open_pos = stat.find('(');
+  const auto close_pos = stat.rfind(')');
+  if (open_pos == std::string::npos || close_pos == std::string::npos || close_pos < open_pos) {
+    throw std::runtime_error("Malformed stat: " + stat);
+  }
+  if (name != nullptr) {
+    *name = stat.substr(open_pos + 1, close_pos - open_pos - 1);
+  }
+
+  // Fields after the name start from the 3rd one (state); utime and stime are the 14th and 15th
+  const char * p = stat.c_str() + close_pos + 1;
+  for (int field = 3; field < 14; ++field) {
+    while (*p == ' ') ++p;
+    while (*p != ' ' && *p != '\0') ++p;
+  }
+  if (*p == '\0') {
+    throw std::runtime_error("Malformed stat: " + stat);
+  }
+  char * end = nullptr;
+  const std::uint64_t utime = std::strtoull(p, &end, 10);
+  const std::uint64_t stime = std::strtoull(end, nullptr, 10);
+  return utime + stime;
+}
+
+ProcSampler::Sample ProcSampler::sample()
+{
+  const double now = monotonic_seconds();
+  const double elapsed = now - last_time_;
+  const bool has_last = has_last_ && elapsed > 0.0;
+
+  Sample result{};
+
+  const std::uint64_t jiffies = parse_stat_jiffies(read_fd(stat_fd_.get()), nullptr);
+  result.cpu_cores_utilized =
+    has_last ? static_cast<float>(
+                 static_cast<double>(jiffies - last_jiffies_) / jiffies_per_second_ / elapsed)
+             : 0.0f;
+
+  // statm: size resident shared text lib data dt [pages]
+  const std::string & statm = read_fd(statm_fd_.get());
+  const char * resident = statm.c_str() + statm.find(' ');
+  result.process_memory_bytes = std::strtoull(resident, nullptr, 10) * page_size_;
+
+  const std::string & meminfo = read_fd(meminfo_fd_.get());
+  result.total_memory_bytes =
+    unit_conversions::kib_to_bytes(find_meminfo_value(meminfo, "MemTotal:"));
+  result.free_memory_bytes = unit_conversions::kib_to_bytes(find_meminfo_value(meminfo, "MemFree:"));
+
+  sample_threads(elapsed, has_last, result.threads);
+
+  last_jiffies_ = jiffies;
+  last_time_ = now;
+  has_last_ = true;
+  return result;
+}
+
+void ProcSampler::sample_threads(
+  const double elapsed, const bool has_last, std::vector<ThreadUsage> & threads)
+{
+  // procfs lists the current threads again after the directory is rewound
+  rewinddir(task_dir_handle_.get());
+
+  for (auto & [tid, thread] : threads_) {
+    thread.alive = false;
+  }
+
+  while (const dirent * entry = readdir(task_dir_handle_.get())) {
+    if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+    const auto tid = static_cast<pid_t>(std::strtol(entry->d_name, nullptr, 10));
+
+    auto itr = threads_.find(tid);
+    const bool is_new = itr == threads_.end();
+    if (is_new) {
+      const std::string path = task_dir_ + "/" + entry->d_name + "/stat";
+      const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) continue;  // the thread has just exited
+      itr = threads_.emplace(tid, ThreadState{FileDescriptor(fd), 0, "", false}).first;
+    }
+
+    ThreadState & thread = itr->second;
+    std::uint64_t jiffies = 0;
+    try {
+      jiffies = parse_stat_jiffies(read_fd(thread.fd.get()), &thread.name);
+    } catch (const std::runtime_error &) {
+      continue;  // the thread has just exited
+    }
+
+    const bool has_delta = has_last && !is_new;
+    const float cpu =
+      has_delta ? static_cast<float>(
+                    static_cast<double>(jiffies - thread.jiffies) / jiffies_per_second_ / elapsed)
+                : 0.0f;
+    thread.jiffies = jiffies;
+    thread.alive = true;
+    threads.push_back(ThreadUsage{tid, thread.name, cpu});
+  }
+
+  for (auto itr = threads_.begin(); itr != threads_.end();) {
+    if (itr->second.alive) {
+      ++itr;
+    } else {
+      itr = threads_.erase(itr);
+    }
+  }
+
+  std::sort(threads.begin(), threads.end(), [](const ThreadUsage & a, const ThreadUsage & b) {
+    return a.cpu_cores_utilized > b.cpu_cores_utilized;
+  });
+}
+
+}  // namespace autoware::component_monitor
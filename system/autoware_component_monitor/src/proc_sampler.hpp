@@ -0,0 +1,135 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROC_SAMPLER_HPP_
+#define PROC_SAMPLER_HPP_
+
+#include <dirent.h>
+#include <sys/types.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace autoware::component_monitor
+{
+/**
+ * @brief Samples the resource usage of a process from procfs.
+ *
+ * @details The files under /proc are kept open and read again with pread(), which makes procfs
+ * regenerate their contents, so no process is spawned and no file is opened per sample except for
+ * new threads. The task directory is rewound to find the threads. CPU usage is computed from the
+ * difference of utime + stime between two samples.
+ */
+class ProcSampler
+{
+public:
+  struct ThreadUsage
+  {
+    pid_t tid;
+    std::string name;
+    float cpu_cores_utilized;
+  };
+
+  struct Sample
+  {
+    float cpu_cores_utilized;
+    std::uint64_t process_memory_bytes;
+    std::uint64_t total_memory_bytes;
+    std::uint64_t free_memory_bytes;
+    // sorted by cpu_cores_utilized in descending order
+    std::vector<ThreadUsage> threads;
+  };
+
+  /**
+   * @param pid The process to sample
+   * @exception std::runtime_error Thrown if the procfs files of the process can not be opened.
+   */
+  explicit ProcSampler(pid_t pid);
+
+  ProcSampler(const ProcSampler &) = delete;
+  ProcSampler & operator=(const ProcSampler &) = delete;
+
+  /**
+   * @brief Read the current usage.
+   *
+   * @details The CPU usage of the first sample is 0 because there is no previous sample.
+   * @exception std::runtime_error Thrown if the procfs files can not be read.
+   */
+  Sample sample();
+
+  /**
+   * @brief Parse utime + stime [jiffies] and the command name from the content of a stat file.
+   *
+   * @param stat The content of /proc/PID/stat or /proc/PID/task/TID/stat
+   * @param name The command name between the parentheses is written if not null
+   * @return utime + stime
+   * @exception std::runtime_error Thrown if the content is malformed.
+   */
+  static std::uint64_t parse_stat_jiffies(const std::string & stat, std::string * name);
+
+private:
+  // Owns a file descriptor, which is closed on destruction
+  class FileDescriptor
+  {
+  public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    FileDescriptor(FileDescriptor && other) noexcept;
+    FileDescriptor & operator=(FileDescriptor && other) noexcept;
+    ~FileDescriptor();
+
+    FileDescriptor(const FileDescriptor &) = delete;
+    FileDescriptor & operator=(const FileDescriptor &) = delete;
+
+    int get() const { return fd_; }
+
+  private:
+    int fd_;
+  };
+
+  struct ThreadState
+  {
+    FileDescriptor fd;
+    std::uint64_t jiffies;
+    std::string name;
+    bool alive;
+  };
+
+  const pid_t pid_;
+  const double jiffies_per_second_;
+  const std::uint64_t page_size_;
+  const std::string task_dir_;
+
+  // not decltype(&closedir), whose nonnull attribute is ignored in a template argument
+  std::unique_ptr<DIR, int (*)(DIR *)> task_dir_handle_;
+  FileDescriptor stat_fd_;
+  FileDescriptor statm_fd_;
+  FileDescriptor meminfo_fd_;
+  std::unordered_map<pid_t, ThreadState> threads_;
+
+  std::uint64_t last_jiffies_{0};
+  double last_time_{0.0};
+  bool has_last_{false};
+
+  std::string buffer_;
+
+  const std::string & read_fd(int fd);
+  void sample_threads(double elapsed, bool has_last, std::vector<ThreadUsage> & threads);
+};
+
+}  // namespace autoware::component_monitor
+
+#endif  // PROC_SAMPLER_HPP_
@@ -0,0 +1,95 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "proc_sampler.hpp"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+// Measure the cost of one sample of this process, which is done on every timer tick, against
+// running `top -b -n 1 -E k -p PID` as the monitor did before. The CPU time of the spawned top
+// processes is included for the reference because it is charged to the machine being monitored.
+
+namespace
+{
+double cpu_seconds(const int who)
+{
+  rusage usage{};
+  getrusage(who, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+std::string run_top(const pid_t pid)
+{
+  const std::string cmd = "top -b -n 1 -E k -p " + std::to_string(pid);
+  FILE * pipe = popen(cmd.c_str(), "r");
+  if (pipe == nullptr) return "";
+  std::string output;
+  char buffer[4096];
+  while (const size_t size = fread(buffer, 1, sizeof(buffer), pipe)) {
+    output.append(buffer, size);
+  }
+  pclose(pipe);
+  return output;
+}
+}  // namespace
+
+int main()
+{
+  using autoware::component_monitor::ProcSampler;
+  const pid_t pid = getpid();
+
+  constexpr int sampler_iterations = 10000;
+  ProcSampler sampler(pid);
+  size_t thread_count = 0;
+  double cpu_start = cpu_seconds(RUSAGE_SELF);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < sampler_iterations; ++i) {
+    thread_count += sampler.sample().threads.size();
+  }
+  const double sampler_us =
+    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+    sampler_iterations;
+  const double sampler_cpu_us = (cpu_seconds(RUSAGE_SELF) - cpu_start) * 1e6 / sampler_iterations;
+
+  constexpr int top_iterations = 20;
+  size_t output_size = 0;
+  cpu_start = cpu_seconds(RUSAGE_SELF) + cpu_seconds(RUSAGE_CHILDREN);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < top_iterations; ++i) {
+    output_size += run_top(pid).size();
+  }
+  const double top_us =
+    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+    top_iterations;
+  const double top_cpu_us =
+    (cpu_seconds(RUSAGE_SELF) + cpu_seconds(RUSAGE_CHILDREN) - cpu_start) * 1e6 / top_iterations;
+
+  std::cout << "procfs sampler: " << sampler_us << " [us] wall, " << sampler_cpu_us
+            << " [us] cpu per sample (" << thread_count / sampler_iterations << " threads)"
+            << std::endl;
+  if (output_size == 0) {
+    std::cout << "top: not available" << std::endl;
+  } else {
+    std::cout << "top: " << top_us << " [us] wall, " << top_cpu_us << " [us] cpu per sample"
+              << std::endl;
+  }
+  return 0;
+}
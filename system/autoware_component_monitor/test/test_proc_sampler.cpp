@@ -0,0 +1,115 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "proc_sampler.hpp"
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace autoware::component_monitor
+{
+namespace
+{
+std::ptrdiff_t count_open_fds()
+{
+  return std::distance(
+    std::filesystem::directory_iterator("/proc/self/fd"), std::filesystem::directory_iterator{});
+}
+}  // namespace
+
+TEST(ProcSampler, parse_stat_jiffies)
+{
+  // The command name contains spaces and parentheses
+  const std::string stat =
+    "1234 (a (b) c) S 1 1234 1234 0 -1 4194304 100 0 0 0 25 17 0 0 20 0 3 0 100 1000 10";
+  std::string name;
+  EXPECT_EQ(ProcSampler::parse_stat_jiffies(stat, &name), 42U);
+  EXPECT_EQ(name, "a (b) c");
+  EXPECT_THROW(ProcSampler::parse_stat_jiffies("1234 (abc) S 1", nullptr), std::runtime_error);
+  EXPECT_THROW(ProcSampler::parse_stat_jiffies("", nullptr), std::runtime_error);
+}
+
+TEST(ProcSampler, sample)
+{
+  std::atomic<bool> running{true};
+  std::thread busy([&running]() {
+    pthread_setname_np(pthread_self(), "busy_thread");
+    while (running) {
+    }
+  });
+
+  ProcSampler sampler(getpid());
+  const auto first = sampler.sample();
+  EXPECT_EQ(first.cpu_cores_utilized, 0.0f);
+  EXPECT_GT(first.process_memory_bytes, 0U);
+  EXPECT_GT(first.total_memory_bytes, first.free_memory_bytes);
+  EXPECT_GE(first.threads.size(), 2U);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  const auto second = sampler.sample();
+  running = false;
+  busy.join();
+
+  EXPECT_GT(second.cpu_cores_utilized, 0.0f);
+  const auto busy_itr =
+    std::find_if(second.threads.begin(), second.threads.end(), [](const auto & thread) {
+      return thread.name == "busy_thread";
+    });
+  ASSERT_NE(busy_itr, second.threads.end());
+  EXPECT_GT(busy_itr->cpu_cores_utilized, 0.0f);
+  EXPECT_TRUE(std::is_sorted(
+    second.threads.begin(), second.threads.end(), [](const auto & a, const auto & b) {
+      return a.cpu_cores_utilized > b.cpu_cores_utilized;
+    }));
+
+  // The exited thread is not reported anymore
+  const auto third = sampler.sample();
+  EXPECT_EQ(
+    std::count_if(
+      third.threads.begin(), third.threads.end(),
+      [](const auto & thread) { return thread.name == "busy_thread"; }),
+    0);
+}
+
+TEST(ProcSampler, close_file_descriptors)
+{
+  const auto open_fds = count_open_fds();
+
+  // no process has the pid above pid_max
+  EXPECT_THROW(ProcSampler(1 << 23), std::runtime_error);
+  EXPECT_EQ(count_open_fds(), open_fds);
+
+  {
+    ProcSampler sampler(getpid());
+    sampler.sample();
+    std::thread([]() {}).join();
+    std::thread short_lived([&sampler]() { sampler.sample(); });
+    short_lived.join();
+    // the stat file of the exited thread is closed
+    sampler.sample();
+  }
+  EXPECT_EQ(count_open_fds(), open_fds);
+}
+}  // namespace autoware::component_monitor
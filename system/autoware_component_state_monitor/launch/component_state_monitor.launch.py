@@ -46,12 +46,37 @@ def create_topic_monitor_node(row):
     return IncludeLaunchDescription(include, launch_arguments=arguments)
 
 
+def create_multi_topic_monitor_node(rows):
+    # a single node monitoring all the topics, with the same diagnostic names as the nodes above
+    param = {"topics": [row["args"]["node_name_suffix"] for row in rows]}
+    for row in rows:
+        args = {k: v for k, v in row["args"].items() if k != "node_name_suffix"}
+        for key in ("warn_rate", "error_rate", "timeout"):
+            if key in args:
+                args[key] = float(args[key])
+        args["diag_name"] = create_topic_monitor_name(row)
+        param[row["args"]["node_name_suffix"]] = args
+    return ComposableNode(
+        namespace="component_state_monitor",
+        name="topic_state_monitor",
+        package="autoware_topic_state_monitor",
+        plugin="autoware::topic_state_monitor::MultiTopicStateMonitorNode",
+        parameters=[param],
+    )
+
+
 def launch_setup(context, *args, **kwargs):
     # create topic monitors
     mode = LaunchConfiguration("mode").perform(context)
     rows = yaml.safe_load(Path(LaunchConfiguration("file").perform(context)).read_text())
     rows = [row for row in rows if mode in row["mode"]]
-    topic_monitor_nodes = [create_topic_monitor_node(row) for row in rows]
+    use_multi_topic_monitor = LaunchConfiguration("use_multi_topic_monitor").perform(context)
+    topic_monitor_nodes = []
+    topic_monitor_components = []
+    if use_multi_topic_monitor.lower() != "true":
+        topic_monitor_nodes = [create_topic_monitor_node(row) for row in rows]
+    elif rows:
+        topic_monitor_components = [create_multi_topic_monitor_node(rows)]
     topic_monitor_names = [create_topic_monitor_name(row) for row in rows]
     topic_monitor_param = defaultdict(lambda: defaultdict(list))
     for row in rows:
@@ -71,7 +96,7 @@ def launch_setup(context, *args, **kwargs):
         name="container",
         package="rclcpp_components",
         executable="component_container",
-        composable_node_descriptions=[component],
+        composable_node_descriptions=[component, *topic_monitor_components],
     )
     return [container, *topic_monitor_nodes]
 
@@ -81,6 +106,7 @@ def generate_launch_description():
         [
             DeclareLaunchArgument("file"),
             DeclareLaunchArgument("mode"),
+            DeclareLaunchArgument("use_multi_topic_monitor", default_value="false"),
             OpaqueFunction(function=launch_setup),
         ]
     )
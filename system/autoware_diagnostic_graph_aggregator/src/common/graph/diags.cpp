@@ -19,7 +19,9 @@
 #include "graph/links.hpp"
 #include "graph/logic.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -79,4 +81,12 @@ void DiagUnit::update(const rclcpp::Time & stamp, const DiagnosticStatus & statu
   status_.values = status.values;
 }
 
+std::optional<rclcpp::Time> DiagUnit::deadline() const
+{
+  const auto timeout = timeout_->deadline();
+  const auto hysteresis = hysteresis_->deadline();
+  if (timeout && hysteresis) return std::min(*timeout, *hysteresis);
+  return timeout ? timeout : hysteresis;
+}
+
 }  // namespace autoware::diagnostic_graph_aggregator
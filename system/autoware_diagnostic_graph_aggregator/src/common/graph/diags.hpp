@@ -23,6 +23,7 @@
 #include <rclcpp/time.hpp>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -44,6 +45,7 @@ public:
   std::string name() const;
   void update(const rclcpp::Time & stamp);
   void update(const rclcpp::Time & stamp, const DiagnosticStatus & status);
+  std::optional<rclcpp::Time> deadline() const;
 
 private:
   DiagLeafStruct struct_;
@@ -21,7 +21,9 @@
 #include "graph/nodes.hpp"
 #include "graph/units.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -48,6 +50,23 @@ Graph::Graph(const std::string & path, const std::string & id, std::shared_ptr<L
   for (const auto & diag : diags_) {
     diag_dict_[diag->name()] = diag;
   }
+
+  const auto size = nodes_.size() + diags_.size();
+  dirty_.resize(size, false);
+  scheduled_.resize(size);
+  dependents_.resize(nodes_.size());
+  for (const auto & node : nodes_) {
+    if (const auto dependency = dynamic_cast<NodeUnit *>(node->dependency_unit())) {
+      dependents_[dependency->index()].push_back(node);
+    }
+  }
+
+  // Evaluate all units at the first update.
+  for (const auto & node : nodes_) status_.nodes.push_back(node->create_status());
+  for (const auto & diag : diags_) status_.diags.push_back(diag->create_status());
+  for (const auto & node : nodes_) mark_dirty(node->index());
+  for (const auto & diag : diags_) mark_dirty(diag->index());
+  status_changed_ = true;
 }
 
 Graph::~Graph()
@@ -56,9 +75,90 @@ Graph::~Graph()
 
 void Graph::update(const rclcpp::Time & stamp)
 {
-  // Update the graph from the leaves. Note that the nodes are topological sorted.
-  std::for_each(diags_.rbegin(), diags_.rend(), [stamp](auto & diag) { diag->update(stamp); });
-  std::for_each(nodes_.rbegin(), nodes_.rend(), [stamp](auto & node) { node->update(stamp); });
+  status_changed_ = false;
+
+  // Wake up the units whose level may change with time. Skip the deadlines that have been replaced.
+  while (!deadlines_.empty() && deadlines_.top().first <= stamp.nanoseconds()) {
+    const auto [deadline, index] = deadlines_.top();
+    deadlines_.pop();
+    if (scheduled_[index] == deadline) {
+      scheduled_[index] = std::nullopt;
+      mark_dirty(index);
+    }
+  }
+
+  // Update the graph from the leaves and propagate only the level changes.
+  for (const auto & diag : dirty_diags_) {
+    const auto level = diag->level();
+    diag->update(stamp);
+    dirty_[diag->index()] = false;
+    schedule(diag->index(), diag->deadline());
+    write_status(diag);
+    if (level != diag->level()) {
+      for (const auto & parent : diag->parent_units()) mark_dirty(parent->index());
+    }
+  }
+  dirty_diags_.clear();
+
+  while (!dirty_nodes_.empty()) {
+    const auto node = nodes_[dirty_nodes_.top()];
+    dirty_nodes_.pop();
+    const auto level = node->level();
+    node->update(stamp);
+    dirty_[node->index()] = false;
+    schedule(node->index(), node->deadline());
+    write_status(node);
+    if (level != node->level()) {
+      for (const auto & parent : node->parent_units()) mark_dirty(parent->index());
+      for (const auto & dependent : dependents_[node->index()]) write_status(dependent);
+    }
+  }
+}
+
+void Graph::mark_dirty(int index)
+{
+  if (dirty_[index]) return;
+  dirty_[index] = true;
+
+  const auto size = static_cast<int>(nodes_.size());
+  if (index < size) {
+    dirty_nodes_.push(index);
+  } else {
+    dirty_diags_.push_back(diags_[index - size]);
+  }
+}
+
+void Graph::schedule(int index, const std::optional<rclcpp::Time> & deadline)
+{
+  if (!deadline) return;
+
+  // Wake up slightly early so that rounding never delays the evaluation. An early evaluation does
+  // not change the state and reschedules the unit. A later deadline is checked by that evaluation.
+  constexpr int64_t margin = 1000;
+  const auto nanoseconds = deadline->nanoseconds() - margin;
+  if (scheduled_[index] && *scheduled_[index] <= nanoseconds) return;
+  scheduled_[index] = nanoseconds;
+  deadlines_.emplace(nanoseconds, index);
+}
+
+void Graph::write_status(NodeUnit * node)
+{
+  auto status = node->create_status();
+  auto & target = status_.nodes[node->index()];
+  if (status != target) {
+    target = std::move(status);
+    status_changed_ = true;
+  }
+}
+
+void Graph::write_status(DiagUnit * diag)
+{
+  auto status = diag->create_status();
+  auto & target = status_.diags[diag->index() - nodes_.size()];
+  if (status != target) {
+    target = std::move(status);
+    status_changed_ = true;
+  }
 }
 
 bool Graph::update(const rclcpp::Time & stamp, const DiagnosticArray & array)
@@ -74,6 +174,7 @@ bool Graph::update(const rclcpp::Time & stamp, const DiagnosticArray & array)
     const auto iter = diag_dict_.find(status.name);
     if (iter != diag_dict_.end()) {
       iter->second->update(array.header.stamp, status);
+      mark_dirty(iter->second->index());
     } else {
       unknown_diags_[status.name] = status;
     }
@@ -104,11 +205,10 @@ DiagGraphStruct Graph::create_struct_msg(const rclcpp::Time & stamp) const
 
 DiagGraphStatus Graph::create_status_msg(const rclcpp::Time & stamp) const
 {
-  DiagGraphStatus msg;
+  // The status of each unit is written when it is evaluated.
+  DiagGraphStatus msg = status_;
   msg.stamp = stamp;
   msg.id = id_;
-  for (const auto & node : nodes_) msg.nodes.push_back(node->create_status());
-  for (const auto & diag : diags_) msg.diags.push_back(diag->create_status());
   return msg;
 }
 
@@ -123,11 +223,13 @@ DiagnosticArray Graph::create_unknown_msg(const rclcpp::Time & stamp) const
 void Graph::set_initializing(bool initializing)
 {
   for (const auto & node : nodes_) node->set_initializing(initializing);
+  for (const auto & node : nodes_) mark_dirty(node->index());
 }
 
 void Graph::reset()
 {
   for (const auto & node : nodes_) node->reset();
+  for (const auto & node : nodes_) mark_dirty(node->index());
 }
 
 }  // namespace autoware::diagnostic_graph_aggregator
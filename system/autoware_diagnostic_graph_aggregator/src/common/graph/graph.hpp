@@ -21,9 +21,14 @@
 
 #include <rclcpp/time.hpp>
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <queue>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace autoware::diagnostic_graph_aggregator
@@ -35,8 +40,11 @@ public:
   explicit Graph(const std::string & path);
   Graph(const std::string & path, const std::string & id, std::shared_ptr<Logger> logger);
   ~Graph();
+
+  // Evaluate the units whose input has changed or whose deadline has passed, and their ancestors.
   void update(const rclcpp::Time & stamp);
   bool update(const rclcpp::Time & stamp, const DiagnosticArray & array);
+  bool is_status_changed() const { return status_changed_; }  // Since the previous update.
   DiagGraphStruct create_struct_msg(const rclcpp::Time & stamp) const;
   DiagGraphStatus create_status_msg(const rclcpp::Time & stamp) const;
   DiagnosticArray create_unknown_msg(const rclcpp::Time & stamp) const;
@@ -47,6 +55,13 @@ public:
   std::vector<DiagUnit *> diags() const { return diags_; }
 
 private:
+  using Deadline = std::pair<int64_t, int>;  // Nanoseconds and unit index.
+
+  void mark_dirty(int index);
+  void schedule(int index, const std::optional<rclcpp::Time> & deadline);
+  void write_status(NodeUnit * node);
+  void write_status(DiagUnit * diag);
+
   std::string id_;
   std::vector<std::unique_ptr<NodeUnit>> alloc_nodes_;
   std::vector<std::unique_ptr<DiagUnit>> alloc_diags_;
@@ -55,6 +70,18 @@ private:
   std::vector<DiagUnit *> diags_;
   std::unordered_map<std::string, DiagUnit *> diag_dict_;
   std::unordered_map<std::string, DiagnosticStatus> unknown_diags_;
+
+  // The units are indexed by BaseUnit::index, the nodes in topological order followed by the diags.
+  // Since the children of a node always have larger indices, the dirty nodes are evaluated from the
+  // largest index so that each node is evaluated once after all of its children.
+  std::vector<bool> dirty_;
+  std::vector<DiagUnit *> dirty_diags_;
+  std::priority_queue<int> dirty_nodes_;
+  std::vector<std::optional<int64_t>> scheduled_;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+  std::vector<std::vector<NodeUnit *>> dependents_;
+  DiagGraphStatus status_;
+  bool status_changed_;
 };
 
 }  // namespace autoware::diagnostic_graph_aggregator
@@ -17,10 +17,30 @@
 #include "config/yaml.hpp"
 
 #include <algorithm>
+#include <optional>
 
 namespace autoware::diagnostic_graph_aggregator
 {
 
+namespace
+{
+
+std::optional<rclcpp::Time> earliest(
+  const std::optional<rclcpp::Time> & a, const std::optional<rclcpp::Time> & b)
+{
+  if (!a) return b;
+  if (!b) return a;
+  return std::min(*a, *b);
+}
+
+std::optional<rclcpp::Time> offset(const std::optional<rclcpp::Time> & stamp, double duration)
+{
+  if (!stamp) return std::nullopt;
+  return *stamp + rclcpp::Duration::from_seconds(duration);
+}
+
+}  // namespace
+
 LatchLevel::LatchLevel(ConfigYaml yaml)
 {
   const auto latch = yaml.optional("latch");
@@ -104,6 +124,16 @@ DiagnosticLevel LatchLevel::latch_level() const
   return DiagnosticStatus::OK;
 }
 
+std::optional<rclcpp::Time> LatchLevel::deadline() const
+{
+  if (!latch_enabled_ || initializing_) {
+    return std::nullopt;
+  }
+  const auto warn = warn_latched_ ? std::nullopt : offset(warn_stamp_, latch_duration_);
+  const auto error = error_latched_ ? std::nullopt : offset(error_stamp_, latch_duration_);
+  return earliest(warn, error);
+}
+
 TimeoutLevel::TimeoutLevel(ConfigYaml yaml)
 {
   timeout_duration_ = yaml.optional("timeout").float64(1.0);
@@ -132,6 +162,11 @@ DiagnosticLevel TimeoutLevel::level() const
   return level_;
 }
 
+std::optional<rclcpp::Time> TimeoutLevel::deadline() const
+{
+  return offset(stamp_, timeout_duration_);
+}
+
 HysteresisLevel::HysteresisLevel(ConfigYaml yaml)
 {
   const auto hysteresis = yaml.optional("hysteresis");
@@ -206,4 +241,25 @@ DiagnosticLevel HysteresisLevel::input_level() const
   return input_level_;
 }
 
+std::optional<rclcpp::Time> HysteresisLevel::deadline() const
+{
+  // Same edges as update_level checks.
+  const auto edge = [](const auto & edges, DiagnosticLevel level) -> std::optional<rclcpp::Time> {
+    const auto iter = edges.find(level);
+    return iter != edges.end() ? iter->second : std::nullopt;
+  };
+
+  std::optional<rclcpp::Time> result;
+  if (!hysteresis_enabled_) {
+    return result;
+  }
+  for (auto level = input_level_; level > stable_level_; --level) {
+    result = earliest(result, offset(edge(upper_edges_, level), hysteresis_duration_));
+  }
+  for (auto level = input_level_; level < stable_level_; ++level) {
+    result = earliest(result, offset(edge(lower_edges_, level), hysteresis_duration_));
+  }
+  return result;
+}
+
 }  // namespace autoware::diagnostic_graph_aggregator
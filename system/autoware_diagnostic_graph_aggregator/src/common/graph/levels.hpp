@@ -26,6 +26,9 @@
 namespace autoware::diagnostic_graph_aggregator
 {
 
+// The deadline functions return the earliest time when the level may change without new input.
+// Until then, calling update with the same input level does not change the state.
+
 class LatchLevel
 {
 public:
@@ -36,6 +39,7 @@ public:
   DiagnosticLevel level() const;
   DiagnosticLevel input_level() const;
   DiagnosticLevel latch_level() const;
+  std::optional<rclcpp::Time> deadline() const;
 
 private:
   void update_latch_status(const rclcpp::Time & stamp, DiagnosticLevel level);
@@ -59,6 +63,7 @@ public:
   void update(const rclcpp::Time & stamp, DiagnosticLevel level);
   void update(const rclcpp::Time & stamp);
   DiagnosticLevel level() const;
+  std::optional<rclcpp::Time> deadline() const;
 
 private:
   double timeout_duration_;
@@ -73,6 +78,7 @@ public:
   void update(const rclcpp::Time & stamp, DiagnosticLevel level);
   DiagnosticLevel level() const;
   DiagnosticLevel input_level() const;
+  std::optional<rclcpp::Time> deadline() const;
 
 private:
   static constexpr DiagnosticLevel upper_limit = DiagnosticStatus::STALE;
@@ -20,6 +20,7 @@
 #include "graph/logic.hpp"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -63,6 +64,11 @@ bool NodeUnit::dependency() const
   return dependency_ && dependency_->level() != DiagnosticStatus::OK;
 }
 
+BaseUnit * NodeUnit::dependency_unit() const
+{
+  return dependency_ ? dependency_->iterate().front() : nullptr;
+}
+
 void NodeUnit::set_initializing(bool initializing)
 {
   latch_->set_initializing(initializing);
@@ -98,4 +104,9 @@ void NodeUnit::update(const rclcpp::Time & stamp)
   latch_->update(stamp, logic_->level());
 }
 
+std::optional<rclcpp::Time> NodeUnit::deadline() const
+{
+  return latch_->deadline();
+}
+
 }  // namespace autoware::diagnostic_graph_aggregator
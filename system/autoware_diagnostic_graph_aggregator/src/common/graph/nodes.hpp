@@ -23,6 +23,7 @@
 #include <rclcpp/time.hpp>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -44,9 +45,11 @@ public:
   std::string path() const;
   std::string type() const;
   bool dependency() const;
+  BaseUnit * dependency_unit() const;
   void set_initializing(bool initializing);
   void reset();
   void update(const rclcpp::Time & stamp);
+  std::optional<rclcpp::Time> deadline() const;
 
 private:
   DiagNodeStruct struct_;
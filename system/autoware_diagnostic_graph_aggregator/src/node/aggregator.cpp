@@ -44,6 +44,8 @@ AggregatorNode::AggregatorNode(const rclcpp::NodeOptions & options) : Node("aggr
     const auto qos_unknown = rclcpp::QoS(1);
     const auto qos_struct = rclcpp::QoS(1).transient_local();
     const auto qos_status = rclcpp::QoS(declare_parameter<int64_t>("graph_qos_depth"));
+    publish_status_on_change_ = declare_parameter<bool>("publish_status_on_change");
+    status_keepalive_period_ = declare_parameter<double>("status_keepalive_period");
     const auto callback = std::bind(&AggregatorNode::on_diag, this, std::placeholders::_1);
     sub_input_ = create_subscription<DiagnosticArray>("/diagnostics", qos_input, callback);
     pub_struct_ = create_publisher<DiagGraphStruct>("~/struct", qos_struct);
@@ -76,8 +78,15 @@ void AggregatorNode::on_timer()
   const auto stamp = now();
   graph_->update(stamp);
 
-  // Publish status.
-  pub_status_->publish(graph_->create_status_msg(stamp));
+  // Publish status. In the on-change mode, skip it while no unit changes except for keepalive.
+  const auto keepalive = [this, &stamp]() {
+    return !status_published_stamp_ ||
+           status_keepalive_period_ <= (stamp - *status_published_stamp_).seconds();
+  };
+  if (!publish_status_on_change_ || graph_->is_status_changed() || keepalive()) {
+    pub_status_->publish(graph_->create_status_msg(stamp));
+    status_published_stamp_ = stamp;
+  }
   pub_unknown_->publish(graph_->create_unknown_msg(stamp));
 
   // Update plugins.
@@ -23,6 +23,7 @@
 #include <std_srvs/srv/set_bool.hpp>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -38,6 +39,9 @@ public:
 private:
   std::unique_ptr<Graph> graph_;
   std::unique_ptr<CommandModeMapping> availability_;
+  bool publish_status_on_change_;
+  double status_keepalive_period_;
+  std::optional<rclcpp::Time> status_published_stamp_;
 
   using SetBool = std_srvs::srv::SetBool;
   rclcpp::TimerBase::SharedPtr timer_;
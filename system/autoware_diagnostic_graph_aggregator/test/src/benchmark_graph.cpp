@@ -0,0 +1,145 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "graph/graph.hpp"
+#include "types/diagnostics.hpp"
+
+#include <rclcpp/time.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measure one aggregation period of a synthetic graph: the input messages, the update and the
+// status message. The diags are published once per second and a few of them change the level in
+// each period. The reference publishes all diags in every period and resets the graph, which makes
+// every unit evaluated in the same way as the full evaluation of each period.
+
+using namespace autoware::diagnostic_graph_aggregator;  // NOLINT(build/namespaces)
+
+namespace
+{
+
+std::string diag_name(int index)
+{
+  return "bench: diag-" + std::to_string(index);
+}
+
+// A tree of and units with the fanout of 10 whose leaves are diag units. The graph is split into
+// files of 100 diags because yaml-cpp slows down quadratically with the size of one document.
+std::filesystem::path write_graph(int diag_count)
+{
+  constexpr int fanout = 10;
+  constexpr int module_size = fanout * fanout;
+  const auto directory = std::filesystem::temp_directory_path() /
+                         ("diagnostic_graph_benchmark_" + std::to_string(diag_count));
+  std::filesystem::create_directories(directory);
+
+  std::vector<std::string> layer;
+  std::ofstream root(directory / "main.yaml");
+  root << "files:\n";
+  for (int module = 0; module * module_size < diag_count; ++module) {
+    const auto name = "module" + std::to_string(module) + ".yaml";
+    const auto path = "/module/" + std::to_string(module);
+    std::ofstream file(directory / name);
+    file << "units:\n  - path: " << path << "\n    type: and\n    list:\n";
+    for (int group = module * module_size; group < (module + 1) * module_size; group += fanout) {
+      file << "      - type: and\n        list:\n";
+      for (int diag = group; diag < std::min(diag_count, group + fanout); ++diag) {
+        file << "          - {type: diag, node: bench, name: diag-" << diag << "}\n";
+      }
+    }
+    root << "  - {path: $(dirname)/" << name << "}\n";
+    layer.push_back(path);
+  }
+
+  root << "units:\n";
+  for (int depth = 0; layer.size() > 1; ++depth) {
+    std::vector<std::string> parents;
+    for (size_t i = 0; i < layer.size(); i += fanout) {
+      const auto path = "/and/" + std::to_string(depth) + "/" + std::to_string(i);
+      root << "  - path: " << path << "\n    type: and\n    list:\n";
+      for (size_t k = i; k < std::min(layer.size(), i + fanout); ++k) {
+        root << "      - {type: link, link: " << layer[k] << "}\n";
+      }
+      parents.push_back(path);
+    }
+    layer = parents;
+  }
+  return directory;
+}
+
+double run(const std::filesystem::path & path, int diag_count, bool full, int periods)
+{
+  constexpr double rate = 10.0;
+  constexpr int changes = 10;
+  const auto interval = rclcpp::Duration::from_seconds(1.0 / rate);
+  const auto batch = full ? diag_count : static_cast<int>(diag_count / rate);
+
+  Graph graph(path.string());
+  std::mt19937 rng(0);
+  std::vector<DiagnosticLevel> levels(diag_count, DiagnosticStatus::OK);
+  rclcpp::Time stamp(1'000'000'000'000, RCL_ROS_TIME);
+
+  size_t checksum = 0;
+  double total = 0.0;
+  for (int period = 0; period < periods; ++period) {
+    for (int k = 0; k < changes; ++k) {
+      levels[rng() % diag_count] = static_cast<DiagnosticLevel>(rng() % 3);
+    }
+    DiagnosticArray array;
+    array.header.stamp = stamp;
+    for (int k = 0; k < batch; ++k) {
+      const int index = static_cast<int>((static_cast<int64_t>(period) * batch + k) % diag_count);
+      DiagnosticStatus status;
+      status.name = diag_name(index);
+      status.level = levels[index];
+      array.status.push_back(status);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    graph.update(stamp, array);
+    if (full) graph.reset();
+    graph.update(stamp);
+    checksum += graph.create_status_msg(stamp).nodes.front().level;
+    total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+               .count();
+    stamp += interval;
+  }
+  if (checksum == static_cast<size_t>(-1)) std::cout << checksum;  // Keep the result alive.
+  return total / periods;
+}
+
+}  // namespace
+
+int main()
+{
+  constexpr int periods = 100;
+  for (const int diag_count : {1000, 10000}) {
+    const auto directory = write_graph(diag_count);
+    const auto path = directory / "main.yaml";
+    const Graph graph(path.string());
+    const auto incremental = run(path, diag_count, false, periods);
+    const auto full = run(path, diag_count, true, periods);
+    std::cout << graph.nodes().size() << " nodes, " << graph.diags().size()
+              << " diags: incremental " << incremental << " [ms], full " << full
+              << " [ms] per period" << std::endl;
+    std::filesystem::remove_all(directory);
+  }
+  return 0;
+}
@@ -0,0 +1,96 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "graph/graph.hpp"
+#include "tests/utils.hpp"
+
+#include <rclcpp/clock.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace autoware::diagnostic_graph_aggregator;  // NOLINT(build/namespaces)
+
+using diagnostic_msgs::msg::DiagnosticArray;
+using diagnostic_msgs::msg::DiagnosticStatus;
+
+namespace
+{
+
+DiagnosticArray create_input(const rclcpp::Time & stamp, const std::vector<uint8_t> & levels)
+{
+  DiagnosticArray array;
+  array.header.stamp = stamp;
+  for (size_t i = 0; i < levels.size(); ++i) {
+    DiagnosticStatus status;
+    status.level = levels[i];
+    status.name = "test: input-" + std::to_string(i);
+    array.status.push_back(status);
+  }
+  return array;
+}
+
+}  // namespace
+
+TEST(GraphUpdate, StatusChanged)
+{
+  auto stamp = rclcpp::Clock(RCL_ROS_TIME).now();
+  const auto interval = rclcpp::Duration::from_seconds(0.1);
+  Graph graph(resource("logics/and.yaml"));
+
+  graph.update(stamp, create_input(stamp, {DiagnosticStatus::OK, DiagnosticStatus::OK}));
+  graph.update(stamp);
+  EXPECT_TRUE(graph.is_status_changed());
+
+  // The same input does not change the status.
+  stamp += interval;
+  graph.update(stamp, create_input(stamp, {DiagnosticStatus::OK, DiagnosticStatus::OK}));
+  graph.update(stamp);
+  EXPECT_FALSE(graph.is_status_changed());
+
+  stamp += interval;
+  graph.update(stamp);
+  EXPECT_FALSE(graph.is_status_changed());
+
+  stamp += interval;
+  graph.update(stamp, create_input(stamp, {DiagnosticStatus::OK, DiagnosticStatus::WARN}));
+  graph.update(stamp);
+  EXPECT_TRUE(graph.is_status_changed());
+  EXPECT_EQ(graph.create_status_msg(stamp).nodes.front().level, DiagnosticStatus::WARN);
+}
+
+TEST(GraphUpdate, TimeoutWithoutInput)
+{
+  auto stamp = rclcpp::Clock(RCL_ROS_TIME).now();
+  Graph graph(resource("logics/and.yaml"));
+
+  graph.update(stamp, create_input(stamp, {DiagnosticStatus::OK, DiagnosticStatus::OK}));
+  graph.update(stamp);
+  EXPECT_EQ(graph.create_status_msg(stamp).nodes.front().level, DiagnosticStatus::OK);
+
+  // The diags are evaluated by the deadline of the timeout even if no message is received.
+  stamp += rclcpp::Duration::from_seconds(0.9);
+  graph.update(stamp);
+  EXPECT_FALSE(graph.is_status_changed());
+
+  stamp += rclcpp::Duration::from_seconds(0.1);
+  graph.update(stamp);
+  EXPECT_TRUE(graph.is_status_changed());
+  EXPECT_EQ(graph.create_status_msg(stamp).nodes.front().level, DiagnosticStatus::ERROR);
+}
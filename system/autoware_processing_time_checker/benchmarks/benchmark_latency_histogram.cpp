@@ -0,0 +1,150 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/math/accumulator.hpp"
+#include "digestible.hpp"
+#include "histogram_file_exporter.hpp"
+#include "latency_histogram.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Throughput of the update path of the subscriber callbacks, with threads recording into the same
+// module: the Accumulator and tdigest used before, behind a mutex as they are not thread-safe, and
+// the lock-free histogram. Then the cost of the work done by the timer for all the modules.
+
+using autoware::processing_time_checker::HistogramFileExporter;
+using autoware::processing_time_checker::HistogramSnapshot;
+using autoware::processing_time_checker::LatencyHistogram;
+
+namespace
+{
+constexpr size_t samples_per_thread = 2'000'000;
+constexpr size_t modules_num = 45;
+
+std::vector<double> create_samples(const unsigned seed)
+{
+  // processing times of a few milliseconds with a long tail
+  std::mt19937 engine(seed);
+  std::lognormal_distribution<double> distribution(1.0, 0.6);
+  std::vector<double> samples(samples_per_thread);
+  for (auto & sample : samples) {
+    sample = distribution(engine);
+  }
+  return samples;
+}
+
+double elapsed_ms(const std::chrono::steady_clock::time_point & start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+
+// return the million samples recorded per second
+template <typename RecordFunc>
+double measure_throughput(const size_t threads_num, const RecordFunc & record)
+{
+  std::vector<std::vector<double>> samples;
+  for (size_t i = 0; i < threads_num; ++i) {
+    samples.push_back(create_samples(static_cast<unsigned>(i)));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threads_num; ++i) {
+    threads.emplace_back([&, i]() {
+      for (const auto sample : samples[i]) {
+        record(sample);
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  return static_cast<double>(threads_num * samples_per_thread) / elapsed_ms(start) * 1e-3;
+}
+}  // namespace
+
+int main()
+{
+  for (const size_t threads_num : {1, 2, 4, 8}) {
+    std::mutex mutex;
+    autoware_utils::Accumulator<double> accumulator;
+    digestible::tdigest<double> tdigest(100);
+    const auto digest_throughput = measure_throughput(threads_num, [&](const double sample) {
+      std::lock_guard<std::mutex> lock(mutex);
+      accumulator.add(sample);
+      tdigest.insert(sample);
+    });
+
+    LatencyHistogram histogram;
+    const auto histogram_throughput =
+      measure_throughput(threads_num, [&](const double sample) { histogram.record(sample); });
+
+    tdigest.merge();
+    const auto snapshot = histogram.snapshot();
+    std::cout << threads_num << " threads: accumulator and tdigest " << digest_throughput
+              << " [M/s], histogram " << histogram_throughput << " [M/s]" << std::endl;
+    std::cout << "  p99 " << tdigest.quantile(99.0) << " / " << snapshot.percentile(99.0)
+              << " [ms], max " << accumulator.max() << " / " << snapshot.max() << " [ms]"
+              << std::endl;
+  }
+
+  std::vector<std::string> module_names;
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms;
+  const auto samples = create_samples(0);
+  for (size_t i = 0; i < modules_num; ++i) {
+    module_names.push_back("module_" + std::to_string(i));
+    histograms.push_back(std::make_unique<LatencyHistogram>());
+    for (size_t j = 0; j < 10'000; ++j) {
+      histograms.back()->record(samples[j]);
+    }
+  }
+
+  constexpr int iterations = 100;
+  std::vector<HistogramSnapshot> window_start_snapshots(modules_num);
+  double percentile_sum = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (size_t j = 0; j < modules_num; ++j) {
+      auto snapshot = histograms[j]->snapshot();
+      const auto window = snapshot.since(window_start_snapshots[j]);
+      percentile_sum += window.percentile(50.0) + window.percentile(90.0) +
+                        window.percentile(99.0) + window.max();
+      window_start_snapshots[j] = std::move(snapshot);
+    }
+  }
+  std::cout << modules_num << " modules: window percentiles " << elapsed_ms(start) / iterations
+            << " [ms] (checksum " << percentile_sum << ")" << std::endl;
+
+  const std::string file_path = "/tmp/benchmark_latency_histogram.bin";
+  {
+    HistogramFileExporter exporter(file_path, module_names);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      exporter.update(i, histograms);
+    }
+    std::cout << modules_num << " modules: export " << elapsed_ms(start) / iterations << " [ms]"
+              << std::endl;
+  }
+  std::remove(file_path.c_str());
+  return 0;
+}
@@ -0,0 +1,105 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "histogram_file_exporter.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+namespace
+{
+constexpr char magic[8] = "PTCHIST";
+constexpr std::uint32_t version = 1;
+
+std::runtime_error make_error(const std::string & what, const std::string & file_path)
+{
+  return std::runtime_error(what + " " + file_path + ": " + std::strerror(errno));
+}
+}  // namespace
+
+HistogramFileExporter::HistogramFileExporter(
+  const std::string & file_path, const std::vector<std::string> & module_names)
+: size_(sizeof(HistogramFileHeader) + module_names.size() * sizeof(HistogramFileModule))
+{
+  fd_ = open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    throw make_error("Failed to open", file_path);
+  }
+  if (ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+    const auto error = make_error("Failed to resize", file_path);
+    close(fd_);
+    throw error;
+  }
+  void * address = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (address == MAP_FAILED) {
+    const auto error = make_error("Failed to map", file_path);
+    close(fd_);
+    throw error;
+  }
+
+  // the file is zero-filled by ftruncate()
+  header_ = new (address) HistogramFileHeader{};
+  std::memcpy(header_->magic, magic, sizeof(magic));
+  header_->version = version;
+  header_->module_count = static_cast<std::uint32_t>(module_names.size());
+  header_->bucket_count = static_cast<std::uint32_t>(histogram_layout::bucket_count);
+  header_->sub_bucket_bits = static_cast<std::uint32_t>(histogram_layout::sub_bucket_bits);
+
+  modules_ = reinterpret_cast<HistogramFileModule *>(header_ + 1);
+  for (std::size_t i = 0; i < module_names.size(); ++i) {
+    auto & name = modules_[i].name;
+    std::memcpy(name, module_names[i].data(), std::min(module_names[i].size(), sizeof(name) - 1));
+  }
+}
+
+HistogramFileExporter::~HistogramFileExporter()
+{
+  munmap(header_, size_);
+  close(fd_);
+}
+
+void HistogramFileExporter::update(
+  const std::int64_t stamp_ns, const std::vector<std::unique_ptr<LatencyHistogram>> & histograms)
+{
+  const auto sequence = header_->sequence.load(std::memory_order_relaxed);
+  header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  header_->stamp_ns = stamp_ns;
+  const auto module_count = std::min<std::size_t>(header_->module_count, histograms.size());
+  for (std::size_t i = 0; i < module_count; ++i) {
+    const auto snapshot = histograms[i]->snapshot();
+    auto & module = modules_[i];
+    module.count = snapshot.count;
+    module.sum_us = snapshot.sum_us;
+    module.min_us = snapshot.min_us;
+    module.max_us = snapshot.max_us;
+    module.last_ms = histograms[i]->last();
+    std::memcpy(module.buckets, snapshot.buckets.data(), sizeof(module.buckets));
+  }
+
+  header_->sequence.store(sequence + 2, std::memory_order_release);
+}
+}  // namespace autoware::processing_time_checker
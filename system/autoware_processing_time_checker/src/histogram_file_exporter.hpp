@@ -0,0 +1,92 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HISTOGRAM_FILE_EXPORTER_HPP_
+#define HISTOGRAM_FILE_EXPORTER_HPP_
+
+#include "latency_histogram.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+// Layout of the export file, in the native byte order: a header followed by one record per module.
+struct HistogramFileHeader
+{
+  char magic[8];  // "PTCHIST"
+  std::uint32_t version;
+  std::uint32_t module_count;
+  std::uint32_t bucket_count;
+  std::uint32_t sub_bucket_bits;
+  // incremented before and after each update: a reader retries while it is odd or has changed
+  std::atomic<std::uint64_t> sequence;
+  std::int64_t stamp_ns;
+};
+
+struct HistogramFileModule
+{
+  char name[64];
+  std::uint64_t count;
+  std::uint64_t sum_us;
+  std::uint64_t min_us;
+  std::uint64_t max_us;
+  double last_ms;
+  std::uint64_t buckets[histogram_layout::bucket_count];
+};
+
+static_assert(std::is_standard_layout_v<HistogramFileHeader>);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(sizeof(HistogramFileHeader) == 40);
+static_assert(sizeof(HistogramFileModule) == 104 + 8 * histogram_layout::bucket_count);
+
+/**
+ * @brief Memory-mapped file holding the histograms of all the modules, readable without ROS.
+ * @details The counters are cumulative since the node started, so a reader gets the percentiles of
+ * any interval from the difference of two reads.
+ */
+class HistogramFileExporter
+{
+public:
+  /**
+   * @brief Create or truncate the file and map it.
+   * @throw std::runtime_error if the file cannot be created or mapped.
+   */
+  HistogramFileExporter(
+    const std::string & file_path, const std::vector<std::string> & module_names);
+  ~HistogramFileExporter();
+
+  HistogramFileExporter(const HistogramFileExporter &) = delete;
+  HistogramFileExporter & operator=(const HistogramFileExporter &) = delete;
+
+  /**
+   * @brief Copy the current counters of the histograms, in the order of the module names.
+   */
+  void update(
+    std::int64_t stamp_ns, const std::vector<std::unique_ptr<LatencyHistogram>> & histograms);
+
+private:
+  int fd_{-1};
+  std::size_t size_{0};
+  HistogramFileHeader * header_{nullptr};
+  HistogramFileModule * modules_{nullptr};
+};
+}  // namespace autoware::processing_time_checker
+
+#endif  // HISTOGRAM_FILE_EXPORTER_HPP_
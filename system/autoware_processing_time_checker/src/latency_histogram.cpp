@@ -0,0 +1,96 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace autoware::processing_time_checker
+{
+HistogramSnapshot LatencyHistogram::snapshot() const
+{
+  HistogramSnapshot snapshot;
+  std::size_t lowest_index = histogram_layout::bucket_count;
+  std::size_t highest_index = 0;
+  for (std::size_t i = 0; i < histogram_layout::bucket_count; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    if (snapshot.buckets[i] > 0) {
+      snapshot.count += snapshot.buckets[i];
+      lowest_index = std::min(lowest_index, i);
+      highest_index = i;
+    }
+  }
+  if (snapshot.count == 0) {
+    return snapshot;
+  }
+
+  // the extrema of a sample being recorded may not be visible yet, so keep them in their buckets
+  snapshot.sum_us = sum_us_.load(std::memory_order_relaxed);
+  snapshot.min_us = std::clamp(
+    min_us_.load(std::memory_order_relaxed), histogram_layout::bucket_lowest_value(lowest_index),
+    histogram_layout::bucket_highest_value(lowest_index));
+  snapshot.max_us = std::clamp(
+    max_us_.load(std::memory_order_relaxed), histogram_layout::bucket_lowest_value(highest_index),
+    histogram_layout::bucket_highest_value(highest_index));
+  snapshot.min_us = std::min(snapshot.min_us, snapshot.max_us);
+  return snapshot;
+}
+
+HistogramSnapshot HistogramSnapshot::since(const HistogramSnapshot & earlier) const
+{
+  HistogramSnapshot interval;
+  std::size_t lowest_index = histogram_layout::bucket_count;
+  std::size_t highest_index = 0;
+  for (std::size_t i = 0; i < histogram_layout::bucket_count; ++i) {
+    interval.buckets[i] = buckets[i] - std::min(buckets[i], earlier.buckets[i]);
+    if (interval.buckets[i] > 0) {
+      interval.count += interval.buckets[i];
+      lowest_index = std::min(lowest_index, i);
+      highest_index = i;
+    }
+  }
+  if (interval.count == 0) {
+    return interval;
+  }
+
+  interval.sum_us = sum_us - std::min(sum_us, earlier.sum_us);
+  interval.min_us = std::max(histogram_layout::bucket_lowest_value(lowest_index), min_us);
+  interval.max_us = std::min(histogram_layout::bucket_highest_value(highest_index), max_us);
+  interval.min_us = std::min(interval.min_us, interval.max_us);
+  return interval;
+}
+
+double HistogramSnapshot::percentile(const double percent) const
+{
+  if (count == 0) {
+    return 0.0;
+  }
+
+  // divided last so that the rank of an exact percentile of the count is not rounded up
+  const auto rank = std::max<std::uint64_t>(
+    1, static_cast<std::uint64_t>(
+         std::ceil(std::clamp(percent, 0.0, 100.0) * static_cast<double>(count) / 100.0)));
+  std::uint64_t cumulative_count = 0;
+  for (std::size_t i = 0; i < histogram_layout::bucket_count; ++i) {
+    cumulative_count += buckets[i];
+    if (cumulative_count >= rank) {
+      const auto value_us = std::clamp(histogram_layout::bucket_highest_value(i), min_us, max_us);
+      return static_cast<double>(value_us) * 1e-3;
+    }
+  }
+  return max();
+}
+}  // namespace autoware::processing_time_checker
@@ -0,0 +1,156 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATENCY_HISTOGRAM_HPP_
+#define LATENCY_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace autoware::processing_time_checker
+{
+namespace histogram_layout
+{
+// Values are recorded in microseconds. Below 2^sub_bucket_bits, every value has its own bucket.
+// Above, each power of two is split into 2^(sub_bucket_bits - 1) buckets of equal width, so the
+// relative error of a value read from a bucket is less than 2^-(sub_bucket_bits - 1).
+constexpr int sub_bucket_bits = 7;
+constexpr int value_bits = 36;  // about 19 hours
+constexpr std::uint64_t sub_bucket_count = std::uint64_t{1} << sub_bucket_bits;
+constexpr std::uint64_t sub_bucket_half_count = sub_bucket_count / 2;
+constexpr std::uint64_t max_value_us = (std::uint64_t{1} << value_bits) - 1;
+constexpr std::size_t bucket_count =
+  sub_bucket_count + (value_bits - sub_bucket_bits) * sub_bucket_half_count;
+
+inline std::size_t bucket_index(std::uint64_t value_us)
+{
+  value_us = std::min(value_us, max_value_us);
+  if (value_us < sub_bucket_count) {
+    return static_cast<std::size_t>(value_us);
+  }
+  const int highest_bit = 63 - __builtin_clzll(value_us);
+  const int shift = highest_bit - (sub_bucket_bits - 1);
+  const std::uint64_t mantissa = value_us >> shift;
+  return static_cast<std::size_t>(
+    sub_bucket_count + static_cast<std::uint64_t>(shift - 1) * sub_bucket_half_count + mantissa -
+    sub_bucket_half_count);
+}
+
+inline std::uint64_t bucket_lowest_value(const std::size_t index)
+{
+  if (index < sub_bucket_count) {
+    return index;
+  }
+  const std::uint64_t offset = index - sub_bucket_count;
+  const auto shift = static_cast<int>(offset / sub_bucket_half_count) + 1;
+  const std::uint64_t mantissa = offset % sub_bucket_half_count + sub_bucket_half_count;
+  return mantissa << shift;
+}
+
+inline std::uint64_t bucket_highest_value(const std::size_t index)
+{
+  return index + 1 < bucket_count ? bucket_lowest_value(index + 1) - 1 : max_value_us;
+}
+}  // namespace histogram_layout
+
+/**
+ * @brief Copy of the counters of a LatencyHistogram, or the difference between two copies.
+ */
+struct HistogramSnapshot
+{
+  std::uint64_t count{0};
+  std::uint64_t sum_us{0};
+  std::uint64_t min_us{0};
+  std::uint64_t max_us{0};
+  std::array<std::uint64_t, histogram_layout::bucket_count> buckets{};
+
+  /**
+   * @brief Samples recorded after the given earlier snapshot of the same histogram.
+   * @details The minimum and maximum are taken from the buckets, and are within the bucket width.
+   */
+  HistogramSnapshot since(const HistogramSnapshot & earlier) const;
+
+  /**
+   * @brief Value at the given percentile [%] in milliseconds, 0.0 if there is no sample.
+   */
+  double percentile(double percent) const;
+
+  double min() const { return static_cast<double>(min_us) * 1e-3; }
+  double max() const { return static_cast<double>(max_us) * 1e-3; }
+  double mean() const
+  {
+    return count == 0 ? 0.0 : static_cast<double>(sum_us) * 1e-3 / static_cast<double>(count);
+  }
+};
+
+/**
+ * @brief Log-linear histogram of processing times with lock-free recording.
+ * @details record() only does relaxed atomic operations on fixed buckets, so it can be called from
+ * any number of subscriber threads while another thread takes snapshots.
+ */
+class LatencyHistogram
+{
+public:
+  void record(const double processing_time_ms)
+  {
+    const auto value_us = to_us(processing_time_ms);
+    buckets_[histogram_layout::bucket_index(value_us)].fetch_add(1, std::memory_order_relaxed);
+    sum_us_.fetch_add(value_us, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    last_ms_.store(processing_time_ms, std::memory_order_relaxed);
+
+    auto min_us = min_us_.load(std::memory_order_relaxed);
+    while (value_us < min_us &&
+           !min_us_.compare_exchange_weak(min_us, value_us, std::memory_order_relaxed)) {
+    }
+    auto max_us = max_us_.load(std::memory_order_relaxed);
+    while (value_us > max_us &&
+           !max_us_.compare_exchange_weak(max_us, value_us, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  double last() const { return last_ms_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Copy the counters. The count is the sum of the copied buckets so that the percentiles
+   * are consistent even if samples are recorded during the copy.
+   */
+  HistogramSnapshot snapshot() const;
+
+private:
+  static std::uint64_t to_us(const double value_ms)
+  {
+    if (!(value_ms > 0.0)) {
+      return 0;
+    }
+    return static_cast<std::uint64_t>(
+      std::min(std::round(value_ms * 1e3), static_cast<double>(histogram_layout::max_value_us)));
+  }
+
+  std::array<std::atomic<std::uint64_t>, histogram_layout::bucket_count> buckets_{};
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::uint64_t> sum_us_{0};
+  std::atomic<std::uint64_t> min_us_{std::numeric_limits<std::uint64_t>::max()};
+  std::atomic<std::uint64_t> max_us_{0};
+  std::atomic<double> last_ms_{0.0};
+};
+}  // namespace autoware::processing_time_checker
+
+#endif  // LATENCY_HISTOGRAM_HPP_
@@ -17,11 +17,14 @@
 #include <nlohmann/json.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::processing_time_checker
@@ -45,6 +48,8 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
 {
   output_metrics_ = declare_parameter<bool>("output_metrics");
   const double update_rate = declare_parameter<double>("update_rate");
+  percentile_window_ = declare_parameter<double>("percentile_window");
+  const auto histogram_export_file = declare_parameter<std::string>("histogram_export_file");
   const auto processing_time_topic_name_list =
     declare_parameter<std::vector<std::string>>("processing_time_topic_name_list");
 
@@ -70,8 +75,12 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
     // register module name
     if (module_name) {
       module_name_map_.insert_or_assign(processing_time_topic_name, *module_name);
-      processing_time_accumulator_map_.insert_or_assign(*module_name, Accumulator<double>());
-      processing_time_tdigest_map_.insert_or_assign(*module_name, tdigest<double>(100));
+      if (
+        std::find(module_names_.begin(), module_names_.end(), *module_name) ==
+        module_names_.end()) {
+        module_names_.push_back(*module_name);
+        histograms_.push_back(std::make_unique<LatencyHistogram>());
+      }
     } else {
       throw std::invalid_argument("The format of the processing time topic name is not correct.");
     }
@@ -80,19 +89,31 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
   // create subscribers
   for (const auto & processing_time_topic_name : processing_time_topic_name_list) {
     const auto & module_name = module_name_map_.at(processing_time_topic_name);
+    const auto module_index = static_cast<size_t>(std::distance(
+      module_names_.begin(), std::find(module_names_.begin(), module_names_.end(), module_name)));
+    LatencyHistogram * histogram = histograms_.at(module_index).get();
 
     // clang-format off
     processing_time_subscribers_.push_back(
       create_subscription<Float64Stamped>(
         processing_time_topic_name, 1,
-        [this, &module_name]([[maybe_unused]] const Float64Stamped & msg) {
-          processing_time_map_.insert_or_assign(module_name, msg.data);
-          processing_time_accumulator_map_.at(module_name).add(msg.data);
-          processing_time_tdigest_map_.at(module_name).insert(msg.data);
-        }));
+        [histogram](const Float64Stamped & msg) { histogram->record(msg.data); }));
     // clang-format on
   }
 
+  window_start_time_ = now();
+  window_start_snapshots_.resize(histograms_.size());
+  window_statistics_.resize(histograms_.size());
+
+  if (!histogram_export_file.empty()) {
+    try {
+      histogram_file_exporter_ =
+        std::make_unique<HistogramFileExporter>(histogram_export_file, module_names_);
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(get_logger(), "Histogram export is disabled: %s", e.what());
+    }
+  }
+
   metrics_pub_ = create_publisher<MetricArrayMsg>("~/metrics", 1);
 
   const auto period_ns = rclcpp::Rate(update_rate).period();
@@ -109,17 +130,15 @@ ProcessingTimeChecker::~ProcessingTimeChecker()
   try {
     // generate json data
     nlohmann::json j;
-    for (const auto & accumulator_iterator : processing_time_accumulator_map_) {
-      const auto module_name = accumulator_iterator.first;
-      const auto processing_time_accumulator = accumulator_iterator.second;
-      auto processing_time_tdigest = processing_time_tdigest_map_.at(module_name);
-      processing_time_tdigest.merge();
-      j[module_name + "/min"] = processing_time_accumulator.min();
-      j[module_name + "/max"] = processing_time_accumulator.max();
-      j[module_name + "/mean"] = processing_time_accumulator.mean();
-      j[module_name + "/percentile_95"] = processing_time_tdigest.quantile(95.0);
-      j[module_name + "/percentile_99"] = processing_time_tdigest.quantile(99.0);
-      j[module_name + "/count"] = processing_time_accumulator.count();
+    for (size_t i = 0; i < module_names_.size(); ++i) {
+      const auto & module_name = module_names_.at(i);
+      const auto snapshot = histograms_.at(i)->snapshot();
+      j[module_name + "/min"] = snapshot.min();
+      j[module_name + "/max"] = snapshot.max();
+      j[module_name + "/mean"] = snapshot.mean();
+      j[module_name + "/percentile_95"] = snapshot.percentile(95.0);
+      j[module_name + "/percentile_99"] = snapshot.percentile(99.0);
+      j[module_name + "/count"] = snapshot.count;
       j[module_name + "/description"] = "processing time of " + module_name + "[ms]";
     }
 
@@ -158,25 +177,64 @@ ProcessingTimeChecker::~ProcessingTimeChecker()
   }
 }
 
+void ProcessingTimeChecker::update_window_statistics()
+{
+  for (size_t i = 0; i < histograms_.size(); ++i) {
+    auto snapshot = histograms_.at(i)->snapshot();
+    const auto window = snapshot.since(window_start_snapshots_.at(i));
+    auto & statistics = window_statistics_.at(i);
+    statistics.count = window.count;
+    statistics.percentile_50 = window.percentile(50.0);
+    statistics.percentile_90 = window.percentile(90.0);
+    statistics.percentile_99 = window.percentile(99.0);
+    statistics.max = window.max();
+    window_start_snapshots_.at(i) = std::move(snapshot);
+  }
+}
+
 void ProcessingTimeChecker::on_timer()
 {
+  const auto stamp = now();
+  if ((stamp - window_start_time_).seconds() >= percentile_window_) {
+    update_window_statistics();
+    window_start_time_ = stamp;
+  }
+
   // create MetricArrayMsg
   MetricArrayMsg metrics_msg;
-  for (const auto & processing_time_iterator : processing_time_map_) {
-    const auto processing_time_topic_name = processing_time_iterator.first;
-    const double processing_time = processing_time_iterator.second;
-
-    // generate MetricMsg
+  const auto add_metric = [&](const std::string & name, const double value) {
     MetricMsg metric;
-    metric.name = "processing_time/" + processing_time_topic_name;
-    metric.value = std::to_string(processing_time);
+    metric.name = name;
+    metric.value = std::to_string(value);
     metric.unit = "millisecond";
     metrics_msg.metric_array.push_back(metric);
+  };
+  for (size_t i = 0; i < module_names_.size(); ++i) {
+    const auto & histogram = *histograms_.at(i);
+    if (histogram.count() == 0) {
+      continue;
+    }
+
+    // generate MetricMsg
+    const auto metric_name = "processing_time/" + module_names_.at(i);
+    add_metric(metric_name, histogram.last());
+
+    const auto & statistics = window_statistics_.at(i);
+    if (statistics.count > 0) {
+      add_metric(metric_name + "/percentile_50", statistics.percentile_50);
+      add_metric(metric_name + "/percentile_90", statistics.percentile_90);
+      add_metric(metric_name + "/percentile_99", statistics.percentile_99);
+      add_metric(metric_name + "/max", statistics.max);
+    }
   }
 
   // publish
-  metrics_msg.stamp = now();
+  metrics_msg.stamp = stamp;
   metrics_pub_->publish(metrics_msg);
+
+  if (histogram_file_exporter_) {
+    histogram_file_exporter_->update(stamp.nanoseconds(), histograms_);
+  }
 }
 }  // namespace autoware::processing_time_checker
 
@@ -15,8 +15,8 @@
 #ifndef PROCESSING_TIME_CHECKER_HPP_
 #define PROCESSING_TIME_CHECKER_HPP_
 
-#include "autoware_utils/math/accumulator.hpp"
-#include "digestible.hpp"
+#include "histogram_file_exporter.hpp"
+#include "latency_histogram.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -24,14 +24,14 @@
 #include <tier4_metric_msgs/msg/metric.hpp>
 #include <tier4_metric_msgs/msg/metric_array.hpp>
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace autoware::processing_time_checker
 {
-using autoware_utils::Accumulator;
-using digestible::tdigest;
 using MetricMsg = tier4_metric_msgs::msg::Metric;
 using MetricArrayMsg = tier4_metric_msgs::msg::MetricArray;
 using autoware_internal_debug_msgs::msg::Float64Stamped;
@@ -43,7 +43,17 @@ public:
   ~ProcessingTimeChecker() override;
 
 private:
+  struct WindowStatistics
+  {
+    std::uint64_t count{0};
+    double percentile_50{0.0};
+    double percentile_90{0.0};
+    double percentile_99{0.0};
+    double max{0.0};
+  };
+
   void on_timer();
+  void update_window_statistics();
 
   rclcpp::TimerBase::SharedPtr timer_;
 
@@ -52,14 +62,20 @@ private:
 
   // parameters
   bool output_metrics_;
+  double percentile_window_;
 
   // topic name - module name
   std::unordered_map<std::string, std::string> module_name_map_{};
-  // module name - processing time
-  std::unordered_map<std::string, double> processing_time_map_{};
-  // module name - accumulator
-  std::unordered_map<std::string, Accumulator<double>> processing_time_accumulator_map_{};
-  std::unordered_map<std::string, tdigest<double>> processing_time_tdigest_map_{};
+  // module names and their histograms, recorded from the subscriber callbacks
+  std::vector<std::string> module_names_{};
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms_{};
+
+  // percentiles of the last completed window, computed once per window
+  rclcpp::Time window_start_time_;
+  std::vector<HistogramSnapshot> window_start_snapshots_{};
+  std::vector<WindowStatistics> window_statistics_{};
+
+  std::unique_ptr<HistogramFileExporter> histogram_file_exporter_{};
 };
 }  // namespace autoware::processing_time_checker
 
@@ -0,0 +1,193 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "histogram_file_exporter.hpp"
+#include "latency_histogram.hpp"
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using autoware::processing_time_checker::HistogramFileExporter;
+using autoware::processing_time_checker::HistogramFileHeader;
+using autoware::processing_time_checker::HistogramFileModule;
+using autoware::processing_time_checker::LatencyHistogram;
+namespace histogram_layout = autoware::processing_time_checker::histogram_layout;
+
+namespace
+{
+// the file as read by a process without ROS, aligned for the 64-bit fields
+class ExportedFile
+{
+public:
+  explicit ExportedFile(const std::string & file_path)
+  {
+    std::ifstream file(file_path, std::ios::binary);
+    const std::vector<char> bytes{std::istreambuf_iterator<char>(file), {}};
+    size_ = bytes.size();
+    data_.resize((size_ + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+    std::memcpy(data_.data(), bytes.data(), size_);
+  }
+
+  std::size_t size() const { return size_; }
+  const HistogramFileHeader & header() const
+  {
+    return *reinterpret_cast<const HistogramFileHeader *>(data_.data());
+  }
+  const HistogramFileModule & module(const std::size_t index) const
+  {
+    return reinterpret_cast<const HistogramFileModule *>(&header() + 1)[index];
+  }
+
+private:
+  std::size_t size_{0};
+  std::vector<std::uint64_t> data_;
+};
+
+class HistogramFileExporterTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    file_path_ = (std::filesystem::temp_directory_path() /
+                  ("test_histogram_file_exporter_" + std::to_string(getpid()) + ".bin"))
+                   .string();
+  }
+
+  void TearDown() override { std::filesystem::remove(file_path_); }
+
+  std::string file_path_;
+};
+}  // namespace
+
+TEST_F(HistogramFileExporterTest, Header)
+{
+  const std::vector<std::string> module_names = {"a", "b", "c"};
+  HistogramFileExporter exporter(file_path_, module_names);
+
+  const ExportedFile file(file_path_);
+  ASSERT_EQ(file.size(), sizeof(HistogramFileHeader) + 3 * sizeof(HistogramFileModule));
+  const auto & header = file.header();
+  EXPECT_STREQ(header.magic, "PTCHIST");
+  EXPECT_EQ(header.version, 1U);
+  EXPECT_EQ(header.module_count, 3U);
+  EXPECT_EQ(header.bucket_count, histogram_layout::bucket_count);
+  EXPECT_EQ(header.sub_bucket_bits, static_cast<std::uint32_t>(histogram_layout::sub_bucket_bits));
+  EXPECT_EQ(header.sequence.load(), 0U);
+  EXPECT_EQ(header.stamp_ns, 0);
+  for (std::size_t i = 0; i < module_names.size(); ++i) {
+    EXPECT_STREQ(file.module(i).name, module_names[i].c_str());
+    EXPECT_EQ(file.module(i).count, 0U);
+  }
+}
+
+TEST_F(HistogramFileExporterTest, Update)
+{
+  // the names longer than the field are truncated and still terminated
+  const std::string long_name(100, 'x');
+  const std::vector<std::string> module_names = {"module_a", long_name};
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms;
+  histograms.push_back(std::make_unique<LatencyHistogram>());
+  histograms.push_back(std::make_unique<LatencyHistogram>());
+  for (int i = 1; i <= 1000; ++i) {
+    histograms[0]->record(i * 0.1);
+  }
+  histograms[1]->record(2.5);
+
+  HistogramFileExporter exporter(file_path_, module_names);
+  exporter.update(123'456'789, histograms);
+  {
+    const ExportedFile file(file_path_);
+    // the sequence is even after the update
+    EXPECT_EQ(file.header().sequence.load(), 2U);
+    EXPECT_EQ(file.header().stamp_ns, 123'456'789);
+    EXPECT_STREQ(file.module(0).name, "module_a");
+    EXPECT_EQ(file.module(1).name, long_name.substr(0, sizeof(HistogramFileModule::name) - 1));
+
+    for (std::size_t i = 0; i < histograms.size(); ++i) {
+      const auto snapshot = histograms[i]->snapshot();
+      const auto & module = file.module(i);
+      EXPECT_EQ(module.count, snapshot.count);
+      EXPECT_EQ(module.sum_us, snapshot.sum_us);
+      EXPECT_EQ(module.min_us, snapshot.min_us);
+      EXPECT_EQ(module.max_us, snapshot.max_us);
+      EXPECT_DOUBLE_EQ(module.last_ms, histograms[i]->last());
+      EXPECT_EQ(
+        std::memcmp(module.buckets, snapshot.buckets.data(), sizeof(module.buckets)), 0);
+    }
+    EXPECT_EQ(file.module(0).count, 1000U);
+    EXPECT_EQ(file.module(0).sum_us, 50'050'000U);
+    EXPECT_EQ(file.module(1).min_us, 2'500U);
+  }
+
+  // the counters are cumulative
+  histograms[1]->record(7.5);
+  exporter.update(223'456'789, histograms);
+  {
+    const ExportedFile file(file_path_);
+    EXPECT_EQ(file.header().sequence.load(), 4U);
+    EXPECT_EQ(file.header().stamp_ns, 223'456'789);
+    EXPECT_EQ(file.module(0).count, 1000U);
+    EXPECT_EQ(file.module(1).count, 2U);
+    EXPECT_EQ(file.module(1).sum_us, 10'000U);
+    EXPECT_EQ(file.module(1).max_us, 7'500U);
+    EXPECT_DOUBLE_EQ(file.module(1).last_ms, 7.5);
+  }
+}
+
+TEST_F(HistogramFileExporterTest, UpdateWithFewerHistograms)
+{
+  // the modules without histogram are left empty
+  std::vector<std::unique_ptr<LatencyHistogram>> histograms;
+  histograms.push_back(std::make_unique<LatencyHistogram>());
+  histograms[0]->record(1.0);
+  HistogramFileExporter exporter(file_path_, {"a", "b"});
+  exporter.update(1, histograms);
+
+  const ExportedFile file(file_path_);
+  EXPECT_EQ(file.module(0).count, 1U);
+  EXPECT_EQ(file.module(1).count, 0U);
+}
+
+TEST_F(HistogramFileExporterTest, TruncateExistingFile)
+{
+  {
+    std::ofstream file(file_path_, std::ios::binary);
+    file << std::string(100'000, 'x');
+  }
+  HistogramFileExporter exporter(file_path_, {"a"});
+
+  const ExportedFile file(file_path_);
+  EXPECT_EQ(file.size(), sizeof(HistogramFileHeader) + sizeof(HistogramFileModule));
+  EXPECT_EQ(file.header().module_count, 1U);
+  EXPECT_EQ(file.module(0).count, 0U);
+  EXPECT_EQ(file.module(0).buckets[0], 0U);
+}
+
+TEST_F(HistogramFileExporterTest, InvalidPath)
+{
+  EXPECT_THROW(
+    HistogramFileExporter(file_path_ + ".d/does_not_exist/histograms.bin", {"a"}),
+    std::runtime_error);
+}
@@ -0,0 +1,268 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using autoware::processing_time_checker::HistogramSnapshot;
+using autoware::processing_time_checker::LatencyHistogram;
+namespace histogram_layout = autoware::processing_time_checker::histogram_layout;
+
+namespace
+{
+// the relative width of the buckets above the exact ones
+constexpr double max_relative_error = 1.0 / histogram_layout::sub_bucket_half_count;
+
+std::uint64_t exact_percentile_us(std::vector<std::uint64_t> values_us, const double percent)
+{
+  std::sort(values_us.begin(), values_us.end());
+  const auto rank = std::max<std::size_t>(
+    1,
+    static_cast<std::size_t>(std::ceil(percent * static_cast<double>(values_us.size()) / 100.0)));
+  return values_us[rank - 1];
+}
+}  // namespace
+
+TEST(LatencyHistogram, BucketsRoundTrip)
+{
+  for (std::size_t i = 0; i < histogram_layout::bucket_count; ++i) {
+    const auto lowest = histogram_layout::bucket_lowest_value(i);
+    const auto highest = histogram_layout::bucket_highest_value(i);
+    ASSERT_LE(lowest, highest) << i;
+    EXPECT_EQ(histogram_layout::bucket_index(lowest), i);
+    EXPECT_EQ(histogram_layout::bucket_index(highest), i);
+    // the buckets are contiguous
+    if (i + 1 < histogram_layout::bucket_count) {
+      EXPECT_EQ(highest + 1, histogram_layout::bucket_lowest_value(i + 1)) << i;
+    }
+    if (i >= histogram_layout::sub_bucket_count) {
+      EXPECT_LE(
+        static_cast<double>(highest - lowest + 1) / static_cast<double>(lowest),
+        max_relative_error)
+        << i;
+    }
+  }
+
+  std::mt19937_64 engine(0);
+  // values of all the magnitudes, up to above the maximum
+  std::uniform_int_distribution<int> bits_distribution(1, histogram_layout::value_bits + 4);
+  for (int i = 0; i < 100'000; ++i) {
+    const auto value = engine() >> (64 - bits_distribution(engine));
+    const auto clamped_value = std::min(value, histogram_layout::max_value_us);
+    const auto index = histogram_layout::bucket_index(value);
+    ASSERT_LT(index, histogram_layout::bucket_count);
+    EXPECT_LE(histogram_layout::bucket_lowest_value(index), clamped_value) << value;
+    EXPECT_GE(histogram_layout::bucket_highest_value(index), clamped_value) << value;
+  }
+}
+
+TEST(LatencyHistogram, EdgeBuckets)
+{
+  // every value below sub_bucket_count has its own bucket
+  EXPECT_EQ(histogram_layout::bucket_index(0), 0U);
+  EXPECT_EQ(histogram_layout::bucket_index(1), 1U);
+  EXPECT_EQ(
+    histogram_layout::bucket_index(histogram_layout::sub_bucket_count - 1),
+    histogram_layout::sub_bucket_count - 1);
+  EXPECT_EQ(
+    histogram_layout::bucket_index(histogram_layout::sub_bucket_count),
+    histogram_layout::sub_bucket_count);
+  EXPECT_EQ(
+    histogram_layout::bucket_highest_value(histogram_layout::sub_bucket_count),
+    histogram_layout::sub_bucket_count + 1);
+
+  // the values above the maximum are in the last bucket
+  const auto last_index = histogram_layout::bucket_count - 1;
+  EXPECT_EQ(histogram_layout::bucket_index(histogram_layout::max_value_us), last_index);
+  EXPECT_EQ(histogram_layout::bucket_index(histogram_layout::max_value_us + 1), last_index);
+  EXPECT_EQ(
+    histogram_layout::bucket_index(std::numeric_limits<std::uint64_t>::max()), last_index);
+  EXPECT_EQ(histogram_layout::bucket_highest_value(last_index), histogram_layout::max_value_us);
+}
+
+TEST(LatencyHistogram, RecordClampsValues)
+{
+  LatencyHistogram histogram;
+  histogram.record(-1.0);
+  histogram.record(std::nan(""));
+  histogram.record(1e12);
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 3U);
+  EXPECT_EQ(snapshot.buckets[0], 2U);
+  EXPECT_EQ(snapshot.buckets[histogram_layout::bucket_count - 1], 1U);
+  EXPECT_EQ(snapshot.min_us, 0U);
+  EXPECT_EQ(snapshot.max_us, histogram_layout::max_value_us);
+  EXPECT_EQ(histogram.count(), 3U);
+  EXPECT_DOUBLE_EQ(histogram.last(), 1e12);
+}
+
+TEST(LatencyHistogram, PercentileOfEmptyHistogram)
+{
+  const LatencyHistogram histogram;
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 0U);
+  EXPECT_DOUBLE_EQ(snapshot.percentile(50.0), 0.0);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 0.0);
+  EXPECT_DOUBLE_EQ(snapshot.min(), 0.0);
+  EXPECT_DOUBLE_EQ(snapshot.max(), 0.0);
+}
+
+TEST(LatencyHistogram, PercentileOfSingleValue)
+{
+  // the percentiles are clamped to the extrema, so they are exact with a single value
+  LatencyHistogram histogram;
+  histogram.record(12.345);
+  const auto snapshot = histogram.snapshot();
+  for (const double percent : {0.0, 1.0, 50.0, 99.0, 100.0}) {
+    EXPECT_DOUBLE_EQ(snapshot.percentile(percent), 12.345) << percent;
+  }
+  EXPECT_DOUBLE_EQ(snapshot.min(), 12.345);
+  EXPECT_DOUBLE_EQ(snapshot.max(), 12.345);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 12.345);
+}
+
+TEST(LatencyHistogram, PercentileOfExactBuckets)
+{
+  // 1 to 100 us are in the buckets of a single value
+  LatencyHistogram histogram;
+  for (int value_us = 100; value_us >= 1; --value_us) {
+    histogram.record(value_us * 1e-3);
+  }
+  const auto snapshot = histogram.snapshot();
+  EXPECT_DOUBLE_EQ(snapshot.percentile(0.0), 0.001);
+  EXPECT_DOUBLE_EQ(snapshot.percentile(-5.0), 0.001);
+  for (int percent = 1; percent <= 100; ++percent) {
+    EXPECT_DOUBLE_EQ(snapshot.percentile(percent), percent * 1e-3) << percent;
+  }
+  EXPECT_DOUBLE_EQ(snapshot.percentile(99.5), 0.1);
+  EXPECT_DOUBLE_EQ(snapshot.percentile(150.0), 0.1);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 0.0505);
+}
+
+TEST(LatencyHistogram, PercentileOfKnownDistributions)
+{
+  std::mt19937_64 engine(1);
+  std::uniform_real_distribution<double> uniform_distribution(0.0, 200.0);
+  std::lognormal_distribution<double> lognormal_distribution(1.0, 1.5);
+  std::exponential_distribution<double> exponential_distribution(0.1);
+  for (int distribution = 0; distribution < 3; ++distribution) {
+    LatencyHistogram histogram;
+    std::vector<std::uint64_t> values_us;
+    std::uint64_t sum_us = 0;
+    for (int i = 0; i < 10'000; ++i) {
+      const double value_ms = distribution == 0   ? uniform_distribution(engine)
+                              : distribution == 1 ? lognormal_distribution(engine)
+                                                  : exponential_distribution(engine);
+      histogram.record(value_ms);
+      values_us.push_back(static_cast<std::uint64_t>(std::round(value_ms * 1e3)));
+      sum_us += values_us.back();
+    }
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, values_us.size());
+    EXPECT_EQ(snapshot.sum_us, sum_us);
+    EXPECT_EQ(snapshot.min_us, *std::min_element(values_us.begin(), values_us.end()));
+    EXPECT_EQ(snapshot.max_us, *std::max_element(values_us.begin(), values_us.end()));
+
+    // the highest value of the bucket of the exact percentile
+    for (const double percent : {0.0, 1.0, 10.0, 25.0, 50.0, 75.0, 90.0, 99.0, 99.9, 100.0}) {
+      const auto exact_ms = static_cast<double>(exact_percentile_us(values_us, percent)) * 1e-3;
+      const double percentile_ms = snapshot.percentile(percent);
+      EXPECT_GE(percentile_ms, exact_ms) << distribution << ", " << percent;
+      EXPECT_LE(percentile_ms, exact_ms * (1.0 + max_relative_error) + 1e-9)
+        << distribution << ", " << percent;
+    }
+  }
+}
+
+TEST(LatencyHistogram, PercentileOfBimodalDistribution)
+{
+  LatencyHistogram histogram;
+  for (int i = 0; i < 90; ++i) {
+    histogram.record(1.0);
+  }
+  for (int i = 0; i < 10; ++i) {
+    histogram.record(100.0);
+  }
+  const auto snapshot = histogram.snapshot();
+  EXPECT_DOUBLE_EQ(snapshot.percentile(50.0), 1.0 + 7e-3);
+  EXPECT_DOUBLE_EQ(snapshot.percentile(90.0), 1.0 + 7e-3);
+  EXPECT_DOUBLE_EQ(snapshot.percentile(90.1), 100.0);
+  EXPECT_DOUBLE_EQ(snapshot.percentile(100.0), 100.0);
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 10.9);
+}
+
+TEST(LatencyHistogram, Since)
+{
+  std::mt19937_64 engine(2);
+  std::lognormal_distribution<double> distribution(1.0, 1.5);
+  LatencyHistogram histogram;
+  for (int i = 0; i < 5'000; ++i) {
+    histogram.record(distribution(engine));
+  }
+  // a small value recorded before is not the minimum of the interval
+  histogram.record(0.001);
+  const auto earlier = histogram.snapshot();
+
+  LatencyHistogram interval_histogram;
+  for (int i = 0; i < 3'000; ++i) {
+    const double value_ms = 5.0 + distribution(engine);
+    histogram.record(value_ms);
+    interval_histogram.record(value_ms);
+  }
+  const auto later = histogram.snapshot();
+  const auto expected = interval_histogram.snapshot();
+  const auto interval = later.since(earlier);
+
+  EXPECT_EQ(interval.count, expected.count);
+  EXPECT_EQ(interval.sum_us, expected.sum_us);
+  EXPECT_EQ(interval.buckets, expected.buckets);
+  EXPECT_DOUBLE_EQ(interval.mean(), expected.mean());
+
+  // the extrema of the interval are within the width of their buckets
+  const auto min_index = histogram_layout::bucket_index(expected.min_us);
+  const auto max_index = histogram_layout::bucket_index(expected.max_us);
+  EXPECT_GE(interval.min_us, histogram_layout::bucket_lowest_value(min_index));
+  EXPECT_LE(interval.min_us, expected.min_us);
+  EXPECT_GE(interval.max_us, expected.max_us);
+  EXPECT_LE(interval.max_us, histogram_layout::bucket_highest_value(max_index));
+  // and so are the percentiles clamped to them
+  for (const double percent : {0.0, 50.0, 90.0, 99.0, 100.0}) {
+    EXPECT_NEAR(
+      interval.percentile(percent), expected.percentile(percent),
+      expected.percentile(percent) * max_relative_error)
+      << percent;
+  }
+
+  // nothing recorded in between
+  const auto empty_interval = later.since(later);
+  EXPECT_EQ(empty_interval.count, 0U);
+  EXPECT_EQ(empty_interval.sum_us, 0U);
+  EXPECT_DOUBLE_EQ(empty_interval.percentile(50.0), 0.0);
+
+  // since the start of the histogram
+  const auto whole = later.since(HistogramSnapshot{});
+  EXPECT_EQ(whole.count, later.count);
+  EXPECT_EQ(whole.sum_us, later.sum_us);
+  EXPECT_EQ(whole.min_us, later.min_us);
+  EXPECT_EQ(whole.max_us, later.max_us);
+  EXPECT_EQ(whole.buckets, later.buckets);
+}
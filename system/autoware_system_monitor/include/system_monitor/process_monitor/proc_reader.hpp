@@ -0,0 +1,162 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file proc_reader.hpp
+ * @brief Reader of the /proc files used by the process monitor
+ */
+
+#ifndef SYSTEM_MONITOR__PROCESS_MONITOR__PROC_READER_HPP_
+#define SYSTEM_MONITOR__PROCESS_MONITOR__PROC_READER_HPP_
+
+#include "system_monitor/process_monitor/process_information.hpp"
+
+#include <sys/types.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief parse the content of /proc/[pid]/stat
+ * @param [in]  content File content
+ * @param [out] info    Parsed information, modified only if successful
+ * @return true if all the fields of StatInfo are found
+ */
+bool parseStat(std::string_view content, StatInfo & info);
+
+/**
+ * @brief parse the content of /proc/[pid]/statm
+ * @param [in]  content File content
+ * @param [out] info    Parsed information, modified only if successful
+ * @return true if all the fields of StatMemoryInfo are found
+ */
+bool parseStatMemory(std::string_view content, StatMemoryInfo & info);
+
+/**
+ * @brief parse the content of /proc/[pid]/status
+ * @param [in]  content File content
+ * @param [out] info    Parsed information, modified only if successful
+ * @return true if both "Name:" and "Uid:" lines are found
+ */
+bool parseStatus(std::string_view content, StatusInfo & info);
+
+/**
+ * @brief convert the content of /proc/[pid]/cmdline to a command line delimited by spaces
+ * @param [in]  content File content
+ * @param [out] command Command line
+ * @return true if the content is not empty, i.e. not a kernel process
+ */
+bool parseCommandLine(std::string_view content, std::string & command);
+
+/**
+ * @brief Reader of /proc files which keeps its buffers and file descriptors across cycles
+ * @note The /proc directory is enumerated with getdents64() into a reused buffer.
+ * The stat, statm and status files of up to a quarter of the file descriptor limit are kept open,
+ * and read again from the beginning with pread() in the next cycles.
+ * A file of an exited process fails to be read and is opened again, in case the PID is reused.
+ */
+class ProcReader
+{
+public:
+  ProcReader();
+  ~ProcReader();
+
+  ProcReader(const ProcReader &) = delete;
+  ProcReader & operator=(const ProcReader &) = delete;
+
+  /**
+   * @brief open "proc" directory under root path, closing all the files opened before
+   * @param [in]  root_path Root path ending with '/'
+   * @return true if successful
+   */
+  bool setRoot(const std::string & root_path);
+
+  /**
+   * @brief list the process IDs in the proc directory, and close the files of exited processes
+   * @param [out] pids Process IDs in the order of the directory entries
+   * @return true if the proc directory is open
+   */
+  bool listProcesses(std::vector<pid_t> & pids);
+
+  /**
+   * @brief read /proc/[pid]/stat
+   * @param [in]  pid  Process ID
+   * @param [out] info Stat information
+   * @return true if successful
+   */
+  bool readStat(pid_t pid, StatInfo & info);
+
+  /**
+   * @brief read /proc/[pid]/statm
+   * @param [in]  pid  Process ID
+   * @param [out] info Memory information
+   * @return true if successful
+   */
+  bool readStatMemory(pid_t pid, StatMemoryInfo & info);
+
+  /**
+   * @brief read /proc/[pid]/status
+   * @param [in]  pid  Process ID
+   * @param [out] info Status information
+   * @return true if successful
+   */
+  bool readStatus(pid_t pid, StatusInfo & info);
+
+  /**
+   * @brief read /proc/[pid]/cmdline
+   * @param [in]  pid     Process ID
+   * @param [out] command Command line
+   * @return true if successful
+   * @note It has its own buffer and does not use the kept files,
+   * so that it may be called while another thread reads the other files.
+   */
+  bool readCommandLine(pid_t pid, std::string & command) const;
+
+  /**
+   * @brief get number of files kept open
+   * @return Number of files kept open
+   */
+  size_t getNumOfOpenFiles() const;
+
+private:
+  enum FileKind : size_t { kStat = 0, kStatMemory, kStatus, kNumOfFileKinds };
+
+  struct OpenFiles
+  {
+    std::array<int, kNumOfFileKinds> fds{-1, -1, -1};
+    uint64_t listed_cycle{0};  //!< @brief last cycle in which the process was listed
+  };
+
+  /**
+   * @brief read a file of a process into buffer_
+   * @return File content, or nullptr data if the file can't be read
+   */
+  std::string_view readFile(pid_t pid, FileKind kind);
+
+  void closeAllFiles();
+
+  int proc_fd_{-1};                  //!< @brief file descriptor of the proc directory
+  size_t max_open_processes_{0};     //!< @brief number of processes whose files are kept open
+  uint64_t cycle_{0};                //!< @brief number of calls to listProcesses()
+  std::vector<char> dirent_buffer_;  //!< @brief buffer for getdents64()
+  std::vector<char> buffer_;         //!< @brief buffer for stat, statm and status files
+  std::unordered_map<pid_t, OpenFiles> open_files_;  //!< @brief files kept open by PID
+};
+
+#endif  // SYSTEM_MONITOR__PROCESS_MONITOR__PROC_READER_HPP_
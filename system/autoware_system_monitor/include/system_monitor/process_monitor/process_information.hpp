@@ -17,11 +17,15 @@
 
 // This file defines structures for process information.
 // As the definitions are implementation dependent,
-// this file should be included only from process_monitor.cpp to reduce dependencies.
+// this file should be included only from the implementation of process_monitor
+// to reduce dependencies.
+
+#include <sys/types.h>  // for pid_t, uid_t
 
 #include <cstdint>  // for int32_t, int64_t
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // For type and size of fields, see "man 5 proc".
@@ -85,6 +89,21 @@ struct RawProcessInfo
   DiffInfo diff_info;
 };
 
+struct ProcessRecord
+{
+  RawProcessInfo info;
+  uint64_t cycle;  // last cycle in which the process was read successfully
+};
+
+// Processes read in the current and the previous cycles.
+// The records are updated in place, so that no allocation is needed for existing processes.
+struct ProcessTable
+{
+  std::unordered_map<pid_t, ProcessRecord> records;
+  std::vector<pid_t> pids;  // PIDs listed in the current cycle
+  uint64_t cycle;
+};
+
 struct ProcessStatistics
 {
   std::vector<std::unique_ptr<RawProcessInfo>> load_tasks_raw;
@@ -30,10 +30,11 @@
 #include <memory>
 #include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+class ProcReader;
 struct ProcessStatistics;
+struct ProcessTable;
 struct RawProcessInfo;
 
 class ProcessMonitor : public rclcpp::Node
@@ -147,9 +148,10 @@ private:
 
   /**
    * @brief collect process information
-   * @param [in]  pid_str Process ID in numeric string
+   * @param [in]  pid Process ID
+   * @return Raw process information, nullptr if the process is not a valid process
    */
-  void collectProcessInfo(const char * pid_str);
+  const RawProcessInfo * collectProcessInfo(const pid_t pid);
 
   /**
    * @brief scan proc filesystem
@@ -176,16 +178,9 @@ private:
   void updateHighMemoryProcessRanking(const RawProcessInfo & info);
 
   /**
-   * @brief register process information to new map
-   * @param [in] pid  Process ID
-   * @param [in] info Raw process information
+   * @brief remove records of processes which were not read in the current cycle
    */
-  void registerProcessInfoToNewMap(const pid_t pid, const RawProcessInfo & info);
-
-  /**
-   * @brief rotate process maps
-   */
-  void rotateProcessMaps();
+  void removeStaleProcessRecords();
 
   /**
    * @brief get system uptime
@@ -200,7 +195,7 @@ private:
    * @param [out] command Command line
    * @return true if successful
    */
-  bool getCommandLineFromPid(const std::string & pid, std::string & command) const;
+  bool getCommandLineFromPid(const pid_t pid, std::string & command) const;
 
   /**
    * @brief set error content
@@ -233,10 +228,9 @@ private:
 
   std::unique_ptr<ProcessStatistics>
     work_{};  //!< @brief Unstable information being read from /proc files
-  std::unordered_map<pid_t, std::shared_ptr<RawProcessInfo>> pid_map1_{};
-  std::unordered_map<pid_t, std::shared_ptr<RawProcessInfo>> pid_map2_{};
-  std::unordered_map<pid_t, std::shared_ptr<RawProcessInfo>> & prev_map_{pid_map1_};
-  std::unordered_map<pid_t, std::shared_ptr<RawProcessInfo>> & new_map_{pid_map2_};
+  std::unique_ptr<ProcReader> proc_reader_{};  //!< @brief Reader of /proc files
+  std::unique_ptr<ProcessTable>
+    process_table_{};  //!< @brief Processes of the current and the previous cycles
 
   std::unique_ptr<ProcessStatistics>
     snapshot_{};  //!< @brief Stable information copied from work_ within mutex_ locked scope
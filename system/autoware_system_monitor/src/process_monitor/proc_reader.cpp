@@ -0,0 +1,468 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file proc_reader.cpp
+ * @brief Reader of the /proc files used by the process monitor
+ */
+
+#include "system_monitor/process_monitor/proc_reader.hpp"
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+// Whitespace characters of the "C" locale, skipped by formatted stream extraction.
+bool isSpace(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// Scanner of whitespace-delimited fields.
+// The former implementation used std::istringstream, and the values are accepted and rejected
+// in the same way: an optional sign followed by digits, out-of-range values are errors,
+// and negative values are wrapped around for unsigned types.
+class FieldScanner
+{
+public:
+  explicit FieldScanner(std::string_view text) : text_(text) {}
+
+  bool next(char & value)
+  {
+    skipSpaces();
+    if (pos_ >= text_.size()) {
+      return false;
+    }
+    value = text_[pos_++];
+    return true;
+  }
+
+  template <typename T>
+  bool next(T & value)
+  {
+    static_assert(std::is_integral_v<T>);
+    using UnsignedT = std::make_unsigned_t<T>;
+
+    skipSpaces();
+    bool negative = false;
+    if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
+      negative = text_[pos_] == '-';
+      ++pos_;
+    }
+    const UnsignedT limit = static_cast<UnsignedT>(std::numeric_limits<T>::max()) +
+                            ((std::is_signed_v<T> && negative) ? 1 : 0);
+
+    const std::size_t digits_pos = pos_;
+    UnsignedT magnitude = 0;
+    bool overflow = false;
+    for (; pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9'; ++pos_) {
+      const auto digit = static_cast<UnsignedT>(text_[pos_] - '0');
+      overflow = overflow || (magnitude > (limit - digit) / 10);
+      magnitude = static_cast<UnsignedT>(magnitude * 10 + digit);
+    }
+    if (pos_ == digits_pos || overflow) {
+      return false;
+    }
+    value = static_cast<T>(negative ? static_cast<UnsignedT>(0 - magnitude) : magnitude);
+    return true;
+  }
+
+  template <typename T, typename... Rest>
+  bool next(T & value, Rest &... rest)
+  {
+    return next(value) && next(rest...);
+  }
+
+private:
+  void skipSpaces()
+  {
+    while (pos_ < text_.size() && isSpace(text_[pos_])) {
+      ++pos_;
+    }
+  }
+
+  std::string_view text_;
+  std::size_t pos_{0};
+};
+
+// Convert a directory entry name to a process ID.
+// Only the canonical decimal form is accepted, as the kernel never names an entry otherwise.
+bool toProcessId(const char * name, pid_t & pid)
+{
+  const std::size_t length = std::strlen(name);
+  if (length == 0 || length > 10 || name[0] == '0') {
+    return false;
+  }
+  int64_t value = 0;
+  const auto [end, error] = std::from_chars(name, name + length, value);
+  if (error != std::errc() || end != name + length || value > std::numeric_limits<pid_t>::max()) {
+    return false;
+  }
+  pid = static_cast<pid_t>(value);
+  return true;
+}
+
+// Read a whole file from the beginning into buffer, which is enlarged if necessary.
+// As "top" does, a short read is regarded as the end of a file.
+bool readAll(const int fd, std::vector<char> & buffer, std::size_t & length)
+{
+  length = 0;
+  for (;;) {
+    if (length == buffer.size()) {
+      buffer.resize(buffer.size() * 2);
+    }
+    const std::size_t space = buffer.size() - length;
+    const ssize_t read_size =
+      ::pread(fd, buffer.data() + length, space, static_cast<off_t>(length));
+    if (read_size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    length += static_cast<std::size_t>(read_size);
+    if (static_cast<std::size_t>(read_size) < space) {
+      return true;
+    }
+  }
+}
+
+// Fill "<pid>/<file_name>" with a terminating NUL.
+void makeProcessFilePath(const pid_t pid, const char * file_name, char (&path)[32])
+{
+  char * end = std::to_chars(path, path + 11, pid).ptr;
+  *end++ = '/';
+  std::strcpy(end, file_name);
+}
+
+constexpr const char * kFileNames[] = {"stat", "statm", "status"};
+constexpr std::size_t kInitialBufferSize = 4096;
+constexpr std::size_t kDirentBufferSize = 32768;
+// Offsets of d_reclen and d_name in struct linux_dirent64. See "man 2 getdents64".
+constexpr std::size_t kDirentRecordLengthOffset = 16;
+constexpr std::size_t kDirentNameOffset = 19;
+
+}  // namespace
+
+bool parseStat(std::string_view content, StatInfo & info)
+{
+  if (content.empty()) {
+    return false;
+  }
+  const std::string_view line = content.substr(0, content.find('\n'));
+
+  StatInfo info_temp{};
+  if (!FieldScanner(line).next(info_temp.pid)) {
+    return false;
+  }
+
+  // command may include spaces. Ex. (UVM deferred release queue)
+  // command may include multiple pairs of parentheses. Ex. ((XXX))
+  const std::size_t left_parenthesis_pos = line.find('(');
+  const auto * right_parenthesis =
+    static_cast<const char *>(::memrchr(line.data(), ')', line.size()));
+  if ((left_parenthesis_pos == std::string_view::npos) || (right_parenthesis == nullptr)) {
+    return false;
+  }
+  const auto right_parenthesis_pos = static_cast<std::size_t>(right_parenthesis - line.data());
+
+  const std::size_t command_len =
+    right_parenthesis_pos - left_parenthesis_pos + 1;  // includes parentheses.
+  const std::string_view command = line.substr(left_parenthesis_pos, command_len);
+  FieldScanner after_command(line.substr(right_parenthesis_pos + 1));
+  if (!after_command.next(
+        info_temp.state, info_temp.ppid, info_temp.pgrp, info_temp.session, info_temp.tty_nr,
+        info_temp.tpgid, info_temp.flags, info_temp.min_flt, info_temp.c_min_flt,
+        info_temp.maj_flt, info_temp.c_maj_flt, info_temp.utime_tick, info_temp.stime_tick,
+        info_temp.c_utime_tick, info_temp.c_stime_tick, info_temp.priority, info_temp.nice,
+        info_temp.num_threads, info_temp.it_real_value, info_temp.starttime_tick,
+        info_temp.vsize_byte, info_temp.rss_page)) {
+    return false;  // Failed to read all values
+  }
+  // The string of info is reused to avoid an allocation in each cycle.
+  info = info_temp;
+  info.command.assign(command.data(), command.size());
+  return true;
+}
+
+bool parseStatMemory(std::string_view content, StatMemoryInfo & info)
+{
+  StatMemoryInfo info_temp{};
+  if (!FieldScanner(content).next(
+        info_temp.size_page, info_temp.resident_page, info_temp.share_page)) {
+    return false;  // Failed to read all values
+  }
+  info = info_temp;
+  return true;
+}
+
+bool parseStatus(std::string_view content, StatusInfo & info)
+{
+  StatusInfo info_temp{};
+  std::string_view command;
+  constexpr uint FOUND_NAME = 0x1;
+  constexpr uint FOUND_UID = 0x2;
+  constexpr uint FOUND_ALL = FOUND_NAME | FOUND_UID;
+  uint found_entries = 0x0;
+  while (!content.empty() && found_entries != FOUND_ALL) {
+    const std::size_t line_end = content.find('\n');
+    const std::string_view line = content.substr(0, line_end);
+    content.remove_prefix(line_end == std::string_view::npos ? content.size() : line_end + 1);
+
+    std::size_t first_delimiter_pos = line.find('\t');  // Delimiters in "status" are tabs.
+    if (first_delimiter_pos == std::string_view::npos) {
+      continue;  // Skip malformed lines
+    }
+    const std::string_view header = line.substr(0, first_delimiter_pos);
+    if (header == "Name:") {
+      std::size_t cmd_pos = line.find_first_not_of("\t ", first_delimiter_pos);
+      if (cmd_pos == std::string_view::npos) {
+        return false;  // No name at all. Further processing is meaningless.
+      }
+      // "Name:" line may contain multiple words delimited by spaces.
+      // Ex. "Name: UVM deferred release queue"
+      command = line.substr(cmd_pos);
+      found_entries |= FOUND_NAME;
+    } else if (header == "Uid:") {
+      // Delimiters (tabs and spaces) are skipped.
+      if (!FieldScanner(line.substr(first_delimiter_pos))
+             .next(
+               info_temp.real_uid, info_temp.effective_uid, info_temp.saved_set_uid,
+               info_temp.filesystem_uid)) {
+        continue;  // Skip malformed lines
+      }
+      found_entries |= FOUND_UID;
+    }
+  }
+  if (found_entries != FOUND_ALL) {
+    return false;
+  }
+  info = info_temp;
+  info.command.assign(command.data(), command.size());
+  return true;
+}
+
+bool parseCommandLine(std::string_view content, std::string & command)
+{
+  // Whitespace bytes are skipped as the formatted stream extraction of the former implementation
+  // did, so that the reported command lines do not change.
+  command.clear();
+  for (const char c : content) {
+    if (!isSpace(c)) {
+      // 0x00 is used as delimiter in /cmdline instead of 0x20 (space)
+      command.push_back(c == '\0' ? ' ' : c);
+    }
+  }
+  if (command.empty()) {  // cmdline is empty if it is a kernel process
+    return false;
+  }
+  // The last byte is the end-of-C-string.
+  command.pop_back();
+  // Remove trailing spaces
+  command.erase(command.find_last_not_of(' ') + 1);
+  return true;
+}
+
+ProcReader::ProcReader()
+: dirent_buffer_(kDirentBufferSize), buffer_(kInitialBufferSize)
+{
+  // Keep a margin of file descriptors for the rest of the process.
+  constexpr rlim_t MAX_OPEN_PROCESSES = 4096;
+  rlimit limit{};
+  if (::getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+    max_open_processes_ = static_cast<std::size_t>(
+      std::min(limit.rlim_cur / 4 / kNumOfFileKinds, MAX_OPEN_PROCESSES));
+  }
+  open_files_.reserve(max_open_processes_);
+}
+
+ProcReader::~ProcReader()
+{
+  closeAllFiles();
+  if (proc_fd_ >= 0) {
+    ::close(proc_fd_);
+  }
+}
+
+bool ProcReader::setRoot(const std::string & root_path)
+{
+  closeAllFiles();
+  if (proc_fd_ >= 0) {
+    ::close(proc_fd_);
+  }
+  const std::string proc_path = root_path + "proc";
+  proc_fd_ = ::open(proc_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  return proc_fd_ >= 0;
+}
+
+bool ProcReader::listProcesses(std::vector<pid_t> & pids)
+{
+  pids.clear();
+  if (proc_fd_ < 0 || ::lseek(proc_fd_, 0, SEEK_SET) < 0) {
+    return false;
+  }
+  ++cycle_;
+
+  // Note that any entry may disappear after getdents64() returns.
+  for (;;) {
+    const auto read_size =
+      ::syscall(SYS_getdents64, proc_fd_, dirent_buffer_.data(), dirent_buffer_.size());
+    if (read_size <= 0) {
+      // If read_size is 0, there is no more entry to read in the directory.
+      // If read_size is negative, there is an error.
+      // In either case, stop further processing.
+      break;
+    }
+    for (std::size_t offset = 0; offset < static_cast<std::size_t>(read_size);) {
+      const char * record = dirent_buffer_.data() + offset;
+      uint16_t record_length;
+      std::memcpy(&record_length, record + kDirentRecordLengthOffset, sizeof(record_length));
+      offset += record_length;
+
+      pid_t pid;
+      if (!toProcessId(record + kDirentNameOffset, pid)) {
+        continue;
+      }
+      pids.push_back(pid);
+      const auto open_files = open_files_.find(pid);
+      if (open_files != open_files_.end()) {
+        open_files->second.listed_cycle = cycle_;
+      }
+    }
+  }
+
+  // Close the files of exited processes
+  for (auto iter = open_files_.begin(); iter != open_files_.end();) {
+    if (iter->second.listed_cycle == cycle_) {
+      ++iter;
+      continue;
+    }
+    for (const int fd : iter->second.fds) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+    iter = open_files_.erase(iter);
+  }
+  return true;
+}
+
+bool ProcReader::readStat(const pid_t pid, StatInfo & info)
+{
+  const std::string_view content = readFile(pid, kStat);
+  return content.data() != nullptr && parseStat(content, info);
+}
+
+bool ProcReader::readStatMemory(const pid_t pid, StatMemoryInfo & info)
+{
+  const std::string_view content = readFile(pid, kStatMemory);
+  return content.data() != nullptr && parseStatMemory(content, info);
+}
+
+bool ProcReader::readStatus(const pid_t pid, StatusInfo & info)
+{
+  const std::string_view content = readFile(pid, kStatus);
+  return content.data() != nullptr && parseStatus(content, info);
+}
+
+// It is not always guaranteed that /proc/[pid]/cmdline file is readable.
+// Please see "man 5 proc".
+bool ProcReader::readCommandLine(const pid_t pid, std::string & command) const
+{
+  char path[32];
+  makeProcessFilePath(pid, "cmdline", path);
+  const int fd = ::openat(proc_fd_, path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  std::vector<char> buffer(kInitialBufferSize);
+  std::size_t length = 0;
+  const bool read_succeeded = readAll(fd, buffer, length);
+  ::close(fd);
+  return read_succeeded && parseCommandLine(std::string_view(buffer.data(), length), command);
+}
+
+size_t ProcReader::getNumOfOpenFiles() const
+{
+  std::size_t num_of_open_files = 0;
+  for (const auto & [pid, open_files] : open_files_) {
+    num_of_open_files += static_cast<std::size_t>(
+      std::count_if(open_files.fds.begin(), open_files.fds.end(), [](int fd) { return fd >= 0; }));
+  }
+  return num_of_open_files;
+}
+
+std::string_view ProcReader::readFile(const pid_t pid, const FileKind kind)
+{
+  std::size_t length = 0;
+  auto open_files = open_files_.find(pid);
+  if (open_files != open_files_.end()) {
+    int & fd = open_files->second.fds[kind];
+    if (fd >= 0) {
+      if (readAll(fd, buffer_, length)) {
+        return std::string_view(buffer_.data(), length);
+      }
+      // The process has exited, and the PID may have been reused.
+      ::close(fd);
+      fd = -1;
+    }
+  }
+
+  char path[32];
+  makeProcessFilePath(pid, kFileNames[kind], path);
+  const int fd = ::openat(proc_fd_, path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return {};
+  }
+  if (!readAll(fd, buffer_, length)) {
+    ::close(fd);
+    return {};
+  }
+
+  if (open_files == open_files_.end() && open_files_.size() < max_open_processes_) {
+    open_files = open_files_.emplace(pid, OpenFiles{}).first;
+    open_files->second.listed_cycle = cycle_;
+  }
+  if (open_files != open_files_.end()) {
+    open_files->second.fds[kind] = fd;
+  } else {
+    ::close(fd);
+  }
+  return std::string_view(buffer_.data(), length);
+}
+
+void ProcReader::closeAllFiles()
+{
+  for (const auto & [pid, open_files] : open_files_) {
+    for (const int fd : open_files.fds) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+  open_files_.clear();
+}
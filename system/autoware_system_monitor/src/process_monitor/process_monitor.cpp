@@ -19,11 +19,11 @@
 
 #include "system_monitor/process_monitor/process_monitor.hpp"
 
+#include "system_monitor/process_monitor/proc_reader.hpp"
 #include "system_monitor/process_monitor/process_information.hpp"
 
 #include <autoware_utils/system/stop_watch.hpp>
 
-#include <dirent.h>
 #include <fmt/format.h>
 #include <pwd.h>
 #include <sys/types.h>
@@ -209,157 +209,6 @@ std::string convertUidToUserName(uid_t uid)
   return std::to_string(uid);
 }
 
-bool isNumeric(const std::string & str)
-{
-  return !str.empty() && (str.find_first_not_of("0123456789") == std::string::npos);
-}
-
-bool isProcessID(const char * entry)
-{
-  const std::string name(entry);
-
-  // A process/thread entry has a numeric name.
-  // No need to distinguish between process and thread.
-  return isNumeric(name);
-}
-
-bool readStat(const std::string & proc_path, StatInfo & info)
-{
-  std::string stat_path = proc_path + "stat";
-
-  std::ifstream stat_file(stat_path);
-  if (!stat_file) {
-    return false;
-  }
-  std::string line;
-  if (!std::getline(stat_file, line, '\n')) {
-    return false;
-  }
-
-  StatInfo info_temp{};
-  try {
-    std::istringstream line_stream(line);
-    line_stream.exceptions(std::ios::failbit | std::ios::badbit);
-    line_stream >> info_temp.pid;
-    line_stream.exceptions();  // Reset to default state
-  } catch (...) {
-    return false;
-  }
-
-  // command may include spaces. Ex. (UVM deferred release queue)
-  // command may include multiple pairs of parentheses. Ex. ((XXX))
-  const std::size_t left_parenthesis_pos = line.find('(');
-  const std::size_t right_parenthesis_pos = line.find_last_of(')');
-  if ((left_parenthesis_pos == std::string::npos) || (right_parenthesis_pos == std::string::npos)) {
-    return false;
-  }
-
-  const std::size_t command_len =
-    right_parenthesis_pos - left_parenthesis_pos + 1;  // includes parentheses.
-  try {  // Handle exceptions from std::string::substr(). Just in case.
-    const std::string command = line.substr(left_parenthesis_pos, command_len);
-    const std::string after_command = line.substr(right_parenthesis_pos + 1);
-    info_temp.command = command;
-
-    try {
-      std::istringstream after_command_stream(after_command);
-      after_command_stream.exceptions(std::ios::failbit | std::ios::badbit);
-      after_command_stream >> info_temp.state >> info_temp.ppid >> info_temp.pgrp >>
-        info_temp.session >> info_temp.tty_nr >> info_temp.tpgid >> info_temp.flags >>
-        info_temp.min_flt >> info_temp.c_min_flt >> info_temp.maj_flt >> info_temp.c_maj_flt >>
-        info_temp.utime_tick >> info_temp.stime_tick >> info_temp.c_utime_tick >>
-        info_temp.c_stime_tick >> info_temp.priority >> info_temp.nice >> info_temp.num_threads >>
-        info_temp.it_real_value >> info_temp.starttime_tick >> info_temp.vsize_byte >>
-        info_temp.rss_page;
-      after_command_stream.exceptions();  // Reset to default state
-    } catch (...) {
-      return false;  // Failed to read all values
-    }
-    info = info_temp;
-    return true;
-  } catch (...) {
-    return false;
-  }
-}
-
-bool readStatMemory(const std::string & proc_path, StatMemoryInfo & info)
-{
-  // cspell:ignore statm
-  const std::string stat_memory_path = proc_path + "statm";
-
-  std::ifstream stat_memory_file(stat_memory_path);
-  if (!stat_memory_file) {
-    return false;
-  }
-  StatMemoryInfo info_temp{};
-  try {
-    stat_memory_file.exceptions(std::ios::failbit | std::ios::badbit);
-    stat_memory_file >> info_temp.size_page >> info_temp.resident_page >> info_temp.share_page;
-    stat_memory_file.exceptions();  // Reset to default state
-  } catch (...) {
-    stat_memory_file.exceptions();  // Reset even if exception occurs
-    return false;                   // Failed to read all values
-  }
-  info = info_temp;
-  return true;
-}
-
-bool readStatus(const std::string & proc_path, StatusInfo & info)
-{
-  std::string status_path = proc_path + "status";
-
-  std::ifstream status_file(status_path);
-  if (!status_file) {
-    return false;
-  }
-  StatusInfo info_temp{};
-  constexpr uint FOUND_NAME = 0x1;
-  constexpr uint FOUND_UID = 0x2;
-  constexpr uint FOUND_ALL = FOUND_NAME | FOUND_UID;
-  uint found_entries = 0x0;
-  std::string line;
-  while (std::getline(status_file, line, '\n')) {
-    if (found_entries == FOUND_ALL) {
-      break;
-    }
-    std::size_t first_delimiter_pos = line.find('\t');  // Delimiters in "status" are tabs.
-    if (first_delimiter_pos == std::string::npos) {
-      continue;  // Skip malformed lines
-    }
-    try {  // Handle exceptions thrown by std::string::substr(). Just in case.
-      std::string header = line.substr(0, first_delimiter_pos);
-      if (header == "Name:") {
-        std::size_t cmd_pos =
-          line.find_first_not_of("\t ", first_delimiter_pos);  // Not TABs or spaces
-        // "Name:" line may contain multiple words delimited by spaces.
-        // Ex. "Name: UVM deferred release queue"
-        std::string command_line = line.substr(cmd_pos);
-        info_temp.command = command_line;
-        found_entries |= FOUND_NAME;
-      } else if (header == "Uid:") {
-        try {
-          std::istringstream uid_line(line.substr(first_delimiter_pos));
-          uid_line.exceptions(std::ios::failbit | std::ios::badbit);
-          // Delimiters (tabs and spaces) are skipped.
-          uid_line >> info_temp.real_uid >> info_temp.effective_uid >> info_temp.saved_set_uid >>
-            info_temp.filesystem_uid;
-          uid_line.exceptions();  // Reset to default state
-        } catch (...) {
-          continue;  // Skip malformed lines
-        }
-        found_entries |= FOUND_UID;
-      }
-    } catch (...) {
-      return false;  // Exception is not expected. Further processing is meaningless.
-    }
-  }
-  if (found_entries != FOUND_ALL) {
-    return false;
-  }
-  info = info_temp;
-  return true;
-}
-
 // Helper function for process ranking about CPU usage
 int64_t getCpuUsage(const RawProcessInfo & info)
 {
@@ -450,6 +299,8 @@ void ProcessMonitor::initialize()
 {
   using namespace std::literals::chrono_literals;
 
+  proc_reader_ = std::make_unique<ProcReader>();
+  process_table_ = std::make_unique<ProcessTable>();
   setRoot("/");
   gethostname(hostname_, sizeof(hostname_));
 
@@ -457,13 +308,13 @@ void ProcessMonitor::initialize()
   updater_.add("Tasks Summary", this, &ProcessMonitor::monitorProcesses);
 
   // As long as the number of processes is less than EXPECTED_NUM_PROCESSES,
-  // the size of the maps can be a compile-time constant.
-  // This is to avoid the cost of rehashing when the map is resized.
+  // the size of the table can be a compile-time constant.
+  // This is to avoid the cost of rehashing when the table is resized.
   // When the number of processes exceeds EXPECTED_NUM_PROCESSES,
-  // the map will be resized, which is a costly operation.
+  // the table will be resized, which is a costly operation.
   constexpr int32_t EXPECTED_NUM_PROCESSES = 1024;
-  pid_map1_.reserve(EXPECTED_NUM_PROCESSES);
-  pid_map2_.reserve(EXPECTED_NUM_PROCESSES);
+  process_table_->records.reserve(EXPECTED_NUM_PROCESSES);
+  process_table_->pids.reserve(EXPECTED_NUM_PROCESSES);
 
   work_ = std::make_unique<ProcessStatistics>();
   snapshot_ = std::make_unique<ProcessStatistics>();
@@ -517,6 +368,9 @@ void ProcessMonitor::setRoot(const std::string & root_path)
     new_root_path.append(1, '/');
   }
   root_path_ = new_root_path;
+  // Files opened under the previous root are closed.
+  // The process table is kept to calculate CPU usage from the previous cycle.
+  proc_reader_->setRoot(root_path_);
   // /proc/meminfo is read only when setRoot() is called.
   // If it can't be read, /proc pseudo-filesystem may not be mounted.
   bool meminfo_error_occurred = !readMemInfo();
@@ -546,40 +400,9 @@ void ProcessMonitor::getTasksSummary(
   stat.summary(DiagStatus::OK, "OK");
 }
 
-// It is not always guaranteed that /proc/[pid]/cmdline file is readable.
-// Please see "man 5 proc".
-bool ProcessMonitor::getCommandLineFromPid(const std::string & pid, std::string & command) const
+bool ProcessMonitor::getCommandLineFromPid(const pid_t pid, std::string & command) const
 {
-  std::string commandLineFilePath = root_path_ + "proc/" + pid + "/cmdline";
-  std::ifstream commandFile(commandLineFilePath, std::ios::in | std::ios::binary);
-
-  if (!commandFile) {
-    return false;
-  }
-  std::vector<uint8_t> buffer;
-  std::copy(
-    std::istream_iterator<uint8_t>(commandFile), std::istream_iterator<uint8_t>(),
-    std::back_inserter(buffer));
-  if (buffer.size() == 0) {  // cmdline is empty if it is a kernel process
-    return false;
-  }
-  // 0x00 is used as delimiter in /cmdline instead of 0x20 (space)
-  // Leave the last 0x00 (end-of-C-string) intact.
-  std::replace(buffer.begin(), (buffer.end() - 1), '\0', ' ');
-  // Make sure the last character is a null terminator.
-
-  // Although buffer.back() is safer and more idiomatic,
-  // using it here causes a compile error with -Werror=stringop-overflow.
-  // Therefore, we safely access the last element by index.
-  buffer[buffer.size() - 1] = '\0';
-  try {
-    std::string cmdline = std::string(buffer.begin(), (buffer.end() - 1));
-    // Remove trailing spaces
-    command = cmdline.substr(0, cmdline.find_last_not_of(' ') + 1);
-    return true;
-  } catch (const std::out_of_range &) {
-    return false;
-  }
+  return proc_reader_->readCommandLine(pid, command);
 }
 
 void ProcessMonitor::fillTaskInfo(
@@ -613,7 +436,7 @@ void ProcessMonitor::fillTaskInfo(
     formatCpuTime(raw_p->stat_info.utime_tick + raw_p->stat_info.stime_tick, clock_tick_);
 
   std::string commandName;
-  bool flag_find_command_line = getCommandLineFromPid(info.processId, commandName);
+  bool flag_find_command_line = getCommandLineFromPid(raw_p->stat_info.pid, commandName);
   if (flag_find_command_line) {
     info.commandName = commandName;
   } else {
@@ -711,37 +534,17 @@ void ProcessMonitor::updateHighMemoryProcessRanking(const RawProcessInfo & info)
     info, work_->memory_tasks_raw, info.stat_memory_info.resident_page, getMemoryUsage);
 }
 
-void ProcessMonitor::registerProcessInfoToNewMap(const pid_t pid, const RawProcessInfo & info)
+void ProcessMonitor::removeStaleProcessRecords()
 {
-  std::shared_ptr<RawProcessInfo> prev_info{nullptr};
-  try {
-    prev_info = prev_map_.at(pid);
-  } catch (...) {
-    ;
-  }
-  auto rtn = new_map_.emplace(pid, std::make_shared<RawProcessInfo>(info));
-  int64_t cpu_usage;
-  if (prev_info) {
-    cpu_usage =
-      static_cast<int64_t>(info.stat_info.utime_tick + info.stat_info.stime_tick) -
-      static_cast<int64_t>(prev_info->stat_info.utime_tick + prev_info->stat_info.stime_tick);
-  } else {
-    // Pid is a new process, which is not in prev_map_
-    cpu_usage = static_cast<int64_t>(info.stat_info.utime_tick + info.stat_info.stime_tick);
-  }
-  if (cpu_usage < 0) {
-    cpu_usage = 0;
+  // Records of exited or invalid processes are deleted as they are no longer in use.
+  auto & records = process_table_->records;
+  for (auto iter = records.begin(); iter != records.end();) {
+    if (iter->second.cycle != process_table_->cycle) {
+      iter = records.erase(iter);
+    } else {
+      ++iter;
+    }
   }
-  (rtn.first->second)->diff_info.cpu_usage = cpu_usage;
-}
-
-void ProcessMonitor::rotateProcessMaps()
-{
-  auto temp = prev_map_;
-  prev_map_ = new_map_;
-  // Data of PIDs that are referenced only in prev_map_ are deleted as they are no longer in use.
-  new_map_ = temp;
-  new_map_.clear();
 }
 
 bool ProcessMonitor::readMemInfo()
@@ -797,83 +600,64 @@ bool ProcessMonitor::readMemInfo()
   return true;
 }
 
-void ProcessMonitor::collectProcessInfo(const char * pid_str)
+const RawProcessInfo * ProcessMonitor::collectProcessInfo(const pid_t pid)
 {
-  RawProcessInfo info;
-
-  std::string procPath(root_path_ + "proc/");
-  procPath += pid_str;
-  procPath += "/";
+  // A record exists if the process was valid in the previous cycle.
+  const auto [iter, is_new_process] = process_table_->records.try_emplace(pid);
+  ProcessRecord & record = iter->second;
+  RawProcessInfo & info = record.info;
+  const uint64_t prev_cpu_tick = info.stat_info.utime_tick + info.stat_info.stime_tick;
 
   // If any of the following functions returns false, the process is not a valid process.
-  if (!readStat(procPath, info.stat_info)) {
-    return;
+  // Its record is left outdated and removed at the end of the cycle.
+  if (!proc_reader_->readStat(pid, info.stat_info)) {
+    return nullptr;
   }
-  if (!readStatMemory(procPath, info.stat_memory_info)) {
-    return;
+  if (!proc_reader_->readStatMemory(pid, info.stat_memory_info)) {
+    return nullptr;
   }
-  if (!readStatus(procPath, info.status_info)) {
-    return;
+  if (!proc_reader_->readStatus(pid, info.status_info)) {
+    return nullptr;
   }
 
-  pid_t pid;
-  try {
-    pid = static_cast<pid_t>(std::stoul(pid_str));
-  } catch (...) {
-    return;
-  }
   // CPU usage calculation is not possible from static information in /proc.
-  // Calculate the difference from the previous information.
-  registerProcessInfoToNewMap(pid, info);
+  // Calculate the difference from the information of the previous cycle.
+  const uint64_t cpu_tick = info.stat_info.utime_tick + info.stat_info.stime_tick;
+  int64_t cpu_usage;
+  if (!is_new_process) {
+    cpu_usage = static_cast<int64_t>(cpu_tick) - static_cast<int64_t>(prev_cpu_tick);
+  } else {
+    // Pid is a new process, which was not valid in the previous cycle
+    cpu_usage = static_cast<int64_t>(cpu_tick);
+  }
+  if (cpu_usage < 0) {
+    cpu_usage = 0;
+  }
+  info.diff_info.cpu_usage = cpu_usage;
+  record.cycle = process_table_->cycle;
+  return &info;
 }
 
 bool ProcessMonitor::scanProcFs()
 {
-  std::string proc_path = root_path_ + "proc";
-
-  // NOTE:
-  // opendir() and readdir() are not perfectly thread-safe.
-  // There shouldn't be a problem as long as other threads are not accessing /proc.
-  // See "man 3 readdir".
-  // readdir_r() has been deprecated and can't be used.
-  DIR * raw_dirp = opendir(proc_path.c_str());
-
-  if (raw_dirp == nullptr) {
+  // Scan all directory entries under /proc
+  // Note that any process may exit after it is listed.
+  if (!proc_reader_->listProcesses(process_table_->pids)) {
     return false;
   }
-  std::unique_ptr<DIR, std::function<void(DIR *)>> directory(
-    raw_dirp, [](DIR * dirp) { closedir(dirp); });
+  ++process_table_->cycle;
 
-  // Scan all directory entries under /proc
-  // Note that any entry may disappear after readdir() returns.
-  // Read "man 3 readdir" about thread safety.
-  for (;;) {
-    errno = 0;
-    const struct dirent * dir_entry = readdir(directory.get());
-    if (dir_entry == nullptr) {
-      // If errno is 0, there is no more entry to read in the directory.
-      // If errno is not 0, there is an error.
-      // In either case, stop further processing.
-      break;
-    }
-
-    // The maximum length of string d_name is not fixed.
-    // See "man 3 readdir".
-    if (!isProcessID(dir_entry->d_name)) {
+  initializeProcessStatistics();
+  for (const pid_t pid : process_table_->pids) {
+    const RawProcessInfo * info = collectProcessInfo(pid);
+    if (info == nullptr) {
       continue;
     }
-    collectProcessInfo(dir_entry->d_name);
+    accumulateStateCount(*info);
+    updateHighLoadProcessRanking(*info);
+    updateHighMemoryProcessRanking(*info);
   }
-  // Information about all valid processes is stored in new_map_
-  initializeProcessStatistics();
-  for (const auto & iter : new_map_) {
-    const RawProcessInfo & info = *(iter.second);
-    accumulateStateCount(info);
-    updateHighLoadProcessRanking(info);
-    updateHighMemoryProcessRanking(info);
-  }
-  rotateProcessMaps();
-  // /proc is closed automatically by the destructor of directory.
+  removeStaleProcessRecords();
   return true;
 }
 
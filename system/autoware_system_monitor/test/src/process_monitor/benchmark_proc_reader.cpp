@@ -0,0 +1,240 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Cost of reading the stat, statm and status files of all the processes in a cycle,
+// over a synthetic /proc tree with a given number of processes:
+// the former way with directory streams and string streams, against ProcReader.
+// Usage: benchmark_proc_reader [root path]
+//   With a root path, e.g. "/", the real /proc file-system under it is read instead.
+
+#include "system_monitor/process_monitor/proc_reader.hpp"
+#include "system_monitor/process_monitor/process_information.hpp"
+
+#include <dirent.h>
+#include <fmt/format.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::atomic<size_t> allocation_count{0};
+}  // namespace
+
+void * operator new(size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void * ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr int kNumOfCycles = 20;
+
+void writeFile(const fs::path & path, const std::string & content)
+{
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+}
+
+// A tree of processes with the contents of a typical ROS 2 node.
+std::string createProcTree(const int num_of_processes)
+{
+  char root_template[] = "/tmp/benchmark_proc_reader_XXXXXX";
+  const std::string root = ::mkdtemp(root_template);
+  for (int i = 0; i < num_of_processes; ++i) {
+    const int pid = 1000 + i;
+    const fs::path dir = fs::path(root) / "proc" / std::to_string(pid);
+    fs::create_directories(dir);
+    writeFile(
+      dir / "stat",
+      fmt::format(
+        "{} (component_conta) S 1 {} {} 0 -1 4194560 {} 0 12 0 {} {} 0 0 20 0 {} 0 {} "
+        "2147483648 {} 18446744073709551615 1 1 0 0 0 0 0 4096 17410 0 0 0 17 3 0 0 0 0 0\n",
+        pid, pid, pid, 100000 + i, 5000 + i * 7, 800 + i * 3, 4 + i % 30, 300000 + i,
+        20000 + i));
+    writeFile(
+      dir / "statm", fmt::format("{} {} {} 1 0 {} 0\n", 524288 + i, 20000 + i, 9000, 60000));
+    std::string status = fmt::format(
+      "Name:\tcomponent_conta\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t{}\nNgid:\t0\n"
+      "Pid:\t{}\nPPid:\t1\nTracerPid:\t0\nUid:\t1000\t1000\t1000\t1000\n"
+      "Gid:\t1000\t1000\t1000\t1000\nFDSize:\t256\nGroups:\t4 24 27 30 46 100 118 1000\n",
+      pid, pid);
+    for (const char * key : {"VmPeak", "VmSize", "VmLck", "VmPin", "VmHWM", "VmRSS", "RssAnon",
+                             "RssFile", "RssShmem", "VmData", "VmStk", "VmExe", "VmLib", "VmPTE",
+                             "VmSwap", "HugetlbPages"}) {
+      status += fmt::format("{}:\t{:8} kB\n", key, 1000 + i);
+    }
+    status += "Threads:\t30\nSigQ:\t0/62584\nSigPnd:\t0000000000000000\n";
+    writeFile(dir / "status", status);
+    constexpr char cmdline[] =
+      "/opt/autoware/lib/rclcpp_components/component_container\0--ros-args\0__node:=container";
+    writeFile(dir / "cmdline", std::string(cmdline, sizeof(cmdline)));
+  }
+  return root + "/";
+}
+
+// The former implementation: a directory stream, and a file stream and string streams per file.
+int readWithStreams(const std::string & root_path)
+{
+  int num_of_valid_processes = 0;
+  DIR * dir = ::opendir((root_path + "proc").c_str());
+  if (dir == nullptr) {
+    return 0;
+  }
+  while (const struct dirent * entry = ::readdir(dir)) {
+    const std::string name(entry->d_name);
+    if (name.empty() || name.find_first_not_of("0123456789") != std::string::npos) {
+      continue;
+    }
+    const std::string proc_path = root_path + "proc/" + name + "/";
+
+    RawProcessInfo info;
+    std::ifstream stat_file(proc_path + "stat");
+    std::string line;
+    if (!stat_file || !std::getline(stat_file, line)) {
+      continue;
+    }
+    std::istringstream pid_stream(line);
+    pid_stream >> info.stat_info.pid;
+    const auto left = line.find('(');
+    const auto right = line.find_last_of(')');
+    info.stat_info.command = line.substr(left, right - left + 1);
+    std::istringstream stat_stream(line.substr(right + 1));
+    auto & s = info.stat_info;
+    stat_stream >> s.state >> s.ppid >> s.pgrp >> s.session >> s.tty_nr >> s.tpgid >> s.flags >>
+      s.min_flt >> s.c_min_flt >> s.maj_flt >> s.c_maj_flt >> s.utime_tick >> s.stime_tick >>
+      s.c_utime_tick >> s.c_stime_tick >> s.priority >> s.nice >> s.num_threads >>
+      s.it_real_value >> s.starttime_tick >> s.vsize_byte >> s.rss_page;
+
+    std::ifstream stat_memory_file(proc_path + "statm");
+    auto & m = info.stat_memory_info;
+    stat_memory_file >> m.size_page >> m.resident_page >> m.share_page;
+
+    std::ifstream status_file(proc_path + "status");
+    int found = 0;
+    while (found < 2 && std::getline(status_file, line)) {
+      const auto tab = line.find('\t');
+      if (tab == std::string::npos) {
+        continue;
+      }
+      const std::string header = line.substr(0, tab);
+      if (header == "Name:") {
+        info.status_info.command = line.substr(line.find_first_not_of("\t ", tab));
+        ++found;
+      } else if (header == "Uid:") {
+        std::istringstream uid_stream(line.substr(tab));
+        uid_stream >> info.status_info.real_uid >> info.status_info.effective_uid >>
+          info.status_info.saved_set_uid >> info.status_info.filesystem_uid;
+        ++found;
+      }
+    }
+    if (stat_stream && stat_memory_file && found == 2) {
+      ++num_of_valid_processes;
+    }
+  }
+  ::closedir(dir);
+  return num_of_valid_processes;
+}
+
+int readWithProcReader(ProcReader & reader, std::vector<pid_t> & pids, RawProcessInfo & info)
+{
+  int num_of_valid_processes = 0;
+  reader.listProcesses(pids);
+  for (const pid_t pid : pids) {
+    if (
+      reader.readStat(pid, info.stat_info) && reader.readStatMemory(pid, info.stat_memory_info) &&
+      reader.readStatus(pid, info.status_info)) {
+      ++num_of_valid_processes;
+    }
+  }
+  return num_of_valid_processes;
+}
+
+template <typename ReadFunc>
+void measure(const std::string & label, const ReadFunc & read)
+{
+  read();  // warm up, and open the files to keep
+  const size_t allocations_before = allocation_count.load();
+  int num_of_valid_processes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumOfCycles; ++i) {
+    num_of_valid_processes = read();
+  }
+  const double elapsed_ms =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  const size_t allocations = allocation_count.load() - allocations_before;
+  std::cout << fmt::format(
+                 "  {:<12} {:>9.3f} ms/cycle {:>9.1f} allocations/cycle ({} processes)", label,
+                 elapsed_ms / kNumOfCycles, static_cast<double>(allocations) / kNumOfCycles,
+                 num_of_valid_processes)
+            << std::endl;
+}
+
+void run(const std::string & root_path)
+{
+  ProcReader reader;
+  reader.setRoot(root_path);
+  std::vector<pid_t> pids;
+  RawProcessInfo info;
+  measure("streams", [&]() { return readWithStreams(root_path); });
+  measure("ProcReader", [&]() { return readWithProcReader(reader, pids, info); });
+  std::cout << "  " << reader.getNumOfOpenFiles() << " files kept open" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc > 1) {
+    std::string root_path = argv[1];
+    if (root_path.empty() || root_path.back() != '/') {
+      root_path += '/';
+    }
+    std::cout << root_path << "proc" << std::endl;
+    run(root_path);
+    return 0;
+  }
+
+  for (const int num_of_processes : {100, 300, 1000}) {
+    const std::string root_path = createProcTree(num_of_processes);
+    std::cout << "synthetic tree of " << num_of_processes << " processes" << std::endl;
+    run(root_path);
+    fs::remove_all(root_path);
+  }
+  return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "system_monitor/process_monitor/proc_reader.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+TEST(ProcReaderTestSuite, parseStatTest)
+{
+  StatInfo info;
+  ASSERT_TRUE(parseStat(
+    "1234 (a (b) c) R 1 1234 1234 0 -1 4194560 100 0 12 0 5000 800 0 0 20 -5 4 0 300000 "
+    "2147483648 20000 18446744073709551615 1 1 0 0\n",
+    info));
+  EXPECT_EQ(info.pid, 1234);
+  EXPECT_EQ(info.command, "(a (b) c)");
+  EXPECT_EQ(info.state, 'R');
+  EXPECT_EQ(info.tty_nr, 0);
+  EXPECT_EQ(info.tpgid, -1);
+  EXPECT_EQ(info.utime_tick, 5000u);
+  EXPECT_EQ(info.stime_tick, 800u);
+  EXPECT_EQ(info.nice, -5);
+  EXPECT_EQ(info.num_threads, 4);
+  EXPECT_EQ(info.starttime_tick, 300000u);
+  EXPECT_EQ(info.vsize_byte, 2147483648u);
+  EXPECT_EQ(info.rss_page, 20000);
+
+  // A truncated line leaves the information unmodified.
+  StatInfo truncated = info;
+  EXPECT_FALSE(parseStat("1234 (a) R 1 1234 1234 0 -1 4194560 100 0 12", truncated));
+  EXPECT_EQ(truncated.command, "(a (b) c)");
+  EXPECT_FALSE(parseStat("1234 a R", truncated));
+  EXPECT_FALSE(parseStat("", truncated));
+}
+
+TEST(ProcReaderTestSuite, parseStatMemoryTest)
+{
+  StatMemoryInfo info;
+  ASSERT_TRUE(parseStatMemory("524288 20000 9000 1 0 60000 0\n", info));
+  EXPECT_EQ(info.size_page, 524288u);
+  EXPECT_EQ(info.resident_page, 20000u);
+  EXPECT_EQ(info.share_page, 9000u);
+
+  // As with istream, a negative value wraps around an unsigned field.
+  ASSERT_TRUE(parseStatMemory("-1 2 3\n", info));
+  EXPECT_EQ(info.size_page, static_cast<decltype(info.size_page)>(-1));
+
+  EXPECT_FALSE(parseStatMemory("1 2\n", info));
+  EXPECT_FALSE(parseStatMemory("1 2 x\n", info));
+  EXPECT_FALSE(parseStatMemory("99999999999999999999 2 3\n", info));
+}
+
+TEST(ProcReaderTestSuite, parseStatusTest)
+{
+  StatusInfo info;
+  ASSERT_TRUE(parseStatus(
+    "Name:\tcomponent_conta\nUmask:\t0022\nState:\tS (sleeping)\n"
+    "Uid:\t1000\t1001\t1002\t1003\nGid:\t1000\t1000\t1000\t1000\n",
+    info));
+  EXPECT_EQ(info.command, "component_conta");
+  EXPECT_EQ(info.real_uid, 1000u);
+  EXPECT_EQ(info.effective_uid, 1001u);
+  EXPECT_EQ(info.saved_set_uid, 1002u);
+  EXPECT_EQ(info.filesystem_uid, 1003u);
+
+  EXPECT_FALSE(parseStatus("Name:\tcomponent_conta\nUmask:\t0022\n", info));
+  EXPECT_FALSE(parseStatus("Uid:\t1000\t1001\t1002\t1003\n", info));
+}
+
+TEST(ProcReaderTestSuite, parseCommandLineTest)
+{
+  std::string command;
+  const char content[] = "/usr/bin/python3\0-m\0my module\0";
+  ASSERT_TRUE(parseCommandLine(std::string_view(content, sizeof(content) - 1), command));
+  EXPECT_EQ(command, "/usr/bin/python3 -m mymodule");
+
+  EXPECT_FALSE(parseCommandLine("", command));
+}
+
+TEST(ProcReaderTestSuite, readSelfTest)
+{
+  ProcReader reader;
+  ASSERT_TRUE(reader.setRoot("/"));
+
+  std::vector<pid_t> pids;
+  ASSERT_TRUE(reader.listProcesses(pids));
+  const pid_t self = ::getpid();
+  ASSERT_NE(std::find(pids.begin(), pids.end(), self), pids.end());
+
+  // The files are kept open and read again in the next cycle.
+  for (int cycle = 0; cycle < 2; ++cycle) {
+    StatInfo stat_info;
+    StatMemoryInfo stat_memory_info;
+    StatusInfo status_info;
+    ASSERT_TRUE(reader.readStat(self, stat_info));
+    ASSERT_TRUE(reader.readStatMemory(self, stat_memory_info));
+    ASSERT_TRUE(reader.readStatus(self, status_info));
+    EXPECT_EQ(stat_info.pid, self);
+    EXPECT_GT(stat_memory_info.size_page, 0u);
+    EXPECT_EQ(status_info.real_uid, ::getuid());
+    EXPECT_GE(reader.getNumOfOpenFiles(), 3u);
+    ASSERT_TRUE(reader.listProcesses(pids));
+  }
+
+  std::string command;
+  ASSERT_TRUE(reader.readCommandLine(self, command));
+  EXPECT_FALSE(command.empty());
+
+  // Setting the root again closes all the kept files.
+  ASSERT_TRUE(reader.setRoot("/"));
+  EXPECT_EQ(reader.getNumOfOpenFiles(), 0u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
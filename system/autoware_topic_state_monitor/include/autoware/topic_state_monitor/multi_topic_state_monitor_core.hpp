@@ -0,0 +1,81 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TOPIC_STATE_MONITOR__MULTI_TOPIC_STATE_MONITOR_CORE_HPP_
+#define AUTOWARE__TOPIC_STATE_MONITOR__MULTI_TOPIC_STATE_MONITOR_CORE_HPP_
+
+#include "autoware/topic_state_monitor/topic_timing_store.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+#include <string>
+#include <vector>
+
+namespace autoware::topic_state_monitor
+{
+struct TopicParam
+{
+  std::string diag_name;
+  std::string topic;
+  std::string topic_type;
+  std::string frame_id;
+  std::string child_frame_id;
+  bool transient_local;
+  bool best_effort;
+  bool is_transform;
+};
+
+/**
+ * @brief Monitor of many topics in one node.
+ * @details It works as TopicStateMonitorNode does for each topic listed in the "topics" parameter,
+ * with one subscription per topic and QoS shared by the topics (e.g. frame pairs of /tf), one
+ * timer, and one diagnostic array holding the statuses of all the topics.
+ */
+class MultiTopicStateMonitorNode : public rclcpp::Node
+{
+public:
+  explicit MultiTopicStateMonitorNode(const rclcpp::NodeOptions & node_options);
+
+private:
+  // Parameter
+  double update_rate_;
+  std::vector<TopicParam> topic_params_;
+
+  // Core
+  TopicTimingStore timing_store_;
+
+  // Subscriber
+  std::vector<rclcpp::GenericSubscription::SharedPtr> sub_topics_;
+  std::vector<rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr> sub_transforms_;
+  void createSubscriptions();
+
+  // Publisher
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr pub_diag_;
+  diagnostic_msgs::msg::DiagnosticArray diag_msg_;
+  void initDiagnostics();
+
+  // Timer
+  void onTimer();
+  rclcpp::TimerBase::SharedPtr timer_;
+
+  // Logging
+  std::vector<int64_t> last_log_times_ns_;
+  void printThrottle(size_t index, int64_t now_ns, bool is_warn, const char * msg);
+};
+}  // namespace autoware::topic_state_monitor
+
+#endif  // AUTOWARE__TOPIC_STATE_MONITOR__MULTI_TOPIC_STATE_MONITOR_CORE_HPP_
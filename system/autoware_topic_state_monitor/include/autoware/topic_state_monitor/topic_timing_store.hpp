@@ -0,0 +1,84 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__TOPIC_STATE_MONITOR__TOPIC_TIMING_STORE_HPP_
+#define AUTOWARE__TOPIC_STATE_MONITOR__TOPIC_TIMING_STORE_HPP_
+
+#include "autoware/topic_state_monitor/topic_state_monitor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::topic_state_monitor
+{
+/**
+ * @brief Arrival stamps of many topics in one contiguous buffer.
+ * @details Each topic owns a ring buffer of window_size stamps, placed back to back, so that the
+ * states of all the topics are judged in a single pass without any allocation.
+ * It is not thread-safe: record() and the getters must be called from mutually exclusive callbacks.
+ */
+class TopicTimingStore
+{
+public:
+  /**
+   * @brief Add a topic.
+   * @return Index of the topic, given in the order of addition.
+   */
+  size_t addTopic(const Param & param);
+
+  size_t size() const { return slots_.size(); }
+
+  const Param & getParam(size_t index) const { return slots_[index].param; }
+
+  /**
+   * @brief Record the arrival of a message.
+   * @param stamp_ns Arrival time [ns], in the clock used for getTopicStatus().
+   */
+  void record(size_t index, int64_t stamp_ns);
+
+  /**
+   * @brief Get the last arrival time, or 0 if no message has arrived.
+   */
+  int64_t getLastMessageTime(size_t index) const { return slots_[index].last_stamp_ns; }
+
+  /**
+   * @brief Get the rate of the topic over the window, or max_rate if it can't be calculated yet.
+   */
+  double getTopicRate(size_t index) const;
+
+  /**
+   * @brief Judge the state of the topic in the same way as TopicStateMonitor.
+   */
+  TopicStatus getTopicStatus(size_t index, int64_t now_ns) const;
+
+  static constexpr double max_rate = 100000.0;
+
+private:
+  struct Slot
+  {
+    Param param;
+    size_t offset;           //!< @brief first element of the ring buffer in stamps_
+    size_t capacity;         //!< @brief window size
+    size_t head{0};          //!< @brief element to be written next
+    size_t count{0};         //!< @brief number of valid elements
+    int64_t last_stamp_ns{0};
+  };
+
+  std::vector<Slot> slots_;
+  std::vector<int64_t> stamps_;
+};
+}  // namespace autoware::topic_state_monitor
+
+#endif  // AUTOWARE__TOPIC_STATE_MONITOR__TOPIC_TIMING_STORE_HPP_
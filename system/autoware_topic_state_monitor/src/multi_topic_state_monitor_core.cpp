@@ -0,0 +1,269 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/topic_state_monitor/multi_topic_state_monitor_core.hpp"
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Order of the key-values of a topic status, the same as TopicStateMonitorNode.
+enum KeyIndex : size_t {
+  kTopic = 0,
+  kStatus,
+  kWarnRate,
+  kErrorRate,
+  kTimeout,
+  kMeasuredRate,
+  kNow,
+  kLastMessageTime,
+  kNumOfKeys
+};
+
+constexpr const char * key_names[kNumOfKeys] = {
+  "topic",   "status",        "warn_rate", "error_rate",
+  "timeout", "measured_rate", "now",       "last_message_time"};
+
+constexpr int64_t log_throttle_ns = 3'000'000'000;
+
+void set_value(std::string & value, const char * format, const double number)
+{
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), format, number);
+  value.assign(buffer);
+}
+}  // namespace
+
+namespace autoware::topic_state_monitor
+{
+MultiTopicStateMonitorNode::MultiTopicStateMonitorNode(const rclcpp::NodeOptions & node_options)
+: Node("multi_topic_state_monitor", node_options)
+{
+  // Parameter
+  update_rate_ = declare_parameter("update_rate", 10.0);
+  for (const auto & name : declare_parameter<std::vector<std::string>>("topics")) {
+    const auto ns = name + ".";
+    TopicParam topic_param;
+    topic_param.topic = declare_parameter<std::string>(ns + "topic");
+    topic_param.transient_local = declare_parameter(ns + "transient_local", false);
+    topic_param.best_effort = declare_parameter(ns + "best_effort", false);
+    topic_param.diag_name = declare_parameter<std::string>(ns + "diag_name");
+    topic_param.is_transform = (topic_param.topic == "/tf" || topic_param.topic == "/tf_static");
+
+    if (topic_param.is_transform) {
+      topic_param.frame_id = declare_parameter<std::string>(ns + "frame_id");
+      topic_param.child_frame_id = declare_parameter<std::string>(ns + "child_frame_id");
+    } else {
+      topic_param.topic_type = declare_parameter<std::string>(ns + "topic_type");
+    }
+
+    Param param;
+    param.warn_rate = declare_parameter(ns + "warn_rate", 0.5);
+    param.error_rate = declare_parameter(ns + "error_rate", 0.1);
+    param.timeout = declare_parameter(ns + "timeout", 1.0);
+    param.window_size = declare_parameter(ns + "window_size", 10);
+
+    // Core
+    timing_store_.addTopic(param);
+    topic_params_.push_back(std::move(topic_param));
+  }
+  last_log_times_ns_.assign(topic_params_.size(), 0);
+
+  // Subscriber
+  createSubscriptions();
+
+  // Publisher
+  pub_diag_ = create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 1);
+  initDiagnostics();
+
+  // Timer
+  const auto period_ns = rclcpp::Rate(update_rate_).period();
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), period_ns, std::bind(&MultiTopicStateMonitorNode::onTimer, this));
+}
+
+void MultiTopicStateMonitorNode::createSubscriptions()
+{
+  // Topics with the same name and QoS share a subscription.
+  using SubscriptionKey = std::tuple<std::string, bool, bool>;
+  std::map<SubscriptionKey, std::vector<size_t>> topic_groups;
+  std::map<SubscriptionKey, std::vector<size_t>> transform_groups;
+  for (size_t i = 0; i < topic_params_.size(); ++i) {
+    const auto & p = topic_params_[i];
+    auto & groups = p.is_transform ? transform_groups : topic_groups;
+    groups[SubscriptionKey{p.topic, p.transient_local, p.best_effort}].push_back(i);
+  }
+
+  const auto create_qos = [](const SubscriptionKey & key) {
+    rclcpp::QoS qos = rclcpp::QoS{1};
+    if (std::get<1>(key)) {
+      qos.transient_local();
+    }
+    if (std::get<2>(key)) {
+      qos.best_effort();
+    }
+    return qos;
+  };
+
+  for (const auto & [key, indices] : topic_groups) {
+    const auto & topic_type = topic_params_[indices.front()].topic_type;
+    for (const auto index : indices) {
+      if (topic_params_[index].topic_type != topic_type) {
+        throw std::invalid_argument(
+          "topic " + std::get<0>(key) + " is given different types: " + topic_type + ", " +
+          topic_params_[index].topic_type);
+      }
+    }
+    sub_topics_.push_back(this->create_generic_subscription(
+      std::get<0>(key), topic_type, create_qos(key),
+      [this, indices = indices]([[maybe_unused]] std::shared_ptr<rclcpp::SerializedMessage> msg) {
+        const auto now_ns = this->now().nanoseconds();
+        for (const auto index : indices) {
+          timing_store_.record(index, now_ns);
+        }
+      }));
+  }
+
+  for (const auto & [key, indices] : transform_groups) {
+    sub_transforms_.push_back(this->create_subscription<tf2_msgs::msg::TFMessage>(
+      std::get<0>(key), create_qos(key),
+      [this, indices = indices](tf2_msgs::msg::TFMessage::ConstSharedPtr msg) {
+        const auto now_ns = this->now().nanoseconds();
+        for (const auto & transform : msg->transforms) {
+          for (const auto index : indices) {
+            const auto & p = topic_params_[index];
+            if (
+              transform.header.frame_id == p.frame_id &&
+              transform.child_frame_id == p.child_frame_id) {
+              timing_store_.record(index, now_ns);
+            }
+          }
+        }
+      }));
+  }
+}
+
+void MultiTopicStateMonitorNode::initDiagnostics()
+{
+  // The names, keys and parameters are set once, and only the values measured are updated.
+  diag_msg_.status.resize(topic_params_.size());
+  for (size_t i = 0; i < topic_params_.size(); ++i) {
+    const auto & p = topic_params_[i];
+    const auto & param = timing_store_.getParam(i);
+    auto & status = diag_msg_.status[i];
+    status.name = p.diag_name;
+    status.hardware_id = "topic_state_monitor";
+    status.values.resize(kNumOfKeys);
+    for (size_t k = 0; k < kNumOfKeys; ++k) {
+      status.values[k].key = key_names[k];
+    }
+
+    if (p.is_transform) {
+      status.values[kTopic].value = p.topic + " (" + p.frame_id + " to " + p.child_frame_id + ")";
+    } else {
+      status.values[kTopic].value = p.topic;
+    }
+    set_value(status.values[kWarnRate].value, "%.2f [Hz]", param.warn_rate);
+    set_value(status.values[kErrorRate].value, "%.2f [Hz]", param.error_rate);
+    set_value(status.values[kTimeout].value, "%.2f [s]", param.timeout);
+  }
+}
+
+void MultiTopicStateMonitorNode::printThrottle(
+  const size_t index, const int64_t now_ns, const bool is_warn, const char * msg)
+{
+  // Throttled per topic, as each TopicStateMonitorNode does.
+  auto & last_log_time_ns = last_log_times_ns_[index];
+  if (last_log_time_ns != 0 && now_ns - last_log_time_ns < log_throttle_ns) {
+    return;
+  }
+  last_log_time_ns = now_ns;
+  if (is_warn) {
+    RCLCPP_WARN(get_logger(), "%s %s", topic_params_[index].topic.c_str(), msg);
+  } else {
+    RCLCPP_INFO(get_logger(), "%s %s", topic_params_[index].topic.c_str(), msg);
+  }
+}
+
+void MultiTopicStateMonitorNode::onTimer()
+{
+  using diagnostic_msgs::msg::DiagnosticStatus;
+
+  const auto now = this->now();
+  const auto now_ns = now.nanoseconds();
+  diag_msg_.header.stamp = now;
+
+  for (size_t i = 0; i < timing_store_.size(); ++i) {
+    auto & status = diag_msg_.status[i];
+    auto & values = status.values;
+
+    // Judge level
+    const auto topic_status = timing_store_.getTopicStatus(i, now_ns);
+    int8_t level = DiagnosticStatus::OK;
+    if (topic_status == TopicStatus::Ok) {
+      level = DiagnosticStatus::OK;
+      values[kStatus].value = "OK";
+    } else if (topic_status == TopicStatus::NotReceived) {
+      level = DiagnosticStatus::ERROR;
+      values[kStatus].value = "NotReceived";
+      printThrottle(i, now_ns, false, "has not received. Set ERROR in diagnostics.");
+    } else if (topic_status == TopicStatus::WarnRate) {
+      level = DiagnosticStatus::WARN;
+      values[kStatus].value = "WarnRate";
+      printThrottle(
+        i, now_ns, true, "topic rate has dropped to the warning level. Set WARN in diagnostics.");
+    } else if (topic_status == TopicStatus::ErrorRate) {
+      level = DiagnosticStatus::ERROR;
+      values[kStatus].value = "ErrorRate";
+      printThrottle(
+        i, now_ns, true, "topic rate has dropped to the error level. Set ERROR in diagnostics.");
+    } else if (topic_status == TopicStatus::Timeout) {
+      level = DiagnosticStatus::ERROR;
+      values[kStatus].value = "Timeout";
+      printThrottle(i, now_ns, true, "topic is timeout. Set ERROR in diagnostics.");
+    }
+
+    // Update key-value
+    set_value(values[kMeasuredRate].value, "%.2f [Hz]", timing_store_.getTopicRate(i));
+    set_value(values[kNow].value, "%.2f [s]", now.seconds());
+    set_value(
+      values[kLastMessageTime].value, "%.2f [s]",
+      static_cast<double>(timing_store_.getLastMessageTime(i)) * 1e-9);
+
+    // Add summary
+    status.level = level;
+    if (level == DiagnosticStatus::OK) {
+      status.message = "OK";
+    } else if (level == DiagnosticStatus::WARN) {
+      status.message = "Warn";
+    } else if (level == DiagnosticStatus::ERROR) {
+      status.message = "Error";
+    }
+  }
+
+  // Publish diagnostics
+  pub_diag_->publish(diag_msg_);
+}
+
+}  // namespace autoware::topic_state_monitor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::topic_state_monitor::MultiTopicStateMonitorNode)
@@ -0,0 +1,78 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/topic_state_monitor/topic_timing_store.hpp"
+
+#include <algorithm>
+
+namespace autoware::topic_state_monitor
+{
+size_t TopicTimingStore::addTopic(const Param & param)
+{
+  Slot slot;
+  slot.param = param;
+  slot.offset = stamps_.size();
+  slot.capacity = static_cast<size_t>(std::max(param.window_size, 1));
+  stamps_.resize(stamps_.size() + slot.capacity, 0);
+  slots_.push_back(slot);
+  return slots_.size() - 1;
+}
+
+void TopicTimingStore::record(const size_t index, const int64_t stamp_ns)
+{
+  auto & slot = slots_[index];
+  stamps_[slot.offset + slot.head] = stamp_ns;
+  slot.head = (slot.head + 1 == slot.capacity) ? 0 : slot.head + 1;
+  slot.count = std::min(slot.count + 1, slot.capacity);
+  slot.last_stamp_ns = stamp_ns;
+}
+
+double TopicTimingStore::getTopicRate(const size_t index) const
+{
+  // Output max_rate when topic rate can't be calculated.
+  // In this case, it's assumed timeout is used instead.
+  const auto & slot = slots_[index];
+  if (slot.count < 2) {
+    return max_rate;
+  }
+
+  const auto oldest = (slot.head + slot.capacity - slot.count) % slot.capacity;
+  const auto time_diff = static_cast<double>(slot.last_stamp_ns - stamps_[slot.offset + oldest]);
+  const auto num_intervals = slot.count - 1;
+
+  return static_cast<double>(num_intervals) / (time_diff * 1e-9);
+}
+
+TopicStatus TopicTimingStore::getTopicStatus(const size_t index, const int64_t now_ns) const
+{
+  const auto & slot = slots_[index];
+  const auto & param = slot.param;
+  if (slot.count == 0) {
+    return TopicStatus::NotReceived;
+  }
+  const auto elapsed_time = static_cast<double>(now_ns - slot.last_stamp_ns) * 1e-9;
+  if (param.timeout != 0.0 && elapsed_time > param.timeout) {
+    return TopicStatus::Timeout;
+  }
+
+  const auto topic_rate = getTopicRate(index);
+  if (param.error_rate != 0.0 && topic_rate < param.error_rate) {
+    return TopicStatus::ErrorRate;
+  }
+  if (param.warn_rate != 0.0 && topic_rate < param.warn_rate) {
+    return TopicStatus::WarnRate;
+  }
+  return TopicStatus::Ok;
+}
+}  // namespace autoware::topic_state_monitor
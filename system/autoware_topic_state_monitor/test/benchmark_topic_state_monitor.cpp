@@ -0,0 +1,182 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/topic_state_monitor/multi_topic_state_monitor_core.hpp"
+#include "autoware/topic_state_monitor/topic_state_monitor_core.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/key_value.hpp>
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Compare the cost of monitoring num_topics topics with one TopicStateMonitorNode per topic, as
+// component_state_monitor launches them, against one MultiTopicStateMonitorNode. A publisher node
+// publishes every topic at 10 Hz, and the monitors and the publisher are spun by one
+// single-threaded executor as in a component container. Each mode is run in its own process, so
+// that the memory of the modes is measured apart:
+//
+//   benchmark_topic_state_monitor single [num_topics] [duration_s]
+//   benchmark_topic_state_monitor multi [num_topics] [duration_s]
+//
+// The memory is the increase of the resident set size from the creation of the monitors to the
+// end of the run. The discovery time runs from the creation of the monitors until the publisher
+// of every topic is matched with a subscription. The CPU usage is the process CPU time over the
+// wall time of the run after discovery, the publisher included, which is the same in both modes.
+
+using autoware::topic_state_monitor::MultiTopicStateMonitorNode;
+using autoware::topic_state_monitor::TopicStateMonitorNode;
+using KeyValue = diagnostic_msgs::msg::KeyValue;
+
+namespace
+{
+constexpr char topic_type[] = "diagnostic_msgs/msg/KeyValue";
+
+std::string getTopicName(const int index)
+{
+  return "/benchmark_topic_state_monitor/topic_" + std::to_string(index);
+}
+
+// the resident set size of the process [kB]
+int64_t getResidentSetSize()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmRSS:", 0) == 0) {
+      return std::stoll(line.substr(6));
+    }
+  }
+  return 0;
+}
+
+// the user and system CPU time of the process [s]
+double getCpuTime()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+std::vector<rclcpp::Node::SharedPtr> createSingleTopicMonitors(const int num_topics)
+{
+  std::vector<rclcpp::Node::SharedPtr> nodes;
+  for (int i = 0; i < num_topics; ++i) {
+    rclcpp::NodeOptions options;
+    options.arguments({"--ros-args", "-r", "__node:=topic_state_monitor_" + std::to_string(i)});
+    std::vector<rclcpp::Parameter> parameters;
+    parameters.emplace_back("topic", getTopicName(i));
+    parameters.emplace_back("topic_type", topic_type);
+    parameters.emplace_back("diag_name", "topic_" + std::to_string(i) + "_status");
+    options.parameter_overrides(parameters);
+    nodes.push_back(std::make_shared<TopicStateMonitorNode>(options));
+  }
+  return nodes;
+}
+
+std::vector<rclcpp::Node::SharedPtr> createMultiTopicMonitor(const int num_topics)
+{
+  std::vector<std::string> topics;
+  std::vector<rclcpp::Parameter> parameters;
+  for (int i = 0; i < num_topics; ++i) {
+    const auto name = "topic_" + std::to_string(i);
+    topics.push_back(name);
+    parameters.emplace_back(name + ".topic", getTopicName(i));
+    parameters.emplace_back(name + ".topic_type", topic_type);
+    parameters.emplace_back(name + ".diag_name", name + "_status");
+  }
+  parameters.emplace_back("topics", topics);
+  rclcpp::NodeOptions options;
+  options.parameter_overrides(parameters);
+  return {std::make_shared<MultiTopicStateMonitorNode>(options)};
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const std::string mode = argc > 1 ? argv[1] : "";
+  if (mode != "single" && mode != "multi") {
+    std::cerr << "usage: " << argv[0] << " single|multi [num_topics] [duration_s]" << std::endl;
+    return 1;
+  }
+  const int num_topics = argc > 2 ? std::atoi(argv[2]) : 100;
+  const double duration_s = argc > 3 ? std::atof(argv[3]) : 10.0;
+  rclcpp::init(0, nullptr);
+
+  auto publisher_node = std::make_shared<rclcpp::Node>("benchmark_topic_state_monitor_publisher");
+  std::vector<rclcpp::Publisher<KeyValue>::SharedPtr> publishers;
+  for (int i = 0; i < num_topics; ++i) {
+    publishers.push_back(publisher_node->create_publisher<KeyValue>(getTopicName(i), 1));
+  }
+  const auto publish_timer =
+    publisher_node->create_wall_timer(std::chrono::milliseconds(100), [&publishers]() {
+      for (const auto & publisher : publishers) {
+        publisher->publish(KeyValue{});
+      }
+    });
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(publisher_node);
+
+  const int64_t rss_before_kb = getResidentSetSize();
+  const auto creation_start = std::chrono::steady_clock::now();
+  const auto monitors =
+    mode == "single" ? createSingleTopicMonitors(num_topics) : createMultiTopicMonitor(num_topics);
+  const auto creation_end = std::chrono::steady_clock::now();
+  for (const auto & monitor : monitors) {
+    executor.add_node(monitor);
+  }
+
+  const auto isMatched = [&publishers]() {
+    for (const auto & publisher : publishers) {
+      if (publisher->get_subscription_count() == 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+  while (rclcpp::ok() && !isMatched()) {
+    executor.spin_once(std::chrono::milliseconds(1));
+  }
+  const auto discovery_end = std::chrono::steady_clock::now();
+
+  const double cpu_start = getCpuTime();
+  const auto run_end = discovery_end + std::chrono::duration<double>(duration_s);
+  while (rclcpp::ok() && std::chrono::steady_clock::now() < run_end) {
+    executor.spin_once(std::chrono::milliseconds(10));
+  }
+  const double cpu_time = getCpuTime() - cpu_start;
+  const int64_t rss_after_kb = getResidentSetSize();
+
+  const auto toMs = [](const auto duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+  std::cout << "mode: " << mode << ", topics: " << num_topics << ", nodes: " << monitors.size()
+            << ", creation: " << toMs(creation_end - creation_start)
+            << " ms, discovery: " << toMs(discovery_end - creation_start)
+            << " ms, memory: " << static_cast<double>(rss_after_kb - rss_before_kb) / 1024.0
+            << " MiB, cpu: " << 100.0 * cpu_time / duration_s << " %" << std::endl;
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,218 @@
+// Copyright 2025 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/topic_state_monitor/topic_state_monitor.hpp"
+#include "autoware/topic_state_monitor/topic_timing_store.hpp"
+
+#include <rcl/time.h>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using autoware::topic_state_monitor::Param;
+using autoware::topic_state_monitor::TopicStateMonitor;
+using autoware::topic_state_monitor::TopicStatus;
+using autoware::topic_state_monitor::TopicTimingStore;
+
+namespace
+{
+constexpr int64_t ms = 1'000'000;
+
+Param createParam(
+  const double warn_rate, const double error_rate, const double timeout, const int window_size)
+{
+  Param param;
+  param.warn_rate = warn_rate;
+  param.error_rate = error_rate;
+  param.timeout = timeout;
+  param.window_size = window_size;
+  return param;
+}
+
+// TopicStateMonitor reads the node clock, which is overridden so that the stamps are the same as
+// the ones recorded in the store
+class TopicTimingStoreTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    node_ = std::make_shared<rclcpp::Node>("test_topic_timing_store");
+    clock_handle_ = node_->get_clock()->get_clock_handle();
+    ASSERT_EQ(rcl_enable_ros_time_override(clock_handle_), RCL_RET_OK);
+    setTime(0);
+  }
+
+  void setTime(const int64_t now_ns)
+  {
+    ASSERT_EQ(rcl_set_ros_time_override(clock_handle_, now_ns), RCL_RET_OK);
+  }
+
+  // a message arrives at now_ns in the single-topic monitors and in the store
+  void receive(
+    const int64_t now_ns, std::vector<TopicStateMonitor> & monitors, TopicTimingStore & store)
+  {
+    setTime(now_ns);
+    for (size_t i = 0; i < monitors.size(); ++i) {
+      monitors[i].update();
+      store.record(i, now_ns);
+    }
+  }
+
+  void expectSameStates(
+    const int64_t now_ns, const std::vector<TopicStateMonitor> & monitors,
+    const TopicTimingStore & store)
+  {
+    setTime(now_ns);
+    for (size_t i = 0; i < monitors.size(); ++i) {
+      EXPECT_EQ(store.getTopicStatus(i, now_ns), monitors[i].getTopicStatus())
+        << "topic: " << i << ", now: " << now_ns;
+      EXPECT_DOUBLE_EQ(store.getTopicRate(i), monitors[i].getTopicRate())
+        << "topic: " << i << ", now: " << now_ns;
+      EXPECT_EQ(store.getLastMessageTime(i), monitors[i].getLastMessageTime().nanoseconds());
+    }
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  rcl_clock_t * clock_handle_{nullptr};
+};
+}  // namespace
+
+TEST_F(TopicTimingStoreTest, NotReceived)
+{
+  TopicTimingStore store;
+  const auto index = store.addTopic(createParam(5.0, 1.0, 1.0, 10));
+  EXPECT_EQ(store.getTopicStatus(index, 10'000 * ms), TopicStatus::NotReceived);
+  EXPECT_EQ(store.getLastMessageTime(index), 0);
+  EXPECT_DOUBLE_EQ(store.getTopicRate(index), TopicTimingStore::max_rate);
+}
+
+TEST_F(TopicTimingStoreTest, Timeout)
+{
+  TopicTimingStore store;
+  const auto index = store.addTopic(createParam(5.0, 1.0, 1.0, 10));
+  store.record(index, 1'000 * ms);
+  EXPECT_EQ(store.getTopicStatus(index, 1'999 * ms), TopicStatus::Ok);
+  EXPECT_EQ(store.getTopicStatus(index, 2'001 * ms), TopicStatus::Timeout);
+
+  // no timeout when it is 0
+  const auto no_timeout_index = store.addTopic(createParam(0.0, 0.0, 0.0, 10));
+  store.record(no_timeout_index, 1'000 * ms);
+  EXPECT_EQ(store.getTopicStatus(no_timeout_index, 100'000 * ms), TopicStatus::Ok);
+}
+
+TEST_F(TopicTimingStoreTest, RateStates)
+{
+  TopicTimingStore store;
+  const auto index = store.addTopic(createParam(5.0, 1.0, 0.0, 10));
+  // the rate is not known with one message
+  store.record(index, 0);
+  EXPECT_EQ(store.getTopicStatus(index, 0), TopicStatus::Ok);
+
+  // 2 Hz is between the error and the warn rates
+  store.record(index, 500 * ms);
+  EXPECT_NEAR(store.getTopicRate(index), 2.0, 1e-9);
+  EXPECT_EQ(store.getTopicStatus(index, 500 * ms), TopicStatus::WarnRate);
+
+  // the number of intervals over the time from the oldest stamp, 3 / 4 Hz is below the error rate
+  store.record(index, 1'500 * ms);
+  EXPECT_NEAR(store.getTopicRate(index), 2.0 / 1.5, 1e-9);
+  store.record(index, 4'000 * ms);
+  EXPECT_NEAR(store.getTopicRate(index), 3.0 / 4.0, 1e-9);
+  EXPECT_EQ(store.getTopicStatus(index, 4'000 * ms), TopicStatus::ErrorRate);
+
+  // 10 Hz
+  for (int i = 1; i <= 10; ++i) {
+    store.record(index, 4'000 * ms + i * 100 * ms);
+  }
+  EXPECT_NEAR(store.getTopicRate(index), 10.0, 1e-9);
+  EXPECT_EQ(store.getTopicStatus(index, 5'000 * ms), TopicStatus::Ok);
+}
+
+TEST_F(TopicTimingStoreTest, RingBufferWrapsAround)
+{
+  TopicTimingStore store;
+  // the topics are back to back in the buffer, the wraparound of one must not touch the others
+  const auto first_index = store.addTopic(createParam(0.0, 0.0, 0.0, 3));
+  const auto second_index = store.addTopic(createParam(0.0, 0.0, 0.0, 1));
+  const auto third_index = store.addTopic(createParam(0.0, 0.0, 0.0, 4));
+  store.record(third_index, 0);
+  store.record(third_index, 1'000 * ms);
+
+  // the window holds the 3 latest stamps: 7, 8 and 10 s
+  for (const int64_t stamp : {1, 2, 4, 7, 8, 10}) {
+    store.record(first_index, stamp * 1'000 * ms);
+    store.record(second_index, stamp * 1'000 * ms);
+  }
+  EXPECT_NEAR(store.getTopicRate(first_index), 2.0 / 3.0, 1e-9);
+  EXPECT_EQ(store.getLastMessageTime(first_index), 10'000 * ms);
+  // a window of one message has no rate
+  EXPECT_DOUBLE_EQ(store.getTopicRate(second_index), TopicTimingStore::max_rate);
+  EXPECT_NEAR(store.getTopicRate(third_index), 1.0, 1e-9);
+
+  // one more turn
+  for (const int64_t stamp : {11, 12, 13}) {
+    store.record(first_index, stamp * 1'000 * ms);
+  }
+  EXPECT_NEAR(store.getTopicRate(first_index), 1.0, 1e-9);
+  EXPECT_NEAR(store.getTopicRate(third_index), 1.0, 1e-9);
+}
+
+TEST_F(TopicTimingStoreTest, MatchesTopicStateMonitor)
+{
+  const std::vector<Param> params = {
+    createParam(5.0, 1.0, 1.0, 10), createParam(10.0, 0.0, 0.5, 3),
+    createParam(0.0, 2.0, 0.0, 1),  createParam(0.0, 0.0, 2.0, 2),
+    createParam(20.0, 8.0, 0.2, 50),
+  };
+  std::vector<TopicStateMonitor> monitors;
+  TopicTimingStore store;
+  for (const auto & param : params) {
+    monitors.emplace_back(*node_);
+    monitors.back().setParam(param);
+    store.addTopic(param);
+  }
+  expectSameStates(0, monitors, store);
+
+  // bursts, steady rates and silences, with the states checked between the arrivals
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<int> mode_distribution(0, 2);
+  std::uniform_int_distribution<int64_t> burst_distribution(1, 20 * ms);
+  std::uniform_int_distribution<int64_t> steady_distribution(40 * ms, 300 * ms);
+  std::uniform_int_distribution<int64_t> silence_distribution(300 * ms, 3'000 * ms);
+  int64_t now_ns = 1'000 * ms;
+  for (int i = 0; i < 2'000; ++i) {
+    const int mode = mode_distribution(engine);
+    const int64_t interval = mode == 0   ? burst_distribution(engine)
+                             : mode == 1 ? steady_distribution(engine)
+                                         : silence_distribution(engine);
+    expectSameStates(now_ns + interval / 2, monitors, store);
+    now_ns += interval;
+    receive(now_ns, monitors, store);
+    expectSameStates(now_ns, monitors, store);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  const int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}